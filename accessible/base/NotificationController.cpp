@@ -576,6 +576,17 @@ void NotificationController::ProcessMutationEvents() {
     }
   }
 
+#if !defined(XP_WIN)
+  // All the tick's show events have been serialized; send them to the parent
+  // process as one batch. Windows sends show events individually because its
+  // DocAccessibleChild may need to defer them.
+  if (mDocument && IPCAccessibilityActive()) {
+    if (DocAccessibleChild* ipcDoc = mDocument->IPCDoc()) {
+      ipcDoc->FlushShowEventBatch();
+    }
+  }
+#endif
+
   // Now we can fire the reorder events after all the show and hide events.
   for (AccTreeMutationEvent* event = mFirstMutationEvent; event;
        event = event->NextEvent()) {
@@ -76,8 +76,33 @@ void DocAccessibleChildBase::ShowEvent(AccShowEvent* aShowEvent) {
   nsTArray<AccessibleData> shownTree;
   ShowEventData data(parentID, idxInParent, shownTree, false);
   SerializeTree(aShowEvent->GetAccessible(), data.NewTree());
+#if defined(XP_WIN)
   MaybeSendShowEvent(data, aShowEvent->IsFromUserInput());
+#else
+  // Queue rather than send; the NotificationController flushes the queue in
+  // one ShowEventBatch message after processing the tick's mutations, so a
+  // burst of insertions doesn't cost one IPC message per show event.
+  mBatchedShowData.AppendElement(std::move(data));
+  mBatchedShowFromUser.AppendElement(aShowEvent->IsFromUserInput());
+#endif
+}
+
+#if !defined(XP_WIN)
+void DocAccessibleChildBase::FlushShowEventBatch() {
+  if (mBatchedShowData.IsEmpty()) {
+    return;
+  }
+
+  if (mBatchedShowData.Length() == 1) {
+    MaybeSendShowEvent(mBatchedShowData[0], mBatchedShowFromUser[0]);
+  } else {
+    Unused << SendShowEventBatch(mBatchedShowData, mBatchedShowFromUser);
+  }
+
+  mBatchedShowData.Clear();
+  mBatchedShowFromUser.Clear();
 }
+#endif  // !defined(XP_WIN)
 
 }  // namespace a11y
 }  // namespace mozilla
@@ -48,6 +48,15 @@ class DocAccessibleChildBase : public PDocAccessibleChild {
                          uint32_t aIdxInParent);
   void ShowEvent(AccShowEvent* aShowEvent);
 
+#if !defined(XP_WIN)
+  /**
+   * Sends all show events queued by ShowEvent() since the last flush as a
+   * single ShowEventBatch message. Called by the NotificationController once
+   * per tick, after the hide events for the tick have been sent.
+   */
+  void FlushShowEventBatch();
+#endif
+
   virtual void ActorDestroy(ActorDestroyReason) override {
     if (!mDoc) {
       return;
@@ -78,6 +87,14 @@ class DocAccessibleChildBase : public PDocAccessibleChild {
   DocAccessible* mDoc;
   bool mIsRemoteConstructed;
 
+#if !defined(XP_WIN)
+  // Show events queued during the current tick, flushed by
+  // FlushShowEventBatch(). Parallel arrays matching the ShowEventBatch
+  // message signature.
+  nsTArray<ShowEventData> mBatchedShowData;
+  nsTArray<bool> mBatchedShowFromUser;
+#endif
+
   friend void DocAccessible::DoInitialUpdate();
 };
 
@@ -116,6 +116,26 @@ mozilla::ipc::IPCResult DocAccessibleParent::RecvShowEvent(
   return IPC_OK();
 }
 
+#if !defined(XP_WIN)
+mozilla::ipc::IPCResult DocAccessibleParent::RecvShowEventBatch(
+    nsTArray<ShowEventData>&& aData, nsTArray<bool>&& aFromUser) {
+  if (aData.Length() != aFromUser.Length()) {
+    return IPC_FAIL(this, "mismatched batch lengths");
+  }
+
+  // The batch is just the tick's show events in the order they would have
+  // been sent individually; process them the same way.
+  for (uint32_t i = 0; i < aData.Length(); i++) {
+    mozilla::ipc::IPCResult result = RecvShowEvent(aData[i], aFromUser[i]);
+    if (!result) {
+      return result;
+    }
+  }
+
+  return IPC_OK();
+}
+#endif  // !defined(XP_WIN)
+
 uint32_t DocAccessibleParent::AddSubtree(
     RemoteAccessible* aParent, const nsTArray<a11y::AccessibleData>& aNewTree,
     uint32_t aIdx, uint32_t aIdxInParent) {
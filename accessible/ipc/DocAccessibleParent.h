@@ -91,6 +91,10 @@ class DocAccessibleParent : public RemoteAccessible,
 
   virtual mozilla::ipc::IPCResult RecvShowEvent(const ShowEventData& aData,
                                                 const bool& aFromUser) override;
+#if !defined(XP_WIN)
+  virtual mozilla::ipc::IPCResult RecvShowEventBatch(
+      nsTArray<ShowEventData>&& aData, nsTArray<bool>&& aFromUser) override;
+#endif
   virtual mozilla::ipc::IPCResult RecvHideEvent(const uint64_t& aRootID,
                                                 const bool& aFromUser) override;
   mozilla::ipc::IPCResult RecvStateChangeEvent(const uint64_t& aID,
@@ -41,6 +41,7 @@
 #include "mozilla/MathAlgorithms.h"
 #include "mozilla/Preferences.h"
 #include "mozilla/Services.h"
+#include "mozilla/StaticPrefs_docshell.h"
 #include "mozilla/StaticPrefs_fission.h"
 #include "mozilla/StaticPtr.h"
 #include "mozilla/dom/CanonicalBrowsingContext.h"
@@ -986,10 +987,16 @@ void nsSHistory::LogHistory() {
   }
 }
 
+// static
+int32_t nsSHistory::ViewerWindow() {
+  return int32_t(StaticPrefs::docshell_shistory_bfcache_viewer_window());
+}
+
 void nsSHistory::WindowIndices(int32_t aIndex, int32_t* aOutStartIndex,
                                int32_t* aOutEndIndex) {
-  *aOutStartIndex = std::max(0, aIndex - nsSHistory::VIEWER_WINDOW);
-  *aOutEndIndex = std::min(Length() - 1, aIndex + nsSHistory::VIEWER_WINDOW);
+  const int32_t viewerWindow = ViewerWindow();
+  *aOutStartIndex = std::max(0, aIndex - viewerWindow);
+  *aOutEndIndex = std::min(Length() - 1, aIndex + viewerWindow);
 }
 
 static void MarkAsInitialEntry(
@@ -1395,14 +1402,14 @@ void nsSHistory::EvictOutOfRangeWindowContentViewers(int32_t aIndex) {
 
   // We need to release all content viewers that are no longer in the range
   //
-  //  aIndex - VIEWER_WINDOW to aIndex + VIEWER_WINDOW
+  //  aIndex - ViewerWindow() to aIndex + ViewerWindow()
   //
   // to ensure that this SHistory object isn't responsible for more than
-  // VIEWER_WINDOW content viewers.  But our job is complicated by the
+  // ViewerWindow() content viewers.  But our job is complicated by the
   // fact that two entries which are related by either hash navigations or
   // history.pushState will have the same content viewer.
   //
-  // To illustrate the issue, suppose VIEWER_WINDOW = 3 and we have four
+  // To illustrate the issue, suppose ViewerWindow() = 3 and we have four
   // linked entries in our history.  Suppose we then add a new content
   // viewer and call into this function.  So the history looks like:
   //
@@ -1410,7 +1417,7 @@ void nsSHistory::EvictOutOfRangeWindowContentViewers(int32_t aIndex) {
   //     +     *
   //
   // where the letters are content viewers and + and * denote the beginning and
-  // end of the range aIndex +/- VIEWER_WINDOW.
+  // end of the range aIndex +/- ViewerWindow().
   //
   // Although one copy of the content viewer A exists outside the range, we
   // don't want to evict A, because it has other copies in range!
@@ -1418,7 +1425,7 @@ void nsSHistory::EvictOutOfRangeWindowContentViewers(int32_t aIndex) {
   // We therefore adjust our eviction strategy to read:
   //
   //   Evict each content viewer outside the range aIndex -/+
-  //   VIEWER_WINDOW, unless that content viewer also appears within the
+  //   ViewerWindow(), unless that content viewer also appears within the
   //   range.
   //
   // (Note that it's entirely legal to have two copies of one content viewer
@@ -1440,7 +1447,7 @@ void nsSHistory::EvictOutOfRangeWindowContentViewers(int32_t aIndex) {
        "Length()=%d. Safe range [%d, %d]",
        aIndex, Length(), startSafeIndex, endSafeIndex));
 
-  // The content viewers in range aIndex -/+ VIEWER_WINDOW will not be
+  // The content viewers in range aIndex -/+ ViewerWindow() will not be
   // evicted.  Collect a set of them so we don't accidentally evict one of them
   // if it appears outside this range.
   nsCOMArray<nsIContentViewer> safeViewers;
@@ -1540,7 +1547,7 @@ void nsSHistory::GloballyEvictContentViewers() {
     nsTArray<EntryAndDistance> shEntries;
 
     // Content viewers are likely to exist only within shist->mIndex -/+
-    // VIEWER_WINDOW, so only search within that range.
+    // ViewerWindow(), so only search within that range.
     //
     // A content viewer might exist outside that range due to either:
     //
@@ -146,9 +146,11 @@ class nsSHistory : public mozilla::LinkedListElement<nsSHistory>,
   // The size of the window of SHEntries which can have alive viewers in the
   // bfcache around the currently active SHEntry.
   //
-  // We try to keep viewers for SHEntries between index - VIEWER_WINDOW and
-  // index + VIEWER_WINDOW alive.
-  static const int32_t VIEWER_WINDOW = 3;
+  // We try to keep viewers for SHEntries between index - ViewerWindow() and
+  // index + ViewerWindow() alive. Controlled by the
+  // docshell.shistory.bfcache.viewer_window pref; the global viewer budget
+  // still applies on top of this per-history window.
+  static int32_t ViewerWindow();
 
   struct LoadEntryResult {
     RefPtr<mozilla::dom::BrowsingContext> mBrowsingContext;
@@ -240,7 +242,7 @@ class nsSHistory : public mozilla::LinkedListElement<nsSHistory>,
                      bool aSameEpoch = false, bool aUserActivation = false);
 
   // Find the history entry for a given bfcache entry. It only looks up between
-  // the range where alive viewers may exist (i.e nsSHistory::VIEWER_WINDOW).
+  // the range where alive viewers may exist (i.e nsSHistory::ViewerWindow()).
   nsresult FindEntryForBFCache(mozilla::dom::SHEntrySharedParentState* aEntry,
                                nsISHEntry** aResult, int32_t* aResultIndex);
 
@@ -6,6 +6,7 @@
 
 #include "ChromeUtils.h"
 
+#include "js/Array.h"  // JS::NewArrayObject
 #include "js/CharacterEncoding.h"
 #include "js/Object.h"  // JS::GetClass
 #include "js/SavedFrameAPI.h"
@@ -25,6 +26,7 @@
 #include "mozilla/SharedStyleSheetCache.h"
 #include "mozilla/TimeStamp.h"
 #include "mozilla/dom/ContentParent.h"
+#include "mozilla/dom/Document.h"
 #include "mozilla/dom/IdleDeadline.h"
 #include "mozilla/dom/InProcessParent.h"
 #include "mozilla/dom/JSActorService.h"
@@ -790,6 +792,52 @@ void ChromeUtils::ClearRecentJSDevError(GlobalObject&) {
 }
 #endif  // NIGHTLY_BUILD
 
+/* static */
+void ChromeUtils::GetRecentLayoutFlushes(GlobalObject& aGlobal,
+                                         JS::MutableHandleValue aRetval,
+                                         ErrorResult& aRv) {
+  JSContext* cx = aGlobal.Context();
+
+  nsTArray<Document::ForcedFlushRecord> records;
+  Document::GetRecentForcedFlushes(records);
+
+  JS::Rooted<JSObject*> array(cx, JS::NewArrayObject(cx, records.Length()));
+  if (!array) {
+    aRv.NoteJSContextException(cx);
+    return;
+  }
+
+  for (size_t i = 0; i < records.Length(); ++i) {
+    const Document::ForcedFlushRecord& record = records[i];
+
+    JS::Rooted<JSObject*> obj(cx, JS_NewPlainObject(cx));
+    if (!obj) {
+      aRv.NoteJSContextException(cx);
+      return;
+    }
+
+    JS::Rooted<JSString*> filename(
+        cx, JS_NewStringCopyUTF8N(
+                cx, JS::UTF8Chars(record.mCallerFilename.get(),
+                                  record.mCallerFilename.Length())));
+    if (!filename ||
+        !JS_DefineProperty(cx, obj, "filename", filename, JSPROP_ENUMERATE) ||
+        !JS_DefineProperty(cx, obj, "lineNumber", record.mCallerLine,
+                           JSPROP_ENUMERATE) ||
+        !JS_DefineProperty(cx, obj, "flushType",
+                           static_cast<uint32_t>(record.mFlushType),
+                           JSPROP_ENUMERATE) ||
+        !JS_DefineProperty(cx, obj, "durationMs", record.mDurationMs,
+                           JSPROP_ENUMERATE) ||
+        !JS_DefineElement(cx, array, i, obj, JSPROP_ENUMERATE)) {
+      aRv.NoteJSContextException(cx);
+      return;
+    }
+  }
+
+  aRetval.setObject(*array);
+}
+
 void ChromeUtils::ClearStyleSheetCacheByPrincipal(GlobalObject&,
                                                   nsIPrincipal* aForPrincipal) {
   SharedStyleSheetCache::Clear(aForPrincipal);
@@ -163,6 +163,10 @@ class ChromeUtils {
 
   static void ClearRecentJSDevError(GlobalObject& aGlobal);
 
+  static void GetRecentLayoutFlushes(GlobalObject& aGlobal,
+                                     JS::MutableHandleValue aRetval,
+                                     ErrorResult& aRv);
+
   static void ClearStyleSheetCacheByPrincipal(GlobalObject&,
                                               nsIPrincipal* aForPrincipal);
 
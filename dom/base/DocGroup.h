@@ -17,6 +17,7 @@
 #include "mozilla/dom/HTMLSlotElement.h"
 #include "mozilla/PerformanceCounter.h"
 #include "mozilla/PerformanceTypes.h"
+#include "mozilla/TimeStamp.h"
 
 namespace mozilla {
 class AbstractThread;
@@ -128,6 +129,23 @@ class DocGroup final {
 
   bool IsEmpty() const { return mDocuments.IsEmpty(); }
 
+  // Execution budget shared by the TimeoutManagers of every window in this
+  // DocGroup, so that the timeouts of one origin are throttled as a unit.
+  // Only TimeoutManager reads or updates this state; see
+  // TimeoutManager::UpdateGroupBudget.
+  const TimeDuration& GetTimeoutExecutionBudget() const {
+    return mTimeoutExecutionBudget;
+  }
+  void SetTimeoutExecutionBudget(const TimeDuration& aBudget) {
+    mTimeoutExecutionBudget = aBudget;
+  }
+  const TimeStamp& GetLastTimeoutBudgetUpdate() const {
+    return mLastTimeoutBudgetUpdate;
+  }
+  void SetLastTimeoutBudgetUpdate(const TimeStamp& aNow) {
+    mLastTimeoutBudgetUpdate = aNow;
+  }
+
  private:
   DocGroup(BrowsingContextGroup* aBrowsingContextGroup, const nsACString& aKey);
 
@@ -152,6 +170,10 @@ class DocGroup final {
   // Each DocGroup has a persisted agent cluster ID.
   const nsID mAgentClusterId;
 
+  // See GetTimeoutExecutionBudget.
+  TimeDuration mTimeoutExecutionBudget;
+  TimeStamp mLastTimeoutBudgetUpdate;
+
   RefPtr<mozilla::dom::DOMArena> mArena;
 };
 
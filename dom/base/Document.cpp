@@ -49,6 +49,7 @@
 #include "mozilla/Base64.h"
 #include "mozilla/BasePrincipal.h"
 #include "mozilla/CSSEnabledState.h"
+#include "mozilla/ClearOnShutdown.h"
 #include "mozilla/ContentBlocking.h"
 #include "mozilla/ContentBlockingAllowList.h"
 #include "mozilla/ContentBlockingNotifier.h"
@@ -124,6 +125,7 @@
 #include "mozilla/StaticPrefs_security.h"
 #include "mozilla/StaticPrefs_widget.h"
 #include "mozilla/StaticPresData.h"
+#include "mozilla/StaticPtr.h"
 #include "mozilla/StorageAccess.h"
 #include "mozilla/StoragePrincipalHelper.h"
 #include "mozilla/StyleSheet.h"
@@ -376,6 +378,7 @@
 #include "nsIXULRuntime.h"
 #include "nsImageLoadingContent.h"
 #include "nsImportModule.h"
+#include "nsJSUtils.h"
 #include "nsLanguageAtomService.h"
 #include "nsLayoutUtils.h"
 #include "nsNetCID.h"
@@ -10545,6 +10548,47 @@ class nsDocumentOnStack {
   Document* mDoc;
 };
 
+// Ring buffer of recent forced style/layout flushes. This is always on, so
+// the entries are kept small and recording only happens when a flush was
+// forced from script and actually has work to do.
+static const size_t kForcedFlushRingSize = 128;
+static StaticAutoPtr<nsTArray<Document::ForcedFlushRecord>> sForcedFlushRing;
+static size_t sForcedFlushRingNext = 0;
+
+static void RecordForcedFlush(Document::ForcedFlushRecord&& aRecord) {
+  MOZ_ASSERT(NS_IsMainThread());
+
+  if (MOZ_UNLIKELY(!sForcedFlushRing)) {
+    sForcedFlushRing = new nsTArray<Document::ForcedFlushRecord>();
+    sForcedFlushRing->SetCapacity(kForcedFlushRingSize);
+    ClearOnShutdown(&sForcedFlushRing);
+  }
+
+  if (sForcedFlushRing->Length() < kForcedFlushRingSize) {
+    sForcedFlushRing->AppendElement(std::move(aRecord));
+  } else {
+    (*sForcedFlushRing)[sForcedFlushRingNext] = std::move(aRecord);
+  }
+  sForcedFlushRingNext = (sForcedFlushRingNext + 1) % kForcedFlushRingSize;
+}
+
+/* static */
+void Document::GetRecentForcedFlushes(nsTArray<ForcedFlushRecord>& aRecords) {
+  MOZ_ASSERT(NS_IsMainThread());
+
+  if (!sForcedFlushRing) {
+    return;
+  }
+
+  // The write cursor points at the oldest entry once the ring has wrapped.
+  const nsTArray<ForcedFlushRecord>& ring = *sForcedFlushRing;
+  size_t start =
+      ring.Length() < kForcedFlushRingSize ? 0 : sForcedFlushRingNext;
+  for (size_t i = 0; i < ring.Length(); ++i) {
+    aRecords.AppendElement(ring[(start + i) % ring.Length()]);
+  }
+}
+
 void Document::FlushPendingNotifications(mozilla::ChangesToFlush aFlush) {
   // See PresShell::DoFlushPendingNotifications.
   if (!mozilla::recordreplay::AllowSideEffects()) {
@@ -10615,8 +10659,60 @@ void Document::FlushPendingNotifications(mozilla::ChangesToFlush aFlush) {
   }
 
   if (RefPtr<PresShell> presShell = GetPresShell()) {
+    // If this flush was forced from script and will actually do work,
+    // record it so that ChromeUtils.getRecentLayoutFlushes can attribute
+    // the cost to the caller.
+    nsAutoCString callerFilename;
+    uint32_t callerLine = 0;
+    bool record = false;
+    if (flushType >= FlushType::Style && NeedsFlush(flushType)) {
+      if (JSContext* cx = nsContentUtils::GetCurrentJSContext()) {
+        record = nsJSUtils::GetCallingLocation(cx, callerFilename, &callerLine);
+      }
+    }
+
+    if (!record) {
+      presShell->FlushPendingNotifications(aFlush);
+      return;
+    }
+
+    TimeStamp start = TimeStamp::Now();
     presShell->FlushPendingNotifications(aFlush);
+
+    ForcedFlushRecord flushRecord;
+    flushRecord.mCallerFilename = std::move(callerFilename);
+    flushRecord.mCallerLine = callerLine;
+    flushRecord.mFlushType = flushType;
+    flushRecord.mDurationMs = (TimeStamp::Now() - start).ToMilliseconds();
+    RecordForcedFlush(std::move(flushRecord));
+  }
+}
+
+bool Document::NeedsFlush(FlushType aType) {
+  // The parser or the sink may still have pending content or frame
+  // construction notifications; FlushPendingNotifications would forward the
+  // flush to them.
+  if (mParser || mWeakSink) {
+    return true;
+  }
+
+  if (aType <= FlushType::ContentAndNotify) {
+    return false;
+  }
+
+  // Mirrors the parent-document promotion in FlushPendingNotifications: a
+  // style or layout flush on us requires our container to be laid out.
+  if (StyleOrLayoutObservablyDependsOnParentDocumentLayout() &&
+      mParentDocument->MayStartLayout() &&
+      mParentDocument->NeedsFlush(std::max(FlushType::Layout, aType))) {
+    return true;
   }
+
+  if (PresShell* presShell = GetPresShell()) {
+    return !presShell->DidInitialize() || presShell->NeedFlush(aType);
+  }
+
+  return false;
 }
 
 void Document::FlushExternalResources(FlushType aType) {
@@ -2093,6 +2093,35 @@ class Document : public nsINode,
   MOZ_CAN_RUN_SCRIPT_BOUNDARY
   void FlushPendingNotifications(ChangesToFlush aFlush);
 
+  /**
+   * Returns whether a call to FlushPendingNotifications(aType) could do any
+   * work at all, for this document or a parent document whose layout we
+   * observe. Conservative: may return true when a flush would be a no-op,
+   * but never returns false when a flush is needed. Geometry query APIs use
+   * this to skip the flush machinery when the frame tree is already
+   * up-to-date.
+   */
+  bool NeedsFlush(FlushType aType);
+
+  /**
+   * A recent forced style/layout flush recorded by
+   * FlushPendingNotifications and exposed through
+   * ChromeUtils.getRecentLayoutFlushes, so that forced-reflow costs can be
+   * attributed to the script that triggered them without running the
+   * profiler.
+   */
+  struct ForcedFlushRecord {
+    nsCString mCallerFilename;
+    uint32_t mCallerLine = 0;
+    FlushType mFlushType = FlushType::None;
+    double mDurationMs = 0.0;
+  };
+
+  /**
+   * Copies the most recently recorded forced flushes, oldest first.
+   */
+  static void GetRecentForcedFlushes(nsTArray<ForcedFlushRecord>& aRecords);
+
   /**
    * Calls FlushPendingNotifications on any external resources this document
    * has. If this document has no external resources or is an external resource
@@ -246,7 +246,12 @@ nsIFrame* nsIContent::GetPrimaryFrame(mozilla::FlushType aType) {
   }
 
   // Cause a flush, so we get up-to-date frame information.
-  if (aType != mozilla::FlushType::None) {
+  //
+  // Geometry queries tend to arrive in batches (virtual-scrolling code calling
+  // getBoundingClientRect on every row, say), and all flushes after the first
+  // one are no-ops, so skip the flush machinery entirely when nothing is
+  // pending and serve the query from the frame tree as-is.
+  if (aType != mozilla::FlushType::None && doc->NeedsFlush(aType)) {
     doc->FlushPendingNotifications(aType);
   }
 
@@ -2393,14 +2393,17 @@ void Selection::Extend(nsINode& aContainer, uint32_t aOffset,
   int32_t endOffset = range->EndOffset();
 
   bool shouldClearRange = false;
+  // The anchor is the first point of two of the comparisons below, so the
+  // index computations along its ancestor chain can be shared between them.
+  nsContentUtils::ComparePointsCache anchorCache;
   const Maybe<int32_t> anchorOldFocusOrder = nsContentUtils::ComparePoints(
-      anchorNode, anchorOffset, focusNode, focusOffset);
+      anchorNode, anchorOffset, focusNode, focusOffset, &anchorCache);
   shouldClearRange |= !anchorOldFocusOrder;
   const Maybe<int32_t> oldFocusNewFocusOrder = nsContentUtils::ComparePoints(
       focusNode, focusOffset, &aContainer, aOffset);
   shouldClearRange |= !oldFocusNewFocusOrder;
   const Maybe<int32_t> anchorNewFocusOrder = nsContentUtils::ComparePoints(
-      anchorNode, anchorOffset, &aContainer, aOffset);
+      anchorNode, anchorOffset, &aContainer, aOffset, &anchorCache);
   shouldClearRange |= !anchorNewFocusOrder;
 
   // If the points are disconnected, the range will be collapsed below,
@@ -243,10 +243,11 @@ TimeDuration TimeoutManager::MinSchedulingDelay() const {
                          StaticPrefs::dom_min_background_timeout_value())
                    : TimeDuration();
   bool budgetThrottlingEnabled = BudgetThrottlingEnabled(isBackground);
-  if (budgetThrottlingEnabled && mExecutionBudget < TimeDuration()) {
+  TimeDuration executionBudget = EffectiveExecutionBudget();
+  if (budgetThrottlingEnabled && executionBudget < TimeDuration()) {
     // Only throttle if execution budget is less than 0
     double factor = 1.0 / GetRegenerationFactor(mWindow.IsBackgroundInternal());
-    return TimeDuration::Max(unthrottled, -mExecutionBudget.MultDouble(factor));
+    return TimeDuration::Max(unthrottled, -executionBudget.MultDouble(factor));
   }
   if (!budgetThrottlingEnabled && isBackground) {
     return TimeDuration::FromMilliseconds(
@@ -320,16 +321,18 @@ TimeDuration TimeoutManager::CalculateDelay(Timeout* aTimeout) const {
 }
 
 PerformanceCounter* TimeoutManager::GetPerformanceCounter() {
-  Document* doc = mWindow.GetDocument();
-  if (doc) {
-    dom::DocGroup* docGroup = doc->GetDocGroup();
-    if (docGroup) {
-      return docGroup->GetPerformanceCounter();
-    }
+  dom::DocGroup* docGroup = GetDocGroup();
+  if (docGroup) {
+    return docGroup->GetPerformanceCounter();
   }
   return nullptr;
 }
 
+dom::DocGroup* TimeoutManager::GetDocGroup() const {
+  Document* doc = mWindow.GetDocument();
+  return doc ? doc->GetDocGroup() : nullptr;
+}
+
 void TimeoutManager::RecordExecution(Timeout* aRunningTimeout,
                                      Timeout* aTimeout) {
   TimeoutBudgetManager& budgetManager = TimeoutBudgetManager::Get();
@@ -385,6 +388,9 @@ void TimeoutManager::UpdateBudget(const TimeStamp& aNow,
         GetMinBudget(isBackground),
         TimeDuration::Min(GetMaxBudget(isBackground),
                           mExecutionBudget - aDuration + regenerated));
+    if (StaticPrefs::dom_timeout_enable_group_budget_timer_throttling()) {
+      UpdateGroupBudget(aNow, aDuration, isBackground);
+    }
   } else {
     // If budget throttling isn't enabled, reset the execution budget
     // to the max budget specified in preferences. Always doing this
@@ -399,6 +405,46 @@ void TimeoutManager::UpdateBudget(const TimeStamp& aNow,
   mLastBudgetUpdate = aNow;
 }
 
+void TimeoutManager::UpdateGroupBudget(const TimeStamp& aNow,
+                                       const TimeDuration& aDuration,
+                                       bool aIsBackground) {
+  dom::DocGroup* docGroup = GetDocGroup();
+  if (!docGroup) {
+    return;
+  }
+
+  // The DocGroup budget regenerates just like the per-window budget, but
+  // every window in the group debits it, so the documents of one origin
+  // are throttled as a unit no matter how many frames the origin spreads
+  // its timeouts over. The regeneration rate of the window asking for the
+  // update is used; the windows of a DocGroup are generally foreground or
+  // background together.
+  TimeDuration budget = GetMaxBudget(aIsBackground);
+  if (!docGroup->GetLastTimeoutBudgetUpdate().IsNull()) {
+    double factor = GetRegenerationFactor(aIsBackground);
+    TimeDuration regenerated =
+        (aNow - docGroup->GetLastTimeoutBudgetUpdate()).MultDouble(factor);
+    budget = TimeDuration::Max(
+        GetMinBudget(aIsBackground),
+        TimeDuration::Min(GetMaxBudget(aIsBackground),
+                          docGroup->GetTimeoutExecutionBudget() - aDuration +
+                              regenerated));
+  }
+  docGroup->SetTimeoutExecutionBudget(budget);
+  docGroup->SetLastTimeoutBudgetUpdate(aNow);
+}
+
+TimeDuration TimeoutManager::EffectiveExecutionBudget() const {
+  TimeDuration budget = mExecutionBudget;
+  if (StaticPrefs::dom_timeout_enable_group_budget_timer_throttling()) {
+    dom::DocGroup* docGroup = GetDocGroup();
+    if (docGroup && !docGroup->GetLastTimeoutBudgetUpdate().IsNull()) {
+      budget = TimeDuration::Min(budget, docGroup->GetTimeoutExecutionBudget());
+    }
+  }
+  return budget;
+}
+
 // The longest interval (as PRIntervalTime) we permit, or that our
 // timer code can handle, really. See DELAY_INTERVAL_LIMIT in
 // nsTimerImpl.h for details.
@@ -633,8 +679,9 @@ void TimeoutManager::RunTimeout(const TimeStamp& aNow,
   uint32_t totalTimeLimitMS =
       std::max(1u, StaticPrefs::dom_timeout_max_consecutive_callbacks_ms());
   const TimeDuration totalTimeLimit =
-      TimeDuration::Min(TimeDuration::FromMilliseconds(totalTimeLimitMS),
-                        TimeDuration::Max(TimeDuration(), mExecutionBudget));
+      TimeDuration::Min(
+          TimeDuration::FromMilliseconds(totalTimeLimitMS),
+          TimeDuration::Max(TimeDuration(), EffectiveExecutionBudget()));
 
   // Allow up to 25% of our total time budget to be used figuring out which
   // timers need to run.  This is the initial loop in this method.
@@ -956,7 +1003,7 @@ void TimeoutManager::RunTimeout(const TimeStamp& aNow,
               // reschedule. By cancelling the executor we will not run
               // immediately, but instead reschedule to the minimum
               // scheduling delay.
-              if (mExecutionBudget < TimeDuration()) {
+              if (EffectiveExecutionBudget() < TimeDuration()) {
                 mExecutor->Cancel();
               }
 
@@ -20,6 +20,7 @@ class PerformanceCounter;
 
 namespace dom {
 
+class DocGroup;
 class TimeoutExecutor;
 class TimeoutHandler;
 
@@ -135,6 +136,16 @@ class TimeoutManager final {
   void UpdateBudget(const TimeStamp& aNow,
                     const TimeDuration& aDuration = TimeDuration());
 
+  void UpdateGroupBudget(const TimeStamp& aNow, const TimeDuration& aDuration,
+                         bool aIsBackground);
+
+  // The execution budget we throttle and limit callbacks against: the
+  // per-window budget, further capped by the budget shared across the
+  // window's DocGroup when group budget throttling is enabled.
+  TimeDuration EffectiveExecutionBudget() const;
+
+  DocGroup* GetDocGroup() const;
+
   mozilla::PerformanceCounter* GetPerformanceCounter();
 
  private:
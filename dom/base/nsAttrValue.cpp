@@ -644,6 +644,15 @@ void nsAttrValue::ToString(nsAString& aResult) const {
       break;
     }
   }
+
+  if (cont && IsSVGType(cont->mType) && !aResult.IsEmpty()) {
+    // SVG values set via the SVG DOM are stored without a serialization, so
+    // we only get here if one had to be computed from the typed value. Cache
+    // it so that subsequent reads don't serialize again; this mirrors what
+    // the eCSSDeclaration case above does. Parse-time values store their
+    // serialization up front and return early from GetString above.
+    const_cast<nsAttrValue*>(this)->SetMiscAtomOrString(&aResult);
+  }
 }
 
 already_AddRefed<nsAtom> nsAttrValue::GetAsAtom() const {
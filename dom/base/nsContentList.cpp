@@ -675,13 +675,62 @@ void nsContentList::ContentInserted(nsIContent* aChild) {
   // Note that aChild->GetParentNode() can be null here if we are inserting into
   // the document itself; any attempted optimizations to this method should deal
   // with that.
-  if (mState != LIST_DIRTY &&
-      MayContainRelevantNodes(aChild->GetParentNode()) &&
-      nsContentUtils::IsInSameAnonymousTree(mRootNode, aChild) &&
-      MatchSelf(aChild)) {
+  if (mState == LIST_DIRTY ||
+      !MayContainRelevantNodes(aChild->GetParentNode()) ||
+      !nsContentUtils::IsInSameAnonymousTree(mRootNode, aChild) ||
+      !MatchSelf(aChild)) {
+    ASSERT_IN_SYNC;
+    return;
+  }
+
+  /*
+   * For a deep list MayContainRelevantNodes accepts any container, so make
+   * sure the insertion really happened within our subtree before trying to
+   * repair the list; an up-to-date list must never pick up out-of-scope
+   * elements.
+   *
+   * If we're lazy, the insertion point may lie beyond the part of the tree
+   * we have populated so far, in which case none of this content belongs in
+   * our list yet. Don't bother trying to work that out.
+   */
+  if (mState == LIST_LAZY ||
+      (mDeep && !aChild->IsInclusiveDescendantOf(mRootNode))) {
     SetDirty();
+    ASSERT_IN_SYNC;
+    return;
   }
 
+  /*
+   * We're up to date, so rather than throwing away the whole list and
+   * rescanning our subtree on the next access, splice the matching elements
+   * in at the right position. The new subtree's matches form a contiguous
+   * run, and none of our current elements can be inside it, so a single
+   * binary search over tree order finds the insertion point.
+   */
+  AutoTArray<nsIContent*, 8> newElements;
+  if (aChild->IsElement() && Match(aChild->AsElement())) {
+    newElements.AppendElement(aChild);
+  }
+  if (mDeep) {
+    for (nsIContent* cur = aChild->GetFirstChild(); cur;
+         cur = cur->GetNextNode(aChild)) {
+      if (cur->IsElement() && Match(cur->AsElement())) {
+        newElements.AppendElement(cur);
+      }
+    }
+  }
+
+  uint32_t lo = 0, hi = mElements.Length();
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) / 2;
+    if (nsContentUtils::PositionIsBefore(mElements[mid], aChild)) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  mElements.InsertElementsAt(lo, newElements);
+
   ASSERT_IN_SYNC;
 }
 
@@ -691,7 +740,20 @@ void nsContentList::ContentRemoved(nsIContent* aChild,
       MayContainRelevantNodes(aChild->GetParentNode()) &&
       nsContentUtils::IsInSameAnonymousTree(mRootNode, aChild) &&
       MatchSelf(aChild)) {
-    SetDirty();
+    if (mState == LIST_UP_TO_DATE) {
+      /*
+       * Instead of invalidating the whole list, just drop the elements that
+       * were inside the removed subtree; everything else is unaffected by
+       * the removal. This keeps the list usable for the common pattern of
+       * interleaved removals and queries.
+       */
+      mElements.RemoveElementsBy(
+          [aChild](const nsCOMPtr<nsIContent>& aElement) {
+            return aElement->IsInclusiveDescendantOf(aChild);
+          });
+    } else {
+      SetDirty();
+    }
   }
 
   ASSERT_IN_SYNC;
@@ -2716,6 +2716,27 @@ int32_t nsContentUtils::ComparePoints_Deprecated(
     const nsINode* child1 = parents1.ElementAt(--pos1);
     const nsINode* child2 = parents2.ElementAt(--pos2);
     if (child1 != child2) {
+      // The two points are often close to each other, e.g. when a selection
+      // is extended by a few nodes.  Try to determine the order of the two
+      // siblings with a short walk in both directions before falling back to
+      // computing full child indices.
+      static const uint32_t kMaxSiblingWalk = 32;
+      const nsINode* next = child1;
+      const nsINode* prev = child1;
+      for (uint32_t i = 0; i < kMaxSiblingWalk && (next || prev); ++i) {
+        if (next) {
+          next = next->GetNextSibling();
+          if (next == child2) {
+            return -1;
+          }
+        }
+        if (prev) {
+          prev = prev->GetPreviousSibling();
+          if (prev == child2) {
+            return 1;
+          }
+        }
+      }
       int32_t child1index = aParent1Cache
                                 ? aParent1Cache->ComputeIndexOf(parent, child1)
                                 : parent->ComputeIndexOf(child1);
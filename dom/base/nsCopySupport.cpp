@@ -97,7 +97,8 @@ static nsresult EncodeForTextUnicode(nsIDocumentEncoder& aEncoder,
   nsAutoString mimeType;
   mimeType.AssignLiteral(kUnicodeMime);
 
-  // Do the first and potentially trial encoding as preformatted and raw.
+  // Encode as preformatted and raw; this is only the final output for text
+  // widget selections, see below.
   uint32_t flags = aAdditionalEncoderFlags |
                    nsIDocumentEncoder::OutputPreformatted |
                    nsIDocumentEncoder::OutputRaw |
@@ -115,22 +116,20 @@ static nsresult EncodeForTextUnicode(nsIDocumentEncoder& aEncoder,
   NS_ENSURE_SUCCESS(rv, rv);
   bool selForcedTextPlain = mimeType.EqualsLiteral(kTextMime);
 
-  nsAutoString buf;
-  rv = aEncoder.EncodeToString(buf);
-  NS_ENSURE_SUCCESS(rv, rv);
-
-  rv = aEncoder.GetMimeType(mimeType);
-  NS_ENSURE_SUCCESS(rv, rv);
-
-  // The mime type is ultimately text/html if the encoder successfully encoded
-  // the selection as text/html.
-  aEncodedAsTextHTMLResult = mimeType.EqualsLiteral(kHTMLMime);
+  // Otherwise the copy encoder encodes as text/html, except when the document
+  // isn't an HTML document, in which case it switches to text/plain when the
+  // encoding starts. Both conditions are decided by SetSelection, so the
+  // ultimate mime type is known here already; this used to be determined by
+  // running a full trial encoding and throwing its output away, which for
+  // large selections doubled the serialization work.
+  aEncodedAsTextHTMLResult = !selForcedTextPlain && aDocument.IsHTMLDocument();
 
   if (selForcedTextPlain) {
-    // Nothing to do.  buf contains the final, preformatted, raw text/plain.
-    aSerializationResult.Assign(buf);
+    // The preformatted, raw text/plain serialization is the final output.
+    rv = aEncoder.EncodeToString(aSerializationResult);
+    NS_ENSURE_SUCCESS(rv, rv);
   } else {
-    // Redo the encoding, but this time use pretty printing.
+    // Re-initialize and encode the plain text flavor with pretty printing.
     flags =
         nsIDocumentEncoder::OutputSelectionOnly |
         nsIDocumentEncoder::OutputAbsoluteLinks |
@@ -40,6 +40,9 @@ AutoTArray<AutoTArray<RefPtr<nsDOMMutationObserver>, 4>, 4>*
 nsINodeList* nsDOMMutationRecord::AddedNodes() {
   if (!mAddedNodes) {
     mAddedNodes = new nsSimpleContentList(mTarget);
+    if (mSingleAddedNode) {
+      mAddedNodes->AppendElement(mSingleAddedNode);
+    }
   }
   return mAddedNodes;
 }
@@ -47,6 +50,9 @@ nsINodeList* nsDOMMutationRecord::AddedNodes() {
 nsINodeList* nsDOMMutationRecord::RemovedNodes() {
   if (!mRemovedNodes) {
     mRemovedNodes = new nsSimpleContentList(mTarget);
+    if (mSingleRemovedNode) {
+      mRemovedNodes->AppendElement(mSingleRemovedNode);
+    }
   }
   return mRemovedNodes;
 }
@@ -61,6 +67,7 @@ NS_IMPL_CYCLE_COLLECTING_RELEASE(nsDOMMutationRecord)
 
 NS_IMPL_CYCLE_COLLECTION_WRAPPERCACHE(nsDOMMutationRecord, mTarget,
                                       mPreviousSibling, mNextSibling,
+                                      mSingleAddedNode, mSingleRemovedNode,
                                       mAddedNodes, mRemovedNodes,
                                       mAddedAnimations, mRemovedAnimations,
                                       mChangedAnimations, mNext, mOwner)
@@ -159,11 +166,9 @@ void nsMutationReceiver::NativeAnonymousChildListChange(nsIContent* aContent,
   m->mTarget = parent;
 
   if (aIsRemove) {
-    m->mRemovedNodes = new nsSimpleContentList(parent);
-    m->mRemovedNodes->AppendElement(aContent);
+    m->mSingleRemovedNode = aContent;
   } else {
-    m->mAddedNodes = new nsSimpleContentList(parent);
-    m->mAddedNodes->AppendElement(aContent);
+    m->mSingleAddedNode = aContent;
   }
 }
 
@@ -277,8 +282,7 @@ void nsMutationReceiver::ContentInserted(nsIContent* aChild) {
     return;
   }
   m->mTarget = parent;
-  m->mAddedNodes = new nsSimpleContentList(parent);
-  m->mAddedNodes->AppendElement(aChild);
+  m->mSingleAddedNode = aChild;
   m->mPreviousSibling = aChild->GetPreviousSibling();
   m->mNextSibling = aChild->GetNextSibling();
 }
@@ -360,8 +364,7 @@ void nsMutationReceiver::ContentRemoved(nsIContent* aChild,
     MOZ_ASSERT(parent);
 
     m->mTarget = parent;
-    m->mRemovedNodes = new nsSimpleContentList(parent);
-    m->mRemovedNodes->AppendElement(aChild);
+    m->mSingleRemovedNode = aChild;
     m->mPreviousSibling = aPreviousSibling;
     m->mNextSibling = aPreviousSibling ? aPreviousSibling->GetNextSibling()
                                        : parent->GetFirstChild();
@@ -1024,6 +1027,7 @@ void nsAutoMutationBatch::Done() {
     RefPtr<nsSimpleContentList> removedList;
     if (wantsChildList) {
       removedList = new nsSimpleContentList(mBatchTarget);
+      removedList->SetCapacity(mRemovedNodes.Length());
     }
 
     nsTArray<nsMutationReceiver*> allObservers;
@@ -1060,6 +1064,7 @@ void nsAutoMutationBatch::Done() {
     if (wantsChildList && (mRemovedNodes.Length() || mAddedNodes.Length())) {
       RefPtr<nsSimpleContentList> addedList =
           new nsSimpleContentList(mBatchTarget);
+      addedList->SetCapacity(mAddedNodes.Length());
       for (uint32_t i = 0; i < mAddedNodes.Length(); ++i) {
         addedList->AppendElement(mAddedNodes[i]);
       }
@@ -103,6 +103,11 @@ class nsDOMMutationRecord final : public nsISupports, public nsWrapperCache {
   RefPtr<nsAtom> mAttrName;
   nsString mAttrNamespace;
   nsString mPrevValue;
+  // Most childList records describe a single inserted or removed node.
+  // Such a node is stored here and the NodeList reflecting it is only
+  // materialized by AddedNodes()/RemovedNodes() if script asks for it.
+  nsCOMPtr<nsIContent> mSingleAddedNode;
+  nsCOMPtr<nsIContent> mSingleRemovedNode;
   RefPtr<nsSimpleContentList> mAddedNodes;
   RefPtr<nsSimpleContentList> mRemovedNodes;
   nsCOMPtr<nsINode> mPreviousSibling;
@@ -8,6 +8,8 @@
 
 #include "GeckoProfiler.h"
 #include "ipc/IPCMessageUtilsSpecializations.h"
+#include "mozilla/Atomics.h"
+#include "mozilla/IntegerPrintfMacros.h"
 #include "mozilla/ProfilerMarkers.h"
 #include "mozilla/Telemetry.h"
 #include "mozilla/TimeStamp.h"
@@ -34,10 +36,13 @@ LazyLogModule gPageLoadLog("PageLoad");
 
 }  // namespace mozilla
 
+static Atomic<uint64_t> gNavigationId(0);
+
 nsDOMNavigationTiming::nsDOMNavigationTiming(nsDocShell* aDocShell) {
   Clear();
 
   mDocShell = aDocShell;
+  mNavigationId = ++gNavigationId;
 }
 
 nsDOMNavigationTiming::~nsDOMNavigationTiming() = default;
@@ -58,10 +63,31 @@ void nsDOMNavigationTiming::Clear() {
   mDOMComplete = TimeStamp();
   mContentfulPaint = TimeStamp();
   mNonBlankPaint = TimeStamp();
+  mInitialFrameConstruction = TimeStamp();
 
   mDocShellHasBeenActiveSinceNavigationStart = false;
 }
 
+void nsDOMNavigationTiming::MaybeLogNavigationSpan(
+    const char* aPhase, const TimeStamp& aEnd) const {
+  if (!PAGELOAD_LOG_ENABLED() || mNavigationStart.IsNull() || aEnd.IsNull()) {
+    return;
+  }
+
+  nsAutoCString spec;
+  if (mLoadedURI) {
+    mLoadedURI->GetSpec(spec);
+  }
+
+  // One JSON object per line, correlated by navigation id, so the log can be
+  // turned into a navigation waterfall without a devtools session.
+  PAGELOAD_LOG(
+      ("{\"navigationId\":%" PRIu64 ",\"phase\":\"%s\",\"ms\":%.3f,"
+       "\"url\":\"%s\"}",
+       mNavigationId, aPhase, (aEnd - mNavigationStart).ToMilliseconds(),
+       spec.get()));
+}
+
 void nsDOMNavigationTiming::Anonymize(nsIURI* aFinalURI) {
   mLoadedURI = aFinalURI;
   mUnloadedURI = nullptr;
@@ -87,6 +113,7 @@ void nsDOMNavigationTiming::NotifyNavigationStart(
       (aDocShellState == DocShellState::eActive);
   PROFILER_MARKER_UNTYPED("Navigation::Start", DOM,
                           MarkerInnerWindowIdFromDocShell(mDocShell));
+  MaybeLogNavigationSpan("navigationStart", mNavigationStart);
 }
 
 void nsDOMNavigationTiming::NotifyFetchStart(nsIURI* aURI,
@@ -136,6 +163,7 @@ void nsDOMNavigationTiming::NotifyLoadEventStart() {
                   MarkerOptions(MarkerTiming::IntervalStart(),
                                 MarkerInnerWindowIdFromDocShell(mDocShell)),
                   Tracing, "Navigation");
+  MaybeLogNavigationSpan("loadEventStart", mLoadEventStart);
 
   if (IsTopLevelContentDocumentInContentProcess()) {
     TimeStamp now = TimeStamp::Now();
@@ -168,6 +196,7 @@ void nsDOMNavigationTiming::NotifyLoadEventEnd() {
                   MarkerOptions(MarkerTiming::IntervalEnd(),
                                 MarkerInnerWindowIdFromDocShell(mDocShell)),
                   Tracing, "Navigation");
+  MaybeLogNavigationSpan("loadEventEnd", mLoadEventEnd);
 
   if (IsTopLevelContentDocumentInContentProcess()) {
     if (profiler_can_accept_markers() || PAGELOAD_LOG_ENABLED()) {
@@ -210,6 +239,7 @@ void nsDOMNavigationTiming::NotifyDOMLoading(nsIURI* aURI) {
 
   PROFILER_MARKER_UNTYPED("Navigation::DOMLoading", DOM,
                           MarkerInnerWindowIdFromDocShell(mDocShell));
+  MaybeLogNavigationSpan("domLoading", mDOMLoading);
 }
 
 void nsDOMNavigationTiming::NotifyDOMInteractive(nsIURI* aURI) {
@@ -221,6 +251,7 @@ void nsDOMNavigationTiming::NotifyDOMInteractive(nsIURI* aURI) {
 
   PROFILER_MARKER_UNTYPED("Navigation::DOMInteractive", DOM,
                           MarkerInnerWindowIdFromDocShell(mDocShell));
+  MaybeLogNavigationSpan("domInteractive", mDOMInteractive);
 }
 
 void nsDOMNavigationTiming::NotifyDOMComplete(nsIURI* aURI) {
@@ -232,6 +263,7 @@ void nsDOMNavigationTiming::NotifyDOMComplete(nsIURI* aURI) {
 
   PROFILER_MARKER_UNTYPED("Navigation::DOMComplete", DOM,
                           MarkerInnerWindowIdFromDocShell(mDocShell));
+  MaybeLogNavigationSpan("domComplete", mDOMComplete);
 }
 
 void nsDOMNavigationTiming::NotifyDOMContentLoadedStart(nsIURI* aURI) {
@@ -246,6 +278,8 @@ void nsDOMNavigationTiming::NotifyDOMContentLoadedStart(nsIURI* aURI) {
                   MarkerOptions(MarkerTiming::IntervalStart(),
                                 MarkerInnerWindowIdFromDocShell(mDocShell)),
                   Tracing, "Navigation");
+  MaybeLogNavigationSpan("domContentLoadedEventStart",
+                         mDOMContentLoadedEventStart);
 
   if (IsTopLevelContentDocumentInContentProcess()) {
     TimeStamp now = TimeStamp::Now();
@@ -280,6 +314,7 @@ void nsDOMNavigationTiming::NotifyDOMContentLoadedEnd(nsIURI* aURI) {
                   MarkerOptions(MarkerTiming::IntervalEnd(),
                                 MarkerInnerWindowIdFromDocShell(mDocShell)),
                   Tracing, "Navigation");
+  MaybeLogNavigationSpan("domContentLoadedEventEnd", mDOMContentLoadedEventEnd);
 
   if (IsTopLevelContentDocumentInContentProcess()) {
     Telemetry::AccumulateTimeDelta(Telemetry::TIME_TO_DOM_CONTENT_LOADED_END_MS,
@@ -389,6 +424,20 @@ void nsDOMNavigationTiming::TTITimeout(nsITimer* aTimer) {
   }
 }
 
+void nsDOMNavigationTiming::NotifyInitialFrameConstruction() {
+  MOZ_ASSERT(NS_IsMainThread());
+
+  if (!mInitialFrameConstruction.IsNull()) {
+    return;
+  }
+
+  mInitialFrameConstruction = TimeStamp::Now();
+
+  PROFILER_MARKER_UNTYPED("Navigation::FrameConstruction", DOM,
+                          MarkerInnerWindowIdFromDocShell(mDocShell));
+  MaybeLogNavigationSpan("frameConstruction", mInitialFrameConstruction);
+}
+
 void nsDOMNavigationTiming::NotifyNonBlankPaintForRootContentDocument() {
   MOZ_ASSERT(NS_IsMainThread());
   MOZ_ASSERT(!mNavigationStart.IsNull());
@@ -398,6 +447,7 @@ void nsDOMNavigationTiming::NotifyNonBlankPaintForRootContentDocument() {
   }
 
   mNonBlankPaint = TimeStamp::Now();
+  MaybeLogNavigationSpan("nonBlankPaint", mNonBlankPaint);
 
   if (profiler_thread_is_being_profiled() || PAGELOAD_LOG_ENABLED()) {
     TimeDuration elapsed = mNonBlankPaint - mNavigationStart;
@@ -446,6 +496,7 @@ void nsDOMNavigationTiming::NotifyContentfulPaintForRootContentDocument(
   }
 
   mContentfulPaint = aCompositeEndTime;
+  MaybeLogNavigationSpan("contentfulPaint", mContentfulPaint);
 
   if (profiler_can_accept_markers() || PAGELOAD_LOG_ENABLED()) {
     TimeDuration elapsed = mContentfulPaint - mNavigationStart;
@@ -578,7 +629,9 @@ nsDOMNavigationTiming::nsDOMNavigationTiming(nsDocShell* aDocShell,
       mDOMContentLoadedEventStart(aOther->mDOMContentLoadedEventStart),
       mDOMContentLoadedEventEnd(aOther->mDOMContentLoadedEventEnd),
       mDOMComplete(aOther->mDOMComplete),
+      mInitialFrameConstruction(aOther->mInitialFrameConstruction),
       mTTFI(aOther->mTTFI),
+      mNavigationId(aOther->mNavigationId),
       mDocShellHasBeenActiveSinceNavigationStart(
           aOther->mDocShellHasBeenActiveSinceNavigationStart) {}
 
@@ -605,7 +658,9 @@ void mozilla::ipc::IPDLParamTraits<nsDOMNavigationTiming*>::Write(
   WriteIPDLParam(aMsg, aActor, aParam->mDOMContentLoadedEventStart);
   WriteIPDLParam(aMsg, aActor, aParam->mDOMContentLoadedEventEnd);
   WriteIPDLParam(aMsg, aActor, aParam->mDOMComplete);
+  WriteIPDLParam(aMsg, aActor, aParam->mInitialFrameConstruction);
   WriteIPDLParam(aMsg, aActor, aParam->mTTFI);
+  WriteIPDLParam(aMsg, aActor, aParam->mNavigationId);
   WriteIPDLParam(aMsg, aActor,
                  aParam->mDocShellHasBeenActiveSinceNavigationStart);
 }
@@ -637,7 +692,10 @@ bool mozilla::ipc::IPDLParamTraits<nsDOMNavigationTiming*>::Read(
                      &timing->mDOMContentLoadedEventStart) ||
       !ReadIPDLParam(aMsg, aIter, aActor, &timing->mDOMContentLoadedEventEnd) ||
       !ReadIPDLParam(aMsg, aIter, aActor, &timing->mDOMComplete) ||
+      !ReadIPDLParam(aMsg, aIter, aActor,
+                     &timing->mInitialFrameConstruction) ||
       !ReadIPDLParam(aMsg, aIter, aActor, &timing->mTTFI) ||
+      !ReadIPDLParam(aMsg, aIter, aActor, &timing->mNavigationId) ||
       !ReadIPDLParam(aMsg, aIter, aActor,
                      &timing->mDocShellHasBeenActiveSinceNavigationStart)) {
     return false;
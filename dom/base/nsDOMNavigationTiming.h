@@ -169,6 +169,7 @@ class nsDOMNavigationTiming final : public mozilla::RelativeTimeline {
   void TTITimeout(nsITimer* aTimer);
 
   void NotifyLongTask(mozilla::TimeStamp aWhen);
+  void NotifyInitialFrameConstruction();
   void NotifyNonBlankPaintForRootContentDocument();
   void NotifyContentfulPaintForRootContentDocument(
       const mozilla::TimeStamp& aCompositeEndTime);
@@ -195,6 +196,7 @@ class nsDOMNavigationTiming final : public mozilla::RelativeTimeline {
     RefPtr<nsDOMNavigationTiming> timing = new nsDOMNavigationTiming(aDocShell);
     timing->mNavigationStartHighRes = mNavigationStartHighRes;
     timing->mNavigationStart = mNavigationStart;
+    timing->mNavigationId = mNavigationId;
     return timing.forget();
   }
 
@@ -204,6 +206,10 @@ class nsDOMNavigationTiming final : public mozilla::RelativeTimeline {
 
   mozilla::TimeStamp LoadEventEnd() { return mLoadEventEnd; }
 
+  // Identifier correlating the per-phase span records this navigation logs
+  // to the "PageLoad" log module. Unique within a process.
+  uint64_t GetNavigationId() const { return mNavigationId; }
+
  private:
   friend class nsDocShell;
   nsDOMNavigationTiming(nsDocShell* aDocShell, nsDOMNavigationTiming* aOther);
@@ -217,6 +223,12 @@ class nsDOMNavigationTiming final : public mozilla::RelativeTimeline {
 
   bool IsTopLevelContentDocumentInContentProcess() const;
 
+  // Logs one JSON object line to the "PageLoad" log module for the given
+  // phase, with the time relative to navigation start, correlated by
+  // mNavigationId.
+  void MaybeLogNavigationSpan(const char* aPhase,
+                              const mozilla::TimeStamp& aEnd) const;
+
   // Should those be amended, the IPC serializer should be updated
   // accordingly.
   mozilla::WeakPtr<nsDocShell> mDocShell;
@@ -244,8 +256,12 @@ class nsDOMNavigationTiming final : public mozilla::RelativeTimeline {
   mozilla::TimeStamp mDOMContentLoadedEventEnd;
   mozilla::TimeStamp mDOMComplete;
 
+  mozilla::TimeStamp mInitialFrameConstruction;
+
   mozilla::TimeStamp mTTFI;
 
+  uint64_t mNavigationId;
+
   bool mDocShellHasBeenActiveSinceNavigationStart;
 
   friend struct mozilla::ipc::IPDLParamTraits<nsDOMNavigationTiming*>;
@@ -3060,7 +3060,7 @@ already_AddRefed<nsINode> nsINode::CloneAndAdopt(
     nsINode* aNode, bool aClone, bool aDeep,
     nsNodeInfoManager* aNewNodeInfoManager,
     JS::Handle<JSObject*> aReparentScope, nsINode* aParent,
-    ErrorResult& aError) {
+    CloneAndAdoptNodeInfoMemo& aNodeInfoMemo, ErrorResult& aError) {
   MOZ_ASSERT((!aClone && aNewNodeInfoManager) || !aReparentScope,
              "If cloning or not getting a new nodeinfo we shouldn't rewrap");
   MOZ_ASSERT(!aParent || aNode->IsContent(),
@@ -3098,10 +3098,19 @@ already_AddRefed<nsINode> nsINode::CloneAndAdopt(
       }
     }
 
-    newNodeInfo = nodeInfoManager->GetNodeInfo(
-        nodeInfo->NameAtom(), nodeInfo->GetPrefixAtom(),
-        nodeInfo->NamespaceID(), nodeInfo->NodeType(),
-        nodeInfo->GetExtraName());
+    if (aNodeInfoMemo.mManager == nodeInfoManager &&
+        aNodeInfoMemo.mOld == nodeInfo) {
+      newNodeInfo = aNodeInfoMemo.mNew;
+    } else {
+      newNodeInfo = nodeInfoManager->GetNodeInfo(
+          nodeInfo->NameAtom(), nodeInfo->GetPrefixAtom(),
+          nodeInfo->NamespaceID(), nodeInfo->NodeType(),
+          nodeInfo->GetExtraName());
+
+      aNodeInfoMemo.mManager = nodeInfoManager;
+      aNodeInfoMemo.mOld = nodeInfo;
+      aNodeInfoMemo.mNew = newNodeInfo;
+    }
 
     nodeInfo = newNodeInfo;
   }
@@ -3286,7 +3295,7 @@ already_AddRefed<nsINode> nsINode::CloneAndAdopt(
          cloneChild = cloneChild->GetNextSibling()) {
       nsCOMPtr<nsINode> child =
           CloneAndAdopt(cloneChild, aClone, true, nodeInfoManager,
-                        aReparentScope, clone, aError);
+                        aReparentScope, clone, aNodeInfoMemo, aError);
       if (NS_WARN_IF(aError.Failed())) {
         return nullptr;
       }
@@ -3317,7 +3326,8 @@ already_AddRefed<nsINode> nsINode::CloneAndAdopt(
                origChild; origChild = origChild->GetNextSibling()) {
             nsCOMPtr<nsINode> child =
                 CloneAndAdopt(origChild, aClone, aDeep, nodeInfoManager,
-                              aReparentScope, newShadowRoot, aError);
+                              aReparentScope, newShadowRoot, aNodeInfoMemo,
+                              aError);
             if (NS_WARN_IF(aError.Failed())) {
               return nullptr;
             }
@@ -3328,7 +3338,7 @@ already_AddRefed<nsINode> nsINode::CloneAndAdopt(
       if (ShadowRoot* shadowRoot = aNode->AsElement()->GetShadowRoot()) {
         nsCOMPtr<nsINode> child =
             CloneAndAdopt(shadowRoot, aClone, aDeep, nodeInfoManager,
-                          aReparentScope, clone, aError);
+                          aReparentScope, clone, aNodeInfoMemo, aError);
         if (NS_WARN_IF(aError.Failed())) {
           return nullptr;
         }
@@ -3352,7 +3362,7 @@ already_AddRefed<nsINode> nsINode::CloneAndAdopt(
          cloneChild = cloneChild->GetNextSibling()) {
       nsCOMPtr<nsINode> child =
           CloneAndAdopt(cloneChild, aClone, aDeep, ownerNodeInfoManager,
-                        aReparentScope, cloneContent, aError);
+                        aReparentScope, cloneContent, aNodeInfoMemo, aError);
       if (NS_WARN_IF(aError.Failed())) {
         return nullptr;
       }
@@ -3388,8 +3398,10 @@ void nsINode::Adopt(nsNodeInfoManager* aNewNodeInfoManager,
 
   // Just need to store the return value of CloneAndAdopt in a
   // temporary nsCOMPtr to make sure we release it.
-  nsCOMPtr<nsINode> node = CloneAndAdopt(this, false, true, aNewNodeInfoManager,
-                                         aReparentScope, nullptr, aError);
+  CloneAndAdoptNodeInfoMemo nodeInfoMemo;
+  nsCOMPtr<nsINode> node =
+      CloneAndAdopt(this, false, true, aNewNodeInfoManager, aReparentScope,
+                    nullptr, nodeInfoMemo, aError);
 
   nsMutationGuard::DidMutate();
 }
@@ -3397,8 +3409,9 @@ void nsINode::Adopt(nsNodeInfoManager* aNewNodeInfoManager,
 already_AddRefed<nsINode> nsINode::Clone(bool aDeep,
                                          nsNodeInfoManager* aNewNodeInfoManager,
                                          ErrorResult& aError) {
+  CloneAndAdoptNodeInfoMemo nodeInfoMemo;
   return CloneAndAdopt(this, true, aDeep, aNewNodeInfoManager, nullptr, nullptr,
-                       aError);
+                       nodeInfoMemo, aError);
 }
 
 void nsINode::GenerateXPath(nsAString& aResult) {
@@ -1133,6 +1133,21 @@ class nsINode : public mozilla::dom::EventTarget {
   T* FirstAncestorOfType() const;
 
  private:
+  /**
+   * Memo used by CloneAndAdopt to avoid a nodeinfo manager hash lookup per
+   * node. Cloned and adopted subtrees usually contain long runs of nodes
+   * sharing a nodeinfo -- sibling elements of the same tag, and every text
+   * node -- so a single-entry cache hits most of the time. This matters for
+   * repeated template stamping, where the same subtree is cloned over and
+   * over. The old nodeinfo is held strongly so a stale entry can never alias
+   * a newly allocated nodeinfo.
+   */
+  struct CloneAndAdoptNodeInfoMemo {
+    nsNodeInfoManager* mManager = nullptr;
+    RefPtr<mozilla::dom::NodeInfo> mOld;
+    RefPtr<mozilla::dom::NodeInfo> mNew;
+  };
+
   /**
    * Walks aNode, its attributes and, if aDeep is true, its descendant nodes.
    * If aClone is true the nodes will be cloned. If aNewNodeInfoManager is
@@ -1153,6 +1168,8 @@ class nsINode : public mozilla::dom::EventTarget {
    * @param aParent If aClone is true the cloned node will be appended to
    *                aParent's children. May be null. If not null then aNode
    *                must be an nsIContent.
+   * @param aNodeInfoMemo Cache of the last nodeinfo mapping, shared by the
+   *                      whole recursive walk.
    * @param aError The error, if any.
    *
    * @return If aClone is true then the cloned node will be returned,
@@ -1163,7 +1180,7 @@ class nsINode : public mozilla::dom::EventTarget {
       nsINode* aNode, bool aClone, bool aDeep,
       nsNodeInfoManager* aNewNodeInfoManager,
       JS::Handle<JSObject*> aReparentScope, nsINode* aParent,
-      mozilla::ErrorResult& aError);
+      CloneAndAdoptNodeInfoMemo& aNodeInfoMemo, mozilla::ErrorResult& aError);
 
  public:
   /**
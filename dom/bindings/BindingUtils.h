@@ -2314,6 +2314,22 @@ bool EnumerateOwnProperties(JSContext* cx, JS::Handle<JSObject*> wrapper,
                             JS::Handle<JSObject*> obj,
                             JS::MutableHandleVector<jsid> props);
 
+// Get the value of a dictionary member from aObject.  Dictionaries are
+// usually plain objects holding data properties, so try an effect-free
+// lookup first and only fall back to the generic property-get machinery
+// when the lookup could have observable side effects (getters, proxy
+// traps, resolve hooks).  The behavior is identical to JS_GetPropertyById
+// in either case.
+inline bool GetDictionaryMemberProperty(JSContext* aCx,
+                                        JS::Handle<JSObject*> aObject,
+                                        JS::Handle<jsid> aId,
+                                        JS::MutableHandle<JS::Value> aValue) {
+  if (js::MaybeGetPropertyPure(aCx, aObject, aId, aValue.address())) {
+    return true;
+  }
+  return JS_GetPropertyById(aCx, aObject, aId, aValue);
+}
+
 }  // namespace binding_detail
 
 /**
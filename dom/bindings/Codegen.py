@@ -17259,7 +17259,10 @@ class CGDictionary(CGThing):
                 replacements["haveValue"] = "!isNull && !temp->isUndefined()"
 
         propId = self.makeIdName(member.identifier.name)
-        propGet = "JS_GetPropertyById(cx, *object, atomsCache->%s, temp.ptr())" % propId
+        propGet = (
+            "binding_detail::GetDictionaryMemberProperty(cx, *object, atomsCache->%s, temp.ptr())"
+            % propId
+        )
 
         conversionReplacements = {
             "prop": self.makeMemberName(member.identifier.name),
@@ -73,6 +73,12 @@ class CanvasPath final : public nsWrapperCache {
   static gfx::Float ToFloat(double aValue) { return gfx::Float(aValue); }
 
   mutable RefPtr<gfx::Path> mPath;
+  // Copy of mPath built for a different backend or fill rule than mPath
+  // itself, retained so that drawing an unchanged Path2D with alternating
+  // winding rules (or into targets with different backends) doesn't
+  // re-stream the geometry on every fill/stroke. Cleared whenever the path
+  // is mutated.
+  mutable RefPtr<gfx::Path> mRetargetedPath;
   mutable RefPtr<gfx::PathBuilder> mPathBuilder;
 
   void EnsurePathBuilder() const;
@@ -90,9 +90,12 @@
 #include "mozilla/gfx/Tools.h"
 #include "mozilla/gfx/PathHelpers.h"
 #include "mozilla/gfx/DataSurfaceHelpers.h"
+#include "mozilla/gfx/DrawEventRecorder.h"
+#include "mozilla/gfx/InlineTranslator.h"
 #include "mozilla/gfx/PatternHelpers.h"
 #include "mozilla/gfx/Swizzle.h"
 #include "mozilla/layers/PersistentBufferProvider.h"
+#include "mozilla/HashFunctions.h"
 #include "mozilla/MathAlgorithms.h"
 #include "mozilla/Preferences.h"
 #include "mozilla/ServoBindings.h"
@@ -970,6 +973,12 @@ CanvasRenderingContext2D::CanvasRenderingContext2D(
       mResetLayer(true),
       mIPC(false),
       mHasPendingStableStateCallback(false),
+      mLastRecordingHash(0),
+      mLastRecordingLength(0),
+      mLastRecordingValid(false),
+      mLastFrameIndependent(false),
+      mFrameIndependent(false),
+      mRecordingFlushedMidFrame(false),
       mIsEntireFrameInvalid(false),
       mPredictManyRedrawCalls(false),
       mIsCapturedFrameInvalid(false),
@@ -1042,6 +1051,13 @@ nsresult CanvasRenderingContext2D::Reset() {
   mTarget = nullptr;
   mBufferProvider = nullptr;
 
+  // The buffer is going away, so the cached replay no longer matches its
+  // content.
+  mRecorder = nullptr;
+  mBackingTarget = nullptr;
+  mLastRecordingValid = false;
+  mRecordingFlushedMidFrame = false;
+
   // reset hit regions
   mHitRegionsOptions.ClearAndRetainStorage();
 
@@ -1297,7 +1313,13 @@ bool CanvasRenderingContext2D::EnsureTarget(const gfx::Rect* aCoveredRect,
   if (mBufferProvider) {
     mTarget = mBufferProvider->BorrowDrawTarget(persistedRect);
 
-    if (mTarget && !mBufferProvider->PreservesDrawingState()) {
+    if (mTarget && mTarget->IsValid()) {
+      MaybeRecordTarget(canDiscardContent);
+    }
+
+    // A fresh recording wrapper doesn't inherit the preserved state of the
+    // provider's draw target, so the state has to be replayed onto it too.
+    if (mTarget && (mRecorder || !mBufferProvider->PreservesDrawingState())) {
       RestoreClipsAndTransformToTarget();
     }
 
@@ -1347,6 +1369,8 @@ bool CanvasRenderingContext2D::EnsureTarget(const gfx::Rect* aCoveredRect,
 
   RegisterAllocation();
 
+  MaybeRecordTarget(canDiscardContent);
+
   RestoreClipsAndTransformToTarget();
 
   // Force a full layer transaction since we didn't have a layer before
@@ -1364,6 +1388,90 @@ bool CanvasRenderingContext2D::EnsureTarget(const gfx::Rect* aCoveredRect,
   return true;
 }
 
+void CanvasRenderingContext2D::MaybeRecordTarget(bool aFrameIndependent) {
+  if (!StaticPrefs::gfx_canvas_replay_cache_enabled()) {
+    return;
+  }
+
+  // The cache relies on the buffer keeping its content between frames, so
+  // that skipping a replay leaves the previous frame's raster in place. Only
+  // the basic buffer provider guarantees that; shared providers may hand out
+  // a different or uninitialized buffer on each borrow.
+  if (!mBufferProvider ||
+      mBufferProvider->GetType() != LayersBackend::LAYERS_BASIC ||
+      mTarget->GetBackendType() != BackendType::SKIA) {
+    return;
+  }
+
+  // Each frame gets its own recorder so that the command stream is
+  // self-contained: fonts and surfaces are stored per recorder, and the
+  // translator can only resolve objects created within the stream.
+  RefPtr<DrawEventRecorderMemory> recorder = new DrawEventRecorderMemory();
+  RefPtr<DrawTarget> recording = Factory::CreateRecordingDrawTarget(
+      recorder, mTarget, IntRect(IntPoint(), GetSize()));
+  if (!recording || !recording->IsValid()) {
+    return;
+  }
+
+  mBackingTarget = mTarget.forget();
+  mTarget = recording.forget();
+  mRecorder = recorder.forget();
+  mFrameIndependent = aFrameIndependent;
+}
+
+void CanvasRenderingContext2D::FinishRecording(bool aFrameComplete) {
+  if (!mRecorder) {
+    return;
+  }
+
+  MOZ_ASSERT(mBackingTarget);
+
+  const MemStream& stream = mRecorder->mOutputStream;
+  if (!stream.mValid) {
+    // We ran out of memory while recording. The frame's commands are lost;
+    // all we can do is drop the recording and invalidate the cache.
+    gfxWarning() << "Dropping invalid canvas 2D recording.";
+    mLastRecordingValid = false;
+  } else {
+    uint32_t hash = HashBytes(stream.mData, stream.mLength);
+
+    // Replaying an identical stream only reproduces the buffer's previous
+    // content if both this frame and the last one started out by discarding
+    // the entire canvas; otherwise the commands blend with whatever the
+    // previous frame left behind. Note that the stream embeds object
+    // identities, so two identical frames that happen to allocate
+    // differently will hash differently; that only costs us the skip, the
+    // replay itself is always correct.
+    bool canSkipReplay = aFrameComplete && mLastRecordingValid &&
+                         mFrameIndependent && mLastFrameIndependent &&
+                         stream.mLength == mLastRecordingLength &&
+                         hash == mLastRecordingHash;
+
+    bool replayed = true;
+    if (!canSkipReplay) {
+      InlineTranslator translator(mBackingTarget);
+      replayed = translator.TranslateRecording(stream.mData, stream.mLength);
+      if (!aFrameComplete) {
+        // The translation pushed this frame's clips directly onto the
+        // provider's target; ReturnTarget will have to pop them again.
+        mRecordingFlushedMidFrame = true;
+      }
+    }
+
+    // An incomplete frame keeps drawing directly onto the buffer after this,
+    // so the buffer won't correspond to any recorded stream once it is
+    // returned.
+    mLastRecordingValid = replayed && aFrameComplete;
+    mLastRecordingHash = hash;
+    mLastRecordingLength = stream.mLength;
+  }
+
+  mLastFrameIndependent = mFrameIndependent && aFrameComplete;
+
+  mTarget = mBackingTarget.forget();
+  mRecorder = nullptr;
+}
+
 void CanvasRenderingContext2D::SetInitialState() {
   // Set up the initial canvas defaults
   mPathBuilder = nullptr;
@@ -1389,6 +1497,10 @@ void CanvasRenderingContext2D::SetErrorState() {
 
   mTarget = sErrorTarget;
   mBufferProvider = nullptr;
+  mRecorder = nullptr;
+  mBackingTarget = nullptr;
+  mLastRecordingValid = false;
+  mRecordingFlushedMidFrame = false;
 
   // clear transforms, clips, etc.
   SetInitialState();
@@ -1558,7 +1670,11 @@ void CanvasRenderingContext2D::ClearTarget(int32_t aWidth, int32_t aHeight) {
 void CanvasRenderingContext2D::ReturnTarget(bool aForceReset) {
   if (mTarget && mBufferProvider && mTarget != sErrorTarget) {
     CurrentState().transform = mTarget->GetTransform();
-    if (aForceReset || !mBufferProvider->PreservesDrawingState()) {
+    // A recording wrapper starts every frame with a clean state, as does a
+    // target that had a recording replayed onto it mid-frame, so their clips
+    // always have to be popped even if the provider preserves drawing state.
+    if (aForceReset || mRecorder || mRecordingFlushedMidFrame ||
+        !mBufferProvider->PreservesDrawingState()) {
       for (const auto& style : mStyleStack) {
         for (const auto& clipOrTransform : style.clipsAndTransforms) {
           if (clipOrTransform.IsClip()) {
@@ -1577,6 +1693,9 @@ void CanvasRenderingContext2D::ReturnTarget(bool aForceReset) {
       mTarget->SetTransform(Matrix());
     }
 
+    FinishRecording(/* aFrameComplete */ true);
+    mRecordingFlushedMidFrame = false;
+
     mBufferProvider->ReturnDrawTarget(mTarget.forget());
   }
 }
@@ -1661,6 +1780,10 @@ UniquePtr<uint8_t[]> CanvasRenderingContext2D::GetImageBuffer(
     }
   }
 
+  // Make sure any pending recorded commands make it into the buffer before
+  // we read it back.
+  FinishRecording(/* aFrameComplete */ false);
+
   RefPtr<SourceSurface> snapshot = mBufferProvider->BorrowSnapshot();
   if (snapshot) {
     RefPtr<DataSourceSurface> data = snapshot->GetDataSurface();
@@ -1724,6 +1847,10 @@ CanvasRenderingContext2D::GetSurfaceSnapshot(gfxAlphaType* aOutAlphaType) {
     return mTarget ? mTarget->Snapshot() : nullptr;
   }
 
+  // Flush any recording onto the provider's target so the snapshot reflects
+  // everything drawn so far.
+  FinishRecording(/* aFrameComplete */ false);
+
   // The concept of BorrowSnapshot seems a bit broken here, but the original
   // code in GetSurfaceSnapshot just returned a snapshot from mTarget, which
   // amounts to breaking the concept implicitly.
@@ -5104,6 +5231,10 @@ nsresult CanvasRenderingContext2D::GetImageDataArray(
     }
   }
 
+  // The readback below goes to the provider's buffer, so any recorded
+  // commands have to be replayed onto it first.
+  FinishRecording(/* aFrameComplete */ false);
+
   RefPtr<SourceSurface> snapshot = mBufferProvider->BorrowSnapshot();
   if (!snapshot) {
     return NS_ERROR_OUT_OF_MEMORY;
@@ -5807,17 +5938,26 @@ already_AddRefed<gfx::Path> CanvasPath::GetPath(
     mPathBuilder = nullptr;
   }
 
-  // retarget our backend if we're used with a different backend
+  if (mRetargetedPath &&
+      (mRetargetedPath->GetBackendType() == aTarget->GetBackendType()) &&
+      (mRetargetedPath->GetFillRule() == fillRule)) {
+    RefPtr<gfx::Path> path(mRetargetedPath);
+    return path.forget();
+  }
+
+  // retarget our backend if we're used with a different backend; keep mPath
+  // as built so that alternating requests (say a nonzero stroke and an
+  // even-odd fill of the same Path2D) don't re-stream the geometry each time
   if (mPath->GetBackendType() != aTarget->GetBackendType()) {
     RefPtr<PathBuilder> tmpPathBuilder = aTarget->CreatePathBuilder(fillRule);
     mPath->StreamToSink(tmpPathBuilder);
-    mPath = tmpPathBuilder->Finish();
+    mRetargetedPath = tmpPathBuilder->Finish();
   } else if (mPath->GetFillRule() != fillRule) {
     RefPtr<PathBuilder> tmpPathBuilder = mPath->CopyToBuilder(fillRule);
-    mPath = tmpPathBuilder->Finish();
+    mRetargetedPath = tmpPathBuilder->Finish();
   }
 
-  RefPtr<gfx::Path> path(mPath);
+  RefPtr<gfx::Path> path(mRetargetedPath);
   return path.forget();
 }
 
@@ -5830,6 +5970,7 @@ void CanvasPath::EnsurePathBuilder() const {
   MOZ_ASSERT(mPath);
   mPathBuilder = mPath->CopyToBuilder();
   mPath = nullptr;
+  mRetargetedPath = nullptr;
 }
 
 size_t BindingJSObjectMallocBytes(CanvasRenderingContext2D* aContext) {
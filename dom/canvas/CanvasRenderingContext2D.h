@@ -30,6 +30,10 @@ namespace mozilla {
 class ErrorResult;
 class PresShell;
 
+namespace gfx {
+class DrawEventRecorderMemory;
+}  // namespace gfx
+
 namespace gl {
 class SourceSurface;
 }  // namespace gl
@@ -653,6 +657,27 @@ class CanvasRenderingContext2D final : public nsICanvasRenderingContextInternal,
    */
   void ReturnTarget(bool aForceReset = false);
 
+  /**
+   * When the replay cache is enabled (gfx.canvas.replay-cache.enabled),
+   * replaces mTarget with a recording wrapper around the buffer provider's
+   * draw target, so that FinishRecording can compare this frame's command
+   * stream against the previous frame's.
+   *
+   * aFrameIndependent is true when the first drawing command of the frame
+   * covers the entire canvas, i.e. the frame's output does not depend on the
+   * previous frame's content.
+   */
+  void MaybeRecordTarget(bool aFrameIndependent);
+
+  /**
+   * Replays the commands recorded since MaybeRecordTarget onto the buffer
+   * provider's draw target and restores mTarget to it. When aFrameComplete
+   * is true and the command stream is identical to the previous frame's,
+   * the replay is skipped entirely since the buffer already contains the
+   * resulting raster.
+   */
+  void FinishRecording(bool aFrameComplete);
+
   /**
    * Check if the target is valid after calling EnsureTarget.
    */
@@ -728,6 +753,28 @@ class CanvasRenderingContext2D final : public nsICanvasRenderingContextInternal,
 
   RefPtr<mozilla::layers::PersistentBufferProvider> mBufferProvider;
 
+  // State for the recorded-command replay cache. While a frame is being
+  // recorded, mTarget is a recording wrapper around the buffer provider's
+  // draw target, which is kept in mBackingTarget. Cf. MaybeRecordTarget and
+  // FinishRecording.
+  RefPtr<mozilla::gfx::DrawEventRecorderMemory> mRecorder;
+  RefPtr<mozilla::gfx::DrawTarget> mBackingTarget;
+  // Hash and length of the last fully replayed (or skipped) command stream.
+  uint32_t mLastRecordingHash;
+  size_t mLastRecordingLength;
+  // Whether mBackingTarget's buffer still holds the raster that the last
+  // recorded command stream produced.
+  bool mLastRecordingValid;
+  // Whether the last frame, respectively the frame currently being recorded,
+  // started out by discarding the entire canvas.
+  bool mLastFrameIndependent;
+  bool mFrameIndependent;
+  // Set when a recording was replayed onto the buffer provider's target in
+  // the middle of a frame (e.g. for a snapshot), in which case ReturnTarget
+  // has to pop the replayed clips even though the provider preserves drawing
+  // state.
+  bool mRecordingFlushedMidFrame;
+
   RefPtr<CanvasShutdownObserver> mShutdownObserver;
   void RemoveShutdownObserver();
   bool AlreadyShutDown() const { return !mShutdownObserver; }
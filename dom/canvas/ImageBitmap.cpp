@@ -822,7 +822,10 @@ already_AddRefed<ImageBitmap> ImageBitmap::CreateInternal(
   if ((aCanvasEl.GetCurrentContextType() == CanvasContextType::WebGL1 ||
        aCanvasEl.GetCurrentContextType() == CanvasContextType::WebGL2 ||
        aCanvasEl.GetCurrentContextType() == CanvasContextType::WebGPU) &&
-      aCropRect.isSome()) {
+      aCropRect.isSome() &&
+      !cropRect.IsEqualEdges(IntRect(IntPoint(0, 0), surface->GetSize()))) {
+    // The snapshot copy is only needed when actually cropping; a crop rect
+    // covering the whole snapshot can use it as-is.
     RefPtr<DataSourceSurface> dataSurface = surface->GetDataSurface();
     croppedSurface = CropAndCopyDataSourceSurface(dataSurface, cropRect);
     cropRect.MoveTo(0, 0);
@@ -1590,7 +1593,13 @@ CreateImageBitmapFromBlob::OnImageReady(imgIContainer* aImgContainer,
   // Crop the source surface if needed.
   RefPtr<SourceSurface> croppedSurface = surface;
 
-  if (mCropRect.isSome()) {
+  if (mCropRect.isSome() &&
+      mCropRect->IsEqualEdges(IntRect(IntPoint(0, 0), mSourceSize))) {
+    // The crop rect covers the whole decoded frame, and the decoded buffer
+    // is only used by this ImageBitmap, so the crop copy would be
+    // byte-for-byte; use the decoded frame directly.
+    mCropRect->MoveTo(0, 0);
+  } else if (mCropRect.isSome()) {
     // The blob is just decoded into a RasterImage and not optimized yet, so the
     // _surface_ we get is a DataSourceSurface which wraps the RasterImage's
     // raw buffer.
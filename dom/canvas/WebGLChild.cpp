@@ -19,6 +19,7 @@ WebGLChild::~WebGLChild() { (void)Send__delete__(this); }
 
 void WebGLChild::ActorDestroy(ActorDestroyReason why) {
   mPendingCmdsShmem = {};
+  mRecycledCmdsShmem = {};
 }
 
 // -
@@ -30,14 +31,20 @@ Maybe<Range<uint8_t>> WebGLChild::AllocPendingCmdBytes(const size_t size) {
       capacity = size;
     }
 
-    auto shmem = webgl::RaiiShmem::Alloc(
-        this, capacity,
-        mozilla::ipc::SharedMemory::SharedMemoryType::TYPE_BASIC);
-    if (!shmem) {
-      NS_WARNING("Failed to alloc shmem for AllocPendingCmdBytes.");
-      return {};
+    if (mRecycledCmdsShmem &&
+        mRecycledCmdsShmem.ByteRange().length() >= capacity) {
+      // The parent has handed this one back, so it's done reading it.
+      mPendingCmdsShmem = std::move(mRecycledCmdsShmem);
+    } else {
+      auto shmem = webgl::RaiiShmem::Alloc(
+          this, capacity,
+          mozilla::ipc::SharedMemory::SharedMemoryType::TYPE_BASIC);
+      if (!shmem) {
+        NS_WARNING("Failed to alloc shmem for AllocPendingCmdBytes.");
+        return {};
+      }
+      mPendingCmdsShmem = std::move(shmem);
     }
-    mPendingCmdsShmem = std::move(shmem);
     mPendingCmdsPos = 0;
 
     if (kIsDebug) {
@@ -81,6 +88,18 @@ void WebGLChild::FlushPendingCmds() {
 
 // -
 
+mozilla::ipc::IPCResult WebGLChild::RecvReturnPendingCmdsShmem(
+    mozilla::ipc::Shmem&& rawShmem) {
+  auto shmem = webgl::RaiiShmem(this, rawShmem);
+  // Keep at most one returned buffer around. Together with the one being
+  // filled that's a two-deep ring, which is enough to keep allocation off
+  // the steady-state flush path.
+  if (!mRecycledCmdsShmem) {
+    mRecycledCmdsShmem = std::move(shmem);
+  }
+  return IPC_OK();
+}
+
 mozilla::ipc::IPCResult WebGLChild::RecvJsWarning(
     const std::string& text) const {
   if (!mContext) return IPC_OK();
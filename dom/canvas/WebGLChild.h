@@ -38,6 +38,11 @@ class WebGLChild final : public PWebGLChild, public SupportsWeakPtr {
   webgl::RaiiShmem mPendingCmdsShmem;
   size_t mPendingCmdsPos = 0;
   FlushedCmdInfo mFlushedCmdInfo;
+  // The last commands shmem the parent handed back after consuming it.
+  // Reusing it instead of allocating a fresh shmem per flush gives us a
+  // double-buffered ring: one buffer being filled while the other is in
+  // flight, with the return message acting as the reuse fence.
+  webgl::RaiiShmem mRecycledCmdsShmem;
 
  public:
   NS_INLINE_DECL_THREADSAFE_REFCOUNTING(WebGLChild, override);
@@ -56,6 +61,7 @@ class WebGLChild final : public PWebGLChild, public SupportsWeakPtr {
  public:
   mozilla::ipc::IPCResult RecvJsWarning(const std::string&) const;
   mozilla::ipc::IPCResult RecvOnContextLoss(webgl::ContextLossReason) const;
+  mozilla::ipc::IPCResult RecvReturnPendingCmdsShmem(mozilla::ipc::Shmem&&);
 };
 
 }  // namespace dom
@@ -5,6 +5,7 @@
 
 #include "WebGLParent.h"
 
+#include "mozilla/Unused.h"
 #include "WebGLChild.h"
 #include "mozilla/layers/LayerTransactionParent.h"
 #include "mozilla/layers/TextureClientSharedSurface.h"
@@ -70,6 +71,13 @@ IPCResult WebGLParent::RecvDispatchCommands(Shmem&& rawShmem,
     }
   }
 
+  // We're done reading the commands, so hand the shmem back for reuse
+  // rather than letting it dealloc. If the send fails the actor is going
+  // away and RaiiShmem cleans up as usual.
+  if (CanSend()) {
+    Unused << SendReturnPendingCmdsShmem(shmem.Extract());
+  }
+
   return IPC_OK();
 }
 
@@ -1222,6 +1222,22 @@ void EventListenerManager::HandleEventInternal(nsPresContext* aPresContext,
         PopupBlocker::GetEventPopupControlState(aEvent, *aDOMEvent));
   }
 
+  // Maybe add markers to the docshell's timeline, but only bother with
+  // all the logic if some docshell is recording. Neither the docshell nor
+  // the set of timeline consumers can change while we iterate the
+  // listeners, so resolve them once here rather than per listener call.
+  nsCOMPtr<nsIDocShell> docShell;
+  RefPtr<TimelineConsumers> timelines;
+  if (mIsMainThreadELM) {
+    timelines = TimelineConsumers::Get();
+    if (timelines && !timelines->IsEmpty()) {
+      docShell = nsContentUtils::GetDocShellForEventTarget(mTarget);
+      if (docShell && !timelines->HasConsumer(docShell)) {
+        docShell = nullptr;
+      }
+    }
+  }
+
   bool hasListener = false;
   bool hasListenerForCurrentGroup = false;
   bool usingLegacyMessage = false;
@@ -1266,26 +1282,16 @@ void EventListenerManager::HandleEventInternal(nsPresContext* aPresContext,
               legacyAutoOverride.emplace(*aDOMEvent, eventMessage);
             }
 
-            // Maybe add a marker to the docshell's timeline, but only
-            // bother with all the logic if some docshell is recording.
-            nsCOMPtr<nsIDocShell> docShell;
-            RefPtr<TimelineConsumers> timelines = TimelineConsumers::Get();
-            bool needsEndEventMarker = false;
-
-            if (mIsMainThreadELM &&
-                listener->mListenerType != Listener::eNativeListener) {
-              docShell = nsContentUtils::GetDocShellForEventTarget(mTarget);
-              if (docShell) {
-                if (timelines && timelines->HasConsumer(docShell)) {
-                  needsEndEventMarker = true;
-                  nsAutoString typeStr;
-                  (*aDOMEvent)->GetType(typeStr);
-                  uint16_t phase = (*aDOMEvent)->EventPhase();
-                  timelines->AddMarkerForDocShell(
-                      docShell, MakeUnique<EventTimelineMarker>(
-                                    typeStr, phase, MarkerTracingType::START));
-                }
-              }
+            bool needsEndEventMarker =
+                docShell &&
+                listener->mListenerType != Listener::eNativeListener;
+            if (needsEndEventMarker) {
+              nsAutoString typeStr;
+              (*aDOMEvent)->GetType(typeStr);
+              uint16_t phase = (*aDOMEvent)->EventPhase();
+              timelines->AddMarkerForDocShell(
+                  docShell, MakeUnique<EventTimelineMarker>(
+                                typeStr, phase, MarkerTracingType::START));
             }
 
             aEvent->mFlags.mInPassiveListener = listener->mFlags.mPassive;
@@ -12,6 +12,7 @@
 #include "mozilla/dom/HTMLAnchorElement.h"
 #include "mozilla/net/NeckoCommon.h"
 #include "mozilla/net/NeckoChild.h"
+#include "mozilla/net/NeckoChannelParams.h"
 #include "mozilla/OriginAttributes.h"
 #include "mozilla/StoragePrincipalHelper.h"
 #include "nsURLHelper.h"
@@ -106,7 +107,10 @@ class DeferredDNSPrefetches final : public nsIWebProgressListener,
   void Flush();
 
   void SubmitQueue();
-  void SubmitQueueEntry(Element&, uint32_t aFlags);
+  // In the content process resolved entries are appended to |aBatch| and
+  // shipped to the parent in one IPC message when the queue drain is done.
+  void SubmitQueueEntry(Element&, uint32_t aFlags,
+                        nsTArray<net::HTMLDNSPrefetchRequest>& aBatch);
 
   uint16_t mHead;
   uint16_t mTail;
@@ -446,23 +450,32 @@ void DeferredDNSPrefetches::SubmitQueue() {
     return;
   }
 
+  // A landing page can defer dozens of prefetches; batch them up so the
+  // parent is woken once for the whole queue instead of once per hostname.
+  nsTArray<net::HTMLDNSPrefetchRequest> batch;
+
   for (; mHead != mTail; mTail = (mTail + 1) & sMaxDeferredMask) {
     Element* element = mEntries[mTail].mElement;
     if (!element) {
       continue;
     }
-    SubmitQueueEntry(*element, mEntries[mTail].mFlags);
+    SubmitQueueEntry(*element, mEntries[mTail].mFlags, batch);
     mEntries[mTail].mElement = nullptr;
   }
 
+  if (!batch.IsEmpty() && gNeckoChild) {
+    gNeckoChild->SendHTMLDNSPrefetchBatch(batch);
+  }
+
   if (mTimerArmed) {
     mTimerArmed = false;
     mTimer->Cancel();
   }
 }
 
-void DeferredDNSPrefetches::SubmitQueueEntry(Element& aElement,
-                                             uint32_t aFlags) {
+void DeferredDNSPrefetches::SubmitQueueEntry(
+    Element& aElement, uint32_t aFlags,
+    nsTArray<net::HTMLDNSPrefetchRequest>& aBatch) {
   auto& supports = ToSupportsDNSPrefetch(aElement);
   supports.ClearIsInDNSPrefetch();
 
@@ -498,8 +511,9 @@ void DeferredDNSPrefetches::SubmitQueueEntry(Element& aElement,
   if (IsNeckoChild()) {
     // during shutdown gNeckoChild might be null
     if (gNeckoChild) {
-      gNeckoChild->SendHTMLDNSPrefetch(NS_ConvertUTF8toUTF16(hostName), isHttps,
-                                       oa, mEntries[mTail].mFlags);
+      aBatch.AppendElement(net::HTMLDNSPrefetchRequest(
+          NS_ConvertUTF8toUTF16(hostName), isHttps, oa,
+          mEntries[mTail].mFlags));
     }
   } else {
     nsCOMPtr<nsICancelable> tmpOutstanding;
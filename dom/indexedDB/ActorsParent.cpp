@@ -83,6 +83,7 @@
 #include "mozilla/Scoped.h"
 #include "mozilla/SnappyCompressOutputStream.h"
 #include "mozilla/SpinEventLoopUntil.h"
+#include "mozilla/StaticPrefs_dom.h"
 #include "mozilla/StaticPtr.h"
 #include "mozilla/TaskCategory.h"
 #include "mozilla/TimeStamp.h"
@@ -1156,6 +1157,12 @@ class DatabaseConnection final : public CachingDatabaseConnection {
   bool mInReadTransaction;
   bool mInWriteTransaction;
 
+  // True when one or more write transactions have been committed into the
+  // current SQLite transaction without that transaction being committed to
+  // disk yet. See CommitWriteTransaction.
+  bool mGroupCommitPending;
+  uint32_t mGroupCommitCount;
+
 #ifdef DEBUG
   uint32_t mDEBUGSavepointCount;
 #endif
@@ -1171,7 +1178,12 @@ class DatabaseConnection final : public CachingDatabaseConnection {
 
   nsresult BeginWriteTransaction();
 
-  nsresult CommitWriteTransaction();
+  // When aAllowGroupCommit is true and the group commit pref is enabled, the
+  // SQLite COMMIT may be deferred and batched with the commits of directly
+  // following write transactions against this connection, trading the
+  // durability of the individual transactions for a single journal sync per
+  // batch.
+  nsresult CommitWriteTransaction(bool aAllowGroupCommit);
 
   void RollbackWriteTransaction();
 
@@ -1206,6 +1218,12 @@ class DatabaseConnection final : public CachingDatabaseConnection {
 
   nsresult Init();
 
+  // Commits a pending group commit to disk and restores the connection's
+  // normal read transaction. The pending state is cleared whether or not the
+  // COMMIT succeeds, because on failure SQLite has rolled the transaction
+  // back.
+  nsresult FlushGroupCommit();
+
   nsresult CheckpointInternal(CheckpointMode aMode);
 
   Result<uint32_t, nsresult> GetFreelistCount(
@@ -4339,6 +4357,12 @@ class CursorBase : public PBackgroundIDBCursorParent {
 
   const int32_t mMaxExtraCount;
 
+  // The number of consecutive sequential continue requests that reached the
+  // parent for this cursor, i.e. that the child could not serve from
+  // preloaded records. Used to grow the preload window while the cursor keeps
+  // iterating. Only touched on the PBackground thread.
+  uint32_t mConsecutiveContinueCount = 0;
+
   const bool mIsSameProcessActor;
 
   struct ConstructFromTransactionBase {};
@@ -4777,10 +4801,11 @@ class Cursor<CursorType>::ContinueOp final
 
   // Only created by Cursor.
   ContinueOp(Cursor* const aCursor, CursorRequestParams aParams,
-             CursorPosition<CursorType> aPosition)
+             CursorPosition<CursorType> aPosition, uint32_t aMaxExtraCount)
       : CursorOpBase(aCursor),
         mParams(std::move(aParams)),
-        mCurrentPosition{std::move(aPosition)} {
+        mCurrentPosition{std::move(aPosition)},
+        mMaxExtraCount(aMaxExtraCount) {
     MOZ_ASSERT(mParams.type() != CursorRequestParams::T__None);
   }
 
@@ -4790,6 +4815,10 @@ class Cursor<CursorType>::ContinueOp final
   nsresult DoDatabaseWork(DatabaseConnection* aConnection) override;
 
   const CursorPosition<CursorType> mCurrentPosition;
+
+  // The number of extra records to preload, computed by RecvContinue from the
+  // cursor's preload window at the time the request was received.
+  const uint32_t mMaxExtraCount;
 };
 
 class Utils final : public PBackgroundIndexedDBUtilsParent {
@@ -6893,7 +6922,9 @@ DatabaseConnection::DatabaseConnection(
     : CachingDatabaseConnection(std::move(aStorageConnection)),
       mFileManager(std::move(aFileManager)),
       mInReadTransaction(false),
-      mInWriteTransaction(false)
+      mInWriteTransaction(false),
+      mGroupCommitPending(false),
+      mGroupCommitCount(0)
 #ifdef DEBUG
       ,
       mDEBUGSavepointCount(0)
@@ -6925,11 +6956,26 @@ nsresult DatabaseConnection::Init() {
 nsresult DatabaseConnection::BeginWriteTransaction() {
   AssertIsOnConnectionThread();
   MOZ_ASSERT(HasStorageConnection());
-  MOZ_ASSERT(mInReadTransaction);
-  MOZ_ASSERT(!mInWriteTransaction);
 
   AUTO_PROFILER_LABEL("DatabaseConnection::BeginWriteTransaction", DOM);
 
+  if (mGroupCommitPending) {
+    // The previous write transaction's commit is still being held back, so the
+    // SQLite transaction is already open. Set a savepoint so that this
+    // transaction can be rolled back on its own without taking the already
+    // committed ones with it.
+    MOZ_ASSERT(!mInReadTransaction);
+    MOZ_ASSERT(mInWriteTransaction);
+    MOZ_ASSERT(mUpdateRefcountFunction);
+
+    QM_TRY(ExecuteCachedStatement("SAVEPOINT group_commit;"_ns));
+
+    return NS_OK;
+  }
+
+  MOZ_ASSERT(mInReadTransaction);
+  MOZ_ASSERT(!mInWriteTransaction);
+
   // Release our read locks.
   QM_TRY(ExecuteCachedStatement("ROLLBACK;"_ns));
 
@@ -6988,7 +7034,7 @@ nsresult DatabaseConnection::BeginWriteTransaction() {
   return NS_OK;
 }
 
-nsresult DatabaseConnection::CommitWriteTransaction() {
+nsresult DatabaseConnection::CommitWriteTransaction(bool aAllowGroupCommit) {
   AssertIsOnConnectionThread();
   MOZ_ASSERT(HasStorageConnection());
   MOZ_ASSERT(!mInReadTransaction);
@@ -6996,8 +7042,34 @@ nsresult DatabaseConnection::CommitWriteTransaction() {
 
   AUTO_PROFILER_LABEL("DatabaseConnection::CommitWriteTransaction", DOM);
 
+  if (aAllowGroupCommit && StaticPrefs::dom_indexedDB_group_commit_enabled()) {
+    if (mGroupCommitPending) {
+      // This transaction's work was done under a savepoint, release it into
+      // the enclosing SQLite transaction.
+      QM_TRY(ExecuteCachedStatement("RELEASE group_commit;"_ns));
+    }
+
+    // If more work is already queued for this connection then the next write
+    // transaction may be among it, so hold the commit back and let it ride
+    // along with the next one. This keeps the added latency at zero: the
+    // commit is only deferred while the thread would stay busy anyway, and
+    // DoIdleProcessing/Close flush any remainder.
+    nsIThread* currentThread = NS_GetCurrentThread();
+    MOZ_ASSERT(currentThread);
+
+    if (mGroupCommitCount + 1 <
+            StaticPrefs::dom_indexedDB_group_commit_max_transactions() &&
+        NS_HasPendingEvents(currentThread)) {
+      mGroupCommitPending = true;
+      mGroupCommitCount++;
+      return NS_OK;
+    }
+  }
+
   QM_TRY(ExecuteCachedStatement("COMMIT;"_ns));
 
+  mGroupCommitPending = false;
+  mGroupCommitCount = 0;
   mInWriteTransaction = false;
   return NS_OK;
 }
@@ -7013,6 +7085,29 @@ void DatabaseConnection::RollbackWriteTransaction() {
     return;
   }
 
+  if (mGroupCommitPending) {
+    // Earlier write transactions have already been committed into the open
+    // SQLite transaction, so only roll back to the savepoint that
+    // BeginWriteTransaction set for this one.
+    QM_TRY_INSPECT(
+        const auto& stmt,
+        BorrowCachedStatement("ROLLBACK TO group_commit;"_ns), QM_VOID);
+
+    if (NS_SUCCEEDED(stmt->Execute())) {
+      QM_WARNONLY_TRY(ExecuteCachedStatement("RELEASE group_commit;"_ns));
+      return;
+    }
+
+    // SQLite rolled the whole transaction back (this can happen on certain
+    // errors regardless of savepoints), taking the held-back commits with it.
+    NS_WARNING("Group commit was rolled back together with a failed write!");
+
+    mGroupCommitPending = false;
+    mGroupCommitCount = 0;
+    mInWriteTransaction = false;
+    return;
+  }
+
   QM_WARNONLY_TRY(
       BorrowCachedStatement("ROLLBACK;"_ns)
           .andThen([&self = *this](const auto& stmt) -> Result<Ok, nsresult> {
@@ -7034,7 +7129,7 @@ void DatabaseConnection::FinishWriteTransaction() {
   AssertIsOnConnectionThread();
   MOZ_ASSERT(HasStorageConnection());
   MOZ_ASSERT(!mInReadTransaction);
-  MOZ_ASSERT(!mInWriteTransaction);
+  MOZ_ASSERT_IF(!mGroupCommitPending, !mInWriteTransaction);
 
   AUTO_PROFILER_LABEL("DatabaseConnection::FinishWriteTransaction", DOM);
 
@@ -7042,11 +7137,47 @@ void DatabaseConnection::FinishWriteTransaction() {
     mUpdateRefcountFunction->Reset();
   }
 
+  if (mGroupCommitPending) {
+    // The SQLite transaction stays open until the group commit is flushed, so
+    // don't start a read transaction yet.
+    return;
+  }
+
+  QM_WARNONLY_TRY(ToResult(ExecuteCachedStatement("BEGIN;"_ns))
+                      .andThen([&](const auto) -> Result<Ok, nsresult> {
+                        mInReadTransaction = true;
+                        return Ok{};
+                      }));
+}
+
+nsresult DatabaseConnection::FlushGroupCommit() {
+  AssertIsOnConnectionThread();
+  MOZ_ASSERT(HasStorageConnection());
+  MOZ_ASSERT(mGroupCommitPending);
+  MOZ_ASSERT(!mInReadTransaction);
+  MOZ_ASSERT(mInWriteTransaction);
+
+  AUTO_PROFILER_LABEL("DatabaseConnection::FlushGroupCommit", DOM);
+
+  const nsresult rv = ExecuteCachedStatement("COMMIT;"_ns);
+
+  // Clear the pending state even if the COMMIT failed: in that case SQLite
+  // has rolled the transaction back and there's nothing left to flush.
+  mGroupCommitPending = false;
+  mGroupCommitCount = 0;
+  mInWriteTransaction = false;
+
+  QM_TRY(ToResult(rv));
+
+  // Restore the connection's normal read transaction, matching
+  // FinishWriteTransaction.
   QM_WARNONLY_TRY(ToResult(ExecuteCachedStatement("BEGIN;"_ns))
                       .andThen([&](const auto) -> Result<Ok, nsresult> {
                         mInReadTransaction = true;
                         return Ok{};
                       }));
+
+  return NS_OK;
 }
 
 nsresult DatabaseConnection::StartSavepoint() {
@@ -7155,6 +7286,14 @@ nsresult DatabaseConnection::CheckpointInternal(CheckpointMode aMode) {
 
 void DatabaseConnection::DoIdleProcessing(bool aNeedsCheckpoint) {
   AssertIsOnConnectionThread();
+
+  if (mGroupCommitPending) {
+    // The connection went idle with held-back commits, get them to disk before
+    // doing anything else. The code below expects the connection to be in its
+    // normal read transaction, which FlushGroupCommit restores.
+    QM_TRY(FlushGroupCommit(), QM_VOID);
+  }
+
   MOZ_ASSERT(mInReadTransaction);
   MOZ_ASSERT(!mInWriteTransaction);
 
@@ -7347,6 +7486,11 @@ Result<uint32_t, nsresult> DatabaseConnection::GetFreelistCount(
 void DatabaseConnection::Close() {
   AssertIsOnConnectionThread();
   MOZ_ASSERT(!mDEBUGSavepointCount);
+
+  if (mGroupCommitPending) {
+    QM_WARNONLY_TRY(ToResult(FlushGroupCommit()));
+  }
+
   MOZ_DIAGNOSTIC_ASSERT(!mInWriteTransaction);
 
   AUTO_PROFILER_LABEL("DatabaseConnection::Close", DOM);
@@ -12186,8 +12330,35 @@ mozilla::ipc::IPCResult Cursor<CursorType>::RecvContinue(
     return IPC_FAIL_NO_REASON(this);
   }
 
+  // A continue request that reaches the parent is one the child couldn't
+  // serve from its preloaded records. If that keeps happening for a cursor
+  // that iterates sequentially, the preload window is too small for the
+  // access pattern, so grow it exponentially, up to a factor of 16. The IPC
+  // message size limit is enforced separately when the responses are
+  // populated. Continuing to an explicit key invalidates the child's
+  // preloaded records anyway and restarts the ramp.
+  const bool hasContinueKey =
+      (aParams.type() == CursorRequestParams::TContinueParams &&
+       !aParams.get_ContinueParams().key().IsUnset()) ||
+      aParams.type() == CursorRequestParams::TContinuePrimaryKeyParams;
+
+  uint32_t maxExtraCount = 0;
+  if (hasContinueKey) {
+    this->mConsecutiveContinueCount = 0;
+  } else if (this->mMaxExtraCount) {
+    static constexpr uint32_t kMaxPreloadGrowthFactorLog2 = 4;
+
+    maxExtraCount = static_cast<uint32_t>(this->mMaxExtraCount)
+                    << std::min(this->mConsecutiveContinueCount,
+                                kMaxPreloadGrowthFactorLog2);
+
+    if (this->mConsecutiveContinueCount <= kMaxPreloadGrowthFactorLog2) {
+      ++this->mConsecutiveContinueCount;
+    }
+  }
+
   const RefPtr<ContinueOp> continueOp =
-      new ContinueOp(this, aParams, std::move(position));
+      new ContinueOp(this, aParams, std::move(position), maxExtraCount);
   if (NS_WARN_IF(!continueOp->Init(*mTransaction))) {
     continueOp->Cleanup();
     return IPC_FAIL_NO_REASON(this);
@@ -17966,7 +18137,11 @@ TransactionBase::CommitOp::Run() {
           if (NS_SUCCEEDED(mResultCode)) {
             AssertForeignKeyConsistency(connection);
 
-            mResultCode = connection->CommitWriteTransaction();
+            // Only plain readwrite transactions may take part in a group
+            // commit; version changes and flush/cleanup transactions must be
+            // durable when they're acknowledged.
+            mResultCode = connection->CommitWriteTransaction(
+                mTransaction->GetMode() == IDBTransaction::Mode::ReadWrite);
             NS_WARNING_ASSERTION(NS_SUCCEEDED(mResultCode), "Commit failed!");
 
             if (NS_SUCCEEDED(mResultCode) &&
@@ -21441,7 +21616,10 @@ nsresult Cursor<CursorType>::ContinueOp::DoDatabaseWork(
   // preload only for an assumed basic operation. Other operations would require
   // more work on the client side for invalidation, and may not make any sense
   // at all.
-  const uint32_t maxExtraCount = hasContinueKey ? 0 : mCursor->mMaxExtraCount;
+  // RecvContinue already computed mMaxExtraCount from the cursor's preload
+  // window, taking hasContinueKey into account.
+  MOZ_ASSERT_IF(hasContinueKey, !mMaxExtraCount);
+  const uint32_t maxExtraCount = mMaxExtraCount;
 
   QM_TRY_INSPECT(const auto& stmt,
                  aConnection->BorrowCachedStatement(
@@ -21449,8 +21627,7 @@ nsresult Cursor<CursorType>::ContinueOp::DoDatabaseWork(
                          hasContinueKey, hasContinuePrimaryKey)));
 
   QM_TRY(stmt->BindUTF8StringByName(
-      kStmtParamNameLimit,
-      IntToCString(advanceCount + mCursor->mMaxExtraCount)));
+      kStmtParamNameLimit, IntToCString(advanceCount + maxExtraCount)));
 
   QM_TRY(stmt->BindInt64ByName(kStmtParamNameId, mCursor->Id()));
 
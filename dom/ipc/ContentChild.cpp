@@ -2669,6 +2669,20 @@ void ContentChild::PreallocInit() {
   // SetAcceptLanguages() needs to read localized strings (file access),
   // which is slow, so do this in prealloc
   nsHttpHandler::PresetAcceptLanguages();
+
+  if (StaticPrefs::dom_ipc_processPrelaunch_prewarm()) {
+    // Map the shared UA style sheets and parse the non-shared ones now.
+    // This does file access, which is also better done before the content
+    // sandbox is fully engaged.
+    GlobalStyleSheetCache::Singleton();
+
+    // Initializing the graphics platform attaches the shared font list
+    // blocks we received with the XPCOM attributes, so an adopted process
+    // doesn't build its font data on first paint. The shared mappings (and
+    // whatever the parent already paged in) stay copy-on-write, so a parked
+    // process adds little unique memory for this.
+    Unused << gfxPlatform::GetPlatform();
+  }
 }
 
 // Call RemoteTypePrefix() on the result to remove URIs if you want to use this
@@ -191,6 +191,13 @@ static Maybe<ipc::StructuredCloneData> CaptureJSStack(JSContext* aCx) {
     JS_ClearPendingException(aCx);
   }
 
+  if (!stack) {
+    // Async stack capture is disabled (the common case) or capture failed.
+    // Don't run the structured clone machinery just to encode a null value;
+    // the receiving side treats a missing stack the same way.
+    return Nothing();
+  }
+
   return CloneJSStack(aCx, stack);
 }
 
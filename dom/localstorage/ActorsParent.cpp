@@ -1886,6 +1886,14 @@ class Snapshot final : public PBackgroundLSSnapshotParent {
    * the child LSSnapshot.
    */
   uint32_t mNextLoadIndex;
+  /**
+   * The number of RecvLoadValueAndMoreItems requests received so far.  Each
+   * such request means the child LSSnapshot exhausted the items sent to it so
+   * far, so the gradual prefill byte budget is grown exponentially with this
+   * count to amortize the per-request overhead when the whole datastore ends
+   * up being read.
+   */
+  uint32_t mLoadRequestCount;
   /**
    * The number of key/value pairs that were present in the Datastore at the
    * time the snapshot was created.  Once we have sent this many values to the
@@ -5453,6 +5461,7 @@ Snapshot::Snapshot(Database* aDatabase, const nsAString& aDocumentURI)
     : mDatabase(aDatabase),
       mDatastore(aDatabase->GetDatastore()),
       mDocumentURI(aDocumentURI),
+      mLoadRequestCount(0),
       mTotalLength(0),
       mUsage(-1),
       mPeakUsage(-1),
@@ -5751,9 +5760,22 @@ mozilla::ipc::IPCResult Snapshot::RecvLoadValueAndMoreItems(
   }
 
   // Load some more key/value pairs (as many as the snapshot gradual prefill
-  // byte budget allows).
+  // byte budget allows). The budget is doubled with every consecutive load
+  // request (up to a factor of 16), because a steady stream of load requests
+  // means the child is scanning through the datastore and every sent batch
+  // only bought us one saved sync IPC.
 
   if (gSnapshotGradualPrefill > 0) {
+    static constexpr uint32_t kMaxGradualPrefillGrowthFactorLog2 = 4;
+
+    const int64_t gradualPrefill =
+        static_cast<int64_t>(gSnapshotGradualPrefill)
+        << std::min(mLoadRequestCount, kMaxGradualPrefillGrowthFactorLog2);
+
+    if (mLoadRequestCount <= kMaxGradualPrefillGrowthFactorLog2) {
+      mLoadRequestCount++;
+    }
+
     const nsTArray<LSItemInfo>& orderedItems = mDatastore->GetOrderedItems();
 
     uint32_t length;
@@ -5814,7 +5836,7 @@ mozilla::ipc::IPCResult Snapshot::RecvLoadValueAndMoreItems(
         size += static_cast<int64_t>(key.Length()) +
                 static_cast<int64_t>(value.Length());
 
-        if (size > gSnapshotGradualPrefill) {
+        if (size > gradualPrefill) {
           mLoadedItems.RemoveEntry(loadedItemEntry);
 
           // mNextLoadIndex is not incremented, so we will resume at the same
@@ -8,6 +8,14 @@
 #include <speex/speex_resampler.h>
 #include <string.h>
 #include <cmath>
+#ifdef USE_NEON
+#  include "mozilla/arm.h"
+#  include "AudioConverterNEON.h"
+#endif
+#ifdef USE_SSE2
+#  include "mozilla/SSE.h"
+#  include "AudioConverterSSE2.h"
+#endif
 
 /*
  *  Parts derived from MythTV AudioConvert Class
@@ -316,6 +324,18 @@ size_t AudioConverter::DownmixAudio(void* aOut, const void* aIn,
   if (mIn.Format() == AudioConfig::FORMAT_FLT) {
     const float* in = static_cast<const float*>(aIn);
     float* out = static_cast<float*>(aOut);
+#ifdef USE_NEON
+    if (mozilla::supports_neon()) {
+      DownmixStereoToMono_NEON(in, out, aFrames);
+      return aFrames;
+    }
+#endif
+#ifdef USE_SSE2
+    if (mozilla::supports_sse2()) {
+      DownmixStereoToMono_SSE2(in, out, aFrames);
+      return aFrames;
+    }
+#endif
     for (size_t fIdx = 0; fIdx < aFrames; ++fIdx) {
       float sample = 0.0;
       // The sample of the buffer would be interleaved.
@@ -325,6 +345,18 @@ size_t AudioConverter::DownmixAudio(void* aOut, const void* aIn,
   } else if (mIn.Format() == AudioConfig::FORMAT_S16) {
     const int16_t* in = static_cast<const int16_t*>(aIn);
     int16_t* out = static_cast<int16_t*>(aOut);
+#ifdef USE_NEON
+    if (mozilla::supports_neon()) {
+      DownmixStereoToMono_NEON(in, out, aFrames);
+      return aFrames;
+    }
+#endif
+#ifdef USE_SSE2
+    if (mozilla::supports_sse2()) {
+      DownmixStereoToMono_SSE2(in, out, aFrames);
+      return aFrames;
+    }
+#endif
     for (size_t fIdx = 0; fIdx < aFrames; ++fIdx) {
       int32_t sample = 0.0;
       // The sample of the buffer would be interleaved.
@@ -432,6 +464,18 @@ size_t AudioConverter::UpmixAudio(void* aOut, const void* aIn,
     const float m3db = std::sqrt(0.5);  // -3dB = sqrt(1/2)
     const float* in = static_cast<const float*>(aIn);
     float* out = static_cast<float*>(aOut);
+#ifdef USE_NEON
+    if (mozilla::supports_neon()) {
+      UpmixMonoToStereo_NEON(in, out, aFrames);
+      return aFrames;
+    }
+#endif
+#ifdef USE_SSE2
+    if (mozilla::supports_sse2()) {
+      UpmixMonoToStereo_SSE2(in, out, aFrames);
+      return aFrames;
+    }
+#endif
     for (size_t fIdx = 0; fIdx < aFrames; ++fIdx) {
       float sample = in[fIdx] * m3db;
       // The samples of the buffer would be interleaved.
@@ -441,6 +485,18 @@ size_t AudioConverter::UpmixAudio(void* aOut, const void* aIn,
   } else if (mIn.Format() == AudioConfig::FORMAT_S16) {
     const int16_t* in = static_cast<const int16_t*>(aIn);
     int16_t* out = static_cast<int16_t*>(aOut);
+#ifdef USE_NEON
+    if (mozilla::supports_neon()) {
+      UpmixMonoToStereo_NEON(in, out, aFrames);
+      return aFrames;
+    }
+#endif
+#ifdef USE_SSE2
+    if (mozilla::supports_sse2()) {
+      UpmixMonoToStereo_SSE2(in, out, aFrames);
+      return aFrames;
+    }
+#endif
     for (size_t fIdx = 0; fIdx < aFrames; ++fIdx) {
       int16_t sample =
           ((int32_t)in[fIdx] * 11585) >> 14;  // close enough to i*sqrt(0.5)
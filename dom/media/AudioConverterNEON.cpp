@@ -0,0 +1,76 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "AudioConverterNEON.h"
+#if defined(_MSC_VER) && defined(_M_ARM64) && !defined(__clang__)
+#  include <arm64_neon.h>
+#else
+#  include <arm_neon.h>
+#endif
+#include <cmath>
+
+namespace mozilla {
+
+void DownmixStereoToMono_NEON(const float* aIn, float* aOut, size_t aFrames) {
+  const float32x4_t gain = vmovq_n_f32(0.5f);
+  size_t i = 0;
+  for (; i + 4 <= aFrames; i += 4) {
+    float32x4x2_t in = vld2q_f32(&aIn[i * 2]);
+    vst1q_f32(&aOut[i], vmulq_f32(vaddq_f32(in.val[0], in.val[1]), gain));
+  }
+  for (; i < aFrames; i++) {
+    aOut[i] = (aIn[i * 2] + aIn[i * 2 + 1]) * 0.5f;
+  }
+}
+
+void DownmixStereoToMono_NEON(const int16_t* aIn, int16_t* aOut,
+                              size_t aFrames) {
+  size_t i = 0;
+  for (; i + 8 <= aFrames; i += 8) {
+    int16x8x2_t in = vld2q_s16(&aIn[i * 2]);
+    // Halving add: (l + r) >> 1 without intermediate overflow.
+    vst1q_s16(&aOut[i], vhaddq_s16(in.val[0], in.val[1]));
+  }
+  for (; i < aFrames; i++) {
+    aOut[i] = (int32_t(aIn[i * 2]) + aIn[i * 2 + 1]) >> 1;
+  }
+}
+
+void UpmixMonoToStereo_NEON(const float* aIn, float* aOut, size_t aFrames) {
+  const float m3db = std::sqrt(0.5f);  // -3dB = sqrt(1/2)
+  const float32x4_t gain = vmovq_n_f32(m3db);
+  size_t i = 0;
+  for (; i + 4 <= aFrames; i += 4) {
+    float32x4_t sample = vmulq_f32(vld1q_f32(&aIn[i]), gain);
+    float32x4x2_t out = {{sample, sample}};
+    vst2q_f32(&aOut[i * 2], out);
+  }
+  for (; i < aFrames; i++) {
+    float sample = aIn[i] * m3db;
+    aOut[i * 2] = sample;
+    aOut[i * 2 + 1] = sample;
+  }
+}
+
+void UpmixMonoToStereo_NEON(const int16_t* aIn, int16_t* aOut, size_t aFrames) {
+  const int16x4_t gain = vdup_n_s16(11585);  // close enough to i*sqrt(0.5)
+  size_t i = 0;
+  for (; i + 8 <= aFrames; i += 8) {
+    int16x8_t in = vld1q_s16(&aIn[i]);
+    int32x4_t lo = vshrq_n_s32(vmull_s16(vget_low_s16(in), gain), 14);
+    int32x4_t hi = vshrq_n_s32(vmull_s16(vget_high_s16(in), gain), 14);
+    int16x8_t sample = vcombine_s16(vmovn_s32(lo), vmovn_s32(hi));
+    int16x8x2_t out = {{sample, sample}};
+    vst2q_s16(&aOut[i * 2], out);
+  }
+  for (; i < aFrames; i++) {
+    int16_t sample = (int32_t(aIn[i]) * 11585) >> 14;
+    aOut[i * 2] = sample;
+    aOut[i * 2 + 1] = sample;
+  }
+}
+
+}  // namespace mozilla
@@ -0,0 +1,22 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+#if !defined(AudioConverterNEON_h)
+#  define AudioConverterNEON_h
+
+#  include <stddef.h>
+#  include <stdint.h>
+
+namespace mozilla {
+
+void DownmixStereoToMono_NEON(const float* aIn, float* aOut, size_t aFrames);
+void DownmixStereoToMono_NEON(const int16_t* aIn, int16_t* aOut,
+                              size_t aFrames);
+void UpmixMonoToStereo_NEON(const float* aIn, float* aOut, size_t aFrames);
+void UpmixMonoToStereo_NEON(const int16_t* aIn, int16_t* aOut, size_t aFrames);
+
+}  // namespace mozilla
+
+#endif /* AudioConverterNEON_h */
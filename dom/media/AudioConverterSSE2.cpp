@@ -0,0 +1,88 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "AudioConverterSSE2.h"
+#include <emmintrin.h>
+#include <cmath>
+
+namespace mozilla {
+
+void DownmixStereoToMono_SSE2(const float* aIn, float* aOut, size_t aFrames) {
+  const __m128 gain = _mm_set1_ps(0.5f);
+  size_t i = 0;
+  for (; i + 4 <= aFrames; i += 4) {
+    __m128 in0 = _mm_loadu_ps(&aIn[i * 2]);      // L0 R0 L1 R1
+    __m128 in1 = _mm_loadu_ps(&aIn[i * 2 + 4]);  // L2 R2 L3 R3
+    __m128 left = _mm_shuffle_ps(in0, in1, _MM_SHUFFLE(2, 0, 2, 0));
+    __m128 right = _mm_shuffle_ps(in0, in1, _MM_SHUFFLE(3, 1, 3, 1));
+    _mm_storeu_ps(&aOut[i], _mm_mul_ps(_mm_add_ps(left, right), gain));
+  }
+  for (; i < aFrames; i++) {
+    aOut[i] = (aIn[i * 2] + aIn[i * 2 + 1]) * 0.5f;
+  }
+}
+
+void DownmixStereoToMono_SSE2(const int16_t* aIn, int16_t* aOut,
+                              size_t aFrames) {
+  const __m128i ones = _mm_set1_epi16(1);
+  size_t i = 0;
+  for (; i + 8 <= aFrames; i += 8) {
+    __m128i in0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&aIn[i * 2]));
+    __m128i in1 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&aIn[i * 2 + 8]));
+    // madd with 1s adds each L/R pair into a 32-bit lane, so the halving
+    // can't overflow.
+    __m128i sum0 = _mm_srai_epi32(_mm_madd_epi16(in0, ones), 1);
+    __m128i sum1 = _mm_srai_epi32(_mm_madd_epi16(in1, ones), 1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&aOut[i]),
+                     _mm_packs_epi32(sum0, sum1));
+  }
+  for (; i < aFrames; i++) {
+    aOut[i] = (int32_t(aIn[i * 2]) + aIn[i * 2 + 1]) >> 1;
+  }
+}
+
+void UpmixMonoToStereo_SSE2(const float* aIn, float* aOut, size_t aFrames) {
+  const float m3db = std::sqrt(0.5f);  // -3dB = sqrt(1/2)
+  const __m128 gain = _mm_set1_ps(m3db);
+  size_t i = 0;
+  for (; i + 4 <= aFrames; i += 4) {
+    __m128 sample = _mm_mul_ps(_mm_loadu_ps(&aIn[i]), gain);
+    _mm_storeu_ps(&aOut[i * 2], _mm_unpacklo_ps(sample, sample));
+    _mm_storeu_ps(&aOut[i * 2 + 4], _mm_unpackhi_ps(sample, sample));
+  }
+  for (; i < aFrames; i++) {
+    float sample = aIn[i] * m3db;
+    aOut[i * 2] = sample;
+    aOut[i * 2 + 1] = sample;
+  }
+}
+
+void UpmixMonoToStereo_SSE2(const int16_t* aIn, int16_t* aOut, size_t aFrames) {
+  const __m128i gain = _mm_set1_epi16(11585);  // close enough to i*sqrt(0.5)
+  size_t i = 0;
+  for (; i + 8 <= aFrames; i += 8) {
+    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&aIn[i]));
+    // Reassemble the 32-bit products from the low/high 16-bit halves, then
+    // scale back from Q14.
+    __m128i lo16 = _mm_mullo_epi16(in, gain);
+    __m128i hi16 = _mm_mulhi_epi16(in, gain);
+    __m128i prodLo = _mm_srai_epi32(_mm_unpacklo_epi16(lo16, hi16), 14);
+    __m128i prodHi = _mm_srai_epi32(_mm_unpackhi_epi16(lo16, hi16), 14);
+    __m128i sample = _mm_packs_epi32(prodLo, prodHi);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&aOut[i * 2]),
+                     _mm_unpacklo_epi16(sample, sample));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&aOut[i * 2 + 8]),
+                     _mm_unpackhi_epi16(sample, sample));
+  }
+  for (; i < aFrames; i++) {
+    int16_t sample = (int32_t(aIn[i]) * 11585) >> 14;
+    aOut[i * 2] = sample;
+    aOut[i * 2 + 1] = sample;
+  }
+}
+
+}  // namespace mozilla
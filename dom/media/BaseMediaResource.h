@@ -41,6 +41,10 @@ class BaseMediaResource : public MediaResource,
   // because it doesn't know when the decoder was paused, buffering, etc.
   virtual void SetPlaybackRate(uint32_t aBytesPerSecond) = 0;
 
+  // Tell the resource whether the decoder is actually playing. Cache-backed
+  // resources deprioritize readahead for streams that aren't playing.
+  virtual void SetPlaybackActive(bool aActive) {}
+
   // Get the estimated download rate in bytes per second (assuming no
   // pausing of the channel is requested by Gecko).
   // *aIsReliable is set to true if we think the estimate is useful.
@@ -337,6 +337,9 @@ void ChannelMediaDecoder::OnPlaybackEvent(MediaPlaybackEvent&& aEvent) {
     case MediaPlaybackEvent::PlaybackStarted:
       mPlaybackPosition = aEvent.mData.as<int64_t>();
       mPlaybackStatistics.Start();
+      if (mResource) {
+        mResource->SetPlaybackActive(true);
+      }
       break;
     case MediaPlaybackEvent::PlaybackProgressed: {
       int64_t newPos = aEvent.mData.as<int64_t>();
@@ -349,6 +352,9 @@ void ChannelMediaDecoder::OnPlaybackEvent(MediaPlaybackEvent&& aEvent) {
       mPlaybackStatistics.AddBytes(newPos - mPlaybackPosition);
       mPlaybackPosition = newPos;
       mPlaybackStatistics.Stop();
+      if (mResource) {
+        mResource->SetPlaybackActive(false);
+      }
       break;
     }
     default:
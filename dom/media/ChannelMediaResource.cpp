@@ -947,6 +947,10 @@ void ChannelMediaResource::SetPlaybackRate(uint32_t aBytesPerSecond) {
   mCacheStream.SetPlaybackRate(aBytesPerSecond);
 }
 
+void ChannelMediaResource::SetPlaybackActive(bool aActive) {
+  mCacheStream.SetPlaybackActive(aActive);
+}
+
 void ChannelMediaResource::Pin() { mCacheStream.Pin(); }
 
 void ChannelMediaResource::Unpin() { mCacheStream.Unpin(); }
@@ -135,6 +135,7 @@ class ChannelMediaResource
   // Other thread
   void SetReadMode(MediaCacheStream::ReadMode aMode) override;
   void SetPlaybackRate(uint32_t aBytesPerSecond) override;
+  void SetPlaybackActive(bool aActive) override;
   nsresult ReadAt(int64_t offset, char* aBuffer, uint32_t aCount,
                   uint32_t* aBytes) override;
   // Data stored in IO&lock-encumbered MediaCacheStream, caching recommended.
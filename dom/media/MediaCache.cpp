@@ -72,6 +72,15 @@ static const double NONSEEKABLE_READAHEAD_MAX = 0.5;
 // position.
 static const uint32_t REPLAY_PENALTY_FACTOR = 3;
 
+// Readahead blocks belonging to streams that aren't playing have this many
+// seconds added to their predicted next use. A paused stream's playback
+// position never advances, so its readahead predictions stay artificially
+// small and would otherwise outcompete the readahead of streams that are
+// actually playing. The penalty makes such blocks effectively scavenge-only:
+// they are the first to be reclaimed whenever a playing stream needs space,
+// but are still cached while the cache is underutilized.
+static const uint32_t INACTIVE_READAHEAD_PENALTY_S = 24 * 60 * 60;
+
 // When looking for a reusable block, scan forward this many blocks
 // from the desired "best" block location to look for free blocks,
 // before we resort to scanning the whole cache. The idea is to try to
@@ -1188,6 +1197,13 @@ TimeDuration MediaCache::PredictNextUse(AutoLock&, TimeStamp aNow,
             bytesAhead * 1000 / bo->mStream->mPlaybackBytesPerSecond;
         prediction = TimeDuration::FromMilliseconds(
             std::min<int64_t>(millisecondsAhead, INT32_MAX));
+        if (!bo->mStream->mPlaybackActive) {
+          // The stream isn't playing, so its offset isn't advancing and the
+          // prediction above is not meaningful. Penalize the block so that
+          // readahead for playing streams always wins. Adding a constant
+          // preserves the ordering of this stream's readahead list.
+          prediction += TimeDuration::FromSeconds(INACTIVE_READAHEAD_PENALTY_S);
+        }
         break;
       }
       default:
@@ -1211,6 +1227,11 @@ TimeDuration MediaCache::PredictNextUseForIncomingData(
     return TimeDuration::FromSeconds(24 * 60 * 60);
   }
   if (bytesAhead <= 0) return TimeDuration(0);
+  if (!aStream->mPlaybackActive) {
+    // Readahead for a stream that isn't playing should only occupy blocks
+    // nobody else has a better use for.
+    return TimeDuration::FromSeconds(INACTIVE_READAHEAD_PENALTY_S);
+  }
   int64_t millisecondsAhead =
       bytesAhead * 1000 / aStream->mPlaybackBytesPerSecond;
   return TimeDuration::FromMilliseconds(
@@ -2388,6 +2409,20 @@ void MediaCacheStream::SetReadMode(ReadMode aMode) {
   OwnerThread()->Dispatch(r.forget());
 }
 
+void MediaCacheStream::SetPlaybackActive(bool aActive) {
+  nsCOMPtr<nsIRunnable> r = NS_NewRunnableFunction(
+      "MediaCacheStream::SetPlaybackActive",
+      [this, client = RefPtr<ChannelMediaResource>(mClient), aActive]() {
+        AutoLock lock(mMediaCache->Monitor());
+        if (!mClosed && mPlaybackActive != aActive) {
+          LOGI("Stream %p SetPlaybackActive %d", this, aActive);
+          mPlaybackActive = aActive;
+          mMediaCache->QueueUpdate(lock);
+        }
+      });
+  OwnerThread()->Dispatch(r.forget());
+}
+
 void MediaCacheStream::SetPlaybackRate(uint32_t aBytesPerSecond) {
   MOZ_ASSERT(!NS_IsMainThread());
   MOZ_ASSERT(aBytesPerSecond > 0, "Zero playback rate not allowed");
@@ -338,6 +338,10 @@ class MediaCacheStream : public DecoderDoctorLifeLogger<MediaCacheStream> {
   // because it doesn't know when the decoder was paused, buffering, etc.
   // Do not pass zero.
   void SetPlaybackRate(uint32_t aBytesPerSecond);
+  // Tell the cache whether this stream's decoder is actually playing.
+  // Readahead for streams that aren't playing is given the lowest priority
+  // so it can't evict readahead of playing streams. Initially false.
+  void SetPlaybackActive(bool aActive);
 
   // Returns true when all streams for this resource are suspended or their
   // channel has ended.
@@ -533,6 +537,10 @@ class MediaCacheStream : public DecoderDoctorLifeLogger<MediaCacheStream> {
 
   bool mThrottleReadahead = false;
 
+  // True while the decoder reports that playback is in progress. Readahead
+  // owned by inactive streams is the first to be evicted.
+  bool mPlaybackActive = false;
+
   // Data received for the block containing mChannelOffset. Data needs
   // to wait here so we can write back a complete block. The first
   // mChannelOffset%BLOCK_SIZE bytes have been filled in with good data,
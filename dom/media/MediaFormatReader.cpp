@@ -25,6 +25,7 @@
 #include "mozilla/Preferences.h"
 #include "mozilla/ProfilerLabels.h"
 #include "mozilla/ProfilerMarkers.h"
+#include "mozilla/RemoteDecoderManagerChild.h"
 #include "mozilla/SharedThreadPool.h"
 #include "mozilla/StaticPrefs_media.h"
 #include "mozilla/TaskQueue.h"
@@ -32,6 +33,7 @@
 #include "nsContentUtils.h"
 #include "nsPrintfCString.h"
 #include "nsTHashSet.h"
+#include "nsXULAppAPI.h"
 
 using namespace mozilla::media;
 
@@ -1004,6 +1006,16 @@ nsresult MediaFormatReader::Init() {
       new TaskQueue(GetMediaThreadPool(MediaThreadType::PLATFORM_DECODER),
                     "MFR::mVideo::mTaskQueue");
 
+  if (XRE_IsContentProcess() && StaticPrefs::media_rdd_process_enabled() &&
+      StaticPrefs::media_rdd_process_prewarm()) {
+    // Decoders are likely to be created in the RDD process once the demuxer
+    // has produced the track configs. Kick off the process launch (and this
+    // content process' bridge to it) now so it happens while we wait on
+    // resource data, instead of adding its startup time to that of the first
+    // decoder.
+    Unused << RemoteDecoderManagerChild::LaunchRDDProcessIfNeeded();
+  }
+
   return NS_OK;
 }
 
@@ -1461,7 +1473,8 @@ void MediaFormatReader::DoDemuxVideo() {
   using SamplesPromise = MediaTrackDemuxer::SamplesPromise;
 
   DDLOG(DDLogCategory::Log, "video_demuxing", DDNoValue{});
-  auto p = mVideo.mTrackDemuxer->GetSamples(1);
+  auto p = mVideo.mTrackDemuxer->GetSamples(
+      std::max<int32_t>(1, StaticPrefs::media_demux_batch_size()));
 
   if (mVideo.mFirstDemuxedSampleTime.isNothing()) {
     RefPtr<MediaFormatReader> self = this;
@@ -1546,7 +1559,8 @@ void MediaFormatReader::DoDemuxAudio() {
   using SamplesPromise = MediaTrackDemuxer::SamplesPromise;
 
   DDLOG(DDLogCategory::Log, "audio_demuxing", DDNoValue{});
-  auto p = mAudio.mTrackDemuxer->GetSamples(1);
+  auto p = mAudio.mTrackDemuxer->GetSamples(
+      std::max<int32_t>(1, StaticPrefs::media_demux_batch_size()));
 
   if (mAudio.mFirstDemuxedSampleTime.isNothing()) {
     RefPtr<MediaFormatReader> self = this;
@@ -1854,25 +1868,30 @@ void MediaFormatReader::RequestDemuxSamples(TrackType aTrack) {
   }
 }
 
-void MediaFormatReader::DecodeDemuxedSamples(TrackType aTrack,
-                                             MediaRawData* aSample) {
+void MediaFormatReader::DecodeDemuxedSamples(
+    TrackType aTrack, nsTArray<RefPtr<MediaRawData>>&& aSamples) {
   MOZ_ASSERT(OnTaskQueue());
+  MOZ_ASSERT(!aSamples.IsEmpty());
   auto& decoder = GetDecoderData(aTrack);
   RefPtr<MediaFormatReader> self = this;
   decoder.mFlushed = false;
-  DDLOGPR(DDLogCategory::Log,
-          aTrack == TrackInfo::kAudioTrack   ? "decode_audio"
-          : aTrack == TrackInfo::kVideoTrack ? "decode_video"
-                                             : "decode_?",
-          "{\"type\":\"MediaRawData\", \"offset\":%" PRIi64
-          ", \"bytes\":%zu, \"time_us\":%" PRIi64 ", \"timecode_us\":%" PRIi64
-          ", \"duration_us\":%" PRIi64 ",%s%s}",
-          aSample->mOffset, aSample->Size(), aSample->mTime.ToMicroseconds(),
-          aSample->mTimecode.ToMicroseconds(),
-          aSample->mDuration.ToMicroseconds(), aSample->mKeyframe ? " kf" : "",
-          aSample->mEOS ? " eos" : "");
-  decoder.mDecoder->Decode(aSample)
-      ->Then(
+  for (const auto& sample : aSamples) {
+    DDLOGPR(DDLogCategory::Log,
+            aTrack == TrackInfo::kAudioTrack   ? "decode_audio"
+            : aTrack == TrackInfo::kVideoTrack ? "decode_video"
+                                               : "decode_?",
+            "{\"type\":\"MediaRawData\", \"offset\":%" PRIi64
+            ", \"bytes\":%zu, \"time_us\":%" PRIi64 ", \"timecode_us\":%" PRIi64
+            ", \"duration_us\":%" PRIi64 ",%s%s}",
+            sample->mOffset, sample->Size(), sample->mTime.ToMicroseconds(),
+            sample->mTimecode.ToMicroseconds(),
+            sample->mDuration.ToMicroseconds(), sample->mKeyframe ? " kf" : "",
+            sample->mEOS ? " eos" : "");
+  }
+  RefPtr<MediaDataDecoder::DecodePromise> p =
+      aSamples.Length() > 1 ? decoder.mDecoder->DecodeBatch(std::move(aSamples))
+                            : decoder.mDecoder->Decode(aSamples[0]);
+  p->Then(
           mTaskQueue, __func__,
           [self, aTrack, &decoder](MediaDataDecoder::DecodedData&& aResults) {
             decoder.mDecodeRequest.Complete();
@@ -1986,18 +2005,41 @@ void MediaFormatReader::HandleDemuxedSamples(
     return;
   }
 
-  LOGV("Input:%" PRId64 " (dts:%" PRId64 " kf:%d)",
-       sample->mTime.ToMicroseconds(), sample->mTimecode.ToMicroseconds(),
-       sample->mKeyframe);
-  decoder.mNumSamplesInput++;
-  decoder.mSizeOfQueue++;
-  if (aTrack == TrackInfo::kVideoTrack) {
-    aA.mStats.mParsedFrames++;
+  // Decoders that support batch decoding (such as the remote decoders) can
+  // take all queued samples belonging to the current stream in a single
+  // request, saving a task-queue (and possibly IPC) round trip per sample.
+  uint32_t batchLength = 1;
+  if (decoder.mDecoder->CanDecodeBatch()) {
+    while (batchLength < decoder.mQueuedSamples.Length()) {
+      const RefPtr<TrackInfoSharedPtr>& nextInfo =
+          decoder.mQueuedSamples[batchLength]->mTrackInfo;
+      if (nextInfo && decoder.mLastStreamSourceID != nextInfo->GetID()) {
+        break;
+      }
+      batchLength++;
+    }
+  }
+
+  nsTArray<RefPtr<MediaRawData>> samplesToDecode(batchLength);
+  for (uint32_t i = 0; i < batchLength; i++) {
+    RefPtr<MediaRawData>& s = decoder.mQueuedSamples[i];
+    if (i > 0) {
+      // The first sample was already accounted for above.
+      decoder.mMeanRate.Update(s->mDuration);
+    }
+    LOGV("Input:%" PRId64 " (dts:%" PRId64 " kf:%d)", s->mTime.ToMicroseconds(),
+         s->mTimecode.ToMicroseconds(), s->mKeyframe);
+    decoder.mNumSamplesInput++;
+    decoder.mSizeOfQueue++;
+    if (aTrack == TrackInfo::kVideoTrack) {
+      aA.mStats.mParsedFrames++;
+    }
+    samplesToDecode.AppendElement(std::move(s));
   }
 
-  DecodeDemuxedSamples(aTrack, sample);
+  DecodeDemuxedSamples(aTrack, std::move(samplesToDecode));
 
-  decoder.mQueuedSamples.RemoveElementAt(0);
+  decoder.mQueuedSamples.RemoveElementsAt(0, batchLength);
 }
 
 media::TimeUnit MediaFormatReader::GetInternalSeekTargetEndTime() const {
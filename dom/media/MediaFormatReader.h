@@ -263,8 +263,10 @@ class MediaFormatReader final
   // Handle demuxed samples by the input behavior.
   void HandleDemuxedSamples(TrackType aTrack,
                             FrameStatistics::AutoNotifyDecoded& aA);
-  // Decode any pending already demuxed samples.
-  void DecodeDemuxedSamples(TrackType aTrack, MediaRawData* aSample);
+  // Decode any pending already demuxed samples. Samples are sent to the
+  // decoder in a single request when it supports batch decoding.
+  void DecodeDemuxedSamples(TrackType aTrack,
+                            nsTArray<RefPtr<MediaRawData>>&& aSamples);
 
   struct InternalSeekTarget {
     InternalSeekTarget(const media::TimeInterval& aTime, bool aDropTarget)
@@ -1348,27 +1348,37 @@ void MediaTrackGraphImpl::ProduceDataForTracksBlockByBlock(
   MOZ_ASSERT(aTrackIndex <= mFirstCycleBreaker,
              "Cycle breaker is not AudioNodeTrack?");
 
+  // Classify the tracks once per iteration instead of once per block. Large
+  // node graphs render many blocks per iteration and the repeated dynamic
+  // casts in the inner loop are measurable. The track set and order can only
+  // change from control messages, which never run during processing.
+  AutoTArray<AudioNodeTrack*, 32> cycleBreakers;
+  for (uint32_t i = mFirstCycleBreaker; i < mTracks.Length(); ++i) {
+    auto nt = static_cast<AudioNodeTrack*>(mTracks[i]);
+    MOZ_ASSERT(nt->AsAudioNodeTrack());
+    cycleBreakers.AppendElement(nt);
+  }
+  AutoTArray<ProcessedMediaTrack*, 64> tracksToProcess;
+  for (uint32_t i = aTrackIndex; i < mTracks.Length(); ++i) {
+    ProcessedMediaTrack* pt = mTracks[i]->AsProcessedTrack();
+    if (pt && !pt->AsNativeInputTrack()) {
+      // NativeInputTracks are processed in Process. Skip them.
+      tracksToProcess.AppendElement(pt);
+    }
+  }
+
   while (mProcessedTime < mStateComputedTime) {
     // Microtask checkpoints are in between render quanta.
     nsAutoMicroTask mt;
 
     GraphTime next = RoundUpToNextAudioBlock(mProcessedTime);
-    for (uint32_t i = mFirstCycleBreaker; i < mTracks.Length(); ++i) {
-      auto nt = static_cast<AudioNodeTrack*>(mTracks[i]);
-      MOZ_ASSERT(nt->AsAudioNodeTrack());
+    for (AudioNodeTrack* nt : cycleBreakers) {
       nt->ProduceOutputBeforeInput(mProcessedTime);
     }
-    for (uint32_t i = aTrackIndex; i < mTracks.Length(); ++i) {
-      ProcessedMediaTrack* pt = mTracks[i]->AsProcessedTrack();
-      if (pt) {
-        if (pt->AsNativeInputTrack()) {
-          // NativeInputTracks are processed in Process. Skip them.
-          continue;
-        }
-        pt->ProcessInput(
-            mProcessedTime, next,
-            (next == mStateComputedTime) ? ProcessedMediaTrack::ALLOW_END : 0);
-      }
+    for (ProcessedMediaTrack* pt : tracksToProcess) {
+      pt->ProcessInput(
+          mProcessedTime, next,
+          (next == mStateComputedTime) ? ProcessedMediaTrack::ALLOW_END : 0);
     }
     mProcessedTime = next;
   }
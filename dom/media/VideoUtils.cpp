@@ -237,12 +237,17 @@ bool IsValidVideoRegion(const gfx::IntSize& aFrame,
 already_AddRefed<SharedThreadPool> GetMediaThreadPool(MediaThreadType aType) {
   const char* name;
   uint32_t threads = 4;
+  // Decoder threads allocate heavily and in parallel; give them per-thread
+  // jemalloc arenas to keep them off the default arena's lock.
+  bool threadLocalArenas = false;
   switch (aType) {
     case MediaThreadType::PLATFORM_DECODER:
       name = "MediaPDecoder";
+      threadLocalArenas = true;
       break;
     case MediaThreadType::WEBRTC_DECODER:
       name = "WebRTCPD";
+      threadLocalArenas = true;
       break;
     case MediaThreadType::MDSM:
       name = "MediaDecoderStateMachine";
@@ -259,7 +264,8 @@ already_AddRefed<SharedThreadPool> GetMediaThreadPool(MediaThreadType aType) {
   }
 
   RefPtr<SharedThreadPool> pool =
-      SharedThreadPool::Get(nsDependentCString(name), threads);
+      SharedThreadPool::Get(nsDependentCString(name), threads,
+                            threadLocalArenas);
 
   // Ensure a larger stack for platform decoder threads
   if (aType == MediaThreadType::PLATFORM_DECODER) {
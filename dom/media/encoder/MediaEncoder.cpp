@@ -48,6 +48,10 @@ namespace mozilla {
 using namespace dom;
 using namespace media;
 
+// Extract muxed data once this much encoded data has accumulated, even if the
+// regular time-based extraction isn't due yet.
+static const size_t MAX_PENDING_FRAME_BYTES = 1024 * 1024;
+
 namespace {
 class BlobStorer : public MutableBlobStorageCallback {
   MozPromiseHolder<MediaEncoder::BlobPromise> mHolder;
@@ -908,12 +912,14 @@ void MediaEncoder::MaybeCreateMutableBlobStorage() {
 void MediaEncoder::OnEncodedAudioPushed(const RefPtr<EncodedFrame>& aFrame) {
   MOZ_ASSERT(mEncoderThread->IsCurrentThreadIn());
   mMuxedAudioEndTime = aFrame->GetEndTime();
+  mPendingFrameBytes += aFrame->mFrameData->Length();
   MaybeExtractOrGatherBlob();
 }
 
 void MediaEncoder::OnEncodedVideoPushed(const RefPtr<EncodedFrame>& aFrame) {
   MOZ_ASSERT(mEncoderThread->IsCurrentThreadIn());
   mMuxedVideoEndTime = aFrame->GetEndTime();
+  mPendingFrameBytes += aFrame->mFrameData->Length();
   MaybeExtractOrGatherBlob();
 }
 
@@ -937,13 +943,18 @@ void MediaEncoder::MaybeExtractOrGatherBlob() {
                         });
   }
 
-  if (muxedEndTime - mLastExtractTime > TimeUnit::FromSeconds(1)) {
-    // Extract data from the muxer at least every second.
+  if (muxedEndTime - mLastExtractTime > TimeUnit::FromSeconds(1) ||
+      mPendingFrameBytes > MAX_PENDING_FRAME_BYTES) {
+    // Extract data from the muxer at least every second, or earlier if the
+    // track encoders have produced enough data that holding on to it until
+    // the time-based extraction would get expensive.
     LOG(LogLevel::Verbose,
-        ("MediaEncoder %p Muxed %.2fs of data since last "
+        ("MediaEncoder %p Muxed %.2fs and %zu bytes of data since last "
          "extract. Extracting more data into blob.",
-         this, (muxedEndTime - mLastExtractTime).ToSeconds()));
+         this, (muxedEndTime - mLastExtractTime).ToSeconds(),
+         mPendingFrameBytes));
     mLastExtractTime = muxedEndTime;
+    mPendingFrameBytes = 0;
     Unused << Extract();
   }
 }
@@ -373,6 +373,11 @@ class MediaEncoder {
   // one track is present, this is the end time of the track that ends the
   // earliest in the current blob storage. Encoder thread only.
   media::TimeUnit mLastExtractTime;
+  // Number of encoded data bytes pushed by the track encoders since the last
+  // extraction. Lets high-bitrate recordings trigger extraction by size, so
+  // the amount of encoded data held in memory between the time-based
+  // extractions stays bounded. Encoder thread only.
+  size_t mPendingFrameBytes = 0;
   // The end time of encoded audio data sent to the muxer. Positive infinity if
   // there is no audio encoder. Encoder thread only.
   media::TimeUnit mMuxedAudioEndTime;
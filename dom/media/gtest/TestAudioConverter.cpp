@@ -0,0 +1,179 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <cmath>
+
+#include "AudioConverter.h"
+#include "MediaData.h"
+#include "gtest/gtest.h"
+#include "gtest/MozGTestBench.h"
+
+using namespace mozilla;
+
+TEST(AudioConverter, DownmixStereoToMonoFloat)
+{
+  AudioConfig in(AudioConfig::ChannelLayout(2), 44100, AudioConfig::FORMAT_FLT);
+  AudioConfig out(AudioConfig::ChannelLayout(1), 44100, AudioConfig::FORMAT_FLT);
+  AudioConverter converter(in, out);
+
+  constexpr size_t frames = 1029;  // Odd count to exercise the scalar tail.
+  AlignedFloatBuffer buffer(frames * 2);
+  for (size_t i = 0; i < frames; i++) {
+    buffer.Data()[i * 2] = float(i % 100) / 100.f;
+    buffer.Data()[i * 2 + 1] = -float(i % 50) / 50.f;
+  }
+
+  AlignedFloatBuffer output(frames);
+  size_t processed = converter.Process(output, buffer.Data(), frames);
+  EXPECT_EQ(processed, frames);
+  for (size_t i = 0; i < frames; i++) {
+    float expected =
+        (float(i % 100) / 100.f + -float(i % 50) / 50.f) * 0.5f;
+    EXPECT_FLOAT_EQ(output.Data()[i], expected);
+  }
+}
+
+TEST(AudioConverter, DownmixStereoToMonoS16)
+{
+  AudioConfig in(AudioConfig::ChannelLayout(2), 44100,
+                 AudioConfig::FORMAT_S16);
+  AudioConfig out(AudioConfig::ChannelLayout(1), 44100,
+                  AudioConfig::FORMAT_S16);
+  AudioConverter converter(in, out);
+
+  constexpr size_t frames = 1029;
+  AlignedShortBuffer buffer(frames * 2);
+  for (size_t i = 0; i < frames; i++) {
+    buffer.Data()[i * 2] = int16_t(i * 131);
+    buffer.Data()[i * 2 + 1] = int16_t(-int(i) * 61);
+  }
+
+  AlignedShortBuffer output(frames);
+  size_t processed = converter.Process(output, buffer.Data(), frames);
+  EXPECT_EQ(processed, frames);
+  for (size_t i = 0; i < frames; i++) {
+    int32_t sum = int32_t(buffer.Data()[i * 2]) + buffer.Data()[i * 2 + 1];
+    // The scalar and SIMD kernels may round negative odd sums differently.
+    EXPECT_NEAR(output.Data()[i], sum / 2, 1);
+  }
+}
+
+TEST(AudioConverter, UpmixMonoToStereoFloat)
+{
+  AudioConfig in(AudioConfig::ChannelLayout(1), 44100, AudioConfig::FORMAT_FLT);
+  AudioConfig out(AudioConfig::ChannelLayout(2), 44100, AudioConfig::FORMAT_FLT);
+  AudioConverter converter(in, out);
+
+  constexpr size_t frames = 1029;
+  AlignedFloatBuffer buffer(frames);
+  for (size_t i = 0; i < frames; i++) {
+    buffer.Data()[i] = float(i % 200) / 200.f - 0.5f;
+  }
+
+  AlignedFloatBuffer output(frames * 2);
+  size_t processed = converter.Process(output, buffer.Data(), frames);
+  EXPECT_EQ(processed, frames);
+  const float m3db = std::sqrt(0.5f);
+  for (size_t i = 0; i < frames; i++) {
+    EXPECT_FLOAT_EQ(output.Data()[i * 2], buffer.Data()[i] * m3db);
+    EXPECT_FLOAT_EQ(output.Data()[i * 2 + 1], buffer.Data()[i] * m3db);
+  }
+}
+
+TEST(AudioConverter, UpmixMonoToStereoS16)
+{
+  AudioConfig in(AudioConfig::ChannelLayout(1), 44100,
+                 AudioConfig::FORMAT_S16);
+  AudioConfig out(AudioConfig::ChannelLayout(2), 44100,
+                  AudioConfig::FORMAT_S16);
+  AudioConverter converter(in, out);
+
+  constexpr size_t frames = 1029;
+  AlignedShortBuffer buffer(frames);
+  for (size_t i = 0; i < frames; i++) {
+    buffer.Data()[i] = int16_t(i * 57 - 29000);
+  }
+
+  AlignedShortBuffer output(frames * 2);
+  size_t processed = converter.Process(output, buffer.Data(), frames);
+  EXPECT_EQ(processed, frames);
+  for (size_t i = 0; i < frames; i++) {
+    int16_t expected = (int32_t(buffer.Data()[i]) * 11585) >> 14;
+    EXPECT_EQ(output.Data()[i * 2], expected);
+    EXPECT_EQ(output.Data()[i * 2 + 1], expected);
+  }
+}
+
+// Throughput benchmarks for the up/downmix kernels. A second of audio per
+// iteration; MozGTestBench reports the mean iteration time.
+class AudioConverterPerf : public ::testing::Test {
+ protected:
+  static constexpr size_t kFrames = 48000;
+
+  void SetUp() override {
+    mFloatStereo = AlignedFloatBuffer(kFrames * 2);
+    mFloatMono = AlignedFloatBuffer(kFrames);
+    mShortStereo = AlignedShortBuffer(kFrames * 2);
+    mShortMono = AlignedShortBuffer(kFrames);
+    for (size_t i = 0; i < kFrames * 2; i++) {
+      mFloatStereo.Data()[i] = float(i % 1000) / 1000.f - 0.5f;
+      mShortStereo.Data()[i] = int16_t(i * 13);
+    }
+    for (size_t i = 0; i < kFrames; i++) {
+      mFloatMono.Data()[i] = float(i % 1000) / 1000.f - 0.5f;
+      mShortMono.Data()[i] = int16_t(i * 13);
+    }
+  }
+
+  AlignedFloatBuffer mFloatStereo;
+  AlignedFloatBuffer mFloatMono;
+  AlignedShortBuffer mShortStereo;
+  AlignedShortBuffer mShortMono;
+};
+
+MOZ_GTEST_BENCH_F(AudioConverterPerf, DownmixStereoToMonoFloat, [this] {
+  AudioConfig in(AudioConfig::ChannelLayout(2), 44100, AudioConfig::FORMAT_FLT);
+  AudioConfig out(AudioConfig::ChannelLayout(1), 44100, AudioConfig::FORMAT_FLT);
+  AudioConverter converter(in, out);
+  AlignedFloatBuffer output(kFrames);
+  for (int iter = 0; iter < 100; iter++) {
+    converter.Process(output, mFloatStereo.Data(), kFrames);
+  }
+});
+
+MOZ_GTEST_BENCH_F(AudioConverterPerf, DownmixStereoToMonoS16, [this] {
+  AudioConfig in(AudioConfig::ChannelLayout(2), 44100,
+                 AudioConfig::FORMAT_S16);
+  AudioConfig out(AudioConfig::ChannelLayout(1), 44100,
+                  AudioConfig::FORMAT_S16);
+  AudioConverter converter(in, out);
+  AlignedShortBuffer output(kFrames);
+  for (int iter = 0; iter < 100; iter++) {
+    converter.Process(output, mShortStereo.Data(), kFrames);
+  }
+});
+
+MOZ_GTEST_BENCH_F(AudioConverterPerf, UpmixMonoToStereoFloat, [this] {
+  AudioConfig in(AudioConfig::ChannelLayout(1), 44100, AudioConfig::FORMAT_FLT);
+  AudioConfig out(AudioConfig::ChannelLayout(2), 44100, AudioConfig::FORMAT_FLT);
+  AudioConverter converter(in, out);
+  AlignedFloatBuffer output(kFrames * 2);
+  for (int iter = 0; iter < 100; iter++) {
+    converter.Process(output, mFloatMono.Data(), kFrames);
+  }
+});
+
+MOZ_GTEST_BENCH_F(AudioConverterPerf, UpmixMonoToStereoS16, [this] {
+  AudioConfig in(AudioConfig::ChannelLayout(1), 44100,
+                 AudioConfig::FORMAT_S16);
+  AudioConfig out(AudioConfig::ChannelLayout(2), 44100,
+                  AudioConfig::FORMAT_S16);
+  AudioConverter converter(in, out);
+  AlignedShortBuffer output(kFrames * 2);
+  for (int iter = 0; iter < 100; iter++) {
+    converter.Process(output, mShortMono.Data(), kFrames);
+  }
+});
@@ -383,6 +383,55 @@ void SampleIterator::Seek(Microseconds aTime) {
   size_t syncSample = 0;
   mCurrentMoof = 0;
   mCurrentSample = 0;
+
+  // Rather than walking every sample from the start of the file, skip ahead
+  // to a sync sample at or before aTime, and only scan per-sample from
+  // there. The linear scan below is unchanged; this just moves its starting
+  // point.
+  if (MoofParser* moofParser = mIndex->mMoofParser.get()) {
+    // Fragmented: jump to the last fragment starting at or before aTime,
+    // then back up until we find one with a sync sample no later than aTime
+    // in its leading (not past-aTime) samples, mirroring what the scan below
+    // will observe.
+    const nsTArray<Moof>& moofs = moofParser->Moofs();
+    if (!moofs.IsEmpty()) {
+      size_t moof = 0;
+      while (moof + 1 < moofs.Length() &&
+             moofs[moof + 1].mTimeRange.start <= aTime) {
+        moof++;
+      }
+      while (moof) {
+        bool hasSync = false;
+        for (const Sample& sample : moofs[moof].mIndex) {
+          if (sample.mCompositionRange.start > aTime) {
+            break;
+          }
+          if (sample.mSync) {
+            hasSync = true;
+            break;
+          }
+        }
+        if (hasSync) {
+          break;
+        }
+        moof--;
+      }
+      mCurrentMoof = syncMoof = moof;
+    }
+  } else {
+    // Not fragmented: mDataOffset records the sample index of each sync
+    // sample (or every 128th sample for audio) for progressive files. Start
+    // at the last one at or before aTime.
+    for (size_t i = mIndex->mDataOffset.Length(); i > 0; i--) {
+      const MP4DataOffset& offset = mIndex->mDataOffset[i - 1];
+      if (offset.mTime.start <= aTime &&
+          mIndex->mIndex[offset.mIndex].mCompositionRange.start <= aTime) {
+        mCurrentSample = syncSample = offset.mIndex;
+        break;
+      }
+    }
+  }
+
   Sample* sample;
   while (!!(sample = Get())) {
     if (sample->mCompositionRange.start > aTime) {
@@ -135,15 +135,13 @@ class DeliverFrameRunnable : public mozilla::Runnable {
         mStreamId(aStreamId),
         mProperties(aProperties),
         mResult(0) {
-    // No ShmemBuffer (of the right size) was available, so make an
-    // extra buffer here.  We have no idea when we are going to run and
-    // it will be potentially long after the webrtc frame callback has
-    // returned, so the copy needs to be no later than here.
-    // We will need to copy this back into a Shmem later on so we prefer
-    // using ShmemBuffers to avoid the extra copy.
-    mAlternateBuffer.reset(new unsigned char[aProperties.bufferSize()]);
-    VideoFrameUtils::CopyVideoFrameBuffers(mAlternateBuffer.get(),
-                                           aProperties.bufferSize(), aFrame);
+    // No ShmemBuffer (of the right size) was available, so hang on to the
+    // frame itself until we run. The frame's pixel data lives in a
+    // refcounted webrtc::VideoFrameBuffer that the capture pipeline will
+    // not reuse, so this is a refcount rather than a copy; the single copy
+    // into a Shmem happens in DeliverFrameOverIPC once a right-sized
+    // buffer exists.
+    mAlternateFrame = MakeUnique<webrtc::VideoFrame>(aFrame);
   }
 
   DeliverFrameRunnable(CamerasParent* aParent, CaptureEngine aEngine,
@@ -164,7 +162,7 @@ class DeliverFrameRunnable : public mozilla::Runnable {
       return NS_OK;
     }
     if (!mParent->DeliverFrameOverIPC(mCapEngine, mStreamId, std::move(mBuffer),
-                                      mAlternateBuffer.get(), mProperties)) {
+                                      mAlternateFrame.get(), mProperties)) {
       mResult = -1;
     } else {
       mResult = 0;
@@ -179,7 +177,7 @@ class DeliverFrameRunnable : public mozilla::Runnable {
   CaptureEngine mCapEngine;
   uint32_t mStreamId;
   ShmemBuffer mBuffer;
-  UniquePtr<unsigned char[]> mAlternateBuffer;
+  UniquePtr<webrtc::VideoFrame> mAlternateFrame;
   VideoFrameProperties mProperties;
   int mResult;
 };
@@ -250,13 +248,13 @@ void CamerasParent::StopVideoCapture() {
 
 int CamerasParent::DeliverFrameOverIPC(CaptureEngine capEng, uint32_t aStreamId,
                                        ShmemBuffer buffer,
-                                       unsigned char* altbuffer,
+                                       const webrtc::VideoFrame* altFrame,
                                        VideoFrameProperties& aProps) {
   // No ShmemBuffers were available, so construct one now of the right size
-  // and copy into it. That is an extra copy, but we expect this to be
-  // the exceptional case, because we just assured the next call *will* have a
+  // and copy the retained frame into it. We expect this to be the
+  // exceptional case, because we just assured the next call *will* have a
   // buffer of the right size.
-  if (altbuffer != nullptr) {
+  if (altFrame != nullptr) {
     // Get a shared memory buffer from the pool, at least size big
     ShmemBuffer shMemBuff = mShmemPool.Get(this, aProps.bufferSize());
 
@@ -266,8 +264,8 @@ int CamerasParent::DeliverFrameOverIPC(CaptureEngine capEng, uint32_t aStreamId,
       return 0;
     }
 
-    // get() and Size() check for proper alignment of the segment
-    memcpy(shMemBuff.GetBytes(), altbuffer, aProps.bufferSize());
+    VideoFrameUtils::CopyVideoFrameBuffers(shMemBuff.GetBytes(),
+                                           aProps.bufferSize(), *altFrame);
 
     if (!SendDeliverFrame(capEng, aStreamId, std::move(shMemBuff.Get()),
                           aProps)) {
@@ -108,7 +108,8 @@ class CamerasParent final : public PCamerasParent,
 
   // helper to forward to the PBackground thread
   int DeliverFrameOverIPC(CaptureEngine capEng, uint32_t aStreamId,
-                          ShmemBuffer buffer, unsigned char* altbuffer,
+                          ShmemBuffer buffer,
+                          const webrtc::VideoFrame* altFrame,
                           VideoFrameProperties& aProps);
 
   CamerasParent();
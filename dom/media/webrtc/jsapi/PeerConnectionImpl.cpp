@@ -1500,18 +1500,46 @@ already_AddRefed<dom::Promise> PeerConnectionImpl::GetStats(
     return nullptr;
   }
 
+  if (!aSelector) {
+    // Coalesce whole-connection snapshots. Stats pollers commonly issue
+    // several getStats() calls per connection per tick, and each snapshot
+    // round-trips through the STS and call threads; every caller that
+    // arrives while a query is in flight shares its report.
+    mPendingFullStatsPromises.AppendElement(promise);
+    if (mPendingFullStatsPromises.Length() > 1) {
+      return promise.forget();
+    }
+  }
+
   GetStats(aSelector, false)
       ->Then(
           GetMainThreadSerialEventTarget(), __func__,
-          [promise,
-           window = mWindow](UniquePtr<dom::RTCStatsReportInternal>&& aReport) {
+          [promise, window = mWindow,
+           self = RefPtr<PeerConnectionImpl>(this), coalesced = !aSelector](
+              UniquePtr<dom::RTCStatsReportInternal>&& aReport) {
             RefPtr<RTCStatsReport> report(new RTCStatsReport(window));
             report->Incorporate(*aReport);
-            promise->MaybeResolve(std::move(report));
+            if (coalesced) {
+              for (const auto& pending : self->mPendingFullStatsPromises) {
+                pending->MaybeResolve(report);
+              }
+              self->mPendingFullStatsPromises.Clear();
+            } else {
+              promise->MaybeResolve(std::move(report));
+            }
           },
-          [promise, window = mWindow](nsresult aError) {
+          [promise, window = mWindow,
+           self = RefPtr<PeerConnectionImpl>(this),
+           coalesced = !aSelector](nsresult aError) {
             RefPtr<RTCStatsReport> report(new RTCStatsReport(window));
-            promise->MaybeResolve(std::move(report));
+            if (coalesced) {
+              for (const auto& pending : self->mPendingFullStatsPromises) {
+                pending->MaybeResolve(report);
+              }
+              self->mPendingFullStatsPromises.Clear();
+            } else {
+              promise->MaybeResolve(std::move(report));
+            }
           });
 
   return promise.forget();
@@ -609,6 +609,11 @@ class PeerConnectionImpl final
   dom::RTCStatsTimestampMaker mTimestampMaker;
 
   RefPtr<RTCStatsIdGenerator> mIdGenerator;
+
+  // getStats() calls with a null selector that are waiting on a snapshot.
+  // Only the call that makes this array non-empty starts a query; the rest
+  // are resolved from the same report when it completes.
+  nsTArray<RefPtr<dom::Promise>> mPendingFullStatsPromises;
   // Ordinarily, I would use a std::map here, but this used to be a JS Map
   // which iterates in insertion order, and I want to avoid changing this.
   nsTArray<RefPtr<DOMMediaStream>> mReceiveStreams;
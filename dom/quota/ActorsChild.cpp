@@ -345,6 +345,7 @@ mozilla::ipc::IPCResult QuotaRequestChild::Recv__delete__(
     case RequestResponse::TClearOriginResponse:
     case RequestResponse::TResetOriginResponse:
     case RequestResponse::TClearDataResponse:
+    case RequestResponse::TClearOriginsResponse:
     case RequestResponse::TClearAllResponse:
     case RequestResponse::TResetAllResponse:
     case RequestResponse::TPersistResponse:
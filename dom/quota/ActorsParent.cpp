@@ -1584,6 +1584,20 @@ class ClearDataOp final : public ClearRequestBase {
   void GetResponse(RequestResponse& aResponse) override;
 };
 
+class ClearOriginsOp final : public ClearRequestBase {
+  const ClearOriginsParams mParams;
+
+ public:
+  explicit ClearOriginsOp(const RequestParams& aParams);
+
+  void Init(Quota& aQuota) override;
+
+ private:
+  ~ClearOriginsOp() = default;
+
+  void GetResponse(RequestResponse& aResponse) override;
+};
+
 class ResetOriginOp final : public QuotaRequestBase {
  public:
   explicit ResetOriginOp(const RequestParams& aParams);
@@ -4133,7 +4147,16 @@ nsresult QuotaManager::LoadQuota() {
             QM_TRY_INSPECT(const bool& exists,
                            MOZ_TO_RESULT_INVOKE(directory, Exists));
 
-            QM_TRY(OkIf(exists), Err(NS_ERROR_FAILURE));
+            if (!exists) {
+              // The origin directory went away since the cache was written
+              // (for example, removed by the user or a cleaning tool while
+              // the browser wasn't running). A full scan of the repository
+              // would simply not find this origin, so skip it instead of
+              // invalidating the whole cache and rescanning all origins.
+              NS_WARNING("An origin directory from the quota cache is gone!");
+
+              return Ok{};
+            }
 
             QM_TRY_INSPECT(const bool& isDirectory,
                            MOZ_TO_RESULT_INVOKE(directory, IsDirectory));
@@ -7931,6 +7954,23 @@ bool Quota::VerifyRequestParams(const RequestParams& aParams) const {
       break;
     }
 
+    case RequestParams::TClearOriginsParams: {
+      if (BackgroundParent::IsOtherProcessActor(Manager())) {
+        ASSERT_UNLESS_FUZZING();
+        return false;
+      }
+
+      for (const PrincipalInfo& principalInfo :
+           aParams.get_ClearOriginsParams().principalInfos()) {
+        if (NS_WARN_IF(!QuotaManager::IsPrincipalInfoValid(principalInfo))) {
+          ASSERT_UNLESS_FUZZING();
+          return false;
+        }
+      }
+
+      break;
+    }
+
     case RequestParams::TClearAllParams:
     case RequestParams::TResetAllParams:
     case RequestParams::TListOriginsParams:
@@ -8107,6 +8147,9 @@ PQuotaRequestParent* Quota::AllocPQuotaRequestParent(
       case RequestParams::TClearDataParams:
         return MakeRefPtr<ClearDataOp>(aParams);
 
+      case RequestParams::TClearOriginsParams:
+        return MakeRefPtr<ClearOriginsOp>(aParams);
+
       case RequestParams::TClearAllParams:
         return MakeRefPtr<ResetOrClearOp>(/* aClear */ true);
 
@@ -9022,6 +9065,13 @@ void ClearRequestBase::DeleteFiles(QuotaManager& aQuotaManager,
                     } else if (originScope.IsPrefix()) {
                       originScope.SetOriginNoSuffix(MakeSanitizedOriginCString(
                           originScope.GetOriginNoSuffix()));
+                    } else if (originScope.IsOriginList()) {
+                      nsTArray<nsCString> sanitizedOrigins;
+                      for (const auto& origin : originScope.GetOrigins()) {
+                        sanitizedOrigins.AppendElement(
+                            MakeSanitizedOriginCString(origin));
+                      }
+                      originScope.SetFromOrigins(std::move(sanitizedOrigins));
                     }
                     return originScope;
                   }(),
@@ -9220,6 +9270,32 @@ void ClearDataOp::GetResponse(RequestResponse& aResponse) {
   aResponse = ClearDataResponse();
 }
 
+ClearOriginsOp::ClearOriginsOp(const RequestParams& aParams)
+    : ClearRequestBase(/* aExclusive */ true),
+      mParams(aParams.get_ClearOriginsParams()) {
+  MOZ_ASSERT(aParams.type() == RequestParams::TClearOriginsParams);
+}
+
+void ClearOriginsOp::Init(Quota& aQuota) {
+  AssertIsOnOwningThread();
+
+  QuotaRequestBase::Init(aQuota);
+
+  nsTArray<nsCString> origins;
+  for (const PrincipalInfo& principalInfo : mParams.principalInfos()) {
+    origins.AppendElement(
+        QuotaManager::GetOriginFromValidatedPrincipalInfo(principalInfo));
+  }
+
+  mOriginScope.SetFromOrigins(std::move(origins));
+}
+
+void ClearOriginsOp::GetResponse(RequestResponse& aResponse) {
+  AssertIsOnOwningThread();
+
+  aResponse = ClearOriginsResponse();
+}
+
 ResetOriginOp::ResetOriginOp(const RequestParams& aParams)
     : QuotaRequestBase(/* aExclusive */ true) {
   AssertIsOnOwningThread();
@@ -14,6 +14,7 @@
 #include "mozilla/Variant.h"
 #include "nsStringFlags.h"
 #include "nsStringFwd.h"
+#include "nsTArray.h"
 
 namespace mozilla::dom::quota {
 
@@ -111,9 +112,53 @@ class OriginScope {
     }
   };
 
+  class OriginList {
+    nsTArray<nsCString> mOrigins;
+
+   public:
+    explicit OriginList(nsTArray<nsCString>&& aOrigins)
+        : mOrigins(std::move(aOrigins)) {}
+
+    OriginList(const OriginList& aOther)
+        : mOrigins(aOther.mOrigins.Clone()) {}
+
+    OriginList(OriginList&& aOther) = default;
+
+    const nsTArray<nsCString>& GetOrigins() const { return mOrigins; }
+
+    bool ContainsOrigin(const nsACString& aOrigin) const {
+      return mOrigins.Contains(aOrigin);
+    }
+
+    bool ContainsOriginNoSuffix(const nsACString& aOriginNoSuffix) const {
+      for (const auto& origin : mOrigins) {
+        nsCString originNoSuffix;
+        OriginAttributes attributes;
+        if (attributes.PopulateFromOrigin(origin, originNoSuffix) &&
+            originNoSuffix == aOriginNoSuffix) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    bool ContainsMatchingAttributes(
+        const OriginAttributesPattern& aPattern) const {
+      for (const auto& origin : mOrigins) {
+        nsCString originNoSuffix;
+        OriginAttributes attributes;
+        if (attributes.PopulateFromOrigin(origin, originNoSuffix) &&
+            aPattern.Matches(attributes)) {
+          return true;
+        }
+      }
+      return false;
+    }
+  };
+
   struct Null {};
 
-  using DataType = Variant<Origin, Prefix, Pattern, Null>;
+  using DataType = Variant<Origin, Prefix, Pattern, OriginList, Null>;
 
   DataType mData;
 
@@ -136,6 +181,10 @@ class OriginScope {
     return OriginScope(std::move(Pattern(aJSONPattern)));
   }
 
+  static OriginScope FromOrigins(nsTArray<nsCString>&& aOrigins) {
+    return OriginScope(std::move(OriginList(std::move(aOrigins))));
+  }
+
   static OriginScope FromNull() { return OriginScope(std::move(Null())); }
 
   bool IsOrigin() const { return mData.is<Origin>(); }
@@ -144,6 +193,8 @@ class OriginScope {
 
   bool IsPattern() const { return mData.is<Pattern>(); }
 
+  bool IsOriginList() const { return mData.is<OriginList>(); }
+
   bool IsNull() const { return mData.is<Null>(); }
 
   void SetFromOrigin(const nsACString& aOrigin) {
@@ -162,6 +213,10 @@ class OriginScope {
     mData = AsVariant(Pattern(aJSONPattern));
   }
 
+  void SetFromOrigins(nsTArray<nsCString>&& aOrigins) {
+    mData = AsVariant(OriginList(std::move(aOrigins)));
+  }
+
   void SetFromNull() { mData = AsVariant(Null()); }
 
   const nsACString& GetOrigin() const {
@@ -203,6 +258,12 @@ class OriginScope {
     return mData.as<Pattern>().GetJSONPattern();
   }
 
+  const nsTArray<nsCString>& GetOrigins() const {
+    MOZ_ASSERT(IsOriginList());
+
+    return mData.as<OriginList>().GetOrigins();
+  }
+
   void SetPattern(const OriginAttributesPattern& aPattern) {
     MOZ_ASSERT(IsPattern());
 
@@ -227,6 +288,10 @@ class OriginScope {
         return mThis.MatchesPattern(aOther);
       }
 
+      bool operator()(const OriginList& aOther) {
+        return mThis.MatchesOriginList(aOther);
+      }
+
       bool operator()(const Null& aOther) { return true; }
     };
 
@@ -243,6 +308,9 @@ class OriginScope {
 
   explicit OriginScope(const Pattern&& aPattern) : mData(aPattern) {}
 
+  explicit OriginScope(OriginList&& aOriginList)
+      : mData(std::move(aOriginList)) {}
+
   explicit OriginScope(const Null&& aNull) : mData(aNull) {}
 
   // Copy constructor
@@ -266,6 +334,10 @@ class OriginScope {
         return aThis.GetPattern().Matches(mOther.GetAttributes());
       }
 
+      bool operator()(const OriginList& aThis) {
+        return aThis.ContainsOrigin(mOther.GetOrigin());
+      }
+
       bool operator()(const Null& aThis) {
         // Null covers everything.
         return true;
@@ -296,6 +368,10 @@ class OriginScope {
         return true;
       }
 
+      bool operator()(const OriginList& aThis) {
+        return aThis.ContainsOriginNoSuffix(mOther.GetOriginNoSuffix());
+      }
+
       bool operator()(const Null& aThis) {
         // Null covers everything.
         return true;
@@ -326,6 +402,10 @@ class OriginScope {
         return aThis.GetPattern().Overlaps(mOther.GetPattern());
       }
 
+      bool operator()(const OriginList& aThis) {
+        return aThis.ContainsMatchingAttributes(mOther.GetPattern());
+      }
+
       bool operator()(const Null& aThis) {
         // Null covers everything.
         return true;
@@ -336,6 +416,42 @@ class OriginScope {
     return mData.match(PatternMatcher(aOther));
   }
 
+  bool MatchesOriginList(const OriginList& aOther) const {
+    struct OriginListMatcher {
+      const OriginList& mOther;
+
+      explicit OriginListMatcher(const OriginList& aOther) : mOther(aOther) {}
+
+      bool operator()(const Origin& aThis) {
+        return mOther.ContainsOrigin(aThis.GetOrigin());
+      }
+
+      bool operator()(const Prefix& aThis) {
+        return mOther.ContainsOriginNoSuffix(aThis.GetOriginNoSuffix());
+      }
+
+      bool operator()(const Pattern& aThis) {
+        return mOther.ContainsMatchingAttributes(aThis.GetPattern());
+      }
+
+      bool operator()(const OriginList& aThis) {
+        for (const auto& origin : aThis.GetOrigins()) {
+          if (mOther.ContainsOrigin(origin)) {
+            return true;
+          }
+        }
+        return false;
+      }
+
+      bool operator()(const Null& aThis) {
+        // Null covers everything.
+        return true;
+      }
+    };
+
+    return mData.match(OriginListMatcher(aOther));
+  }
+
   bool operator==(const OriginScope& aOther) = delete;
 };
 
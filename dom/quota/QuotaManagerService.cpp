@@ -746,6 +746,39 @@ QuotaManagerService::ClearStoragesForPrincipal(
   return NS_OK;
 }
 
+NS_IMETHODIMP
+QuotaManagerService::ClearStoragesForPrincipals(
+    const nsTArray<RefPtr<nsIPrincipal>>& aPrincipals,
+    nsIQuotaRequest** _retval) {
+  MOZ_ASSERT(NS_IsMainThread());
+
+  RefPtr<Request> request = new Request();
+
+  ClearOriginsParams params;
+
+  for (const auto& principal : aPrincipals) {
+    if (NS_WARN_IF(!principal)) {
+      return NS_ERROR_INVALID_ARG;
+    }
+
+    nsresult rv = CheckedPrincipalToPrincipalInfo(
+        principal, *params.principalInfos().AppendElement());
+    if (NS_WARN_IF(NS_FAILED(rv))) {
+      return rv;
+    }
+  }
+
+  RequestInfo info(request, params);
+
+  nsresult rv = InitiateRequest(info);
+  if (NS_WARN_IF(NS_FAILED(rv))) {
+    return rv;
+  }
+
+  request.forget(_retval);
+  return NS_OK;
+}
+
 NS_IMETHODIMP
 QuotaManagerService::Reset(nsIQuotaRequest** _retval) {
   MOZ_ASSERT(NS_IsMainThread());
@@ -401,6 +401,17 @@ ScriptLoadHandler::OnStreamComplete(nsIIncrementalStreamLoader* aLoader,
     }
   }
 
+  // Remember whether the script was served from the HTTP cache. Scripts we
+  // have seen before are likely to run again, so the loader full-parses them
+  // off thread rather than paying delazification costs on every visit.
+  if (NS_SUCCEEDED(rv)) {
+    nsCOMPtr<nsICacheInfoChannel> cacheInfo = do_QueryInterface(channelRequest);
+    bool fromCache = false;
+    if (cacheInfo && NS_SUCCEEDED(cacheInfo->IsFromCache(&fromCache))) {
+      mRequest->mIsFromCache = fromCache;
+    }
+  }
+
   // Everything went well, keep the CacheInfoChannel alive such that we can
   // later save the bytecode on the cache entry.
   if (NS_SUCCEEDED(rv) && mRequest->IsSource() &&
@@ -98,6 +98,7 @@ ScriptLoadRequest::ScriptLoadRequest(ScriptKind aKind, nsIURI* aURI,
       mIsCanceled(false),
       mWasCompiledOMT(false),
       mIsTracking(false),
+      mIsFromCache(false),
       mFetchOptions(aFetchOptions),
       mOffThreadToken(nullptr),
       mRunnable(nullptr),
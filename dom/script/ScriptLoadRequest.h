@@ -295,6 +295,9 @@ class ScriptLoadRequest
                          // thread.
   bool mIsTracking;      // True if the script comes from a source on our
                          // tracking protection list.
+  bool mIsFromCache;     // True if the script was served from the HTTP
+                         // cache, which makes it a candidate for eager
+                         // off-thread full parsing.
 
   RefPtr<ScriptFetchOptions> mFetchOptions;
 
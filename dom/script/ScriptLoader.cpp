@@ -2618,7 +2618,13 @@ nsresult ScriptLoader::AttemptAsyncScriptCompile(ScriptLoadRequest* aRequest,
     nsresult rv = GetScriptSource(cx, aRequest, &maybeSource);
     NS_ENSURE_SUCCESS(rv, rv);
 
-    if (StaticPrefs::dom_script_loader_full_parse()) {
+    // Scripts served from the HTTP cache have usually been run before and
+    // will be run again, so parse them fully on the helper thread up front
+    // instead of delazifying the same inner functions on the main thread on
+    // every visit.
+    if (StaticPrefs::dom_script_loader_full_parse() ||
+        (aRequest->mIsFromCache &&
+         StaticPrefs::dom_script_loader_full_parse_from_cache())) {
       options.setForceFullParse();
     }
 
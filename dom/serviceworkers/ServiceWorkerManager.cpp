@@ -2215,7 +2215,13 @@ bool ServiceWorkerManager::IsAvailable(nsIPrincipal* aPrincipal, nsIURI* aURI,
     registration->MaybeScheduleUpdate();
     return false;
   }
-  // Found a matching service worker which handles fetch events, return true.
+  // Found a matching service worker which handles fetch events. A fetch
+  // event for this request will be dispatched once the interception is set
+  // up; start the worker now so a cold start overlaps with that setup
+  // instead of serializing behind it.
+  RefPtr<ServiceWorkerPrivate> workerPrivate =
+      registration->GetActive()->WorkerPrivate();
+  Unused << workerPrivate->SpeculativeStartWorker();
   return true;
 }
 
@@ -2134,5 +2134,15 @@ void ServiceWorkerPrivate::SetHandlesFetch(bool aValue) {
   mInfo->SetHandlesFetch(aValue);
 }
 
+nsresult ServiceWorkerPrivate::SpeculativeStartWorker() {
+  MOZ_ASSERT(NS_IsMainThread());
+
+  if (mInner) {
+    return mInner->SpawnWorkerIfNeeded();
+  }
+
+  return SpawnWorkerIfNeeded(FetchEvent);
+}
+
 }  // namespace dom
 }  // namespace mozilla
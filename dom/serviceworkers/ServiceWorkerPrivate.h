@@ -220,6 +220,13 @@ class ServiceWorkerPrivate final {
 
   void SetHandlesFetch(bool aValue);
 
+  // Speculatively start the worker when a fetch event is expected shortly
+  // (e.g. an intercepted navigation that will dispatch one), so worker
+  // startup overlaps with the channel setup instead of serializing behind
+  // it. Safe to call when the worker is already running; if no event ever
+  // arrives the regular idle timeout terminates the worker.
+  nsresult SpeculativeStartWorker();
+
  private:
   enum WakeUpReason {
     FetchEvent = 0,
@@ -303,7 +303,7 @@ void SMILAnimationController::DoSample(bool aSkipUnchangedContainers) {
   // (i)  Rewind elements where necessary
   // (ii) Run milestone samples
   RewindElements();
-  DoMilestoneSamples();
+  const bool didMilestoneSamples = DoMilestoneSamples();
 
   // STEP 2: Sample the child time containers
   //
@@ -324,6 +324,17 @@ void SMILAnimationController::DoSample(bool aSkipUnchangedContainers) {
     }
   }
 
+  // If no container needed a sample, no milestone fired and nothing has
+  // requested a resample, then no animation function has changed state since
+  // the previous sample and rebuilding the compositor table below would just
+  // reproduce mLastCompositorTable. Returning here keeps documents full of
+  // paused (or long-since-finished) animations from paying a walk over every
+  // registered animation element on each tick.
+  if (activeContainers.Count() == 0 && !didMilestoneSamples &&
+      !isStyleFlushNeeded) {
+    return;
+  }
+
   // STEP 3: (i)  Sample the timed elements AND
   //         (ii) Create a table of compositors
   //
@@ -439,7 +450,7 @@ void SMILAnimationController::RewindElements() {
   }
 }
 
-void SMILAnimationController::DoMilestoneSamples() {
+bool SMILAnimationController::DoMilestoneSamples() {
   // We need to sample the timing model but because SMIL operates independently
   // of the frame-rate, we can get one sample at t=0s and the next at t=10min.
   //
@@ -458,6 +469,7 @@ void SMILAnimationController::DoMilestoneSamples() {
   // dependencies can be resolved etc.
 
   SMILTime sampleTime = INT64_MIN;
+  bool sampledAny = false;
 
   while (true) {
     // We want to find any milestones AT OR BEFORE the current sample time so we
@@ -525,8 +537,11 @@ void SMILAnimationController::DoMilestoneSamples() {
       } else {
         elem->TimedElement().SampleAt(containerTime);
       }
+      sampledAny = true;
     }
   }
+
+  return sampledAny;
 }
 
 /*static*/
@@ -135,7 +135,8 @@ class SMILAnimationController final : public SMILTimeContainer,
 
   void RewindElements();
 
-  void DoMilestoneSamples();
+  // Returns true if any timed element was sampled at a milestone.
+  bool DoMilestoneSamples();
 
   static void SampleTimedElement(mozilla::dom::SVGAnimationElement* aElement,
                                  TimeContainerHashtable* aActiveContainers);
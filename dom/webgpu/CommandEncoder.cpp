@@ -109,6 +109,18 @@ void CommandEncoder::Cleanup() {
   }
 }
 
+void CommandEncoder::PushAction(ipc::ByteBuf&& aByteBuf) {
+  mPendingActions.AppendElement(std::move(aByteBuf));
+}
+
+void CommandEncoder::FlushPendingActions() {
+  if (mPendingActions.IsEmpty()) {
+    return;
+  }
+  mBridge->SendCommandEncoderActions(mId, mParent->mId,
+                                     std::move(mPendingActions));
+}
+
 void CommandEncoder::CopyBufferToBuffer(const Buffer& aSource,
                                         BufferAddress aSourceOffset,
                                         const Buffer& aDestination,
@@ -119,7 +131,7 @@ void CommandEncoder::CopyBufferToBuffer(const Buffer& aSource,
     ffi::wgpu_command_encoder_copy_buffer_to_buffer(
         aSource.mId, aSourceOffset, aDestination.mId, aDestinationOffset, aSize,
         ToFFI(&bb));
-    mBridge->SendCommandEncoderAction(mId, mParent->mId, std::move(bb));
+    PushAction(std::move(bb));
   }
 }
 
@@ -132,7 +144,7 @@ void CommandEncoder::CopyBufferToTexture(
     ffi::wgpu_command_encoder_copy_buffer_to_texture(
         ConvertBufferCopyView(aSource), ConvertTextureCopyView(aDestination),
         ConvertExtent(aCopySize), ToFFI(&bb));
-    mBridge->SendCommandEncoderAction(mId, mParent->mId, std::move(bb));
+    PushAction(std::move(bb));
 
     const auto& targetCanvas = aDestination.mTexture->mTargetCanvasElement;
     if (targetCanvas) {
@@ -149,7 +161,7 @@ void CommandEncoder::CopyTextureToBuffer(
     ffi::wgpu_command_encoder_copy_texture_to_buffer(
         ConvertTextureCopyView(aSource), ConvertBufferCopyView(aDestination),
         ConvertExtent(aCopySize), ToFFI(&bb));
-    mBridge->SendCommandEncoderAction(mId, mParent->mId, std::move(bb));
+    PushAction(std::move(bb));
   }
 }
 void CommandEncoder::CopyTextureToTexture(
@@ -161,7 +173,7 @@ void CommandEncoder::CopyTextureToTexture(
     ffi::wgpu_command_encoder_copy_texture_to_texture(
         ConvertTextureCopyView(aSource), ConvertTextureCopyView(aDestination),
         ConvertExtent(aCopySize), ToFFI(&bb));
-    mBridge->SendCommandEncoderAction(mId, mParent->mId, std::move(bb));
+    PushAction(std::move(bb));
 
     const auto& targetCanvas = aDestination.mTexture->mTargetCanvasElement;
     if (targetCanvas) {
@@ -201,7 +213,7 @@ void CommandEncoder::EndComputePass(ffi::WGPUComputePass& aPass,
 
   ipc::ByteBuf byteBuf;
   ffi::wgpu_compute_pass_finish(&aPass, ToFFI(&byteBuf));
-  mBridge->SendCommandEncoderAction(mId, mParent->mId, std::move(byteBuf));
+  PushAction(std::move(byteBuf));
 }
 
 void CommandEncoder::EndRenderPass(ffi::WGPURenderPass& aPass,
@@ -212,7 +224,7 @@ void CommandEncoder::EndRenderPass(ffi::WGPURenderPass& aPass,
 
   ipc::ByteBuf byteBuf;
   ffi::wgpu_render_pass_finish(&aPass, ToFFI(&byteBuf));
-  mBridge->SendCommandEncoderAction(mId, mParent->mId, std::move(byteBuf));
+  PushAction(std::move(byteBuf));
 }
 
 already_AddRefed<CommandBuffer> CommandEncoder::Finish(
@@ -220,6 +232,9 @@ already_AddRefed<CommandBuffer> CommandEncoder::Finish(
   RawId id = 0;
   if (mValid) {
     mValid = false;
+    // The accumulated actions must reach the parent before the finish
+    // message that consumes them.
+    FlushPendingActions();
     id = mBridge->CommandEncoderFinish(mId, mParent->mId, aDesc);
   }
   RefPtr<CommandBuffer> comb =
@@ -7,6 +7,7 @@
 #define GPU_CommandEncoder_H_
 
 #include "mozilla/dom/TypedArray.h"
+#include "mozilla/ipc/ByteBuf.h"
 #include "mozilla/WeakPtr.h"
 #include "mozilla/webgpu/WebGPUTypes.h"
 #include "nsWrapperCache.h"
@@ -68,8 +69,16 @@ class CommandEncoder final : public ObjectBase, public ChildOf<Device> {
   ~CommandEncoder();
   void Cleanup();
 
+  // Queue an encoded action for this encoder. Actions are self-contained
+  // and only ordered relative to each other, so they are accumulated here
+  // and sent to the parent in a single message when the encoder finishes,
+  // instead of one IPC message per pass or copy.
+  void PushAction(ipc::ByteBuf&& aByteBuf);
+  void FlushPendingActions();
+
   RefPtr<WebGPUChild> mBridge;
   nsTArray<WeakPtr<dom::HTMLCanvasElement>> mTargetCanvases;
+  nsTArray<ipc::ByteBuf> mPendingActions;
 
  public:
   void EndComputePass(ffi::WGPUComputePass& aPass, ErrorResult& aRv);
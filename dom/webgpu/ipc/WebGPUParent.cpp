@@ -769,6 +769,17 @@ ipc::IPCResult WebGPUParent::RecvCommandEncoderAction(
   return IPC_OK();
 }
 
+ipc::IPCResult WebGPUParent::RecvCommandEncoderActions(
+    RawId aSelf, RawId aDevice, nsTArray<ipc::ByteBuf>&& aByteBufs) {
+  for (const auto& byteBuf : aByteBufs) {
+    ErrorBuffer error;
+    ffi::wgpu_server_command_encoder_action(mContext, aSelf, ToFFI(&byteBuf),
+                                            error.ToFFI());
+    ForwardError(aDevice, error);
+  }
+  return IPC_OK();
+}
+
 ipc::IPCResult WebGPUParent::RecvBumpImplicitBindGroupLayout(RawId aPipelineId,
                                                              bool aIsCompute,
                                                              uint32_t aIndex,
@@ -78,6 +78,8 @@ class WebGPUParent final : public PWebGPUParent {
                                    const ipc::ByteBuf& aByteBuf);
   ipc::IPCResult RecvCommandEncoderAction(RawId aSelf, RawId aDevice,
                                           const ipc::ByteBuf& aByteBuf);
+  ipc::IPCResult RecvCommandEncoderActions(RawId aSelf, RawId aDevice,
+                                           nsTArray<ipc::ByteBuf>&& aByteBufs);
   ipc::IPCResult RecvBumpImplicitBindGroupLayout(RawId aPipelineId,
                                                  bool aIsCompute,
                                                  uint32_t aIndex,
@@ -20,8 +20,20 @@ namespace dom {
 MessageEventRunnable::MessageEventRunnable(WorkerPrivate* aWorkerPrivate,
                                            TargetAndBusyBehavior aBehavior)
     : WorkerDebuggeeRunnable(aWorkerPrivate, aBehavior),
-      StructuredCloneHolder(CloningSupported, TransferringSupported,
-                            StructuredCloneScope::SameProcess) {}
+      mMutex("MessageEventRunnable::mMutex"),
+      mSealed(false) {}
+
+bool MessageEventRunnable::TryAddMessage(
+    UniquePtr<StructuredCloneHolder>&& aData) {
+  MOZ_ASSERT(aData);
+
+  MutexAutoLock lock(mMutex);
+  if (mSealed) {
+    return false;
+  }
+  mData.AppendElement(std::move(aData));
+  return true;
+}
 
 bool MessageEventRunnable::DispatchDOMEvent(JSContext* aCx,
                                             WorkerPrivate* aWorkerPrivate,
@@ -45,6 +57,30 @@ bool MessageEventRunnable::DispatchDOMEvent(JSContext* aCx,
 
   MOZ_ASSERT(parent);
 
+  // Seal the runnable: messages posted from here on go onto a new runnable.
+  // The batch is drained locally so event listeners (which can post further
+  // messages themselves) run without the lock held.
+  nsTArray<UniquePtr<StructuredCloneHolder>> data;
+  {
+    MutexAutoLock lock(mMutex);
+    mSealed = true;
+    data = std::move(mData);
+  }
+
+  bool ok = true;
+  for (auto& message : data) {
+    if (!DispatchMessageEvent(*message, aCx, aWorkerPrivate, parent, aTarget,
+                              aIsMainThread)) {
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+bool MessageEventRunnable::DispatchMessageEvent(
+    StructuredCloneHolder& aData, JSContext* aCx, WorkerPrivate* aWorkerPrivate,
+    nsIGlobalObject* aParent, DOMEventTargetHelper* aTarget,
+    bool aIsMainThread) {
   JS::Rooted<JS::Value> messageData(aCx);
   IgnoredErrorResult rv;
 
@@ -62,9 +98,9 @@ bool MessageEventRunnable::DispatchDOMEvent(JSContext* aCx,
   }
 
   JS::CloneDataPolicy cloneDataPolicy;
-  if (parent->GetClientInfo().isSome() &&
-      parent->GetClientInfo()->AgentClusterId().isSome() &&
-      parent->GetClientInfo()->AgentClusterId()->Equals(
+  if (aParent->GetClientInfo().isSome() &&
+      aParent->GetClientInfo()->AgentClusterId().isSome() &&
+      aParent->GetClientInfo()->AgentClusterId()->Equals(
           aWorkerPrivate->AgentClusterId())) {
     cloneDataPolicy.allowIntraClusterClonableSharedObjects();
   }
@@ -73,7 +109,7 @@ bool MessageEventRunnable::DispatchDOMEvent(JSContext* aCx,
     cloneDataPolicy.allowSharedMemoryObjects();
   }
 
-  Read(parent, aCx, &messageData, cloneDataPolicy, rv);
+  aData.Read(aParent, aCx, &messageData, cloneDataPolicy, rv);
 
   if (isTimelineRecording) {
     end = MakeUnique<WorkerTimelineMarker>(
@@ -91,7 +127,7 @@ bool MessageEventRunnable::DispatchDOMEvent(JSContext* aCx,
   }
 
   Sequence<OwningNonNull<MessagePort>> ports;
-  if (!TakeTransferredPortsAsSequence(ports)) {
+  if (!aData.TakeTransferredPortsAsSequence(ports)) {
     DispatchError(aCx, aTarget);
     return false;
   }
@@ -9,7 +9,10 @@
 
 #include "WorkerCommon.h"
 #include "WorkerRunnable.h"
+#include "mozilla/Mutex.h"
+#include "mozilla/UniquePtr.h"
 #include "mozilla/dom/StructuredCloneHolder.h"
+#include "nsTArray.h"
 
 namespace mozilla {
 
@@ -17,19 +20,39 @@ class DOMEventTargetHelper;
 
 namespace dom {
 
-class MessageEventRunnable final : public WorkerDebuggeeRunnable,
-                                   public StructuredCloneHolder {
+// A runnable carrying one or more structured-cloned messages to a worker or
+// its parent. A single runnable can deliver a whole batch: while it is still
+// waiting in the target's event queue, additional messages posted to the same
+// destination are appended to it instead of dispatching (and busy-counting)
+// one runnable per message.
+class MessageEventRunnable final : public WorkerDebuggeeRunnable {
  public:
   MessageEventRunnable(WorkerPrivate* aWorkerPrivate,
                        TargetAndBusyBehavior aBehavior);
 
-  bool DispatchDOMEvent(JSContext* aCx, WorkerPrivate* aWorkerPrivate,
-                        DOMEventTargetHelper* aTarget, bool aIsMainThread);
+  // Append an already-written message. This fails once the runnable has
+  // started running on the target thread, in which case the caller must
+  // dispatch a new runnable to preserve message order.
+  bool TryAddMessage(UniquePtr<StructuredCloneHolder>&& aData);
 
  private:
   bool WorkerRun(JSContext* aCx, WorkerPrivate* aWorkerPrivate) override;
 
+  bool DispatchDOMEvent(JSContext* aCx, WorkerPrivate* aWorkerPrivate,
+                        DOMEventTargetHelper* aTarget, bool aIsMainThread);
+
+  bool DispatchMessageEvent(StructuredCloneHolder& aData, JSContext* aCx,
+                            WorkerPrivate* aWorkerPrivate,
+                            nsIGlobalObject* aParent,
+                            DOMEventTargetHelper* aTarget, bool aIsMainThread);
+
   void DispatchError(JSContext* aCx, DOMEventTargetHelper* aTarget);
+
+  // Protects mSealed and mData. The sending thread appends messages while
+  // the receiving thread seals the runnable when it starts to run.
+  Mutex mMutex;
+  bool mSealed;
+  nsTArray<UniquePtr<StructuredCloneHolder>> mData;
 };
 
 }  // namespace dom
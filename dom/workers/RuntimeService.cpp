@@ -62,6 +62,9 @@
 #include "nsServiceManagerUtils.h"
 #include "nsThreadUtils.h"
 #include "nsXPCOM.h"
+#ifdef MOZ_MEMORY
+#  include "mozmemory.h"
+#endif
 #include "nsXPCOMPrivate.h"
 #include "OSFileConstants.h"
 #include "xpcpublic.h"
@@ -1389,6 +1392,33 @@ bool RuntimeService::ScheduleWorker(WorkerPrivate& aWorkerPrivate) {
       UnregisterWorker(aWorkerPrivate);
       return false;
     }
+
+    // The idle pool was empty, so this worker paid for thread creation on
+    // its spawn path. Park a spare thread from an idle task so the next
+    // worker can adopt it instead; if it goes unused the regular idle
+    // timeout reaps it.
+    nsCOMPtr<nsIRunnable> warmup =
+        NS_NewRunnableFunction("RuntimeService::SpareThreadWarmup", []() {
+          RuntimeService* rts = RuntimeService::GetService();
+          if (!rts || rts->mShuttingDown) {
+            return;
+          }
+
+          {
+            MutexAutoLock lock(rts->mMutex);
+            if (!rts->mIdleThreadArray.IsEmpty()) {
+              return;
+            }
+          }
+
+          const WorkerThreadFriendKey friendKey;
+          SafeRefPtr<WorkerThread> spare = WorkerThread::Create(friendKey);
+          if (spare) {
+            rts->NoteIdleThread(std::move(spare));
+          }
+        });
+    NS_DispatchToCurrentThreadQueue(warmup.forget(),
+                                    EventQueuePriority::Idle);
   }
 
   if (NS_FAILED(thread->SetPriority(nsISupportsPriority::PRIORITY_NORMAL))) {
@@ -2186,6 +2216,15 @@ WorkerThreadPrimaryRunnable::Run() {
 
   using mozilla::ipc::BackgroundChild;
 
+#ifdef MOZ_MEMORY
+  // Have the worker allocate from its own jemalloc arena for its whole run,
+  // keeping it off the default arena's lock. The arena is handed back for
+  // reuse by a later worker when this thread winds down.
+  jemalloc_thread_local_arena(true);
+  const auto arenaCleanup =
+      MakeScopeExit([] { jemalloc_thread_local_arena(false); });
+#endif
+
   {
     auto failureCleanup = MakeScopeExit([&]() {
       // The creation of threadHelper above is the point at which a worker is
@@ -11,7 +11,6 @@
 #include "mozilla/ProfilerLabels.h"
 #include "mozilla/ProfilerMarkers.h"
 #include "mozilla/TimelineConsumers.h"
-#include "mozilla/Unused.h"
 #include "mozilla/WorkerTimelineMarker.h"
 #include "nsContentUtils.h"
 #include "nsGlobalWindowOuter.h"
@@ -109,8 +108,10 @@ void Worker::PostMessage(JSContext* aCx, JS::Handle<JS::Value> aMessage,
       JS::ProfilingCategoryPair::DOM, flags);
 #endif
 
-  RefPtr<MessageEventRunnable> runnable = new MessageEventRunnable(
-      mWorkerPrivate, WorkerRunnable::WorkerThreadModifyBusyCount);
+  auto data = MakeUnique<StructuredCloneHolder>(
+      StructuredCloneHolder::CloningSupported,
+      StructuredCloneHolder::TransferringSupported,
+      JS::StructuredCloneScope::SameProcess);
 
   UniquePtr<AbstractTimelineMarker> start;
   UniquePtr<AbstractTimelineMarker> end;
@@ -141,7 +142,7 @@ void Worker::PostMessage(JSContext* aCx, JS::Handle<JS::Value> aMessage,
     }
   }
 
-  runnable->Write(aCx, aMessage, transferable, clonePolicy, aRv);
+  data->Write(aCx, aMessage, transferable, clonePolicy, aRv);
 
   if (isTimelineRecording) {
     end = MakeUnique<WorkerTimelineMarker>(
@@ -157,10 +158,26 @@ void Worker::PostMessage(JSContext* aCx, JS::Handle<JS::Value> aMessage,
     return;
   }
 
+  // If the runnable from an earlier postMessage hasn't started running on
+  // the worker yet, batch this message onto it instead of dispatching
+  // another runnable.
+  if (mLastMessageEventRunnable &&
+      mLastMessageEventRunnable->TryAddMessage(std::move(data))) {
+    return;
+  }
+
+  RefPtr<MessageEventRunnable> runnable = new MessageEventRunnable(
+      mWorkerPrivate, WorkerRunnable::WorkerThreadModifyBusyCount);
+  MOZ_ALWAYS_TRUE(runnable->TryAddMessage(std::move(data)));
+
   // The worker could have closed between the time we entered this function and
   // checked ParentStatusProtected and now, which could cause the dispatch to
   // fail.
-  Unused << NS_WARN_IF(!runnable->Dispatch());
+  if (NS_WARN_IF(!runnable->Dispatch())) {
+    return;
+  }
+
+  mLastMessageEventRunnable = runnable;
 }
 
 void Worker::PostMessage(JSContext* aCx, JS::Handle<JS::Value> aMessage,
@@ -20,6 +20,7 @@
 namespace mozilla {
 namespace dom {
 
+class MessageEventRunnable;
 struct PostMessageOptions;
 struct WorkerOptions;
 class WorkerPrivate;
@@ -60,6 +61,11 @@ class Worker : public DOMEventTargetHelper, public SupportsWeakPtr {
   ~Worker();
 
   RefPtr<WorkerPrivate> mWorkerPrivate;
+
+  // The runnable dispatched by the last PostMessage call. While it is still
+  // queued on the worker thread, further messages are batched onto it
+  // instead of dispatching one runnable per message.
+  RefPtr<MessageEventRunnable> mLastMessageEventRunnable;
 };
 
 }  // namespace dom
@@ -4237,8 +4237,10 @@ void WorkerPrivate::PostMessageToParent(
     return;
   }
 
-  RefPtr<MessageEventRunnable> runnable = new MessageEventRunnable(
-      this, WorkerRunnable::ParentThreadUnchangedBusyCount);
+  auto messageData = MakeUnique<StructuredCloneHolder>(
+      StructuredCloneHolder::CloningSupported,
+      StructuredCloneHolder::TransferringSupported,
+      JS::StructuredCloneScope::SameProcess);
 
   UniquePtr<AbstractTimelineMarker> start;
   UniquePtr<AbstractTimelineMarker> end;
@@ -4262,7 +4264,7 @@ void WorkerPrivate::PostMessageToParent(
     clonePolicy.allowSharedMemoryObjects();
   }
 
-  runnable->Write(aCx, aMessage, transferable, clonePolicy, aRv);
+  messageData->Write(aCx, aMessage, transferable, clonePolicy, aRv);
 
   if (isTimelineRecording) {
     end = MakeUnique<WorkerTimelineMarker>(
@@ -4278,9 +4280,26 @@ void WorkerPrivate::PostMessageToParent(
     return;
   }
 
+  auto data = mWorkerThreadAccessible.Access();
+
+  // If the runnable from an earlier postMessage hasn't started running on
+  // the parent yet, batch this message onto it instead of dispatching
+  // another runnable.
+  if (data->mLastMessageEventRunnable &&
+      data->mLastMessageEventRunnable->TryAddMessage(std::move(messageData))) {
+    return;
+  }
+
+  RefPtr<MessageEventRunnable> runnable = new MessageEventRunnable(
+      this, WorkerRunnable::ParentThreadUnchangedBusyCount);
+  MOZ_ALWAYS_TRUE(runnable->TryAddMessage(std::move(messageData)));
+
   if (!runnable->Dispatch()) {
     aRv = NS_ERROR_FAILURE;
+    return;
   }
+
+  data->mLastMessageEventRunnable = runnable;
 }
 
 void WorkerPrivate::EnterDebuggerEventLoop() {
@@ -70,6 +70,7 @@ class WorkerErrorReport;
 class WorkerEventTarget;
 class WorkerGlobalScope;
 class WorkerRef;
+class MessageEventRunnable;
 class WorkerRunnable;
 class WorkerDebuggeeRunnable;
 class WorkerThread;
@@ -1244,6 +1245,11 @@ class WorkerPrivate final : public RelativeTimeline {
 
     RefPtr<MemoryReporter> mMemoryReporter;
 
+    // The runnable dispatched by the last PostMessageToParent call. While it
+    // is still queued on the parent, further messages are batched onto it
+    // instead of dispatching one runnable per message.
+    RefPtr<MessageEventRunnable> mLastMessageEventRunnable;
+
     // While running a nested event loop, whether a sync loop or a debugger
     // event loop we want to keep track of which global is running it, if any,
     // so runnables that run off that event loop can get at that information. In
@@ -1943,6 +1943,24 @@ XMLHttpRequestMainThread::OnStartRequest(nsIRequest* request) {
     }
   }
 
+  if (NS_SUCCEEDED(status) &&
+      (mResponseType == XMLHttpRequestResponseType::_empty ||
+       mResponseType == XMLHttpRequestResponseType::Text ||
+       mResponseType == XMLHttpRequestResponseType::Json)) {
+    // Pre-size the response text like we pre-size the ArrayBuffer above, so
+    // that accumulating a large response doesn't keep reallocating and
+    // copying the buffer as chunks arrive. None of the encodings we decode
+    // produce more UTF-16 code units than there are input bytes, so the
+    // Content-Length is a safe capacity bound; for UTF-16 sources we
+    // over-allocate by at most 2x until the load completes.
+    int64_t contentLength;
+    rv = channel->GetContentLength(&contentLength);
+    if (NS_SUCCEEDED(rv) && contentLength > 0 &&
+        contentLength < XML_HTTP_REQUEST_MAX_CONTENT_LENGTH_PREALLOCATE) {
+      mResponseText.SetCapacity(static_cast<uint32_t>(contentLength));
+    }
+  }
+
   // Set up responseXML
   // Note: Main Fetch step 18 requires to ignore body for head/connect methods.
   bool parseBody = (mResponseType == XMLHttpRequestResponseType::_empty ||
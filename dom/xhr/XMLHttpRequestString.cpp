@@ -7,6 +7,7 @@
 #include "XMLHttpRequestString.h"
 #include "nsISupportsImpl.h"
 #include "mozilla/dom/DOMString.h"
+#include "mozilla/Unused.h"
 
 namespace mozilla {
 namespace dom {
@@ -33,6 +34,13 @@ class XMLHttpRequestStringBuffer final {
     return mData.BulkWrite(aCapacity, UnsafeLength(), false);
   }
 
+  void SetCapacity(uint32_t aCapacity) {
+    NS_ASSERT_OWNINGTHREAD(XMLHttpRequestStringBuffer);
+
+    MutexAutoLock lock(mMutex);
+    mozilla::Unused << mData.SetCapacity(aCapacity, mozilla::fallible);
+  }
+
   void Append(const nsAString& aString) {
     NS_ASSERT_OWNINGTHREAD(XMLHttpRequestStringBuffer);
 
@@ -101,6 +109,10 @@ void XMLHttpRequestString::Truncate() {
 
 uint32_t XMLHttpRequestString::Length() const { return mBuffer->Length(); }
 
+void XMLHttpRequestString::SetCapacity(uint32_t aCapacity) {
+  mBuffer->SetCapacity(aCapacity);
+}
+
 void XMLHttpRequestString::Append(const nsAString& aString) {
   mBuffer->Append(aString);
 }
@@ -36,6 +36,12 @@ class XMLHttpRequestString final {
 
   uint32_t Length() const;
 
+  // Best-effort capacity hint, used when the expected size of the response is
+  // known up front so that appending doesn't repeatedly reallocate and copy
+  // the buffer. Allocation failure is ignored; we just grow on demand as
+  // usual.
+  void SetCapacity(uint32_t aCapacity);
+
   void Append(const nsAString& aString);
 
   // This method should be called only when the string is really needed because
@@ -113,6 +113,8 @@ nsresult txStylesheet::findTemplate(const txXPathNode& aNode,
   txPattern* match = 0;
 #endif
 
+  RefPtr<nsAtom> localName = txXPathNodeUtils::getLocalName(aNode);
+
   ImportFrame* frame;
   while (!*aTemplate && (frame = static_cast<ImportFrame*>(frameIter.next())) &&
          frame != endFrame) {
@@ -125,6 +127,12 @@ nsresult txStylesheet::findTemplate(const txXPathNode& aNode,
       uint32_t i, len = templates->Length();
       for (i = 0; i < len && !*aTemplate; ++i) {
         MatchableTemplate& templ = (*templates)[i];
+        if (templ.mLocalNameFilter && templ.mLocalNameFilter != localName) {
+          // The pattern can only match nodes with a different name, so
+          // don't bother evaluating it.
+          continue;
+        }
+
         bool matched;
         nsresult rv = templ.mMatch->matches(aNode, aContext, matched);
         NS_ENSURE_SUCCESS(rv, rv);
@@ -393,6 +401,7 @@ nsresult txStylesheet::addTemplate(txTemplateItem* aTemplate,
     NS_ENSURE_TRUE(nt, NS_ERROR_OUT_OF_MEMORY);
 
     nt->mFirstInstruction = instr;
+    nt->mLocalNameFilter = simple->getLocalNameFilter();
     nt->mMatch = std::move(simple);
     nt->mPriority = priority;
 
@@ -68,6 +68,10 @@ class txStylesheet final {
     txInstruction* mFirstInstruction;
     mozilla::UniquePtr<txPattern> mMatch;
     double mPriority;
+    // The local name required of nodes for mMatch to possibly match, or
+    // null if mMatch can match nodes with any name. The atom is owned by
+    // mMatch.
+    nsAtom* mLocalNameFilter;
   };
 
   /**
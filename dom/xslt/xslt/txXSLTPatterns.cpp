@@ -14,6 +14,7 @@
 #include "txXSLTFunctions.h"
 #include "nsWhitespaceTokenizer.h"
 #include "nsIContent.h"
+#include "nsGkAtoms.h"
 
 #ifdef TX_TO_STRING
 #  include "nsReadableUtils.h"
@@ -200,6 +201,12 @@ double txLocPathPattern::getDefaultPriority() {
   return 0.5;
 }
 
+nsAtom* txLocPathPattern::getLocalNameFilter() {
+  // The last step is the one that is matched against the node itself, the
+  // earlier steps only restrict its ancestry.
+  return mSteps.LastElement().pattern->getLocalNameFilter();
+}
+
 TX_IMPL_PATTERN_STUBS_NO_SUB_EXPR(txLocPathPattern)
 txPattern* txLocPathPattern::getSubPatternAt(uint32_t aPos) {
   return aPos < mSteps.Length() ? mSteps[aPos].pattern.get() : nullptr;
@@ -513,6 +520,15 @@ double txStepPattern::getDefaultPriority() {
 
 txPattern::Type txStepPattern::getType() { return STEP_PATTERN; }
 
+nsAtom* txStepPattern::getLocalNameFilter() {
+  if (mNodeTest->getType() != txNodeTest::NAME_TEST) {
+    return nullptr;
+  }
+
+  nsAtom* localName = static_cast<txNameTest*>(mNodeTest.get())->mLocalName;
+  return localName == nsGkAtoms::_asterisk ? nullptr : localName;
+}
+
 TX_IMPL_PATTERN_STUBS_NO_SUB_PATTERN(txStepPattern)
 Expr* txStepPattern::getSubExprAt(uint32_t aPos) {
   return PredicateList::getSubExprAt(aPos);
@@ -36,6 +36,14 @@ class txPattern {
   enum Type { STEP_PATTERN, UNION_PATTERN, OTHER_PATTERN };
   virtual Type getType() { return OTHER_PATTERN; }
 
+  /**
+   * Returns the local name that any node matched by this pattern must
+   * have, or null if the pattern can match nodes regardless of their
+   * name. Used by txStylesheet::findTemplate to reject templates
+   * without evaluating the full pattern.
+   */
+  virtual nsAtom* getLocalNameFilter() { return nullptr; }
+
   /**
    * Returns sub-expression at given position
    */
@@ -121,6 +129,7 @@ class txLocPathPattern : public txPattern {
   nsresult addStep(txPattern* aPattern, bool isChild);
 
   TX_DECL_PATTERN;
+  nsAtom* getLocalNameFilter() override;
 
  private:
   class Step {
@@ -188,6 +197,7 @@ class txStepPattern : public txPattern, public PredicateList {
 
   TX_DECL_PATTERN;
   Type getType() override;
+  nsAtom* getLocalNameFilter() override;
 
   txNodeTest* getNodeTest() { return mNodeTest.get(); }
   void setNodeTest(txNodeTest* aNodeTest) {
@@ -10,6 +10,8 @@
 #include "mozilla/DebugOnly.h"
 #include "nsContentUtils.h"
 #include "nsIChannel.h"
+#include "nsIFile.h"
+#include "nsIFileURL.h"
 #include "nsILoadInfo.h"
 #include "nsNetUtil.h"
 #include "nsUnicharUtils.h"
@@ -27,6 +29,18 @@ Result<Ok, nsresult> mozHunspellFileMgrHost::Open(const nsCString& aPath) {
   nsCOMPtr<nsIURI> uri;
   MOZ_TRY(NS_NewURI(getter_AddRefs(uri), aPath));
 
+  // Prefer mapping local dictionary files into memory over channel I/O; see
+  // the comment on mMap in the header. Dictionaries inside jar archives have
+  // to be decompressed, so they keep using a channel.
+  if (nsCOMPtr<nsIFileURL> fileURL = do_QueryInterface(uri)) {
+    nsCOMPtr<nsIFile> file;
+    if (NS_SUCCEEDED(fileURL->GetFile(getter_AddRefs(file))) &&
+        mMap.init(file).isOk()) {
+      return Ok();
+    }
+    // Fall through to the channel path if the file couldn't be mapped.
+  }
+
   nsCOMPtr<nsIChannel> channel;
   MOZ_TRY(NS_NewChannel(
       getter_AddRefs(channel), uri, nsContentUtils::GetSystemPrincipal(),
@@ -38,6 +52,10 @@ Result<Ok, nsresult> mozHunspellFileMgrHost::Open(const nsCString& aPath) {
 }
 
 Result<Ok, nsresult> mozHunspellFileMgrHost::ReadLine(nsCString& aLine) {
+  if (mMap.initialized()) {
+    return ReadMappedLine(aLine);
+  }
+
   if (!mStream) {
     return Err(NS_ERROR_NOT_INITIALIZED);
   }
@@ -52,6 +70,38 @@ Result<Ok, nsresult> mozHunspellFileMgrHost::ReadLine(nsCString& aLine) {
   return Ok();
 }
 
+// Serves lines straight out of the read-only mapping, with the same
+// behavior as the NS_ReadLine path: '\r', '\n' and "\r\n" all terminate a
+// line, the last line is returned without a terminator, and reading past
+// the end of the file fails.
+Result<Ok, nsresult> mozHunspellFileMgrHost::ReadMappedLine(nsCString& aLine) {
+  if (mMapAtEof) {
+    return Err(NS_ERROR_NOT_INITIALIZED);
+  }
+
+  const char* data = mMap.get<char>().get();
+  const uint32_t size = mMap.size();
+  uint32_t pos = mMapOffset;
+  while (pos < size && data[pos] != '\n' && data[pos] != '\r') {
+    pos++;
+  }
+  aLine.Assign(data + mMapOffset, pos - mMapOffset);
+
+  if (pos == size) {
+    mMapAtEof = true;
+  } else {
+    // Skip the line terminator; "\r\n" counts as a single terminator.
+    if (data[pos] == '\r' && pos + 1 < size && data[pos + 1] == '\n') {
+      pos++;
+    }
+    pos++;
+  }
+  mMapOffset = pos;
+
+  mLineNum++;
+  return Ok();
+}
+
 bool mozHunspellFileMgrHost::GetLine(std::string& aResult) {
   nsAutoCString line;
   auto res = ReadLine(line);
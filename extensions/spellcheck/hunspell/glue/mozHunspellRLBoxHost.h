@@ -18,6 +18,7 @@
 #include "mozilla/Result.h"
 #include "mozilla/ResultExtensions.h"
 #include "mozilla/RWLock.h"
+#include "mozilla/loader/AutoMemMap.h"
 #include "nsIInputStream.h"
 #include "nsReadLine.h"
 
@@ -38,8 +39,18 @@ class mozHunspellFileMgrHost final {
   mozilla::Result<mozilla::Ok, nsresult> Open(const nsCString& aPath);
 
   mozilla::Result<mozilla::Ok, nsresult> ReadLine(nsCString& aLine);
+  mozilla::Result<mozilla::Ok, nsresult> ReadMappedLine(nsCString& aLine);
 
   int mLineNum = 0;
+
+  // Local dictionary files are mapped read-only and read in place; the
+  // file-backed pages are shared by the OS between all processes mapping
+  // the same dictionary. mStream is only used when the dictionary can't be
+  // mapped, e.g. when it lives in a jar archive.
+  mozilla::loader::AutoMemMap mMap;
+  uint32_t mMapOffset = 0;
+  bool mMapAtEof = false;
+
   nsCOMPtr<nsIInputStream> mStream;
   nsLineBuffer<char> mLineBuffer;
 };
@@ -215,6 +215,60 @@ mozInlineSpellStatus::CreateForEditorChange(
   return status;
 }
 
+// mozInlineSpellStatus::CoalesceEditorChange
+//
+//    Folds a later editor change into this status so that a burst of
+//    keystrokes is spellchecked by the single resume event that is already
+//    on the queue. The range to check grows to the union of the two ranges,
+//    and the anchor moves to the new caret position so the word being typed
+//    keeps being skipped (the no-check range is only computed from the
+//    anchor when the resume finally runs).
+
+bool mozInlineSpellStatus::CoalesceEditorChange(
+    const mozInlineSpellStatus& aNextStatus) {
+  MOZ_ASSERT(aNextStatus.mSpellChecker == mSpellChecker);
+
+  if (!IsCoalesceableEditorChange() ||
+      !aNextStatus.IsCoalesceableEditorChange()) {
+    return false;
+  }
+  if (!mRange->IsPositioned() || !aNextStatus.mRange->IsPositioned()) {
+    return false;
+  }
+
+  // Growing the range is done with ComparePoint so that this fails cleanly
+  // (and we simply don't coalesce) if the new range is in a different
+  // document. Note that failing after the start has already been moved is
+  // harmless: the caller schedules aNextStatus normally and this status just
+  // checks a bit more text than strictly necessary.
+  IgnoredErrorResult ignoredError;
+  int16_t cmpResult =
+      mRange->ComparePoint(*aNextStatus.mRange->GetStartContainer(),
+                           aNextStatus.mRange->StartOffset(), ignoredError);
+  if (ignoredError.Failed()) {
+    return false;
+  }
+  if (cmpResult < 0 &&  // new range starts before
+      NS_FAILED(mRange->SetStart(aNextStatus.mRange->GetStartContainer(),
+                                 aNextStatus.mRange->StartOffset()))) {
+    return false;
+  }
+  cmpResult =
+      mRange->ComparePoint(*aNextStatus.mRange->GetEndContainer(),
+                           aNextStatus.mRange->EndOffset(), ignoredError);
+  if (ignoredError.Failed()) {
+    return false;
+  }
+  if (cmpResult > 0 &&  // new range ends after
+      NS_FAILED(mRange->SetEnd(aNextStatus.mRange->GetEndContainer(),
+                               aNextStatus.mRange->EndOffset()))) {
+    return false;
+  }
+
+  mAnchorRange = aNextStatus.mAnchorRange;
+  return true;
+}
+
 // mozInlineSpellStatus::CreateForNavigation
 //
 //    For navigation events, we just need to store the new and old positions.
@@ -564,6 +618,7 @@ mozInlineSpellChecker::mozInlineSpellChecker()
       mNumPendingSpellChecks(0),
       mNumPendingUpdateCurrentDictionary(0),
       mDisabledAsyncToken(0),
+      mPendingEditorChangeStatus(nullptr),
       mNeedsCheckAfterNavigation(false),
       mFullSpellCheckScheduled(false),
       mIsListeningToEditSubActions(false) {
@@ -640,6 +695,10 @@ mozInlineSpellChecker::Cleanup(bool aDestroyingFrames) {
   // scheduled spell checks are discarded when they finish.
   mDisabledAsyncToken++;
 
+  // Scheduled resumes will now be discarded without calling ResumeCheck, so
+  // drop our reference to any status still owned by one of them.
+  mPendingEditorChangeStatus = nullptr;
+
   if (mNumPendingUpdateCurrentDictionary > 0) {
     // Account for pending UpdateCurrentDictionary calls.
     ChangeNumPendingSpellChecks(-mNumPendingUpdateCurrentDictionary,
@@ -1186,9 +1245,21 @@ nsresult mozInlineSpellChecker::ScheduleSpellCheck(
     // Just ignore this; we're going to spell-check everything anyway
     return NS_OK;
   }
-  // Cache the value because we are going to move aStatus's ownership to
+
+  // If the resume for the previous editor change hasn't run yet, fold this
+  // change into it instead of queueing another resume event. During
+  // sustained typing this batches a whole burst of keystrokes into a single
+  // check over the combined dirty range.
+  if (mPendingEditorChangeStatus &&
+      mPendingEditorChangeStatus->CoalesceEditorChange(*aStatus)) {
+    return NS_OK;
+  }
+
+  // Cache the values because we are going to move aStatus's ownership to
   // the new created mozInlineSpellResume instance.
   bool isFullSpellCheck = aStatus->IsFullSpellCheck();
+  mozInlineSpellStatus* coalesceableStatus =
+      aStatus->IsCoalesceableEditorChange() ? aStatus.get() : nullptr;
 
   RefPtr<mozInlineSpellResume> resume =
       new mozInlineSpellResume(std::move(aStatus), mDisabledAsyncToken);
@@ -1201,6 +1272,11 @@ nsresult mozInlineSpellChecker::ScheduleSpellCheck(
       // until that happens.
       mFullSpellCheckScheduled = true;
     }
+    if (coalesceableStatus) {
+      // Remember the queued status so that later editor changes can be
+      // folded into it. The resume owns it; ResumeCheck clears this.
+      mPendingEditorChangeStatus = coalesceableStatus;
+    }
     ChangeNumPendingSpellChecks(1);
   }
   return rv;
@@ -1639,6 +1715,11 @@ nsresult mozInlineSpellChecker::ResumeCheck(
   // whether the spell check actually happens, use this RAII object.
   AutoChangeNumPendingSpellChecks autoChangeNumPending(this, -1);
 
+  if (aStatus.get() == mPendingEditorChangeStatus) {
+    // No further editor changes can be folded into this check.
+    mPendingEditorChangeStatus = nullptr;
+  }
+
   if (aStatus->IsFullSpellCheck()) {
     // Allow posting new spellcheck resume events from inside
     // ResumeCheck, now that we're actually firing.
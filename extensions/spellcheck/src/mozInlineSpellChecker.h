@@ -57,6 +57,20 @@ class mozInlineSpellStatus {
   // Return true if we plan to spell-check everything
   bool IsFullSpellCheck() const { return mOp == eOpChange && !mRange; }
 
+  // Return true for editor-change statuses which CoalesceEditorChange can
+  // fold into an already scheduled status.
+  bool IsCoalesceableEditorChange() const {
+    return mOp == eOpChange && mRange && mAnchorRange;
+  }
+
+  // Try to fold a later editor change into this (already scheduled) status
+  // so that a burst of keystrokes is handled by the single resume event
+  // which is on the queue already. On success, mRange grows to the union of
+  // both ranges and the anchor moves to the new caret position. Returns
+  // false when the statuses cannot be merged; the caller must then schedule
+  // aNextStatus normally.
+  bool CoalesceEditorChange(const mozInlineSpellStatus& aNextStatus);
+
   const RefPtr<mozInlineSpellChecker> mSpellChecker;
 
   enum Operation {
@@ -113,8 +127,10 @@ class mozInlineSpellStatus {
   // mNoCheckRange). It can be nullptr if we don't care about the cursor
   // position (such as for the intial check of everything).
   //
-  // For mOp == eOpNavigation, this is the NEW position of the cursor
-  const RefPtr<const nsRange> mAnchorRange;
+  // For mOp == eOpNavigation, this is the NEW position of the cursor.
+  // Not const: CoalesceEditorChange moves it when a later editor change is
+  // folded into this status.
+  RefPtr<const nsRange> mAnchorRange;
 
   // -----
   // The following members are only for navigation events and are only
@@ -189,6 +205,14 @@ class mozInlineSpellChecker final : public nsIInlineSpellChecker,
   // it was initialized.
   RefPtr<InitEditorSpellCheckCallback> mPendingInitEditorSpellCheckCallback;
 
+  // The most recently scheduled editor-change status whose resume event
+  // hasn't run yet, used to coalesce the checks for a burst of keystrokes
+  // into one pass over the combined dirty range. Not owning: the queued
+  // mozInlineSpellResume owns the status. Cleared when the resume runs
+  // (ResumeCheck) and when the spell checker is disabled (stale resumes
+  // then delete their status without calling us back).
+  mozInlineSpellStatus* mPendingEditorChangeStatus;
+
   // Set when we have spellchecked after the last edit operation. See the
   // commment at the top of the .cpp file for more info.
   bool mNeedsCheckAfterNavigation;
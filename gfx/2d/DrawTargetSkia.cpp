@@ -855,20 +855,38 @@ void DrawTargetSkia::FillRect(const Rect& aRect, const Pattern& aPattern,
 void DrawTargetSkia::Stroke(const Path* aPath, const Pattern& aPattern,
                             const StrokeOptions& aStrokeOptions,
                             const DrawOptions& aOptions) {
-  MarkChanged();
   MOZ_ASSERT(aPath, "Null path");
   if (aPath->GetBackendType() != BackendType::SKIA) {
     return;
   }
 
   const PathSkia* skiaPath = static_cast<const PathSkia*>(aPath);
-
-  AutoPaintSetup paint(mCanvas, aOptions, aPattern);
-  if (!StrokeOptionsToPaint(paint.mPaint, aStrokeOptions)) {
+  if (!skiaPath->GetPath().isFinite()) {
     return;
   }
 
-  if (!skiaPath->GetPath().isFinite()) {
+  // Skia rejects draws that fall entirely outside the clip on its own, but
+  // only after we've paid for MarkChanged (which may have to copy a
+  // snapshot), shader creation and possibly a saveLayer. Path-heavy canvas
+  // workloads tend to draw a lot of geometry outside the view, so reject up
+  // front. This is only valid for operators bound by their mask; unbounded
+  // operators affect pixels outside the stroked shape.
+  if (IsOperatorBoundByMask(aOptions.mCompositionOp)) {
+    // Approximate the stroke extents, since Path::GetStrokeExtents can be
+    // slow. Inflate by an extra pixel to cover antialiasing fuzz.
+    Rect deviceRect = skiaPath->GetBounds(mTransform);
+    deviceRect.Inflate(MaxStrokeExtents(aStrokeOptions, mTransform));
+    deviceRect.Inflate(1);
+    SkIRect clipBounds;
+    if (!mCanvas->getDeviceClipBounds(&clipBounds) ||
+        !deviceRect.Intersects(IntRectToRect(SkIRectToIntRect(clipBounds)))) {
+      return;
+    }
+  }
+
+  MarkChanged();
+  AutoPaintSetup paint(mCanvas, aOptions, aPattern);
+  if (!StrokeOptionsToPaint(paint.mPaint, aStrokeOptions)) {
     return;
   }
 
@@ -982,19 +1000,24 @@ void DrawTargetSkia::StrokeLine(const Point& aStart, const Point& aEnd,
 
 void DrawTargetSkia::Fill(const Path* aPath, const Pattern& aPattern,
                           const DrawOptions& aOptions) {
-  MarkChanged();
   if (!aPath || aPath->GetBackendType() != BackendType::SKIA) {
     return;
   }
 
   const PathSkia* skiaPath = static_cast<const PathSkia*>(aPath);
-
-  AutoPaintSetup paint(mCanvas, aOptions, aPattern);
-
   if (!skiaPath->GetPath().isFinite()) {
     return;
   }
 
+  // See the early-reject comment in Stroke above.
+  if (IsOperatorBoundByMask(aOptions.mCompositionOp) &&
+      mCanvas->quickReject(skiaPath->GetPath().getBounds())) {
+    return;
+  }
+
+  MarkChanged();
+  AutoPaintSetup paint(mCanvas, aOptions, aPattern);
+
   mCanvas->drawPath(skiaPath->GetPath(), paint.mPaint);
 }
 
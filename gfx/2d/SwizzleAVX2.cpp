@@ -11,9 +11,325 @@
 
 namespace mozilla::gfx {
 
+template <bool aSwapRB, bool aOpaqueAlpha>
+void PremultiplyRow_SSE2(const uint8_t* aSrc, uint8_t* aDst, int32_t aLength);
+
+template <bool aSwapRB>
+void UnpremultiplyRow_SSE2(const uint8_t* aSrc, uint8_t* aDst,
+                           int32_t aLength);
+
+template <bool aSwapRB, bool aOpaqueAlpha>
+void SwizzleRow_SSE2(const uint8_t* aSrc, uint8_t* aDst, int32_t aLength);
+
 template <bool aSwapRB>
 void UnpackRowRGB24_SSSE3(const uint8_t* aSrc, uint8_t* aDst, int32_t aLength);
 
+// Premultiply vector of 8 pixels using splayed math. This is the SSE2
+// algorithm from SwizzleSSE2.cpp widened to process twice as many pixels
+// per iteration.
+template <bool aSwapRB, bool aOpaqueAlpha>
+static MOZ_ALWAYS_INLINE __m256i PremultiplyVector_AVX2(const __m256i& aSrc) {
+  // Isolate R and B with mask.
+  const __m256i mask = _mm256_set1_epi32(0x00FF00FF);
+  __m256i rb = _mm256_and_si256(mask, aSrc);
+  // Swap R and B if necessary.
+  if (aSwapRB) {
+    rb = _mm256_shufflelo_epi16(rb, _MM_SHUFFLE(2, 3, 0, 1));
+    rb = _mm256_shufflehi_epi16(rb, _MM_SHUFFLE(2, 3, 0, 1));
+  }
+  // Isolate G and A by shifting down to bottom of word.
+  __m256i ga = _mm256_srli_epi16(aSrc, 8);
+
+  // Duplicate alphas to get vector of A1 A1 A2 A2 A3 A3 A4 A4 ...
+  __m256i alphas = _mm256_shufflelo_epi16(ga, _MM_SHUFFLE(3, 3, 1, 1));
+  alphas = _mm256_shufflehi_epi16(alphas, _MM_SHUFFLE(3, 3, 1, 1));
+
+  // rb = rb*a + 255; rb += rb >> 8;
+  rb = _mm256_add_epi16(_mm256_mullo_epi16(rb, alphas), mask);
+  rb = _mm256_add_epi16(rb, _mm256_srli_epi16(rb, 8));
+
+  // If format is not opaque, force A to 255 so that A*alpha/255 = alpha
+  if (!aOpaqueAlpha) {
+    ga = _mm256_or_si256(ga, _mm256_set1_epi32(0x00FF0000));
+  }
+  // ga = ga*a + 255; ga += ga >> 8;
+  ga = _mm256_add_epi16(_mm256_mullo_epi16(ga, alphas), mask);
+  ga = _mm256_add_epi16(ga, _mm256_srli_epi16(ga, 8));
+  // If format is opaque, force output A to be 255.
+  if (aOpaqueAlpha) {
+    ga = _mm256_or_si256(ga, _mm256_set1_epi32(0xFF000000));
+  }
+
+  // Combine back to final pixel with (rb >> 8) | (ga & 0xFF00FF00)
+  rb = _mm256_srli_epi16(rb, 8);
+  ga = _mm256_andnot_si256(mask, ga);
+  return _mm256_or_si256(rb, ga);
+}
+
+// Premultiply vector of aAlignedRow + aRemainder pixels.
+template <bool aSwapRB, bool aOpaqueAlpha>
+static MOZ_ALWAYS_INLINE void PremultiplyChunk_AVX2(const uint8_t*& aSrc,
+                                                    uint8_t*& aDst,
+                                                    int32_t aAlignedRow,
+                                                    int32_t aRemainder) {
+  // Process all 8-pixel chunks as one vector.
+  for (const uint8_t* end = aSrc + aAlignedRow; aSrc < end;) {
+    __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(aSrc));
+    px = PremultiplyVector_AVX2<aSwapRB, aOpaqueAlpha>(px);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(aDst), px);
+    aSrc += 8 * 4;
+    aDst += 8 * 4;
+  }
+
+  // Handle any 1-7 remaining pixels with the SSE2 variant.
+  if (aRemainder) {
+    PremultiplyRow_SSE2<aSwapRB, aOpaqueAlpha>(aSrc, aDst, aRemainder);
+  }
+}
+
+// Premultiply vector of aLength pixels.
+template <bool aSwapRB, bool aOpaqueAlpha>
+void PremultiplyRow_AVX2(const uint8_t* aSrc, uint8_t* aDst, int32_t aLength) {
+  int32_t alignedRow = 4 * (aLength & ~7);
+  int32_t remainder = aLength & 7;
+  PremultiplyChunk_AVX2<aSwapRB, aOpaqueAlpha>(aSrc, aDst, alignedRow,
+                                               remainder);
+}
+
+template <bool aSwapRB, bool aOpaqueAlpha>
+void Premultiply_AVX2(const uint8_t* aSrc, int32_t aSrcGap, uint8_t* aDst,
+                      int32_t aDstGap, IntSize aSize) {
+  int32_t alignedRow = 4 * (aSize.width & ~7);
+  int32_t remainder = aSize.width & 7;
+  // Fold remainder into stride gap.
+  aSrcGap += 4 * remainder;
+  aDstGap += 4 * remainder;
+
+  for (int32_t height = aSize.height; height > 0; height--) {
+    PremultiplyChunk_AVX2<aSwapRB, aOpaqueAlpha>(aSrc, aDst, alignedRow,
+                                                 remainder);
+    aSrc += aSrcGap;
+    aDst += aDstGap;
+  }
+}
+
+// Force instantiation of premultiply variants here.
+template void PremultiplyRow_AVX2<false, false>(const uint8_t*, uint8_t*,
+                                                int32_t);
+template void PremultiplyRow_AVX2<false, true>(const uint8_t*, uint8_t*,
+                                               int32_t);
+template void PremultiplyRow_AVX2<true, false>(const uint8_t*, uint8_t*,
+                                               int32_t);
+template void PremultiplyRow_AVX2<true, true>(const uint8_t*, uint8_t*,
+                                              int32_t);
+template void Premultiply_AVX2<false, false>(const uint8_t*, int32_t, uint8_t*,
+                                             int32_t, IntSize);
+template void Premultiply_AVX2<false, true>(const uint8_t*, int32_t, uint8_t*,
+                                            int32_t, IntSize);
+template void Premultiply_AVX2<true, false>(const uint8_t*, int32_t, uint8_t*,
+                                            int32_t, IntSize);
+template void Premultiply_AVX2<true, true>(const uint8_t*, int32_t, uint8_t*,
+                                           int32_t, IntSize);
+
+// This is the same 16-bit reciprocal table as in SwizzleSSE2.cpp, where the
+// reciprocal is shifted down by either 3 or 8 bits depending on whether the
+// alpha value is less than 0x20, and then duplicated into both words of a
+// uint32_t. See SwizzleSSE2.cpp for derivation. Duplicating the reciprocal
+// into both words means a single 32-bit gather per pixel yields the same
+// splayed Q1 Q1 Q2 Q2 ... layout the multiplies below require.
+#define UNPREMULQ_AVX2(x) \
+  (0x10001U * (0xFF0220U / ((x) * ((x) < 0x20 ? 0x100 : 8))))
+#define UNPREMULQ_AVX2_2(x) UNPREMULQ_AVX2(x), UNPREMULQ_AVX2((x) + 1)
+#define UNPREMULQ_AVX2_4(x) UNPREMULQ_AVX2_2(x), UNPREMULQ_AVX2_2((x) + 2)
+#define UNPREMULQ_AVX2_8(x) UNPREMULQ_AVX2_4(x), UNPREMULQ_AVX2_4((x) + 4)
+#define UNPREMULQ_AVX2_16(x) UNPREMULQ_AVX2_8(x), UNPREMULQ_AVX2_8((x) + 8)
+#define UNPREMULQ_AVX2_32(x) UNPREMULQ_AVX2_16(x), UNPREMULQ_AVX2_16((x) + 16)
+static const uint32_t sUnpremultiplyTable_AVX2[256] = {0,
+                                                       UNPREMULQ_AVX2(1),
+                                                       UNPREMULQ_AVX2_2(2),
+                                                       UNPREMULQ_AVX2_4(4),
+                                                       UNPREMULQ_AVX2_8(8),
+                                                       UNPREMULQ_AVX2_16(16),
+                                                       UNPREMULQ_AVX2_32(32),
+                                                       UNPREMULQ_AVX2_32(64),
+                                                       UNPREMULQ_AVX2_32(96),
+                                                       UNPREMULQ_AVX2_32(128),
+                                                       UNPREMULQ_AVX2_32(160),
+                                                       UNPREMULQ_AVX2_32(192),
+                                                       UNPREMULQ_AVX2_32(224)};
+
+// Unpremultiply a vector of 8 pixels using splayed math and a reciprocal
+// table that avoids doing any actual division. Unlike the SSE2 variant,
+// which must extract each alpha and assemble the reciprocals manually, the
+// reciprocals for all 8 pixels can be fetched with a single gather.
+template <bool aSwapRB>
+static MOZ_ALWAYS_INLINE __m256i UnpremultiplyVector_AVX2(const __m256i& aSrc) {
+  // Isolate R and B with mask.
+  __m256i rb = _mm256_and_si256(aSrc, _mm256_set1_epi32(0x00FF00FF));
+  // Swap R and B if necessary.
+  if (aSwapRB) {
+    rb = _mm256_shufflelo_epi16(rb, _MM_SHUFFLE(2, 3, 0, 1));
+    rb = _mm256_shufflehi_epi16(rb, _MM_SHUFFLE(2, 3, 0, 1));
+  }
+
+  // Isolate G and A by shifting down to bottom of word.
+  __m256i ga = _mm256_srli_epi16(aSrc, 8);
+
+  // Gather the reciprocals from the table for each alpha. Each table entry
+  // duplicates the 16-bit reciprocal into both words of the uint32_t, so
+  // this directly produces a vector of duplicated reciprocals of the form
+  // Q1 Q1 Q2 Q2 ... Q8 Q8.
+  __m256i q = _mm256_i32gather_epi32(
+      reinterpret_cast<const int*>(sUnpremultiplyTable_AVX2),
+      _mm256_srli_epi32(aSrc, 24), 4);
+
+  // Check if the alphas are less than 0x20, so that we can undo
+  // scaling of the reciprocals as appropriate.
+  __m256i scale = _mm256_cmpgt_epi32(_mm256_set1_epi32(0x00200000), ga);
+  // Produce scale factors by ((a < 0x20) ^ 8) & 0x108,
+  // such that scale is 0x100 if < 0x20, and 8 otherwise.
+  scale = _mm256_xor_si256(scale, _mm256_set1_epi16(8));
+  scale = _mm256_and_si256(scale, _mm256_set1_epi16(0x108));
+  // Isolate G now so that we don't accidentally unpremultiply A.
+  ga = _mm256_and_si256(ga, _mm256_set1_epi32(0x000000FF));
+
+  // Scale R, B, and G as required depending on reciprocal precision.
+  rb = _mm256_mullo_epi16(rb, scale);
+  ga = _mm256_mullo_epi16(ga, scale);
+
+  // Multiply R, B, and G by the reciprocal, only taking the high word
+  // too effectively shift right by 16.
+  rb = _mm256_mulhi_epu16(rb, q);
+  ga = _mm256_mulhi_epu16(ga, q);
+
+  // Combine back to final pixel with rb | (ga << 8) | (aSrc & 0xFF000000),
+  // which will add back on the original alpha value unchanged.
+  ga = _mm256_slli_si256(ga, 1);
+  ga = _mm256_or_si256(ga,
+                       _mm256_and_si256(aSrc, _mm256_set1_epi32(0xFF000000)));
+  return _mm256_or_si256(rb, ga);
+}
+
+template <bool aSwapRB>
+static MOZ_ALWAYS_INLINE void UnpremultiplyChunk_AVX2(const uint8_t*& aSrc,
+                                                      uint8_t*& aDst,
+                                                      int32_t aAlignedRow,
+                                                      int32_t aRemainder) {
+  // Process all 8-pixel chunks as one vector.
+  for (const uint8_t* end = aSrc + aAlignedRow; aSrc < end;) {
+    __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(aSrc));
+    px = UnpremultiplyVector_AVX2<aSwapRB>(px);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(aDst), px);
+    aSrc += 8 * 4;
+    aDst += 8 * 4;
+  }
+
+  // Handle any 1-7 remaining pixels with the SSE2 variant.
+  if (aRemainder) {
+    UnpremultiplyRow_SSE2<aSwapRB>(aSrc, aDst, aRemainder);
+  }
+}
+
+template <bool aSwapRB>
+void UnpremultiplyRow_AVX2(const uint8_t* aSrc, uint8_t* aDst,
+                           int32_t aLength) {
+  int32_t alignedRow = 4 * (aLength & ~7);
+  int32_t remainder = aLength & 7;
+  UnpremultiplyChunk_AVX2<aSwapRB>(aSrc, aDst, alignedRow, remainder);
+}
+
+template <bool aSwapRB>
+void Unpremultiply_AVX2(const uint8_t* aSrc, int32_t aSrcGap, uint8_t* aDst,
+                        int32_t aDstGap, IntSize aSize) {
+  int32_t alignedRow = 4 * (aSize.width & ~7);
+  int32_t remainder = aSize.width & 7;
+  // Fold remainder into stride gap.
+  aSrcGap += 4 * remainder;
+  aDstGap += 4 * remainder;
+
+  for (int32_t height = aSize.height; height > 0; height--) {
+    UnpremultiplyChunk_AVX2<aSwapRB>(aSrc, aDst, alignedRow, remainder);
+    aSrc += aSrcGap;
+    aDst += aDstGap;
+  }
+}
+
+// Force instantiation of unpremultiply variants here.
+template void UnpremultiplyRow_AVX2<false>(const uint8_t*, uint8_t*, int32_t);
+template void UnpremultiplyRow_AVX2<true>(const uint8_t*, uint8_t*, int32_t);
+template void Unpremultiply_AVX2<false>(const uint8_t*, int32_t, uint8_t*,
+                                        int32_t, IntSize);
+template void Unpremultiply_AVX2<true>(const uint8_t*, int32_t, uint8_t*,
+                                       int32_t, IntSize);
+
+// Swizzle a vector of 8 pixels providing swaps and opaquifying. With AVX2
+// the R and B swap can be done with a single byte shuffle within each lane
+// rather than the word shuffles the SSE2 variant requires.
+template <bool aSwapRB, bool aOpaqueAlpha>
+static MOZ_ALWAYS_INLINE __m256i SwizzleVector_AVX2(const __m256i& aSrc) {
+  // Swap R and B within each pixel, leaving G and A in place.
+  const __m256i swapMask =
+      _mm256_set_epi8(15, 12, 13, 14, 11, 8, 9, 10, 7, 4, 5, 6, 3, 0, 1, 2, 15,
+                      12, 13, 14, 11, 8, 9, 10, 7, 4, 5, 6, 3, 0, 1, 2);
+  __m256i px = _mm256_shuffle_epi8(aSrc, swapMask);
+  // Force alpha to 255 if necessary.
+  if (aOpaqueAlpha) {
+    px = _mm256_or_si256(px, _mm256_set1_epi32(0xFF000000));
+  }
+  return px;
+}
+
+template <bool aSwapRB, bool aOpaqueAlpha>
+static MOZ_ALWAYS_INLINE void SwizzleChunk_AVX2(const uint8_t*& aSrc,
+                                                uint8_t*& aDst,
+                                                int32_t aAlignedRow,
+                                                int32_t aRemainder) {
+  // Process all 8-pixel chunks as one vector.
+  for (const uint8_t* end = aSrc + aAlignedRow; aSrc < end;) {
+    __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(aSrc));
+    px = SwizzleVector_AVX2<aSwapRB, aOpaqueAlpha>(px);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(aDst), px);
+    aSrc += 8 * 4;
+    aDst += 8 * 4;
+  }
+
+  // Handle any 1-7 remaining pixels with the SSE2 variant.
+  if (aRemainder) {
+    SwizzleRow_SSE2<aSwapRB, aOpaqueAlpha>(aSrc, aDst, aRemainder);
+  }
+}
+
+template <bool aSwapRB, bool aOpaqueAlpha>
+void SwizzleRow_AVX2(const uint8_t* aSrc, uint8_t* aDst, int32_t aLength) {
+  int32_t alignedRow = 4 * (aLength & ~7);
+  int32_t remainder = aLength & 7;
+  SwizzleChunk_AVX2<aSwapRB, aOpaqueAlpha>(aSrc, aDst, alignedRow, remainder);
+}
+
+template <bool aSwapRB, bool aOpaqueAlpha>
+void Swizzle_AVX2(const uint8_t* aSrc, int32_t aSrcGap, uint8_t* aDst,
+                  int32_t aDstGap, IntSize aSize) {
+  int32_t alignedRow = 4 * (aSize.width & ~7);
+  int32_t remainder = aSize.width & 7;
+  // Fold remainder into stride gap.
+  aSrcGap += 4 * remainder;
+  aDstGap += 4 * remainder;
+
+  for (int32_t height = aSize.height; height > 0; height--) {
+    SwizzleChunk_AVX2<aSwapRB, aOpaqueAlpha>(aSrc, aDst, alignedRow, remainder);
+    aSrc += aSrcGap;
+    aDst += aDstGap;
+  }
+}
+
+// Force instantiation of swizzle variants here.
+template void SwizzleRow_AVX2<true, false>(const uint8_t*, uint8_t*, int32_t);
+template void SwizzleRow_AVX2<true, true>(const uint8_t*, uint8_t*, int32_t);
+template void Swizzle_AVX2<true, false>(const uint8_t*, int32_t, uint8_t*,
+                                        int32_t, IntSize);
+template void Swizzle_AVX2<true, true>(const uint8_t*, int32_t, uint8_t*,
+                                       int32_t, IntSize);
+
 template <bool aSwapRB>
 void UnpackRowRGB24_AVX2(const uint8_t* aSrc, uint8_t* aDst, int32_t aLength) {
   // Because this implementation will read an additional 8 bytes of data that
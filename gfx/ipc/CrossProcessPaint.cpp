@@ -123,6 +123,16 @@ PaintFragment PaintFragment::Record(dom::BrowsingContext* aBc,
     renderDocFlags = (RenderDocumentFlags::IgnoreViewportScrolling |
                       RenderDocumentFlags::ResetViewportScrolling |
                       RenderDocumentFlags::DocumentRelative);
+  } else {
+    // A viewport capture wants what the user currently sees, so let
+    // RenderDocument serve it from the widget's retained layer tree where the
+    // layer manager supports snapshots, rather than re-rasterizing the
+    // document. RenderDocument falls back to a regular paint when it can't
+    // (e.g. for remote content whose compositing happens outside the content
+    // process). Drawing the caret is required for the retained layers to stay
+    // usable; see the checks in PresShell::RenderDocument.
+    renderDocFlags =
+        (RenderDocumentFlags::UseWidgetLayers | RenderDocumentFlags::DrawCaret);
   }
 
   // Perform the actual rendering
@@ -459,11 +459,10 @@ void ImageContainer::EnsureRecycleAllocatorForRDD(
     return;
   }
 
-  static const uint32_t MAX_POOLED_VIDEO_COUNT = 5;
-
   mRecycleAllocator =
       new layers::TextureClientRecycleAllocator(aKnowsCompositor);
-  mRecycleAllocator->SetMaxPoolSize(MAX_POOLED_VIDEO_COUNT);
+  mRecycleAllocator->SetMaxPoolSize(
+      StaticPrefs::layers_recycle_allocator_rdd_max_pooled_frames());
 }
 
 #ifdef XP_WIN
@@ -11,6 +11,7 @@
 #include "mozilla/gfx/Point.h"        // for Point
 #include "mozilla/gfx/Types.h"  // for CompositionOp, CompositionOp::OP_OVER, CompositionOp::OP_SOURCE
 #include "mozilla/layers/LayerManager.h"  // for LayerManager, LayerManager::DrawPaintedLayerCallback
+#include "mozilla/StaticPrefs_layers.h"  // for layers_basic_occlusion_culling_enabled
 #include "nsDebug.h"      // for NS_ASSERTION
 #include "nsISupports.h"  // for MOZ_COUNTED_DTOR_VIRTUAL, MOZ_COUNT_CTOR
 
@@ -92,9 +93,13 @@ class BasicImplData {
   /**
    * This variable is set by MarkLayersHidden() before painting. It indicates
    * that the layer should not be composited during this transaction.
+   * It is only honored when occlusion culling is enabled; otherwise every
+   * layer is treated as visible.
    */
   void SetHidden(bool aCovered) { mHidden = aCovered; }
-  bool IsHidden() const { return false; }
+  bool IsHidden() const {
+    return StaticPrefs::layers_basic_occlusion_culling_enabled() && mHidden;
+  }
   /**
    * This variable is set by MarkLayersHidden() before painting. This is
    * the operator to be used when compositing the layer in this transaction. It
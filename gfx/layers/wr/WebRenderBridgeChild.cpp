@@ -58,11 +58,12 @@ void WebRenderBridgeChild::Destroy(bool aIsSync) {
 void WebRenderBridgeChild::ActorDestroy(ActorDestroyReason why) { DoDestroy(); }
 
 void WebRenderBridgeChild::DoDestroy() {
-  if (RefCountedShm::IsValid(mResourceShm) &&
-      RefCountedShm::Release(mResourceShm) == 0) {
-    RefCountedShm::Dealloc(this, mResourceShm);
-    mResourceShm = RefCountedShmem();
+  for (auto& shm : mResourceShms) {
+    if (RefCountedShm::IsValid(shm) && RefCountedShm::Release(shm) == 0) {
+      RefCountedShm::Dealloc(this, shm);
+    }
   }
+  mResourceShms.Clear();
 
   // mDestroyed is used to prevent calling Send__delete__() twice.
   // When this function is called from CompositorBridgeChild::Destroy().
@@ -526,6 +527,19 @@ mozilla::ipc::IPCResult WebRenderBridgeChild::RecvWrReleasedImages(
 void WebRenderBridgeChild::BeginClearCachedResources() {
   mSentDisplayList = false;
   mIsInClearCachedResources = true;
+
+  // Drop cached resource shmems which aren't in flight; if the bridge gets
+  // used again they are reallocated on demand.
+  mResourceShms.RemoveElementsBy([&](RefCountedShmem& aShm) {
+    if (!RefCountedShm::IsValid(aShm) ||
+        RefCountedShm::GetReferenceCount(aShm) > 1) {
+      return false;
+    }
+    if (RefCountedShm::Release(aShm) == 0) {
+      RefCountedShm::Dealloc(this, aShm);
+    }
+    return true;
+  });
   // Clear display list and animtaions at parent side before clearing cached
   // resources on client side. It prevents to clear resources before clearing
   // display list at parent side.
@@ -573,30 +587,30 @@ RefPtr<KnowsCompositor> WebRenderBridgeChild::GetForMedia() {
 
 bool WebRenderBridgeChild::AllocResourceShmem(size_t aSize,
                                               RefCountedShmem& aShm) {
-  // We keep a single shmem around to reuse later if it is reference count has
-  // dropped back to 1 (the reference held by the WebRenderBridgeChild).
-
-  // If the cached shmem exists, has the correct size and isn't held by anything
-  // other than us, recycle it.
-  bool alreadyAllocated = RefCountedShm::IsValid(mResourceShm);
-  if (alreadyAllocated) {
-    if (RefCountedShm::GetSize(mResourceShm) == aSize &&
-        RefCountedShm::GetReferenceCount(mResourceShm) <= 1) {
-      MOZ_ASSERT(RefCountedShm::GetReferenceCount(mResourceShm) == 1);
-      aShm = mResourceShm;
+  // We keep shmems around to reuse later once their reference count has
+  // dropped back to 1 (the reference held by the WebRenderBridgeChild). A
+  // display list transaction can write several chunks, so caching a single
+  // segment would still map fresh segments for the rest of the chunks.
+
+  // Recycle a cached shmem if one has the correct size and isn't held by
+  // anything other than us.
+  for (auto& shm : mResourceShms) {
+    if (RefCountedShm::GetSize(shm) == aSize &&
+        RefCountedShm::GetReferenceCount(shm) <= 1) {
+      MOZ_ASSERT(RefCountedShm::GetReferenceCount(shm) == 1);
+      aShm = shm;
       return true;
     }
   }
 
-  // If there was no cached shmem or we couldn't recycle it, alloc a new one.
+  // If there was no cached shmem we could recycle, alloc a new one.
   if (!RefCountedShm::Alloc(this, aSize, aShm)) {
     return false;
   }
 
-  // Now that we have a valid shmem, put it in the cache if we don't have one
-  // yet.
-  if (!alreadyAllocated) {
-    mResourceShm = aShm;
+  // Now that we have a valid shmem, put it in the cache if there is room.
+  if (mResourceShms.Length() < kMaxCachedResourceShmems) {
+    mResourceShms.AppendElement(aShm);
     RefCountedShm::AddRef(aShm);
   }
 
@@ -262,7 +262,10 @@ class WebRenderBridgeChild final : public PWebRenderBridgeChild,
 
   UniquePtr<ActiveResourceTracker> mActiveResourceTracker;
 
-  RefCountedShmem mResourceShm;
+  // Cache of resource shmems kept around for reuse, so steady-state display
+  // list updates don't allocate and map fresh segments every transaction.
+  static const size_t kMaxCachedResourceShmems = 8;
+  AutoTArray<RefCountedShmem, kMaxCachedResourceShmems> mResourceShms;
 };
 
 }  // namespace layers
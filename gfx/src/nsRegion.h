@@ -622,6 +622,124 @@ class nsRegion {
     }
   }
 
+  // Append aBand to aOut, merging it into the band above when they touch and
+  // have identical strips, so the output stays canonical.
+  static void AppendOrExtendBand(BandArray& aOut, Band&& aBand) {
+    if (aOut.Length() && aOut.LastElement().bottom == aBand.top &&
+        aOut.LastElement().EqualStrips(aBand)) {
+      aOut.LastElement().bottom = aBand.bottom;
+      return;
+    }
+    aOut.AppendElement(std::move(aBand));
+  }
+
+  void Or(BandArray& aOut, const BandArray& aIn1, const BandArray& aIn2) {
+    // This algorithm builds a new list of bands by iterating over both
+    // regions' lists of bands simultaneously, emitting the segments where
+    // only one region has a band unchanged and merging the strips where the
+    // bands overlap vertically. Each input band may be emitted in several
+    // segments when it only partially overlaps bands of the other region, so
+    // we track the top of the unprocessed part of both current bands.
+    size_t idx1 = 0;
+    size_t idx2 = 0;
+    int32_t top1 = aIn1.Length() ? aIn1[0].top : 0;
+    int32_t top2 = aIn2.Length() ? aIn2[0].top : 0;
+
+    while (idx1 != aIn1.Length() && idx2 != aIn2.Length()) {
+      const Band& band1 = aIn1[idx1];
+      const Band& band2 = aIn2[idx2];
+
+      if (band1.bottom <= top2) {
+        // The rest of band1 lies wholly above band2, emit it unchanged.
+        Band newBand(band1);
+        newBand.top = top1;
+        AppendOrExtendBand(aOut, std::move(newBand));
+        idx1++;
+        if (idx1 != aIn1.Length()) {
+          top1 = aIn1[idx1].top;
+        }
+        continue;
+      }
+
+      if (band2.bottom <= top1) {
+        // The rest of band2 lies wholly above band1, emit it unchanged.
+        Band newBand(band2);
+        newBand.top = top2;
+        AppendOrExtendBand(aOut, std::move(newBand));
+        idx2++;
+        if (idx2 != aIn2.Length()) {
+          top2 = aIn2[idx2].top;
+        }
+        continue;
+      }
+
+      if (top1 < top2) {
+        // The part of band1 above band2 doesn't overlap, emit it unchanged.
+        Band newBand(band1);
+        newBand.top = top1;
+        newBand.bottom = top2;
+        AppendOrExtendBand(aOut, std::move(newBand));
+        top1 = top2;
+        continue;
+      }
+
+      if (top2 < top1) {
+        // The part of band2 above band1 doesn't overlap, emit it unchanged.
+        Band newBand(band2);
+        newBand.top = top2;
+        newBand.bottom = top1;
+        AppendOrExtendBand(aOut, std::move(newBand));
+        top2 = top1;
+        continue;
+      }
+
+      // The bands overlap starting at top1 == top2, until the nearer of the
+      // two bottoms. Emit the union of their strips for that segment.
+      Band newBand(band1);
+      newBand.top = top1;
+      newBand.bottom = std::min(band1.bottom, band2.bottom);
+      for (const Strip& strip : band2.mStrips) {
+        newBand.InsertStrip(strip);
+      }
+      int32_t bottom = newBand.bottom;
+      AppendOrExtendBand(aOut, std::move(newBand));
+
+      top1 = top2 = bottom;
+      if (band1.bottom == bottom) {
+        idx1++;
+        if (idx1 != aIn1.Length()) {
+          top1 = aIn1[idx1].top;
+        }
+      }
+      if (band2.bottom == bottom) {
+        idx2++;
+        if (idx2 != aIn2.Length()) {
+          top2 = aIn2[idx2].top;
+        }
+      }
+    }
+
+    // Emit whatever remains of the region that still has bands.
+    while (idx1 != aIn1.Length()) {
+      Band newBand(aIn1[idx1]);
+      newBand.top = top1;
+      AppendOrExtendBand(aOut, std::move(newBand));
+      idx1++;
+      if (idx1 != aIn1.Length()) {
+        top1 = aIn1[idx1].top;
+      }
+    }
+    while (idx2 != aIn2.Length()) {
+      Band newBand(aIn2[idx2]);
+      newBand.top = top2;
+      AppendOrExtendBand(aOut, std::move(newBand));
+      idx2++;
+      if (idx2 != aIn2.Length()) {
+        top2 = aIn2[idx2].top;
+      }
+    }
+  }
+
  public:
   nsRegion& AndWith(const nsRegion& aRegion) {
 #ifdef DEBUG_REGIONS
@@ -943,23 +1061,115 @@ class nsRegion {
   }
 
   nsRegion& OrWith(const nsRegion& aOther) {
-    for (RectIterator idx(aOther); !idx.Done(); idx.Next()) {
-      AddRect(idx.GetAbsolute());
+#ifdef DEBUG_REGIONS
+    class OperationStringGeneratorOrWith : public OperationStringGenerator {
+     public:
+      OperationStringGeneratorOrWith(nsRegion& aRegion,
+                                     const nsRegion& aOtherRegion)
+          : mRegion(&aRegion),
+            mRegionCopy(aRegion),
+            mOtherRegion(aOtherRegion) {
+        aRegion.mCurrentOpGenerator = this;
+      }
+      virtual ~OperationStringGeneratorOrWith() {
+        mRegion->mCurrentOpGenerator = nullptr;
+      }
+
+      virtual void OutputOp() override {
+        std::stringstream stream;
+        mRegionCopy.OutputToStream("r1", stream);
+        mOtherRegion.OutputToStream("r2", stream);
+        stream << "r1.OrWith(r2);\n";
+        gfxCriticalError() << stream.str();
+      }
+
+     private:
+      nsRegion* mRegion;
+      nsRegion mRegionCopy;
+      nsRegion mOtherRegion;
+    };
+
+    OperationStringGeneratorOrWith opGenerator(*this, aOther);
+#endif
+    if (aOther.mBounds.IsEmpty()) {
+      return *this;
+    }
+
+    if (mBounds.IsEmpty()) {
+      return Copy(aOther);
+    }
+
+    if (aOther.mBands.IsEmpty()) {
+      // Other region is a rect.
+      AddRect(aOther.mBounds);
+      return *this;
+    }
+
+    if (mBands.IsEmpty()) {
+      mBands.AppendElement(Band(mBounds));
     }
+
+    BandArray newBands;
+
+    Or(newBands, mBands, aOther.mBands);
+
+    mBands = std::move(newBands);
+    mBounds = mBounds.UnsafeUnion(aOther.mBounds);
+
+    EnsureSimplified();
+    AssertState();
     return *this;
   }
   nsRegion& OrWith(const nsRect& aOther) {
     AddRect(nsRectAbsolute::FromRect(aOther));
     return *this;
   }
+
+  // Union of a span of rectangles, e.g. an accumulated list of invalidation
+  // rects. The rectangles are merged pairwise, so the work done is
+  // proportional to the size of the intermediate regions times the logarithm
+  // of the number of rectangles, instead of re-walking the growing band list
+  // for every rectangle in turn.
+  nsRegion& OrWith(mozilla::gfx::ArrayView<nsRect> aRects) {
+    if (aRects.Length() == 1) {
+      return OrWith(aRects[0]);
+    }
+
+    AutoTArray<nsRegion, 32> regions;
+    regions.SetCapacity(aRects.Length());
+    for (uint32_t i = 0; i < aRects.Length(); i++) {
+      if (!aRects[i].IsEmpty()) {
+        regions.AppendElement(nsRegion(aRects[i]));
+      }
+    }
+
+    while (regions.Length() > 1) {
+      size_t merged = 0;
+      for (size_t i = 0; i + 1 < regions.Length(); i += 2) {
+        regions[i].OrWith(regions[i + 1]);
+        if (merged != i) {
+          regions[merged] = std::move(regions[i]);
+        }
+        merged++;
+      }
+      if (regions.Length() % 2) {
+        regions[merged] = std::move(regions.LastElement());
+        merged++;
+      }
+      regions.TruncateLength(merged);
+    }
+
+    if (regions.Length()) {
+      OrWith(regions[0]);
+    }
+    return *this;
+  }
+
   nsRegion& Or(const nsRegion& aRgn1, const nsRegion& aRgn2) {
     if (&aRgn1 != this) {
       *this = aRgn1;
     }
-    for (RectIterator idx(aRgn2); !idx.Done(); idx.Next()) {
-      AddRect(idx.GetAbsolute());
-    }
-    return *this;
+    return OrWith(aRgn2);
   }
   nsRegion& Or(const nsRegion& aRegion, const nsRect& aRect) {
     if (&aRegion != this) {
@@ -2262,6 +2472,16 @@ class BaseIntRegion {
 
   Derived& OrWith(const Derived& aOther) { return Or(This(), aOther); }
   Derived& OrWith(const Rect& aOther) { return Or(This(), aOther); }
+  // Union of a span of rectangles, see nsRegion::OrWith.
+  Derived& OrWith(mozilla::gfx::ArrayView<Rect> aRects) {
+    AutoTArray<nsRect, 32> rects;
+    rects.SetCapacity(aRects.Length());
+    for (uint32_t i = 0; i < aRects.Length(); i++) {
+      rects.AppendElement(ToRect(aRects[i]));
+    }
+    mImpl.OrWith(mozilla::gfx::ArrayView<nsRect>(rects));
+    return This();
+  }
   Derived& Or(const Derived& aRgn1, const Derived& aRgn2) {
     mImpl.Or(aRgn1.mImpl, aRgn2.mImpl);
     return This();
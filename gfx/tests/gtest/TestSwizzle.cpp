@@ -5,7 +5,9 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "gtest/gtest.h"
+#include "gtest/MozGTestBench.h"
 #include "mozilla/ArrayUtils.h"
+#include "mozilla/UniquePtr.h"
 #include "mozilla/gfx/Swizzle.h"
 
 using namespace mozilla;
@@ -78,6 +80,20 @@ TEST(Moz2D, PremultiplyRow)
   func = PremultiplyRow(SurfaceFormat::B8G8R8A8, SurfaceFormat::A8R8G8B8);
   func(in_bgra, out, 5);
   EXPECT_TRUE(ArrayEqual(out, check_argb));
+
+  // Repeat with a wider row, so that the main loops of the wider SIMD
+  // implementations are exercised in addition to the remainder handling
+  // covered by the 5 pixel rows above.
+  uint8_t in_wide[16 * 4];
+  uint8_t out_wide[16 * 4];
+  uint8_t check_wide[16 * 4];
+  for (size_t i = 0; i < 16; i++) {
+    memcpy(&in_wide[i * 4], &in_bgra[(i % 5) * 4], 4);
+    memcpy(&check_wide[i * 4], &check_rgba[(i % 5) * 4], 4);
+  }
+  func = PremultiplyRow(SurfaceFormat::B8G8R8A8, SurfaceFormat::R8G8B8A8);
+  func(in_wide, out_wide, 16);
+  EXPECT_TRUE(ArrayEqual(out_wide, check_wide));
 }
 
 TEST(Moz2D, UnpremultiplyData)
@@ -147,6 +163,20 @@ TEST(Moz2D, UnpremultiplyRow)
   func = UnpremultiplyRow(SurfaceFormat::B8G8R8A8, SurfaceFormat::A8R8G8B8);
   func(in_bgra, out, 5);
   EXPECT_TRUE(ArrayEqual(out, check_argb));
+
+  // Repeat with a wider row, so that the main loops of the wider SIMD
+  // implementations are exercised in addition to the remainder handling
+  // covered by the 5 pixel rows above.
+  uint8_t in_wide[16 * 4];
+  uint8_t out_wide[16 * 4];
+  uint8_t check_wide[16 * 4];
+  for (size_t i = 0; i < 16; i++) {
+    memcpy(&in_wide[i * 4], &in_bgra[(i % 5) * 4], 4);
+    memcpy(&check_wide[i * 4], &check_rgba[(i % 5) * 4], 4);
+  }
+  func = UnpremultiplyRow(SurfaceFormat::B8G8R8A8, SurfaceFormat::R8G8B8A8);
+  func(in_wide, out_wide, 16);
+  EXPECT_TRUE(ArrayEqual(out_wide, check_wide));
 }
 
 TEST(Moz2D, SwizzleData)
@@ -322,4 +352,63 @@ TEST(Moz2D, SwizzleRow)
   memcpy(out_unpack, in_rgb, sizeof(in_rgb));
   func(out_unpack, out_unpack, 16);
   EXPECT_TRUE(ArrayEqual(out_unpack, check_unpack_xrgb));
+
+  // Repeat the swap with a wider row, so that the main loops of the wider
+  // SIMD implementations are exercised in addition to the remainder handling
+  // covered by the 5 pixel rows above.
+  uint8_t in_wide[16 * 4];
+  uint8_t out_wide[16 * 4];
+  uint8_t check_wide[16 * 4];
+  for (size_t i = 0; i < 16; i++) {
+    memcpy(&in_wide[i * 4], &in_bgra[(i % 5) * 4], 4);
+    memcpy(&check_wide[i * 4], &check_rgba[(i % 5) * 4], 4);
+  }
+  func = SwizzleRow(SurfaceFormat::B8G8R8A8, SurfaceFormat::R8G8B8A8);
+  func(in_wide, out_wide, 16);
+  EXPECT_TRUE(ArrayEqual(out_wide, check_wide));
 }
+
+class GfxSwizzlePerf : public ::testing::Test {
+ protected:
+  // Process enough pixels per iteration that the dispatch overhead is
+  // negligible compared to the row conversion itself.
+  static constexpr int32_t kPixels = 1024 * 1024;
+
+  void SetUp() override {
+    mIn = MakeUnique<uint8_t[]>(kPixels * 4);
+    mOut = MakeUnique<uint8_t[]>(kPixels * 4);
+    // Fill the input with varied color and alpha values so that data-dependent
+    // paths (e.g. the unpremultiply reciprocal table) are representatively
+    // exercised.
+    for (int32_t i = 0; i < kPixels * 4; i++) {
+      mIn[i] = uint8_t(i * 31);
+    }
+  }
+
+  void RunRow(SwizzleRowFn aFn) { aFn(mIn.get(), mOut.get(), kPixels); }
+
+  UniquePtr<uint8_t[]> mIn;
+  UniquePtr<uint8_t[]> mOut;
+};
+
+MOZ_GTEST_BENCH_F(GfxSwizzlePerf, PremultiplyRowBGRAToBGRA, [this] {
+  RunRow(PremultiplyRow(SurfaceFormat::B8G8R8A8, SurfaceFormat::B8G8R8A8));
+});
+MOZ_GTEST_BENCH_F(GfxSwizzlePerf, PremultiplyRowBGRAToRGBA, [this] {
+  RunRow(PremultiplyRow(SurfaceFormat::B8G8R8A8, SurfaceFormat::R8G8B8A8));
+});
+MOZ_GTEST_BENCH_F(GfxSwizzlePerf, UnpremultiplyRowBGRAToBGRA, [this] {
+  RunRow(UnpremultiplyRow(SurfaceFormat::B8G8R8A8, SurfaceFormat::B8G8R8A8));
+});
+MOZ_GTEST_BENCH_F(GfxSwizzlePerf, UnpremultiplyRowBGRAToRGBA, [this] {
+  RunRow(UnpremultiplyRow(SurfaceFormat::B8G8R8A8, SurfaceFormat::R8G8B8A8));
+});
+MOZ_GTEST_BENCH_F(GfxSwizzlePerf, SwizzleRowBGRAToRGBA, [this] {
+  RunRow(SwizzleRow(SurfaceFormat::B8G8R8A8, SurfaceFormat::R8G8B8A8));
+});
+MOZ_GTEST_BENCH_F(GfxSwizzlePerf, SwizzleRowBGRXToRGBX, [this] {
+  RunRow(SwizzleRow(SurfaceFormat::B8G8R8X8, SurfaceFormat::R8G8B8X8));
+});
+MOZ_GTEST_BENCH_F(GfxSwizzlePerf, UnpackRowRGBToRGBX, [this] {
+  RunRow(SwizzleRow(SurfaceFormat::R8G8B8, SurfaceFormat::R8G8B8X8));
+});
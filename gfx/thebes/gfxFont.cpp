@@ -138,6 +138,12 @@ gfxFontCache::Observer::Observe(nsISupports* aSubject, const char* aTopic,
     gfxFontCache* fontCache = gfxFontCache::GetCache();
     if (fontCache) {
       fontCache->FlushShapedWordCaches();
+      // Also expire any fonts that are no longer referenced by textruns or
+      // font groups, rather than waiting out their expiration timeout. This
+      // releases their glyph-extents storage as well as the font instances
+      // themselves; fonts that are still in use stay resident and keep their
+      // extents, so hot pages don't pay a re-shaping penalty.
+      fontCache->AgeAllGenerations();
     }
   } else {
     MOZ_ASSERT_UNREACHABLE("unexpected notification topic");
@@ -2760,12 +2766,22 @@ gfxShapedWord* gfxFont::GetShapedWord(
     Script aRunScript, nsAtom* aLanguage, bool aVertical,
     int32_t aAppUnitsPerDevUnit, gfx::ShapedTextFlags aFlags,
     RoundingFlags aRounding, gfxTextPerfMetrics* aTextPerf GFX_MAYBE_UNUSED) {
-  // if the cache is getting too big, flush it and start over
+  // if the cache is getting too big, evict the words that haven't been used
+  // since the last expiration pass; flush wholesale only if the cache is
+  // still full of fresh words, so the hot set survives a burst of new text
   uint32_t wordCacheMaxEntries =
       gfxPlatform::GetPlatform()->WordCacheMaxEntries();
   if (mWordCache->Count() > wordCacheMaxEntries) {
-    NS_WARNING("flushing shaped-word cache");
-    ClearCachedWords();
+    for (auto it = mWordCache->Iter(); !it.Done(); it.Next()) {
+      CacheHashEntry* aged = it.Get();
+      if (!aged->mShapedWord || aged->mShapedWord->GetAge() != 0) {
+        it.Remove();
+      }
+    }
+    if (mWordCache->Count() > wordCacheMaxEntries) {
+      NS_WARNING("flushing shaped-word cache");
+      ClearCachedWords();
+    }
   }
 
   // if there's a cached entry for this word, just return it
@@ -1339,6 +1339,7 @@ class gfxShapedWord final : public gfxShapedText {
 
   void ResetAge() { mAgeCounter = 0; }
   uint32_t IncrementAge() { return ++mAgeCounter; }
+  uint32_t GetAge() const { return mAgeCounter; }
 
   // Helper used when hashing a word for the shaped-word caches
   static uint32_t HashMix(uint32_t aHash, char16_t aCh) {
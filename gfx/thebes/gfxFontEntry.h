@@ -934,6 +934,15 @@ class gfxFontFamily {
     return mFamilyCharacterMap.test(aCh);
   }
 
+  // test whether the family's character map covers any character in the
+  // given range (inclusive)
+  bool TestCharacterRange(uint32_t aStart, uint32_t aEnd) {
+    if (!mFamilyCharacterMapInitialized) {
+      ReadAllCMAPs();
+    }
+    return mFamilyCharacterMap.TestRange(aStart, aEnd);
+  }
+
   void ResetCharacterMap() {
     mFamilyCharacterMap.reset();
     mFamilyCharacterMapInitialized = false;
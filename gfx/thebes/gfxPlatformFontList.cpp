@@ -378,6 +378,9 @@ void gfxPlatformFontList::ApplyWhitelist() {
     ToLowerCase(fontFamilyName);
     mFontFamilies.InsertOrUpdate(fontFamilyName, std::move(f));
   }
+  // The set of families changed, so any existing coverage index is stale.
+  mFallbackBlockIndex.Clear();
+  mFallbackBlockIndexInitialized = false;
 }
 
 void gfxPlatformFontList::ApplyWhitelist(
@@ -508,6 +511,8 @@ bool gfxPlatformFontList::InitFontList() {
 
     CancelInitOtherFamilyNamesTask();
     mFontFamilies.Clear();
+    mFallbackBlockIndex.Clear();
+    mFallbackBlockIndexInitialized = false;
     mOtherFamilyNames.Clear();
     mOtherFamilyNamesInitialized = false;
 
@@ -1078,6 +1083,25 @@ gfxFont* gfxPlatformFontList::CommonFontFallback(
   return nullptr;
 }
 
+void gfxPlatformFontList::EnsureFallbackBlockIndex() {
+  if (mFallbackBlockIndexInitialized) {
+    return;
+  }
+  mFallbackBlockIndexInitialized = true;
+
+  // Building the index loads the character map of every family, which is the
+  // cost the per-character search used to pay piecemeal; once built, each
+  // fallback only probes the families indexed for the character's block.
+  for (const RefPtr<gfxFontFamily>& family : mFontFamilies.Values()) {
+    for (uint32_t block = 0; block <= (gfxFontUtils::CMAP_MAX_CODEPOINT >> 8);
+         block++) {
+      if (family->TestCharacterRange(block << 8, (block << 8) | 0xff)) {
+        mFallbackBlockIndex.LookupOrInsert(block).AppendElement(family);
+      }
+    }
+  }
+}
+
 gfxFont* gfxPlatformFontList::GlobalFontFallback(
     uint32_t aCh, uint32_t aNextCh, Script aRunScript,
     eFontPresentation aPresentation, const gfxFontStyle* aMatchStyle,
@@ -1157,17 +1181,21 @@ gfxFont* gfxPlatformFontList::GlobalFontFallback(
       }
     }
   } else {
-    // iterate over all font families to find a font that support the
-    // character
-    for (const RefPtr<gfxFontFamily>& family : mFontFamilies.Values()) {
-      if (!IsVisibleToCSS(*family)) {
-        continue;
-      }
-      // evaluate all fonts in this family for a match
-      family->FindFontForChar(&data);
-      if (data.mMatchDistance == 0.0) {
-        // no better style match is possible, so stop searching
-        break;
+    // Only families whose character map covers the block containing the
+    // character can possibly support it, so consult the coverage index
+    // rather than iterating over every family.
+    EnsureFallbackBlockIndex();
+    if (auto candidates = mFallbackBlockIndex.Lookup(aCh >> 8)) {
+      for (const RefPtr<gfxFontFamily>& family : candidates.Data()) {
+        if (!IsVisibleToCSS(*family)) {
+          continue;
+        }
+        // evaluate all fonts in this family for a match
+        family->FindFontForChar(&data);
+        if (data.mMatchDistance == 0.0) {
+          // no better style match is possible, so stop searching
+          break;
+        }
       }
     }
 
@@ -2589,6 +2617,12 @@ void gfxPlatformFontList::AddSizeOfExcludingThis(MallocSizeOf aMallocSizeOf,
 
   aSizes->mFontListSize +=
       mCodepointsWithNoFonts.SizeOfExcludingThis(aMallocSizeOf);
+  aSizes->mFontListSize +=
+      mFallbackBlockIndex.ShallowSizeOfExcludingThis(aMallocSizeOf);
+  for (const auto& entry : mFallbackBlockIndex) {
+    aSizes->mFontListSize +=
+        entry.GetData().ShallowSizeOfExcludingThis(aMallocSizeOf);
+  }
   aSizes->mFontListSize +=
       mFontFamiliesToLoad.ShallowSizeOfExcludingThis(aMallocSizeOf);
 
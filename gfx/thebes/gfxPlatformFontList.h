@@ -693,6 +693,11 @@ class gfxPlatformFontList : public gfxFontInfoLoader {
                               uint32_t& aCmapCount, FontFamily& aMatchedFamily,
                               FontMatchingStats* aFontMatchingStats);
 
+  // Ensure mFallbackBlockIndex has been built, loading family character
+  // maps as needed. Only used when doing cmap-based fallback over the
+  // unshared font list.
+  void EnsureFallbackBlockIndex();
+
   // Platform-specific implementation of global font fallback, if any;
   // this may return nullptr in which case the default cmap-based fallback
   // will be performed.
@@ -873,6 +878,15 @@ class gfxPlatformFontList : public gfxFontInfoLoader {
   // on pages with lots of problems
   FontFamily mReplacementCharFallbackFamily;
 
+  // coverage index over the (unshared) font families: for each 256-codepoint
+  // block, the families whose character maps include at least one character
+  // in it. Built lazily on the first global fallback, so that subsequent
+  // fallbacks only probe families that can possibly support the character
+  // instead of walking every family's cmap.
+  nsTHashMap<nsUint32HashKey, nsTArray<RefPtr<gfxFontFamily>>>
+      mFallbackBlockIndex;
+  bool mFallbackBlockIndexInitialized = false;
+
   // Sorted array of lowercased family names; use ContainsSorted to test
   nsTArray<nsCString> mBadUnderlineFamilyNames;
 
@@ -9,7 +9,6 @@
 #include "gfxPlatform.h"
 #include "gfxFontConstants.h"
 #include "mozilla/FontPropertyTypes.h"
-#include "mozilla/Preferences.h"
 #include "mozilla/ProfilerLabels.h"
 #include "mozilla/Services.h"
 #include "mozilla/StaticPrefs_gfx.h"
@@ -1180,7 +1179,7 @@ void gfxUserFontSet::UserFontCache::CacheFont(gfxFontEntry* aFontEntry) {
                "caching a font associated with no family yet");
 
   // if caching is disabled, simply return
-  if (Preferences::GetBool("gfx.downloadable_fonts.disable_cache")) {
+  if (StaticPrefs::gfx_downloadable_fonts_disable_cache()) {
     return;
   }
 
@@ -1254,7 +1253,7 @@ void gfxUserFontSet::UserFontCache::ForgetFont(gfxFontEntry* aFontEntry) {
 gfxFontEntry* gfxUserFontSet::UserFontCache::GetFont(
     const gfxFontFaceSrc& aSrc, const gfxUserFontEntry& aUserFontEntry) {
   if (!sUserFonts || aUserFontEntry.mFontSet->BypassCache() ||
-      Preferences::GetBool("gfx.downloadable_fonts.disable_cache")) {
+      StaticPrefs::gfx_downloadable_fonts_disable_cache()) {
     return nullptr;
   }
 
@@ -0,0 +1,63 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "Hal.h"
+#include "HalLog.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nsPrintfCString.h"
+
+using namespace mozilla::hal;
+
+namespace mozilla {
+namespace hal_impl {
+
+void SetProcessPriority(int aPid, ProcessPriority aPriority) {
+  HAL_LOG("LinuxProcessPriority - SetProcessPriority(%d, %s)\n", aPid,
+          ProcessPriorityToString(aPriority));
+
+  // Background processes run under SCHED_IDLE, whose near-zero scheduler
+  // weight keeps a runaway background tab from competing with the foreground
+  // process for CPU while still letting it make progress on an otherwise
+  // idle machine. Everything else (including BACKGROUND_PERCEIVABLE, which
+  // covers things like tabs playing audio) keeps the default policy. We
+  // deliberately don't use nice values: an unprivileged process may never
+  // lower another's nice value again, while the kernel explicitly allows
+  // moving a thread out of SCHED_IDLE as long as its nice value is
+  // unchanged.
+  int policy =
+      aPriority == PROCESS_PRIORITY_BACKGROUND ? SCHED_IDLE : SCHED_OTHER;
+
+  // Scheduling policy is per-thread, so walk the process's task directory
+  // and apply it to every thread. Threads created afterwards inherit the
+  // policy of the thread that created them.
+  nsPrintfCString taskPath("/proc/%d/task", aPid);
+  DIR* taskDir = opendir(taskPath.get());
+  if (!taskDir) {
+    HAL_LOG("LinuxProcessPriority - could not open %s\n", taskPath.get());
+    return;
+  }
+
+  // sched_priority must be 0 for both SCHED_IDLE and SCHED_OTHER.
+  struct sched_param param = {};
+  while (struct dirent* entry = readdir(taskDir)) {
+    int tid = atoi(entry->d_name);
+    if (tid <= 0) {
+      continue;
+    }
+    if (sched_setscheduler(tid, policy, &param) != 0) {
+      HAL_LOG("LinuxProcessPriority - setting policy for tid %d failed: %s\n",
+              tid, strerror(errno));
+    }
+  }
+  closedir(taskDir);
+}
+
+}  // namespace hal_impl
+}  // namespace mozilla
@@ -25,7 +25,11 @@ AnimationSurfaceProvider::AnimationSurfaceProvider(
       mImage(aImage.get()),
       mDecodingMutex("AnimationSurfaceProvider::mDecoder"),
       mDecoder(aDecoder.get()),
-      mFramesMutex("AnimationSurfaceProvider::mFrames", /* aOrdered */ true) {
+      mFramesMutex("AnimationSurfaceProvider::mFrames", /* aOrdered */ true),
+      mTaskPriority(bool(aDecoder->GetDecoderFlags() &
+                         DecoderFlags::HIGH_PRIORITY)
+                        ? TaskPriority::eHigh
+                        : TaskPriority::eLow) {
   MOZ_ASSERT(!mDecoder->IsMetadataDecode(),
              "Use MetadataDecodingTask for metadata decodes");
   MOZ_ASSERT(!mDecoder->IsFirstFrameDecode(),
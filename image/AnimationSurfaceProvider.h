@@ -76,8 +76,9 @@ class AnimationSurfaceProvider final : public ISurfaceProvider,
   bool ShouldPreferSyncRun() const override;
 
   // Full decodes are low priority compared to metadata decodes because they
-  // don't block layout or page load.
-  TaskPriority Priority() const override { return TaskPriority::eLow; }
+  // don't block layout or page load, unless the decode was requested to
+  // paint content that's in the viewport right now.
+  TaskPriority Priority() const override { return mTaskPriority; }
 
   //////////////////////////////////////////////////////////////////////////////
   // IDecoderFrameRecycler implementation.
@@ -114,6 +115,10 @@ class AnimationSurfaceProvider final : public ISurfaceProvider,
 
   /// The frames of this animation, in order.
   UniquePtr<AnimationFrameBuffer> mFrames;
+
+  /// The priority our decoding task runs at, captured from the decoder's
+  /// flags at creation time.
+  const TaskPriority mTaskPriority;
 };
 
 }  // namespace image
@@ -23,7 +23,11 @@ DecodedSurfaceProvider::DecodedSurfaceProvider(NotNull<RasterImage*> aImage,
                        AvailabilityState::StartAsPlaceholder()),
       mImage(aImage.get()),
       mMutex("mozilla::image::DecodedSurfaceProvider"),
-      mDecoder(aDecoder.get()) {
+      mDecoder(aDecoder.get()),
+      mTaskPriority(bool(aDecoder->GetDecoderFlags() &
+                         DecoderFlags::HIGH_PRIORITY)
+                        ? TaskPriority::eHigh
+                        : TaskPriority::eLow) {
   recordreplay::RegisterThing(this);
   MOZ_ASSERT(!mDecoder->IsMetadataDecode(),
              "Use MetadataDecodingTask for metadata decodes");
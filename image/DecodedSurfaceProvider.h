@@ -52,8 +52,9 @@ class DecodedSurfaceProvider final : public ISurfaceProvider,
   bool ShouldPreferSyncRun() const override;
 
   // Full decodes are low priority compared to metadata decodes because they
-  // don't block layout or page load.
-  TaskPriority Priority() const override { return TaskPriority::eLow; }
+  // don't block layout or page load, unless the decode was requested to
+  // paint content that's in the viewport right now.
+  TaskPriority Priority() const override { return mTaskPriority; }
 
  private:
   virtual ~DecodedSurfaceProvider();
@@ -76,6 +77,10 @@ class DecodedSurfaceProvider final : public ISurfaceProvider,
 
   /// A drawable reference to our service; used for locking.
   DrawableFrameRef mLockRef;
+
+  /// The priority our decoding task runs at, captured from the decoder's
+  /// flags at creation time.
+  const TaskPriority mTaskPriority;
 };
 
 }  // namespace image
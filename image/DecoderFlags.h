@@ -31,6 +31,13 @@ enum class DecoderFlags : uint8_t {
    * set.
    */
   CANNOT_SUBSTITUTE = 1 << 4,
+
+  /**
+   * The decode was requested to paint content that's in the viewport right
+   * now, so it should be scheduled ahead of decodes for content further
+   * away. See imgIContainer::FLAG_HIGH_PRIORITY.
+   */
+  HIGH_PRIORITY = 1 << 5,
 };
 MOZ_MAKE_ENUM_CLASS_BITWISE_OPERATORS(DecoderFlags)
 
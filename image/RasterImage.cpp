@@ -1243,6 +1243,9 @@ void RasterImage::Decode(const UnorientedIntSize& aSize, uint32_t aFlags,
   if (LoadHasBeenDecoded()) {
     decoderFlags |= DecoderFlags::IS_REDECODE;
   }
+  if (aFlags & FLAG_HIGH_PRIORITY) {
+    decoderFlags |= DecoderFlags::HIGH_PRIORITY;
+  }
   if ((aFlags & FLAG_SYNC_DECODE) || !(aFlags & FLAG_HIGH_QUALITY_SCALING)) {
     // Used SurfaceCache::Lookup instead of SurfaceCache::LookupBestMatch. That
     // means the caller can handle a differently sized surface to be returned
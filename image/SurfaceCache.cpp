@@ -1142,6 +1142,28 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
     MaybeRemoveEmptyCache(aImageKey, cache);
   }
 
+  void PruneAllImages(const OrderedStaticMutexAutoLock& aAutoLock) {
+    // Pruning may empty a per-image cache, and removing an empty cache
+    // mutates mImageCaches, so take a snapshot of the caches to iterate over.
+    AutoTArray<ImageKey, 16> keys;
+    AutoTArray<RefPtr<ImageSurfaceCache>, 16> caches;
+    for (auto iter = mImageCaches.Iter(); !iter.Done(); iter.Next()) {
+      keys.AppendElement(iter.Key());
+      caches.AppendElement(iter.Data());
+    }
+
+    for (uint32_t i = 0; i < caches.Length(); ++i) {
+      caches[i]->Prune(
+          [this, &aAutoLock](NotNull<CachedSurface*> aSurface) -> void {
+            StopTracking(aSurface, /* aIsTracked */ true, aAutoLock);
+            // Individual surfaces must be freed outside the lock.
+            mCachedSurfacesDiscard.AppendElement(aSurface);
+          });
+
+      MaybeRemoveEmptyCache(keys[i], caches[i]);
+    }
+  }
+
   void DiscardAll(const OrderedStaticMutexAutoLock& aAutoLock) {
     // Remove in order of cost because mCosts is an array and the other data
     // structures are all hash tables. Note that locked surfaces are not
@@ -1483,6 +1505,10 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
       {
         OrderedStaticMutexAutoLock lock(sInstanceMutex);
         if (sInstance && strcmp(aTopic, "memory-pressure") == 0) {
+          // Drop redundant non-factor-of-2 sized surfaces first; those have a
+          // substitute already in the cache, so losing them costs nothing.
+          // Only then discard by LRU order to reach the target.
+          sInstance->PruneAllImages(lock);
           sInstance->DiscardForMemoryPressure(lock);
           sInstance->TakeDiscard(discard, lock);
         }
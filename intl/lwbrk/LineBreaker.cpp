@@ -1111,7 +1111,7 @@ void LineBreaker::GetJISx4051Breaks(const char16_t* aChars, uint32_t aLength,
           aBreakBefore[ci - aChars] = true;
         }
       } else {
-        NS_GetComplexLineBreaks(aChars + cur, end - cur, aBreakBefore + cur);
+        ComplexBreaker::GetBreaks(aChars + cur, end - cur, aBreakBefore + cur);
         // restore breakability at chunk begin, which was always set to false
         // by the complex line breaker
         aBreakBefore[cur] = allowBreak;
@@ -33,7 +33,8 @@ bool WordBreaker::BreakInBetween(const char16_t* aText1, uint32_t aTextLen1,
     text.Append(aText2, aTextLen2);
     AutoTArray<uint8_t, 256> breakBefore;
     breakBefore.SetLength(aTextLen1 + aTextLen2);
-    NS_GetComplexLineBreaks(text.get(), text.Length(), breakBefore.Elements());
+    ComplexBreaker::GetBreaks(text.get(), text.Length(),
+                              breakBefore.Elements());
     bool ret = breakBefore[aTextLen1];
     return ret;
   }
@@ -156,8 +157,8 @@ WordRange WordBreaker::FindWord(const char16_t* aText, uint32_t aTextLen,
     // shorter answer
     AutoTArray<uint8_t, 256> breakBefore;
     breakBefore.SetLength(range.mEnd - range.mBegin);
-    NS_GetComplexLineBreaks(aText + range.mBegin, range.mEnd - range.mBegin,
-                            breakBefore.Elements());
+    ComplexBreaker::GetBreaks(aText + range.mBegin, range.mEnd - range.mBegin,
+                              breakBefore.Elements());
 
     // Scan forward
     for (i = aOffset + 1; i < range.mEnd; i++) {
@@ -199,7 +200,7 @@ int32_t WordBreaker::NextWord(const char16_t* aText, uint32_t aLen,
     // shorter answer
     AutoTArray<uint8_t, 256> breakBefore;
     breakBefore.SetLength(aLen - aPos);
-    NS_GetComplexLineBreaks(aText + aPos, aLen - aPos, breakBefore.Elements());
+    ComplexBreaker::GetBreaks(aText + aPos, aLen - aPos, breakBefore.Elements());
     uint32_t i = 1;
     while (i < cur - aPos && !breakBefore[i]) {
       i++;
@@ -0,0 +1,35 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "gtest/gtest.h"
+
+#include "mozilla/ArrayUtils.h"
+#include "nsComplexBreaker.h"
+#include "nsTArray.h"
+
+// Thai text, since all platform back-ends support Thai breaking.
+static const char16_t kThaiText[] = u"เราทุกคนอยู่ในโลก";
+
+TEST(ComplexBreaker, CachedBreaksMatchUncached)
+{
+  const uint32_t length = mozilla::ArrayLength(kThaiText) - 1;
+
+  nsTArray<uint8_t> direct;
+  direct.SetLength(length);
+  NS_GetComplexLineBreaks(kThaiText, length, direct.Elements());
+
+  // The first call computes and populates the cache, the second one is
+  // served from it; both must agree with the direct computation.
+  nsTArray<uint8_t> cached;
+  cached.SetLength(length);
+  ComplexBreaker::GetBreaks(kThaiText, length, cached.Elements());
+  EXPECT_EQ(direct, cached);
+
+  nsTArray<uint8_t> again;
+  again.SetLength(length);
+  ComplexBreaker::GetBreaks(kThaiText, length, again.Elements());
+  EXPECT_EQ(direct, again);
+}
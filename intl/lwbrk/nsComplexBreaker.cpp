@@ -0,0 +1,55 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "nsComplexBreaker.h"
+
+#include "mozilla/ClearOnShutdown.h"
+#include "mozilla/StaticPtr.h"
+#include "nsTArray.h"
+#include "nsTHashMap.h"
+#include "nsThreadUtils.h"
+
+using BreakCache = nsTHashMap<nsStringHashKey, nsTArray<uint8_t>>;
+
+static mozilla::StaticAutoPtr<BreakCache> sBreakCache;
+
+// Above this length the key copy and hash start eating into the win, and
+// long segments are unlikely to recur verbatim anyway.
+static const uint32_t kMaxCacheableLength = 1024;
+
+// When the cache fills up it is simply emptied wholesale; refilling it is
+// cheap relative to tracking recency per entry.
+static const uint32_t kMaxCacheEntries = 2048;
+
+// static
+void ComplexBreaker::GetBreaks(const char16_t* aText, uint32_t aLength,
+                               uint8_t* aBreakBefore) {
+  MOZ_ASSERT(aText, "aText shouldn't be null");
+
+  if (aLength > kMaxCacheableLength || !NS_IsMainThread()) {
+    NS_GetComplexLineBreaks(aText, aLength, aBreakBefore);
+    return;
+  }
+
+  if (!sBreakCache) {
+    sBreakCache = new BreakCache();
+    mozilla::ClearOnShutdown(&sBreakCache);
+  }
+
+  nsDependentSubstring key(aText, aLength);
+  if (auto cached = sBreakCache->Lookup(key)) {
+    memcpy(aBreakBefore, cached->Elements(), aLength);
+    return;
+  }
+
+  NS_GetComplexLineBreaks(aText, aLength, aBreakBefore);
+
+  if (sBreakCache->Count() >= kMaxCacheEntries) {
+    sBreakCache->Clear();
+  }
+  nsTArray<uint8_t> breaks;
+  breaks.AppendElements(aBreakBefore, aLength);
+  sBreakCache->InsertOrUpdate(key, std::move(breaks));
+}
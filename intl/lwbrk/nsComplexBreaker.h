@@ -15,6 +15,19 @@
 void NS_GetComplexLineBreaks(const char16_t* aText, uint32_t aLength,
                              uint8_t* aBreakBefore);
 
+/**
+ * A caching wrapper around NS_GetComplexLineBreaks. The platform back-ends
+ * can be expensive (they may call into system dictionaries), and reflows
+ * that rebuild text runs keep asking about the same text, so the breaks
+ * computed for recently seen segments are kept and reused. The cache needs
+ * no explicit invalidation because it is keyed by the text itself.
+ */
+class ComplexBreaker {
+ public:
+  static void GetBreaks(const char16_t* aText, uint32_t aLength,
+                        uint8_t* aBreakBefore);
+};
+
 // This is used on some platforms when diverged from the recording. In this case
 // system calls made while computing line breaks might not be present in the
 // recording, and may cause the computation to fail. The breaks will be computed
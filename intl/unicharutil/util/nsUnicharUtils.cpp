@@ -9,6 +9,8 @@
 #include "mozilla/Likely.h"
 #include "mozilla/HashFunctions.h"
 
+#include <string.h>
+
 // We map x -> x, except for upper-case letters,
 // which we map to their lower-case equivalents.
 static const uint8_t gASCIIToLower[128] = {
@@ -25,6 +27,44 @@ static const uint8_t gASCIIToLower[128] = {
     0x78, 0x79, 0x7a, 0x7b, 0x7c, 0x7d, 0x7e, 0x7f,
 };
 
+// Helpers for the buffer-folding loops below: a size_t is treated as a
+// vector of 16-bit lanes, so runs of ASCII text can be case-mapped a
+// register width at a time instead of per code unit.
+
+// Every 16-bit lane filled with aValue.
+static constexpr size_t LaneRepeat(char16_t aValue) {
+  size_t word = 0;
+  for (size_t i = 0; i < sizeof(size_t) / sizeof(char16_t); ++i) {
+    word = (word << 16) | aValue;
+  }
+  return word;
+}
+
+// Number of UTF-16 code units processed per word.
+static const size_t kLanesPerWord = sizeof(size_t) / sizeof(char16_t);
+
+// A lane with any of these bits set is not ASCII.
+static const size_t kNonAsciiLanes = LaneRepeat(0xff80);
+
+// Returns a word with 0x0080 set in each lane whose value lies in
+// [aLow, aHigh]. All lanes of aWord must be ASCII.
+static MOZ_ALWAYS_INLINE size_t LanesInRange(size_t aWord, char16_t aLow,
+                                             char16_t aHigh) {
+  size_t atLeast = aWord + LaneRepeat(0x0080 - aLow);
+  size_t above = aWord + LaneRepeat(0x0080 - (aHigh + 1));
+  return (atLeast & ~above) & LaneRepeat(0x0080);
+}
+
+// Lower-cases all-ASCII lanes by setting 0x20 on upper-case letters.
+static MOZ_ALWAYS_INLINE size_t ToLowerCaseAsciiWord(size_t aWord) {
+  return aWord | (LanesInRange(aWord, 'A', 'Z') >> 2);
+}
+
+// Upper-cases all-ASCII lanes by clearing 0x20 on lower-case letters.
+static MOZ_ALWAYS_INLINE size_t ToUpperCaseAsciiWord(size_t aWord) {
+  return aWord & ~(LanesInRange(aWord, 'a', 'z') >> 2);
+}
+
 // We want ToLowerCase(uint32_t) and ToLowerCaseASCII(uint32_t) to be fast
 // when they're called from within the case-insensitive comparators, so we
 // define inlined versions.
@@ -239,23 +279,51 @@ int32_t nsASCIICaseInsensitiveStringComparator(const char16_t* lhs,
 uint32_t ToLowerCase(uint32_t aChar) { return ToLowerCase_inline(aChar); }
 
 void ToLowerCase(const char16_t* aIn, char16_t* aOut, size_t aLen) {
-  for (size_t i = 0; i < aLen; i++) {
+  for (size_t i = 0; i < aLen;) {
+    // Bulk-fold runs of ASCII a register width at a time.
+    while (i + kLanesPerWord <= aLen) {
+      size_t word;
+      memcpy(&word, aIn + i, sizeof(word));
+      if (word & kNonAsciiLanes) {
+        break;
+      }
+      word = ToLowerCaseAsciiWord(word);
+      memcpy(aOut + i, &word, sizeof(word));
+      i += kLanesPerWord;
+    }
+    if (i == aLen) {
+      break;
+    }
     uint32_t ch = aIn[i];
     if (i < aLen - 1 && NS_IS_SURROGATE_PAIR(ch, aIn[i + 1])) {
       ch = mozilla::unicode::GetLowercase(SURROGATE_TO_UCS4(ch, aIn[i + 1]));
       NS_ASSERTION(!IS_IN_BMP(ch), "case mapping crossed BMP/SMP boundary!");
       aOut[i++] = H_SURROGATE(ch);
-      aOut[i] = L_SURROGATE(ch);
+      aOut[i++] = L_SURROGATE(ch);
       continue;
     }
-    aOut[i] = ToLowerCase(ch);
+    aOut[i++] = ToLowerCase(ch);
   }
 }
 
 void ToLowerCaseASCII(const char16_t* aIn, char16_t* aOut, size_t aLen) {
-  for (size_t i = 0; i < aLen; i++) {
+  for (size_t i = 0; i < aLen;) {
+    // Bulk-fold runs of ASCII a register width at a time.
+    while (i + kLanesPerWord <= aLen) {
+      size_t word;
+      memcpy(&word, aIn + i, sizeof(word));
+      if (word & kNonAsciiLanes) {
+        break;
+      }
+      word = ToLowerCaseAsciiWord(word);
+      memcpy(aOut + i, &word, sizeof(word));
+      i += kLanesPerWord;
+    }
+    if (i == aLen) {
+      break;
+    }
     char16_t ch = aIn[i];
-    aOut[i] = IS_ASCII_UPPER(ch) ? (ch + 0x20) : ch;
+    aOut[i++] = IS_ASCII_UPPER(ch) ? (ch + 0x20) : ch;
   }
 }
 
@@ -271,16 +339,30 @@ uint32_t ToUpperCase(uint32_t aChar) {
 }
 
 void ToUpperCase(const char16_t* aIn, char16_t* aOut, size_t aLen) {
-  for (size_t i = 0; i < aLen; i++) {
+  for (size_t i = 0; i < aLen;) {
+    // Bulk-fold runs of ASCII a register width at a time.
+    while (i + kLanesPerWord <= aLen) {
+      size_t word;
+      memcpy(&word, aIn + i, sizeof(word));
+      if (word & kNonAsciiLanes) {
+        break;
+      }
+      word = ToUpperCaseAsciiWord(word);
+      memcpy(aOut + i, &word, sizeof(word));
+      i += kLanesPerWord;
+    }
+    if (i == aLen) {
+      break;
+    }
     uint32_t ch = aIn[i];
     if (i < aLen - 1 && NS_IS_SURROGATE_PAIR(ch, aIn[i + 1])) {
       ch = mozilla::unicode::GetUppercase(SURROGATE_TO_UCS4(ch, aIn[i + 1]));
       NS_ASSERTION(!IS_IN_BMP(ch), "case mapping crossed BMP/SMP boundary!");
       aOut[i++] = H_SURROGATE(ch);
-      aOut[i] = L_SURROGATE(ch);
+      aOut[i++] = L_SURROGATE(ch);
       continue;
     }
-    aOut[i] = ToUpperCase(ch);
+    aOut[i++] = ToUpperCase(ch);
   }
 }
 
@@ -687,6 +687,56 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
     }
 
     const bool intentional_short_write = !iter.Done();
+
+    // How many bytes of the first message are in the iovec.
+    const size_t head_bytes = amt_to_write;
+
+    // Sizes of whole messages, beyond the first, riding along in the same
+    // sendmsg(). Coalescing bursts of small messages into one syscall keeps
+    // high-rate channels from paying a sendmsg() per message. Only messages
+    // without file descriptors can be coalesced, since descriptors travel in
+    // the control message, which belongs to the first message here. Each
+    // message contributes at least one iovec, so this can't overflow.
+    size_t coalesced_bytes[kMaxIOVecSize];
+    size_t num_coalesced = 0;
+
+    if (!intentional_short_write) {
+      auto queued = output_queue_.begin();
+      for (++queued; queued != output_queue_.end(); ++queued) {
+        Message* next = (*queued).get();
+        if (!next->file_descriptor_set()->empty()) {
+          break;
+        }
+
+        // Add the whole message or roll it back; a partially included
+        // follower would complicate the accounting below for no benefit.
+        const size_t prev_iov_count = iov_count;
+        const size_t prev_amt_to_write = amt_to_write;
+        Pickle::BufferList::IterImpl next_iter(next->Buffers());
+        bool added = true;
+        while (!next_iter.Done()) {
+          if (iov_count == kMaxIOVecSize || !PipeBufHasSpaceAfter(amt_to_write)) {
+            added = false;
+            break;
+          }
+          iov[iov_count].iov_base = const_cast<char*>(next_iter.Data());
+          iov[iov_count].iov_len = next_iter.RemainingInSegment();
+          amt_to_write += iov[iov_count].iov_len;
+          next_iter.Advance(next->Buffers(), iov[iov_count].iov_len);
+          iov_count++;
+        }
+        if (!added) {
+          iov_count = prev_iov_count;
+          amt_to_write = prev_amt_to_write;
+          break;
+        }
+
+        coalesced_bytes[num_coalesced++] = amt_to_write - prev_amt_to_write;
+        AddIPCProfilerMarker(*next, other_pid_, MessageDirection::eSending,
+                             MessagePhase::TransferStart);
+      }
+    }
+
     msgh.msg_iov = iov;
     msgh.msg_iovlen = iov_count;
 
@@ -737,19 +787,74 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
       }
     }
 
-    if (intentional_short_write ||
-        static_cast<size_t>(bytes_written) != amt_to_write) {
-      // If write() fails with EAGAIN then bytes_written will be -1.
-      if (bytes_written > 0) {
-        MOZ_DIAGNOSTIC_ASSERT(intentional_short_write ||
-                              static_cast<size_t>(bytes_written) <
-                                  amt_to_write);
-        partial_write_iter_.ref().AdvanceAcrossSegments(msg->Buffers(),
-                                                        bytes_written);
+    if (bytes_written > 0) {
+      size_t left = static_cast<size_t>(bytes_written);
+
+      if (!intentional_short_write && left >= head_bytes) {
+        // The first message was written out completely.
+        left -= head_bytes;
+        partial_write_iter_.reset();
+
+#if defined(OS_MACOSX)
+        if (!msg->file_descriptor_set()->empty())
+          pending_fds_.push_back(PendingDescriptors(
+              msg->fd_cookie(), msg->file_descriptor_set()));
+#endif
+
+        // Message sent OK!
+
+        AddIPCProfilerMarker(*msg, other_pid_, MessageDirection::eSending,
+                             MessagePhase::TransferEnd);
+
+#ifdef IPC_MESSAGE_DEBUG_EXTRA
+        DLOG(INFO) << "sent message @" << msg << " on channel @" << this
+                   << " with type " << msg->type();
+#endif
+        OutputQueuePop();
+        // msg has been destroyed, so clear the dangling reference.
+        msg = nullptr;
+
+        // Pop any coalesced messages which were also written out completely.
+        size_t sent_coalesced = 0;
+        while (sent_coalesced < num_coalesced &&
+               left >= coalesced_bytes[sent_coalesced]) {
+          left -= coalesced_bytes[sent_coalesced];
+          sent_coalesced++;
+
+          Message* sent = output_queue_.FirstElement().get();
+          AddIPCProfilerMarker(*sent, other_pid_, MessageDirection::eSending,
+                               MessagePhase::TransferEnd);
+#ifdef IPC_MESSAGE_DEBUG_EXTRA
+          DLOG(INFO) << "sent message @" << sent << " on channel @" << this
+                     << " with type " << sent->type();
+#endif
+          OutputQueuePop();
+        }
+
+        if (left > 0) {
+          // The write stopped partway into a coalesced message. It becomes
+          // the new first message, with the written part skipped over.
+          MOZ_DIAGNOSTIC_ASSERT(sent_coalesced < num_coalesced);
+          Message* next = output_queue_.FirstElement().get();
+          Pickle::BufferList::IterImpl next_iter(next->Buffers());
+          next_iter.AdvanceAcrossSegments(next->Buffers(), left);
+          // We should not hit the end of the buffer.
+          MOZ_DIAGNOSTIC_ASSERT(!next_iter.Done());
+          partial_write_iter_.emplace(next_iter);
+        }
+      } else {
+        // Partial write of the first message.
+        MOZ_DIAGNOSTIC_ASSERT(intentional_short_write || left < amt_to_write);
+        partial_write_iter_.ref().AdvanceAcrossSegments(msg->Buffers(), left);
         // We should not hit the end of the buffer.
         MOZ_DIAGNOSTIC_ASSERT(!partial_write_iter_.ref().Done());
       }
+    }
 
+    if (intentional_short_write ||
+        static_cast<size_t>(bytes_written) != amt_to_write) {
+      // If write() fails with EAGAIN then bytes_written will be -1, and the
+      // accounting above was skipped.
       // Tell libevent to call us back once things are unblocked.
       is_blocked_on_write_ = true;
       MessageLoopForIO::current()->WatchFileDescriptor(
@@ -757,27 +862,6 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
           false,  // One shot
           MessageLoopForIO::WATCH_WRITE, &write_watcher_, this);
       return true;
-    } else {
-      partial_write_iter_.reset();
-
-#if defined(OS_MACOSX)
-      if (!msg->file_descriptor_set()->empty())
-        pending_fds_.push_back(
-            PendingDescriptors(msg->fd_cookie(), msg->file_descriptor_set()));
-#endif
-
-      // Message sent OK!
-
-      AddIPCProfilerMarker(*msg, other_pid_, MessageDirection::eSending,
-                           MessagePhase::TransferEnd);
-
-#ifdef IPC_MESSAGE_DEBUG_EXTRA
-      DLOG(INFO) << "sent message @" << msg << " on channel @" << this
-                 << " with type " << msg->type();
-#endif
-      OutputQueuePop();
-      // msg has been destroyed, so clear the dangling reference.
-      msg = nullptr;
     }
   }
   return true;
@@ -22,6 +22,7 @@
 #include "mozilla/ScopeExit.h"
 #include "mozilla/Sprintf.h"
 #include "mozilla/StaticMutex.h"
+#include "mozilla/StaticPrefs_ipc.h"
 #include "mozilla/Telemetry.h"
 #include "mozilla/TimeStamp.h"
 #include "mozilla/UniquePtrExtensions.h"
@@ -1537,6 +1538,19 @@ bool MessageChannel::Send(UniquePtr<Message> aMsg, Message* aReply) {
   if (NS_IsMainThread() && latencyMs >= kMinTelemetrySyncIPCLatencyMs) {
     Telemetry::Accumulate(Telemetry::IPC_SYNC_MAIN_LATENCY_MS,
                           nsDependentCString(msgName), latencyMs);
+
+    // A sync send that blocked the main thread past the configured deadline
+    // additionally gets a marker carrying the sending stack, so the guilty
+    // message type is attributable in profiles rather than showing up as
+    // anonymous jank.
+    uint32_t deadlineMs = StaticPrefs::ipc_sync_message_deadline_ms();
+    if (deadlineMs && latencyMs >= deadlineMs &&
+        !profiler_is_locked_on_current_thread()) {
+      PROFILER_MARKER_TEXT("SyncIPCDeadline", IPC,
+                           MarkerOptions(MarkerTiming::IntervalUntilNowFrom(start),
+                                         MarkerStack::Capture()),
+                           nsDependentCString(msgName));
+    }
   }
   return true;
 }
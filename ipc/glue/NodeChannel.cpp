@@ -189,22 +189,46 @@ void NodeChannel::SendMessage(UniquePtr<IPC::Message> aMessage) {
   }
   aMessage->AssertAsLargeAsHeader();
 
-  XRE_GetIOMessageLoop()->PostTask(
-      NewRunnableMethod<StoreCopyPassByRRef<UniquePtr<IPC::Message>>>(
-          "NodeChannel::DoSendMessage", this, &NodeChannel::DoSendMessage,
-          std::move(aMessage)));
+  bool needsFlush = false;
+  {
+    auto pending = mPendingMessages.Lock();
+    needsFlush = pending->IsEmpty();
+    pending->Push(std::move(aMessage));
+  }
+
+  // Only wake the IO thread when the queue was empty; a flush which is
+  // already pending will pick up any messages queued behind the first one.
+  if (needsFlush) {
+    XRE_GetIOMessageLoop()->PostTask(
+        NewRunnableMethod("NodeChannel::FlushPendingMessages", this,
+                          &NodeChannel::FlushPendingMessages));
+  }
 }
 
-void NodeChannel::DoSendMessage(UniquePtr<IPC::Message> aMessage) {
+void NodeChannel::FlushPendingMessages() {
   AssertIOThread();
-  if (mClosed) {
-    NS_WARNING("Dropping message as channel has been closed");
-    return;
+
+  // Take the entire queue in one go. Messages sent while we're writing will
+  // find the queue empty again and post a new flush task.
+  Queue<UniquePtr<IPC::Message>, 64> messages;
+  {
+    auto pending = mPendingMessages.Lock();
+    messages = std::move(*pending);
   }
 
-  if (!mChannel->Send(std::move(aMessage))) {
-    NS_WARNING("Call to Send() failed");
-    OnChannelError();
+  while (!messages.IsEmpty()) {
+    UniquePtr<IPC::Message> message = messages.Pop();
+
+    if (mClosed) {
+      NS_WARNING("Dropping message as channel has been closed");
+      continue;
+    }
+
+    if (!mChannel->Send(std::move(message))) {
+      NS_WARNING("Call to Send() failed");
+      OnChannelError();
+      return;
+    }
   }
 }
 
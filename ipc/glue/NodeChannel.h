@@ -108,7 +108,7 @@ class NodeChannel final : public IPC::Channel::Listener {
   void SetOtherPid(int32_t aNewPid);
 
   void SendMessage(UniquePtr<IPC::Message> aMessage);
-  void DoSendMessage(UniquePtr<IPC::Message> aMessage);
+  void FlushPendingMessages();
 
   // IPC::Channel::Listener implementation
   void OnMessageReceived(IPC::Message&& aMessage) override;
@@ -137,6 +137,13 @@ class NodeChannel final : public IPC::Channel::Listener {
   // WARNING: This must only be accessed on the IO thread.
   bool mClosed = false;
 
+  // Messages which are queued to be sent over the channel. Senders on any
+  // thread append here, and only post a flush task to the IO thread when the
+  // queue transitions from empty to non-empty, so that a burst of messages
+  // wakes the IO thread once and is written out in a single pass.
+  DataMutex<Queue<UniquePtr<IPC::Message>, 64>> mPendingMessages{
+      "NodeChannel::mPendingMessages"};
+
   // WARNING: Must only be accessed on the IO thread.
   WeakPtr<IPC::Channel::Listener> mExistingListener;
 };
@@ -14,6 +14,7 @@
 
 #include "jstypes.h"  // JS_PUBLIC_API
 
+#include "js/CharacterEncoding.h"  // JS::UTF8Chars
 #include "js/TypeDecls.h"
 
 using JSONWriteCallback = bool (*)(const char16_t* buf, uint32_t len,
@@ -63,12 +64,35 @@ extern JS_PUBLIC_API bool JS_ParseJSON(JSContext* cx, const char16_t* chars,
                                        uint32_t len,
                                        JS::MutableHandle<JS::Value> vp);
 
+/**
+ * Performs the JSON.parse operation as specified by ECMAScript, on Latin-1
+ * (8-bit) characters. The characters are parsed in place, so unlike the
+ * two-byte and JSString overloads no copy of the input is required; prefer
+ * this overload when ingesting large payloads whose bytes are known to be
+ * valid Latin-1.
+ */
+extern JS_PUBLIC_API bool JS_ParseJSON(JSContext* cx,
+                                       const JS::Latin1Char* chars,
+                                       uint32_t len,
+                                       JS::MutableHandle<JS::Value> vp);
+
 /**
  * Performs the JSON.parse operation as specified by ECMAScript.
  */
 extern JS_PUBLIC_API bool JS_ParseJSON(JSContext* cx, JS::Handle<JSString*> str,
                                        JS::MutableHandle<JS::Value> vp);
 
+/**
+ * Performs the JSON.parse operation as specified by ECMAScript, on UTF-8
+ * encoded bytes. ASCII-only input -- the common case for large
+ * machine-generated payloads -- is parsed in place without being copied or
+ * inflated first; input containing non-ASCII code points is inflated to
+ * two-byte characters before parsing.
+ */
+extern JS_PUBLIC_API bool JS_ParseJSON(JSContext* cx,
+                                       const JS::UTF8Chars chars,
+                                       JS::MutableHandle<JS::Value> vp);
+
 /**
  * Performs the JSON.parse operation as specified by ECMAScript, using the
  * given |reviver| argument as the corresponding optional argument to that
@@ -78,6 +102,15 @@ extern JS_PUBLIC_API bool JS_ParseJSONWithReviver(
     JSContext* cx, const char16_t* chars, uint32_t len,
     JS::Handle<JS::Value> reviver, JS::MutableHandle<JS::Value> vp);
 
+/**
+ * Performs the JSON.parse operation as specified by ECMAScript, using the
+ * given |reviver| argument as the corresponding optional argument to that
+ * function, on Latin-1 (8-bit) characters, which are parsed in place.
+ */
+extern JS_PUBLIC_API bool JS_ParseJSONWithReviver(
+    JSContext* cx, const JS::Latin1Char* chars, uint32_t len,
+    JS::Handle<JS::Value> reviver, JS::MutableHandle<JS::Value> vp);
+
 /**
  * Performs the JSON.parse operation as specified by ECMAScript, using the
  * given |reviver| argument as the corresponding optional argument to that
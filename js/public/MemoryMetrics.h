@@ -895,6 +895,14 @@ extern JS_PUBLIC_API size_t UserCompartmentCount(JSContext* cx);
 extern JS_PUBLIC_API size_t SystemRealmCount(JSContext* cx);
 extern JS_PUBLIC_API size_t UserRealmCount(JSContext* cx);
 
+// Computes all four of the above counts in a single traversal of the
+// runtime's compartments and realms, for callers that sample them together.
+extern JS_PUBLIC_API void CompartmentAndRealmCounts(JSContext* cx,
+                                                    size_t* systemCompartments,
+                                                    size_t* userCompartments,
+                                                    size_t* systemRealms,
+                                                    size_t* userRealms);
+
 extern JS_PUBLIC_API size_t PeakSizeOfTemporary(const JSContext* cx);
 
 extern JS_PUBLIC_API bool AddSizeOfTab(JSContext* cx, JS::HandleObject obj,
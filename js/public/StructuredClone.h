@@ -399,6 +399,33 @@ class SharedArrayRawBufferRefs {
   js::Vector<js::SharedArrayRawBuffer*, 0, js::SystemAllocPolicy> refs_;
 };
 
+struct ArrayBufferSnapshot;
+
+/**
+ * References to immutable out-of-line copies of large ArrayBuffers, held
+ * alive by a structured clone buffer. When a large ArrayBuffer is cloned
+ * within the SameProcess scope, its contents are copied once into a single
+ * refcounted snapshot and the clone stream stores only a pointer to it; each
+ * read copies out of the snapshot, so the clone data may be read any number
+ * of times. The snapshots are released when the clone data is discarded.
+ */
+class ArrayBufferSnapshotRefs {
+ public:
+  ArrayBufferSnapshotRefs() = default;
+  ArrayBufferSnapshotRefs(ArrayBufferSnapshotRefs&& other) = default;
+  ArrayBufferSnapshotRefs& operator=(ArrayBufferSnapshotRefs&& other);
+  ~ArrayBufferSnapshotRefs();
+
+  // Take ownership of a reference to |snapshot|. On failure the reference is
+  // dropped.
+  [[nodiscard]] bool adopt(JSContext* cx, ArrayBufferSnapshot* snapshot);
+  void takeOwnership(ArrayBufferSnapshotRefs&&);
+  void releaseAll();
+
+ private:
+  js::Vector<js::ArrayBufferSnapshot*, 0, js::SystemAllocPolicy> refs_;
+};
+
 template <typename T, typename AllocPolicy>
 struct BufferIterator;
 }  // namespace js
@@ -428,6 +455,7 @@ class MOZ_NON_MEMMOVABLE JS_PUBLIC_API JSStructuredCloneData {
   OwnTransferablePolicy ownTransferables_ =
       OwnTransferablePolicy::NoTransferables;
   js::SharedArrayRawBufferRefs refsHeld_;
+  js::ArrayBufferSnapshotRefs snapshotsHeld_;
 
   friend struct JSStructuredCloneWriter;
   friend class JS_PUBLIC_API JSAutoStructuredCloneBuffer;
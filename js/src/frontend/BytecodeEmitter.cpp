@@ -187,6 +187,9 @@ bool BytecodeEmitter::init() {
       return false;
     }
   }
+  if (!bytecodeSection_.init(cx)) {
+    return false;
+  }
   return perScriptData_.init(cx);
 }
 
@@ -289,6 +292,7 @@ bool BytecodeEmitter::emitCheck(JSOp op, ptrdiff_t delta,
   }
 
   if (!bytecodeSection().code().growByUninitialized(delta)) {
+    ReportOutOfMemory(cx);
     return false;
   }
 
@@ -11744,6 +11748,7 @@ static bool AllocSrcNote(JSContext* cx, SrcNotesVector& notes, unsigned size,
   }
 
   if (!notes.growByUninitialized(size)) {
+    ReportOutOfMemory(cx);
     return false;
   }
 
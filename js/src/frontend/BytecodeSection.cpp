@@ -158,8 +158,8 @@ void CGScopeNoteList::recordEndImpl(uint32_t index, uint32_t offset) {
 
 BytecodeSection::BytecodeSection(JSContext* cx, uint32_t lineNum,
                                  uint32_t column)
-    : code_(cx),
-      notes_(cx),
+    : code_(cx->frontendCollectionPool()),
+      notes_(cx->frontendCollectionPool()),
       lastNoteOffset_(0),
       tryNoteList_(cx),
       scopeNoteList_(cx),
@@ -167,6 +167,10 @@ BytecodeSection::BytecodeSection(JSContext* cx, uint32_t lineNum,
       currentLine_(lineNum),
       lastColumn_(column) {}
 
+bool BytecodeSection::init(JSContext* cx) {
+  return code_.acquire(cx) && notes_.acquire(cx);
+}
+
 void BytecodeSection::updateDepth(BytecodeOffset target) {
   jsbytecode* pc = code(target);
 
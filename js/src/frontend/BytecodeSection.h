@@ -177,10 +177,13 @@ struct CGResumeOffsetList {
 static constexpr size_t MaxBytecodeLength = INT32_MAX;
 static constexpr size_t MaxSrcNotesLength = INT32_MAX;
 
-// Have a few inline elements, so as to avoid heap allocation for tiny
-// sequences.  See bug 1390526.
-typedef Vector<jsbytecode, 64> BytecodeVector;
-typedef Vector<js::SrcNote, 64> SrcNotesVector;
+// The bytecode and source-note buffers are recycled through the per-thread
+// NameCollectionPool, so their heap storage is reused across the many
+// functions emitted by a compilation instead of being freed and reallocated
+// for each one. Allocation failures are not reported automatically; callers
+// report OOM themselves (see BytecodeEmitter::emitCheck and AllocSrcNote).
+typedef Vector<jsbytecode, 0, SystemAllocPolicy> BytecodeVector;
+typedef Vector<js::SrcNote, 0, SystemAllocPolicy> SrcNotesVector;
 
 // Bytecode and all data directly associated with specific opcode/index inside
 // bytecode is stored in this class.
@@ -188,22 +191,24 @@ class BytecodeSection {
  public:
   BytecodeSection(JSContext* cx, uint32_t lineNum, uint32_t column);
 
+  [[nodiscard]] bool init(JSContext* cx);
+
   // ---- Bytecode ----
 
-  BytecodeVector& code() { return code_; }
-  const BytecodeVector& code() const { return code_; }
+  BytecodeVector& code() { return *code_; }
+  const BytecodeVector& code() const { return *code_; }
 
   jsbytecode* code(BytecodeOffset offset) {
-    return code_.begin() + offset.value();
+    return code_->begin() + offset.value();
   }
   BytecodeOffset offset() const {
-    return BytecodeOffset(code_.end() - code_.begin());
+    return BytecodeOffset(code_->end() - code_->begin());
   }
 
   // ---- Source notes ----
 
-  SrcNotesVector& notes() { return notes_; }
-  const SrcNotesVector& notes() const { return notes_; }
+  SrcNotesVector& notes() { return *notes_; }
+  const SrcNotesVector& notes() const { return *notes_; }
 
   BytecodeOffset lastNoteOffset() const { return lastNoteOffset_; }
   void setLastNoteOffset(BytecodeOffset offset) { lastNoteOffset_ = offset; }
@@ -311,12 +316,12 @@ class BytecodeSection {
   // ---- Bytecode ----
 
   // Bytecode.
-  BytecodeVector code_;
+  PooledVectorPtr<BytecodeVector> code_;
 
   // ---- Source notes ----
 
   // Source notes
-  SrcNotesVector notes_;
+  PooledVectorPtr<SrcNotesVector> notes_;
 
   // Code offset for last source note
   BytecodeOffset lastNoteOffset_;
@@ -265,8 +265,12 @@ class VectorPool : public CollectionPool<RepresentativeVector,
 
     using ElementType = typename Vector::ElementType;
 
-    static_assert(std::is_trivial_v<ElementType>,
-                  "Only vectors of trivial values are usable in the pool.");
+    // The pool only recycles the underlying buffers, so trivially copyable
+    // and destructible elements suffice; trivial default construction is not
+    // required.
+    static_assert(std::is_trivially_copyable_v<ElementType>,
+                  "Only vectors of trivially copyable values are usable in "
+                  "the pool.");
     static_assert(std::is_trivially_destructible_v<ElementType>,
                   "Only vectors of trivially destructible values are usable in "
                   "the pool.");
@@ -278,10 +282,16 @@ class VectorPool : public CollectionPool<RepresentativeVector,
   }
 };
 
+// Representative type for pooling the BytecodeEmitter's bytecode and
+// source-note buffers, whose heap storage would otherwise be freed and
+// reallocated for each function emitted by a compilation.
+using RecyclableByteVector = Vector<uint8_t, 0, SystemAllocPolicy>;
+
 class NameCollectionPool {
   InlineTablePool<AtomIndexMap> mapPool_;
   VectorPool<AtomVector> atomVectorPool_;
   VectorPool<FunctionBoxVector> functionBoxVectorPool_;
+  VectorPool<RecyclableByteVector> byteVectorPool_;
   uint32_t activeCompilations_;
 
  public:
@@ -322,6 +332,7 @@ class NameCollectionPool {
       mapPool_.purgeAll();
       atomVectorPool_.purgeAll();
       functionBoxVectorPool_.purgeAll();
+      byteVectorPool_.purgeAll();
     }
   }
 };
@@ -359,6 +370,25 @@ inline void NameCollectionPool::releaseVector<FunctionBoxVector>(
   }
 }
 
+// Any other vector type is pooled through the byte-vector pool. The
+// invariants asserted by VectorPool restrict this to vectors of byte-sized
+// trivially copyable elements with no inline storage, such as the
+// BytecodeEmitter's bytecode and source-note vectors.
+template <typename Vector>
+inline Vector* NameCollectionPool::acquireVector(JSContext* cx) {
+  MOZ_ASSERT(hasActiveCompilation());
+  return byteVectorPool_.acquire<Vector>(cx);
+}
+
+template <typename Vector>
+inline void NameCollectionPool::releaseVector(Vector** vec) {
+  MOZ_ASSERT(hasActiveCompilation());
+  MOZ_ASSERT(vec);
+  if (*vec) {
+    byteVectorPool_.release(vec);
+  }
+}
+
 template <typename T, template <typename> typename Impl>
 class PooledCollectionPtr {
   NameCollectionPool& pool_;
@@ -192,6 +192,7 @@
 
 #include "gc/GC-inl.h"
 
+#include "mozilla/Atomics.h"
 #include "mozilla/DebugOnly.h"
 #include "mozilla/MacroForEach.h"
 #include "mozilla/MemoryReporting.h"
@@ -5446,6 +5447,39 @@ class ImmediateSweepWeakCacheTask : public GCParallelTask {
   }
 };
 
+// Causes the weak maps in the given zone to be swept when run. Weak map
+// sweeping is split into a task per zone so that a sweep group containing
+// several ephemeron-heavy zones doesn't serialize all of its weak map
+// sweeping on a single helper thread.
+class SweepZoneWeakMapsTask : public GCParallelTask {
+  Zone* zone;
+
+  SweepZoneWeakMapsTask(const SweepZoneWeakMapsTask&) = delete;
+
+ public:
+  SweepZoneWeakMapsTask(GCRuntime* gc, Zone* zone)
+      : GCParallelTask(gc), zone(zone) {}
+
+  SweepZoneWeakMapsTask(SweepZoneWeakMapsTask&& other)
+      : GCParallelTask(std::move(other)), zone(other.zone) {}
+
+  void run(AutoLockHelperThreadState& lock) override {
+    AutoUnlockHelperThreadState unlock(lock);
+    AutoSetThreadIsSweeping threadIsSweeping;  // This may touch any zone.
+
+    /* No need to look up any more weakmap keys from this sweep group. */
+    AutoEnterOOMUnsafeRegion oomUnsafe;
+    if (!zone->gcEphemeronEdges().clear()) {
+      oomUnsafe.crash("clearing weak keys in SweepZoneWeakMapsTask::run()");
+    }
+
+    // Lock the storebuffer since this may access it when rehashing or resizing
+    // the tables.
+    AutoLockStoreBuffer lock2(&gc->storeBuffer());
+    zone->sweepWeakMaps();
+  }
+};
+
 void GCRuntime::updateAtomsBitmap() {
   DenseBitmap marked;
   if (atomMarking.computeBitmapFromChunkMarkBits(rt, marked)) {
@@ -5499,6 +5533,8 @@ void GCRuntime::sweepCompressionTasks() {
 }
 
 void GCRuntime::sweepWeakMaps() {
+  // Fallback used when we couldn't allocate the per-zone sweep tasks, see
+  // PrepareWeakMapSweepTasks.
   AutoSetThreadIsSweeping threadIsSweeping;  // This may touch any zone.
   for (SweepGroupZonesIter zone(this); !zone.done(); zone.next()) {
     /* No need to look up any more weakmap keys from this sweep group. */
@@ -5649,6 +5685,26 @@ void GCRuntime::sweepJitDataOnMainThread(JSFreeOp* fop) {
 using WeakCacheTaskVector =
     mozilla::Vector<ImmediateSweepWeakCacheTask, 0, SystemAllocPolicy>;
 
+using WeakMapSweepTaskVector =
+    mozilla::Vector<SweepZoneWeakMapsTask, 0, SystemAllocPolicy>;
+
+static bool PrepareWeakMapSweepTasks(GCRuntime* gc,
+                                     WeakMapSweepTaskVector* tasks) {
+  // Add a sweep task for each zone in the current sweep group, so zones'
+  // weak maps can be swept on separate helper threads.
+
+  MOZ_ASSERT(tasks->empty());
+
+  for (SweepGroupZonesIter zone(gc); !zone.done(); zone.next()) {
+    if (!tasks->emplaceBack(gc, zone)) {
+      tasks->clearAndFree();
+      return false;
+    }
+  }
+
+  return true;
+}
+
 // Call a functor for all weak caches that need to be swept in the current
 // sweep group.
 template <typename Functor>
@@ -5790,13 +5846,20 @@ IncrementalProgress GCRuntime::beginSweepingSweepGroup(JSFreeOp* fop,
                                   PhaseKind::SWEEP_MISC, lock);
     AutoRunParallelTask sweepCompTasks(this, &GCRuntime::sweepCompressionTasks,
                                        PhaseKind::SWEEP_COMPRESSION, lock);
-    AutoRunParallelTask sweepWeakMaps(this, &GCRuntime::sweepWeakMaps,
-                                      PhaseKind::SWEEP_WEAKMAPS, lock);
     AutoRunParallelTask sweepUniqueIds(this, &GCRuntime::sweepUniqueIds,
                                        PhaseKind::SWEEP_UNIQUEIDS, lock);
     AutoRunParallelTask sweepWeakRefs(this, &GCRuntime::sweepWeakRefs,
                                       PhaseKind::SWEEP_WEAKREFS, lock);
 
+    WeakMapSweepTaskVector sweepWeakMapTasks;
+    bool canSweepWeakMapsOffThread =
+        PrepareWeakMapSweepTasks(this, &sweepWeakMapTasks);
+    if (canSweepWeakMapsOffThread) {
+      for (auto& task : sweepWeakMapTasks) {
+        startTask(task, PhaseKind::SWEEP_WEAKMAPS, lock);
+      }
+    }
+
     WeakCacheTaskVector sweepCacheTasks;
     bool canSweepWeakCachesOffThread =
         PrepareWeakCacheTasks(rt, &sweepCacheTasks);
@@ -5811,12 +5874,22 @@ IncrementalProgress GCRuntime::beginSweepingSweepGroup(JSFreeOp* fop,
       AutoUnlockHelperThreadState unlock(lock);
       sweepJitDataOnMainThread(fop);
 
+      if (!canSweepWeakMapsOffThread) {
+        MOZ_ASSERT(sweepWeakMapTasks.empty());
+        AutoPhase ap2(stats(), PhaseKind::SWEEP_WEAKMAPS);
+        sweepWeakMaps();
+      }
+
       if (!canSweepWeakCachesOffThread) {
         MOZ_ASSERT(sweepCacheTasks.empty());
         SweepAllWeakCachesOnMainThread(rt);
       }
     }
 
+    for (auto& task : sweepWeakMapTasks) {
+      joinTask(task, PhaseKind::SWEEP_WEAKMAPS, lock);
+    }
+
     for (auto& task : sweepCacheTasks) {
       joinTask(task, PhaseKind::SWEEP_WEAK_CACHES, lock);
     }
@@ -6060,7 +6133,116 @@ IncrementalProgress GCRuntime::markUntilBudgetExhausted(
                                                                   : NotFinished;
 }
 
+// Parallel marking (experimental, enabled with JSGC_PARALLEL_MARKING in the
+// environment): when draining the mark stack non-incrementally, entries are
+// handed out in batches to helper threads, each of which drains them with
+// its own marker, pulling more work from the global marker's stack as it
+// runs dry. The global mark stack acts as the shared work pool and is only
+// accessed with the helper thread lock held while tasks are running.
+//
+// Helper markers skip weakmap expansion entirely (the collection is switched
+// to iterative weakmap marking, which tolerates entries being marked in any
+// order), and everything subtle --- delayed marking, barriered cells, gray
+// marking --- is left on the main marker and processed by the main thread
+// mop-up drain afterwards.
+
+// Number of entries a task claims from the global stack at a time.
+static const size_t ParallelMarkBatchSize = 512;
+
+// Maximum number of helper tasks used for parallel marking.
+static const size_t MaxParallelMarkTasks = 3;
+
+namespace {
+
+class ParallelMarkTask : public GCParallelTask {
+ public:
+  ParallelMarkTask(GCRuntime* gc, mozilla::Atomic<size_t>& busyCount)
+      : GCParallelTask(gc),
+        busyCount_(busyCount),
+        marker_(gc->rt, JS::WeakMapTraceAction::Skip) {}
+
+  bool init() { return marker_.init(); }
+
+  void run(AutoLockHelperThreadState& lock) override {
+    marker_.start();
+
+    // Weakmap entries are handled iteratively, see above.
+    marker_.abortLinearWeakMarking();
+
+    while (true) {
+      size_t stolen = gc->marker.moveWorkTo(marker_, ParallelMarkBatchSize);
+      if (!stolen) {
+        if (!busyCount_) {
+          break;
+        }
+        // Another task is still marking and may push more work onto the
+        // global stack; wait for it.
+        HelperThreadState().wait(lock,
+                                 mozilla::TimeDuration::FromMilliseconds(1));
+        continue;
+      }
+
+      busyCount_++;
+      {
+        AutoUnlockHelperThreadState unlock(lock);
+
+        // These checks assert when run in parallel.
+        AutoDisableProxyCheck noProxyCheck;
+
+        auto unlimited = SliceBudget::unlimited();
+        MOZ_RELEASE_ASSERT(marker_.markUntilBudgetExhausted(
+            unlimited, GCMarker::DontReportMarkTime));
+      }
+      busyCount_--;
+      HelperThreadState().notifyAll(lock);
+    }
+  }
+
+ private:
+  mozilla::Atomic<size_t>& busyCount_;
+  GCMarker marker_;
+};
+
+}  // anonymous namespace
+
+static bool ParallelMarkingEnabled() {
+  static bool enabled = !!getenv("JSGC_PARALLEL_MARKING");
+  return enabled;
+}
+
 void GCRuntime::drainMarkStack() {
+  if (ParallelMarkingEnabled() && marker.markColor() == MarkColor::Black &&
+      marker.hasBlackEntries()) {
+    // Iterative weakmap marking tolerates entries being marked out of order
+    // across markers; linear weak marking does not.
+    marker.abortLinearWeakMarking();
+
+    mozilla::Atomic<size_t> busyCount(0);
+    Vector<ParallelMarkTask*, 8, SystemAllocPolicy> tasks;
+
+    {
+      AutoLockHelperThreadState lock;
+
+      size_t numTasks = std::min(MaxParallelMarkTasks,
+                                 size_t(HelperThreadState().threadCount));
+      for (size_t i = 0; i < numTasks; i++) {
+        auto* task = js_new<ParallelMarkTask>(this, busyCount);
+        if (!task || !task->init() || !tasks.append(task)) {
+          js_delete(task);
+          break;
+        }
+        task->startWithLockHeld(lock);
+      }
+    }
+
+    for (ParallelMarkTask* task : tasks) {
+      task->join();
+      js_delete(task);
+    }
+  }
+
+  // Process whatever remains (including delayed marking, barriered cells and
+  // anything a failed parallel phase left behind) on this thread.
   auto unlimited = SliceBudget::unlimited();
   MOZ_RELEASE_ASSERT(marker.markUntilBudgetExhausted(unlimited));
 }
@@ -161,6 +161,10 @@ class MarkStack {
                           size_t start);
   [[nodiscard]] bool push(const SlotsOrElementsRange& array);
 
+  // Re-push an entry previously popped from a mark stack, preserving its
+  // tag. Used when transferring work between markers.
+  [[nodiscard]] bool push(const TaggedPtr& ptr);
+
   // GCMarker::eagerlyMarkChildren uses unused marking stack as temporary
   // storage to hold rope pointers.
   [[nodiscard]] bool pushTempRope(JSRope* ptr);
@@ -260,9 +264,19 @@ enum MarkingState : uint8_t {
 
 class GCMarker final : public JSTracer {
  public:
-  explicit GCMarker(JSRuntime* rt);
+  // Helper markers used for parallel marking pass WeakMapTraceAction::Skip
+  // so they never expand weakmap entries; the collection is switched to
+  // iterative weakmap marking instead, see GCRuntime::drainMarkStack.
+  explicit GCMarker(
+      JSRuntime* rt,
+      JS::WeakMapTraceAction weakMapAction = JS::WeakMapTraceAction::Expand);
   [[nodiscard]] bool init();
 
+  // Transfer up to maxEntries black mark stack entries to dst, returning the
+  // number moved. Both markers must be marking black, and the caller is
+  // responsible for synchronizing access to both markers.
+  size_t moveWorkTo(GCMarker& dst, size_t maxEntries);
+
   void setMaxCapacity(size_t maxCap) { stack.setMaxCapacity(maxCap); }
   size_t maxCapacity() const { return stack.maxCapacity(); }
 
@@ -2185,6 +2185,16 @@ inline bool MarkStack::push(JSObject* obj, SlotsOrElementsKind kind,
   return push(SlotsOrElementsRange(kind, obj, start));
 }
 
+inline bool MarkStack::push(const TaggedPtr& ptr) {
+  if (!ensureSpace(1)) {
+    return false;
+  }
+
+  *topPtr() = ptr;
+  topIndex_++;
+  return true;
+}
+
 inline bool MarkStack::push(const SlotsOrElementsRange& array) {
   array.assertValid();
 
@@ -2317,9 +2327,9 @@ inline void MarkStackIter::nextArray() {
  * a table of which will be consulted in a later phase whenever marking a
  * potential key.
  */
-GCMarker::GCMarker(JSRuntime* rt)
+GCMarker::GCMarker(JSRuntime* rt, JS::WeakMapTraceAction weakMapAction)
     : JSTracer(rt, JS::TracerKind::Marking,
-               JS::TraceOptions(JS::WeakMapTraceAction::Expand,
+               JS::TraceOptions(weakMapAction,
                                 JS::WeakEdgeTraceAction::Skip)),
       stack(),
       auxStack(),
@@ -2351,6 +2361,35 @@ bool GCMarker::isDrained() {
   return barrierBuffer().empty() && isMarkStackEmpty() && !delayedMarkingList;
 }
 
+size_t GCMarker::moveWorkTo(GCMarker& dst, size_t maxEntries) {
+  MOZ_ASSERT(markColor() == MarkColor::Black);
+  MOZ_ASSERT(dst.markColor() == MarkColor::Black);
+
+  MarkStack& srcStack = getStack(MarkColor::Black);
+  MarkStack& dstStack = dst.getStack(MarkColor::Black);
+
+  size_t moved = 0;
+  while (moved < maxEntries && !srcStack.isEmpty()) {
+    if (TagIsRangeTag(srcStack.peekTag())) {
+      MarkStack::SlotsOrElementsRange range =
+          srcStack.popSlotsOrElementsRange();
+      if (!dstStack.push(range)) {
+        // The re-push cannot fail as the pop freed sufficient space.
+        MOZ_ALWAYS_TRUE(srcStack.push(range));
+        break;
+      }
+    } else {
+      MarkStack::TaggedPtr ptr = srcStack.popPtr();
+      if (!dstStack.push(ptr)) {
+        MOZ_ALWAYS_TRUE(srcStack.push(ptr));
+        break;
+      }
+    }
+    moved++;
+  }
+  return moved;
+}
+
 void GCMarker::start() {
   MOZ_ASSERT(state == MarkingState::NotActive);
   state = MarkingState::RegularMarking;
@@ -3135,6 +3174,8 @@ inline void js::TenuringTracer::insertIntoObjectFixupList(
 
 template <typename T>
 inline T* js::TenuringTracer::allocTenured(Zone* zone, AllocKind kind) {
+  // Attribute the promoted cell to its zone for per-zone nursery sizing.
+  zone->nurseryPartition.tenuredBytes += Arena::thingSize(kind);
   return static_cast<T*>(static_cast<Cell*>(AllocateCellInGC(zone, kind)));
 }
 
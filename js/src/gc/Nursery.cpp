@@ -196,7 +196,6 @@ js::Nursery::Nursery(GCRuntime* gc)
       reportPretenuring_(false),
       minorGCTriggerReason_(JS::GCReason::NO_REASON),
       hasRecentGrowthData(false),
-      smoothedGrowthFactor(1.0),
       decommitTask(gc)
 #ifdef JS_GC_ZEAL
       ,
@@ -1632,13 +1631,6 @@ size_t js::Nursery::targetSize(JS::GCOptions options, JS::GCReason reason) {
     return 0;
   }
 
-  // Calculate the fraction of the nursery promoted out of its entire
-  // capacity. This gives better results than using the promotion rate (based on
-  // the amount of nursery used) in cases where we collect before the nursery is
-  // full.
-  double fractionPromoted =
-      double(previousGC.tenuredBytes) / double(previousGC.nurseryCapacity);
-
   // Calculate the fraction of time spent collecting the nursery.
   double timeFraction = 0.0;
   if (hasRecentGrowthData && !js::SupportDifferentialTesting()) {
@@ -1651,37 +1643,89 @@ size_t js::Nursery::targetSize(JS::GCOptions options, JS::GCReason reason) {
   // collector time goals.
   static const double PromotionGoal = 0.02;
   static const double TimeGoal = 0.01;
-  double growthFactor =
-      std::max(fractionPromoted / PromotionGoal, timeFraction / TimeGoal);
 
   // Limit the range of the growth factor to prevent transient high promotion
   // rates from affecting the nursery size too far into the future.
   static const double GrowthRange = 2.0;
-  growthFactor = ClampDouble(growthFactor, 1.0 / GrowthRange, GrowthRange);
 
-  // Use exponential smoothing on the desired growth rate to take into account
-  // the promotion rate from recent previous collections.
-  if (hasRecentGrowthData &&
-      now - lastCollectionEndTime() < TimeDuration::FromMilliseconds(200) &&
-      !js::SupportDifferentialTesting()) {
-    growthFactor = 0.75 * smoothedGrowthFactor + 0.25 * growthFactor;
-  }
+  // Leave a partition untouched if it is close to its promotion goal.
+  static const double GoalWidth = 1.5;
+
+  // Use exponential smoothing on the desired growth rates to take into
+  // account the promotion rate from recent previous collections.
+  bool smooth = hasRecentGrowthData &&
+                now - lastCollectionEndTime() <
+                    TimeDuration::FromMilliseconds(200) &&
+                !js::SupportDifferentialTesting();
 
   hasRecentGrowthData = true;
-  smoothedGrowthFactor = growthFactor;
 
-  // Leave size untouched if we are close to the promotion goal.
-  static const double GoalWidth = 1.5;
-  if (growthFactor > (1.0 / GoalWidth) && growthFactor < GoalWidth) {
-    return capacity();
+  // Each zone maintains its own notional partition of the nursery which
+  // adapts to the bytes that zone promoted, and the nursery is sized to the
+  // sum of the partitions. This stops one allocation-heavy zone from scaling
+  // the whole nursery by the blended promotion rate of every zone: quiet
+  // zones keep small partitions while busy zones grow their own.
+  //
+  // Zones without growth data yet are seeded with an equal share of the
+  // current capacity.
+
+  size_t zoneCount = 0;
+  for (AllZonesIter zone(gc); !zone.done(); zone.next()) {
+    zoneCount++;
   }
+  MOZ_ASSERT(zoneCount != 0);
+  size_t initialShare =
+      std::max(capacity() / zoneCount, size_t(SystemPageSize()));
 
-  // The multiplication below cannot overflow because growthFactor is at
-  // most two.
-  MOZ_ASSERT(growthFactor <= 2.0);
-  MOZ_ASSERT(capacity() < SIZE_MAX / 2);
+  // The time spent collecting is shared by every zone, so it contributes the
+  // same growth term to each partition.
+  double timeGrowth = timeFraction / TimeGoal;
 
-  return roundSize(size_t(double(capacity()) * growthFactor));
+  size_t partitionTotal = 0;
+  for (AllZonesIter zone(gc); !zone.done(); zone.next()) {
+    gc::NurseryPartition& part = zone->nurseryPartition;
+
+    size_t zoneTenuredBytes = part.tenuredBytes;
+    part.tenuredBytes = 0;
+
+    if (!part.hasGrowthData) {
+      part.partitionBytes = initialShare;
+    }
+
+    // Calculate the fraction of this zone's partition that was promoted.
+    // Using the partition rather than the bytes the zone allocated gives
+    // better results in cases where we collect before the nursery is full,
+    // as for the global fraction-of-capacity calculation this replaces.
+    double fractionPromoted =
+        double(zoneTenuredBytes) / double(part.partitionBytes);
+
+    double growthFactor = std::max(fractionPromoted / PromotionGoal,
+                                   timeGrowth);
+    growthFactor = ClampDouble(growthFactor, 1.0 / GrowthRange, GrowthRange);
+
+    if (smooth && part.hasGrowthData) {
+      growthFactor = 0.75 * part.smoothedGrowthFactor + 0.25 * growthFactor;
+    }
+
+    part.hasGrowthData = true;
+    part.smoothedGrowthFactor = growthFactor;
+
+    if (growthFactor <= (1.0 / GoalWidth) || growthFactor >= GoalWidth) {
+      // The multiplication below cannot overflow because growthFactor is at
+      // most two.
+      MOZ_ASSERT(growthFactor <= 2.0);
+      MOZ_ASSERT(part.partitionBytes < SIZE_MAX / 2);
+      part.partitionBytes = size_t(double(part.partitionBytes) * growthFactor);
+      part.partitionBytes =
+          std::max(part.partitionBytes, size_t(SystemPageSize()));
+    }
+
+    // Saturate at the maximum nursery size; the caller clamps the result.
+    partitionTotal = std::min(partitionTotal + part.partitionBytes,
+                              tunables().gcMaxNurseryBytes());
+  }
+
+  return roundSize(partitionTotal);
 }
 
 void js::Nursery::clearRecentGrowthData() {
@@ -1690,7 +1734,10 @@ void js::Nursery::clearRecentGrowthData() {
   }
 
   hasRecentGrowthData = false;
-  smoothedGrowthFactor = 1.0;
+
+  for (AllZonesIter zone(gc); !zone.done(); zone.next()) {
+    zone->nurseryPartition = gc::NurseryPartition();
+  }
 }
 
 /* static */
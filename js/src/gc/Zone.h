@@ -49,6 +49,25 @@ struct UniqueIdGCPolicy {
 using UniqueIdMap = GCHashMap<Cell*, uint64_t, PointerHasher<Cell*>,
                               SystemAllocPolicy, UniqueIdGCPolicy>;
 
+// Per-zone nursery sizing state. During minor GC, bytes promoted out of the
+// nursery are attributed to the zone they belong to, and after collection
+// each zone adapts its own notional partition of the nursery based on that
+// zone's promotion behaviour. The nursery is sized to the sum of the
+// partitions, see Nursery::targetSize.
+struct NurseryPartition {
+  // Bytes promoted out of the nursery from this zone during the current
+  // minor collection. Only the cell sizes are counted; out-of-line slot and
+  // element data is not attributed.
+  size_t tenuredBytes = 0;
+
+  // This zone's adaptive share of the nursery, in bytes.
+  size_t partitionBytes = 0;
+
+  // Exponentially smoothed growth factor for the partition.
+  double smoothedGrowthFactor = 1.0;
+  bool hasGrowthData = false;
+};
+
 extern uint64_t NextCellUniqueId(JSRuntime* rt);
 
 template <typename T>
@@ -239,6 +258,8 @@ class Zone : public js::ZoneAllocator, public js::gc::GraphNodeBase<JS::Zone> {
 
   js::gc::PretenuringZone pretenuring;
 
+  js::gc::NurseryPartition nurseryPartition;
+
  private:
   // Side map for storing unique ids for cells, independent of address.
   js::ZoneOrGCTaskData<js::gc::UniqueIdMap> uniqueIds_;
@@ -29,6 +29,7 @@
 #include "js/friend/ErrorMessages.h"  // JSMSG_*
 #include "js/friend/StackLimits.h"    // js::ReportOverRecursed
 #include "util/StringBuffer.h"
+#include "util/Text.h"
 #include "vm/MatchPairs.h"
 #include "vm/RegExpShared.h"
 
@@ -624,6 +625,20 @@ bool CompilePattern(JSContext* cx, MutableHandleRegExpShared re,
         return false;
       }
     }
+    // If every match must begin with a known literal, record its first code
+    // unit so the interpreter can scan ahead to candidate positions. Patterns
+    // starting with an assertion, disjunction or quantifier don't qualify,
+    // and neither does case-insensitive or sticky matching.
+    if (!flags.ignoreCase() && !flags.sticky()) {
+      v8::internal::RegExpTree* first = data.tree;
+      if (first->IsAlternative() &&
+          first->AsAlternative()->nodes()->length() > 0) {
+        first = first->AsAlternative()->nodes()->at(0);
+      }
+      if (first->IsAtom() && first->AsAtom()->length() > 0) {
+        re->setPrefilterChar(first->AsAtom()->data().begin()[0]);
+      }
+    }
     // All fallible initialization has succeeded, so we can change state.
     // Add one to capture_count to account for the whole-match capture.
     uint32_t pairCount = data.capture_count + 1;
@@ -690,6 +705,36 @@ RegExpRunStatus Interpret(JSContext* cx, MutableHandleRegExpShared re,
                           VectorMatchPairs* matches) {
   MOZ_ASSERT(re->getByteCode(input->hasLatin1Chars()));
 
+  // If every match must begin with a known code unit, scan ahead to the
+  // first candidate position instead of retrying the bytecode at every
+  // position: memchr is vectorized and far faster than the interpreter's
+  // per-position restart. The JIT gets the same effect from its quick
+  // check; this recovers it for cold and non-JIT-eligible regexps.
+  if (re->hasPrefilterChar() && startIndex < input->length()) {
+    char16_t prefilter = re->prefilterChar();
+    JS::AutoAssertNoGC nogc(cx);
+    if (input->hasLatin1Chars()) {
+      if (prefilter > JSString::MAX_LATIN1_CHAR) {
+        return RegExpRunStatus_Success_NotFound;
+      }
+      const JS::Latin1Char* chars = input->latin1Chars(nogc);
+      const void* found = memchr(chars + startIndex, prefilter,
+                                 input->length() - startIndex);
+      if (!found) {
+        return RegExpRunStatus_Success_NotFound;
+      }
+      startIndex = static_cast<const JS::Latin1Char*>(found) - chars;
+    } else {
+      const char16_t* chars = input->twoByteChars(nogc);
+      const char16_t* found = js_strchr_limit(chars + startIndex, prefilter,
+                                              chars + input->length());
+      if (!found) {
+        return RegExpRunStatus_Success_NotFound;
+      }
+      startIndex = found - chars;
+    }
+  }
+
   HandleScope handleScope(cx->isolate);
   V8HandleRegExp wrappedRegExp(v8::internal::JSRegExp(re), cx->isolate);
   V8HandleString wrappedInput(v8::internal::String(input), cx->isolate);
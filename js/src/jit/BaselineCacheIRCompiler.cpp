@@ -1984,10 +1984,9 @@ ICCacheIRStub* js::jit::AttachBaselineCacheIRStub(
       return nullptr;
     }
 
-    // Allocate the shared CacheIRStubInfo. Note that the
-    // putBaselineCacheIRStubCode call below will transfer ownership
-    // to the stub code HashMap, so we don't have to worry about freeing
-    // it below.
+    // Get the shared CacheIRStubInfo. This is interned in a process-wide
+    // cache which retains ownership; the zone's stub code HashMap only holds
+    // a pointer to it.
     MOZ_ASSERT(!stubInfo);
     stubInfo =
         CacheIRStubInfo::New(kind, ICStubEngine::Baseline, comp.makesGCCalls(),
@@ -36,6 +36,8 @@
 #include "js/ScalarType.h"          // js::Scalar::Type
 #include "proxy/DOMProxy.h"
 #include "proxy/Proxy.h"
+#include "threading/LockGuard.h"
+#include "threading/Mutex.h"
 #include "vm/ArgumentsObject.h"
 #include "vm/ArrayBufferObject.h"
 #include "vm/ArrayBufferViewObject.h"
@@ -43,6 +45,7 @@
 #include "vm/FunctionFlags.h"  // js::FunctionFlags
 #include "vm/GeneratorObject.h"
 #include "vm/GetterSetter.h"
+#include "vm/MutexIDs.h"
 #include "vm/Uint8Clamped.h"
 
 #include "builtin/Boolean-inl.h"
@@ -1300,10 +1303,74 @@ CacheIRReader::CacheIRReader(const CacheIRStubInfo* stubInfo)
     : CacheIRReader(stubInfo->code(),
                     stubInfo->code() + stubInfo->codeLength()) {}
 
+// Process-wide cache of CacheIRStubInfo instances, keyed by cache kind,
+// engine and CacheIR opcode sequence.
+//
+// Stub info is immutable plain data with no pointers into the owning zone or
+// runtime, so identical stubs generated in different zones and runtimes (e.g.
+// workers) can share a single instance instead of each zone allocating its
+// own copy. Entries are created once and then read-mostly; they live until
+// JS_ShutDown.
+class StubInfoCache {
+  using Set = HashSet<CacheIRStubKey, CacheIRStubKey, SystemAllocPolicy>;
+
+  Mutex lock_;
+  Set set_;
+
+ public:
+  StubInfoCache() : lock_(mutexid::CacheIRStubInfoCache) {}
+
+  CacheIRStubInfo* lookup(const CacheIRStubKey::Lookup& lookup) {
+    LockGuard<Mutex> guard(lock_);
+    Set::Ptr p = set_.lookup(lookup);
+    return p ? p->stubInfo : nullptr;
+  }
+
+  // Add |stubInfo| to the cache, or free it and return the existing entry if
+  // another thread raced us to add an identical one.
+  CacheIRStubInfo* add(const CacheIRStubKey::Lookup& lookup,
+                       CacheIRStubInfo* stubInfo) {
+    LockGuard<Mutex> guard(lock_);
+    Set::AddPtr p = set_.lookupForAdd(lookup);
+    if (p) {
+      js_free(stubInfo);
+      return p->stubInfo;
+    }
+    CacheIRStubKey key(stubInfo);
+    if (!set_.add(p, std::move(key))) {
+      js_free(stubInfo);
+      return nullptr;
+    }
+    return stubInfo;
+  }
+
+  void clear() {
+    LockGuard<Mutex> guard(lock_);
+    for (Set::Range r = set_.all(); !r.empty(); r.popFront()) {
+      js_free(r.front().stubInfo);
+    }
+    set_.clearAndCompact();
+  }
+};
+
+static StubInfoCache stubInfoCache;
+
+void jit::ShutDownStubInfoCache() { stubInfoCache.clear(); }
+
 CacheIRStubInfo* CacheIRStubInfo::New(CacheKind kind, ICStubEngine engine,
                                       bool makesGCCalls,
                                       uint32_t stubDataOffset,
                                       const CacheIRWriter& writer) {
+  CacheIRStubKey::Lookup lookup(kind, engine, writer.codeStart(),
+                                writer.codeLength());
+  if (CacheIRStubInfo* stubInfo = stubInfoCache.lookup(lookup)) {
+    // These are all functions of the CacheIR code for a given engine, so an
+    // entry generated by another zone must agree with our caller.
+    MOZ_ASSERT(stubInfo->makesGCCalls() == makesGCCalls);
+    MOZ_ASSERT(stubInfo->stubDataOffset() == stubDataOffset);
+    return stubInfo;
+  }
+
   size_t numStubFields = writer.numStubFields();
   size_t bytesNeeded =
       sizeof(CacheIRStubInfo) + writer.codeLength() +
@@ -1327,8 +1394,15 @@ CacheIRStubInfo* CacheIRStubInfo::New(CacheKind kind, ICStubEngine engine,
   }
   fieldTypes[numStubFields] = uint8_t(StubField::Type::Limit);
 
-  return new (p) CacheIRStubInfo(kind, engine, makesGCCalls, stubDataOffset,
-                                 codeStart, writer.codeLength(), fieldTypes);
+  CacheIRStubInfo* stubInfo =
+      new (p) CacheIRStubInfo(kind, engine, makesGCCalls, stubDataOffset,
+                              codeStart, writer.codeLength(), fieldTypes);
+
+  // Intern the new stub info. The cache takes ownership; key the entry by the
+  // copied code so the lookup doesn't depend on the writer's buffer.
+  CacheIRStubKey::Lookup internLookup(kind, engine, stubInfo->code(),
+                                      stubInfo->codeLength());
+  return stubInfoCache.add(internLookup, stubInfo);
 }
 
 bool OperandLocation::operator==(const OperandLocation& other) const {
@@ -1247,6 +1247,10 @@ class CacheIRStubInfo {
     return (StubField::Type)fieldTypes_[i];
   }
 
+  // Return the interned stub info for this CacheIR code, allocating it if
+  // needed. The returned instance is owned by a process-wide cache and is
+  // shared by every zone and runtime that generates identical CacheIR, see
+  // StubInfoCache in CacheIRCompiler.cpp.
   static CacheIRStubInfo* New(CacheKind kind, ICStubEngine engine,
                               bool canMakeCalls, uint32_t stubDataOffset,
                               const CacheIRWriter& writer);
@@ -1275,6 +1279,9 @@ class CacheIRStubInfo {
 template <typename T>
 void TraceCacheIRStub(JSTracer* trc, T* stub, const CacheIRStubInfo* stubInfo);
 
+// Free the process-wide CacheIRStubInfo cache. Called by JS_ShutDown.
+void ShutDownStubInfoCache();
+
 }  // namespace jit
 }  // namespace js
 
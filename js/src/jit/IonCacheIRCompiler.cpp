@@ -1809,10 +1809,9 @@ void IonIC::attachCacheIRStub(JSContext* cx, const CacheIRWriter& writer,
                                 writer.codeLength());
   CacheIRStubInfo* stubInfo = jitZone->getIonCacheIRStubInfo(lookup);
   if (!stubInfo) {
-    // Allocate the shared CacheIRStubInfo. Note that the
-    // putIonCacheIRStubInfo call below will transfer ownership to
-    // the stub info HashSet, so we don't have to worry about freeing
-    // it below.
+    // Get the shared CacheIRStubInfo. This is interned in a process-wide
+    // cache which retains ownership; the zone's stub info HashSet only holds
+    // a pointer to it.
 
     // For Ion ICs, we don't track/use the makesGCCalls flag, so just pass true.
     bool makesGCCalls = true;
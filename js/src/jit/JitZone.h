@@ -63,15 +63,14 @@ struct CacheIRStubKey : public DefaultHasher<CacheIRStubKey> {
   static HashNumber hash(const Lookup& l);
   static bool match(const CacheIRStubKey& entry, const Lookup& l);
 
-  UniquePtr<CacheIRStubInfo, JS::FreePolicy> stubInfo;
+  // The stub info is interned in a process-wide cache which retains ownership,
+  // see CacheIRStubInfo::New.
+  CacheIRStubInfo* stubInfo;
 
   explicit CacheIRStubKey(CacheIRStubInfo* info) : stubInfo(info) {}
-  CacheIRStubKey(CacheIRStubKey&& other)
-      : stubInfo(std::move(other.stubInfo)) {}
+  CacheIRStubKey(CacheIRStubKey&& other) : stubInfo(other.stubInfo) {}
 
-  void operator=(CacheIRStubKey&& other) {
-    stubInfo = std::move(other.stubInfo);
-  }
+  void operator=(CacheIRStubKey&& other) { stubInfo = other.stubInfo; }
 };
 
 struct BaselineCacheIRStubCodeMapGCPolicy {
@@ -123,7 +122,7 @@ class JitZone {
                                       CacheIRStubInfo** stubInfo) {
     auto p = baselineCacheIRStubCodes_.lookup(key);
     if (p) {
-      *stubInfo = p->key().stubInfo.get();
+      *stubInfo = p->key().stubInfo;
       return p->value();
     }
     *stubInfo = nullptr;
@@ -139,7 +138,7 @@ class JitZone {
 
   CacheIRStubInfo* getIonCacheIRStubInfo(const CacheIRStubKey::Lookup& key) {
     IonCacheIRStubInfoSet::Ptr p = ionCacheIRStubInfoSet_.lookup(key);
-    return p ? p->stubInfo.get() : nullptr;
+    return p ? p->stubInfo : nullptr;
   }
   [[nodiscard]] bool putIonCacheIRStubInfo(const CacheIRStubKey::Lookup& lookup,
                                            CacheIRStubKey& key) {
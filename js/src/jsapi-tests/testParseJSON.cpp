@@ -354,3 +354,41 @@ inline bool TryParse(JSContext* cx, const char (&input)[N],
   return true;
 }
 END_TEST(testParseJSON_reviver)
+
+BEGIN_TEST(testParseJSON_eightBit) {
+  JS::RootedValue v(cx);
+
+  // Latin-1 input is parsed in place, without inflation.
+  static const char latin1Input[] = "[1, true, \"f\"]";
+  CHECK(JS_ParseJSON(cx, reinterpret_cast<const JS::Latin1Char*>(latin1Input),
+                     strlen(latin1Input), &v));
+  CHECK(v.isObject());
+
+  bool isArray = false;
+  JS::RootedObject obj(cx, &v.toObject());
+  CHECK(JS::IsArrayObject(cx, obj, &isArray));
+  CHECK(isArray);
+
+  // ASCII-only UTF-8 input takes the same in-place path.
+  static const char asciiInput[] = "{ \"f\": 17 }";
+  CHECK(JS_ParseJSON(cx, JS::UTF8Chars(asciiInput, strlen(asciiInput)), &v));
+  CHECK(v.isObject());
+  obj = &v.toObject();
+
+  JS::RootedValue v2(cx);
+  CHECK(JS_GetProperty(cx, obj, "f", &v2));
+  CHECK(v2.isInt32(17));
+
+  // Non-ASCII UTF-8 input is inflated before parsing. "\xC3\xBC" is U+00FC.
+  static const char utf8Input[] = "\"\xC3\xBC\"";
+  CHECK(JS_ParseJSON(cx, JS::UTF8Chars(utf8Input, strlen(utf8Input)), &v));
+  CHECK(v.isString());
+  CHECK(JS_GetStringLength(v.toString()) == 1);
+
+  char16_t ch;
+  CHECK(JS_GetStringCharAt(cx, v.toString(), 0, &ch));
+  CHECK(ch == 0x00FC);
+
+  return true;
+}
+END_TEST(testParseJSON_eightBit)
@@ -14,6 +14,7 @@
 #include "mozilla/Maybe.h"
 #include "mozilla/PodOperations.h"
 #include "mozilla/Sprintf.h"
+#include "mozilla/TextUtils.h"
 
 #include <algorithm>
 #ifdef __linux__
@@ -4587,11 +4588,50 @@ JS_PUBLIC_API bool JS_ParseJSON(JSContext* cx, const char16_t* chars,
                               NullHandleValue, vp);
 }
 
+JS_PUBLIC_API bool JS_ParseJSON(JSContext* cx, const Latin1Char* chars,
+                                uint32_t len, MutableHandleValue vp) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+  return ParseJSONWithReviver(cx, mozilla::Range<const Latin1Char>(chars, len),
+                              NullHandleValue, vp);
+}
+
 JS_PUBLIC_API bool JS_ParseJSON(JSContext* cx, HandleString str,
                                 MutableHandleValue vp) {
   return JS_ParseJSONWithReviver(cx, str, NullHandleValue, vp);
 }
 
+JS_PUBLIC_API bool JS_ParseJSON(JSContext* cx, const JS::UTF8Chars chars,
+                                MutableHandleValue vp) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+
+  // ASCII is a subset of both UTF-8 and Latin-1, so ASCII-only input -- the
+  // overwhelmingly common case for large machine-generated JSON -- can be
+  // parsed in place without making an inflated copy of it.
+  auto bytes = mozilla::Span(
+      reinterpret_cast<const char*>(chars.begin().get()), chars.length());
+  if (mozilla::IsAscii(bytes)) {
+    return ParseJSONWithReviver(
+        cx,
+        mozilla::Range<const Latin1Char>(
+            reinterpret_cast<const Latin1Char*>(chars.begin().get()),
+            chars.length()),
+        NullHandleValue, vp);
+  }
+
+  size_t length;
+  UniqueTwoByteChars twoByte(
+      UTF8CharsToNewTwoByteCharsZ(cx, chars, &length, js::MallocArena).get());
+  if (!twoByte) {
+    return false;
+  }
+
+  return ParseJSONWithReviver(
+      cx, mozilla::Range<const char16_t>(twoByte.get(), length),
+      NullHandleValue, vp);
+}
+
 JS_PUBLIC_API bool JS_ParseJSONWithReviver(JSContext* cx, const char16_t* chars,
                                            uint32_t len, HandleValue reviver,
                                            MutableHandleValue vp) {
@@ -4601,6 +4641,16 @@ JS_PUBLIC_API bool JS_ParseJSONWithReviver(JSContext* cx, const char16_t* chars,
                               reviver, vp);
 }
 
+JS_PUBLIC_API bool JS_ParseJSONWithReviver(JSContext* cx,
+                                           const Latin1Char* chars,
+                                           uint32_t len, HandleValue reviver,
+                                           MutableHandleValue vp) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+  return ParseJSONWithReviver(cx, mozilla::Range<const Latin1Char>(chars, len),
+                              reviver, vp);
+}
+
 JS_PUBLIC_API bool JS_ParseJSONWithReviver(JSContext* cx, HandleString str,
                                            HandleValue reviver,
                                            MutableHandleValue vp) {
@@ -281,6 +281,11 @@ JS_PUBLIC_API bool js::IsArgumentsObject(HandleObject obj) {
   return obj->is<ArgumentsObject>();
 }
 
+JS_PUBLIC_API bool js::MaybeGetPropertyPure(JSContext* cx, JSObject* obj,
+                                            jsid id, Value* vp) {
+  return GetPropertyPure(cx, obj, id, vp);
+}
+
 JS_PUBLIC_API JS::Zone* js::GetRealmZone(JS::Realm* realm) {
   return realm->zone();
 }
@@ -140,6 +140,16 @@ JS_PUBLIC_API bool AddRawValueRoot(JSContext* cx, JS::Value* vp,
 
 JS_PUBLIC_API void RemoveRawValueRoot(JSContext* cx, JS::Value* vp);
 
+/**
+ * Get obj[id] if doing so has no observable side effects: no getters, proxy
+ * traps or resolve hooks are invoked and no exception can be thrown. On
+ * success the result is stored in *vp. Returns false, without reporting an
+ * error, if the get can't be performed effect-free; callers are expected to
+ * fall back to a regular get such as JS_GetPropertyById.
+ */
+JS_PUBLIC_API bool MaybeGetPropertyPure(JSContext* cx, JSObject* obj, jsid id,
+                                        JS::Value* vp);
+
 }  // namespace js
 
 namespace JS {
@@ -75,6 +75,10 @@ typedef Fifo<CompileTask*, 0, SystemAllocPolicy> CompileTaskPtrFifo;
 struct Tier2GeneratorTask : public HelperThreadTask {
   virtual ~Tier2GeneratorTask() = default;
   virtual void cancel() = 0;
+
+  // Total baseline execution count of the module's functions, used to
+  // generate tier-2 code for the hottest queued module first.
+  virtual uint64_t hotness() const = 0;
 };
 
 using UniqueTier2GeneratorTask = UniquePtr<Tier2GeneratorTask>;
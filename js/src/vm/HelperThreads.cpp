@@ -262,6 +262,9 @@ bool js::StartOffThreadIonCompile(jit::IonCompileTask* task,
   return HelperThreadState().submitTask(task, lock);
 }
 
+static void MaybePreemptIonCompileTask(jit::IonCompileTask* task,
+                                       const AutoLockHelperThreadState& lock);
+
 bool GlobalHelperThreadState::submitTask(
     jit::IonCompileTask* task, const AutoLockHelperThreadState& locked) {
   MOZ_ASSERT(isInitialized(locked));
@@ -274,6 +277,12 @@ bool GlobalHelperThreadState::submitTask(
   // unwanted mutations.
   task->alloc().lifoAlloc()->setReadOnly();
 
+  // If every Ion helper thread is occupied, consider cancelling a running
+  // compilation of clearly lower value so this one need not wait behind it.
+  if (!canStartIonCompileTask(locked)) {
+    MaybePreemptIonCompileTask(task, locked);
+  }
+
   dispatch(locked);
   return true;
 }
@@ -1864,7 +1873,22 @@ HelperThreadTask* GlobalHelperThreadState::maybeGetWasmTier2GeneratorTask(
     return nullptr;
   }
 
-  return wasmTier2GeneratorWorklist(lock).popCopy();
+  // Pick the task whose module has executed the most baseline code so far so
+  // that the hottest module tiers up first. Queued tasks accumulate hotness
+  // while they wait.
+  auto& worklist = wasmTier2GeneratorWorklist(lock);
+  size_t best = 0;
+  uint64_t bestHotness = worklist[0]->hotness();
+  for (size_t i = 1; i < worklist.length(); i++) {
+    uint64_t hotness = worklist[i]->hotness();
+    if (hotness > bestHotness) {
+      best = i;
+      bestHotness = hotness;
+    }
+  }
+
+  std::swap(worklist[best], worklist.back());
+  return worklist.popCopy();
 }
 
 bool GlobalHelperThreadState::canStartWasmTier2GeneratorTask(
@@ -1894,18 +1918,51 @@ bool GlobalHelperThreadState::canStartPromiseHelperTask(
                               /*isMaster=*/true, lock);
 }
 
+static double IonCompileTaskPriority(jit::IonCompileTask* task) {
+  // The priority of a compilation estimates the value of the code it will
+  // produce: how warm the script has run, discounted by how much bytecode has
+  // to be compiled. The inputs are allowed to race (change on the fly).
+  jit::JitScript* jitScript = task->script()->jitScript();
+  return double(jitScript->warmUpCount()) / double(task->script()->length());
+}
+
 static bool IonCompileTaskHasHigherPriority(jit::IonCompileTask* first,
                                             jit::IonCompileTask* second) {
   // Return true if priority(first) > priority(second).
   //
   // This method can return whatever it wants, though it really ought to be a
   // total order. The ordering is allowed to race (change on the fly), however.
+  return IonCompileTaskPriority(first) > IonCompileTaskPriority(second);
+}
+
+// A newly submitted compilation only preempts a running one when it is worth
+// at least this many times as much, so that compilations of comparable value
+// do not continually cancel each other.
+static const double IonPreemptionPriorityFactor = 4.0;
+
+static void MaybePreemptIonCompileTask(jit::IonCompileTask* task,
+                                       const AutoLockHelperThreadState& lock) {
+  // All Ion helper threads are busy. Find the least valuable compilation in
+  // progress; if |task| is worth several times more, cancel the running
+  // compilation rather than queueing behind it. The cancelled task is
+  // discarded when it reaches the finished list, and the script's warm-up
+  // counter will resubmit it if it is still worth compiling.
+  jit::IonCompileTask* victim = nullptr;
+  for (auto* helper : HelperThreadState().helperTasks(lock)) {
+    if (!helper->is<jit::IonCompileTask>()) {
+      continue;
+    }
+    jit::IonCompileTask* running = helper->as<jit::IonCompileTask>();
+    if (!victim || IonCompileTaskHasHigherPriority(victim, running)) {
+      victim = running;
+    }
+  }
 
-  // A higher warm-up counter indicates a higher priority.
-  jit::JitScript* firstJitScript = first->script()->jitScript();
-  jit::JitScript* secondJitScript = second->script()->jitScript();
-  return firstJitScript->warmUpCount() / first->script()->length() >
-         secondJitScript->warmUpCount() / second->script()->length();
+  if (victim &&
+      IonCompileTaskPriority(task) >
+          IonPreemptionPriorityFactor * IonCompileTaskPriority(victim)) {
+    victim->mirGen().cancel();
+  }
 }
 
 HelperThreadTask* GlobalHelperThreadState::maybeGetIonCompileTask(
@@ -18,6 +18,7 @@
 #include "ds/MemoryProtectionExceptionHandler.h"
 #include "gc/Statistics.h"
 #include "jit/AtomicOperations.h"
+#include "jit/CacheIRCompiler.h"
 #include "jit/ExecutableAllocator.h"
 #include "jit/Ion.h"
 #include "jit/JitCommon.h"
@@ -336,6 +337,8 @@ JS_PUBLIC_API void JS_ShutDown(void) {
 
   js::jit::AtomicOperations::ShutDown();
 
+  js::jit::ShutDownStubInfoCache();
+
 #ifdef JS_TRACE_LOGGING
   js::DestroyTraceLoggerThreadState();
   js::DestroyTraceLoggerGraphState();
@@ -1103,33 +1103,18 @@ class AutoAssertNoPendingException {
 #endif
 };
 
+// Guard access to the process-wide script data table. The table is shared
+// across runtimes, so the lock must be taken unconditionally; another
+// runtime's thread may touch the table even when this runtime has no parse
+// tasks.
 class MOZ_RAII AutoLockScriptData {
-  JSRuntime* runtime;
-
  public:
   explicit AutoLockScriptData(JSRuntime* rt) {
     MOZ_ASSERT(CurrentThreadCanAccessRuntime(rt) ||
                CurrentThreadIsParseThread());
-    runtime = rt;
-    if (runtime->hasParseTasks()) {
-      runtime->scriptDataLock.lock();
-    } else {
-      MOZ_ASSERT(!runtime->activeThreadHasScriptDataAccess);
-#ifdef DEBUG
-      runtime->activeThreadHasScriptDataAccess = true;
-#endif
-    }
-  }
-  ~AutoLockScriptData() {
-    if (runtime->hasParseTasks()) {
-      runtime->scriptDataLock.unlock();
-    } else {
-      MOZ_ASSERT(runtime->activeThreadHasScriptDataAccess);
-#ifdef DEBUG
-      runtime->activeThreadHasScriptDataAccess = false;
-#endif
-    }
+    JSRuntime::scriptDataLock.lock();
   }
+  ~AutoLockScriptData() { JSRuntime::scriptDataLock.unlock(); }
 };
 
 // A token used to prove you can safely access the atoms zone. This zone is
@@ -3587,8 +3587,11 @@ void JSScript::relazify(JSRuntime* rt) {
 }
 
 // Takes ownership of the passed SharedImmutableScriptData and either adds it
-// into the runtime's SharedImmutableScriptDataTable, or frees it if a matching
-// entry already exists and replaces the passed RefPtr with the existing entry.
+// into the process-wide SharedImmutableScriptDataTable, or frees it if a
+// matching entry already exists and replaces the passed RefPtr with the
+// existing entry. The table is shared by all runtimes in the process, so a
+// script decoded or compiled in one runtime can reuse bytecode created by
+// another, e.g. by a worker runtime.
 /* static */
 bool SharedImmutableScriptData::shareScriptData(
     JSContext* cx, RefPtr<SharedImmutableScriptData>& sisd) {
@@ -3626,7 +3629,10 @@ bool SharedImmutableScriptData::shareScriptData(
 
 void js::SweepScriptData(JSRuntime* rt) {
   // Entries are removed from the table when their reference count is one,
-  // i.e. when the only reference to them is from the table entry.
+  // i.e. when the only reference to them is from the table entry. The table
+  // is process-wide, so a sweep triggered by one runtime's GC may also
+  // remove entries that were created by other runtimes; this is safe because
+  // any entry still in use is kept alive by its reference count.
 
   AutoLockScriptData lock(rt);
   SharedImmutableScriptDataTable& table = rt->scriptDataTable(lock);
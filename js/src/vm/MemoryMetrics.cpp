@@ -804,6 +804,31 @@ JS_PUBLIC_API size_t JS::UserRealmCount(JSContext* cx) {
   return n;
 }
 
+JS_PUBLIC_API void JS::CompartmentAndRealmCounts(JSContext* cx,
+                                                 size_t* systemCompartments,
+                                                 size_t* userCompartments,
+                                                 size_t* systemRealms,
+                                                 size_t* userRealms) {
+  *systemCompartments = 0;
+  *userCompartments = 0;
+  *systemRealms = 0;
+  *userRealms = 0;
+  for (CompartmentsIter comp(cx->runtime()); !comp.done(); comp.next()) {
+    if (IsSystemCompartment(comp)) {
+      ++*systemCompartments;
+    } else {
+      ++*userCompartments;
+    }
+  }
+  for (RealmsIter realm(cx->runtime()); !realm.done(); realm.next()) {
+    if (realm->isSystem()) {
+      ++*systemRealms;
+    } else {
+      ++*userRealms;
+    }
+  }
+}
+
 JS_PUBLIC_API size_t JS::PeakSizeOfTemporary(const JSContext* cx) {
   return cx->tempLifoAlloc().peakSizeOfExcludingThis();
 }
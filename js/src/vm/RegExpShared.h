@@ -123,6 +123,13 @@ class RegExpShared
   uint32_t maxRegisters_ = 0;
   uint32_t ticks_ = 0;
 
+  // When the pattern must begin with a known code unit (it starts with a
+  // literal atom), that unit is recorded here and the interpreter scans
+  // ahead to candidate match positions instead of retrying the bytecode at
+  // every position. See irregexp::Interpret.
+  char16_t prefilterChar_ = 0;
+  bool hasPrefilterChar_ = false;
+
   uint32_t numNamedCaptures_ = {};
   uint32_t* namedCaptureIndices_ = {};
   GCPtr<PlainObject*> groupsTemplate_ = {};
@@ -200,6 +207,16 @@ class RegExpShared
     maxRegisters_ = std::max(maxRegisters_, numRegisters);
   }
 
+  void setPrefilterChar(char16_t c) {
+    prefilterChar_ = c;
+    hasPrefilterChar_ = true;
+  }
+  bool hasPrefilterChar() const { return hasPrefilterChar_; }
+  char16_t prefilterChar() const {
+    MOZ_ASSERT(hasPrefilterChar_);
+    return prefilterChar_;
+  }
+
   uint32_t numNamedCaptures() const { return numNamedCaptures_; }
   int32_t getNamedCaptureIndex(uint32_t idx) const {
     MOZ_ASSERT(idx < numNamedCaptures());
@@ -63,6 +63,11 @@ using mozilla::PositiveInfinity;
 /* static */ MOZ_THREAD_LOCAL(JSContext*) js::TlsContext;
 /* static */
 Atomic<size_t> JSRuntime::liveRuntimesCount;
+/* static */
+js::Mutex JSRuntime::scriptDataLock(mutexid::SharedImmutableScriptData);
+/* static */
+js::ScriptDataLockData<js::SharedImmutableScriptDataTable>
+    JSRuntime::scriptDataTable_;
 Atomic<JS::LargeAllocationFailureCallback> js::OnLargeAllocationFailure;
 
 JS::FilenameValidationCallback js::gFilenameValidationCallback = nullptr;
@@ -115,10 +120,6 @@ JSRuntime::JSRuntime(JSRuntime* parentRuntime)
       scriptEnvironmentPreparer(nullptr),
       ctypesActivityCallback(nullptr),
       windowProxyClass_(nullptr),
-      scriptDataLock(mutexid::SharedImmutableScriptData),
-#ifdef DEBUG
-      activeThreadHasScriptDataAccess(false),
-#endif
       numParseTasks(0),
       numActiveHelperThreadZones(0),
       numRealms(0),
@@ -295,7 +296,10 @@ void JSRuntime::destroyRuntime() {
   MOZ_ASSERT(!hasHelperThreadZones());
 
 #ifdef DEBUG
-  {
+  if (liveRuntimesCount == 1) {
+    // The script data table is shared by all runtimes in the process, so
+    // other runtimes may still have scripts keeping entries alive. Once we
+    // are the last runtime, the final GC above must have swept everything.
     AutoLockScriptData lock(this);
     MOZ_ASSERT(scriptDataTable(lock).empty());
   }
@@ -390,7 +394,10 @@ void JSRuntime::addSizeOfIncludingThis(mozilla::MallocSizeOf mallocSizeOf,
       sharedIntlData.ref().sizeOfExcludingThis(mallocSizeOf);
 #endif
 
-  {
+  if (!parentRuntime) {
+    // The script data table is shared by all runtimes in the process.
+    // Report it against the main runtime only, so worker runtimes don't
+    // count it again.
     AutoLockScriptData lock(this);
     rtSizes->scriptData +=
         scriptDataTable(lock).shallowSizeOfExcludingThis(mallocSizeOf);
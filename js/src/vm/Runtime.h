@@ -523,20 +523,14 @@ struct JSRuntime {
 
  private:
   /*
-   * Lock used to protect the script data table, which can be used by
-   * off-thread parsing.
-   *
-   * Locking this only occurs if there is actually a thread other than the
-   * main thread which could access this.
+   * Lock used to protect the script data table. The table is shared by all
+   * runtimes in the process, so the lock must always be taken, even when
+   * only one thread in this runtime could access the table.
    */
-  js::Mutex scriptDataLock;
-#ifdef DEBUG
-  bool activeThreadHasScriptDataAccess;
-#endif
+  static js::Mutex scriptDataLock;
 
   // Number of off-thread ParseTasks that are using this runtime. This is only
-  // updated on main-thread. If this is non-zero we must use `scriptDataLock` to
-  // protect access to the bytecode table;
+  // updated on main-thread.
   mozilla::Atomic<size_t, mozilla::SequentiallyConsistent> numParseTasks;
 
   // Number of zones which may be operated on by helper threads.
@@ -557,12 +551,6 @@ struct JSRuntime {
 
 #ifdef DEBUG
   void assertCurrentThreadHasScriptDataAccess() const {
-    if (!hasParseTasks()) {
-      MOZ_ASSERT(js::CurrentThreadCanAccessRuntime(this) &&
-                 activeThreadHasScriptDataAccess);
-      return;
-    }
-
     scriptDataLock.assertOwnedByCurrentThread();
   }
 
@@ -866,10 +854,13 @@ struct JSRuntime {
 #endif
 
   // Table of bytecode and other data that may be shared across scripts
-  // within the runtime. This may be modified by threads using
-  // AutoLockScriptData.
+  // within the process. The table is shared by all runtimes in the process
+  // (including worker runtimes), so identical bytecode, e.g. the same
+  // framework scripts loaded by several workers, is stored only once per
+  // process. This may be modified by threads using AutoLockScriptData.
  private:
-  js::ScriptDataLockData<js::SharedImmutableScriptDataTable> scriptDataTable_;
+  static js::ScriptDataLockData<js::SharedImmutableScriptDataTable>
+      scriptDataTable_;
 
  public:
   js::SharedImmutableScriptDataTable& scriptDataTable(
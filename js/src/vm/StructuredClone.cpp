@@ -28,6 +28,7 @@
 
 #include "js/StructuredClone.h"
 
+#include "mozilla/Atomics.h"
 #include "mozilla/Casting.h"
 #include "mozilla/CheckedInt.h"
 #include "mozilla/EndianUtils.h"
@@ -135,6 +136,10 @@ enum StructuredDataType : uint32_t {
   SCTAG_TYPED_ARRAY_OBJECT,
   SCTAG_DATA_VIEW_OBJECT,
 
+  // A large ArrayBuffer stored out-of-line as a refcounted snapshot; only
+  // valid within the SameProcess scope. See writeArrayBuffer.
+  SCTAG_ARRAY_BUFFER_SNAPSHOT_OBJECT,
+
   SCTAG_TYPED_ARRAY_V1_MIN = 0xFFFF0100,
   SCTAG_TYPED_ARRAY_V1_INT8 = SCTAG_TYPED_ARRAY_V1_MIN + Scalar::Int8,
   SCTAG_TYPED_ARRAY_V1_UINT8 = SCTAG_TYPED_ARRAY_V1_MIN + Scalar::Uint8,
@@ -301,6 +306,74 @@ void SharedArrayRawBufferRefs::releaseAll() {
   refs_.clear();
 }
 
+// An immutable copy of a large ArrayBuffer's contents, stored in a single
+// allocation outside the clone stream and shared by reference. Snapshots are
+// created by writeArrayBuffer when a large buffer is cloned within the
+// SameProcess scope; the stream then carries only a pointer, which avoids
+// chopping multi-megabyte payloads into clone-buffer segments on both the
+// write and read sides. Snapshots are never mutated after creation, so a
+// clone buffer pointing at one may be read any number of times.
+struct js::ArrayBufferSnapshot {
+  mozilla::Atomic<size_t> refCount_;
+  size_t byteLength;
+
+  // The buffer contents follow the header in the same allocation.
+  uint8_t* data() { return reinterpret_cast<uint8_t*>(this + 1); }
+
+  static ArrayBufferSnapshot* create(const void* contents, size_t nbytes) {
+    void* p = js_malloc(sizeof(ArrayBufferSnapshot) + nbytes);
+    if (!p) {
+      return nullptr;
+    }
+    auto* snapshot = new (p) ArrayBufferSnapshot();
+    snapshot->refCount_ = 1;
+    snapshot->byteLength = nbytes;
+    memcpy(snapshot->data(), contents, nbytes);
+    return snapshot;
+  }
+
+  void addReference() { refCount_++; }
+  void dropReference() {
+    if (--refCount_ == 0) {
+      js_free(this);
+    }
+  }
+};
+
+// Clones of ArrayBuffers at least this large use an out-of-line snapshot
+// when the clone cannot leave the process.
+static const size_t MinArrayBufferSnapshotBytes = 1024 * 1024;
+
+ArrayBufferSnapshotRefs& ArrayBufferSnapshotRefs::operator=(
+    ArrayBufferSnapshotRefs&& other) {
+  takeOwnership(std::move(other));
+  return *this;
+}
+
+ArrayBufferSnapshotRefs::~ArrayBufferSnapshotRefs() { releaseAll(); }
+
+bool ArrayBufferSnapshotRefs::adopt(JSContext* cx,
+                                    ArrayBufferSnapshot* snapshot) {
+  if (!refs_.append(snapshot)) {
+    snapshot->dropReference();
+    ReportOutOfMemory(cx);
+    return false;
+  }
+  return true;
+}
+
+void ArrayBufferSnapshotRefs::takeOwnership(ArrayBufferSnapshotRefs&& other) {
+  MOZ_ASSERT(refs_.empty());
+  refs_ = std::move(other.refs_);
+}
+
+void ArrayBufferSnapshotRefs::releaseAll() {
+  for (auto ref : refs_) {
+    ref->dropReference();
+  }
+  refs_.clear();
+}
+
 // SCOutput provides an interface to write raw data -- eg uint64_ts, doubles,
 // arrays of bytes -- into a structured clone data output stream. It also knows
 // how to free any transferable data within that stream.
@@ -434,6 +507,7 @@ struct JSStructuredCloneReader {
   [[nodiscard]] bool readDataView(uint64_t byteLength, MutableHandleValue vp);
   [[nodiscard]] bool readArrayBuffer(StructuredDataType type, uint32_t data,
                                      MutableHandleValue vp);
+  [[nodiscard]] bool readArrayBufferSnapshot(MutableHandleValue vp);
   [[nodiscard]] bool readSharedArrayBuffer(MutableHandleValue vp);
   [[nodiscard]] bool readSharedWasmMemory(uint32_t nbytes,
                                           MutableHandleValue vp);
@@ -1332,11 +1406,38 @@ bool JSStructuredCloneWriter::writeArrayBuffer(HandleObject obj) {
                                     obj->maybeUnwrapAs<ArrayBufferObject>());
   JSAutoRealm ar(context(), buffer);
 
+  uint64_t byteLength = buffer->byteLength();
+
+  // Large buffers are copied once into an out-of-line snapshot rather than
+  // being chopped into clone-buffer segments, provided the clone cannot leave
+  // the process. The stream then carries only a pointer; the snapshot is kept
+  // alive by the clone data and each read copies out of it, so the data may
+  // still be read any number of times. Unlike the SharedArrayBuffer case we
+  // must not force the scope here: if the destination may be another process,
+  // fall through to the inline copy instead.
+  if (byteLength >= MinArrayBufferSnapshotBytes &&
+      output().scope() == JS::StructuredCloneScope::SameProcess) {
+    ArrayBufferSnapshot* snapshot =
+        ArrayBufferSnapshot::create(buffer->dataPointer(), byteLength);
+    if (!snapshot) {
+      ReportOutOfMemory(context());
+      return false;
+    }
+    if (!out.buf.snapshotsHeld_.adopt(context(), snapshot)) {
+      return false;
+    }
+
+    intptr_t p = reinterpret_cast<intptr_t>(snapshot);
+    return out.writePair(SCTAG_ARRAY_BUFFER_SNAPSHOT_OBJECT,
+                         static_cast<uint32_t>(sizeof(p))) &&
+           out.writeBytes(&byteLength, sizeof(byteLength)) &&
+           out.writeBytes(&p, sizeof(p));
+  }
+
   if (!out.writePair(SCTAG_ARRAY_BUFFER_OBJECT, 0)) {
     return false;
   }
 
-  uint64_t byteLength = buffer->byteLength();
   if (!out.write(byteLength)) {
     return false;
   }
@@ -2396,6 +2497,42 @@ bool JSStructuredCloneReader::readArrayBuffer(StructuredDataType type,
   return in.readArray(buffer.dataPointer(), nbytes);
 }
 
+bool JSStructuredCloneReader::readArrayBufferSnapshot(MutableHandleValue vp) {
+  uint64_t byteLength;
+  if (!in.readBytes(&byteLength, sizeof(byteLength))) {
+    return in.reportTruncated();
+  }
+
+  // The maximum ArrayBuffer size depends on the platform and prefs, and we
+  // cast to size_t below, so we have to check this here.
+  if (byteLength > ArrayBufferObject::maxBufferByteLength()) {
+    JS_ReportErrorNumberASCII(context(), GetErrorMessage, nullptr,
+                              JSMSG_BAD_ARRAY_LENGTH);
+    return false;
+  }
+
+  intptr_t p;
+  if (!in.readBytes(&p, sizeof(p))) {
+    return in.reportTruncated();
+  }
+
+  ArrayBufferSnapshot* snapshot = reinterpret_cast<ArrayBufferSnapshot*>(p);
+  MOZ_RELEASE_ASSERT(snapshot->byteLength == byteLength);
+
+  // The snapshot is immutable and is kept alive by the clone data we are
+  // reading from, so copying out of it without taking a reference is safe.
+  JSObject* obj =
+      ArrayBufferObject::createZeroed(context(), size_t(byteLength));
+  if (!obj) {
+    return false;
+  }
+  ArrayBufferObject& buffer = obj->as<ArrayBufferObject>();
+  memcpy(buffer.dataPointer(), snapshot->data(), size_t(byteLength));
+
+  vp.setObject(*obj);
+  return true;
+}
+
 bool JSStructuredCloneReader::readSharedArrayBuffer(MutableHandleValue vp) {
   if (!cloneDataPolicy.areIntraClusterClonableSharedObjectsAllowed() ||
       !cloneDataPolicy.areSharedMemoryObjectsAllowed()) {
@@ -2743,6 +2880,12 @@ bool JSStructuredCloneReader::startRead(MutableHandleValue vp,
       }
       break;
 
+    case SCTAG_ARRAY_BUFFER_SNAPSHOT_OBJECT:
+      if (!readArrayBufferSnapshot(vp)) {
+        return false;
+      }
+      break;
+
     case SCTAG_SHARED_ARRAY_BUFFER_OBJECT:
       if (!readSharedArrayBuffer(vp)) {
         return false;
@@ -2990,13 +3133,18 @@ bool JSStructuredCloneReader::readTransferMap() {
       if (!in.readPair(&tag, &data)) {
         return false;
       }
-      if (tag != SCTAG_ARRAY_BUFFER_OBJECT_V2 &&
-          tag != SCTAG_ARRAY_BUFFER_OBJECT) {
-        ReportDataCloneError(cx, callbacks, JS_SCERR_TRANSFERABLE, closure);
-        return false;
-      }
       RootedValue val(cx);
-      if (!readArrayBuffer(StructuredDataType(tag), data, &val)) {
+      if (tag == SCTAG_ARRAY_BUFFER_SNAPSHOT_OBJECT) {
+        if (!readArrayBufferSnapshot(&val)) {
+          return false;
+        }
+      } else if (tag == SCTAG_ARRAY_BUFFER_OBJECT_V2 ||
+                 tag == SCTAG_ARRAY_BUFFER_OBJECT) {
+        if (!readArrayBuffer(StructuredDataType(tag), data, &val)) {
+          return false;
+        }
+      } else {
+        ReportDataCloneError(cx, callbacks, JS_SCERR_TRANSFERABLE, closure);
         return false;
       }
       obj = &val.toObject();
@@ -3507,6 +3655,7 @@ void JSAutoStructuredCloneBuffer::clear() {
   data_.discardTransferables();
   data_.ownTransferables_ = OwnTransferablePolicy::NoTransferables;
   data_.refsHeld_.releaseAll();
+  data_.snapshotsHeld_.releaseAll();
   data_.Clear();
   version_ = 0;
 }
@@ -5616,6 +5616,18 @@ class BaseCompiler final : public BaseCompilerInterface {
       // flag (hasCachedReturnJSValue or hasSpilledRefRegisterResult) is set.
     }
 
+    // When tiering, bump this function's hotness counter so the tier-2
+    // scheduler can prioritize the hottest code. The increment is racy,
+    // which is fine for a profiling counter. ABINonArgReg0 is free here:
+    // arguments have not been moved off their registers yet, but it is not
+    // an argument register and it is used as a scratch below anyway.
+    if (compilerEnv_.mode() == CompileMode::Tier1) {
+      masm.loadPtr(Address(WasmTlsReg, offsetof(TlsData, hotnessCounters)),
+                   ABINonArgReg0);
+      masm.add32(Imm32(1),
+                 Address(ABINonArgReg0, func_.index * sizeof(uint32_t)));
+    }
+
     // Generate a stack-overflow check and its associated stackmap.
 
     fr.checkStack(ABINonArgReg0, BytecodeOffset(func_.lineOrBytecode));
@@ -1200,10 +1200,30 @@ bool Code::initialize(const LinkData& linkData) {
     return false;
   }
 
+  // When tiering, allocate the per-function hotness counters bumped by
+  // baseline function prologues.
+  if (jumpTables_.tiering()) {
+    funcHotnessCounters_.reset(
+        js_pod_calloc<uint32_t>(jumpTables_.numFuncs()));
+    if (!funcHotnessCounters_) {
+      return false;
+    }
+  }
+
   MOZ_ASSERT(initialized());
   return true;
 }
 
+uint64_t Code::totalHotness() const {
+  uint64_t total = 0;
+  if (funcHotnessCounters_) {
+    for (size_t i = 0; i < jumpTables_.numFuncs(); i++) {
+      total += funcHotnessCounters_[i];
+    }
+  }
+  return total;
+}
+
 bool Code::setTier2(UniqueCodeTier tier2, const LinkData& linkData) const {
   MOZ_RELEASE_ASSERT(!hasTier2());
   MOZ_RELEASE_ASSERT(tier2->tier() == Tier::Optimized &&
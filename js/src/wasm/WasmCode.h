@@ -688,6 +688,8 @@ class JumpTables {
   }
   void** tiering() const { return tiering_.get(); }
 
+  size_t numFuncs() const { return numFuncs_; }
+
   size_t sizeOfMiscExcludingThis() const {
     // 2 words per function for the jit entry table, plus maybe 1 per
     // function if we're tiering.
@@ -711,6 +713,13 @@ class Code : public ShareableBase<Code> {
   ExclusiveData<CacheableCharsVector> profilingLabels_;
   JumpTables jumpTables_;
 
+  // Per-function execution counters, with one entry per function (including
+  // imports, whose entries are unused), allocated only when compiling with
+  // tiering. Baseline function prologues bump them racily through
+  // TlsData::hotnessCounters; the helper thread scheduler reads them to
+  // generate tier-2 code for the hottest module first.
+  mozilla::UniquePtr<uint32_t[], JS::FreePolicy> funcHotnessCounters_;
+
  public:
   Code(UniqueCodeTier tier1, const Metadata& metadata,
        JumpTables&& maybeJumpTables);
@@ -723,6 +732,12 @@ class Code : public ShareableBase<Code> {
   }
   void** tieringJumpTable() const { return jumpTables_.tiering(); }
 
+  uint32_t* funcHotnessCounters() const { return funcHotnessCounters_.get(); }
+
+  // Sum of the per-function hotness counters, or zero if this Code was not
+  // compiled with tiering.
+  uint64_t totalHotness() const;
+
   void setJitEntry(size_t i, void* target) const {
     jumpTables_.setJitEntry(i, target);
   }
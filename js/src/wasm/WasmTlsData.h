@@ -101,6 +101,11 @@ struct TlsData {
   // baseline-compiled function.
   void** jumpTable;
 
+  // When compiling with tiering, points to the module's per-function hotness
+  // counters, which baseline function prologues bump to drive tier-2
+  // prioritization. See Code::funcHotnessCounters.
+  uint32_t* hotnessCounters;
+
   // The globalArea must be the last field.  Globals for the module start here
   // and are inline in this structure.  16-byte alignment is required for SIMD
   // data.
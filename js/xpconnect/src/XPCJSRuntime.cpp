@@ -1265,6 +1265,19 @@ static int64_t JSMainRuntimeRealmsUserDistinguishedAmount() {
   return JS::UserRealmCount(cx);
 }
 
+static void JSMainRuntimeCompartmentsRealmsDistinguishedAmounts(
+    int64_t* aSystemCompartments, int64_t* aUserCompartments,
+    int64_t* aSystemRealms, int64_t* aUserRealms) {
+  JSContext* cx = danger::GetJSContext();
+  size_t systemCompartments, userCompartments, systemRealms, userRealms;
+  JS::CompartmentAndRealmCounts(cx, &systemCompartments, &userCompartments,
+                                &systemRealms, &userRealms);
+  *aSystemCompartments = systemCompartments;
+  *aUserCompartments = userCompartments;
+  *aSystemRealms = systemRealms;
+  *aUserRealms = userRealms;
+}
+
 class JSMainRuntimeTemporaryPeakReporter final : public nsIMemoryReporter {
   ~JSMainRuntimeTemporaryPeakReporter() = default;
 
@@ -3045,6 +3058,8 @@ void XPCJSRuntime::Initialize(JSContext* cx) {
       JSMainRuntimeRealmsSystemDistinguishedAmount);
   RegisterJSMainRuntimeRealmsUserDistinguishedAmount(
       JSMainRuntimeRealmsUserDistinguishedAmount);
+  RegisterJSMainRuntimeCompartmentsRealmsDistinguishedAmounts(
+      JSMainRuntimeCompartmentsRealmsDistinguishedAmounts);
   mozilla::RegisterJSSizeOfTab(JSSizeOfTab);
 
   // Set the callback for reporting memory to ubi::Node.
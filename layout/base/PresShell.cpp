@@ -1859,6 +1859,10 @@ nsresult PresShell::Initialize() {
 
   mDidInitialize = true;
 
+  if (nsDOMNavigationTiming* timing = mDocument->GetNavigationTiming()) {
+    timing->NotifyInitialFrameConstruction();
+  }
+
 #ifdef DEBUG
   if (VerifyReflowFlags::NoisyCommands & gVerifyReflowFlags) {
     if (mDocument) {
@@ -9425,6 +9429,7 @@ void PresShell::WillDoReflow() {
 }
 
 void PresShell::DidDoReflow(bool aInterruptible) {
+  IncrementGeometryGeneration();
   HandlePostedReflowCallbacks(aInterruptible);
   if (mIsDestroying) {
     return;
@@ -895,6 +895,15 @@ class PresShell final : public nsStubDocumentObserver,
   uint64_t GetPaintCount() { return mPaintCount; }
   void IncrementPaintCount() { ++mPaintCount; }
 
+  /**
+   * A counter that's bumped whenever frame geometry in this pres shell may
+   * have changed: after every reflow and every scroll position update.
+   * Consumers of cached geometry (e.g. intersection observers) combine this
+   * with the restyle generation to tell whether their results may be stale.
+   */
+  uint64_t GetGeometryGeneration() const { return mGeometryGeneration; }
+  void IncrementGeometryGeneration() { ++mGeometryGeneration; }
+
   /**
    * Get the root DOM window of this presShell.
    */
@@ -2972,6 +2981,10 @@ class PresShell final : public nsStubDocumentObserver,
   // Count of the number of times this presshell has been painted to a window.
   uint64_t mPaintCount;
 
+  // Bumped whenever frame geometry may have changed; see
+  // GetGeometryGeneration().
+  uint64_t mGeometryGeneration = 0;
+
   // The focus sequence number of the last processed input event
   uint64_t mAPZFocusSequenceNumber;
 
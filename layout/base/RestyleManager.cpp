@@ -3290,6 +3290,20 @@ void RestyleManager::TakeSnapshotForAttributeChange(Element& aElement,
     return;
   }
 
+  // If we already have a snapshot recording a change to this attribute since
+  // the last restyle flush, there's nothing new to capture: the snapshot
+  // holds the values from before the first change, and the style set's
+  // dependency map would just repeat the answer it already gave us. This
+  // keeps repeated toggles of a single class or attribute down to one
+  // dependency lookup per flush.
+  if (aElement.HasFlag(ELEMENT_HAS_SNAPSHOT)) {
+    if (const ServoElementSnapshot* snapshot = mSnapshots.Get(&aElement)) {
+      if (snapshot->HasAttrChanged(aNameSpaceID, aAttribute)) {
+        return;
+      }
+    }
+  }
+
   bool influencesOtherPseudoClassState;
   if (!NeedToRecordAttrChange(*StyleSet(), aElement, aNameSpaceID, aAttribute,
                               &influencesOtherPseudoClassState)) {
@@ -5091,7 +5091,12 @@ void nsCSSFrameConstructor::AddPageBreakItem(
 bool nsCSSFrameConstructor::ShouldCreateItemsForChild(
     nsFrameConstructorState& aState, nsIContent* aContent,
     nsContainerFrame* aParentFrame) {
-  aContent->UnsetFlags(NODE_DESCENDANTS_NEED_FRAMES | NODE_NEEDS_FRAME);
+  // Only clear the lazy bits if some are actually set: this runs for every
+  // child of every processed container, and the unconditional write was
+  // dirtying a cache line per node on wide DOMs.
+  if (aContent->HasFlag(NODE_DESCENDANTS_NEED_FRAMES | NODE_NEEDS_FRAME)) {
+    aContent->UnsetFlags(NODE_DESCENDANTS_NEED_FRAMES | NODE_NEEDS_FRAME);
+  }
   // XXX the GetContent() != aContent check is needed due to bug 135040.
   // Remove it once that's fixed.
   if (aContent->GetPrimaryFrame() &&
@@ -2356,9 +2356,19 @@ bool nsPresContext::CheckForInterrupt(nsIFrame* aFrame) {
 
   // Don't interrupt if it's been less than sInterruptTimeout since we started
   // the reflow.
+  const TimeDuration elapsed = TimeStamp::Now() - mReflowStartTime;
   mHasPendingInterrupt =
-      TimeStamp::Now() - mReflowStartTime > sInterruptTimeout &&
-      HavePendingInputEvent() && !IsChrome();
+      elapsed > sInterruptTimeout && HavePendingInputEvent() && !IsChrome();
+
+  // Even with no input pending, yield once the reflow has used up the
+  // configured frame budget, so huge documents are reflowed in slices across
+  // refresh ticks instead of blocking until completion.
+  const uint32_t budgetMs =
+      StaticPrefs::layout_interruptible_reflow_budget_ms();
+  if (!mHasPendingInterrupt && budgetMs && !IsChrome() &&
+      elapsed.ToMilliseconds() > budgetMs) {
+    mHasPendingInterrupt = true;
+  }
 
   if (mPendingInterruptFromTest) {
     mPendingInterruptFromTest = false;
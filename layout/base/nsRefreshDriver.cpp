@@ -35,6 +35,7 @@
 #include "mozilla/CycleCollectedJSContext.h"
 #include "mozilla/DebugOnly.h"
 #include "mozilla/DisplayPortUtils.h"
+#include "mozilla/HashFunctions.h"
 #include "mozilla/InputTaskManager.h"
 #include "mozilla/IntegerRange.h"
 #include "mozilla/PresShell.h"
@@ -1935,6 +1936,33 @@ void nsRefreshDriver::UpdateIntersectionObservations(TimeStamp aNowTime) {
         return document->HasIntersectionObservers();
       });
 
+  // Computing intersections walks every observation target in those
+  // documents, which is wasteful on ticks where nothing moved (e.g. ticks
+  // driven purely by requestAnimationFrame). Hash the geometry and restyle
+  // generations of the documents involved and skip the walk when they're all
+  // unchanged since the last tick. We can't skip when an update was
+  // explicitly requested (new or removed observations), nor when we may be
+  // embedded in an out-of-process iframe, whose visible rect can change
+  // without affecting any of our local generations.
+  uint32_t generation = HashGeneric(documents.Length());
+  for (const Document* doc : documents) {
+    uint64_t geometryGeneration = 0;
+    if (PresShell* presShell = doc->GetPresShell()) {
+      geometryGeneration = presShell->GetGeometryGeneration();
+    }
+    uint64_t restyleGeneration = 0;
+    if (nsPresContext* pc = doc->GetPresContext()) {
+      restyleGeneration = pc->GetRestyleGeneration();
+    }
+    generation = AddToHash(generation, geometryGeneration, restyleGeneration);
+  }
+  if (!mNeedToUpdateIntersectionObservations &&
+      mPresContext->Document()->IsTopLevelContentDocument() &&
+      generation == mIntersectionObservationGeneration) {
+    return;
+  }
+  mIntersectionObservationGeneration = generation;
+
   for (uint32_t i = 0; i < documents.Length(); ++i) {
     Document* doc = documents[i];
     doc->UpdateIntersectionObservations(aNowTime);
@@ -595,6 +595,12 @@ class nsRefreshDriver final : public mozilla::layers::TransactionIdAllocator,
   // compositor transaction to be completed before we append a note to the gfx
   // critical log. The number is doubled every time the threshold is hit.
   uint64_t mWarningThreshold;
+
+  // Hash of the geometry and restyle generations of the documents we computed
+  // intersection observations for during the last tick; when it's unchanged
+  // we can skip recomputing them. See UpdateIntersectionObservations.
+  uint32_t mIntersectionObservationGeneration = 0;
+
   mozilla::TimeStamp mMostRecentRefresh;
   mozilla::TimeStamp mTickStart;
   mozilla::VsyncId mTickVsyncId;
@@ -2987,6 +2987,11 @@ void ScrollFrameHelper::ScrollToImpl(nsPoint aPt, const nsRect& aRange,
     }
   }
 
+  // The scroll position is really changing now; let the pres shell know so
+  // that consumers of cached geometry (e.g. intersection observers) can tell
+  // their results may be stale.
+  mOuter->PresShell()->IncrementGeometryGeneration();
+
   bool needFrameVisibilityUpdate = mLastUpdateFramesPos == nsPoint(-1, -1);
 
   nsPoint dist(std::abs(pt.x - mLastUpdateFramesPos.x),
@@ -5128,12 +5128,19 @@ static LogicalMargin SubgridAccumulatedMarginBorderPadding(
 /**
  * Return the [min|max]-content contribution of aChild to its parent (i.e.
  * the child's margin-box) in aAxis.
+ *
+ * If aConstraintIndependent is non-null, it's set to true when the result
+ * doesn't depend on aConstraint (i.e. when we had to measure the child with
+ * a reflow, which produces the same size for both constraint types), so the
+ * caller can reuse the result for the other constraint without reflowing
+ * the child a second time.
  */
 static nscoord ContentContribution(
     const GridItemInfo& aGridItem, const GridReflowInput& aState,
     gfxContext* aRC, WritingMode aCBWM, LogicalAxis aAxis,
     const Maybe<LogicalSize>& aPercentageBasis, IntrinsicISizeType aConstraint,
-    nscoord aMinSizeClamp = NS_MAXSIZE, uint32_t aFlags = 0) {
+    nscoord aMinSizeClamp = NS_MAXSIZE, uint32_t aFlags = 0,
+    bool* aConstraintIndependent = nullptr) {
   nsIFrame* child = aGridItem.mFrame;
 
   nscoord extraMargin = 0;
@@ -5191,6 +5198,10 @@ static nscoord ContentContribution(
   auto childWM = child->GetWritingMode();
   const bool isOrthogonal = childWM.IsOrthogonalTo(aCBWM);
   auto childAxis = isOrthogonal ? GetOrthogonalAxis(aAxis) : aAxis;
+  if (aConstraintIndependent) {
+    *aConstraintIndependent =
+        size == NS_INTRINSIC_ISIZE_UNKNOWN && childAxis == eLogicalAxisBlock;
+  }
   if (size == NS_INTRINSIC_ISIZE_UNKNOWN && childAxis == eLogicalAxisBlock) {
     // We need to reflow the child to find its BSize contribution.
     // XXX this will give mostly correct results for now (until bug 1174569).
@@ -5339,10 +5350,18 @@ static nscoord MinContentContribution(const GridItemInfo& aGridItem,
     aCache->mPercentageBasis.emplace(
         aState.PercentageBasisFor(aAxis, aGridItem));
   }
+  bool constraintIndependent = false;
   nscoord s = ContentContribution(
       aGridItem, aState, aRC, aCBWM, aAxis, aCache->mPercentageBasis,
-      IntrinsicISizeType::MinISize, aCache->mMinSizeClamp);
+      IntrinsicISizeType::MinISize, aCache->mMinSizeClamp, 0,
+      &constraintIndependent);
   aCache->mMinContentContribution.emplace(s);
+  if (constraintIndependent && aCache->mMaxContentContribution.isNothing()) {
+    // The contribution came from a measuring reflow, so it's the same for
+    // both constraint types; avoid reflowing the item again for the
+    // max-content contribution.
+    aCache->mMaxContentContribution.emplace(s);
+  }
   return s;
 }
 
@@ -5358,10 +5377,16 @@ static nscoord MaxContentContribution(const GridItemInfo& aGridItem,
     aCache->mPercentageBasis.emplace(
         aState.PercentageBasisFor(aAxis, aGridItem));
   }
+  bool constraintIndependent = false;
   nscoord s = ContentContribution(
       aGridItem, aState, aRC, aCBWM, aAxis, aCache->mPercentageBasis,
-      IntrinsicISizeType::PrefISize, aCache->mMinSizeClamp);
+      IntrinsicISizeType::PrefISize, aCache->mMinSizeClamp, 0,
+      &constraintIndependent);
   aCache->mMaxContentContribution.emplace(s);
+  if (constraintIndependent && aCache->mMinContentContribution.isNothing()) {
+    // See the comment in MinContentContribution.
+    aCache->mMinContentContribution.emplace(s);
+  }
   return s;
 }
 
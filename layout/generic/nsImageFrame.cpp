@@ -1994,7 +1994,9 @@ void nsDisplayImage::Paint(nsDisplayListBuilder* aBuilder, gfxContext* aCtx) {
   const bool oldImageIsDifferent =
       OldImageHasDifferentRatio(*frame, *mImage, mPrevImage);
 
-  uint32_t flags = imgIContainer::FLAG_NONE;
+  // We're painting, so any decode this kicks off is for content the user can
+  // see right now; let it run ahead of decodes for content further away.
+  uint32_t flags = imgIContainer::FLAG_HIGH_PRIORITY;
   if (aBuilder->ShouldSyncDecodeImages() || oldImageIsDifferent) {
     flags |= imgIContainer::FLAG_SYNC_DECODE;
   }
@@ -2162,7 +2164,10 @@ bool nsDisplayImage::CreateWebRenderCommands(
   const bool oldImageIsDifferent =
       OldImageHasDifferentRatio(*frame, *mImage, mPrevImage);
 
-  uint32_t flags = imgIContainer::FLAG_ASYNC_NOTIFY;
+  // We're painting, so any decode this kicks off is for content the user can
+  // see right now; let it run ahead of decodes for content further away.
+  uint32_t flags =
+      imgIContainer::FLAG_ASYNC_NOTIFY | imgIContainer::FLAG_HIGH_PRIORITY;
   if (aDisplayListBuilder->ShouldSyncDecodeImages() || oldImageIsDifferent) {
     flags |= imgIContainer::FLAG_SYNC_DECODE;
   }
@@ -55,6 +55,15 @@ static bool IsSpaceOrTabOrSegmentBreak(char16_t aCh) {
   return IsSpaceOrTab(aCh) || IsSegmentBreak(aCh);
 }
 
+// True for characters that the white-space-compressing modes of TransformText
+// copy through untouched: not collapsible white space and not discardable.
+// Must be kept in sync with IsDiscardable() above.
+template <class CharT>
+static bool IsPlainChar(CharT aCh) {
+  return !IsSpaceOrTabOrSegmentBreak(aCh) && aCh != CH_SHY &&
+         !(sizeof(CharT) > 1 && IsBidiControl(aCh));
+}
+
 template <typename CharT>
 /* static */
 bool nsTextFrameUtils::IsSkippableCharacterForTransformText(CharT aChar) {
@@ -235,6 +244,22 @@ CharT* nsTextFrameUtils::TransformText(const CharT* aText, uint32_t aLength,
     uint32_t i;
     for (i = 0; i < aLength; ++i) {
       CharT ch = aText[i];
+      // Bulk-copy a run of characters that need no white space processing
+      // and aren't discardable, rather than testing them one at a time.
+      // Runs like this dominate scripts that don't use spaces.
+      if (IsPlainChar(ch)) {
+        uint32_t runEnd = i + 1;
+        while (runEnd < aLength && IsPlainChar(aText[runEnd])) {
+          ++runEnd;
+        }
+        memcpy(aOutput, aText + i, (runEnd - i) * sizeof(CharT));
+        aOutput += runEnd - i;
+        aSkipChars->KeepChars(runEnd - i);
+        lastCharArabic = IS_ARABIC_CHAR(aText[runEnd - 1]);
+        inWhitespace = false;
+        i = runEnd - 1;
+        continue;
+      }
       // CSS Text 3 - 4.1. The White Space Processing Rules
       // White space processing in CSS affects only the document white space
       // characters: spaces (U+0020), tabs (U+0009), and segment breaks.
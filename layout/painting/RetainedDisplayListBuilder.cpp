@@ -15,6 +15,7 @@
 #include "nsSubDocumentFrame.h"
 #include "nsViewManager.h"
 #include "nsCanvasFrame.h"
+#include "nsTHashMap.h"
 #include "mozilla/AutoRestore.h"
 #include "mozilla/DisplayPortUtils.h"
 #include "mozilla/PresShell.h"
@@ -142,6 +143,42 @@ bool AnyContentAncestorModified(nsIFrame* aFrame, nsIFrame* aStopAtFrame) {
   return false;
 }
 
+// Same as above, but memoizes the answer for every frame visited. Only valid
+// while the modified-frame state and the stop frame stay the same, i.e. for
+// the duration of one list walk in PreProcessDisplayList, where sibling items
+// share most of their ancestor chain.
+static bool AnyContentAncestorModified(
+    nsIFrame* aFrame, nsIFrame* aStopAtFrame,
+    nsTHashMap<nsPtrHashKey<nsIFrame>, bool>& aCache) {
+  AutoTArray<nsIFrame*, 32> path;
+  bool modified = false;
+  nsIFrame* f = aFrame;
+  while (f) {
+    if (auto entry = aCache.Lookup(f)) {
+      modified = entry.Data();
+      break;
+    }
+
+    path.AppendElement(f);
+    if (f->IsFrameModified()) {
+      modified = true;
+      break;
+    }
+
+    if (aStopAtFrame && f == aStopAtFrame) {
+      break;
+    }
+
+    f = nsLayoutUtils::GetDisplayListParent(f);
+  }
+
+  for (nsIFrame* visited : path) {
+    aCache.InsertOrUpdate(visited, modified);
+  }
+
+  return modified;
+}
+
 // Removes any display items that belonged to a frame that was deleted,
 // and mark frames that belong to a different AGR so that get their
 // items built again.
@@ -181,6 +218,10 @@ bool RetainedDisplayListBuilder::PreProcessDisplayList(
 
   nsDisplayList out;
 
+  // Memoizes the modified-ancestor walks for the items of this list; see
+  // the cached AnyContentAncestorModified overload above.
+  nsTHashMap<nsPtrHashKey<nsIFrame>, bool> modifiedAncestorCache;
+
   size_t i = 0;
   while (nsDisplayItem* item = aList->RemoveBottom()) {
 #ifdef MOZ_DIAGNOSTIC_ASSERT_ENABLED
@@ -208,7 +249,8 @@ bool RetainedDisplayListBuilder::PreProcessDisplayList(
     }
 
     if (!item->CanBeReused() || item->HasDeletedFrame() ||
-        AnyContentAncestorModified(item->FrameForInvalidation(), aOuterFrame)) {
+        AnyContentAncestorModified(item->FrameForInvalidation(), aOuterFrame,
+                                   modifiedAncestorCache)) {
       if (initializeOldItems) {
         aList->mOldItems.AppendElement(OldItemInfo(nullptr));
       } else {
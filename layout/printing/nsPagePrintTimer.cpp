@@ -29,7 +29,9 @@ void nsPagePrintTimer::Disconnect() {
 
 nsresult nsPagePrintTimer::StartTimer(bool aUseDelay) {
   uint32_t delay = 0;
-  if (aUseDelay) {
+  // A zero mDelay means the job shouldn't sleep between sheets at all (e.g.
+  // when printing to a file), so don't apply the initial ramp either.
+  if (aUseDelay && mDelay > 0) {
     if (mFiringCount < 10) {
       // Longer delay for the few first pages.
       delay = mDelay + ((10 - mFiringCount) * 100);
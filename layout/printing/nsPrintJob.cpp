@@ -2647,6 +2647,19 @@ nsresult nsPrintJob::StartPagePrintTimer(const UniquePtr<nsPrintObject>& aPO) {
     int32_t printPageDelay = 50;
     mPrt->mPrintSettings->GetPrintPageDelay(&printPageDelay);
 
+    // The delay exists to pace a physical printer and give the user time to
+    // cancel. When the output is a file there is no printer to pace, and on
+    // a long document the accumulated sleeps dominate the export time, so
+    // don't sleep between sheets. The timer still fires through the event
+    // loop, so the UI stays responsive and cancel keeps working.
+    int16_t outputFormat = nsIPrintSettings::kOutputFormatNative;
+    mPrt->mPrintSettings->GetOutputFormat(&outputFormat);
+    bool printToFile = false;
+    mPrt->mPrintSettings->GetPrintToFile(&printToFile);
+    if (printToFile || outputFormat == nsIPrintSettings::kOutputFormatPDF) {
+      printPageDelay = 0;
+    }
+
     nsCOMPtr<nsIContentViewer> cv = do_QueryInterface(mDocViewerPrint);
     NS_ENSURE_TRUE(cv, NS_ERROR_FAILURE);
     nsCOMPtr<Document> doc = cv->GetDocument();
@@ -84,4 +84,17 @@ void ServoElementSnapshot::AddAttrs(const Element& aElement,
   }
 }
 
+bool ServoElementSnapshot::HasAttrChanged(int32_t aNameSpaceID,
+                                          nsAtom* aAttribute) const {
+  if (aNameSpaceID == kNameSpaceID_None) {
+    if (aAttribute == nsGkAtoms::_class) {
+      return mClassAttributeChanged;
+    }
+    if (aAttribute == nsGkAtoms::id) {
+      return mIdAttributeChanged;
+    }
+  }
+  return mChangedAttrNames.Contains(aAttribute);
+}
+
 }  // namespace mozilla
@@ -84,6 +84,14 @@ class ServoElementSnapshot {
    */
   void AddAttrs(const Element&, int32_t aNameSpaceID, nsAtom* aAttribute);
 
+  /**
+   * Returns whether we have already captured a change to the given attribute.
+   *
+   * In that case the pre-change values are recorded already, and there's
+   * nothing else the snapshot needs from further changes to that attribute.
+   */
+  bool HasAttrChanged(int32_t aNameSpaceID, nsAtom* aAttribute) const;
+
   /**
    * Captures some other pseudo-class matching state not included in
    * EventStates.
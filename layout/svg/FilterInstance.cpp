@@ -8,6 +8,7 @@
 #include "FilterInstance.h"
 
 // MFBT headers next:
+#include "mozilla/HashFunctions.h"
 #include "mozilla/UniquePtr.h"
 
 // Keep others in (case-insensitive) order:
@@ -737,6 +738,50 @@ void FilterInstance::BuildSourceImage(DrawTarget* aDest,
   mSourceGraphic.mSurfaceRect = neededRect;
 }
 
+/**
+ * The output of the most recent software filter rendering for a frame, kept
+ * on the frame so that a repaint which changes neither the filter nor the
+ * filtered content costs a surface copy instead of re-executing the filter
+ * graph.
+ */
+struct CachedFilterOutput {
+  FilterDescription mDescription;
+  nsIntRect mFilterRect;
+  nsIntRect mSourceRect;
+  uint32_t mSourceHash;
+  RefPtr<SourceSurface> mOutput;
+};
+
+NS_DECLARE_FRAME_PROPERTY_DELETABLE(CachedFilterOutputProperty,
+                                    CachedFilterOutput)
+
+// Don't cache filter outputs above this size. Hashing a large source surface
+// costs a noticeable fraction of what the filter itself costs, and the cached
+// output lives for as long as its frame does.
+static const int64_t kMaxCachedFilterArea = 1 << 20;  // pixels
+
+static bool ComputeSourceSurfaceHash(SourceSurface* aSurface,
+                                     uint32_t* aHash) {
+  RefPtr<DataSourceSurface> data = aSurface->GetDataSurface();
+  if (!data) {
+    return false;
+  }
+  DataSourceSurface::ScopedMap map(data, DataSourceSurface::READ);
+  if (!map.IsMapped()) {
+    return false;
+  }
+  // The stride can include uninitialized padding, so hash row by row.
+  IntSize size = data->GetSize();
+  int32_t rowLength = size.width * BytesPerPixel(data->GetFormat());
+  uint32_t hash = 0;
+  for (int32_t y = 0; y < size.height; y++) {
+    hash = AddToHash(
+        hash, HashBytes(map.GetData() + y * map.GetStride(), rowLength));
+  }
+  *aHash = hash;
+  return true;
+}
+
 void FilterInstance::Render(gfxContext* aCtx, imgDrawingParams& aImgParams,
                             float aOpacity) {
   MOZ_ASSERT(mTargetFrame, "Need a frame for rendering");
@@ -807,6 +852,63 @@ void FilterInstance::Render(gfxContext* aCtx, imgDrawingParams& aImgParams,
     }
   }
 
+  // With a software backend, cache the filter output on the frame. Pages
+  // with many small filtered elements (e.g. charts full of drop-shadowed
+  // sparklines) repaint them with unchanged content far more often than they
+  // change them, and hashing the source image plus blitting the previous
+  // output is much cheaper than re-executing the filter graph. Fill/stroke
+  // paints and feImage inputs feed the filter without being part of the hash,
+  // so don't cache when they're present.
+  if (StaticPrefs::gfx_filters_cache_software_output_enabled() &&
+      (dt->GetBackendType() == BackendType::SKIA ||
+       dt->GetBackendType() == BackendType::CAIRO) &&
+      !fillPaint && !strokePaint && mInputImages.IsEmpty() &&
+      mSourceGraphic.mSourceSurface &&
+      int64_t(filterRect.width) * filterRect.height <= kMaxCachedFilterArea &&
+      int64_t(mSourceGraphic.mSurfaceRect.width) *
+              mSourceGraphic.mSurfaceRect.height <=
+          kMaxCachedFilterArea) {
+    uint32_t sourceHash;
+    if (ComputeSourceSurfaceHash(mSourceGraphic.mSourceSurface, &sourceHash)) {
+      Rect destRect(0, 0, Float(filterRect.width), Float(filterRect.height));
+
+      CachedFilterOutput* cached =
+          mTargetFrame->GetProperty(CachedFilterOutputProperty());
+      if (cached && cached->mFilterRect == filterRect &&
+          cached->mSourceRect == mSourceGraphic.mSurfaceRect &&
+          cached->mSourceHash == sourceHash &&
+          cached->mDescription == mFilterDescription) {
+        dt->DrawSurface(cached->mOutput, destRect, destRect,
+                        DrawSurfaceOptions(), DrawOptions(aOpacity));
+        return;
+      }
+
+      // Render into an offscreen surface so there's an output to keep.
+      // Opacity is applied when blitting, so the cached output stays valid
+      // when only the opacity changes.
+      RefPtr<DrawTarget> offscreen;
+      if (dt->CanCreateSimilarDrawTarget(filterRect.Size(),
+                                         SurfaceFormat::B8G8R8A8)) {
+        offscreen = dt->CreateSimilarDrawTarget(filterRect.Size(),
+                                                SurfaceFormat::B8G8R8A8);
+      }
+      if (offscreen && offscreen->IsValid()) {
+        offscreen->DrawFilter(resultFilter, renderRect, Point(0, 0));
+        RefPtr<SourceSurface> output = offscreen->Snapshot();
+        if (output) {
+          dt->DrawSurface(output, destRect, destRect, DrawSurfaceOptions(),
+                          DrawOptions(aOpacity));
+          mTargetFrame->SetProperty(
+              CachedFilterOutputProperty(),
+              new CachedFilterOutput{mFilterDescription, filterRect,
+                                     mSourceGraphic.mSurfaceRect, sourceHash,
+                                     std::move(output)});
+          return;
+        }
+      }
+    }
+  }
+
   dt->DrawFilter(resultFilter, renderRect, Point(0, 0), DrawOptions(aOpacity));
 }
 
@@ -891,6 +891,11 @@ struct arena_t {
   // and it keeps the value it had after the destructor.
   arena_id_t mId;
 
+  // Linkage for the list of thread-local arenas released by exited threads,
+  // kept around for reuse by the next thread that wants one. Only managed by
+  // ArenaCollection, under its lock.
+  arena_t* mNextReleased;
+
   // All operations on this arena require that lock be locked.
   Mutex mLock;
 
@@ -1064,6 +1069,7 @@ class ArenaCollection {
   bool Init() {
     mArenas.Init();
     mPrivateArenas.Init();
+    mReleasedThreadLocalArenas = nullptr;
     arena_params_t params;
     // The main arena allows more dirty pages than the default for other arenas.
     params.mMaxDirty = opt_dirty_max;
@@ -1076,6 +1082,34 @@ class ArenaCollection {
 
   arena_t* CreateArena(bool aIsPrivate, arena_params_t* aParams);
 
+  // Returns an arena for a thread to pin itself to, preferring an arena
+  // released by an exited thread over creating a new one, so that thread
+  // pools whose threads come and go don't grow the arena set without bound.
+  arena_t* AcquireThreadLocalArena() {
+    {
+      MutexAutoLock lock(mLock);
+      if (mReleasedThreadLocalArenas) {
+        arena_t* arena = mReleasedThreadLocalArenas;
+        mReleasedThreadLocalArenas = arena->mNextReleased;
+        arena->mNextReleased = nullptr;
+        return arena;
+      }
+    }
+    return CreateArena(/* IsPrivate = */ false, /* Params = */ nullptr);
+  }
+
+  // Puts a thread-local arena on the released list. The arena may still own
+  // live allocations, and those can be freed from any thread, so the arena
+  // stays registered and is never destroyed; it is merely up for grabs by
+  // the next thread that wants a thread-local arena.
+  void ReleaseThreadLocalArena(arena_t* aArena) {
+    MOZ_ASSERT(aArena != mDefaultArena);
+    MutexAutoLock lock(mLock);
+    MOZ_ASSERT(!aArena->mNextReleased);
+    aArena->mNextReleased = mReleasedThreadLocalArenas;
+    mReleasedThreadLocalArenas = aArena;
+  }
+
   void DisposeArena(arena_t* aArena) {
     MutexAutoLock lock(mLock);
     MOZ_RELEASE_ASSERT(mPrivateArenas.Search(aArena),
@@ -1122,6 +1156,10 @@ class ArenaCollection {
   arena_id_t mLastPublicArenaId;
   Tree mArenas;
   Tree mPrivateArenas;
+
+  // Head of the list of thread-local arenas that are no longer pinned to a
+  // thread, linked through arena_t::mNextReleased.
+  arena_t* mReleasedThreadLocalArenas;
 };
 
 static ArenaCollection gArenas;
@@ -2038,15 +2076,19 @@ static inline arena_t* thread_local_arena(bool enabled) {
   arena_t* arena;
 
   if (enabled) {
-    // The arena will essentially be leaked if this function is
-    // called with `false`, but it doesn't matter at the moment.
-    // because in practice nothing actually calls this function
-    // with `false`, except maybe at shutdown.
-    arena =
-        gArenas.CreateArena(/* IsPrivate = */ false, /* Params = */ nullptr);
+    arena = gArenas.AcquireThreadLocalArena();
   } else {
     arena = gArenas.GetDefault();
   }
+
+  // If the thread was pinned to a thread-local arena before, give that arena
+  // back to the collection for the next thread that wants one. It can't be
+  // destroyed, because allocations made from it may outlive this thread.
+  arena_t* prev = thread_arena.get();
+  if (prev && prev != arena && prev != gArenas.GetDefault()) {
+    gArenas.ReleaseThreadLocalArena(prev);
+  }
+
   thread_arena.set(arena);
   return arena;
 }
@@ -3525,6 +3567,7 @@ arena_t::arena_t(arena_params_t* aParams, bool aIsPrivate) {
   memset(&mLink, 0, sizeof(mLink));
   memset(&mStats, 0, sizeof(arena_stats_t));
   mId = 0;
+  mNextReleased = nullptr;
 
   // Initialize chunks.
   mChunksDirty.Init();
@@ -437,8 +437,22 @@ template <typename AllocPolicy>
 
   size_t copied = 0;
   while (copied < aSize) {
+    size_t remaining = aSize - copied;
     size_t toCopy;
-    char* data = AllocateBytes(aSize - copied, &toCopy);
+    char* data;
+    if (remaining > mStandardCapacity &&
+        (mSegments.empty() ||
+         mSegments.back().mSize == mSegments.back().mCapacity)) {
+      // A large write that would need a fresh segment anyway. Allocate one
+      // segment fitting the whole remainder rather than chopping it into
+      // standard-capacity segments, so large buffers stay contiguous.
+      size_t capacity =
+          (remaining + kSegmentAlignment - 1) & ~(kSegmentAlignment - 1);
+      data = AllocateSegment(remaining, capacity);
+      toCopy = remaining;
+    } else {
+      data = AllocateBytes(remaining, &toCopy);
+    }
     if (!data) {
       return false;
     }
@@ -53,8 +53,16 @@ namespace mozilla {
 // The ideal size depends on how the SegmentedVector is used and the size of
 // |T|, but reasonable sizes include 1024, 4096 (the default), 8192, and 16384.
 //
+// |SegmentFreeListCapacity| specifies how many emptied segments the vector
+// may keep around for reuse instead of freeing them. Use a non-zero value
+// for vectors that are repeatedly filled and cleared, so that steady-state
+// refills don't go through the allocator at all. The memory retained by the
+// free list is bounded by |SegmentFreeListCapacity * IdealSegmentSize| and
+// is only released when the vector itself is destroyed.
+//
 template <typename T, size_t IdealSegmentSize = 4096,
-          typename AllocPolicy = MallocAllocPolicy>
+          typename AllocPolicy = MallocAllocPolicy,
+          size_t SegmentFreeListCapacity = 0>
 class SegmentedVector : private AllocPolicy {
   template <size_t SegmentCapacity>
   struct SegmentImpl
@@ -102,6 +110,16 @@ class SegmentedVector : private AllocPolicy {
       new (KnownNotNull, elem) T(std::forward<U>(aU));
     }
 
+    // Appends |aCount| default-constructed elements, constructed in place.
+    void AppendN(uint32_t aCount) {
+      MOZ_ASSERT(aCount <= SegmentCapacity - mLength);
+      T* elems = Elems() + mLength;
+      mLength += aCount;
+      for (uint32_t i = 0; i < aCount; i++) {
+        new (KnownNotNull, &elems[i]) T();
+      }
+    }
+
     void PopLast() {
       MOZ_ASSERT(mLength > 0);
       (*this)[mLength - 1].~T();
@@ -136,9 +154,20 @@ class SegmentedVector : private AllocPolicy {
   }
 
   SegmentedVector(SegmentedVector&& aOther)
-      : mSegments(std::move(aOther.mSegments)) {}
+      : mSegments(std::move(aOther.mSegments)),
+        mFreeList(std::move(aOther.mFreeList)),
+        mFreeCount(aOther.mFreeCount) {
+    aOther.mFreeCount = 0;
+  }
 
-  ~SegmentedVector() { Clear(); }
+  ~SegmentedVector() {
+    Clear();
+    Segment* segment;
+    while ((segment = mFreeList.popFirst())) {
+      segment->~Segment();
+      this->free_(segment, 1);
+    }
+  }
 
   bool IsEmpty() const { return !mSegments.getFirst(); }
 
@@ -159,17 +188,37 @@ class SegmentedVector : private AllocPolicy {
   [[nodiscard]] bool Append(U&& aU) {
     Segment* last = mSegments.getLast();
     if (!last || last->Length() == kSegmentCapacity) {
-      last = this->template pod_malloc<Segment>(1);
+      last = AllocSegment();
       if (!last) {
         return false;
       }
-      new (KnownNotNull, last) Segment();
       mSegments.insertBack(last);
     }
     last->Append(std::forward<U>(aU));
     return true;
   }
 
+  // Appends |aCount| default-constructed elements, filling each segment
+  // before allocating the next one. Returns false if an allocation failed,
+  // in which case the elements appended so far are kept.
+  [[nodiscard]] bool AppendN(size_t aCount) {
+    while (aCount) {
+      Segment* last = mSegments.getLast();
+      if (!last || last->Length() == kSegmentCapacity) {
+        last = AllocSegment();
+        if (!last) {
+          return false;
+        }
+        mSegments.insertBack(last);
+      }
+      size_t room = kSegmentCapacity - last->Length();
+      uint32_t n = uint32_t(aCount < room ? aCount : room);
+      last->AppendN(n);
+      aCount -= n;
+    }
+    return true;
+  }
+
   // You should probably only use this instead of Append() if you are using an
   // infallible allocation policy. It will crash if the allocation fails.
   template <typename U>
@@ -188,8 +237,7 @@ class SegmentedVector : private AllocPolicy {
   void Clear() {
     Segment* segment;
     while ((segment = mSegments.popFirst())) {
-      segment->~Segment();
-      this->free_(segment, 1);
+      FreeSegment(segment);
     }
   }
 
@@ -211,8 +259,7 @@ class SegmentedVector : private AllocPolicy {
     last->PopLast();
     if (!last->Length()) {
       mSegments.popLast();
-      last->~Segment();
-      this->free_(last, 1);
+      FreeSegment(last);
     }
   }
 
@@ -243,8 +290,7 @@ class SegmentedVector : private AllocPolicy {
 
       // Destroying the segment destroys all elements contained therein.
       mSegments.popLast();
-      last->~Segment();
-      this->free_(last, 1);
+      FreeSegment(last);
 
       MOZ_ASSERT(aNumElements >= segmentLen);
       aNumElements -= segmentLen;
@@ -331,7 +377,8 @@ class SegmentedVector : private AllocPolicy {
   // pointers to other memory blocks, those blocks must be measured separately
   // during a subsequent iteration over the vector.
   size_t SizeOfExcludingThis(mozilla::MallocSizeOf aMallocSizeOf) const {
-    return mSegments.sizeOfExcludingThis(aMallocSizeOf);
+    return mSegments.sizeOfExcludingThis(aMallocSizeOf) +
+           mFreeList.sizeOfExcludingThis(aMallocSizeOf);
   }
 
   // Like sizeOfExcludingThis(), but measures |this| as well.
@@ -340,7 +387,40 @@ class SegmentedVector : private AllocPolicy {
   }
 
  private:
+  // Takes a segment from the free list, or allocates and constructs a fresh
+  // one. Returns null on allocation failure.
+  Segment* AllocSegment() {
+    if (SegmentFreeListCapacity) {
+      if (Segment* segment = mFreeList.popFirst()) {
+        mFreeCount--;
+        return segment;
+      }
+    }
+    Segment* segment = this->template pod_malloc<Segment>(1);
+    if (segment) {
+      new (KnownNotNull, segment) Segment();
+    }
+    return segment;
+  }
+
+  // Destroys a segment's elements and either parks the (emptied) segment on
+  // the free list or frees it, depending on the free list's capacity.
+  void FreeSegment(Segment* aSegment) {
+    aSegment->~Segment();
+    if (SegmentFreeListCapacity && mFreeCount < SegmentFreeListCapacity) {
+      new (KnownNotNull, aSegment) Segment();
+      mFreeList.insertFront(aSegment);
+      mFreeCount++;
+      return;
+    }
+    this->free_(aSegment, 1);
+  }
+
   mozilla::LinkedList<Segment> mSegments;
+
+  // Emptied segments kept for reuse, at most SegmentFreeListCapacity of them.
+  mozilla::LinkedList<Segment> mFreeList;
+  size_t mFreeCount = 0;
 };
 
 }  // namespace mozilla
@@ -95,9 +95,63 @@ void TestHashPair() {
   }
 }
 
+// A pathological pointer hasher that sends every key to the same bucket, so
+// every operation walks a maximal collision chain. This exercises the
+// prefetching probe loops in a way well-distributed hashes never would.
+struct CollidingPointerHasher {
+  using Key = int*;
+  using Lookup = int*;
+
+  static mozilla::HashNumber hash(const Lookup& aLookup) { return 0; }
+
+  static bool match(const Key& aKey, const Lookup& aLookup) {
+    return aKey == aLookup;
+  }
+};
+
+void TestCollisionChains() {
+  using namespace mozilla;
+
+  static const size_t count = 500;
+  static int backing[count];
+
+  HashSet<int*, CollidingPointerHasher> set;
+  for (size_t i = 0; i < count; i++) {
+    MOZ_RELEASE_ASSERT(set.putNew(&backing[i]));
+  }
+  MOZ_RELEASE_ASSERT(set.count() == count);
+
+  // Every key must survive the chain walk, hits and misses alike.
+  for (size_t i = 0; i < count; i++) {
+    MOZ_RELEASE_ASSERT(set.has(&backing[i]));
+  }
+  int other;
+  MOZ_RELEASE_ASSERT(!set.has(&other));
+
+  // lookupForAdd's cached hash must stay usable across the add.
+  auto addPtr = set.lookupForAdd(&other);
+  MOZ_RELEASE_ASSERT(!addPtr);
+  MOZ_RELEASE_ASSERT(set.add(addPtr, &other));
+  MOZ_RELEASE_ASSERT(set.has(&other));
+
+  // Removing from the middle leaves tombstones on the chain; lookups and
+  // re-adds still have to work.
+  for (size_t i = 0; i < count; i += 2) {
+    set.remove(&backing[i]);
+  }
+  for (size_t i = 0; i < count; i++) {
+    MOZ_RELEASE_ASSERT(set.has(&backing[i]) == (i % 2 == 1));
+  }
+  for (size_t i = 0; i < count; i += 2) {
+    MOZ_RELEASE_ASSERT(set.putNew(&backing[i]));
+  }
+  MOZ_RELEASE_ASSERT(set.count() == count + 1);
+}
+
 int main() {
   TestMoveConstructor();
   TestEnumHash();
   TestHashPair();
+  TestCollisionChains();
   return 0;
 }
@@ -359,11 +359,89 @@ void TestIterator() {
   MOZ_RELEASE_ASSERT(iterFromLast.Done());
 }
 
+// An alloc policy that counts allocations, so we can check the segment free
+// list really does keep refills away from the allocator.
+static size_t gNumAllocs;
+static size_t gNumFrees;
+
+class CountingAllocPolicy : public InfallibleAllocPolicy {
+ public:
+  template <typename T>
+  T* pod_malloc(size_t aNumElems) {
+    gNumAllocs++;
+    return InfallibleAllocPolicy::pod_malloc<T>(aNumElems);
+  }
+
+  template <typename T>
+  void free_(T* aPtr, size_t aNumElems = 0) {
+    gNumFrees++;
+    InfallibleAllocPolicy::free_(aPtr, aNumElems);
+  }
+};
+
+// This tests the segment free list and bulk appending.
+void TestSegmentRecyclingAndAppendN() {
+  static const size_t segmentSize = 64;
+  static const size_t freeListCapacity = 2;
+  typedef SegmentedVector<int, segmentSize, CountingAllocPolicy,
+                          freeListCapacity>
+      MyVector;
+
+  {
+    MyVector v;
+
+    // Fill a few segments, then clear and refill. The refill should be
+    // served entirely from the free list (within its capacity).
+    MOZ_RELEASE_ASSERT(v.AppendN(40));
+    MOZ_RELEASE_ASSERT(v.Length() == 40);
+    size_t allocs = gNumAllocs;
+    MOZ_RELEASE_ASSERT(allocs >= freeListCapacity);
+
+    v.Clear();
+    MOZ_RELEASE_ASSERT(v.IsEmpty());
+    // Up to freeListCapacity segments are retained, the rest are freed.
+    MOZ_RELEASE_ASSERT(gNumFrees == allocs - freeListCapacity);
+
+    MOZ_RELEASE_ASSERT(v.AppendN(40));
+    MOZ_RELEASE_ASSERT(v.Length() == 40);
+    // The first freeListCapacity segments came from the free list.
+    MOZ_RELEASE_ASSERT(gNumAllocs == 2 * allocs - freeListCapacity);
+
+    // AppendN fills the last segment before allocating a new one.
+    size_t allocsBefore = gNumAllocs;
+    MOZ_RELEASE_ASSERT(v.AppendN(1));
+    MOZ_RELEASE_ASSERT(gNumAllocs == allocsBefore);
+    MOZ_RELEASE_ASSERT(v.Length() == 41);
+
+    int n = 0;
+    for (auto iter = v.Iter(); !iter.Done(); iter.Next()) {
+      MOZ_RELEASE_ASSERT(iter.Get() == 0);
+      n++;
+    }
+    MOZ_RELEASE_ASSERT(n == 41);
+  }
+  // Destruction frees the free list too.
+  MOZ_RELEASE_ASSERT(gNumFrees == gNumAllocs);
+
+  // AppendN also constructs non-POD elements in place.
+  {
+    size_t defaultCtors = gNumDefaultCtors;
+    size_t dtors = gNumDtors;
+    SegmentedVector<NonPOD, segmentSize, InfallibleAllocPolicy> v;
+    MOZ_RELEASE_ASSERT(v.AppendN(100));
+    MOZ_RELEASE_ASSERT(v.Length() == 100);
+    MOZ_RELEASE_ASSERT(gNumDefaultCtors == defaultCtors + 100);
+    v.Clear();
+    MOZ_RELEASE_ASSERT(gNumDtors == dtors + 100);
+  }
+}
+
 int main(void) {
   TestBasics();
   TestConstructorsAndDestructors();
   TestSegmentCapacitiesAndAlignments();
   TestIterator();
+  TestSegmentRecyclingAndAppendN();
 
   return 0;
 }
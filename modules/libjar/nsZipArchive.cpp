@@ -341,8 +341,13 @@ nsZipHandle::~nsZipHandle() {
 nsresult nsZipArchive::OpenArchive(nsZipHandle* aZipHandle, PRFileDesc* aFd) {
   mFd = aZipHandle;
 
-  //-- get table of contents for archive
-  nsresult rv = BuildFileList(aFd);
+  //-- find the central directory. Parsing it into the entry table is
+  //-- deferred until the first lookup; see BuildFileList().
+  nsresult rv;
+  {
+    MutexAutoLock lock(mLock);
+    rv = LocateCentralDirectory();
+  }
   if (NS_SUCCEEDED(rv)) {
     if (aZipHandle->mFile && XRE_IsParentProcess()) {
       static char* env = PR_GetEnv("MOZ_JAR_LOG_FILE");
@@ -429,6 +434,11 @@ nsresult nsZipArchive::Test(const char* aEntryName) {
   }
 
   // test all items in archive
+  {
+    MutexAutoLock lock(mLock);
+    nsresult rv = BuildFileList();
+    if (rv != NS_OK) return rv;
+  }
   for (auto* item : mFiles) {
     for (currItem = item; currItem; currItem = currItem->next) {
       //-- don't test (synthetic) directory items
@@ -459,6 +469,11 @@ nsresult nsZipArchive::CloseArchive() {
   // anything more than cleaning up memory, we should start calling it.
   // Let us also cleanup the mFiles table for re-use on the next 'open' call
   memset(mFiles, 0, sizeof(mFiles));
+  mCommentPtr = nullptr;
+  mCommentLen = 0;
+  mCentralOffset = 0;
+  mBuiltFileList = false;
+  mFileListStatus = NS_OK;
   mBuiltSynthetics = false;
   return NS_OK;
 }
@@ -470,6 +485,9 @@ nsZipItem* nsZipArchive::GetItem(const char* aEntryName) {
   MutexAutoLock lock(mLock);
 
   if (aEntryName) {
+    if (NS_FAILED(BuildFileList())) {
+      return nullptr;
+    }
     uint32_t len = strlen(aEntryName);
     //-- If the request is for a directory, make sure that synthetic entries
     //-- are created for the directories without their own entry.
@@ -560,8 +578,11 @@ nsresult nsZipArchive::FindInit(const char* aPattern, nsZipFind** aFind) {
   bool regExp = false;
   char* pattern = 0;
 
+  nsresult rv = BuildFileList();
+  if (rv != NS_OK) return rv;
+
   // Create synthetic directory entries on demand
-  nsresult rv = BuildSynthetics();
+  rv = BuildSynthetics();
   if (rv != NS_OK) return rv;
 
   // validate the pattern
@@ -649,10 +670,10 @@ nsZipItem* nsZipArchive::CreateZipItem() {
 }
 
 //---------------------------------------------
-//  nsZipArchive::BuildFileList
+//  nsZipArchive::LocateCentralDirectory
 //---------------------------------------------
-nsresult nsZipArchive::BuildFileList(PRFileDesc* aFd) {
-  MutexAutoLock lock(mLock);
+nsresult nsZipArchive::LocateCentralDirectory() {
+  mLock.AssertCurrentThreadOwns();
 
   // Get archive size using end pos
   const uint8_t* buf;
@@ -682,7 +703,46 @@ nsresult nsZipArchive::BuildFileList(PRFileDesc* aFd) {
     return NS_ERROR_FILE_CORRUPTED;
   }
 
-  buf = startp + centralOffset;
+  mCentralOffset = centralOffset;
+  MMAP_FAULT_HANDLER_CATCH(NS_ERROR_FAILURE)
+  return NS_OK;
+}
+
+//---------------------------------------------
+//  nsZipArchive::BuildFileList
+//---------------------------------------------
+nsresult nsZipArchive::BuildFileList() {
+  mLock.AssertCurrentThreadOwns();
+
+  if (mBuiltFileList) {
+    return mFileListStatus;
+  }
+  mBuiltFileList = true;
+
+  mFileListStatus = ParseCentralDirectory();
+  if (NS_FAILED(mFileListStatus)) {
+    // Don't leave a partially populated table behind; a corrupt archive
+    // stays unusable, just as it was when the whole parse happened at open
+    // time.
+    memset(mFiles, 0, sizeof(mFiles));
+    mCommentPtr = nullptr;
+    mCommentLen = 0;
+    mArena.Clear();
+  }
+  return mFileListStatus;
+}
+
+//---------------------------------------------
+//  nsZipArchive::ParseCentralDirectory
+//---------------------------------------------
+nsresult nsZipArchive::ParseCentralDirectory() {
+  mLock.AssertCurrentThreadOwns();
+
+  const uint8_t* buf;
+  const uint8_t* startp = mFd->mFileData;
+  const uint8_t* endp = startp + mFd->mLen;
+  MMAP_FAULT_HANDLER_BEGIN_HANDLE(mFd)
+  buf = startp + mCentralOffset;
 
   // avoid overflow of startp + centralOffset.
   if (buf < startp) {
@@ -878,6 +938,13 @@ const uint8_t* nsZipArchive::GetData(nsZipItem* aItem) {
 
 // nsZipArchive::GetComment
 bool nsZipArchive::GetComment(nsACString& aComment) {
+  {
+    // The comment is located while parsing the central directory.
+    MutexAutoLock lock(mLock);
+    if (NS_FAILED(BuildFileList())) {
+      return false;
+    }
+  }
   MMAP_FAULT_HANDLER_BEGIN_BUFFER(mCommentPtr, mCommentLen)
   aComment.Assign(mCommentPtr, mCommentLen);
   MMAP_FAULT_HANDLER_CATCH(false)
@@ -889,6 +956,23 @@ bool nsZipArchive::GetComment(nsACString& aComment) {
 //---------------------------------------------
 int64_t nsZipArchive::SizeOfMapping() { return mFd ? mFd->SizeOfMapping() : 0; }
 
+//---------------------------------------------
+// nsZipArchive::PrefetchArchive
+//---------------------------------------------
+void nsZipArchive::PrefetchArchive() {
+  RefPtr<nsZipHandle> fd;
+  {
+    MutexAutoLock lock(mLock);
+    fd = mFd;
+  }
+  if (!fd || !mozilla::CanPrefetchMemory()) {
+    return;
+  }
+  MMAP_FAULT_HANDLER_BEGIN_HANDLE(fd)
+  mozilla::PrefetchMemory(const_cast<uint8_t*>(fd->mFileData), fd->mLen);
+  MMAP_FAULT_HANDLER_CATCH()
+}
+
 //------------------------------------------
 // nsZipArchive constructor and destructor
 //------------------------------------------
@@ -897,6 +981,9 @@ nsZipArchive::nsZipArchive()
     : mRefCnt(0),
       mCommentPtr(nullptr),
       mCommentLen(0),
+      mCentralOffset(0),
+      mBuiltFileList(false),
+      mFileListStatus(NS_OK),
       mBuiltSynthetics(false),
       mUseZipLog(false) {
   // initialize the table to nullptr
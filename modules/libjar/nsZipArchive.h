@@ -187,6 +187,13 @@ class nsZipArchive final {
    */
   int64_t SizeOfMapping();
 
+  /**
+   * Reads the whole mapped archive into the page cache with one sequential
+   * pass, so that later entry reads don't block on scattered disk I/O.
+   * This blocks until the read is done, so call it from a background thread.
+   */
+  void PrefetchArchive();
+
   /*
    * Refcounting
    */
@@ -204,6 +211,15 @@ class nsZipArchive final {
   const char* mCommentPtr;
   uint16_t mCommentLen;
 
+  // Offset of the first central directory record, found at open time.
+  uint32_t mCentralOffset;
+
+  // Whether we parsed the central directory into mFiles yet. The parse is
+  // deferred until an entry is actually looked up, and its result is kept
+  // in mFileListStatus so a corrupt archive stays unusable.
+  bool mBuiltFileList;
+  nsresult mFileListStatus;
+
   // Whether we synthesized the directory entries
   bool mBuiltSynthetics;
 
@@ -222,7 +238,9 @@ class nsZipArchive final {
  private:
   //--- private methods ---
   nsZipItem* CreateZipItem();
-  nsresult BuildFileList(PRFileDesc* aFd = nullptr);
+  nsresult LocateCentralDirectory();
+  nsresult BuildFileList();
+  nsresult ParseCentralDirectory();
   nsresult BuildSynthetics();
 
   nsZipArchive& operator=(const nsZipArchive& rhs) = delete;
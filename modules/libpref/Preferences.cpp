@@ -1098,18 +1098,18 @@ void Pref::FromWrapper(PrefWrapper& aWrapper) {
 class CallbackNode {
  public:
   CallbackNode(const nsACString& aDomain, PrefChangedFunc aFunc, void* aData,
-               Preferences::MatchKind aMatchKind)
+               Preferences::MatchKind aMatchKind, bool aIsPriority)
       : mDomain(AsVariant(nsCString(aDomain))),
         mFunc(aFunc),
         mData(aData),
-        mNextAndMatchKind(aMatchKind) {}
+        mNextAndMatchKind(aMatchKind | (aIsPriority ? kPriorityMask : 0)) {}
 
   CallbackNode(const char** aDomains, PrefChangedFunc aFunc, void* aData,
-               Preferences::MatchKind aMatchKind)
+               Preferences::MatchKind aMatchKind, bool aIsPriority)
       : mDomain(AsVariant(aDomains)),
         mFunc(aFunc),
         mData(aData),
-        mNextAndMatchKind(aMatchKind) {}
+        mNextAndMatchKind(aMatchKind | (aIsPriority ? kPriorityMask : 0)) {}
 
   // mDomain is a UniquePtr<>, so any uses of Domain() should only be temporary
   // borrows.
@@ -1125,6 +1125,14 @@ class CallbackNode {
                                                kMatchKindMask);
   }
 
+  bool IsPriority() const { return !!(mNextAndMatchKind & kPriorityMask); }
+
+  // Callbacks that exact-match a single pref name live in gExactCallbacks
+  // rather than on the gFirstCallback list.
+  bool IsIndexed() const {
+    return MatchKind() == Preferences::ExactMatch && mDomain.is<nsCString>();
+  }
+
   bool DomainIs(const nsACString& aDomain) const {
     return mDomain.is<nsCString>() && mDomain.as<nsCString>() == aDomain;
   }
@@ -1156,10 +1164,10 @@ class CallbackNode {
   }
 
   void SetNext(CallbackNode* aNext) {
-    uintptr_t matchKind = mNextAndMatchKind & kMatchKindMask;
+    uintptr_t tags = mNextAndMatchKind & kTagMask;
     mNextAndMatchKind = reinterpret_cast<uintptr_t>(aNext);
-    MOZ_ASSERT((mNextAndMatchKind & kMatchKindMask) == 0);
-    mNextAndMatchKind |= matchKind;
+    MOZ_ASSERT((mNextAndMatchKind & kTagMask) == 0);
+    mNextAndMatchKind |= tags;
   }
 
   void AddSizeOfIncludingThis(MallocSizeOf aMallocSizeOf, PrefsSizes& aSizes) {
@@ -1172,7 +1180,9 @@ class CallbackNode {
 
  private:
   static const uintptr_t kMatchKindMask = uintptr_t(0x1);
-  static const uintptr_t kNextMask = ~kMatchKindMask;
+  static const uintptr_t kPriorityMask = uintptr_t(0x2);
+  static const uintptr_t kTagMask = kMatchKindMask | kPriorityMask;
+  static const uintptr_t kNextMask = ~kTagMask;
 
   Variant<nsCString, const char**> mDomain;
 
@@ -1182,10 +1192,12 @@ class CallbackNode {
   PrefChangedFunc mFunc;
   void* mData;
 
-  // Conceptually this is two fields:
+  // Conceptually this is three fields:
   // - CallbackNode* mNext;
   // - Preferences::MatchKind mMatchKind;
-  // They are combined into a tagged pointer to save memory.
+  // - bool mIsPriority;
+  // They are combined into a tagged pointer to save memory. (mNext is unused
+  // for indexed nodes, but keeping the representation uniform is simpler.)
   uintptr_t mNextAndMatchKind;
 };
 
@@ -1216,9 +1228,19 @@ static AntiFootgunMap* gOnceStaticPrefsAntiFootgun;
 
 // The callback list contains all the priority callbacks followed by the
 // non-priority callbacks. gLastPriorityNode records where the first part ends.
+// Only prefix-match callbacks and callbacks registered for multiple prefs are
+// kept on this list; see gExactCallbacks below.
 static CallbackNode* gFirstCallback = nullptr;
 static CallbackNode* gLastPriorityNode = nullptr;
 
+// Callbacks that exact-match a single pref are indexed by pref name here, so
+// that NotifyCallbacks() doesn't have to walk every registered callback to
+// notify a change to one pref. The vast majority of callbacks (e.g. all the
+// StaticPrefs mirror updaters) are of this kind. Created lazily by the first
+// such registration.
+using CallbackBucket = nsTArray<CallbackNode*>;
+static nsTHashMap<nsCStringHashKey, CallbackBucket>* gExactCallbacks = nullptr;
+
 #ifdef DEBUG
 #  define ACCESS_COUNTS
 #endif
@@ -1665,6 +1687,56 @@ static CallbackNode* pref_RemoveCallbackNode(CallbackNode* aNode,
   return next_node;
 }
 
+// Removes matching callbacks from gExactCallbacks. Returns true if callbacks
+// for this domain and match kind could only live in the index, in which case
+// the caller doesn't need to search the gFirstCallback list.
+static bool pref_UnregisterIndexedCallbacks(const nsACString& aDomain,
+                                            Preferences::MatchKind aMatchKind,
+                                            PrefChangedFunc aCallback,
+                                            void* aData, nsresult& aRv) {
+  if (aMatchKind != Preferences::ExactMatch) {
+    return false;
+  }
+  if (!gExactCallbacks) {
+    return true;
+  }
+  auto lookup = gExactCallbacks->Lookup(aDomain);
+  if (!lookup) {
+    return true;
+  }
+
+  CallbackBucket& bucket = lookup.Data();
+  for (size_t i = bucket.Length(); i > 0; i--) {
+    CallbackNode* node = bucket[i - 1];
+    // The bucket only holds exact matches on aDomain, so the domain and
+    // match kind don't need to be re-checked.
+    if (node->Func() == aCallback && node->Data() == aData) {
+      if (gCallbacksInProgress) {
+        // Postpone the node removal until after callbacks enumeration is
+        // finished.
+        node->ClearFunc();
+        gShouldCleanupDeadNodes = true;
+      } else {
+        bucket.RemoveElementAt(i - 1);
+        delete node;
+      }
+      aRv = NS_OK;
+    }
+  }
+  if (bucket.IsEmpty()) {
+    lookup.Remove();
+  }
+  return true;
+}
+
+static bool pref_UnregisterIndexedCallbacks(const char** aDomains,
+                                            Preferences::MatchKind aMatchKind,
+                                            PrefChangedFunc aCallback,
+                                            void* aData, nsresult& aRv) {
+  // Multi-pref callbacks are never indexed.
+  return false;
+}
+
 static void NotifyCallbacks(const nsCString& aPrefName,
                             const PrefWrapper* aPref) {
   bool reentered = gCallbacksInProgress;
@@ -1678,9 +1750,28 @@ static void NotifyCallbacks(const nsCString& aPrefName,
   // if we haven't reentered.
   gCallbacksInProgress = true;
 
-  for (CallbackNode* node = gFirstCallback; node; node = node->Next()) {
-    if (node->Func()) {
-      if (node->Matches(aPrefName)) {
+  // Snapshot the bucket for this pref: a callback may register further
+  // callbacks, which can grow the bucket or rehash the index under us. The
+  // nodes themselves are safe to hold across the calls because they are not
+  // deleted while gCallbacksInProgress is true.
+  AutoTArray<CallbackNode*, 4> exactNodes;
+  if (gExactCallbacks) {
+    if (auto lookup = gExactCallbacks->Lookup(aPrefName)) {
+      exactNodes.AppendElements(lookup.Data());
+    }
+  }
+
+  // Priority callbacks must all run before non-priority ones: they update the
+  // StaticPrefs mirror variables, which non-priority callbacks may read.
+  for (const bool priority : {true, false}) {
+    for (CallbackNode* node : exactNodes) {
+      if (node->IsPriority() == priority && node->Func()) {
+        (node->Func())(aPrefName.get(), node->Data());
+      }
+    }
+    for (CallbackNode* node = gFirstCallback; node; node = node->Next()) {
+      if (node->IsPriority() == priority && node->Func() &&
+          node->Matches(aPrefName)) {
         (node->Func())(aPrefName.get(), node->Data());
       }
     }
@@ -1700,6 +1791,22 @@ static void NotifyCallbacks(const nsCString& aPrefName,
         node = node->Next();
       }
     }
+
+    if (gExactCallbacks) {
+      for (auto iter = gExactCallbacks->Iter(); !iter.Done(); iter.Next()) {
+        iter.Data().RemoveElementsBy([](CallbackNode* aNode) {
+          if (aNode->Func()) {
+            return false;
+          }
+          delete aNode;
+          return true;
+        });
+        if (iter.Data().IsEmpty()) {
+          iter.Remove();
+        }
+      }
+    }
+
     gShouldCleanupDeadNodes = false;
   }
 
@@ -3127,6 +3234,18 @@ PreferenceServiceReporter::CollectReports(
     node->AddSizeOfIncludingThis(mallocSizeOf, sizes);
   }
 
+  if (gExactCallbacks) {
+    sizes.mCallbacksObjects +=
+        gExactCallbacks->ShallowSizeOfIncludingThis(mallocSizeOf);
+    for (auto iter = gExactCallbacks->Iter(); !iter.Done(); iter.Next()) {
+      sizes.mCallbacksObjects +=
+          iter.Data().ShallowSizeOfExcludingThis(mallocSizeOf);
+      for (CallbackNode* node : iter.Data()) {
+        node->AddSizeOfIncludingThis(mallocSizeOf, sizes);
+      }
+    }
+  }
+
   if (gSharedMap) {
     sizes.mMisc += mallocSizeOf(gSharedMap);
   }
@@ -3500,6 +3619,16 @@ Preferences::~Preferences() {
   }
   gLastPriorityNode = gFirstCallback = nullptr;
 
+  if (gExactCallbacks) {
+    for (auto iter = gExactCallbacks->Iter(); !iter.Done(); iter.Next()) {
+      for (CallbackNode* indexedNode : iter.Data()) {
+        delete indexedNode;
+      }
+    }
+    delete gExactCallbacks;
+    gExactCallbacks = nullptr;
+  }
+
   delete HashTable();
   HashTable() = nullptr;
 
@@ -5113,7 +5242,17 @@ nsresult Preferences::RegisterCallbackImpl(PrefChangedFunc aCallback,
 
   NS_ENSURE_TRUE(InitStaticMembers(), NS_ERROR_NOT_AVAILABLE);
 
-  auto node = new CallbackNode(aPrefNode, aCallback, aData, aMatchKind);
+  auto node = new CallbackNode(aPrefNode, aCallback, aData, aMatchKind,
+                               aIsPriority);
+
+  if (node->IsIndexed()) {
+    if (!gExactCallbacks) {
+      gExactCallbacks = new nsTHashMap<nsCStringHashKey, CallbackBucket>();
+    }
+    gExactCallbacks->LookupOrInsert(node->Domain().as<nsCString>())
+        .AppendElement(node);
+    return NS_OK;
+  }
 
   if (aIsPriority) {
     // Add to the start of the list.
@@ -5193,6 +5332,11 @@ nsresult Preferences::UnregisterCallbackImpl(PrefChangedFunc aCallback,
   NS_ENSURE_TRUE(sPreferences, NS_ERROR_NOT_AVAILABLE);
 
   nsresult rv = NS_ERROR_FAILURE;
+  if (pref_UnregisterIndexedCallbacks(aPrefNode, aMatchKind, aCallback, aData,
+                                      rv)) {
+    return rv;
+  }
+
   CallbackNode* node = gFirstCallback;
   CallbackNode* prev_node = nullptr;
 
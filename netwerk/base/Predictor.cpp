@@ -75,6 +75,11 @@ static const uint32_t ONE_YEAR = 365U * ONE_DAY;
 
 static const uint32_t STARTUP_WINDOW = 5U * 60U;  // 5min
 
+// Upper bound on the number of origins we remember speculative actions for.
+// The table only needs to cover origins the user is actively navigating
+// between, so when it fills up we just start over.
+static const uint32_t kMaxRecentPredictions = 100;
+
 // Version of metadata entries we expect
 static const uint32_t METADATA_VERSION = 1;
 
@@ -569,6 +574,15 @@ Predictor::PredictNative(nsIURI* targetURI, nsIURI* sourceURI,
       return NS_ERROR_INVALID_ARG;
   }
 
+  if (reason == nsINetworkPredictor::PREDICT_LOAD && !verifier) {
+    // Fire the previous navigation's speculative actions for this origin
+    // right away, before the async cache opens below complete. The
+    // cache-backed prediction still runs and refreshes the remembered
+    // actions; duplicated speculative connects are coalesced by the
+    // connection manager, so the overlap is cheap.
+    MaybeReplayRecentPrediction(targetURI, originAttributes);
+  }
+
   Predictor::Reason argReason{};
   argReason.mPredict = reason;
 
@@ -752,6 +766,8 @@ bool Predictor::PredictForPageload(nsICacheEntry* entry, nsIURI* targetURI,
   CalculatePredictions(entry, targetURI, lastLoad, loadCount, globalDegradation,
                        fullUri);
 
+  RememberRecentPrediction(targetURI);
+
   return RunPredictions(targetURI, *lci->OriginAttributesPtr(), verifier);
 }
 
@@ -1210,6 +1226,112 @@ bool Predictor::RunPredictions(nsIURI* referrer,
   return predicted;
 }
 
+void Predictor::RememberRecentPrediction(nsIURI* targetURI) {
+  MOZ_ASSERT(NS_IsMainThread());
+
+  if (mPrefetches.IsEmpty() && mPreconnects.IsEmpty() &&
+      mPreresolves.IsEmpty()) {
+    return;
+  }
+
+  nsCOMPtr<nsIURI> origin;
+  nsresult rv = ExtractOrigin(targetURI, getter_AddRefs(origin));
+  if (NS_FAILED(rv)) {
+    return;
+  }
+  nsAutoCString originKey;
+  origin->GetAsciiSpec(originKey);
+
+  if (mRecentPredictions.Count() >= kMaxRecentPredictions &&
+      !mRecentPredictions.Contains(originKey)) {
+    mRecentPredictions.Clear();
+  }
+
+  RecentPrediction& recent = mRecentPredictions.LookupOrInsert(originKey);
+
+  // One navigation produces predictions from both the full-URI and the
+  // origin-keyed cache entries, which arrive within the same tick or so.
+  // Merge those; anything older belongs to a previous navigation and is
+  // replaced.
+  TimeStamp now = TimeStamp::Now();
+  if (recent.mWhen.IsNull() || (now - recent.mWhen).ToSeconds() > 5) {
+    recent.mPreconnects.Clear();
+    recent.mPreresolves.Clear();
+  }
+  recent.mWhen = now;
+
+  auto appendUnique = [](nsTArray<nsCOMPtr<nsIURI>>& aTo,
+                         const nsTArray<nsCOMPtr<nsIURI>>& aFrom) {
+    for (const auto& uri : aFrom) {
+      bool found = false;
+      for (const auto& existing : aTo) {
+        bool equals = false;
+        if (NS_SUCCEEDED(existing->Equals(uri, &equals)) && equals) {
+          found = true;
+          break;
+        }
+      }
+      if (!found) {
+        aTo.AppendElement(uri);
+      }
+    }
+  };
+  // A prefetchable subresource will certainly need a connection on a replay,
+  // but a replay can't know whether the prefetched response would still be
+  // valid, so remember it as a preconnect.
+  appendUnique(recent.mPreconnects, mPrefetches);
+  appendUnique(recent.mPreconnects, mPreconnects);
+  appendUnique(recent.mPreresolves, mPreresolves);
+
+  PREDICTOR_LOG(
+      ("Predictor::RememberRecentPrediction origin=%s preconnects=%zu "
+       "preresolves=%zu",
+       originKey.get(), recent.mPreconnects.Length(),
+       recent.mPreresolves.Length()));
+}
+
+void Predictor::MaybeReplayRecentPrediction(
+    nsIURI* targetURI, const OriginAttributes& originAttributes) {
+  MOZ_ASSERT(NS_IsMainThread());
+
+  uint32_t replayWindow =
+      StaticPrefs::network_predictor_replay_window_seconds();
+  if (!replayWindow) {
+    return;
+  }
+
+  nsCOMPtr<nsIURI> origin;
+  nsresult rv = ExtractOrigin(targetURI, getter_AddRefs(origin));
+  if (NS_FAILED(rv)) {
+    return;
+  }
+  nsAutoCString originKey;
+  origin->GetAsciiSpec(originKey);
+
+  auto recent = mRecentPredictions.Lookup(originKey);
+  if (!recent) {
+    return;
+  }
+  if ((TimeStamp::Now() - recent->mWhen).ToSeconds() > replayWindow) {
+    recent.Remove();
+    return;
+  }
+
+  PREDICTOR_LOG(
+      ("Predictor::MaybeReplayRecentPrediction origin=%s preconnects=%zu "
+       "preresolves=%zu",
+       originKey.get(), recent->mPreconnects.Length(),
+       recent->mPreresolves.Length()));
+
+  for (const auto& uri : recent->mPreconnects) {
+    mPreconnects.AppendElement(uri);
+  }
+  for (const auto& uri : recent->mPreresolves) {
+    mPreresolves.AppendElement(uri);
+  }
+  RunPredictions(nullptr, originAttributes, nullptr);
+}
+
 // Find out if a top-level page is likely to redirect.
 bool Predictor::WouldRedirect(nsICacheEntry* entry, uint32_t loadCount,
                               uint32_t lastLoad, int32_t globalDegradation,
@@ -1742,6 +1864,8 @@ Predictor::Reset() {
     return NS_OK;
   }
 
+  mRecentPredictions.Clear();
+
   RefPtr<Predictor::Resetter> reset = new Predictor::Resetter(this);
   PREDICTOR_LOG(("    created a resetter"));
   mCacheStorageService->AsyncVisitAllStorages(reset, true);
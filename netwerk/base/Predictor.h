@@ -22,6 +22,7 @@
 #include "mozilla/RefPtr.h"
 #include "nsString.h"
 #include "nsTArray.h"
+#include "nsTHashMap.h"
 
 #include "mozilla/TimeStamp.h"
 
@@ -348,6 +349,21 @@ class Predictor final : public nsINetworkPredictor,
                       const OriginAttributes& originAttributes,
                       nsINetworkPredictorVerifier* verifier);
 
+  // Remembers the speculative actions just set up for a pageload of targetURI
+  // (keyed by its origin), so MaybeReplayRecentPrediction can fire them for
+  // the next navigation to the same origin without waiting on the cache.
+  //   * targetURI - the URI the predictions were made for
+  void RememberRecentPrediction(nsIURI* targetURI);
+
+  // Immediately fires the speculative actions remembered for the origin of
+  // targetURI, if they are recent enough. This runs ahead of (and in addition
+  // to) the cache-backed prediction, which will refresh the remembered
+  // actions once its entries open.
+  //   * targetURI - the URI of the toplevel navigation that just began
+  //   * originAttributes - the originAttributes of the navigation
+  void MaybeReplayRecentPrediction(nsIURI* targetURI,
+                                   const OriginAttributes& originAttributes);
+
   // Used to guess whether a page will redirect to another page or not. Returns
   // true if a redirection is likely.
   //   * entry - cache entry with all necessary information about this page
@@ -449,6 +465,17 @@ class Predictor final : public nsINetworkPredictor,
   nsTArray<nsCOMPtr<nsIURI>> mPreconnects;
   nsTArray<nsCOMPtr<nsIURI>> mPreresolves;
 
+  // The speculative actions most recently computed for a navigation, keyed by
+  // the ascii spec of the page's origin. Prefetchable subresources are
+  // remembered as preconnects, since a replay can't know whether the cached
+  // response is still valid.
+  struct RecentPrediction {
+    nsTArray<nsCOMPtr<nsIURI>> mPreconnects;
+    nsTArray<nsCOMPtr<nsIURI>> mPreresolves;
+    TimeStamp mWhen;
+  };
+  nsTHashMap<nsCStringHashKey, RecentPrediction> mRecentPredictions;
+
   static Predictor* sSelf;
 };
 
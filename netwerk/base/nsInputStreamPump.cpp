@@ -6,6 +6,7 @@
 
 #include "nsIOService.h"
 #include "nsInputStreamPump.h"
+#include "nsIDirectStreamListener.h"
 #include "nsIStreamTransportService.h"
 #include "nsIThreadRetargetableStreamListener.h"
 #include "nsThreadUtils.h"
@@ -331,6 +332,10 @@ nsInputStreamPump::AsyncRead(nsIStreamListener* listener) {
 
   mState = STATE_START;
   mListener = listener;
+  // Listeners that can consume data in place opt into segment delivery;
+  // OnStateTransfer then walks the pipe segments itself instead of handing
+  // the stream to OnDataAvailable.
+  mDirectListener = do_QueryInterface(listener);
   return NS_OK;
 }
 
@@ -509,55 +514,80 @@ uint32_t nsInputStreamPump::OnStateTransfer() {
     //       an infinite loop.  we do our best here to try to catch
     //       such an error.  (see bug 189672)
 
-    // in most cases this QI will succeed (mAsyncStream is almost always
-    // a nsPipeInputStream, which implements nsITellableStream::Tell).
-    int64_t offsetBefore;
-    nsCOMPtr<nsITellableStream> tellable = do_QueryInterface(mAsyncStream);
-    if (tellable && NS_FAILED(tellable->Tell(&offsetBefore))) {
-      MOZ_ASSERT_UNREACHABLE("Tell failed on readable stream");
-      offsetBefore = 0;
-    }
-
     uint32_t odaAvail = avail > UINT32_MAX ? UINT32_MAX : uint32_t(avail);
 
-    LOG(("  calling OnDataAvailable [offset=%" PRIu64 " count=%" PRIu64
-         "(%u)]\n",
-         mStreamOffset, avail, odaAvail));
-
-    {
-      // Note: Must exit mutex for call to OnStartRequest to avoid
-      // deadlocks when calls to RetargetDeliveryTo for multiple
-      // nsInputStreamPumps are needed (e.g. nsHttpChannel).
-      RecursiveMutexAutoUnlock unlock(mMutex);
-      rv = mListener->OnDataAvailable(this, mAsyncStream, mStreamOffset,
-                                      odaAvail);
-    }
+    if (mDirectListener) {
+      // Segment-delivery mode: hand each pipe segment to the listener in
+      // place rather than making it Read() into its own buffer.
+      LOG(("  calling OnDataSegment [offset=%" PRIu64 " count=%" PRIu64
+           "(%u)]\n",
+           mStreamOffset, avail, odaAvail));
+
+      uint32_t bytesRead = 0;
+      {
+        RecursiveMutexAutoUnlock unlock(mMutex);
+        rv = mAsyncStream->ReadSegments(ConsumeSegment, this, odaAvail,
+                                        &bytesRead);
+      }
 
-    // don't enter this code if ODA failed or called Cancel
-    if (NS_SUCCEEDED(rv) && NS_SUCCEEDED(mStatus)) {
-      // test to see if this ODA failed to consume data
-      if (tellable) {
-        // NOTE: if Tell fails, which can happen if the stream is
-        // now closed, then we assume that everything was read.
-        int64_t offsetAfter;
-        if (NS_FAILED(tellable->Tell(&offsetAfter))) {
-          offsetAfter = offsetBefore + odaAvail;
-        }
-        if (offsetAfter > offsetBefore) {
-          mStreamOffset += (offsetAfter - offsetBefore);
+      if (NS_SUCCEEDED(rv) && NS_SUCCEEDED(mStatus)) {
+        if (bytesRead) {
+          mStreamOffset += bytesRead;
         } else if (mSuspendCount == 0) {
-          //
-          // possible infinite loop if we continue pumping data!
-          //
-          // NOTE: although not allowed by nsIStreamListener, we
-          // will allow the ODA impl to Suspend the pump.  IMAP
-          // does this :-(
-          //
-          NS_ERROR("OnDataAvailable implementation consumed no data");
+          // see the infinite-loop note in the OnDataAvailable path below.
+          NS_ERROR("OnDataSegment implementation consumed no data");
           mStatus = NS_ERROR_UNEXPECTED;
         }
-      } else {
-        mStreamOffset += odaAvail;  // assume ODA behaved well
+      }
+    } else {
+      // in most cases this QI will succeed (mAsyncStream is almost always
+      // a nsPipeInputStream, which implements nsITellableStream::Tell).
+      int64_t offsetBefore;
+      nsCOMPtr<nsITellableStream> tellable = do_QueryInterface(mAsyncStream);
+      if (tellable && NS_FAILED(tellable->Tell(&offsetBefore))) {
+        MOZ_ASSERT_UNREACHABLE("Tell failed on readable stream");
+        offsetBefore = 0;
+      }
+
+      LOG(("  calling OnDataAvailable [offset=%" PRIu64 " count=%" PRIu64
+           "(%u)]\n",
+           mStreamOffset, avail, odaAvail));
+
+      {
+        // Note: Must exit mutex for call to OnStartRequest to avoid
+        // deadlocks when calls to RetargetDeliveryTo for multiple
+        // nsInputStreamPumps are needed (e.g. nsHttpChannel).
+        RecursiveMutexAutoUnlock unlock(mMutex);
+        rv = mListener->OnDataAvailable(this, mAsyncStream, mStreamOffset,
+                                        odaAvail);
+      }
+
+      // don't enter this code if ODA failed or called Cancel
+      if (NS_SUCCEEDED(rv) && NS_SUCCEEDED(mStatus)) {
+        // test to see if this ODA failed to consume data
+        if (tellable) {
+          // NOTE: if Tell fails, which can happen if the stream is
+          // now closed, then we assume that everything was read.
+          int64_t offsetAfter;
+          if (NS_FAILED(tellable->Tell(&offsetAfter))) {
+            offsetAfter = offsetBefore + odaAvail;
+          }
+          if (offsetAfter > offsetBefore) {
+            mStreamOffset += (offsetAfter - offsetBefore);
+          } else if (mSuspendCount == 0) {
+            //
+            // possible infinite loop if we continue pumping data!
+            //
+            // NOTE: although not allowed by nsIStreamListener, we
+            // will allow the ODA impl to Suspend the pump.  IMAP
+            // does this :-(
+            //
+            NS_ERROR("OnDataAvailable implementation consumed no data");
+            mStatus = NS_ERROR_UNEXPECTED;
+          }
+        } else {
+          mStreamOffset += odaAvail;  // assume ODA behaved well
+        }
       }
     }
   }
@@ -581,6 +611,27 @@ uint32_t nsInputStreamPump::OnStateTransfer() {
   return STATE_STOP;
 }
 
+// static
+nsresult nsInputStreamPump::ConsumeSegment(nsIInputStream* aStream,
+                                           void* aClosure,
+                                           const char* aFromSegment,
+                                           uint32_t aToOffset, uint32_t aCount,
+                                           uint32_t* aWriteCount) {
+  auto* self = static_cast<nsInputStreamPump*>(aClosure);
+
+  // mStreamOffset is only advanced once the whole ReadSegments call is
+  // done, so add the offset of this segment within the batch.
+  nsresult rv = self->mDirectListener->OnDataSegment(
+      self, self->mStreamOffset + aToOffset,
+      reinterpret_cast<const uint8_t*>(aFromSegment), aCount);
+  if (NS_FAILED(rv)) {
+    return rv;
+  }
+
+  *aWriteCount = aCount;
+  return NS_OK;
+}
+
 nsresult nsInputStreamPump::CallOnStateStop() {
   RecursiveMutexAutoLock lock(mMutex);
 
@@ -636,6 +687,7 @@ uint32_t nsInputStreamPump::OnStateStop() {
     mListener->OnStopRequest(this, mStatus);
   }
   mListener = nullptr;
+  mDirectListener = nullptr;
 
   if (mLoadGroup) mLoadGroup->RemoveRequest(this, nullptr, mStatus);
 
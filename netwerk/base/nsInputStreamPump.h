@@ -13,6 +13,7 @@
 #include "mozilla/Attributes.h"
 #include "mozilla/RecursiveMutex.h"
 
+class nsIDirectStreamListener;
 class nsIInputStream;
 class nsILoadGroup;
 class nsIStreamListener;
@@ -74,9 +75,17 @@ class nsInputStreamPump final : public nsIInputStreamPump,
   uint32_t OnStateStop();
   nsresult CreateBufferedStreamIfNeeded();
 
+  // nsWriteSegmentFun forwarding one pipe segment to mDirectListener.
+  static nsresult ConsumeSegment(nsIInputStream* aStream, void* aClosure,
+                                 const char* aFromSegment, uint32_t aToOffset,
+                                 uint32_t aCount, uint32_t* aWriteCount);
+
   uint32_t mState{STATE_IDLE};
   nsCOMPtr<nsILoadGroup> mLoadGroup;
   nsCOMPtr<nsIStreamListener> mListener;
+  // Non-null while pumping to a listener that opted into in-place segment
+  // delivery; see nsIDirectStreamListener.
+  nsCOMPtr<nsIDirectStreamListener> mDirectListener;
   nsCOMPtr<nsIEventTarget> mTargetThread;
   nsCOMPtr<nsIEventTarget> mLabeledMainThreadTarget;
   nsCOMPtr<nsIInputStream> mStream;
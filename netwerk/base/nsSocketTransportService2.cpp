@@ -1315,6 +1315,14 @@ nsresult nsSocketTransportService::DoPollIteration(TimeDuration* pollDuration) {
   // should become active.  take care to check only idle sockets that
   // were idle to begin with ;-)
   //
+  // Nearest deadline over all engaged socket timeouts, tracked while we
+  // refresh the poll flags below.  With it the post-poll service pass can
+  // stop as soon as every descriptor poll() reported ready has been
+  // handled, instead of probing each of the (possibly thousands of)
+  // remaining active sockets for an expired timeout on every wakeup.
+  bool hasDeadline = false;
+  PRIntervalTime nearestDeadline = 0;
+
   count = mIdleCount;
   for (i = mActiveCount - 1; i >= 0; --i) {
     //---
@@ -1335,6 +1343,21 @@ nsresult nsSocketTransportService::DoPollIteration(TimeDuration* pollDuration) {
         mPollList[i + 1].in_flags = in_flags;
         mPollList[i + 1].out_flags = 0;
         mActiveList[i].EnsureTimeout(now);
+        if (mActiveList[i].mHandler->mPollTimeout != UINT16_MAX) {
+          PRIntervalTime deadline =
+              mActiveList[i].mPollStartEpoch +
+              PR_SecondsToInterval(mActiveList[i].mHandler->mPollTimeout);
+          if (!hasDeadline ||
+              static_cast<int32_t>(deadline - nearestDeadline) < 0) {
+            hasDeadline = true;
+            nearestDeadline = deadline;
+          }
+        } else {
+          // a disabled timeout may leave a stale epoch behind; reset it
+          // here since the service pass below no longer visits sockets
+          // that aren't ready.
+          mActiveList[i].MaybeResetEpoch();
+        }
       }
     }
   }
@@ -1401,18 +1424,29 @@ nsresult nsSocketTransportService::DoPollIteration(TimeDuration* pollDuration) {
     //
     // service "active" sockets...
     //
+    // only probe for expired timeouts when the nearest engaged deadline
+    // has actually passed; otherwise this pass only needs to visit the
+    // descriptors poll() flagged ready.
+    bool checkTimeouts =
+        hasDeadline && static_cast<int32_t>(now - nearestDeadline) >= 0;
+    int32_t readyCount = n > 0 ? n : 0;
+    if (readyCount && mPollList[0].fd && mPollList[0].out_flags != 0) {
+      readyCount--;  // the pollable event is serviced separately below
+    }
     for (i = 0; i < int32_t(mActiveCount); ++i) {
+      if (!readyCount && !checkTimeouts) {
+        break;
+      }
       PRPollDesc& desc = mPollList[i + 1];
       SocketContext& s = mActiveList[i];
       if (n > 0 && desc.out_flags != 0) {
+        readyCount--;
         s.DisengageTimeout();
         s.mHandler->OnSocketReady(desc.fd, desc.out_flags);
-      } else if (s.IsTimedOut(now)) {
+      } else if (checkTimeouts && s.IsTimedOut(now)) {
         SOCKET_LOG(("socket %p timed out", s.mHandler));
         s.DisengageTimeout();
         s.mHandler->OnSocketReady(desc.fd, -1);
-      } else {
-        s.MaybeResetEpoch();
       }
     }
     //
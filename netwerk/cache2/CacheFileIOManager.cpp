@@ -32,9 +32,10 @@
 #include "mozilla/Preferences.h"
 #include "nsNetUtil.h"
 
-// include files for ftruncate (or equivalent)
+// include files for ftruncate and posix_fadvise (or equivalent)
 #if defined(XP_UNIX)
 #  include <unistd.h>
+#  include <fcntl.h>
 #elif defined(XP_WIN)
 #  include <windows.h>
 #  undef CreateFile
@@ -48,7 +49,16 @@ namespace mozilla::net {
 #define kOpenHandlesLimit 128
 #define kMetadataWriteDelay 5000
 #define kRemoveTrashStartDelay 60000    // in milliseconds
+// Trash files are unlinked in batches of this size on background threads so
+// that removing a huge cache doesn't monopolize the IO thread. Only this many
+// batches may be in flight at once to bound memory and thread pool usage.
+#define kTrashRemovalBatchSize 64
+#define kMaxTrashRemovalsInFlight 4
 #define kSmartSizeUpdateInterval 60000  // in milliseconds
+// Entry files up to this size are hinted to the kernel for readahead when
+// they are opened for reading. Larger files are left alone so that a single
+// big entry doesn't evict the rest of the page cache.
+#define kReadAheadFileSizeLimit (8 * 1024 * 1024)  // in bytes
 
 #ifdef ANDROID
 const uint32_t kMaxCacheSizeKB = 512 * 1024;  // 512 MB
@@ -3432,6 +3442,16 @@ nsresult CacheFileIOManager::RemoveTrashInternal() {
     // We null out mTrashDirEnumerator once we remove all files in the
     // directory, so remove the trash directory if we don't have enumerator.
     if (!mTrashDirEnumerator) {
+      if (mTrashRemovalsInFlight) {
+        // Some batches of files from this directory are still being unlinked
+        // on background threads. The last OnTrashBatchRemoved() will get us
+        // here again.
+        LOG(
+            ("CacheFileIOManager::RemoveTrashInternal() - Waiting for "
+             "removal batches before removing the directory."));
+        return NS_OK;
+      }
+
       rv = mTrashDir->Remove(false);
       if (NS_FAILED(rv)) {
         // There is no reason why removing an empty directory should fail, but
@@ -3450,35 +3470,97 @@ nsresult CacheFileIOManager::RemoveTrashInternal() {
       continue;  // check elapsed time
     }
 
-    nsCOMPtr<nsIFile> file;
-    rv = mTrashDirEnumerator->GetNextFile(getter_AddRefs(file));
-    if (!file) {
-      mTrashDirEnumerator->Close();
-      mTrashDirEnumerator = nullptr;
-      continue;  // check elapsed time
+    if (mTrashRemovalsInFlight >= kMaxTrashRemovalsInFlight) {
+      // Enough unlinking work is queued already, don't enumerate further
+      // until some of it finishes. OnTrashBatchRemoved() restarts us.
+      LOG(
+          ("CacheFileIOManager::RemoveTrashInternal() - Too many removal "
+           "batches in flight, waiting for one to finish."));
+      return NS_OK;
     }
-    bool isDir = false;
-    file->IsDirectory(&isDir);
-    if (isDir) {
-      NS_WARNING(
-          "Found a directory in a trash directory! It will be removed "
-          "recursively, but this can block IO thread for a while!");
-      if (LOG_ENABLED()) {
-        LOG(
-            ("CacheFileIOManager::RemoveTrashInternal() - Found a directory in "
-             "a trash "
-             "directory! It will be removed recursively, but this can block IO "
-             "thread for a while! [file=%s]",
-             file->HumanReadablePath().get()));
+
+    nsTArray<nsCOMPtr<nsIFile>> batch;
+    while (batch.Length() < kTrashRemovalBatchSize) {
+      nsCOMPtr<nsIFile> file;
+      rv = mTrashDirEnumerator->GetNextFile(getter_AddRefs(file));
+      if (!file) {
+        mTrashDirEnumerator->Close();
+        mTrashDirEnumerator = nullptr;
+        break;
       }
+      bool isDir = false;
+      file->IsDirectory(&isDir);
+      if (isDir) {
+        NS_WARNING(
+            "Found a directory in a trash directory! It will be removed "
+            "recursively, but this can block IO thread for a while!");
+        if (LOG_ENABLED()) {
+          LOG(
+              ("CacheFileIOManager::RemoveTrashInternal() - Found a directory "
+               "in a trash "
+               "directory! It will be removed recursively, but this can block "
+               "IO thread for a while! [file=%s]",
+               file->HumanReadablePath().get()));
+        }
+        file->Remove(true);
+        continue;
+      }
+      batch.AppendElement(std::move(file));
+    }
+
+    if (batch.IsEmpty()) {
+      continue;  // check elapsed time
+    }
+
+    // Unlink the batch of files on a background thread. Only plain files are
+    // removed there; directory enumeration and removal stay serialized on
+    // this thread.
+    mTrashRemovalsInFlight++;
+    RefPtr<CacheFileIOManager> self = this;
+    rv = NS_DispatchBackgroundTask(
+        NS_NewRunnableFunction(
+            "net::CacheFileIOManager::RemoveTrashBatch",
+            [self, batch = std::move(batch)]() {
+              for (const auto& file : batch) {
+                file->Remove(false);
+              }
+              nsCOMPtr<nsIRunnable> ev = NewRunnableMethod(
+                  "net::CacheFileIOManager::OnTrashBatchRemoved", self,
+                  &CacheFileIOManager::OnTrashBatchRemoved);
+              self->mIOThread->Dispatch(ev, CacheIOThread::EVICT);
+            }),
+        NS_DISPATCH_EVENT_MAY_BLOCK);
+    if (NS_WARN_IF(NS_FAILED(rv))) {
+      // This happens only during xpcom shutdown. Removal of the directory
+      // will fail because of the leftover files and the directory will be
+      // retried during the next trash sweep via mFailedTrashDirs.
+      mTrashRemovalsInFlight--;
     }
-    file->Remove(isDir);
   }
 
   MOZ_ASSERT_UNREACHABLE("We should never get here");
   return NS_OK;
 }
 
+void CacheFileIOManager::OnTrashBatchRemoved() {
+  LOG(("CacheFileIOManager::OnTrashBatchRemoved()"));
+
+  MOZ_ASSERT(mIOThread->IsCurrentThread());
+  MOZ_ASSERT(mTrashRemovalsInFlight);
+
+  mTrashRemovalsInFlight--;
+
+  if (mShuttingDown) {
+    return;
+  }
+
+  // Continue the sweep in case RemoveTrashInternal() stopped enumerating
+  // because too many batches were in flight or because it was waiting for
+  // this directory's batches before removing the directory itself.
+  // StartRemovingTrash() is a no-op if a continuation is already scheduled.
+  StartRemovingTrash();
+}
+
 nsresult CacheFileIOManager::FindTrashDirToRemove() {
   LOG(("CacheFileIOManager::FindTrashDirToRemove()"));
 
@@ -3951,6 +4033,21 @@ nsresult CacheFileIOManager::OpenNSPRHandle(CacheFileHandle* aHandle,
            static_cast<uint32_t>(rv)));
     }
     NS_ENSURE_SUCCESS(rv, rv);
+
+#if defined(HAVE_POSIX_FADVISE)
+    if (!aHandle->IsSpecialFile() && aHandle->mFileSize > 0 &&
+        aHandle->mFileSize <= kReadAheadFileSizeLimit) {
+      // Ask the kernel to start reading the file into the page cache in the
+      // background. The first read of an entry fetches the metadata from the
+      // end of the file and reads of the data chunks usually follow shortly,
+      // so by the time they reach this thread they mostly hit memory. Since
+      // all I/O is funneled through this single thread, this also lets the
+      // disk work on several independent entries at once instead of getting
+      // one blocking read at a time.
+      posix_fadvise(PR_FileDesc2NativeHandle(aHandle->mFD), 0, 0,
+                    POSIX_FADV_WILLNEED);
+    }
+#endif
   }
 
   mHandlesByLastUsed.AppendElement(aHandle);
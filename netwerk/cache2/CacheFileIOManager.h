@@ -404,6 +404,7 @@ class CacheFileIOManager final : public nsITimerCallback, public nsINamed {
   static void OnTrashTimer(nsITimer* aTimer, void* aClosure);
   nsresult StartRemovingTrash();
   nsresult RemoveTrashInternal();
+  void OnTrashBatchRemoved();
   nsresult FindTrashDirToRemove();
 
   nsresult CreateFile(CacheFileHandle* aHandle);
@@ -470,6 +471,9 @@ class CacheFileIOManager final : public nsITimerCallback, public nsINamed {
   nsCOMPtr<nsITimer> mTrashTimer;
   nsCOMPtr<nsIFile> mTrashDir;
   nsCOMPtr<nsIDirectoryEnumerator> mTrashDirEnumerator;
+  // Number of batches of trash files currently being unlinked on background
+  // threads. Accessed only on the IO thread.
+  uint32_t mTrashRemovalsInFlight{0};
   nsTArray<nsCString> mFailedTrashDirs;
   RefPtr<CacheFileContextEvictor> mContextEvictor;
   TimeStamp mLastSmartSizeTime;
@@ -26,7 +26,11 @@
 #define kMinUnwrittenChanges 300
 #define kMinDumpInterval 20000  // in milliseconds
 #define kMaxBufSize 16384
-#define kIndexVersion 0x0000000A
+#define kIndexVersion 0x0000000B
+// The whole index is dumped instead of appending a journal batch when the
+// journal would grow over 1/kMaxJournalRatio of the number of entries in the
+// index, to keep the replay cost at startup bounded.
+#define kMaxJournalRatio 4
 #define kUpdateIndexStartDelay 50000  // in milliseconds
 #define kTelemetryReportBytesLimit (2U * 1024U * 1024U * 1024U)  // 2GB
 
@@ -1072,8 +1076,8 @@ nsresult CacheIndex::RemoveAll() {
     AutoRestore<bool> saveRemovingAll(index->mRemovingAll);
     index->mRemovingAll = true;
 
-    // Doom index and journal handles but don't null them out since this will be
-    // done in FinishWrite/FinishRead methods.
+    // Doom the index handle but don't null it out since this will be done in
+    // FinishWrite/FinishRead methods.
     if (index->mIndexHandle) {
       CacheFileIOManager::DoomFile(index->mIndexHandle, nullptr);
     } else {
@@ -1084,8 +1088,15 @@ nsresult CacheIndex::RemoveAll() {
 
     if (index->mJournalHandle) {
       CacheFileIOManager::DoomFile(index->mJournalHandle, nullptr);
+      // Unlike mIndexHandle, the journal handle may be kept open in READY
+      // state for appending batches, so null it out here instead of relying
+      // on FinishWrite/FinishRead.
+      index->mJournalHandle = nullptr;
     }
 
+    index->mJournalEntryCount = 0;
+    index->mJournalAppendFailed = false;
+
     switch (index->mState) {
       case WRITING:
         index->FinishWrite(false, lock);
@@ -1645,7 +1656,17 @@ bool CacheIndex::WriteIndexToDiskIfNeeded(
     return false;
   }
 
-  WriteIndexToDisk(aProofOfLock);
+  // Most of the time only a small fraction of the index is dirty, so append
+  // the changes to the journal instead of rewriting the whole index file.
+  // Once the journal grows to a significant fraction of the index, fall back
+  // to a full dump, which makes the journal written so far obsolete.
+  if (mIndexOnDiskIsValid && !mJournalAppendFailed &&
+      (mJournalEntryCount + mIndexStats.Dirty()) * kMaxJournalRatio <
+          mIndexStats.ActiveEntriesCount()) {
+    WriteJournalBatchToDisk(aProofOfLock);
+  } else {
+    WriteIndexToDisk(aProofOfLock);
+  }
   return true;
 }
 
@@ -1687,8 +1708,8 @@ void CacheIndex::WriteIndexToDisk(const StaticMutexAutoLock& aProofOfLock) {
   NetworkEndian::writeUint32(mRWBuf + mRWBufPos, kIndexVersion);
   mRWBufPos += sizeof(uint32_t);
   // timestamp
-  NetworkEndian::writeUint32(mRWBuf + mRWBufPos,
-                             static_cast<uint32_t>(PR_Now() / PR_USEC_PER_SEC));
+  mPendingIndexTimeStamp = static_cast<uint32_t>(PR_Now() / PR_USEC_PER_SEC);
+  NetworkEndian::writeUint32(mRWBuf + mRWBufPos, mPendingIndexTimeStamp);
   mRWBufPos += sizeof(uint32_t);
   // dirty flag
   NetworkEndian::writeUint32(mRWBuf + mRWBufPos, 1);
@@ -1793,6 +1814,147 @@ void CacheIndex::WriteRecords(const StaticMutexAutoLock& aProofOfLock) {
   mRWBufPos = 0;
 }
 
+void CacheIndex::WriteJournalBatchToDisk(
+    const StaticMutexAutoLock& aProofOfLock) {
+  LOG(("CacheIndex::WriteJournalBatchToDisk()"));
+  mIndexStats.Log();
+
+  nsresult rv;
+
+  MOZ_ASSERT(mState == READY);
+  MOZ_ASSERT(!mRWBuf);
+  MOZ_ASSERT(!mRWHash);
+  MOZ_ASSERT(!mRWPending);
+  MOZ_ASSERT(mIndexOnDiskIsValid);
+  MOZ_ASSERT(!mJournalAppendFailed);
+
+  ChangeState(WRITING, aProofOfLock);
+  mWritingJournalBatch = true;
+
+  mProcessEntries = 0;
+  for (auto iter = mIndex.Iter(); !iter.Done(); iter.Next()) {
+    CacheIndexEntry* entry = iter.Get();
+    if (entry->IsRemoved() || entry->IsDirty()) {
+      mProcessEntries++;
+    }
+  }
+
+  mSkipEntries = 0;
+
+  if (mJournalHandle) {
+    WriteJournalRecords(aProofOfLock);
+    return;
+  }
+
+  // This is the first batch since the last full dump of the index (or since
+  // startup). CREATE_NEW wipes any journal left over on disk whose batches
+  // are already contained in the index file.
+  mJournalFileOpener = new FileOpenHelper(this);
+  rv = CacheFileIOManager::OpenFile(
+      nsLiteralCString(JOURNAL_NAME),
+      CacheFileIOManager::SPECIAL_FILE | CacheFileIOManager::CREATE_NEW,
+      mJournalFileOpener);
+  if (NS_FAILED(rv)) {
+    LOG(
+        ("CacheIndex::WriteJournalBatchToDisk() - Can't open file "
+         "[rv=0x%08" PRIx32 "]",
+         static_cast<uint32_t>(rv)));
+    FinishWrite(false, aProofOfLock);
+  }
+}
+
+void CacheIndex::WriteJournalRecords(const StaticMutexAutoLock& aProofOfLock) {
+  LOG(("CacheIndex::WriteJournalRecords()"));
+
+  nsresult rv;
+
+  MOZ_ASSERT(mState == WRITING);
+  MOZ_ASSERT(mWritingJournalBatch);
+  MOZ_ASSERT(mJournalHandle);
+  MOZ_ASSERT(!mRWPending);
+
+  int64_t fileOffset;
+
+  if (!mRWBuf) {
+    // First chunk of the batch, write the batch header to the buffer. Unlike
+    // the hash in the index file, the batch hash covers the header too.
+    MOZ_ASSERT(mSkipEntries == 0);
+    mJournalAppendOffset = mJournalHandle->FileSize();
+    AllocBuffer();
+    mRWHash = new CacheHash();
+
+    mRWBufPos = 0;
+    // number of records in the batch
+    NetworkEndian::writeUint32(mRWBuf + mRWBufPos, mProcessEntries);
+    mRWBufPos += sizeof(uint32_t);
+    // timestamp of the index file this batch applies to
+    NetworkEndian::writeUint32(mRWBuf + mRWBufPos, mIndexTimeStamp);
+    mRWBufPos += sizeof(uint32_t);
+
+    fileOffset = mJournalAppendOffset;
+  } else {
+    MOZ_ASSERT(mRWBufPos == 0);
+    fileOffset = mJournalAppendOffset + 2 * sizeof(uint32_t);
+    fileOffset += sizeof(CacheIndexRecord) * mSkipEntries;
+  }
+
+  char* buf = mRWBuf + mRWBufPos;
+  uint32_t skip = mSkipEntries;
+  uint32_t processMax = (mRWBufSize - mRWBufPos) / sizeof(CacheIndexRecord);
+  uint32_t processed = 0;
+  for (auto iter = mIndex.Iter(); !iter.Done(); iter.Next()) {
+    CacheIndexEntry* entry = iter.Get();
+    if (!entry->IsRemoved() && !entry->IsDirty()) {
+      continue;
+    }
+
+    if (skip) {
+      skip--;
+      continue;
+    }
+
+    if (processed == processMax) {
+      break;
+    }
+
+    entry->WriteToBuf(buf);
+    buf += sizeof(CacheIndexRecord);
+    processed++;
+  }
+
+  mRWBufPos = buf - mRWBuf;
+  mSkipEntries += processed;
+  MOZ_ASSERT(mSkipEntries <= mProcessEntries);
+
+  mRWHash->Update(mRWBuf, mRWBufPos);
+
+  if (mSkipEntries == mProcessEntries) {
+    // We've processed all records
+    if (mRWBufPos + sizeof(CacheHash::Hash32_t) > mRWBufSize) {
+      // realloc buffer to spare another write cycle
+      mRWBufSize = mRWBufPos + sizeof(CacheHash::Hash32_t);
+      mRWBuf = static_cast<char*>(moz_xrealloc(mRWBuf, mRWBufSize));
+    }
+
+    NetworkEndian::writeUint32(mRWBuf + mRWBufPos, mRWHash->GetHash());
+    mRWBufPos += sizeof(CacheHash::Hash32_t);
+  }
+
+  rv = CacheFileIOManager::Write(mJournalHandle, fileOffset, mRWBuf, mRWBufPos,
+                                 mSkipEntries == mProcessEntries, false, this);
+  if (NS_FAILED(rv)) {
+    LOG(
+        ("CacheIndex::WriteJournalRecords() - CacheFileIOManager::Write() "
+         "failed synchronously [rv=0x%08" PRIx32 "]",
+         static_cast<uint32_t>(rv)));
+    FinishWrite(false, aProofOfLock);
+  } else {
+    mRWPending = true;
+  }
+
+  mRWBufPos = 0;
+}
+
 void CacheIndex::FinishWrite(bool aSucceeded,
                              const StaticMutexAutoLock& aProofOfLock) {
   LOG(("CacheIndex::FinishWrite() [succeeded=%d]", aSucceeded));
@@ -1810,6 +1972,7 @@ void CacheIndex::FinishWrite(bool aSucceeded,
   if (aSucceeded) {
     // Opening of the file must not be in progress if writing succeeded.
     MOZ_ASSERT(!mIndexFileOpener);
+    MOZ_ASSERT(!mJournalFileOpener);
 
     for (auto iter = mIndex.Iter(); !iter.Done(); iter.Next()) {
       CacheIndexEntry* entry = iter.Get();
@@ -1830,8 +1993,25 @@ void CacheIndex::FinishWrite(bool aSucceeded,
       }
     }
 
-    mIndexOnDiskIsValid = true;
+    if (mWritingJournalBatch) {
+      mJournalEntryCount += mProcessEntries;
+    } else {
+      // The full dump supersedes all batches appended to the journal so far.
+      // The next batch wipes the journal file and starts over.
+      mIndexTimeStamp = mPendingIndexTimeStamp;
+      mJournalEntryCount = 0;
+      mJournalAppendFailed = false;
+      mJournalHandle = nullptr;
+      mIndexOnDiskIsValid = true;
+    }
   } else {
+    if (mWritingJournalBatch) {
+      // The journal file may now end with a torn batch. Stop appending to it
+      // and don't write the shutdown journal, so that the index is updated on
+      // the next startup.
+      mJournalAppendFailed = true;
+      mJournalHandle = nullptr;
+    }
     if (mIndexFileOpener) {
       // If opening of the file is still in progress (e.g. WRITE process was
       // canceled by RemoveAll()) then we need to cancel the opener to make sure
@@ -1839,8 +2019,14 @@ void CacheIndex::FinishWrite(bool aSucceeded,
       mIndexFileOpener->Cancel();
       mIndexFileOpener = nullptr;
     }
+    if (mJournalFileOpener) {
+      mJournalFileOpener->Cancel();
+      mJournalFileOpener = nullptr;
+    }
   }
 
+  mWritingJournalBatch = false;
+
   ProcessPendingOperations(aProofOfLock);
   mIndexStats.Log();
 
@@ -1904,6 +2090,7 @@ class WriteLogHelper {
 
   ~WriteLogHelper() { free(mBuf); }
 
+  nsresult AddUint32(uint32_t aValue);
   nsresult AddEntry(CacheIndexEntry* aEntry);
   nsresult Finish();
 
@@ -1917,6 +2104,23 @@ class WriteLogHelper {
   RefPtr<CacheHash> mHash;
 };
 
+nsresult WriteLogHelper::AddUint32(uint32_t aValue) {
+  nsresult rv;
+
+  if (mBufPos + sizeof(uint32_t) > mBufSize) {
+    mHash->Update(mBuf, mBufPos);
+
+    rv = FlushBuffer();
+    NS_ENSURE_SUCCESS(rv, rv);
+    MOZ_ASSERT(mBufPos + sizeof(uint32_t) <= mBufSize);
+  }
+
+  NetworkEndian::writeUint32(mBuf + mBufPos, aValue);
+  mBufPos += sizeof(uint32_t);
+
+  return NS_OK;
+}
+
 nsresult WriteLogHelper::AddEntry(CacheIndexEntry* aEntry) {
   nsresult rv;
 
@@ -1977,6 +2181,13 @@ nsresult CacheIndex::WriteLogToDisk() {
   MOZ_ASSERT(mPendingUpdates.Count() == 0);
   MOZ_ASSERT(mState == SHUTDOWN);
 
+  if (mJournalAppendFailed) {
+    LOG(
+        ("CacheIndex::WriteLogToDisk() - Journal may end with a torn batch, "
+         "skipping writing journal."));
+    return NS_ERROR_FAILURE;
+  }
+
   if (CacheObserver::IsPastShutdownIOLag()) {
     LOG(("CacheIndex::WriteLogToDisk() - Skipping writing journal."));
     return NS_ERROR_FAILURE;
@@ -1994,17 +2205,39 @@ nsresult CacheIndex::WriteLogToDisk() {
 
   mIndexStats.Log();
 
+  // Append the final batch after the batches written during the session. When
+  // no batch was appended, truncate whatever journal file may be on disk.
   PRFileDesc* fd = nullptr;
-  rv = logFile->OpenNSPRFileDesc(PR_RDWR | PR_CREATE_FILE | PR_TRUNCATE, 0600,
-                                 &fd);
+  rv = logFile->OpenNSPRFileDesc(
+      PR_RDWR | PR_CREATE_FILE | (mJournalEntryCount ? PR_APPEND : PR_TRUNCATE),
+      0600, &fd);
   NS_ENSURE_SUCCESS(rv, rv);
 
+  uint32_t count = 0;
+  for (auto iter = mIndex.Iter(); !iter.Done(); iter.Next()) {
+    CacheIndexEntry* entry = iter.Get();
+    if (entry->IsRemoved() || entry->IsDirty()) {
+      count++;
+    }
+  }
+
   WriteLogHelper wlh(fd);
+
+  rv = wlh.AddUint32(count);
+  if (NS_SUCCEEDED(rv)) {
+    rv = wlh.AddUint32(mIndexTimeStamp);
+  }
+  if (NS_WARN_IF(NS_FAILED(rv))) {
+    PR_Close(fd);
+    return rv;
+  }
+
   for (auto iter = mIndex.Iter(); !iter.Done(); iter.Next()) {
     CacheIndexEntry* entry = iter.Get();
     if (entry->IsRemoved() || entry->IsDirty()) {
       rv = wlh.AddEntry(entry);
       if (NS_WARN_IF(NS_FAILED(rv))) {
+        PR_Close(fd);
         return rv;
       }
     }
@@ -2271,17 +2504,20 @@ void CacheIndex::StartReadingJournal(const StaticMutexAutoLock& aProofOfLock) {
   MOZ_ASSERT(mJournalHandle->FileSize() >= 0);
   MOZ_ASSERT(!mRWPending);
 
-  int64_t entriesSize =
-      mJournalHandle->FileSize() - sizeof(CacheHash::Hash32_t);
-
-  if (entriesSize < 0 || entriesSize % sizeof(CacheIndexRecord)) {
+  // The journal must contain at least one batch, i.e. a batch header followed
+  // by the hash of the batch data.
+  if (mJournalHandle->FileSize() <
+      int64_t(2 * sizeof(uint32_t) + sizeof(CacheHash::Hash32_t))) {
     LOG(("CacheIndex::StartReadingJournal() - Journal is corrupted"));
     FinishRead(false, aProofOfLock);
     return;
   }
 
   mSkipEntries = 0;
-  mRWHash = new CacheHash();
+  mJournalReadOffset = 0;
+  mJournalBatchInProgress = false;
+  // The hash is created when a batch header is parsed, see ParseJournal().
+  mRWHash = nullptr;
 
   mRWBufPos =
       std::min(mRWBufSize, static_cast<uint32_t>(mJournalHandle->FileSize()));
@@ -2305,34 +2541,91 @@ void CacheIndex::ParseJournal(const StaticMutexAutoLock& aProofOfLock) {
 
   MOZ_ASSERT(!mRWPending);
 
-  uint32_t entryCnt =
-      (mJournalHandle->FileSize() - sizeof(CacheHash::Hash32_t)) /
-      sizeof(CacheIndexRecord);
-
+  int64_t fileSize = mJournalHandle->FileSize();
   uint32_t pos = 0;
 
-  while (pos + sizeof(CacheIndexRecord) <= mRWBufPos &&
-         mSkipEntries != entryCnt) {
-    CacheIndexEntry tmpEntry(reinterpret_cast<SHA1Sum::Hash*>(mRWBuf + pos));
-    tmpEntry.ReadFromBuf(mRWBuf + pos);
+  while (true) {
+    if (!mJournalBatchInProgress) {
+      if (pos + 2 * sizeof(uint32_t) > mRWBufPos) {
+        break;
+      }
 
-    CacheIndexEntry* entry = mTmpJournal.PutEntry(*tmpEntry.Hash());
-    *entry = tmpEntry;
+      uint32_t count = NetworkEndian::readUint32(mRWBuf + pos);
+      uint32_t timeStamp =
+          NetworkEndian::readUint32(mRWBuf + pos + sizeof(uint32_t));
 
-    if (entry->IsDirty() || entry->IsFresh()) {
-      LOG(
-          ("CacheIndex::ParseJournal() - Invalid entry found in journal, "
-           "ignoring whole journal [dirty=%d, fresh=%d]",
-           entry->IsDirty(), entry->IsFresh()));
-      FinishRead(false, aProofOfLock);
-      return;
-    }
+      // The whole batch must fit into the rest of the file.
+      int64_t batchEnd = mJournalReadOffset + pos + 2 * sizeof(uint32_t) +
+                         int64_t(count) * sizeof(CacheIndexRecord) +
+                         sizeof(CacheHash::Hash32_t);
+      if (batchEnd > fileSize) {
+        LOG(
+            ("CacheIndex::ParseJournal() - Corrupted batch header, ignoring "
+             "whole journal [count=%u]",
+             count));
+        FinishRead(false, aProofOfLock);
+        return;
+      }
 
-    pos += sizeof(CacheIndexRecord);
-    mSkipEntries++;
+      mRWHash = new CacheHash();
+      mRWHash->Update(mRWBuf + pos, 2 * sizeof(uint32_t));
+      mJournalBatchInProgress = true;
+      mJournalBatchRemaining = count;
+      // Batches written before the last full dump of the index are obsolete,
+      // their changes are already contained in the index file. Verify their
+      // hash but don't apply their records.
+      mJournalBatchApply = (timeStamp == mIndexTimeStamp);
+      pos += 2 * sizeof(uint32_t);
+    } else if (mJournalBatchRemaining) {
+      if (pos + sizeof(CacheIndexRecord) > mRWBufPos) {
+        break;
+      }
+
+      mRWHash->Update(mRWBuf + pos, sizeof(CacheIndexRecord));
+
+      if (mJournalBatchApply) {
+        CacheIndexEntry tmpEntry(
+            reinterpret_cast<SHA1Sum::Hash*>(mRWBuf + pos));
+        tmpEntry.ReadFromBuf(mRWBuf + pos);
+
+        CacheIndexEntry* entry = mTmpJournal.PutEntry(*tmpEntry.Hash());
+        *entry = tmpEntry;
+
+        if (entry->IsDirty() || entry->IsFresh()) {
+          LOG(
+              ("CacheIndex::ParseJournal() - Invalid entry found in journal, "
+               "ignoring whole journal [dirty=%d, fresh=%d]",
+               entry->IsDirty(), entry->IsFresh()));
+          FinishRead(false, aProofOfLock);
+          return;
+        }
+      }
+
+      pos += sizeof(CacheIndexRecord);
+      mJournalBatchRemaining--;
+      mSkipEntries++;
+    } else {
+      if (pos + sizeof(CacheHash::Hash32_t) > mRWBufPos) {
+        break;
+      }
+
+      uint32_t expectedHash = NetworkEndian::readUint32(mRWBuf + pos);
+      if (mRWHash->GetHash() != expectedHash) {
+        LOG(
+            ("CacheIndex::ParseJournal() - Hash mismatch, [is %x, should be "
+             "%x]",
+             mRWHash->GetHash(), expectedHash));
+        FinishRead(false, aProofOfLock);
+        return;
+      }
+
+      mRWHash = nullptr;
+      mJournalBatchInProgress = false;
+      pos += sizeof(CacheHash::Hash32_t);
+    }
   }
 
-  mRWHash->Update(mRWBuf, pos);
+  mJournalReadOffset += pos;
 
   if (pos != mRWBufPos) {
     memmove(mRWBuf, mRWBuf + pos, mRWBufPos - pos);
@@ -2341,14 +2634,14 @@ void CacheIndex::ParseJournal(const StaticMutexAutoLock& aProofOfLock) {
   mRWBufPos -= pos;
   pos = 0;
 
-  int64_t fileOffset = mSkipEntries * sizeof(CacheIndexRecord) + mRWBufPos;
+  int64_t fileOffset = mJournalReadOffset + mRWBufPos;
 
-  MOZ_ASSERT(fileOffset <= mJournalHandle->FileSize());
-  if (fileOffset == mJournalHandle->FileSize()) {
-    uint32_t expectedHash = NetworkEndian::readUint32(mRWBuf);
-    if (mRWHash->GetHash() != expectedHash) {
-      LOG(("CacheIndex::ParseJournal() - Hash mismatch, [is %x, should be %x]",
-           mRWHash->GetHash(), expectedHash));
+  MOZ_ASSERT(fileOffset <= fileSize);
+  if (fileOffset == fileSize) {
+    if (mRWBufPos != 0 || mJournalBatchInProgress) {
+      LOG(
+          ("CacheIndex::ParseJournal() - Unexpected end of journal, ignoring "
+           "whole journal"));
       FinishRead(false, aProofOfLock);
       return;
     }
@@ -2359,9 +2652,8 @@ void CacheIndex::ParseJournal(const StaticMutexAutoLock& aProofOfLock) {
   }
 
   pos = mRWBufPos;
-  uint32_t toRead =
-      std::min(mRWBufSize - pos,
-               static_cast<uint32_t>(mJournalHandle->FileSize() - fileOffset));
+  uint32_t toRead = std::min(mRWBufSize - pos,
+                             static_cast<uint32_t>(fileSize - fileOffset));
   mRWBufPos = pos + toRead;
 
   rv = CacheFileIOManager::Read(mJournalHandle, fileOffset, mRWBuf + pos,
@@ -3456,6 +3748,23 @@ void CacheIndex::OnFileOpenedInternal(FileOpenHelper* aOpener,
 
   switch (mState) {
     case WRITING:
+      if (mWritingJournalBatch) {
+        MOZ_ASSERT(aOpener == mJournalFileOpener);
+        mJournalFileOpener = nullptr;
+
+        if (NS_FAILED(aResult)) {
+          LOG(
+              ("CacheIndex::OnFileOpenedInternal() - Can't open journal file "
+               "for appending [rv=0x%08" PRIx32 "]",
+               static_cast<uint32_t>(aResult)));
+          FinishWrite(false, aProofOfLock);
+        } else {
+          mJournalHandle = aHandle;
+          WriteJournalRecords(aProofOfLock);
+        }
+        break;
+      }
+
       MOZ_ASSERT(aOpener == mIndexFileOpener);
       mIndexFileOpener = nullptr;
 
@@ -3566,6 +3875,20 @@ nsresult CacheIndex::OnDataWritten(CacheFileHandle* aHandle, const char* aBuf,
 
   switch (mState) {
     case WRITING:
+      if (mWritingJournalBatch) {
+        MOZ_ASSERT(mJournalHandle == aHandle);
+
+        if (NS_FAILED(aResult)) {
+          FinishWrite(false, lock);
+        } else if (mSkipEntries == mProcessEntries) {
+          // The batch is written in place, there is no file to rename.
+          FinishWrite(true, lock);
+        } else {
+          WriteJournalRecords(lock);
+        }
+        break;
+      }
+
       MOZ_ASSERT(mIndexHandle == aHandle);
 
       if (NS_FAILED(aResult)) {
@@ -858,9 +858,14 @@ class CacheIndex final : public CacheFileIOListener, public nsIRunnable {
   //
   // The index is written periodically, but not earlier than once in
   // kMinDumpInterval and there must be at least kMinUnwrittenChanges
-  // differences between index on disk and in memory. Index is always first
-  // written to a temporary file and the old index file is replaced when the
-  // writing process succeeds.
+  // differences between index on disk and in memory. When only a small
+  // fraction of the index is dirty, the changes are appended to the journal
+  // file as a checksummed batch, so the cost of a write is proportional to the
+  // number of dirty entries instead of the size of the whole index. Once the
+  // journal grows to a significant fraction of the index, the whole index is
+  // dumped again, which makes the journal written so far obsolete. A full dump
+  // is always first written to a temporary file and the old index file is
+  // replaced when the writing process succeeds.
   //
   // Starts writing of index when both limits (minimal delay between writes and
   // minimum number of changes in index) were exceeded.
@@ -870,14 +875,21 @@ class CacheIndex final : public CacheFileIOListener, public nsIRunnable {
   // Serializes part of mIndex hashtable to the write buffer a writes the buffer
   // to the file.
   void WriteRecords(const StaticMutexAutoLock& aProofOfLock);
+  // Starts appending a batch with all dirty entries to the journal file
+  // instead of dumping the whole index.
+  void WriteJournalBatchToDisk(const StaticMutexAutoLock& aProofOfLock);
+  // Serializes part of the batch to the write buffer and appends the buffer to
+  // the journal file.
+  void WriteJournalRecords(const StaticMutexAutoLock& aProofOfLock);
   // Finalizes writing process.
   void FinishWrite(bool aSucceeded, const StaticMutexAutoLock& aProofOfLock);
 
   // Following methods perform writing of the journal during shutdown. All these
   // methods must be called only during shutdown since they write/delete files
   // directly on the main thread instead of using CacheFileIOManager that does
-  // it asynchronously on IO thread. Journal contains only entries that are
-  // dirty, i.e. changes that are not present in the index file on the disk.
+  // it asynchronously on IO thread. The shutdown batch contains only entries
+  // that are dirty, i.e. changes that are neither in the index file on the
+  // disk nor in a batch appended to the journal earlier during the session.
   // When the log is written successfully, the dirty flag in index file is
   // cleared.
   nsresult GetFile(const nsACString& aName, nsIFile** _retval);
@@ -919,6 +931,14 @@ class CacheIndex final : public CacheFileIOListener, public nsIRunnable {
   // Note: We accept the data from journal only when the index is up to date as
   // a whole (i.e. C,V,M state).
   //
+  // The journal consists of one or more batches, each with a record count, the
+  // timestamp of the index file it applies to and a hash of the batch data.
+  // Batches are appended by WriteJournalBatchToDisk() while the browser is
+  // running and the last one is appended by WriteLogToDisk() during shutdown.
+  // Batches whose timestamp doesn't match the index file predate its last full
+  // dump; their changes are already contained in the index file, so they are
+  // verified but not applied.
+  //
   // We rename the journal file to the temporary file as soon as possible after
   // initial test to ensure that we start update process on the next startup if
   // FF crashes during parsing of the index.
@@ -1083,11 +1103,41 @@ class CacheIndex final : public CacheFileIOListener, public nsIRunnable {
   // Timestamp value from index file. It is used during update process to skip
   // entries that were last modified before this timestamp.
   uint32_t mIndexTimeStamp{0};
+  // Timestamp that the full dump currently in progress writes to the index
+  // header. It replaces mIndexTimeStamp once the dump succeeds.
+  uint32_t mPendingIndexTimeStamp{0};
   // Timestamp of last time the index was dumped to disk.
   // NOTE: The index might not be necessarily dumped at this time. The value
   // is used to schedule next dump of the index.
   TimeStamp mLastDumpTime;
 
+  // Number of records appended to the journal during this session. A
+  // successful full dump of the index makes the journal obsolete and resets
+  // the counter; the next appended batch then starts a new journal file.
+  uint32_t mJournalEntryCount{0};
+  // Offset in the journal file at which the batch currently being written
+  // starts.
+  int64_t mJournalAppendOffset{0};
+  // Set to true when appending a batch to the journal fails. The journal file
+  // may then end with a torn batch, so we stop appending to it and don't write
+  // the shutdown journal, forcing an update process on the next startup. The
+  // flag is cleared by a successful full dump of the index since the next
+  // batch starts a new journal file.
+  bool mJournalAppendFailed{false};
+  // True while the WRITING state is appending a journal batch instead of
+  // dumping the whole index.
+  bool mWritingJournalBatch{false};
+
+  // State used by ParseJournal() to parse the batched journal format across
+  // multiple reads: true while parsing is inside a batch, whether the records
+  // from the current batch are applied (batches older than the index file are
+  // only verified), the number of records that remain to be read from the
+  // current batch and the number of bytes consumed from the file so far.
+  bool mJournalBatchInProgress{false};
+  bool mJournalBatchApply{false};
+  uint32_t mJournalBatchRemaining{0};
+  int64_t mJournalReadOffset{0};
+
   // Timer of delayed update/build.
   nsCOMPtr<nsITimer> mUpdateTimer;
   // True when build or update event is posted
@@ -1116,7 +1166,8 @@ class CacheIndex final : public CacheFileIOListener, public nsIRunnable {
 
   // Handle used for writing and reading index file.
   RefPtr<CacheFileHandle> mIndexHandle;
-  // Handle used for reading journal file.
+  // Handle used for reading the journal file and for appending journal
+  // batches. It is kept open between batches during the session.
   RefPtr<CacheFileHandle> mJournalHandle;
   // Used to check the existence of the file during reading process.
   RefPtr<CacheFileHandle> mTmpHandle;
@@ -913,6 +913,15 @@ void CookieService::GetCookiesForURI(
                                             baseDomainFromURI);
   NS_ENSURE_SUCCESS_VOID(rv);
 
+  // Fast path: if the storage has no cookie at all for either base domain,
+  // no cookie can be sent, and CheckPrefs() would have run with a zero
+  // cookie count and so never notified a rejection either. This keeps the
+  // common cookie-less origin to a single filter probe per base domain.
+  if (!storage->MayHaveCookies(baseDomain) &&
+      !storage->MayHaveCookies(baseDomainFromURI)) {
+    return;
+  }
+
   nsICookie::schemeType schemeType = CookieCommons::URIToSchemeType(aHostURI);
 
   // check default prefs
@@ -2390,5 +2399,21 @@ bool CookieService::SetCookiesFromIPC(const nsACString& aBaseDomain,
   return true;
 }
 
+bool CookieService::HasCookiesForBaseDomain(const nsACString& aBaseDomain,
+                                            const OriginAttributes& aAttrs) {
+  if (!IsInitialized()) {
+    return false;
+  }
+
+  CookieStorage* storage = PickStorage(aAttrs);
+  if (!storage->MayHaveCookies(aBaseDomain)) {
+    return false;
+  }
+
+  const nsTArray<RefPtr<Cookie>>* cookies =
+      storage->GetCookiesFromHost(aBaseDomain, aAttrs);
+  return cookies && !cookies->IsEmpty();
+}
+
 }  // namespace net
 }  // namespace mozilla
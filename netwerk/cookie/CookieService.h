@@ -100,6 +100,14 @@ class CookieService final : public nsICookieService,
                          bool aFromHttp,
                          const nsTArray<CookieStruct>& aCookies);
 
+  /**
+   * Returns true if any cookie (including expired ones) is stored for
+   * aBaseDomain in the cookie jar selected by aAttrs. Used to let content
+   * processes negatively cache cookie-less base domains.
+   */
+  bool HasCookiesForBaseDomain(const nsACString& aBaseDomain,
+                               const OriginAttributes& aAttrs);
+
  protected:
   virtual ~CookieService();
 
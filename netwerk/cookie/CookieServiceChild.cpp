@@ -123,10 +123,6 @@ void CookieServiceChild::TrackCookieLoad(nsIChannel* aChannel) {
     return;
   }
 
-  uint32_t rejectedReason = 0;
-  ThirdPartyAnalysisResult result = mThirdPartyUtil->AnalyzeChannel(
-      aChannel, true, nullptr, RequireThirdPartyCheck, &rejectedReason);
-
   nsCOMPtr<nsIURI> uri;
   aChannel->GetURI(getter_AddRefs(uri));
   nsCOMPtr<nsILoadInfo> loadInfo = aChannel->LoadInfo();
@@ -135,6 +131,21 @@ void CookieServiceChild::TrackCookieLoad(nsIChannel* aChannel) {
   StoragePrincipalHelper::PrepareEffectiveStoragePrincipalOriginAttributes(
       aChannel, attrs);
 
+  // If the parent has told us that this cookie jar holds no cookies at all,
+  // preparing a cookie list can't deliver anything. Skip the IPC round trip;
+  // the entry is dropped from mEmptyBaseDomains once a cookie shows up for
+  // the jar.
+  bool requireHostMatch;
+  nsCString baseDomain;
+  CookieCommons::GetBaseDomain(mTLDService, uri, baseDomain, requireHostMatch);
+  if (mEmptyBaseDomains.Contains(CookieKey(baseDomain, attrs))) {
+    return;
+  }
+
+  uint32_t rejectedReason = 0;
+  ThirdPartyAnalysisResult result = mThirdPartyUtil->AnalyzeChannel(
+      aChannel, true, nullptr, RequireThirdPartyCheck, &rejectedReason);
+
   bool isSafeTopLevelNav = CookieCommons::IsSafeTopLevelNav(aChannel);
   bool isSameSiteForeign = CookieCommons::IsSameSiteForeign(aChannel, uri);
   SendPrepareCookieList(
@@ -194,13 +205,21 @@ IPCResult CookieServiceChild::RecvRemoveBatchDeletedCookies(
 }
 
 IPCResult CookieServiceChild::RecvTrackCookiesLoad(
-    nsTArray<CookieStruct>&& aCookiesList, const OriginAttributes& aAttrs) {
+    nsTArray<CookieStruct>&& aCookiesList, const nsCString& aBaseDomain,
+    const OriginAttributes& aAttrs, const bool& aIsBaseDomainEmpty) {
   for (uint32_t i = 0; i < aCookiesList.Length(); i++) {
     RefPtr<Cookie> cookie = Cookie::Create(aCookiesList[i], aAttrs);
     cookie->SetIsHttpOnly(false);
     RecordDocumentCookie(cookie, aAttrs);
   }
 
+  CookieKey key(aBaseDomain, aAttrs);
+  if (aIsBaseDomainEmpty) {
+    mEmptyBaseDomains.PutEntry(key);
+  } else {
+    mEmptyBaseDomains.RemoveEntry(key);
+  }
+
   return IPC_OK();
 }
 
@@ -269,6 +288,11 @@ void CookieServiceChild::RecordDocumentCookie(Cookie* aCookie,
   recordreplay::AddRecordingOperation("cookie", baseDomain.get());
 
   CookieKey key(baseDomain, aAttrs);
+
+  // The jar is not empty anymore; stop short-circuiting cookie list requests
+  // for it.
+  mEmptyBaseDomains.RemoveEntry(key);
+
   CookiesList* cookiesList = nullptr;
   mCookiesMap.Get(key, &cookiesList);
 
@@ -9,6 +9,7 @@
 #include "CookieKey.h"
 #include "mozilla/net/PCookieServiceChild.h"
 #include "nsClassHashtable.h"
+#include "nsTHashtable.h"
 #include "nsICookieService.h"
 #include "nsIObserver.h"
 #include "nsIPrefBranch.h"
@@ -61,7 +62,8 @@ class CookieServiceChild final : public PCookieServiceChild,
   static bool RequireThirdPartyCheck(nsILoadInfo* aLoadInfo);
 
   mozilla::ipc::IPCResult RecvTrackCookiesLoad(
-      nsTArray<CookieStruct>&& aCookiesList, const OriginAttributes& aAttrs);
+      nsTArray<CookieStruct>&& aCookiesList, const nsCString& aBaseDomain,
+      const OriginAttributes& aAttrs, const bool& aIsBaseDomainEmpty);
 
   mozilla::ipc::IPCResult RecvRemoveAll();
 
@@ -76,6 +78,11 @@ class CookieServiceChild final : public PCookieServiceChild,
                                         const OriginAttributes& aAttrs);
 
   CookiesMap mCookiesMap;
+  // Cookie jars the parent has told us contain no cookies at all. For keys in
+  // this set we don't have to ask the parent to prepare a cookie list on every
+  // channel load. An entry is removed as soon as a cookie is recorded for its
+  // jar, either locally or via a change broadcast from the parent.
+  nsTHashtable<CookieKey> mEmptyBaseDomains;
   nsCOMPtr<nsITimer> mCookieTimer;
   nsCOMPtr<mozIThirdPartyUtil> mThirdPartyUtil;
   nsCOMPtr<nsIEffectiveTLDService> mTLDService;
@@ -13,7 +13,9 @@
 #include "mozIThirdPartyUtil.h"
 #include "nsArrayUtils.h"
 #include "nsIChannel.h"
+#include "nsIEffectiveTLDService.h"
 #include "nsNetCID.h"
+#include "nsServiceManagerUtils.h"
 
 using namespace mozilla::ipc;
 
@@ -28,6 +30,10 @@ CookieServiceParent::CookieServiceParent() {
   // Get the CookieService instance directly, so we can call internal methods.
   mCookieService = CookieService::GetSingleton();
   NS_ASSERTION(mCookieService, "couldn't get nsICookieService");
+
+  mTLDService = do_GetService(NS_EFFECTIVETLDSERVICE_CONTRACTID);
+  NS_ASSERTION(mTLDService, "couldn't get TLDService");
+
   mProcessingCookie = false;
 }
 
@@ -105,7 +111,16 @@ void CookieServiceParent::TrackCookieLoad(nsIChannel* aChannel) {
       foundCookieList);
   nsTArray<CookieStruct> matchingCookiesList;
   SerialializeCookieList(foundCookieList, matchingCookiesList);
-  Unused << SendTrackCookiesLoad(matchingCookiesList, attrs);
+
+  nsAutoCString baseDomain;
+  bool requireHostMatch;
+  CookieCommons::GetBaseDomain(mTLDService, uri, baseDomain, requireHostMatch);
+  bool isBaseDomainEmpty =
+      matchingCookiesList.IsEmpty() &&
+      !mCookieService->HasCookiesForBaseDomain(baseDomain, attrs);
+
+  Unused << SendTrackCookiesLoad(matchingCookiesList, baseDomain, attrs,
+                                 isBaseDomainEmpty);
 }
 
 // static
@@ -146,7 +161,17 @@ IPCResult CookieServiceParent::RecvPrepareCookieList(
       foundCookieList);
   nsTArray<CookieStruct> matchingCookiesList;
   SerialializeCookieList(foundCookieList, matchingCookiesList);
-  Unused << SendTrackCookiesLoad(matchingCookiesList, aAttrs);
+
+  nsAutoCString baseDomain;
+  bool requireHostMatch;
+  CookieCommons::GetBaseDomain(mTLDService, aHost, baseDomain,
+                               requireHostMatch);
+  bool isBaseDomainEmpty =
+      matchingCookiesList.IsEmpty() &&
+      !mCookieService->HasCookiesForBaseDomain(baseDomain, aAttrs);
+
+  Unused << SendTrackCookiesLoad(matchingCookiesList, baseDomain, aAttrs,
+                                 isBaseDomainEmpty);
   return IPC_OK();
 }
 
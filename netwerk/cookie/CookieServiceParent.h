@@ -7,9 +7,11 @@
 #define mozilla_net_CookieServiceParent_h
 
 #include "mozilla/net/PCookieServiceParent.h"
+#include "nsCOMPtr.h"
 
 class nsIArray;
 class nsICookie;
+class nsIEffectiveTLDService;
 namespace mozilla {
 class OriginAttributes;
 }
@@ -62,6 +64,7 @@ class CookieServiceParent : public PCookieServiceParent {
                                      nsTArray<CookieStruct>& aCookiesList);
 
   RefPtr<CookieService> mCookieService;
+  nsCOMPtr<nsIEffectiveTLDService> mTLDService;
   bool mProcessingCookie;
 };
 
@@ -222,6 +222,12 @@ uint32_t CookieStorage::CountCookiesFromHost(const nsACString& aBaseDomain,
   return entry ? entry->GetCookies().Length() : 0;
 }
 
+// Approximate check whether any origin-attributes jar holds a cookie for
+// aBaseDomain. False positives are possible; a false answer is authoritative.
+bool CookieStorage::MayHaveCookies(const nsACString& aBaseDomain) const {
+  return mBaseDomainFilter.mightContain(HashString(aBaseDomain));
+}
+
 void CookieStorage::GetAll(nsTArray<RefPtr<nsICookie>>& aResult) const {
   aResult.SetCapacity(mCookieCount);
 
@@ -353,6 +359,7 @@ void CookieStorage::RemoveAll() {
   mHostTable.Clear();
   mCookieCount = 0;
   mCookieOldestTime = INT64_MAX;
+  mBaseDomainFilter.clear();
 
   RemoveAllInternal();
 
@@ -635,6 +642,7 @@ void CookieStorage::AddCookieToList(const nsACString& aBaseDomain,
 
   entry->GetCookies().AppendElement(aCookie);
   ++mCookieCount;
+  mBaseDomainFilter.add(HashString(aBaseDomain));
 
   // keep track of the oldest cookie, for when it comes time to purge
   UpdateCookieOldestTime(aCookie);
@@ -822,6 +830,8 @@ void CookieStorage::RemoveCookieFromList(const CookieListIter& aIter) {
 }
 
 void CookieStorage::RemoveCookieFromListInternal(const CookieListIter& aIter) {
+  mBaseDomainFilter.remove(HashString(aIter.entry->mBaseDomain));
+
   if (aIter.entry->GetCookies().Length() == 1) {
     // we're removing the last element in the array - so just remove the entry
     // from the hash. note that the entryclass' dtor will take care of
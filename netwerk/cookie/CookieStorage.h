@@ -8,6 +8,7 @@
 
 #include "CookieKey.h"
 
+#include "mozilla/BloomFilter.h"
 #include "nsIObserver.h"
 #include "nsTHashtable.h"
 #include "nsWeakReference.h"
@@ -88,6 +89,8 @@ class CookieStorage : public nsIObserver, public nsSupportsWeakReference {
   uint32_t CountCookiesFromHost(const nsACString& aBaseDomain,
                                 uint32_t aPrivateBrowsingId);
 
+  bool MayHaveCookies(const nsACString& aBaseDomain) const;
+
   void GetAll(nsTArray<RefPtr<nsICookie>>& aResult) const;
 
   const nsTArray<RefPtr<Cookie>>* GetCookiesFromHost(
@@ -188,6 +191,12 @@ class CookieStorage : public nsIObserver, public nsSupportsWeakReference {
                                                   uint16_t aMaxNumberOfCookies,
                                                   int64_t aCookiePurgeAge) = 0;
 
+  // Approximate set of base domains that currently have at least one cookie,
+  // in any origin-attributes jar. Lets GetCookiesForURI() skip the hashtable
+  // walks and pref checks for the common case of a cookie-less origin. The
+  // filter is counting so removals keep it accurate; 4k of 8-bit counters.
+  CountingBloomFilter<12, nsCString> mBaseDomainFilter;
+
   int64_t mCookieOldestTime{INT64_MAX};
 
   uint16_t mMaxNumberOfCookies{kMaxNumberOfCookies};
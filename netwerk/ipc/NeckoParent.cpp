@@ -546,6 +546,15 @@ mozilla::ipc::IPCResult NeckoParent::RecvHTMLDNSPrefetch(
   return IPC_OK();
 }
 
+mozilla::ipc::IPCResult NeckoParent::RecvHTMLDNSPrefetchBatch(
+    nsTArray<HTMLDNSPrefetchRequest>&& aRequests) {
+  for (const auto& request : aRequests) {
+    HTMLDNSPrefetch::Prefetch(request.hostname(), request.isHttps(),
+                              request.originAttributes(), request.flags());
+  }
+  return IPC_OK();
+}
+
 mozilla::ipc::IPCResult NeckoParent::RecvCancelHTMLDNSPrefetch(
     const nsString& hostname, const bool& isHttps,
     const OriginAttributes& aOriginAttributes, const uint32_t& flags,
@@ -125,6 +125,8 @@ class NeckoParent : public PNeckoParent {
   mozilla::ipc::IPCResult RecvHTMLDNSPrefetch(
       const nsString& hostname, const bool& isHttps,
       const OriginAttributes& aOriginAttributes, const uint32_t& flags);
+  mozilla::ipc::IPCResult RecvHTMLDNSPrefetchBatch(
+      nsTArray<HTMLDNSPrefetchRequest>&& aRequests);
   mozilla::ipc::IPCResult RecvCancelHTMLDNSPrefetch(
       const nsString& hostname, const bool& isHttps,
       const OriginAttributes& aOriginAttributes, const uint32_t& flags,
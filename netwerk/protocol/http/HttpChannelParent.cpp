@@ -43,6 +43,7 @@
 #include "mozilla/BasePrincipal.h"
 #include "nsCORSListenerProxy.h"
 #include "nsIIPCSerializableInputStream.h"
+#include <algorithm>
 #include "nsIPrompt.h"
 #include "nsIPromptFactory.h"
 #include "mozilla/net/RedirectChannelRegistrar.h"
@@ -90,7 +91,7 @@ HttpChannelParent::HttpChannelParent(dom::BrowserParent* iframeEmbedding,
 
   mBrowserParent = iframeEmbedding;
 
-  mSendWindowSize = gHttpHandler->SendWindowSize();
+  mSendWindowSize = mDynamicSendWindowSize = gHttpHandler->SendWindowSize();
 
   mEventQ =
       new ChannelEventQueue(static_cast<nsIParentRedirectingChannel*>(this));
@@ -1386,6 +1387,7 @@ HttpChannelParent::OnDataAvailable(nsIRequest* aRequest,
       Unused << mChannel->Suspend();
       mSuspendedForFlowControl = true;
       mHasSuspendedByBackPressure = true;
+      mFlowControlSuspendTimestamp = TimeStamp::Now();
     } else if (!mResumedTimestamp.IsNull()) {
       // Calculate the delay when the first packet arrived after resume
       Telemetry::AccumulateTimeDelta(
@@ -1426,6 +1428,15 @@ bool HttpChannelParent::NeedFlowControl() {
   return mNeedFlowControl;
 }
 
+// Bounds for adapting the e10s backpressure window in RecvBytesRead. A
+// suspension shorter than kDynamicWindowGrowThresholdMs means the child
+// drained its whole share of the window before we could refill it; one
+// longer than kDynamicWindowShrinkThresholdMs means sent data would only
+// have piled up in the child.
+static const uint32_t kDynamicWindowGrowThresholdMs = 10;
+static const uint32_t kDynamicWindowShrinkThresholdMs = 100;
+static const int32_t kDynamicWindowMaxFactor = 8;
+
 mozilla::ipc::IPCResult HttpChannelParent::RecvBytesRead(
     const int32_t& aCount) {
   if (!NeedFlowControl()) {
@@ -1435,6 +1446,7 @@ mozilla::ipc::IPCResult HttpChannelParent::RecvBytesRead(
   LOG(("HttpChannelParent::RecvBytesRead [this=%p count=%" PRId32 "]\n", this,
        aCount));
 
+  bool resumed = false;
   if (mSendWindowSize <= 0 && mSendWindowSize + aCount > 0) {
     MOZ_ASSERT(mSuspendedForFlowControl);
     LOG(("  resume the channel due to e10s backpressure relief"));
@@ -1442,8 +1454,39 @@ mozilla::ipc::IPCResult HttpChannelParent::RecvBytesRead(
     mSuspendedForFlowControl = false;
 
     mResumedTimestamp = TimeStamp::Now();
+    resumed = true;
   }
   mSendWindowSize += aCount;
+
+  if (resumed && !mFlowControlSuspendTimestamp.IsNull()) {
+    // Adapt the window to the consumer's drain rate. A short suspension
+    // means the window is throttling a consumer that keeps up, so let it
+    // grow (up to a bound); a long one means the child is the bottleneck
+    // and buffering more there helps nothing, so shrink the window back
+    // toward the configured size.
+    double suspendedMs =
+        (mResumedTimestamp - mFlowControlSuspendTimestamp).ToMilliseconds();
+    mFlowControlSuspendTimestamp = TimeStamp();
+
+    int32_t configured = gHttpHandler->SendWindowSize();
+    if (suspendedMs < kDynamicWindowGrowThresholdMs &&
+        mDynamicSendWindowSize <= configured * (kDynamicWindowMaxFactor / 2)) {
+      mSendWindowSize += mDynamicSendWindowSize;
+      mDynamicSendWindowSize *= 2;
+      LOG(("  grow the send window to %" PRId32, mDynamicSendWindowSize));
+    } else if (suspendedMs > kDynamicWindowShrinkThresholdMs &&
+               mDynamicSendWindowSize > configured) {
+      int32_t newWindow = std::max(configured, mDynamicSendWindowSize / 2);
+      // Keep at least one credit outstanding so the resume above stays valid.
+      int32_t reduction =
+          std::min(mDynamicSendWindowSize - newWindow, mSendWindowSize - 1);
+      if (reduction > 0) {
+        mSendWindowSize -= reduction;
+        mDynamicSendWindowSize -= reduction;
+        LOG(("  shrink the send window to %" PRId32, mDynamicSendWindowSize));
+      }
+    }
+  }
   return IPC_OK();
 }
 
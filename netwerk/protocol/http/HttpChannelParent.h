@@ -240,6 +240,12 @@ class HttpChannelParent final : public nsIInterfaceRequestor,
   bool NeedFlowControl();
   int32_t mSendWindowSize;
 
+  // The current size the send window is allowed to grow back to;
+  // mSendWindowSize counts the remaining credits against it. Starts at the
+  // configured window size and adapts to the consumer's drain rate whenever
+  // a backpressure suspension ends (see RecvBytesRead).
+  int32_t mDynamicSendWindowSize;
+
   friend class HttpBackgroundChannelParent;
 
   RefPtr<HttpBaseChannel> mChannel;
@@ -263,6 +269,10 @@ class HttpChannelParent final : public nsIInterfaceRequestor,
   // To calculate the delay caused by the e10s back-pressure suspension
   TimeStamp mResumedTimestamp;
 
+  // When the channel was last suspended for flow control; used to judge how
+  // quickly the child drained its share of the send window.
+  TimeStamp mFlowControlSuspendTimestamp;
+
   Atomic<bool> mIPCClosed;  // PHttpChannel actor has been Closed()
 
   // Corresponding redirect channel registrar Id. 0 means redirection is not
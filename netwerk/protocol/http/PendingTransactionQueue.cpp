@@ -14,11 +14,21 @@
 
 #include "PendingTransactionQueue.h"
 #include "nsHttpHandler.h"
+#include "nsIClassOfService.h"
+#include "mozilla/ArrayUtils.h"
 #include "mozilla/ChaosMode.h"
+#include "mozilla/StaticPrefs_network.h"
 
 namespace mozilla {
 namespace net {
 
+// Weighted round-robin credits per latency class (indexed by
+// LatencyClass).  For every four interactive admissions at most two
+// default and one background-bulk transaction are admitted, so bulk
+// traffic keeps making progress but can't add head-of-line latency to
+// user-facing requests on a busy origin.
+static const uint32_t kLatencyClassWeight[] = {4, 2, 1};
+
 static uint64_t TabIdForQueuing(nsAHttpTransaction* transaction) {
   return gHttpHandler->ActiveTabPriority() ? transaction->TopBrowsingContextId()
                                            : 0;
@@ -45,6 +55,79 @@ static bool TransactionComparator(nsHttpTransaction* t1,
   return t1->Priority() >= t2->Priority();
 }
 
+// static
+PendingTransactionQueue::LatencyClass PendingTransactionQueue::LatencyClassOf(
+    nsHttpTransaction* aTrans) {
+  uint32_t caps = aTrans->Caps();
+  uint32_t cos = aTrans->ClassOfService();
+  if ((caps & (NS_HTTP_URGENT_START | NS_HTTP_LOAD_AS_BLOCKING |
+               NS_HTTP_LOAD_UNBLOCKED)) ||
+      (cos & (nsIClassOfService::UrgentStart | nsIClassOfService::Leader |
+              nsIClassOfService::Unblocked))) {
+    return LatencyClass::Interactive;
+  }
+  if (cos & (nsIClassOfService::Background | nsIClassOfService::Throttleable |
+             nsIClassOfService::Tail)) {
+    return LatencyClass::BackgroundBulk;
+  }
+  return LatencyClass::Default;
+}
+
+void PendingTransactionQueue::TakeFromPendingQWeighted(
+    nsTArray<RefPtr<PendingTransactionInfo>>& queue,
+    nsTArray<RefPtr<PendingTransactionInfo>>& result, uint32_t maxCount,
+    bool aInsertSorted) {
+  MOZ_ASSERT(maxCount && maxCount < queue.Length());
+
+  // Partition the queue by latency class; within a class the existing
+  // (blocking/priority) order is kept.
+  AutoTArray<uint32_t, 32> classed[ArrayLength(kLatencyClassWeight)];
+  for (uint32_t i = 0; i < queue.Length(); ++i) {
+    classed[static_cast<size_t>(LatencyClassOf(queue[i]->Transaction()))]
+        .AppendElement(i);
+  }
+
+  AutoTArray<uint32_t, 8> chosen;
+  size_t cursor[ArrayLength(kLatencyClassWeight)] = {0};
+  while (chosen.Length() < maxCount) {
+    bool progress = false;
+    for (size_t cls = 0;
+         cls < ArrayLength(kLatencyClassWeight) && chosen.Length() < maxCount;
+         ++cls) {
+      for (uint32_t credit = kLatencyClassWeight[cls];
+           credit && chosen.Length() < maxCount &&
+           cursor[cls] < classed[cls].Length();
+           --credit) {
+        chosen.AppendElement(classed[cls][cursor[cls]++]);
+        progress = true;
+      }
+    }
+    if (!progress) {
+      break;
+    }
+  }
+
+  LOG(
+      ("PendingTransactionQueue::TakeFromPendingQWeighted "
+       "admitting %zu of %zu [interactive=%zu default=%zu bulk=%zu]\n",
+       chosen.Length(), queue.Length(), classed[0].Length(),
+       classed[1].Length(), classed[2].Length()));
+
+  for (uint32_t index : chosen) {
+    if (aInsertSorted) {
+      InsertTransactionSorted(result, queue[index]);
+    } else {
+      result.AppendElement(queue[index]);
+    }
+  }
+
+  // Remove the chosen entries from the back so the indices stay valid.
+  chosen.Sort();
+  for (uint32_t i = chosen.Length(); i > 0; --i) {
+    queue.RemoveElementAt(chosen[i - 1]);
+  }
+}
+
 void PendingTransactionQueue::InsertTransactionNormal(
     PendingTransactionInfo* info,
     bool aInsertAsFirstForTheSamePriority /*= false*/) {
@@ -157,9 +240,17 @@ void PendingTransactionQueue::AppendPendingQForFocusedWindow(
                       ? infoArray->Length()
                       : countToAppend;
 
-  result.InsertElementsAt(result.Length(), infoArray->Elements(),
-                          countToAppend);
-  infoArray->RemoveElementsAt(0, countToAppend);
+  if (StaticPrefs::network_http_pending_queue_wfq() &&
+      countToAppend < infoArray->Length()) {
+    // Not every queued transaction gets a connection this round; admit
+    // them by weighted fair queuing over latency classes so queued
+    // background-bulk work can't take every available slot.
+    TakeFromPendingQWeighted(*infoArray, result, countToAppend, false);
+  } else {
+    result.InsertElementsAt(result.Length(), infoArray->Elements(),
+                            countToAppend);
+    infoArray->RemoveElementsAt(0, countToAppend);
+  }
 
   LOG(
       ("PendingTransactionQueue::AppendPendingQForFocusedWindow, "
@@ -178,18 +269,27 @@ void PendingTransactionQueue::AppendPendingQForNonFocusedWindows(
       continue;
     }
 
-    uint32_t count = 0;
-    for (; count < entry.GetWeak()->Length(); ++count) {
-      if (maxCount && totalCount == maxCount) {
-        break;
-      }
+    uint32_t remaining = maxCount ? maxCount - totalCount : 0;
+    if (StaticPrefs::network_http_pending_queue_wfq() && maxCount &&
+        remaining < entry.GetWeak()->Length()) {
+      // Admission is contended for this window's queue as well; pick the
+      // transactions that get a slot by latency class.
+      TakeFromPendingQWeighted(*entry.GetWeak(), result, remaining, true);
+      totalCount += remaining;
+    } else {
+      uint32_t count = 0;
+      for (; count < entry.GetWeak()->Length(); ++count) {
+        if (maxCount && totalCount == maxCount) {
+          break;
+        }
 
-      // Because elements in |result| could come from multiple penndingQ,
-      // call |InsertTransactionSorted| to make sure the order is correct.
-      InsertTransactionSorted(result, entry.GetWeak()->ElementAt(count));
-      ++totalCount;
+        // Because elements in |result| could come from multiple penndingQ,
+        // call |InsertTransactionSorted| to make sure the order is correct.
+        InsertTransactionSorted(result, entry.GetWeak()->ElementAt(count));
+        ++totalCount;
+      }
+      entry.GetWeak()->RemoveElementsAt(0, count);
     }
-    entry.GetWeak()->RemoveElementsAt(0, count);
 
     if (maxCount && totalCount == maxCount) {
       if (entry.GetWeak()->Length()) {
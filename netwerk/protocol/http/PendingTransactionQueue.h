@@ -15,6 +15,19 @@ namespace net {
 
 class PendingTransactionQueue {
  public:
+  // Latency class used when admitting pending transactions to available
+  // connections.  The class is derived from the transaction's caps and
+  // class of service flags; free connection slots are handed out by
+  // weighted round-robin across the classes so background-bulk work can
+  // never occupy every slot an origin has.
+  enum class LatencyClass : uint8_t {
+    Interactive = 0,
+    Default = 1,
+    BackgroundBulk = 2,
+  };
+
+  static LatencyClass LatencyClassOf(nsHttpTransaction* aTrans);
+
   PendingTransactionQueue() = default;
 
   void ReschedTransaction(nsHttpTransaction* aTrans);
@@ -73,6 +86,17 @@ class PendingTransactionQueue {
   void InsertTransactionNormal(PendingTransactionInfo* info,
                                bool aInsertAsFirstForTheSamePriority = false);
 
+  // Move up to |maxCount| entries of |queue| into |result|, choosing them
+  // by weighted round-robin over latency classes while keeping the
+  // relative (blocking/priority) order within each class.  When
+  // |aInsertSorted| is true the chosen entries are merged into |result|
+  // with |InsertTransactionSorted|; this is used when |result|
+  // accumulates entries from several window queues.
+  void TakeFromPendingQWeighted(
+      nsTArray<RefPtr<PendingTransactionInfo>>& queue,
+      nsTArray<RefPtr<PendingTransactionInfo>>& result, uint32_t maxCount,
+      bool aInsertSorted);
+
   nsTArray<RefPtr<PendingTransactionInfo>>
       mUrgentStartQ;  // the urgent start transaction queue
 
@@ -19,6 +19,7 @@
 
 #include "nsHttp.h"
 #include "nsHttpChannel.h"
+#include "nsTHashMap.h"
 #include "nsHttpChannelAuthProvider.h"
 #include "nsHttpHandler.h"
 #include "nsString.h"
@@ -60,8 +61,10 @@
 #include "mozilla/Attributes.h"
 #include "mozilla/BasePrincipal.h"
 #include "mozilla/ContentBlocking.h"
+#include "mozilla/ClearOnShutdown.h"
 #include "mozilla/DebugOnly.h"
 #include "mozilla/Preferences.h"
+#include "mozilla/StaticPtr.h"
 #include "mozilla/Components.h"
 #include "mozilla/StaticPrefs_browser.h"
 #include "mozilla/StaticPrefs_fission.h"
@@ -168,6 +171,17 @@ namespace {
 
 static NS_DEFINE_CID(kStreamListenerTeeCID, NS_STREAMLISTENERTEE_CID);
 
+// Validators of responses we have seen for a URI during this session, used
+// to make a raced network request conditional before the cache entry has
+// been opened (see MaybeAddSpeculativeValidationHeaders). Main thread only.
+struct SpeculativeValidators {
+  nsCString mETag;
+  nsCString mLastModified;
+};
+static const uint32_t kSpeculativeValidatorsLimit = 1024;
+static StaticAutoPtr<nsTHashMap<nsCStringHashKey, SpeculativeValidators>>
+    sSpeculativeValidators;
+
 void AccumulateCacheHitTelemetry(CacheDisposition hitOrMiss,
                                  nsIChannel* aChannel) {
   nsCString key("UNKNOWN");
@@ -732,9 +746,10 @@ nsresult nsHttpChannel::ConnectOnTailUnblock() {
     // otherwise, let's just proceed without using the cache.
   }
 
-  if (mRaceCacheWithNetwork && ((mCacheEntry && !mCachedContentIsValid &&
-                                 (mDidReval || LoadCachedContentIsPartial())) ||
-                                mIgnoreCacheEntry)) {
+  if (mRaceCacheWithNetwork && !mDidSpeculativeReval &&
+      ((mCacheEntry && !mCachedContentIsValid &&
+        (mDidReval || LoadCachedContentIsPartial())) ||
+       mIgnoreCacheEntry)) {
     // We won't send the conditional request because the unconditional
     // request was already sent (see bug 1377223).
     AccumulateCategorical(
@@ -1069,6 +1084,12 @@ nsresult nsHttpChannel::SetupTransaction() {
       StoreDeliveringAltData(false);
       mAltDataLength = -1;
       mCacheInputStream.CloseAndRelease();
+    } else {
+      // The entry hasn't told us yet whether it needs validation, but if we
+      // remember the validators a previous response for this URI carried, we
+      // can race a conditional request and let a 304 be resolved against the
+      // entry once it's available.
+      MaybeAddSpeculativeValidationHeaders();
     }
   }
 
@@ -2276,6 +2297,22 @@ nsresult nsHttpChannel::ContinueProcessResponse3(nsresult rv) {
         return NS_OK;
       }
 
+      if (mDidSpeculativeReval) {
+        // The conditional request was built from remembered validators
+        // before the cache entry was available, so
+        // ShouldBypassProcessNotModified() doesn't know about it. The 304
+        // can only be resolved against the entry.
+        if (mCacheOpenFunc || AwaitingCacheCallbacks()) {
+          LOG(
+              ("  deferring 304 processing until the cache entry callbacks "
+               "arrive [this=%p]\n",
+               this));
+          mWaitingForSpeculative304 = true;
+          return NS_OK;
+        }
+        return ProcessSpeculativeNotModified();
+      }
+
       // Don't cache uninformative 304
       if (LoadCustomConditionalRequest()) {
         CloseCacheEntry(false);
@@ -3375,6 +3412,65 @@ nsresult nsHttpChannel::ProcessNotModified(
   });
 }
 
+// A 304 answer to a speculatively revalidated request (see
+// MaybeAddSpeculativeValidationHeaders) only proves that the copy matching
+// the validators we guessed is still fresh. Serve the cache entry when it
+// still carries exactly those validators, otherwise reload from the network.
+nsresult nsHttpChannel::ProcessSpeculativeNotModified() {
+  LOG(("nsHttpChannel::ProcessSpeculativeNotModified [this=%p]\n", this));
+
+  MOZ_ASSERT(NS_IsMainThread());
+  MOZ_ASSERT(mDidSpeculativeReval);
+  MOZ_ASSERT(!AwaitingCacheCallbacks());
+
+  bool usable = mCacheEntry && mCachedResponseHead;
+  if (usable) {
+    nsAutoCString val;
+    if (!mSpeculativeRevalETag.IsEmpty()) {
+      Unused << mCachedResponseHead->GetHeader(nsHttp::ETag, val);
+      usable = val.Equals(mSpeculativeRevalETag);
+    } else {
+      Unused << mCachedResponseHead->GetHeader(nsHttp::Last_Modified, val);
+      usable = val.Equals(mSpeculativeRevalLastModified);
+    }
+  }
+  if (usable) {
+    // The server may answer 304 for matching validators even though our
+    // copy of the body is incomplete. Unlike OnCacheEntryCheck we never
+    // turn a speculative validation into a byte range request, so an
+    // incomplete entry cannot serve this load.
+    int64_t size = 0;
+    int64_t contentLength = 0;
+    usable = NS_SUCCEEDED(CheckPartial(mCacheEntry, &size, &contentLength)) &&
+             size != int64_t(-1) &&
+             (contentLength == int64_t(-1) || size == contentLength);
+  }
+
+  if (!usable) {
+    LOG(("  the entry is gone or its validators changed\n"));
+    // Drop the remembered validators so the reload won't guess the same
+    // ones again, and take the usual recovery path for a revalidation that
+    // cannot read the entry: an internal redirect to the same URI.
+    ForgetSpeculativeValidators();
+    return ContinueProcessResponseAfterNotModified(NS_ERROR_NOT_AVAILABLE);
+  }
+
+  // From here on this is the classic revalidation flow: the transaction gets
+  // replaced and the body is read from the cache entry. The race is decided,
+  // so drop the racing flag to let the cache pump's notifications through.
+  mRaceCacheWithNetwork = false;
+  mDidReval = true;
+
+  auto func = [](auto* self, nsresult aRv) {
+    return self->ContinueProcessResponseAfterNotModified(aRv);
+  };
+  nsresult rv = ProcessNotModified(func);
+  if (!mSuspendCount || NS_FAILED(rv)) {
+    return ContinueProcessResponseAfterNotModified(rv);
+  }
+  return NS_OK;
+}
+
 // Determines if a request is a byte range request for a subrange,
 // i.e. is a byte range request, but not a 0- byte range request.
 static bool IsSubRangeRequest(nsHttpRequestHead& aRequestHead) {
@@ -3578,6 +3674,115 @@ void nsHttpChannel::UntieValidationRequest() {
   MOZ_ASSERT(NS_SUCCEEDED(rv));
 }
 
+// Remember the validators of a response for this URI so that a later load
+// can race a conditional request before its cache entry has opened. The
+// table deliberately outlives the channel: it is a session-scoped memory
+// keyed by URI spec, capped in size and dropped at shutdown.
+void nsHttpChannel::RememberSpeculativeValidators(
+    nsHttpResponseHead* aResponseHead) {
+  MOZ_ASSERT(NS_IsMainThread());
+
+  if (!StaticPrefs::network_http_rcwn_speculative_revalidation() ||
+      !StaticPrefs::network_http_rcwn_enabled()) {
+    return;
+  }
+  if (mPostID || !(mRequestHead.IsGet() || mRequestHead.IsHead())) {
+    return;
+  }
+  if (aResponseHead->NoStore() || aResponseHead->Status() >= 400) {
+    return;
+  }
+
+  nsAutoCString etag;
+  nsAutoCString lastModified;
+  Unused << aResponseHead->GetHeader(nsHttp::ETag, etag);
+  Unused << aResponseHead->GetHeader(nsHttp::Last_Modified, lastModified);
+
+  if (etag.IsEmpty() && lastModified.IsEmpty()) {
+    // The response can't be revalidated; make sure we don't keep guessing
+    // validators an older response carried.
+    ForgetSpeculativeValidators();
+    return;
+  }
+
+  if (!sSpeculativeValidators) {
+    sSpeculativeValidators =
+        new nsTHashMap<nsCStringHashKey, SpeculativeValidators>();
+    ClearOnShutdown(&sSpeculativeValidators);
+  }
+
+  if (sSpeculativeValidators->Count() >= kSpeculativeValidatorsLimit &&
+      !sSpeculativeValidators->Lookup(mSpec)) {
+    // Starting over is crude but cheap; the table refills with the URIs
+    // that are actually being loaded.
+    sSpeculativeValidators->Clear();
+  }
+
+  SpeculativeValidators& validators =
+      sSpeculativeValidators->LookupOrInsert(mSpec);
+  validators.mETag = etag;
+  validators.mLastModified = lastModified;
+}
+
+void nsHttpChannel::ForgetSpeculativeValidators() {
+  MOZ_ASSERT(NS_IsMainThread());
+
+  if (sSpeculativeValidators) {
+    sSpeculativeValidators->Remove(mSpec);
+  }
+}
+
+// Make a raced network request conditional using validators remembered from
+// a previous response for this URI. When the cache entry would have required
+// validation anyway, this turns the full re-transfer after losing the race
+// into a 304 whose body is served from the entry.
+void nsHttpChannel::MaybeAddSpeculativeValidationHeaders() {
+  MOZ_ASSERT(NS_IsMainThread());
+
+  if (!StaticPrefs::network_http_rcwn_speculative_revalidation()) {
+    return;
+  }
+
+  // Same restrictions as for conditional headers built from the entry in
+  // OnCacheEntryCheck, plus the request must not be conditional already.
+  if (mDidReval || mDidSpeculativeReval || LoadCustomConditionalRequest() ||
+      LoadCachedContentIsPartial()) {
+    return;
+  }
+  if (mPostID || !(mRequestHead.IsGet() || mRequestHead.IsHead())) {
+    return;
+  }
+  if (BYPASS_LOCAL_CACHE(mLoadFlags, LoadPreferCacheLoadOverBypass())) {
+    // There would be no entry to serve the body of a 304 from.
+    return;
+  }
+
+  if (!sSpeculativeValidators) {
+    return;
+  }
+  auto validators = sSpeculativeValidators->Lookup(mSpec);
+  if (!validators) {
+    return;
+  }
+
+  LOG(("nsHttpChannel::MaybeAddSpeculativeValidationHeaders [this=%p]\n",
+       this));
+
+  DebugOnly<nsresult> rv{};
+  if (!validators->mLastModified.IsEmpty()) {
+    rv = mRequestHead.SetHeader(nsHttp::If_Modified_Since,
+                                validators->mLastModified);
+    MOZ_ASSERT(NS_SUCCEEDED(rv));
+  }
+  if (!validators->mETag.IsEmpty()) {
+    rv = mRequestHead.SetHeader(nsHttp::If_None_Match, validators->mETag);
+    MOZ_ASSERT(NS_SUCCEEDED(rv));
+  }
+  mSpeculativeRevalETag = validators->mETag;
+  mSpeculativeRevalLastModified = validators->mLastModified;
+  mDidSpeculativeReval = true;
+}
+
 NS_IMETHODIMP
 nsHttpChannel::OnCacheEntryCheck(nsICacheEntry* entry, uint32_t* aResult) {
   nsresult rv = NS_OK;
@@ -3588,6 +3793,30 @@ nsHttpChannel::OnCacheEntryCheck(nsICacheEntry* entry, uint32_t* aResult) {
   mozilla::MutexAutoLock lock(mRCWNLock);
 
   if (mRaceCacheWithNetwork && mFirstResponseSource == RESPONSE_FROM_NETWORK) {
+    if (mDidSpeculativeReval) {
+      // The raced request carried validators remembered from a previous
+      // response. If the server answered 304 the body has to come from this
+      // entry, so it must not be dropped just because the network delivered
+      // its headers first. ProcessSpeculativeNotModified() decides whether
+      // the entry can actually be used.
+      LOG(
+          ("Keeping the entry; the network response may be a 304 to a "
+           "speculative validation\n"));
+      mCachedResponseHead = MakeUnique<nsHttpResponseHead>();
+      rv = nsHttp::GetHttpResponseHeadFromCacheEntry(
+          entry, mCachedResponseHead.get());
+      if (NS_SUCCEEDED(rv)) {
+        rv = OpenCacheInputStream(entry, false);
+      }
+      if (NS_FAILED(rv)) {
+        mCachedResponseHead = nullptr;
+        *aResult = ENTRY_NOT_WANTED;
+        return NS_OK;
+      }
+      *aResult = ENTRY_NEEDS_REVALIDATION;
+      return NS_OK;
+    }
+
     LOG(
         ("Not using cached response because we've already got one from the "
          "network\n"));
@@ -3967,6 +4196,12 @@ nsHttpChannel::OnCacheEntryAvailable(nsICacheEntry* entry, bool aNew,
   rv = OnCacheEntryAvailableInternal(entry, aNew, status);
   if (NS_FAILED(rv)) {
     CloseCacheEntry(false);
+    if (mWaitingForSpeculative304 && !mCanceled) {
+      // The deferred 304 now has its answer: there is no entry to serve
+      // the body from, so it will take the refetch path.
+      mWaitingForSpeculative304 = false;
+      return ProcessSpeculativeNotModified();
+    }
     if (mRaceCacheWithNetwork && mNetworkTriggered &&
         mFirstResponseSource != RESPONSE_FROM_CACHE) {
       // Ignore the error if we're racing cache with network and the cache
@@ -4021,9 +4256,10 @@ nsresult nsHttpChannel::OnCacheEntryAvailableInternal(nsICacheEntry* entry,
     return NS_OK;
   }
 
-  if (mRaceCacheWithNetwork && ((mCacheEntry && !mCachedContentIsValid &&
-                                 (mDidReval || LoadCachedContentIsPartial())) ||
-                                mIgnoreCacheEntry)) {
+  if (mRaceCacheWithNetwork && !mDidSpeculativeReval &&
+      ((mCacheEntry && !mCachedContentIsValid &&
+        (mDidReval || LoadCachedContentIsPartial())) ||
+       mIgnoreCacheEntry)) {
     // We won't send the conditional request because the unconditional
     // request was already sent (see bug 1377223).
     AccumulateCategorical(
@@ -4034,6 +4270,17 @@ nsresult nsHttpChannel::OnCacheEntryAvailableInternal(nsICacheEntry* entry,
     Unused << ReadFromCache(true);
   }
 
+  if (mCacheEntry && mCachedResponseHead) {
+    RememberSpeculativeValidators(mCachedResponseHead.get());
+  }
+
+  if (mWaitingForSpeculative304) {
+    // A 304 answered the speculative validation before the entry callbacks
+    // completed; it can be resolved against the entry now.
+    mWaitingForSpeculative304 = false;
+    return ProcessSpeculativeNotModified();
+  }
+
   return TriggerNetwork();
 }
 
@@ -4674,6 +4921,8 @@ nsresult nsHttpChannel::InitCacheEntry() {
   // Don't perform the check when writing (doesn't make sense)
   StoreConcurrentCacheAccess(0);
 
+  RememberSpeculativeValidators(mResponseHead.get());
+
   return NS_OK;
 }
 
@@ -7251,6 +7500,14 @@ nsresult nsHttpChannel::ContinueOnStopRequestAfterAuthRetry(
     return NS_OK;
   }
 
+  // A 304 answer to a speculative validation is still waiting for the cache
+  // entry callbacks; whether the transaction ends up replaced is decided in
+  // ProcessSpeculativeNotModified, which notifies the listener either way.
+  if (mWaitingForSpeculative304) {
+    LOG(("Deferred speculative 304 still pending\n"));
+    return NS_OK;
+  }
+
   bool upgradeWebsocket = mUpgradeProtocolCallback && aTransWithStickyConn &&
                           mResponseHead &&
                           ((mResponseHead->Status() == 101 &&
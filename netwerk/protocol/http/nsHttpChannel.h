@@ -497,6 +497,19 @@ class nsHttpChannel final : public HttpBaseChannel,
   [[nodiscard]] nsresult SetupByteRangeRequest(int64_t partialLen);
   void UntieByteRangeRequest();
   void UntieValidationRequest();
+
+  // Speculative revalidation when racing cache with network: remember the
+  // validators a response carried so that a later load of the same URI can
+  // make its raced request conditional before the cache entry has opened.
+  void RememberSpeculativeValidators(nsHttpResponseHead* aResponseHead);
+  void ForgetSpeculativeValidators();
+  // Must be called with mRCWNLock held, before the transaction picks up the
+  // request head.
+  void MaybeAddSpeculativeValidationHeaders();
+  // Resolves a 304 answer to a speculative validation against the cache
+  // entry once the entry callbacks have completed.
+  [[nodiscard]] nsresult ProcessSpeculativeNotModified();
+
   [[nodiscard]] nsresult OpenCacheInputStream(nsICacheEntry* cacheEntry,
                                               bool startBuffering);
 
@@ -772,6 +785,18 @@ class nsHttpChannel final : public HttpBaseChannel,
   // SetupTransaction removed conditional headers and decisions made in
   // OnCacheEntryCheck are no longer valid.
   bool mIgnoreCacheEntry{false};
+  // True if the raced network request was made conditional with validators
+  // remembered from a previous response instead of validators read from the
+  // cache entry. Written under mRCWNLock on the main thread; read from
+  // OnCacheEntryCheck under the same lock.
+  bool mDidSpeculativeReval{false};
+  // True if a 304 answered a speculative validation while the cache entry
+  // callbacks were still pending; processing resumes when they complete.
+  bool mWaitingForSpeculative304{false};
+  // The exact validators the speculative conditional request carried. The
+  // 304 may only be applied to an entry that still carries the same ones.
+  nsCString mSpeculativeRevalETag;
+  nsCString mSpeculativeRevalLastModified;
   // Lock preventing SetupTransaction/MaybeCreateCacheEntryWhenRCWN and
   // OnCacheEntryCheck being called at the same time.
   mozilla::Mutex mRCWNLock{"nsHttpChannel.mRCWNLock"};
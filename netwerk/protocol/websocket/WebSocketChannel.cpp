@@ -518,36 +518,40 @@ nsWSAdmissionManager* nsWSAdmissionManager::sManager;
 StaticMutex nsWSAdmissionManager::sLock;
 
 //-----------------------------------------------------------------------------
-// CallOnMessageAvailable
+// CallOnMessagesAvailable
 //-----------------------------------------------------------------------------
 
-class CallOnMessageAvailable final : public Runnable {
+// Delivers the batch of messages decoded from one socket read, so that a read
+// carrying many small frames costs a single event on the target thread rather
+// than one per frame.
+class CallOnMessagesAvailable final : public Runnable {
  public:
-  CallOnMessageAvailable(WebSocketChannel* aChannel, nsACString& aData,
-                         int32_t aLen)
-      : Runnable("net::CallOnMessageAvailable"),
+  CallOnMessagesAvailable(WebSocketChannel* aChannel,
+                          nsTArray<WebSocketInboundMessage>&& aMessages)
+      : Runnable("net::CallOnMessagesAvailable"),
         mChannel(aChannel),
         mListenerMT(aChannel->mListenerMT),
-        mData(aData),
-        mLen(aLen) {}
+        mMessages(std::move(aMessages)) {}
 
   NS_IMETHOD Run() override {
     MOZ_ASSERT(mChannel->IsOnTargetThread());
 
     if (mListenerMT) {
-      nsresult rv;
-      if (mLen < 0) {
-        rv = mListenerMT->mListener->OnMessageAvailable(mListenerMT->mContext,
-                                                        mData);
-      } else {
-        rv = mListenerMT->mListener->OnBinaryMessageAvailable(
-            mListenerMT->mContext, mData);
-      }
-      if (NS_FAILED(rv)) {
-        LOG(
-            ("OnMessageAvailable or OnBinaryMessageAvailable "
-             "failed with 0x%08" PRIx32,
-             static_cast<uint32_t>(rv)));
+      for (const WebSocketInboundMessage& message : mMessages) {
+        nsresult rv;
+        if (message.mLen < 0) {
+          rv = mListenerMT->mListener->OnMessageAvailable(mListenerMT->mContext,
+                                                          message.mData);
+        } else {
+          rv = mListenerMT->mListener->OnBinaryMessageAvailable(
+              mListenerMT->mContext, message.mData);
+        }
+        if (NS_FAILED(rv)) {
+          LOG(
+              ("OnMessageAvailable or OnBinaryMessageAvailable "
+               "failed with 0x%08" PRIx32,
+               static_cast<uint32_t>(rv)));
+        }
       }
     }
 
@@ -555,12 +559,11 @@ class CallOnMessageAvailable final : public Runnable {
   }
 
  private:
-  ~CallOnMessageAvailable() = default;
+  ~CallOnMessagesAvailable() = default;
 
   RefPtr<WebSocketChannel> mChannel;
   RefPtr<BaseWebSocketChannel::ListenerAndContextContainer> mListenerMT;
-  nsCString mData;
-  int32_t mLen;
+  nsTArray<WebSocketInboundMessage> mMessages;
 };
 
 //-----------------------------------------------------------------------------
@@ -1416,6 +1419,11 @@ nsresult WebSocketChannel::ProcessInput(uint8_t* buffer, uint32_t count) {
 
   nsresult rv;
 
+  // Deliver whatever accumulated in mPendingInboundMessages on every way out
+  // of this function, including the error paths: an error dispatches OnStop
+  // from the caller, and the messages must reach the listener before it.
+  auto flushPendingMessages = MakeScopeExit([&] { DispatchPendingMessages(); });
+
   // The purpose of ping/pong is to actively probe the peer so that an
   // unreachable peer is not mistaken for a period of idleness. This
   // implementation accepts any application level read activity as a sign of
@@ -1656,8 +1664,8 @@ nsresult WebSocketChannel::ProcessInput(uint8_t* buffer, uint32_t count) {
           mService->FrameReceived(mSerial, mInnerWindowID, frame.forget());
         }
 
-        mTargetThread->Dispatch(new CallOnMessageAvailable(this, utf8Data, -1),
-                                NS_DISPATCH_NORMAL);
+        mPendingInboundMessages.AppendElement(
+            WebSocketInboundMessage{std::move(utf8Data), -1});
         if (mConnectionLogService && !mPrivateBrowsing) {
           mConnectionLogService->NewMsgReceived(mHost, mSerial, count);
           LOG(("Added new msg received for %s", mHost.get()));
@@ -1716,6 +1724,9 @@ nsresult WebSocketChannel::ProcessInput(uint8_t* buffer, uint32_t count) {
         }
 
         if (mListenerMT) {
+          // Flush any batched messages first so they are delivered before the
+          // close notification.
+          DispatchPendingMessages();
           mTargetThread->Dispatch(
               new CallOnServerClose(this, mServerCloseCode, mServerCloseReason),
               NS_DISPATCH_NORMAL);
@@ -1782,9 +1793,9 @@ nsresult WebSocketChannel::ProcessInput(uint8_t* buffer, uint32_t count) {
           mService->FrameReceived(mSerial, mInnerWindowID, frame.forget());
         }
 
-        mTargetThread->Dispatch(
-            new CallOnMessageAvailable(this, binaryData, binaryData.Length()),
-            NS_DISPATCH_NORMAL);
+        int32_t len = binaryData.Length();
+        mPendingInboundMessages.AppendElement(
+            WebSocketInboundMessage{std::move(binaryData), len});
         // To add the header to 'Networking Dashboard' log
         if (mConnectionLogService && !mPrivateBrowsing) {
           mConnectionLogService->NewMsgReceived(mHost, mSerial, count);
@@ -1842,6 +1853,20 @@ nsresult WebSocketChannel::ProcessInput(uint8_t* buffer, uint32_t count) {
   return NS_OK;
 }
 
+void WebSocketChannel::DispatchPendingMessages() {
+  MOZ_ASSERT(OnSocketThread(), "not on socket thread");
+
+  if (mPendingInboundMessages.IsEmpty()) {
+    return;
+  }
+
+  LOG(("WebSocketChannel::DispatchPendingMessages %p [%zu messages]\n", this,
+       mPendingInboundMessages.Length()));
+  mTargetThread->Dispatch(
+      new CallOnMessagesAvailable(this, std::move(mPendingInboundMessages)),
+      NS_DISPATCH_NORMAL);
+}
+
 /* static */
 void WebSocketChannel::ApplyMask(uint32_t mask, uint8_t* data, uint64_t len) {
   if (!data || len == 0) return;
@@ -23,6 +23,7 @@
 
 #include "nsCOMPtr.h"
 #include "nsString.h"
+#include "nsTArray.h"
 #include "nsDeque.h"
 #include "mozilla/Atomics.h"
 
@@ -41,7 +42,7 @@ class OutboundMessage;
 class OutboundEnqueuer;
 class nsWSAdmissionManager;
 class PMCECompression;
-class CallOnMessageAvailable;
+class CallOnMessagesAvailable;
 class CallOnStop;
 class CallOnServerClose;
 class CallAcknowledge;
@@ -52,6 +53,14 @@ class WebSocketEventService;
 extern void ProcessServerWebSocketExtensions(const nsACString& aExtensions,
                                              nsACString& aNegotiatedExtensions);
 
+// A decoded inbound message awaiting delivery on the target thread.
+// ProcessInput() accumulates these so that one socket read costs at most one
+// listener event, no matter how many frames it carried.
+struct WebSocketInboundMessage {
+  nsCString mData;
+  int32_t mLen;  // < 0 for text messages, else the binary message length
+};
+
 // Used to enforce "1 connecting websocket per host" rule, and reconnect delays
 enum wsConnectingState {
   NOT_CONNECTING = 0,     // Not yet (or no longer) trying to open connection
@@ -130,7 +139,7 @@ class WebSocketChannel : public BaseWebSocketChannel,
   friend class OutboundEnqueuer;
   friend class nsWSAdmissionManager;
   friend class FailDelayManager;
-  friend class CallOnMessageAvailable;
+  friend class CallOnMessagesAvailable;
   friend class CallOnStop;
   friend class CallOnServerClose;
   friend class CallAcknowledge;
@@ -177,6 +186,7 @@ class WebSocketChannel : public BaseWebSocketChannel,
 
   bool IsPersistentFramePtr();
   [[nodiscard]] nsresult ProcessInput(uint8_t* buffer, uint32_t count);
+  void DispatchPendingMessages();
   [[nodiscard]] bool UpdateReadBuffer(uint8_t* buffer, uint32_t count,
                                       uint32_t accumulatedFragments,
                                       uint32_t* available);
@@ -274,6 +284,10 @@ class WebSocketChannel : public BaseWebSocketChannel,
   // increase the buffer temporarily, then drop back down to this size.
   const static uint32_t kIncomingBufferStableSize = 128 * 1024;
 
+  // Messages decoded from the buffer ProcessInput() is currently working on,
+  // flushed to the target thread in a single CallOnMessagesAvailable event.
+  nsTArray<WebSocketInboundMessage> mPendingInboundMessages;
+
   uint8_t* mFramePtr;
   uint8_t* mBuffer;
   uint8_t mFragmentOpcode;
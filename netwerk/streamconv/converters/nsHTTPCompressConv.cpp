@@ -45,6 +45,10 @@ class BrotliWrapper {
   nsresult mStatus = NS_OK;
   Atomic<bool, Relaxed> mBrotliStateIsStreamEnd{false};
 
+  // Scratch output buffer, allocated on the first OnDataAvailable and reused
+  // for the rest of the stream.
+  UniquePtr<uint8_t[]> mOutBuffer;
+
   nsIRequest* mRequest{nullptr};
   nsISupports* mContext{nullptr};
   uint64_t mSourceOffset{0};
@@ -201,15 +205,18 @@ nsresult nsHTTPCompressConv::BrotliHandler(nsIInputStream* stream,
     return NS_OK;
   }
 
-  auto outBuffer = MakeUniqueFallible<uint8_t[]>(kOutSize);
-  if (outBuffer == nullptr) {
-    self->mBrotli->mStatus = NS_ERROR_OUT_OF_MEMORY;
-    return self->mBrotli->mStatus;
+  if (!self->mBrotli->mOutBuffer) {
+    self->mBrotli->mOutBuffer = MakeUniqueFallible<uint8_t[]>(kOutSize);
+    if (!self->mBrotli->mOutBuffer) {
+      self->mBrotli->mStatus = NS_ERROR_OUT_OF_MEMORY;
+      return self->mBrotli->mStatus;
+    }
   }
+  uint8_t* const outBuffer = self->mBrotli->mOutBuffer.get();
 
   do {
     outSize = kOutSize;
-    outPtr = outBuffer.get();
+    outPtr = outBuffer;
 
     // brotli api is documented in brotli/dec/decode.h and brotli/dec/decode.c
     LOG(("nsHttpCompresssConv %p brotlihandler decompress %zu\n", self, avail));
@@ -246,7 +253,7 @@ nsresult nsHTTPCompressConv::BrotliHandler(nsIInputStream* stream,
       nsresult rv = self->do_OnDataAvailable(
           self->mBrotli->mRequest, self->mBrotli->mContext,
           self->mBrotli->mSourceOffset,
-          reinterpret_cast<const char*>(outBuffer.get()), outSize);
+          reinterpret_cast<const char*>(outBuffer), outSize);
       LOG(("nsHttpCompressConv %p BrotliHandler ODA rv=%" PRIx32, self,
            static_cast<uint32_t>(rv)));
       if (NS_FAILED(rv)) {
@@ -3,6 +3,9 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "nsHtml5Module.h"
+
+#include <algorithm>
+
 #include "mozilla/Attributes.h"
 #include "mozilla/Preferences.h"
 #include "mozilla/Services.h"
@@ -17,11 +20,15 @@
 #include "nsHtml5TreeBuilder.h"
 #include "nsHtml5UTF16Buffer.h"
 #include "nsIObserverService.h"
+#ifdef MOZ_MEMORY
+#  include "mozmemory.h"
+#endif
 
 using namespace mozilla;
 
 // static
-nsIThread* nsHtml5Module::sStreamParserThread = nullptr;
+nsIThread* nsHtml5Module::sStreamParserThreads[kMaxStreamParserThreads] = {};
+size_t nsHtml5Module::sNextStreamParserThread = 0;
 nsIThread* nsHtml5Module::sMainThread = nullptr;
 
 // static
@@ -54,7 +61,9 @@ void nsHtml5Module::ReleaseStatics() {
   nsHtml5Tokenizer::releaseStatics();
   nsHtml5TreeBuilder::releaseStatics();
   nsHtml5UTF16Buffer::releaseStatics();
-  NS_IF_RELEASE(sStreamParserThread);
+  for (size_t i = 0; i < kMaxStreamParserThreads; ++i) {
+    NS_IF_RELEASE(sStreamParserThreads[i]);
+  }
   NS_IF_RELEASE(sMainThread);
 }
 
@@ -91,15 +100,36 @@ NS_IMPL_ISUPPORTS(nsHtml5ParserThreadTerminator, nsIObserver)
 // static
 nsIThread* nsHtml5Module::GetStreamParserThread() {
   if (StaticPrefs::html5_offmainthread()) {
-    if (!sStreamParserThread) {
-      NS_NewNamedThread("HTML5 Parser", &sStreamParserThread);
-      NS_ASSERTION(sStreamParserThread, "Thread creation failed!");
+    // Hand out threads from a small pool round-robin so that documents
+    // parsing concurrently (e.g. a top-level page and its iframes) don't
+    // queue behind each other on a single thread. Each stream parser is
+    // bound to the one thread it gets here for its whole lifetime, so the
+    // per-document serial ordering the parser relies on is unaffected.
+    size_t poolSize = std::max<size_t>(
+        1, std::min<size_t>(StaticPrefs::html5_parser_threads(),
+                            kMaxStreamParserThreads));
+    size_t index = sNextStreamParserThread++ % poolSize;
+    if (!sStreamParserThreads[index]) {
+      NS_NewNamedThread("HTML5 Parser", &sStreamParserThreads[index]);
+      NS_ASSERTION(sStreamParserThreads[index], "Thread creation failed!");
+#ifdef MOZ_MEMORY
+      // Parser threads allocate heavily while tokenizing; give each its own
+      // jemalloc arena. The threads live until shutdown, so there's no need
+      // to undo this.
+      if (sStreamParserThreads[index]) {
+        sStreamParserThreads[index]->Dispatch(
+            NS_NewRunnableFunction("nsHtml5Module::ThreadLocalArena",
+                                   [] { jemalloc_thread_local_arena(true); }),
+            NS_DISPATCH_NORMAL);
+      }
+#endif
       nsCOMPtr<nsIObserverService> os = mozilla::services::GetObserverService();
       NS_ASSERTION(os, "do_GetService failed");
-      os->AddObserver(new nsHtml5ParserThreadTerminator(sStreamParserThread),
-                      "xpcom-shutdown-threads", false);
+      os->AddObserver(
+          new nsHtml5ParserThreadTerminator(sStreamParserThreads[index]),
+          "xpcom-shutdown-threads", false);
     }
-    return sStreamParserThread;
+    return sStreamParserThreads[index];
   }
   if (!sMainThread) {
     NS_GetMainThread(&sMainThread);
@@ -20,7 +20,11 @@ class nsHtml5Module {
 #ifdef DEBUG
   static bool sNsHtml5ModuleInitialized;
 #endif
-  static nsIThread* sStreamParserThread;
+  // Upper bound on the stream parser thread pool size; the actual size is
+  // html5.parser_threads clamped to [1, kMaxStreamParserThreads].
+  static const size_t kMaxStreamParserThreads = 8;
+  static nsIThread* sStreamParserThreads[kMaxStreamParserThreads];
+  static size_t sNextStreamParserThread;
   static nsIThread* sMainThread;
 };
 
@@ -501,6 +501,10 @@ stateloop:
               [[fallthrough]];
             }
             default: {
+              // Manual change relative to Tokenizer.java: skip ahead to the
+              // last code unit before the next one the data state has to act
+              // on individually.
+              pos = SkipUntilSignificant(buf, pos, endPos, '&', '<');
               continue;
             }
           }
@@ -930,6 +934,14 @@ stateloop:
             }
             default: {
               appendStrBuf(c);
+              // Manual change relative to Tokenizer.java: copy the run of
+              // code units that need no individual handling in one go.
+              int32_t newPos =
+                  SkipUntilSignificant(buf, pos, endPos, '\"', '&');
+              if (newPos > pos) {
+                appendStrBuf(buf, pos + 1, newPos - pos);
+                pos = newPos;
+              }
               continue;
             }
           }
@@ -4,6 +4,40 @@
 
 #include "mozilla/CheckedInt.h"
 #include "mozilla/Likely.h"
+#include "mozilla/SSE.h"
+
+#ifdef MOZILLA_MAY_SUPPORT_SSE2
+namespace mozilla::SSE2 {
+int32_t Html5TokenizerSkipUntilSignificant(const char16_t* aBuf, int32_t aPos,
+                                           int32_t aEnd, char16_t aV1,
+                                           char16_t aV2);
+}  // namespace mozilla::SSE2
+#endif
+
+static int32_t SkipUntilSignificantUnvectorized(const char16_t* aBuf,
+                                                int32_t aPos, int32_t aEnd,
+                                                char16_t aV1, char16_t aV2) {
+  for (int32_t i = aPos + 1; i < aEnd; ++i) {
+    char16_t c = aBuf[i];
+    if (c == aV1 || c == aV2 || c == '\0' || c == '\n' || c == '\r') {
+      return i - 1;
+    }
+  }
+  return aEnd - 1;
+}
+
+// static
+int32_t nsHtml5Tokenizer::SkipUntilSignificant(const char16_t* aBuf,
+                                               int32_t aPos, int32_t aEnd,
+                                               char16_t aV1, char16_t aV2) {
+#ifdef MOZILLA_MAY_SUPPORT_SSE2
+  if (mozilla::supports_sse2()) {
+    return mozilla::SSE2::Html5TokenizerSkipUntilSignificant(aBuf, aPos, aEnd,
+                                                             aV1, aV2);
+  }
+#endif
+  return SkipUntilSignificantUnvectorized(aBuf, aPos, aEnd, aV1, aV2);
+}
 
 // INT32_MAX is (2^31)-1. Therefore, the highest power-of-two that fits
 // is 2^30. Note that this is counting char16_t units. The underlying
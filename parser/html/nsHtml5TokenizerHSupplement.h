@@ -4,6 +4,16 @@
 
 inline nsHtml5HtmlAttributes* GetAttributes() { return attributes; }
 
+/**
+ * Returns the index of the last code unit in (aPos, aEnd) before the next
+ * code unit the tokenizer has to act on individually in a text-like state,
+ * i.e. before the next occurrence of aV1, aV2, '\0', '\n' or '\r'. Returns
+ * aEnd - 1 if there is no such code unit. The code unit at aPos itself is
+ * not examined.
+ */
+static int32_t SkipUntilSignificant(const char16_t* aBuf, int32_t aPos,
+                                    int32_t aEnd, char16_t aV1, char16_t aV2);
+
 /**
  * Makes sure the buffers are large enough to be able to tokenize aLength
  * UTF-16 code units before having to make the buffers larger.
@@ -0,0 +1,53 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// This file should only be compiled if you're on x86 or x86_64.  Additionally,
+// you'll need to compile this file with -msse2 if you're using gcc.
+
+#include <emmintrin.h>
+#include <stdint.h>
+
+#include "mozilla/MathAlgorithms.h"
+
+namespace mozilla::SSE2 {
+
+// Vectorized counterpart of nsHtml5Tokenizer::SkipUntilSignificant(): scans
+// (aPos, aEnd) for the first code unit equal to aV1, aV2, '\0', '\n' or '\r'
+// and returns the index just before it, or aEnd - 1 if there is none.
+int32_t Html5TokenizerSkipUntilSignificant(const char16_t* aBuf, int32_t aPos,
+                                           int32_t aEnd, char16_t aV1,
+                                           char16_t aV2) {
+  int32_t i = aPos + 1;
+  const __m128i v1 = _mm_set1_epi16(static_cast<int16_t>(aV1));
+  const __m128i v2 = _mm_set1_epi16(static_cast<int16_t>(aV2));
+  const __m128i nul = _mm_setzero_si128();
+  const __m128i lf = _mm_set1_epi16(0x000A);
+  const __m128i cr = _mm_set1_epi16(0x000D);
+  // Check eight code units (one XMM register) at a time.
+  for (; i + 8 <= aEnd; i += 8) {
+    const __m128i vect =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(aBuf + i));
+    __m128i hits = _mm_or_si128(_mm_cmpeq_epi16(vect, v1),
+                                _mm_cmpeq_epi16(vect, v2));
+    hits = _mm_or_si128(hits, _mm_cmpeq_epi16(vect, nul));
+    hits = _mm_or_si128(hits, _mm_cmpeq_epi16(vect, lf));
+    hits = _mm_or_si128(hits, _mm_cmpeq_epi16(vect, cr));
+    const uint32_t mask = _mm_movemask_epi8(hits);
+    if (mask) {
+      return i + int32_t(mozilla::CountTrailingZeroes32(mask) >> 1) - 1;
+    }
+  }
+  // Take care of the remainder one code unit at a time.
+  for (; i < aEnd; ++i) {
+    const char16_t c = aBuf[i];
+    if (c == aV1 || c == aV2 || c == '\0' || c == '\n' || c == '\r') {
+      return i - 1;
+    }
+  }
+  return aEnd - 1;
+}
+
+}  // namespace mozilla::SSE2
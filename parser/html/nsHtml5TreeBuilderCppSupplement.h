@@ -328,6 +328,29 @@ nsIContentHandle* nsHtml5TreeBuilder::createElement(
                 }
                 // Other "as" values will be supported later.
               }
+            } else if (StaticPrefs::network_modulepreload() &&
+                       rel.LowerCaseEqualsASCII("modulepreload")) {
+              nsHtml5String url =
+                  aAttributes->getValue(nsHtml5AttributeName::ATTR_HREF);
+              if (url) {
+                nsHtml5String crossOrigin = aAttributes->getValue(
+                    nsHtml5AttributeName::ATTR_CROSSORIGIN);
+                nsHtml5String integrity =
+                    aAttributes->getValue(nsHtml5AttributeName::ATTR_INTEGRITY);
+                nsHtml5String referrerPolicy = aAttributes->getValue(
+                    nsHtml5AttributeName::ATTR_REFERRERPOLICY);
+                // Speculatively fetch the module itself. Once it arrives, the
+                // module loader compiles it and recursively fetches its
+                // static imports, so the whole dependency graph starts
+                // loading ahead of the script element that imports it.
+                nsHtml5String moduleType =
+                    nsHtml5String::FromLiteral("module");
+                mSpeculativeLoadQueue.AppendElement()->InitScript(
+                    url, nullptr, moduleType, crossOrigin, nullptr, integrity,
+                    referrerPolicy, mode == nsHtml5TreeBuilder::IN_HEAD, false,
+                    false, false, true);
+                moduleType.Release();
+              }
             }
           }
         } else if (nsGkAtoms::video == aName) {
@@ -621,6 +644,13 @@ void nsHtml5TreeBuilder::appendElement(nsIContentHandle* aChild,
     return;
   }
 
+  if (!mOpQueue.IsEmpty() &&
+      mOpQueue.LastElement().TryAppendAfterCreate(aChild, aParent)) {
+    // Common case: the preceding op created aChild for aParent, so the
+    // append was fused into it and no separate op is needed.
+    return;
+  }
+
   nsHtml5TreeOperation* treeOp = mOpQueue.AppendElement(mozilla::fallible);
   if (MOZ_UNLIKELY(!treeOp)) {
     MarkAsBrokenAndRequestSuspensionWithoutBuilder(NS_ERROR_OUT_OF_MEMORY);
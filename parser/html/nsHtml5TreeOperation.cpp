@@ -205,6 +205,31 @@ nsHtml5TreeOperation::~nsHtml5TreeOperation() {
   mOperation.match(TreeOperationMatcher());
 }
 
+bool nsHtml5TreeOperation::TryAppendAfterCreate(nsIContentHandle* aChild,
+                                                nsIContentHandle* aParent) {
+  if (mOperation.is<opCreateHTMLElement>()) {
+    opCreateHTMLElement& op = mOperation.as<opCreateHTMLElement>();
+    if (op.mContent == static_cast<nsIContent**>(aChild) &&
+        op.mIntendedParent == static_cast<nsIContent**>(aParent)) {
+      op.mAppendToIntendedParent = true;
+      return true;
+    }
+    return false;
+  }
+  if (mOperation.is<opCreateSVGElement>()) {
+    opCreateSVGElement& op = mOperation.as<opCreateSVGElement>();
+    if (op.mContent == static_cast<nsIContent**>(aChild) &&
+        op.mIntendedParent == static_cast<nsIContent**>(aParent)) {
+      op.mAppendToIntendedParent = true;
+      return true;
+    }
+    return false;
+  }
+  // opCreateMathMLElement doesn't carry the FromParser value the append
+  // would need, so MathML creates are left unfused.
+  return false;
+}
+
 nsresult nsHtml5TreeOperation::AppendTextToTextNode(
     const char16_t* aBuffer, uint32_t aLength, dom::Text* aTextNode,
     nsHtml5DocumentBuilder* aBuilder) {
@@ -852,6 +877,11 @@ nsresult nsHtml5TreeOperation::Perform(nsHtml5TreeOpExecutor* aBuilder,
 
       *target = CreateHTMLElement(name, attributes, aOperation.mFromNetwork,
                                   nodeInfoManager, mBuilder, creator);
+      if (aOperation.mAppendToIntendedParent) {
+        MOZ_ASSERT(intendedParent, "Fused append without a parent.");
+        return Append(*target, intendedParent, aOperation.mFromNetwork,
+                      mBuilder);
+      }
       return NS_OK;
     }
 
@@ -871,6 +901,11 @@ nsresult nsHtml5TreeOperation::Perform(nsHtml5TreeOpExecutor* aBuilder,
 
       *target = CreateSVGElement(name, attributes, aOperation.mFromNetwork,
                                  nodeInfoManager, mBuilder, creator);
+      if (aOperation.mAppendToIntendedParent) {
+        MOZ_ASSERT(intendedParent, "Fused append without a parent.");
+        return Append(*target, intendedParent, aOperation.mFromNetwork,
+                      mBuilder);
+      }
       return NS_OK;
     }
 
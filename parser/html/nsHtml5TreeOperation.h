@@ -97,6 +97,9 @@ struct opCreateHTMLElement {
   mozilla::dom::HTMLContentCreatorFunction mCreator;
   nsIContent** mIntendedParent;
   mozilla::dom::FromParser mFromNetwork;
+  // Set via nsHtml5TreeOperation::TryAppendAfterCreate() when the append of
+  // the created node to mIntendedParent has been fused into this op.
+  bool mAppendToIntendedParent;
 
   explicit opCreateHTMLElement(
       nsIContentHandle* aContent, nsAtom* aName,
@@ -106,7 +109,8 @@ struct opCreateHTMLElement {
       : mName(aName),
         mAttributes(aAttributes),
         mCreator(aCreator),
-        mFromNetwork(mFromNetwork) {
+        mFromNetwork(mFromNetwork),
+        mAppendToIntendedParent(false) {
     mContent = static_cast<nsIContent**>(aContent);
     mIntendedParent = static_cast<nsIContent**>(aIntendedParent);
     aName->AddRef();
@@ -123,6 +127,9 @@ struct opCreateSVGElement {
   mozilla::dom::SVGContentCreatorFunction mCreator;
   nsIContent** mIntendedParent;
   mozilla::dom::FromParser mFromNetwork;
+  // Set via nsHtml5TreeOperation::TryAppendAfterCreate() when the append of
+  // the created node to mIntendedParent has been fused into this op.
+  bool mAppendToIntendedParent;
 
   explicit opCreateSVGElement(nsIContentHandle* aContent, nsAtom* aName,
                               nsHtml5HtmlAttributes* aAttributes,
@@ -132,7 +139,8 @@ struct opCreateSVGElement {
       : mName(aName),
         mAttributes(aAttributes),
         mCreator(aCreator),
-        mFromNetwork(mFromNetwork) {
+        mFromNetwork(mFromNetwork),
+        mAppendToIntendedParent(false) {
     mContent = static_cast<nsIContent**>(aContent);
     mIntendedParent = static_cast<nsIContent**>(aIntendedParent);
     aName->AddRef();
@@ -610,6 +618,15 @@ class nsHtml5TreeOperation final {
 
   inline bool IsRunScript() { return mOperation.is<opRunScript>(); }
 
+  /**
+   * If this operation creates aChild with aParent as the intended parent,
+   * fuses the subsequent append of aChild to aParent into this operation and
+   * returns true. Used by the tree builder to avoid queuing a separate append
+   * op for the common create-then-append op sequence.
+   */
+  bool TryAppendAfterCreate(nsIContentHandle* aChild,
+                            nsIContentHandle* aParent);
+
   inline bool IsMarkAsBroken() { return mOperation.is<opMarkAsBroken>(); }
 
   inline void SetSnapshot(nsAHtml5TreeBuilderState* aSnapshot, int32_t aLine) {
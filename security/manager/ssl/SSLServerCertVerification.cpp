@@ -110,7 +110,10 @@
 #include "cert.h"
 #include "mozilla/Assertions.h"
 #include "mozilla/Casting.h"
+#include "mozilla/MruCache.h"
 #include "mozilla/RefPtr.h"
+#include "mozilla/StaticMutex.h"
+#include "mozilla/StaticPrefs_security.h"
 #include "mozilla/Telemetry.h"
 #include "mozilla/UniquePtr.h"
 #include "mozilla/Unused.h"
@@ -149,6 +152,114 @@ namespace {
 // do not use a nsCOMPtr to avoid static initializer/destructor
 nsIThreadPool* gCertVerificationThreadPool = nullptr;
 
+// Memoizes recent successful server certificate verifications so that a burst
+// of connections presenting the same chain doesn't run a full mozilla::pkix
+// chain build each time. Entries are keyed by a SHA-256 digest over every
+// input that can affect the verification result and expire after a few
+// minutes, so time-based checks and newly-arrived revocation information
+// can't be bypassed for longer than that window. Only successes are cached:
+// failures go through per-host override processing and must not be shared.
+const uint32_t kVerifiedChainCacheLifetimeSeconds = 300;
+
+struct VerifiedChainEntry {
+  nsTArray<uint8_t> mKey;
+  nsTArray<nsTArray<uint8_t>> mBuiltChainBytes;
+  uint16_t mCertificateTransparencyStatus =
+      nsITransportSecurityInfo::CERTIFICATE_TRANSPARENCY_NOT_APPLICABLE;
+  EVStatus mEVStatus = EVStatus::NotEV;
+  bool mIsBuiltChainRootBuiltInRoot = false;
+  TimeStamp mExpiration;
+};
+
+class VerifiedChainCache : public MruCache<nsTArray<uint8_t>,
+                                           VerifiedChainEntry,
+                                           VerifiedChainCache> {
+ public:
+  static HashNumber Hash(const KeyType& aKey) {
+    return HashBytes(aKey.Elements(), aKey.Length());
+  }
+  static bool Match(const KeyType& aKey, const VerifiedChainEntry& aEntry) {
+    return aEntry.mKey == aKey;
+  }
+};
+
+// Created and destroyed alongside gCertVerificationThreadPool. The mutex is
+// needed because verification jobs run on a pool of threads.
+StaticMutex gVerifiedChainCacheMutex;
+VerifiedChainCache* gVerifiedChainCache = nullptr;
+
+// Computes the cache key for one verification: a digest over the peer chain
+// and everything else VerifySSLServerCert consults besides the current time.
+// Each variable-length component is preceded by its length so that
+// concatenations of adjacent components can't collide.
+nsresult ComputeVerifiedChainCacheKey(
+    const nsTArray<nsTArray<uint8_t>>& aPeerCertChain,
+    const nsACString& aHostName, const OriginAttributes& aOriginAttributes,
+    const Maybe<nsTArray<uint8_t>>& aStapledOCSPResponse,
+    const Maybe<nsTArray<uint8_t>>& aSCTsFromTLSExtension,
+    uint32_t aCertVerifierFlags, /*out*/ nsTArray<uint8_t>& aKey) {
+  Digest digest;
+  nsresult rv = digest.Begin(SEC_OID_SHA256);
+  if (NS_FAILED(rv)) {
+    return rv;
+  }
+  auto updateLength = [&digest](uint32_t aLength) {
+    return digest.Update(reinterpret_cast<const uint8_t*>(&aLength),
+                         sizeof(aLength));
+  };
+  auto updateBytes = [&](const nsTArray<uint8_t>& aBytes) {
+    nsresult rv = updateLength(aBytes.Length());
+    if (NS_FAILED(rv)) {
+      return rv;
+    }
+    return digest.Update(aBytes.Elements(), aBytes.Length());
+  };
+  rv = updateLength(aPeerCertChain.Length());
+  if (NS_FAILED(rv)) {
+    return rv;
+  }
+  for (const auto& certBytes : aPeerCertChain) {
+    rv = updateBytes(certBytes);
+    if (NS_FAILED(rv)) {
+      return rv;
+    }
+  }
+  auto updateString = [&](const nsACString& aString) {
+    nsresult rv = updateLength(aString.Length());
+    if (NS_FAILED(rv)) {
+      return rv;
+    }
+    return digest.Update(
+        reinterpret_cast<const uint8_t*>(aString.BeginReading()),
+        aString.Length());
+  };
+  rv = updateString(aHostName);
+  if (NS_FAILED(rv)) {
+    return rv;
+  }
+  nsAutoCString suffix;
+  aOriginAttributes.CreateSuffix(suffix);
+  rv = updateString(suffix);
+  if (NS_FAILED(rv)) {
+    return rv;
+  }
+  rv = updateBytes(aStapledOCSPResponse.isSome() ? *aStapledOCSPResponse
+                                                 : nsTArray<uint8_t>());
+  if (NS_FAILED(rv)) {
+    return rv;
+  }
+  rv = updateBytes(aSCTsFromTLSExtension.isSome() ? *aSCTsFromTLSExtension
+                                                  : nsTArray<uint8_t>());
+  if (NS_FAILED(rv)) {
+    return rv;
+  }
+  rv = updateLength(aCertVerifierFlags);
+  if (NS_FAILED(rv)) {
+    return rv;
+  }
+  return digest.End(aKey);
+}
+
 }  // unnamed namespace
 
 // Called when the socket transport thread starts, to initialize the SSL cert
@@ -170,6 +281,9 @@ void InitializeSSLServerCertVerificationThreads() {
   (void)gCertVerificationThreadPool->SetIdleThreadTimeout(30 * 1000);
   (void)gCertVerificationThreadPool->SetThreadLimit(5);
   (void)gCertVerificationThreadPool->SetName("SSL Cert"_ns);
+
+  StaticMutexAutoLock lock(gVerifiedChainCacheMutex);
+  gVerifiedChainCache = new VerifiedChainCache();
 }
 
 // Called when the socket transport thread finishes, to destroy the thread
@@ -187,6 +301,11 @@ void StopSSLServerCertVerificationThreads() {
     gCertVerificationThreadPool->Shutdown();
     NS_RELEASE(gCertVerificationThreadPool);
   }
+
+  // The pool's threads have been joined, so nothing can be using the cache.
+  StaticMutexAutoLock lock(gVerifiedChainCacheMutex);
+  delete gVerifiedChainCache;
+  gVerifiedChainCache = nullptr;
 }
 
 namespace {
@@ -1052,6 +1171,58 @@ SSLServerCertVerificationJob::Run() {
     return NS_OK;
   }
 
+  // Before doing a full chain build, see whether a verification with
+  // identical inputs succeeded recently. Delegated credentials are rare
+  // enough that they just skip the cache.
+  nsTArray<uint8_t> cacheKey;
+  bool cacheUsable =
+      StaticPrefs::security_ssl_server_cert_verification_cache_enabled() &&
+      mDCInfo.isNothing() &&
+      NS_SUCCEEDED(ComputeVerifiedChainCacheKey(
+          mPeerCertChain, mHostName, mOriginAttributes, mStapledOCSPResponse,
+          mSCTsFromTLSExtension, mCertVerifierFlags, cacheKey));
+  if (cacheUsable) {
+    Maybe<VerifiedChainEntry> cached;
+    {
+      StaticMutexAutoLock lock(gVerifiedChainCacheMutex);
+      if (gVerifiedChainCache) {
+        auto entry = gVerifiedChainCache->Lookup(cacheKey);
+        if (entry) {
+          if (entry.Data().mExpiration > TimeStamp::Now()) {
+            cached.emplace();
+            cached->mBuiltChainBytes.SetCapacity(
+                entry.Data().mBuiltChainBytes.Length());
+            for (const auto& certBytes : entry.Data().mBuiltChainBytes) {
+              cached->mBuiltChainBytes.AppendElement(certBytes.Clone());
+            }
+            cached->mCertificateTransparencyStatus =
+                entry.Data().mCertificateTransparencyStatus;
+            cached->mEVStatus = entry.Data().mEVStatus;
+            cached->mIsBuiltChainRootBuiltInRoot =
+                entry.Data().mIsBuiltChainRootBuiltInRoot;
+          } else {
+            entry.Remove();
+          }
+        }
+      }
+    }
+    if (cached) {
+      MOZ_LOG(gPIPNSSLog, LogLevel::Debug,
+              ("[%" PRIx64
+               "] SSLServerCertVerificationJob::Run - reusing recent "
+               "verification\n",
+               mAddrForLogging));
+      RefPtr<nsNSSCertificate> cachedCert =
+          nsNSSCertificate::Create(mCert.get());
+      mResultTask->Dispatch(
+          cachedCert, std::move(cached->mBuiltChainBytes),
+          std::move(mPeerCertChain), cached->mCertificateTransparencyStatus,
+          cached->mEVStatus, true, 0, 0, cached->mIsBuiltChainRootBuiltInRoot,
+          mProviderFlags);
+      return NS_OK;
+    }
+  }
+
   TimeStamp jobStartTime = TimeStamp::Now();
   UniqueCERTCertList builtCertChain;
   EVStatus evStatus;
@@ -1073,11 +1244,31 @@ SSLServerCertVerificationJob::Run() {
 
     certBytesArray =
         TransportSecurityInfo::CreateCertBytesArray(builtCertChain);
-    mResultTask->Dispatch(
-        nsc, std::move(certBytesArray), std::move(mPeerCertChain),
+    uint16_t certificateTransparencyStatus =
         TransportSecurityInfo::ConvertCertificateTransparencyInfoToStatus(
-            certificateTransparencyInfo),
-        evStatus, true, 0, 0, isCertChainRootBuiltInRoot, mProviderFlags);
+            certificateTransparencyInfo);
+    if (cacheUsable) {
+      StaticMutexAutoLock lock(gVerifiedChainCacheMutex);
+      if (gVerifiedChainCache) {
+        VerifiedChainEntry entry;
+        entry.mKey = cacheKey.Clone();
+        entry.mBuiltChainBytes.SetCapacity(certBytesArray.Length());
+        for (const auto& certBytes : certBytesArray) {
+          entry.mBuiltChainBytes.AppendElement(certBytes.Clone());
+        }
+        entry.mCertificateTransparencyStatus = certificateTransparencyStatus;
+        entry.mEVStatus = evStatus;
+        entry.mIsBuiltChainRootBuiltInRoot = isCertChainRootBuiltInRoot;
+        entry.mExpiration =
+            TimeStamp::Now() +
+            TimeDuration::FromSeconds(kVerifiedChainCacheLifetimeSeconds);
+        gVerifiedChainCache->Put(cacheKey, std::move(entry));
+      }
+    }
+    mResultTask->Dispatch(nsc, std::move(certBytesArray),
+                          std::move(mPeerCertChain),
+                          certificateTransparencyStatus, evStatus, true, 0, 0,
+                          isCertChainRootBuiltInRoot, mProviderFlags);
     return NS_OK;
   }
 
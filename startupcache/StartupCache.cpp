@@ -262,9 +262,6 @@ Result<Ok, nsresult> StartupCache::LoadArchive() {
 
   MOZ_TRY(mCacheData.init(mFile));
   auto size = mCacheData.size();
-  if (CanPrefetchMemory()) {
-    StartPrefetchMemoryThread();
-  }
 
   uint32_t headerSize;
   if (size < sizeof(MAGIC) + sizeof(headerSize)) {
@@ -351,6 +348,11 @@ Result<Ok, nsresult> StartupCache::LoadArchive() {
 
   MMAP_FAULT_HANDLER_CATCH(Err(NS_ERROR_UNEXPECTED))
 
+  // Start the prefetch thread now that the entry table is usable from other
+  // threads. Besides touching the pages, it inflates the entries in the
+  // background; see BackgroundDecompress.
+  StartPrefetchMemoryThread();
+
   return Ok();
 }
 
@@ -374,6 +376,13 @@ nsresult StartupCache::GetBuffer(const char* id, const char** outbuf,
   auto telemetry =
       MakeScopeExit([&label] { Telemetry::AccumulateCategorical(label); });
 
+  // The lock protects the entry data against the background decompression
+  // thread, which inflates entries in place; the table itself is only
+  // mutated on the main thread. A write can't be pending while
+  // mCacheData.initialized() below is true, because mCacheData is reset
+  // before writing to the cache.
+  MutexAutoLock lock(mTableLock);
+
   decltype(mTable)::Ptr p = mTable.lookup(nsDependentCString(id));
   if (!p) {
     return NS_ERROR_NOT_AVAILABLE;
@@ -386,49 +395,14 @@ nsresult StartupCache::GetBuffer(const char* id, const char** outbuf,
     if (!mCacheData.initialized()) {
       return NS_ERROR_NOT_AVAILABLE;
     }
-#ifdef DEBUG
-    // It should be impossible for a write to be pending here. This is because
-    // we just checked mCacheData.initialized(), and this is reset before
-    // writing to the cache. It's not re-initialized unless we call
-    // LoadArchive(), either from Init() (which must have already happened) or
-    // InvalidateCache(). InvalidateCache() locks the mutex, so a write can't be
-    // happening. Really, we want to MOZ_ASSERT(!mTableLock.IsLocked()) here,
-    // but there is no such method. So we hack around by attempting to gain the
-    // lock. This should always succeed; if it fails, someone's broken the
-    // assumptions.
-    if (!mTableLock.TryLock()) {
-      MOZ_ASSERT(false, "Could not gain mTableLock - should never happen!");
-      return NS_ERROR_NOT_AVAILABLE;
-    }
-    mTableLock.Unlock();
-#endif
 
-    size_t totalRead = 0;
-    size_t totalWritten = 0;
-    Span<const char> compressed = Span(
-        mCacheData.get<char>().get() + mCacheEntriesBaseOffset + value.mOffset,
-        value.mCompressedSize);
-    value.mData = MakeUnique<char[]>(value.mUncompressedSize);
-    Span<char> uncompressed = Span(value.mData.get(), value.mUncompressedSize);
-    MMAP_FAULT_HANDLER_BEGIN_BUFFER(uncompressed.Elements(),
-                                    uncompressed.Length())
-    bool finished = false;
-    while (!finished) {
-      auto result = mDecompressionContext->Decompress(
-          uncompressed.From(totalWritten), compressed.From(totalRead));
-      if (NS_WARN_IF(result.isErr())) {
-        value.mData = nullptr;
-        InvalidateCache();
-        return NS_ERROR_FAILURE;
-      }
-      auto decompressionResult = result.unwrap();
-      totalRead += decompressionResult.mSizeRead;
-      totalWritten += decompressionResult.mSizeWritten;
-      finished = decompressionResult.mFinished;
+    if (!DecompressEntry(value, *mDecompressionContext)) {
+      // InvalidateCache() takes mTableLock itself.
+      MutexAutoUnlock unlock(mTableLock);
+      InvalidateCache();
+      return NS_ERROR_FAILURE;
     }
 
-    MMAP_FAULT_HANDLER_CATCH(NS_ERROR_FAILURE)
-
     label = Telemetry::LABELS_STARTUP_CACHE_REQUESTS::HitDisk;
   }
 
@@ -668,6 +642,11 @@ void StartupCache::EnsureShutdownWriteComplete() {
   }
   // Otherwise, ensure the write happens. The timer should have been cancelled
   // already in MaybeInitShutdownWrite.
+
+  // Join the prefetch thread before acquiring the lock: it takes mTableLock
+  // itself while decompressing entries, so joining it with the lock held
+  // would deadlock.
+  WaitOnPrefetchThread();
   if (!mTableLock.TryLock()) {
     // Uh oh, we're writing away from the main thread. Wait to gain the lock,
     // to ensure the write completes.
@@ -675,7 +654,6 @@ void StartupCache::EnsureShutdownWriteComplete() {
   } else {
     // We got the lock. Keep the following in sync with
     // MaybeWriteOffMainThread:
-    WaitOnPrefetchThread();
     mDirty = true;
     mCacheData.reset();
     // Most of this should be redundant given MaybeWriteOffMainThread should
@@ -707,14 +685,101 @@ void StartupCache::ThreadedPrefetch(void* aClosure) {
   NS_SetCurrentThreadName("StartupCache");
   mozilla::IOInterposer::RegisterCurrentThread();
   StartupCache* startupCacheObj = static_cast<StartupCache*>(aClosure);
-  uint8_t* buf = startupCacheObj->mCacheData.get<uint8_t>().get();
-  size_t size = startupCacheObj->mCacheData.size();
-  MMAP_FAULT_HANDLER_BEGIN_BUFFER(buf, size)
-  PrefetchMemory(buf, size);
-  MMAP_FAULT_HANDLER_CATCH()
+  if (CanPrefetchMemory()) {
+    uint8_t* buf = startupCacheObj->mCacheData.get<uint8_t>().get();
+    size_t size = startupCacheObj->mCacheData.size();
+    MMAP_FAULT_HANDLER_BEGIN_BUFFER(buf, size)
+    PrefetchMemory(buf, size);
+    MMAP_FAULT_HANDLER_CATCH()
+  }
+  startupCacheObj->BackgroundDecompress();
   mozilla::IOInterposer::UnregisterCurrentThread();
 }
 
+bool StartupCache::DecompressEntry(
+    StartupCacheEntry& aEntry, LZ4FrameDecompressionContext& aContext) {
+  mTableLock.AssertCurrentThreadOwns();
+  MOZ_ASSERT(mCacheData.initialized());
+  MOZ_ASSERT(!aEntry.mData);
+
+  size_t totalRead = 0;
+  size_t totalWritten = 0;
+  Span<const char> compressed =
+      Span(mCacheData.get<char>().get() + mCacheEntriesBaseOffset +
+               aEntry.mOffset,
+           aEntry.mCompressedSize);
+  aEntry.mData = MakeUnique<char[]>(aEntry.mUncompressedSize);
+  Span<char> uncompressed = Span(aEntry.mData.get(), aEntry.mUncompressedSize);
+  MMAP_FAULT_HANDLER_BEGIN_BUFFER(uncompressed.Elements(),
+                                  uncompressed.Length())
+  bool finished = false;
+  while (!finished) {
+    auto result = aContext.Decompress(uncompressed.From(totalWritten),
+                                      compressed.From(totalRead));
+    if (NS_WARN_IF(result.isErr())) {
+      aEntry.mData = nullptr;
+      return false;
+    }
+    auto decompressionResult = result.unwrap();
+    totalRead += decompressionResult.mSizeRead;
+    totalWritten += decompressionResult.mSizeWritten;
+    finished = decompressionResult.mFinished;
+  }
+  MMAP_FAULT_HANDLER_CATCH(false)
+
+  return true;
+}
+
+void StartupCache::BackgroundDecompress() {
+  // Take a snapshot of the entries which still need inflating and sort it
+  // by file offset, which is the order the entries were requested in during
+  // the previous run, so the data needed earliest is ready first. The main
+  // thread only mutates the table structure, never from another thread, so
+  // looking entries up again per iteration below stays valid while the lock
+  // is dropped in between.
+  nsTArray<std::pair<nsCString, uint32_t>> entries;
+  {
+    MutexAutoLock lock(mTableLock);
+    for (auto iter = mTable.iter(); !iter.done(); iter.next()) {
+      auto& value = iter.get().value();
+      if (!value.mData) {
+        entries.AppendElement(
+            std::make_pair(nsCString(iter.get().key()), value.mOffset));
+      }
+    }
+  }
+
+  struct OffsetComparator {
+    using Value = std::pair<nsCString, uint32_t>;
+
+    bool Equals(const Value& a, const Value& b) const {
+      return a.second == b.second;
+    }
+
+    bool LessThan(const Value& a, const Value& b) const {
+      return a.second < b.second;
+    }
+  };
+  entries.Sort(OffsetComparator());
+
+  // The lock is taken per entry so that a main-thread GetBuffer only ever
+  // waits for at most one entry to be inflated. Corrupt entries are left
+  // alone here; the main thread invalidates the cache when it hits one.
+  LZ4FrameDecompressionContext context(true);
+  for (auto& entry : entries) {
+    MutexAutoLock lock(mTableLock);
+    if (!mCacheData.initialized()) {
+      // The cache was invalidated or is being written out; stop.
+      break;
+    }
+    decltype(mTable)::Ptr p = mTable.lookup(entry.first);
+    if (!p || p->value().mData) {
+      continue;
+    }
+    Unused << NS_WARN_IF(!DecompressEntry(p->value(), context));
+  }
+}
+
 bool StartupCache::ShouldCompactCache() {
   // If we've requested less than 4/5 of the startup cache, then we should
   // probably compact it down. This can happen quite easily after the first run,
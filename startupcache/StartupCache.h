@@ -205,6 +205,18 @@ class StartupCache : public nsIMemoryReporter {
   void WaitOnPrefetchThread();
   void StartPrefetchMemoryThread();
 
+  // Decompresses the given entry's data in place. Returns false and drops
+  // the partially written data if the compressed data is corrupt.
+  // mTableLock must be held.
+  bool DecompressEntry(StartupCacheEntry& aEntry,
+                       Compression::LZ4FrameDecompressionContext& aContext);
+
+  // Runs on the prefetch thread once the pages have been prefetched;
+  // inflates all entries in file order (the order they were requested in
+  // during the previous run), so that by the time consumers ask for them
+  // most GetBuffer calls are memory hits.
+  void BackgroundDecompress();
+
   static nsresult InitSingleton();
   static void WriteTimeout(nsITimer* aTimer, void* aClosure);
   void MaybeWriteOffMainThread();
@@ -13,6 +13,7 @@
 
 #include "nsHashKeys.h"
 #include "nsInterfaceHashtable.h"
+#include "nsTArray.h"
 
 namespace mozilla {
 namespace storage {
@@ -33,9 +34,17 @@ class StatementCache {
    *        A reference to the nsCOMPtr for the connection this cache is to be
    *        used for.  This nsCOMPtr must at least live as long as this class,
    *        otherwise crashes will happen.
+   * @param aMaxStatements
+   *        The maximum number of statements to keep compiled, or zero for no
+   *        limit.  When the limit would be exceeded, the least recently used
+   *        statement is finalized and evicted.  Consumers whose set of queries
+   *        is not small and fixed (for example queries assembled from varying
+   *        parameters) should pass a limit to keep the sqlite3_stmt memory
+   *        bounded.
    */
-  explicit StatementCache(nsCOMPtr<mozIStorageConnection>& aConnection)
-      : mConnection(aConnection) {}
+  explicit StatementCache(nsCOMPtr<mozIStorageConnection>& aConnection,
+                          uint32_t aMaxStatements = 0)
+      : mConnection(aConnection), mMaxStatements(aMaxStatements) {}
 
   /**
    * Obtains a cached statement.  If this statement is not yet created, it will
@@ -53,8 +62,17 @@ class StatementCache {
       stmt = CreateStatement(aQuery);
       NS_ENSURE_TRUE(stmt, nullptr);
 
+      if (mMaxStatements && mCachedStatements.Count() == mMaxStatements) {
+        EvictLeastRecentlyUsed();
+      }
+
       mCachedStatements.InsertOrUpdate(aQuery, stmt);
     }
+    if (mMaxStatements) {
+      // Keep mStatementOrder sorted from least to most recently used.
+      mStatementOrder.RemoveElement(aQuery);
+      mStatementOrder.AppendElement(aQuery);
+    }
     return stmt.forget();
   }
 
@@ -76,14 +94,39 @@ class StatementCache {
 
     // Clear the cache at this time too!
     (void)mCachedStatements.Clear();
+    mStatementOrder.Clear();
   }
 
  private:
   inline already_AddRefed<StatementType> CreateStatement(
       const nsACString& aQuery);
 
+  /**
+   * Finalizes and removes the least recently used cached statement to make
+   * room for a new one.
+   */
+  inline void EvictLeastRecentlyUsed() {
+    MOZ_ASSERT(mMaxStatements);
+    MOZ_ASSERT(mStatementOrder.Length() == mCachedStatements.Count());
+
+    const nsCString query = mStatementOrder[0];
+    mStatementOrder.RemoveElementAt(0);
+
+    nsCOMPtr<StatementType> stmt;
+    if (mCachedStatements.Get(query, getter_AddRefs(stmt))) {
+      (void)stmt->Finalize();
+      mCachedStatements.Remove(query);
+    }
+  }
+
   nsInterfaceHashtable<nsCStringHashKey, StatementType> mCachedStatements;
+  /**
+   * The cached SQL strings ordered from least to most recently used.  Only
+   * maintained when mMaxStatements is non-zero.
+   */
+  nsTArray<nsCString> mStatementOrder;
   nsCOMPtr<mozIStorageConnection>& mConnection;
+  const uint32_t mMaxStatements;
 };
 
 template <>
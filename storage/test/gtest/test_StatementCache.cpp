@@ -130,3 +130,45 @@ TYPED_TEST(storage_StatementCache, FinalizeAsyncStatements) {
   // Should be able to close the database now too.
   do_check_success(db->AsyncClose(nullptr));
 }
+
+TYPED_TEST_CASE(storage_StatementCache, TwoStringTypes);
+TYPED_TEST(storage_StatementCache, EvictLeastRecentlyUsed) {
+  nsCOMPtr<mozIStorageConnection> db(getMemoryDatabase());
+  StatementCache<mozIStorageStatement> cache(db, /* aMaxStatements */ 2);
+
+  TypeParam sql1 = "SELECT 1";
+  TypeParam sql2 = "SELECT 2";
+  TypeParam sql3 = "SELECT 3";
+
+  nsCOMPtr<mozIStorageStatement> stmt1 = cache.GetCachedStatement(sql1);
+  do_check_true(stmt1);
+  nsCOMPtr<mozIStorageStatement> stmt2 = cache.GetCachedStatement(sql2);
+  do_check_true(stmt2);
+
+  // Touch the first statement so that the second one is the least recently
+  // used.
+  nsCOMPtr<mozIStorageStatement> stmt = cache.GetCachedStatement(sql1);
+  do_check_eq(stmt1.get(), stmt.get());
+
+  // Requesting a third statement should finalize and evict the second one.
+  nsCOMPtr<mozIStorageStatement> stmt3 = cache.GetCachedStatement(sql3);
+  do_check_true(stmt3);
+
+  int32_t state;
+  do_check_success(stmt2->GetState(&state));
+  do_check_eq(mozIStorageBaseStatement::MOZ_STORAGE_STATEMENT_INVALID, state);
+
+  // The first statement must still be cached and usable.
+  stmt = cache.GetCachedStatement(sql1);
+  do_check_eq(stmt1.get(), stmt.get());
+  do_check_success(stmt1->GetState(&state));
+  do_check_eq(mozIStorageBaseStatement::MOZ_STORAGE_STATEMENT_READY, state);
+
+  // Requesting the evicted statement again should compile a fresh one.
+  stmt = cache.GetCachedStatement(sql2);
+  do_check_true(stmt);
+  do_check_true(stmt.get() != stmt2.get());
+
+  cache.FinalizeStatements();
+  do_check_success(db->Close());
+}
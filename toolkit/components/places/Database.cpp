@@ -57,6 +57,12 @@
 // Set to specify the size of the places database growth increments in kibibytes
 #define PREF_GROWTH_INCREMENT_KIB "places.database.growthIncrementKiB"
 
+// The percentage of the physical memory to use for the connection's page
+// cache. The value is clamped between 0 and 50.
+#define PREF_CACHE_TO_MEMORY_PERCENTAGE \
+  "places.database.cache_to_memory_percentage"
+#define DATABASE_DEFAULT_CACHE_TO_MEMORY_PERCENTAGE 2
+
 // Set to disable the default robust storage and use volatile, in-memory
 // storage without robust transaction flushing guarantees. This makes
 // SQLite use much less I/O at the cost of losing data when things crash.
@@ -1009,6 +1015,36 @@ nsresult Database::SetupDatabaseConnection(
   rv = SetupDurability(mMainConn, mDBPageSize);
   NS_ENSURE_SUCCESS(rv, rv);
 
+  // Size the page cache relative to the physical memory instead of using
+  // SQLite's fixed default, so that profiles whose places.sqlite has grown to
+  // hundreds of megabytes don't continuously evict hot pages during history
+  // and autocomplete queries. SQLite only allocates the cache as pages are
+  // actually read, so small databases don't pay for the larger limit.
+  {
+    int32_t cachePercentage =
+        Preferences::GetInt(PREF_CACHE_TO_MEMORY_PERCENTAGE,
+                            DATABASE_DEFAULT_CACHE_TO_MEMORY_PERCENTAGE);
+    // Sanitize the percentage to be sure an erroneous pref value can't eat up
+    // all of the memory.
+    if (cachePercentage > 50) {
+      cachePercentage = 50;
+    }
+    if (cachePercentage < 0) {
+      cachePercentage = 0;
+    }
+
+    int64_t cacheSize = PR_GetPhysicalMemorySize() * cachePercentage / 100;
+
+    // Compute the number of cached pages, this value is negative to indicate
+    // the amount of memory in KiB the cache can use, rather than a number of
+    // pages.
+    nsAutoCString cacheSizePragma(MOZ_STORAGE_UNIQUIFY_QUERY_STR
+                                  "PRAGMA cache_size = ");
+    cacheSizePragma.AppendInt(-(cacheSize / BYTES_PER_KIBIBYTE));
+    rv = mMainConn->ExecuteSimpleSQL(cacheSizePragma);
+    NS_ENSURE_SUCCESS(rv, rv);
+  }
+
   nsAutoCString busyTimeoutPragma("PRAGMA busy_timeout = ");
   busyTimeoutPragma.AppendInt(DATABASE_BUSY_TIMEOUT_MS);
   (void)mMainConn->ExecuteSimpleSQL(busyTimeoutPragma);
@@ -481,18 +481,33 @@ MatchAutoCompleteFunction::OnFunctionCall(mozIStorageValueArray* aArguments,
   // Obtain our search function.
   searchFunctionPtr searchFunction = getSearchFunction(matchBehavior);
 
-  // Clean up our URI spec and prepare it for searching.
+  const bool matchTitle = HAS_BEHAVIOR(TITLE);
+  const bool matchUrl = HAS_BEHAVIOR(URL);
+  const bool matchAny = !matchTitle && !matchUrl;
+
+  // Clean up our URI spec and prepare it for searching. This unescapes and
+  // re-validates the spec, which is the most expensive per-row work we do, so
+  // skip it for title-restricted searches that never look at the URL.
   nsCString fixedUrlBuf;
-  nsDependentCSubstring fixedUrl =
-      fixupURISpec(url, matchBehavior, fixedUrlBuf);
-  // Limit the number of chars we search through.
-  const nsDependentCSubstring& trimmedUrl =
-      Substring(fixedUrl, 0, MAX_CHARS_TO_SEARCH_THROUGH);
+  nsDependentCSubstring trimmedUrl;
+  if (matchUrl || matchAny) {
+    const nsDependentCSubstring& fixedUrl =
+        fixupURISpec(url, matchBehavior, fixedUrlBuf);
+    // Limit the number of chars we search through.
+    trimmedUrl.Rebind(
+        fixedUrl.BeginReading(),
+        XPCOM_MIN(fixedUrl.Length(), size_type(MAX_CHARS_TO_SEARCH_THROUGH)));
+  }
 
-  nsDependentCString title = getSharedUTF8String(aArguments, kArgIndexTitle);
-  // Limit the number of chars we search through.
-  const nsDependentCSubstring& trimmedTitle =
-      Substring(title, 0, MAX_CHARS_TO_SEARCH_THROUGH);
+  // Likewise, don't fetch the title for URL-restricted searches.
+  nsDependentCSubstring trimmedTitle;
+  if (matchTitle || matchAny) {
+    nsDependentCString title = getSharedUTF8String(aArguments, kArgIndexTitle);
+    // Limit the number of chars we search through.
+    trimmedTitle.Rebind(
+        title.BeginReading(),
+        XPCOM_MIN(title.Length(), size_type(MAX_CHARS_TO_SEARCH_THROUGH)));
+  }
 
   // Determine if every token matches either the bookmark title, tags, page
   // title, or page URL.
@@ -500,14 +515,14 @@ MatchAutoCompleteFunction::OnFunctionCall(mozIStorageValueArray* aArguments,
   while (matches && tokenizer.hasMoreTokens()) {
     const nsDependentCSubstring& token = tokenizer.nextToken();
 
-    if (HAS_BEHAVIOR(TITLE) && HAS_BEHAVIOR(URL)) {
+    if (matchTitle && matchUrl) {
       matches = (searchFunction(token, trimmedTitle) ||
                  searchFunction(token, tags)) &&
                 searchFunction(token, trimmedUrl);
-    } else if (HAS_BEHAVIOR(TITLE)) {
+    } else if (matchTitle) {
       matches =
           searchFunction(token, trimmedTitle) || searchFunction(token, tags);
-    } else if (HAS_BEHAVIOR(URL)) {
+    } else if (matchUrl) {
       matches = searchFunction(token, trimmedUrl);
     } else {
       matches = searchFunction(token, trimmedTitle) ||
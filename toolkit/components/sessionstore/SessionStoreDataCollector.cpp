@@ -115,13 +115,16 @@ void SessionStoreDataCollector::Collect() {
   if (mInputChanged) {
     maybeFormData.emplace();
     auto& formData = maybeFormData.ref();
-    SessionStoreUtils::CollectFormData(document, formData);
+    uint64_t size = SessionStoreUtils::CollectFormData(document, formData);
 
     Element* body = document->GetBody();
     if (document->HasFlag(NODE_IS_EDITABLE) && body) {
       IgnoredErrorResult result;
-      body->GetInnerHTML(formData.innerHTML(), result);
-      if (!result.Failed()) {
+      nsAutoString innerHTML;
+      body->GetInnerHTML(innerHTML, result);
+      if (!result.Failed() &&
+          SessionStoreUtils::CanCollectValue(innerHTML, size)) {
+        formData.innerHTML() = std::move(innerHTML);
         formData.hasData() = true;
       }
     }
@@ -8,6 +8,7 @@
 #include "js/JSON.h"
 #include "jsapi.h"
 #include "mozilla/PresShell.h"
+#include "mozilla/StaticPrefs_browser.h"
 #include "mozilla/dom/AutocompleteInfoBinding.h"
 #include "mozilla/dom/CanonicalBrowsingContext.h"
 #include "mozilla/dom/Document.h"
@@ -496,7 +497,8 @@ static void AppendEntry(nsINode* aNode, const nsString& aId,
 }
 
 static void CollectTextAreaElement(Document* aDocument,
-                                   sessionstore::FormData& aFormData) {
+                                   sessionstore::FormData& aFormData,
+                                   uint64_t& aCollectedSize) {
   RefPtr<nsContentList> textlist =
       NS_GetContentList(aDocument, kNameSpaceID_XHTML, u"textarea"_ns);
   uint32_t length = textlist->Length();
@@ -526,13 +528,17 @@ static void CollectTextAreaElement(Document* aDocument,
                               eCaseMatters)) {
       continue;
     }
+    if (!SessionStoreUtils::CanCollectValue(value, aCollectedSize)) {
+      continue;
+    }
 
     AppendEntry(textArea, id, TextField{value}, aFormData);
   }
 }
 
 static void CollectInputElement(Document* aDocument,
-                                sessionstore::FormData& aFormData) {
+                                sessionstore::FormData& aFormData,
+                                uint64_t& aCollectedSize) {
   RefPtr<nsContentList> inputlist =
       NS_GetContentList(aDocument, kNameSpaceID_XHTML, u"input"_ns);
   uint32_t length = inputlist->Length();
@@ -596,6 +602,9 @@ static void CollectInputElement(Document* aDocument,
                              eCaseMatters)) {
         continue;
       }
+      if (!SessionStoreUtils::CanCollectValue(value, aCollectedSize)) {
+        continue;
+      }
       AppendEntry(input, id, field, aFormData);
     }
   }
@@ -682,21 +691,42 @@ static void CollectSelectElement(Document* aDocument,
 }
 
 /* static */
-void SessionStoreUtils::CollectFormData(Document* aDocument,
-                                        sessionstore::FormData& aFormData) {
+uint64_t SessionStoreUtils::CollectFormData(Document* aDocument,
+                                            sessionstore::FormData& aFormData) {
   MOZ_DIAGNOSTIC_ASSERT(aDocument);
-  CollectTextAreaElement(aDocument, aFormData);
-  CollectInputElement(aDocument, aFormData);
+  uint64_t collectedSize = 0;
+  CollectTextAreaElement(aDocument, aFormData, collectedSize);
+  CollectInputElement(aDocument, aFormData, collectedSize);
   CollectSelectElement(aDocument, aFormData);
 
   aFormData.hasData() =
       !aFormData.id().IsEmpty() || !aFormData.xpath().IsEmpty();
+
+  return collectedSize;
+}
+
+/* static */
+bool SessionStoreUtils::CanCollectValue(const nsAString& aValue,
+                                        uint64_t& aCollectedSize) {
+  if (aValue.Length() >
+      StaticPrefs::browser_sessionstore_dom_form_field_limit()) {
+    return false;
+  }
+
+  uint64_t newSize = aCollectedSize + aValue.Length();
+  if (newSize > StaticPrefs::browser_sessionstore_dom_form_limit()) {
+    return false;
+  }
+
+  aCollectedSize = newSize;
+  return true;
 }
 
 /* static */
 template <typename... ArgsT>
 void SessionStoreUtils::CollectFromTextAreaElement(Document& aDocument,
                                                    uint16_t& aGeneratedCount,
+                                                   uint64_t& aCollectedSize,
                                                    ArgsT&&... args) {
   RefPtr<nsContentList> textlist =
       NS_GetContentList(&aDocument, kNameSpaceID_XHTML, u"textarea"_ns);
@@ -727,6 +757,9 @@ void SessionStoreUtils::CollectFromTextAreaElement(Document& aDocument,
                               eCaseMatters)) {
       continue;
     }
+    if (!CanCollectValue(value, aCollectedSize)) {
+      continue;
+    }
     AppendValueToCollectedData(textArea, id, value, aGeneratedCount,
                                std::forward<ArgsT>(args)...);
   }
@@ -736,6 +769,7 @@ void SessionStoreUtils::CollectFromTextAreaElement(Document& aDocument,
 template <typename... ArgsT>
 void SessionStoreUtils::CollectFromInputElement(Document& aDocument,
                                                 uint16_t& aGeneratedCount,
+                                                uint64_t& aCollectedSize,
                                                 ArgsT&&... args) {
   RefPtr<nsContentList> inputlist =
       NS_GetContentList(&aDocument, kNameSpaceID_XHTML, u"input"_ns);
@@ -800,6 +834,9 @@ void SessionStoreUtils::CollectFromInputElement(Document& aDocument,
                              eCaseMatters)) {
         continue;
       }
+      if (!CanCollectValue(value, aCollectedSize)) {
+        continue;
+      }
       AppendValueToCollectedData(aDocument, input, id, value, aGeneratedCount,
                                  std::forward<ArgsT>(args)...);
     }
@@ -877,20 +914,24 @@ void SessionStoreUtils::CollectFromSelectElement(Document& aDocument,
 static void CollectCurrentFormData(JSContext* aCx, Document& aDocument,
                                    Nullable<CollectedData>& aRetVal) {
   uint16_t generatedCount = 0;
+  uint64_t collectedSize = 0;
   /* textarea element */
   SessionStoreUtils::CollectFromTextAreaElement(aDocument, generatedCount,
-                                                aRetVal);
+                                                collectedSize, aRetVal);
   /* input element */
-  SessionStoreUtils::CollectFromInputElement(aDocument, generatedCount, aCx,
-                                             aRetVal);
+  SessionStoreUtils::CollectFromInputElement(aDocument, generatedCount,
+                                             collectedSize, aCx, aRetVal);
   /* select element */
   SessionStoreUtils::CollectFromSelectElement(aDocument, generatedCount, aCx,
                                               aRetVal);
 
   Element* bodyElement = aDocument.GetBody();
   if (aDocument.HasFlag(NODE_IS_EDITABLE) && bodyElement) {
-    bodyElement->GetInnerHTML(aRetVal.SetValue().mInnerHTML.Construct(),
-                              IgnoreErrors());
+    nsAutoString innerHTML;
+    bodyElement->GetInnerHTML(innerHTML, IgnoreErrors());
+    if (SessionStoreUtils::CanCollectValue(innerHTML, collectedSize)) {
+      aRetVal.SetValue().mInnerHTML.Construct(std::move(innerHTML));
+    }
   }
 
   if (aRetVal.IsNull()) {
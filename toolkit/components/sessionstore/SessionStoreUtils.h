@@ -74,21 +74,41 @@ class SessionStoreUtils {
   static void RestoreScrollPosition(nsGlobalWindowInner& aWindow,
                                     const nsCString& aScrollPosition);
 
-  static void CollectFormData(Document* aDocument,
-                              sessionstore::FormData& aFormData);
+  /*
+    Returns the total number of characters collected into aFormData, so that
+    callers collecting additional data (e.g. the innerHTML of an editable
+    document) can count it against the same budget via CanCollectValue.
+   */
+  static uint64_t CollectFormData(Document* aDocument,
+                                  sessionstore::FormData& aFormData);
+
+  /*
+    Checks whether a collected text value is within the form data size limits,
+    both on its own (browser.sessionstore.dom_form_field_limit) and counted
+    together with the values collected so far for the same document
+    (browser.sessionstore.dom_form_limit), and counts it against
+    aCollectedSize if it is. A value exceeding a limit is skipped entirely,
+    because restoring a truncated value would be worse than restoring none.
+   */
+  static bool CanCollectValue(const nsAString& aValue,
+                              uint64_t& aCollectedSize);
 
   /*
     @param aDocument: DOMDocument instance to obtain form data for.
     @param aGeneratedCount: the current number of XPath expressions in the
                             returned object.
+    @param aCollectedSize: the number of characters collected so far, see
+                           CanCollectValue.
    */
   template <typename... ArgsT>
   static void CollectFromTextAreaElement(Document& aDocument,
                                          uint16_t& aGeneratedCount,
+                                         uint64_t& aCollectedSize,
                                          ArgsT&&... args);
   template <typename... ArgsT>
   static void CollectFromInputElement(Document& aDocument,
                                       uint16_t& aGeneratedCount,
+                                      uint64_t& aCollectedSize,
                                       ArgsT&&... args);
   template <typename... ArgsT>
   static void CollectFromSelectElement(Document& aDocument,
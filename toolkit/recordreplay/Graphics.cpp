@@ -9,13 +9,19 @@
 
 #include "Graphics.h"
 
+#include "InfallibleVector.h"
 #include "ProcessRecordReplay.h"
+#include "RecordingCompression.h"
 #include "mozilla/Base64.h"
 #include "mozilla/StaticMutex.h"
 #include "imgIEncoder.h"
 #include "nsComponentManagerUtils.h"
 #include "nsPrintfCString.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 using namespace mozilla::layers;
 
 namespace mozilla { extern void RecordReplayTickRefreshDriver(); }
@@ -47,6 +53,10 @@ static LayerTransactionParent* gLayerTransactionParent;
 // Directory to write paints to when recording, for use in debugging.
 static const char* gPaintsDirectory;
 
+// Whether to capture paints as a tile based delta stream instead of one full
+// image per paint, see MaybeRecordPaintDelta().
+static bool gRecordPaintDeltas;
+
 static void EnsureInitialized(LayerTransactionChild* aChild) {
   MOZ_RELEASE_ASSERT(NS_IsMainThread());
 
@@ -72,6 +82,7 @@ static void EnsureInitialized(LayerTransactionChild* aChild) {
                                                        LayersId(), TimeDuration());
 
   gPaintsDirectory = getenv("RECORD_REPLAY_PAINTS_DIRECTORY");
+  gRecordPaintDeltas = gPaintsDirectory && TestEnv("RECORD_REPLAY_PAINT_DELTAS");
 }
 
 static bool ShouldUpdateCompositor(LayerTransactionChild* aChild) {
@@ -332,6 +343,259 @@ static void WriteJPEGFromBase64(const char* aPath, const char* aBuf) {
   fclose(f);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Tile based paint deltas
+///////////////////////////////////////////////////////////////////////////////
+
+// Consecutive paints are usually nearly identical, so instead of capturing a
+// full image per paint we can store only the tiles which changed since the
+// previous snapshot, with periodic keyframes containing every tile. The
+// resulting stream is fed through the background compression pipeline.
+//
+// Diffing and encoding a paint touches every pixel in the buffer, so it runs
+// on a dedicated thread rather than stalling the main thread after each
+// composite. The pipeline is triple buffered: the compositor paints into
+// gDrawTargetBuffer, the encoding thread diffs the buffer most recently
+// handed off, and gPreviousSnapshot holds the pixels of the last encoded
+// paint. Handing off a paint just swaps buffer pointers, so the main thread
+// never copies pixels.
+
+// Pixel dimensions of each tile compared between snapshots.
+static const size_t PaintTileSize = 64;
+
+// Emit a keyframe with every tile after this many delta paints, so that a
+// consumer does not have to walk the entire stream to reconstruct a paint.
+static const size_t PaintKeyframeInterval = 60;
+
+// Pixels of the last encoded paint, empty before the first paint and after
+// the buffer changes dimensions. Only touched on the encoding thread.
+static void* gPreviousSnapshot;
+static size_t gPreviousSnapshotSize;
+
+// Number of delta paints encoded since the last keyframe. Only touched on
+// the encoding thread.
+static size_t gPaintsSinceKeyframe;
+
+// All state below is protected by gDeltaMutex.
+static std::mutex* gDeltaMutex;
+static std::condition_variable* gDeltaCondVar;
+
+// Buffer handed off for encoding, null when none is pending.
+static void* gDeltaBuffer;
+static size_t gDeltaBufferSize;
+static size_t gDeltaWidth, gDeltaHeight;
+
+// Whether the encoding thread is currently working on a buffer.
+static bool gDeltaInFlight;
+
+// Buffer from the last completed encode, recycled as the compositor's next
+// draw target buffer.
+static void* gDeltaSpareBuffer;
+static size_t gDeltaSpareBufferSize;
+
+// Header written before each encoded paint.
+struct PaintDeltaHeader {
+  uint32_t mWidth;
+  uint32_t mHeight;
+  uint32_t mKeyframe;
+  uint32_t mNumTiles;
+};
+
+// Per-tile header, followed by the tile's rows (bottom rows are truncated at
+// the buffer edge).
+struct PaintDeltaTile {
+  uint32_t mTileX;
+  uint32_t mTileY;
+};
+
+// Compare one tile between the current and previous snapshots.
+static bool TileChanged(const uint8_t* aCurrent, const uint8_t* aPrevious,
+                        size_t aStride, size_t aTileX, size_t aTileY,
+                        size_t aTileWidthBytes, size_t aTileHeight) {
+  size_t offset = aTileY * PaintTileSize * aStride +
+                  aTileX * PaintTileSize * 4;
+  for (size_t row = 0; row < aTileHeight; row++) {
+    if (memcmp(aCurrent + offset + row * aStride,
+               aPrevious + offset + row * aStride, aTileWidthBytes)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Append one tile's pixels to the encoded paint.
+static void AppendTile(InfallibleVector<uint8_t>& aEncoded,
+                       const uint8_t* aBuffer, size_t aStride, size_t aTileX,
+                       size_t aTileY, size_t aTileWidthBytes,
+                       size_t aTileHeight) {
+  PaintDeltaTile tile = { (uint32_t)aTileX, (uint32_t)aTileY };
+  aEncoded.append((const uint8_t*)&tile, sizeof(tile));
+
+  size_t offset = aTileY * PaintTileSize * aStride +
+                  aTileX * PaintTileSize * 4;
+  for (size_t row = 0; row < aTileHeight; row++) {
+    aEncoded.append(aBuffer + offset + row * aStride, aTileWidthBytes);
+  }
+}
+
+// Encode a painted buffer as either a keyframe or a delta against the
+// previous snapshot, and hand the result to the compression pipeline.
+// Runs on the encoding thread.
+static void RecordPaintDelta(const uint8_t* aBuffer, size_t aSize,
+                             size_t aWidth, size_t aHeight) {
+  size_t stride = ImageDataSerializer::ComputeRGBStride(SurfaceFormat, aWidth);
+
+  bool keyframe = false;
+  if (!gPreviousSnapshot || gPreviousSnapshotSize != aSize ||
+      gPaintsSinceKeyframe >= PaintKeyframeInterval) {
+    keyframe = true;
+    if (gPreviousSnapshotSize != aSize) {
+      free(gPreviousSnapshot);
+      gPreviousSnapshot = malloc(aSize);
+      gPreviousSnapshotSize = aSize;
+    }
+  }
+
+  size_t numTilesX = (aWidth + PaintTileSize - 1) / PaintTileSize;
+  size_t numTilesY = (aHeight + PaintTileSize - 1) / PaintTileSize;
+
+  InfallibleVector<uint8_t> encoded;
+  PaintDeltaHeader header = { (uint32_t)aWidth, (uint32_t)aHeight,
+                              keyframe, 0 };
+  encoded.append((const uint8_t*)&header, sizeof(header));
+
+  uint32_t numTiles = 0;
+  for (size_t tileY = 0; tileY < numTilesY; tileY++) {
+    size_t tileHeight = std::min(PaintTileSize,
+                                 aHeight - tileY * PaintTileSize);
+    for (size_t tileX = 0; tileX < numTilesX; tileX++) {
+      size_t tileWidthBytes =
+          std::min(PaintTileSize, aWidth - tileX * PaintTileSize) * 4;
+      if (keyframe ||
+          TileChanged(aBuffer, (const uint8_t*)gPreviousSnapshot, stride,
+                      tileX, tileY, tileWidthBytes, tileHeight)) {
+        AppendTile(encoded, aBuffer, stride, tileX, tileY, tileWidthBytes,
+                   tileHeight);
+        numTiles++;
+      }
+    }
+  }
+
+  ((PaintDeltaHeader*)encoded.begin())->mNumTiles = numTiles;
+  EnqueueRecordingData(encoded.begin(), encoded.length());
+
+  memcpy(gPreviousSnapshot, aBuffer, aSize);
+  gPaintsSinceKeyframe = keyframe ? 0 : gPaintsSinceKeyframe + 1;
+}
+
+static void PaintDeltaThreadMain() {
+  // The encoding thread only reads buffers handed off by the main thread and
+  // feeds the compression pipeline. Make sure none of this interacts with
+  // the recording itself.
+  AutoPassThroughThreadEvents pt;
+
+  std::unique_lock<std::mutex> lock(*gDeltaMutex);
+  while (true) {
+    if (!gDeltaBuffer) {
+      gDeltaCondVar->wait(lock);
+      continue;
+    }
+
+    void* buffer = gDeltaBuffer;
+    size_t size = gDeltaBufferSize;
+    size_t width = gDeltaWidth;
+    size_t height = gDeltaHeight;
+    gDeltaBuffer = nullptr;
+    gDeltaInFlight = true;
+
+    lock.unlock();
+    RecordPaintDelta((const uint8_t*)buffer, size, width, height);
+    lock.lock();
+
+    // Recycle the encoded buffer for a later paint.
+    free(gDeltaSpareBuffer);
+    gDeltaSpareBuffer = buffer;
+    gDeltaSpareBufferSize = size;
+    gDeltaInFlight = false;
+    gDeltaCondVar->notify_all();
+  }
+}
+
+void FlushPaintDeltas() {
+  if (!gDeltaMutex) {
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(*gDeltaMutex);
+  while (gDeltaBuffer || gDeltaInFlight) {
+    gDeltaCondVar->wait(lock);
+  }
+}
+
+// File which compressed paint delta chunks are appended to.
+static FILE* gPaintDeltaFile;
+
+static void PaintDeltaSink(const void* aData, size_t aSize,
+                           size_t aDecompressedSize) {
+  uint64_t sizes[2] = { aSize, aDecompressedSize };
+  fwrite(sizes, sizeof(sizes), 1, gPaintDeltaFile);
+  fwrite(aData, 1, aSize, gPaintDeltaFile);
+  fflush(gPaintDeltaFile);
+}
+
+// Composite the current layer state into gDrawTargetBuffer and hand it off
+// for delta encoding, instead of writing a full image file.
+static void MaybeRecordPaintDelta() {
+  if (!gPaintDeltaFile) {
+    nsPrintfCString path("%s/paints.delta", gPaintsDirectory);
+    gPaintDeltaFile = fopen(path.get(), "w");
+    MOZ_RELEASE_ASSERT(gPaintDeltaFile);
+    InitializeRecordingCompression(PaintDeltaSink);
+
+    gDeltaMutex = new std::mutex();
+    gDeltaCondVar = new std::condition_variable();
+    std::thread thread(PaintDeltaThreadMain);
+    thread.detach();
+  }
+
+  {
+    AutoDisallowThreadEvents disallow;
+    gCompositorBridge->CompositeToTarget(VsyncId(), nullptr, nullptr);
+  }
+
+  if (!gFetchedDrawTarget) {
+    return;
+  }
+  gFetchedDrawTarget = false;
+
+  std::unique_lock<std::mutex> lock(*gDeltaMutex);
+
+  // Only one paint may be in the pipeline at a time, so that deltas reach
+  // the compression stream in paint order. If the encoding thread has fallen
+  // behind, wait for it to catch up.
+  while (gDeltaBuffer || gDeltaInFlight) {
+    gDeltaCondVar->wait(lock);
+  }
+
+  // Hand the painted buffer to the encoding thread and install the recycled
+  // buffer (or a fresh one) as the compositor's next draw target. The next
+  // composite repaints the whole target, so the recycled buffer's stale
+  // contents don't matter.
+  gDeltaBuffer = gDrawTargetBuffer;
+  gDeltaBufferSize = gDrawTargetBufferSize;
+  gDeltaWidth = gPaintWidth;
+  gDeltaHeight = gPaintHeight;
+  if (gDeltaSpareBufferSize != gDrawTargetBufferSize) {
+    free(gDeltaSpareBuffer);
+    gDeltaSpareBuffer = malloc(gDrawTargetBufferSize);
+    gDeltaSpareBufferSize = gDrawTargetBufferSize;
+  }
+  gDrawTargetBuffer = gDeltaSpareBuffer;
+  gDeltaSpareBuffer = nullptr;
+  gDeltaSpareBufferSize = 0;
+  gDeltaCondVar->notify_all();
+}
+
 static size_t gPaintIndex = 0;
 static size_t gPaintSubindex = 0;
 static bool gCreatingPaintFile;
@@ -346,6 +610,11 @@ static void MaybeCreatePaintFile() {
   ++gPaintIndex;
   gPaintSubindex = 0;
 
+  if (gRecordPaintDeltas) {
+    MaybeRecordPaintDelta();
+    return;
+  }
+
   gCreatingPaintFile = true;
   char* buf = PaintCallback("image/jpeg", 50);
   gCreatingPaintFile = false;
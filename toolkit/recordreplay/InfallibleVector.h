@@ -51,6 +51,10 @@ class InfallibleVectorOperations {
     }
   }
 
+  // Return any excess capacity to the OS, e.g. after a capture phase has
+  // finished and the vector has stopped growing.
+  void releaseUnusedCapacity() { Vector().shrinkStorageToFit(); }
+
   void resize(size_t aNewLength) {
     if (!Vector().resize(aNewLength)) {
       MOZ_CRASH();
@@ -145,6 +149,87 @@ class StaticInfallibleVector
   }
 };
 
+// Variant of InfallibleVector which stores its contents in fixed size
+// segments instead of one contiguous allocation. Appending never moves
+// existing elements, so very large capture vectors avoid both the copy
+// storms and the transient doubled footprint of contiguous reallocation.
+// The tradeoff is that elements are not contiguous, so there is no begin()
+// or end(); access is by index.
+template <typename T, size_t SegmentCapacity = 4096>
+class SegmentedInfallibleVector {
+  struct Segment {
+    T mElements[SegmentCapacity];
+  };
+
+  InfallibleVector<Segment*> mSegments;
+  size_t mLength = 0;
+
+  Segment* EnsureSegmentForAppend() {
+    size_t segment = mLength / SegmentCapacity;
+    if (segment == mSegments.length()) {
+      mSegments.append(new Segment());
+    }
+    return mSegments[segment];
+  }
+
+ public:
+  SegmentedInfallibleVector() = default;
+
+  SegmentedInfallibleVector(const SegmentedInfallibleVector&) = delete;
+  SegmentedInfallibleVector& operator=(const SegmentedInfallibleVector&) =
+      delete;
+
+  ~SegmentedInfallibleVector() { clear(); }
+
+  size_t length() const { return mLength; }
+  bool empty() const { return !mLength; }
+
+  T& operator[](size_t aIndex) {
+    MOZ_ASSERT(aIndex < mLength);
+    return mSegments[aIndex / SegmentCapacity]
+        ->mElements[aIndex % SegmentCapacity];
+  }
+  const T& operator[](size_t aIndex) const {
+    MOZ_ASSERT(aIndex < mLength);
+    return mSegments[aIndex / SegmentCapacity]
+        ->mElements[aIndex % SegmentCapacity];
+  }
+
+  T& back() { return (*this)[mLength - 1]; }
+  const T& back() const { return (*this)[mLength - 1]; }
+
+  template <typename U>
+  void append(U&& aU) {
+    Segment* segment = EnsureSegmentForAppend();
+    segment->mElements[mLength % SegmentCapacity] = std::forward<U>(aU);
+    mLength++;
+  }
+
+  void popBack() {
+    MOZ_ASSERT(mLength);
+    mLength--;
+  }
+
+  void clear() {
+    for (Segment* segment : mSegments) {
+      delete segment;
+    }
+    mSegments.clear();
+    mLength = 0;
+  }
+
+  // Free segments past the current length, and any slop in the segment
+  // pointer vector itself.
+  void releaseUnusedCapacity() {
+    size_t needed = (mLength + SegmentCapacity - 1) / SegmentCapacity;
+    while (mSegments.length() > needed) {
+      delete mSegments.back();
+      mSegments.popBack();
+    }
+    mSegments.releaseUnusedCapacity();
+  }
+};
+
 }  // namespace recordreplay
 }  // namespace mozilla
 
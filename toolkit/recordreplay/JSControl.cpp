@@ -6,11 +6,13 @@
 
 #include "JSControl.h"
 #include "ProcessRecordReplay.h"
+#include "RecordingStringTable.h"
 
 #include "mozilla/Base64.h"
 #include "mozilla/ClearOnShutdown.h"
 #include "mozilla/StaticMutex.h"
 #include "mozilla/StaticPtr.h"
+#include "js/Array.h"
 #include "js/CharacterEncoding.h"
 #include "js/Conversions.h"
 #include "js/JSON.h"
@@ -23,6 +25,12 @@
 #include <fcntl.h>
 #include <sys/stat.h>
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #ifndef XP_WIN
 #include <unistd.h>
 #endif
@@ -39,12 +47,14 @@ namespace recordreplay {
 // This is used for operations that could be considered security sensitive,
 // and is currently targeted at times when the recording accesses existing
 // information from the user's profile like cookies and local storage.
+// Kinds and values repeat heavily (the same cookie or storage key can be
+// accessed thousands of times), so operations store interned string ids.
 struct RecordingOperation {
-  nsCString mKind;
-  nsCString mValue;
+  uint32_t mKindId;
+  uint32_t mValueId;
 
-  RecordingOperation(const char* aKind, const char* aValue)
-    : mKind(aKind), mValue(aValue) {}
+  RecordingOperation(uint32_t aKindId, uint32_t aValueId)
+    : mKindId(aKindId), mValueId(aValueId) {}
 };
 static StaticInfallibleVector<RecordingOperation> gRecordingOperations;
 static StaticMutex gRecordingOperationsMutex;
@@ -56,8 +66,11 @@ void AddRecordingOperation(const char* aKind, const char* aValue) {
 
   RecordReplayAssert("AddRecordingOperation %s %s", aKind, aValue);
 
+  uint32_t kindId = InternRecordingString(aKind);
+  uint32_t valueId = InternRecordingString(aValue);
+
   StaticMutexAutoLock lock(gRecordingOperationsMutex);
-  gRecordingOperations.append(RecordingOperation(aKind, aValue));
+  gRecordingOperations.append(RecordingOperation(kindId, valueId));
 }
 
 namespace js {
@@ -84,6 +97,10 @@ static size_t (*gElapsedTimeMs)();
 static char* (*gGetUnusableRecordingReason)();
 static void (*gAddMetadata)(const char* metadata);
 
+// Optional driver entry point for delivering a command result off thread.
+// Results must be delivered in the order the commands were received.
+static void (*gAsyncCommandResult)(const char* aResult);
+
 // Callback used when the recording driver is sending us a command to look up
 // some state.
 static char* CommandCallback(const char* aMethod, const char* aParams);
@@ -121,6 +138,8 @@ void InitializeJS() {
   LoadSymbol("RecordReplayElapsedTimeMs", gElapsedTimeMs);
   LoadSymbol("RecordReplayGetUnusableRecordingReason", gGetUnusableRecordingReason);
   LoadSymbol("RecordReplayAddMetadata", gAddMetadata);
+  LoadSymbol("RecordReplayAsyncCommandResult", gAsyncCommandResult,
+             /* aOptional */ true);
 
   gSetDefaultCommandCallback(CommandCallback);
   gSetClearPauseDataCallback(ClearPauseDataCallback);
@@ -128,6 +147,72 @@ void InitializeJS() {
   gSetPossibleBreakpointsCallback(PossibleBreakpointsCallback);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Checkpoint scheduling
+///////////////////////////////////////////////////////////////////////////////
+
+// Checkpoints are created at the top of the event loop, and bound how far the
+// replaying process has to re-execute when seeking. Creating one at every
+// event loop turn is wasteful on JS-heavy pages (high checkpoint overhead for
+// tiny slices of execution) and on idle pages the opposite problem appears:
+// long stretches of wall clock time with little execution between
+// checkpoints. The scheduler below sizes checkpoint intervals from observed
+// execution progress, and adapts the progress threshold so the checkpoint
+// cadence stays near a target wall clock interval.
+
+// Target time between checkpoints. Seek latency at replay time is roughly
+// bounded by how much execution one of these intervals can contain.
+static const size_t CheckpointTargetIntervalMs = 200;
+
+// Never go longer than this between checkpoints, even with no JS running,
+// so that seeking on mostly-idle pages stays fast.
+static const size_t CheckpointMaxIntervalMs = 1000;
+
+// Execution progress which must accumulate before a new checkpoint is
+// created, adjusted adaptively. The initial value is a guess which the
+// scheduler converges away from within a few checkpoints.
+static size_t gCheckpointProgressThreshold = 10000;
+
+// Bounds on the adaptive threshold so it can't run away in either direction.
+static const size_t MinCheckpointProgressThreshold = 1000;
+static const size_t MaxCheckpointProgressThreshold = 10000000;
+
+// State at the last created checkpoint.
+static ProgressCounter gLastCheckpointProgress;
+static size_t gLastCheckpointTimeMs;
+
+bool ShouldCreateCheckpoint() {
+  size_t elapsedMs = gElapsedTimeMs() - gLastCheckpointTimeMs;
+  if (elapsedMs >= CheckpointMaxIntervalMs) {
+    return true;
+  }
+
+  ProgressCounter progress = *ExecutionProgressCounter();
+  return progress - gLastCheckpointProgress >= gCheckpointProgressThreshold;
+}
+
+void NoteCheckpointCreated() {
+  size_t nowMs = gElapsedTimeMs();
+  size_t elapsedMs = nowMs - gLastCheckpointTimeMs;
+
+  // Nudge the progress threshold toward the target cadence: if checkpoints
+  // are arriving much faster than the target the threshold grows, and if
+  // execution is slow enough that the progress threshold is rarely reached
+  // the threshold shrinks so seeking stays fine grained.
+  if (elapsedMs < CheckpointTargetIntervalMs / 2) {
+    gCheckpointProgressThreshold =
+        std::min(gCheckpointProgressThreshold * 2,
+                 MaxCheckpointProgressThreshold);
+  } else if (elapsedMs > CheckpointTargetIntervalMs * 2) {
+    gCheckpointProgressThreshold =
+        std::max(gCheckpointProgressThreshold / 2,
+                 MinCheckpointProgressThreshold);
+  }
+
+  gLastCheckpointProgress = *ExecutionProgressCounter();
+  gLastCheckpointTimeMs = nowMs;
+}
+
 // URL of the root module script.
 #define ModuleURL "resource://devtools/server/actors/replay/module.js"
 
@@ -786,12 +871,14 @@ static bool Method_RecordingOperations(JSContext* aCx, unsigned aArgc, Value* aV
   }
 
   for (size_t i = 0; i < gRecordingOperations.length(); i++) {
-    RootedString kind(aCx, JS_NewStringCopyZ(aCx, gRecordingOperations[i].mKind.get()));
+    RootedString kind(aCx, JS_NewStringCopyZ(
+        aCx, GetInternedString(gRecordingOperations[i].mKindId).get()));
     if (!kind) {
       return false;
     }
 
-    RootedString value(aCx, JS_NewStringCopyZ(aCx, gRecordingOperations[i].mValue.get()));
+    RootedString value(aCx, JS_NewStringCopyZ(
+        aCx, GetInternedString(gRecordingOperations[i].mValueId).get()));
     if (!value) {
       return false;
     }
@@ -915,6 +1002,238 @@ static const JSFunctionSpec gRecordReplayMethods[] = {
   JS_FS_END
 };
 
+///////////////////////////////////////////////////////////////////////////////
+// Off thread command response serialization
+///////////////////////////////////////////////////////////////////////////////
+
+// Stringifying large command responses (e.g. object previews) with the JS
+// JSON stringifier blocks the main thread while the page is running. When
+// the driver supports asynchronous command results, responses are instead
+// snapshotted into the POD structure below --- a cheap traversal with no
+// string building --- and stringified on a helper thread, with results
+// delivered to the driver in command order.
+
+struct SnapshotValue {
+  enum Kind { Null, Boolean, Number, String, Array, Object } mKind = Null;
+
+  bool mBoolean = false;
+  double mNumber = 0;
+  nsCString mString;
+
+  // Contents for arrays and objects. Objects store alternating keys and
+  // values.
+  std::vector<SnapshotValue> mChildren;
+};
+
+// Snapshot a JS value into POD form, mirroring what ToJSONMaybeSafely
+// accepts: anything unexpected becomes null rather than throwing.
+static void SnapshotJSValue(JSContext* aCx, HandleValue aValue,
+                            SnapshotValue& aSnapshot) {
+  if (aValue.isBoolean()) {
+    aSnapshot.mKind = SnapshotValue::Boolean;
+    aSnapshot.mBoolean = aValue.toBoolean();
+    return;
+  }
+
+  if (aValue.isNumber()) {
+    aSnapshot.mKind = SnapshotValue::Number;
+    aSnapshot.mNumber = aValue.toNumber();
+    return;
+  }
+
+  if (aValue.isString()) {
+    aSnapshot.mKind = SnapshotValue::String;
+    nsAutoCString str;
+    ConvertJSStringToCString(aCx, aValue.toString(), str);
+    aSnapshot.mString = str;
+    return;
+  }
+
+  if (aValue.isObject()) {
+    RootedObject obj(aCx, &aValue.toObject());
+
+    bool isArray;
+    if (!IsArrayObject(aCx, obj, &isArray)) {
+      MOZ_CRASH("SnapshotJSValue IsArrayObject");
+    }
+
+    if (isArray) {
+      aSnapshot.mKind = SnapshotValue::Array;
+
+      uint32_t length;
+      if (!GetArrayLength(aCx, obj, &length)) {
+        MOZ_CRASH("SnapshotJSValue GetArrayLength");
+      }
+
+      aSnapshot.mChildren.resize(length);
+      for (uint32_t i = 0; i < length; i++) {
+        RootedValue element(aCx);
+        if (!JS_GetElement(aCx, obj, i, &element)) {
+          MOZ_CRASH("SnapshotJSValue GetElement");
+        }
+        SnapshotJSValue(aCx, element, aSnapshot.mChildren[i]);
+      }
+      return;
+    }
+
+    aSnapshot.mKind = SnapshotValue::Object;
+
+    RootedIdVector ids(aCx);
+    if (!JS_Enumerate(aCx, obj, &ids)) {
+      MOZ_CRASH("SnapshotJSValue Enumerate");
+    }
+
+    for (size_t i = 0; i < ids.length(); i++) {
+      RootedId id(aCx, ids[i]);
+      RootedValue idValue(aCx);
+      if (!JS_IdToValue(aCx, id, &idValue)) {
+        MOZ_CRASH("SnapshotJSValue IdToValue");
+      }
+      if (!idValue.isString() && !idValue.isNumber()) {
+        continue;
+      }
+
+      RootedValue property(aCx);
+      if (!JS_GetPropertyById(aCx, obj, id, &property)) {
+        MOZ_CRASH("SnapshotJSValue GetPropertyById");
+      }
+
+      SnapshotValue key;
+      SnapshotJSValue(aCx, idValue, key);
+      if (key.mKind == SnapshotValue::Number) {
+        key.mKind = SnapshotValue::String;
+        key.mString = nsPrintfCString("%.0f", key.mNumber);
+      }
+
+      aSnapshot.mChildren.push_back(std::move(key));
+      aSnapshot.mChildren.emplace_back();
+      SnapshotJSValue(aCx, property, aSnapshot.mChildren.back());
+    }
+    return;
+  }
+
+  // null, undefined and anything else serialize as null.
+  aSnapshot.mKind = SnapshotValue::Null;
+}
+
+static void AppendEscapedJSONString(nsCString& aOutput,
+                                    const nsCString& aString) {
+  aOutput.Append('"');
+  for (size_t i = 0; i < aString.Length(); i++) {
+    char c = aString[i];
+    switch (c) {
+      case '"': aOutput.AppendLiteral("\\\""); break;
+      case '\\': aOutput.AppendLiteral("\\\\"); break;
+      case '\b': aOutput.AppendLiteral("\\b"); break;
+      case '\f': aOutput.AppendLiteral("\\f"); break;
+      case '\n': aOutput.AppendLiteral("\\n"); break;
+      case '\r': aOutput.AppendLiteral("\\r"); break;
+      case '\t': aOutput.AppendLiteral("\\t"); break;
+      default:
+        if ((unsigned char)c < 0x20) {
+          aOutput.Append(nsPrintfCString("\\u%04x", c));
+        } else {
+          aOutput.Append(c);
+        }
+    }
+  }
+  aOutput.Append('"');
+}
+
+// Stringify a snapshot. Runs on the serialization thread, without entering
+// the JS engine.
+static void StringifySnapshot(const SnapshotValue& aSnapshot,
+                              nsCString& aOutput) {
+  switch (aSnapshot.mKind) {
+    case SnapshotValue::Null:
+      aOutput.AppendLiteral("null");
+      break;
+    case SnapshotValue::Boolean:
+      aOutput.Append(aSnapshot.mBoolean ? "true" : "false");
+      break;
+    case SnapshotValue::Number:
+      if (aSnapshot.mNumber == (double)(int64_t)aSnapshot.mNumber) {
+        aOutput.Append(nsPrintfCString("%lld", (long long)aSnapshot.mNumber));
+      } else {
+        aOutput.Append(nsPrintfCString("%.17g", aSnapshot.mNumber));
+      }
+      break;
+    case SnapshotValue::String:
+      AppendEscapedJSONString(aOutput, aSnapshot.mString);
+      break;
+    case SnapshotValue::Array:
+      aOutput.Append('[');
+      for (size_t i = 0; i < aSnapshot.mChildren.size(); i++) {
+        if (i) {
+          aOutput.Append(',');
+        }
+        StringifySnapshot(aSnapshot.mChildren[i], aOutput);
+      }
+      aOutput.Append(']');
+      break;
+    case SnapshotValue::Object:
+      aOutput.Append('{');
+      for (size_t i = 0; i < aSnapshot.mChildren.size(); i += 2) {
+        if (i) {
+          aOutput.Append(',');
+        }
+        StringifySnapshot(aSnapshot.mChildren[i], aOutput);
+        aOutput.Append(':');
+        StringifySnapshot(aSnapshot.mChildren[i + 1], aOutput);
+      }
+      aOutput.Append('}');
+      break;
+  }
+}
+
+// Queue of snapshots waiting for stringification, in command order.
+static std::mutex* gSerializationMutex;
+static std::condition_variable* gSerializationCondVar;
+static std::deque<SnapshotValue>* gSerializationQueue;
+
+static void SerializationThreadMain() {
+  AutoPassThroughThreadEvents pt;
+
+  std::unique_lock<std::mutex> lock(*gSerializationMutex);
+  while (true) {
+    if (gSerializationQueue->empty()) {
+      gSerializationCondVar->wait(lock);
+      continue;
+    }
+
+    SnapshotValue snapshot = std::move(gSerializationQueue->front());
+    gSerializationQueue->pop_front();
+
+    lock.unlock();
+
+    nsCString output;
+    StringifySnapshot(snapshot, output);
+    gAsyncCommandResult(output.get());
+
+    lock.lock();
+  }
+}
+
+// Snapshot a response object and queue it for off thread stringification.
+static void EnqueueCommandResponse(JSContext* aCx, HandleObject aObject) {
+  if (!gSerializationMutex) {
+    gSerializationMutex = new std::mutex();
+    gSerializationCondVar = new std::condition_variable();
+    gSerializationQueue = new std::deque<SnapshotValue>();
+
+    std::thread thread(SerializationThreadMain);
+    thread.detach();
+  }
+
+  SnapshotValue snapshot;
+  RootedValue value(aCx, ObjectValue(*aObject));
+  SnapshotJSValue(aCx, value, snapshot);
+
+  std::unique_lock<std::mutex> lock(*gSerializationMutex);
+  gSerializationQueue->push_back(std::move(snapshot));
+  gSerializationCondVar->notify_all();
+}
+
 static char* CommandCallback(const char* aMethod, const char* aParams) {
   MOZ_RELEASE_ASSERT(js::IsModuleInitialized());
 
@@ -947,6 +1266,13 @@ static char* CommandCallback(const char* aMethod, const char* aParams) {
 
   RootedObject obj(cx, &rv.toObject());
 
+  // With a new enough driver, stringify the response on the serialization
+  // thread instead of blocking the main thread here.
+  if (gAsyncCommandResult) {
+    EnqueueCommandResponse(cx, obj);
+    return nullptr;
+  }
+
   nsCString str;
   if (!JS::ToJSONMaybeSafely(cx, obj, FillStringCallback, &str)) {
     PrintLog("Error: CommandCallback ToJSON failed");
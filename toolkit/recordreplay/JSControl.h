@@ -37,6 +37,13 @@ void MaybeSendRecordingUnusable();
 // Notify the UI process that recording is unsupported on this machine.
 void SendRecordingUnsupported(const char* aReason);
 
+// Whether enough execution has happened since the last checkpoint that a new
+// one should be created, per the adaptive checkpoint scheduler.
+bool ShouldCreateCheckpoint();
+
+// Notify the scheduler that a checkpoint was just created.
+void NoteCheckpointCreated();
+
 }  // namespace js
 }  // namespace recordreplay
 }  // namespace mozilla
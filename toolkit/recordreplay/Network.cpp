@@ -7,6 +7,7 @@
 // Interfaces for wrapping standard request binary response data streams.
 
 #include "ProcessRecordReplay.h"
+#include "RecordingRingBuffer.h"
 #include "nsIObserverService.h"
 #include "nsIRequest.h"
 #include "mozilla/InputStreamLengthHelper.h"
@@ -134,6 +135,16 @@ class ReplayInputStreamTee final : public nsIAsyncInputStream,
   nsCOMPtr<nsIOutputStream> mSink;
   ~ReplayInputStreamTee() = default;
 
+  // Captured bytes which have not been written to the sink yet. Reads append
+  // here and then opportunistically drain to the sink, so a momentarily full
+  // sink pipe does not stall the thread reading the body.
+  RecordingRingBuffer mSinkBuffer{256 * 1024};
+
+  // Drain mSinkBuffer into the sink. When aBlocking is true this loops until
+  // the buffer is empty or the sink fails; otherwise it stops as soon as the
+  // sink stops accepting data.
+  void FlushSinkBuffer(bool aBlocking);
+
   // Optional interfaces implemented by source.
   nsCOMPtr<nsIAsyncInputStream> mAsyncSource;
   nsCOMPtr<nsIInputStreamLength> mSourceLength;
@@ -176,11 +187,36 @@ ReplayInputStreamTee::ReplayInputStreamTee(nsIInputStream* aSource, nsIOutputStr
   }
 }
 
+void ReplayInputStreamTee::FlushSinkBuffer(bool aBlocking) {
+  while (mSink) {
+    size_t spanSize;
+    const char* span = mSinkBuffer.PeekSpan(&spanSize);
+    if (!spanSize) {
+      return;
+    }
+
+    uint32_t bytesWritten = 0;
+    nsresult rv = mSink->Write(span, spanSize, &bytesWritten);
+    if (NS_FAILED(rv)) {
+      if (rv == NS_BASE_STREAM_WOULD_BLOCK && !aBlocking) {
+        return;
+      }
+      NS_WARNING("ReplayInputStreamTee write silently failed, dropping sink");
+      mSink = nullptr;
+      return;
+    }
+    mSinkBuffer.ReleaseSpan(bytesWritten);
+  }
+}
+
 // nsIInputStream
 
 NS_IMETHODIMP
 ReplayInputStreamTee::Close() {
   nsresult rv = mSource->Close();
+  if (mSink) {
+    FlushSinkBuffer(/* aBlocking */ true);
+  }
   if (mSink) {
     nsresult rv2 = mSink->Close();
     mSink = nullptr;
@@ -199,6 +235,9 @@ NS_IMETHODIMP
 ReplayInputStreamTee::Available(uint64_t* aResult) {
   nsresult rv = mSource->Available(aResult);
 
+  if (rv == NS_BASE_STREAM_CLOSED && mSink) {
+    FlushSinkBuffer(/* aBlocking */ true);
+  }
   if (rv == NS_BASE_STREAM_CLOSED && mSink) {
     nsresult rv2 = mSink->Close();
     mSink = nullptr;
@@ -223,9 +262,13 @@ ReplayInputStreamTee::Read(char* aBuf, uint32_t aCount, uint32_t* aResult) {
   }
 
   if (*aResult == 0 && mSink) {
-    rv = mSink->Close();
-    mSink = nullptr;
-    return rv;
+    FlushSinkBuffer(/* aBlocking */ true);
+    if (mSink) {
+      rv = mSink->Close();
+      mSink = nullptr;
+      return rv;
+    }
+    return NS_OK;
   }
 
   if (!mSink) {
@@ -234,18 +277,14 @@ ReplayInputStreamTee::Read(char* aBuf, uint32_t aCount, uint32_t* aResult) {
 
   uint32_t remaining = *aResult;
   uint32_t totalBytesWritten = 0;
-  while (remaining > 0) {
-    uint32_t bytesWritten = 0;
-    rv = mSink->Write(aBuf + totalBytesWritten, remaining, &bytesWritten);
-
-    if (NS_FAILED(rv)) {
-      NS_WARNING("ReplayInputStreamTee write silently failed, dropping sink");
-      mSink = nullptr;
-      break;
-    }
-    NS_ASSERTION(bytesWritten <= remaining, "wrote too much");
-    totalBytesWritten += bytesWritten;
-    remaining -= bytesWritten;
+  while (remaining > 0 && mSink) {
+    size_t appended = mSinkBuffer.Append(aBuf + totalBytesWritten, remaining);
+    totalBytesWritten += appended;
+    remaining -= appended;
+
+    // If the ring filled up the sink has fallen far behind; drain it before
+    // buffering the rest so no captured data is dropped.
+    FlushSinkBuffer(/* aBlocking */ remaining > 0);
   }
 
   return NS_OK;
@@ -298,6 +337,9 @@ NS_IMETHODIMP
 ReplayInputStreamTee::CloseWithStatus(nsresult aRv) {
   MOZ_ASSERT(mAsyncSource);
   nsresult rv = mAsyncSource->CloseWithStatus(aRv);
+  if (mSink) {
+    FlushSinkBuffer(/* aBlocking */ true);
+  }
   if (mSink) {
     nsresult rv2 = mSink->Close();
     mSink = nullptr;
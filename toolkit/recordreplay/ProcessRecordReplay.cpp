@@ -7,6 +7,8 @@
 #include "ProcessRecordReplay.h"
 
 #include "JSControl.h"
+#include "RecordingCompression.h"
+#include "RecordingUpload.h"
 #include "mozilla/BasicEvents.h"
 #include "mozilla/dom/BrowserChild.h"
 #include "mozilla/dom/ScriptSettings.h"
@@ -458,6 +460,8 @@ MOZ_EXPORT void RecordReplayInterface_Initialize(int* aArgc, char*** aArgv) {
   LoadSymbol("RecordReplayIsRecordingCreated", gIsRecordingCreated);
   LoadSymbol("RecordReplayWaitForRecordingCreated", gWaitForRecordingCreated);
 
+  InitializeRecordingUpload();
+
   if (apiKey) {
     gSetApiKey(apiKey->c_str());
   }
@@ -871,6 +875,7 @@ void CreateCheckpoint() {
 
   gRecordReplayNewCheckpoint();
   gHasCheckpoint = true;
+  js::NoteCheckpointCreated();
 
   // When recording all content, we won't remember the recording until it has loaded
   // some interesting source. See Method_OnNewSource. Otherwise we want to make sure
@@ -885,8 +890,11 @@ void MaybeCreateCheckpoint() {
   // This is called at the top of the event loop, and the process might not be
   // fully initialized. CreateCheckpoint() is only called after the process has
   // been fully initialized, and we don't want any checkpoints before then.
-  if (HasCheckpoint()) {
+  // The adaptive scheduler decides whether enough execution has happened
+  // since the last checkpoint for a new one to be worthwhile.
+  if (HasCheckpoint() && js::ShouldCreateCheckpoint()) {
     gRecordReplayNewCheckpoint();
+    js::NoteCheckpointCreated();
   }
 }
 
@@ -904,6 +912,16 @@ void FinishRecording() {
   //  b) failed and marked the recording as unusable
   gWaitForRecordingCreated();
 
+  // Make sure any data still sitting in the background encoding and
+  // compression pipelines makes it into the recording before the driver
+  // finalizes it.
+  FlushPaintDeltas();
+  FlushRecordingData();
+
+  // Upload finished parts of the recording over concurrent connections, so
+  // that the driver's serial path only has to send what remains.
+  UploadRecordingInParallel();
+
   js::SendRecordingFinished();
 
   gFinishRecording();
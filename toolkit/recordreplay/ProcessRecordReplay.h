@@ -31,6 +31,12 @@ static inline bool TestEnv(const char* env) {
 }
 
 void InitializeGraphics();
+
+// Block until any paint delta handed to the background encoding thread has
+// been fed into the compression pipeline, so a subsequent
+// FlushRecordingData() covers it.
+void FlushPaintDeltas();
+
 bool HasCheckpoint();
 void RememberRecording();
 void FinishRecording();
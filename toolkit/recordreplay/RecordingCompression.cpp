@@ -0,0 +1,136 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Background compression pipeline for bulk recording data, see
+// RecordingCompression.h.
+
+#include "RecordingCompression.h"
+
+#include "ProcessRecordReplay.h"
+#include "mozilla/Compression.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mozilla::recordreplay {
+
+// Uncompressed size of each chunk handed to the compression thread. Chunks
+// need to be large enough for LZ4 to find matches, but small enough that the
+// pipeline keeps flowing while data is still being produced.
+static const size_t ChunkSize = 512 * 1024;
+
+// Maximum number of chunks that may be waiting for compression before
+// producers block. This bounds the memory held by the pipeline if the
+// compression thread falls behind.
+static const size_t MaxPendingChunks = 16;
+
+struct CompressionChunk {
+  std::vector<char> mData;
+};
+
+// All state below is protected by gMutex.
+static std::mutex* gMutex;
+static std::condition_variable* gCondVar;
+
+// Chunks waiting to be compressed, in stream order. The front chunk is the
+// one currently being filled by producers.
+static std::deque<CompressionChunk>* gPendingChunks;
+
+// Whether the compression thread is currently working on a chunk, so that
+// FlushRecordingData does not return while a chunk is in flight.
+static bool gChunkInFlight;
+
+static CompressedChunkSink gSink;
+
+static void CompressionThreadMain() {
+  // The compression thread only touches buffers which have been handed off by
+  // producers, and calls into the sink. Make sure none of this interacts with
+  // the recording itself.
+  AutoPassThroughThreadEvents pt;
+
+  std::unique_lock<std::mutex> lock(*gMutex);
+  while (true) {
+    if (gPendingChunks->empty()) {
+      gCondVar->wait(lock);
+      continue;
+    }
+
+    CompressionChunk chunk = std::move(gPendingChunks->front());
+    gPendingChunks->pop_front();
+    gChunkInFlight = true;
+    gCondVar->notify_all();
+
+    lock.unlock();
+
+    size_t bound = Compression::LZ4::maxCompressedSize(chunk.mData.size());
+    std::vector<char> compressed(bound);
+    size_t compressedSize = Compression::LZ4::compress(
+        chunk.mData.data(), chunk.mData.size(), compressed.data());
+    MOZ_RELEASE_ASSERT(compressedSize);
+
+    gSink(compressed.data(), compressedSize, chunk.mData.size());
+
+    lock.lock();
+    gChunkInFlight = false;
+    gCondVar->notify_all();
+  }
+}
+
+void InitializeRecordingCompression(CompressedChunkSink aSink) {
+  MOZ_RELEASE_ASSERT(!gMutex);
+  MOZ_RELEASE_ASSERT(aSink);
+
+  gMutex = new std::mutex();
+  gCondVar = new std::condition_variable();
+  gPendingChunks = new std::deque<CompressionChunk>();
+  gSink = aSink;
+
+  std::thread thread(CompressionThreadMain);
+  thread.detach();
+}
+
+void EnqueueRecordingData(const void* aData, size_t aSize) {
+  MOZ_RELEASE_ASSERT(gMutex);
+
+  const char* data = static_cast<const char*>(aData);
+
+  std::unique_lock<std::mutex> lock(*gMutex);
+  while (aSize) {
+    while (gPendingChunks->size() > MaxPendingChunks) {
+      gCondVar->wait(lock);
+    }
+
+    if (gPendingChunks->empty() ||
+        gPendingChunks->back().mData.size() == ChunkSize) {
+      gPendingChunks->emplace_back();
+      gPendingChunks->back().mData.reserve(ChunkSize);
+    }
+
+    CompressionChunk& chunk = gPendingChunks->back();
+    size_t nbytes = std::min(aSize, ChunkSize - chunk.mData.size());
+    chunk.mData.insert(chunk.mData.end(), data, data + nbytes);
+    data += nbytes;
+    aSize -= nbytes;
+  }
+  gCondVar->notify_all();
+}
+
+void FlushRecordingData() {
+  if (!gMutex) {
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(*gMutex);
+  gCondVar->notify_all();
+  while (!gPendingChunks->empty() || gChunkInFlight) {
+    gCondVar->wait(lock);
+  }
+}
+
+}  // namespace mozilla::recordreplay
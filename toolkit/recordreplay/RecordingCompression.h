@@ -0,0 +1,46 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef mozilla_recordreplay_RecordingCompression_h
+#define mozilla_recordreplay_RecordingCompression_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace mozilla::recordreplay {
+
+// Bulk data which this process produces for inclusion in the recording
+// (graphics payloads, network bodies and so forth) can be routed through a
+// background compression pipeline instead of being handed to the driver
+// directly. Data is split into fixed size chunks which are compressed with
+// LZ4 on a dedicated thread, so the thread producing the data never blocks
+// on compression or downstream I/O.
+//
+// Compressed chunks are forwarded to a sink callback, in the same order the
+// data was enqueued. Each chunk is framed with its compressed and
+// decompressed sizes so the consumer can reassemble the stream.
+
+// Signature for the sink receiving compressed chunks. aDecompressedSize is
+// the size of the original data in the chunk.
+typedef void (*CompressedChunkSink)(const void* aData, size_t aSize,
+                                    size_t aDecompressedSize);
+
+// Start the compression thread, routing compressed chunks to aSink.
+// Must be called before EnqueueRecordingData.
+void InitializeRecordingCompression(CompressedChunkSink aSink);
+
+// Append data to the stream. Copies the data and returns immediately;
+// compression happens on the pipeline thread. Can be called on any thread.
+void EnqueueRecordingData(const void* aData, size_t aSize);
+
+// Block until all enqueued data has been compressed and delivered to the
+// sink, including any partially filled trailing chunk. Called when the
+// recording is being finished.
+void FlushRecordingData();
+
+}  // namespace mozilla::recordreplay
+
+#endif  // mozilla_recordreplay_RecordingCompression_h
@@ -0,0 +1,105 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef mozilla_recordreplay_RecordingRingBuffer_h
+#define mozilla_recordreplay_RecordingRingBuffer_h
+
+#include "mozilla/Atomics.h"
+
+#include <algorithm>
+#include <string.h>
+
+namespace mozilla::recordreplay {
+
+// Single producer, single consumer byte ring buffer used to decouple capture
+// paths (e.g. network body capture) from the recording writer. The producer
+// reserves a contiguous span, fills it in place and commits it, so data can
+// be read directly into the ring without an intermediate buffer; the
+// consumer peeks at a contiguous span and releases it after handing it to
+// the writer. Neither side takes a lock, so a capture thread never blocks
+// on the writer as long as the ring has room.
+class RecordingRingBuffer {
+ public:
+  // aCapacity must be a power of two.
+  explicit RecordingRingBuffer(size_t aCapacity)
+      : mBuffer(new char[aCapacity]), mCapacity(aCapacity), mHead(0),
+        mTail(0) {
+    MOZ_RELEASE_ASSERT((aCapacity & (aCapacity - 1)) == 0);
+  }
+
+  ~RecordingRingBuffer() { delete[] mBuffer; }
+
+  RecordingRingBuffer(const RecordingRingBuffer&) = delete;
+  RecordingRingBuffer& operator=(const RecordingRingBuffer&) = delete;
+
+  // Total bytes committed but not yet released.
+  size_t Length() const { return mHead - mTail; }
+
+  // Bytes which can currently be reserved.
+  size_t Available() const { return mCapacity - Length(); }
+
+  // Producer: get a pointer to a contiguous span of up to aSize writable
+  // bytes. Returns the usable size in *aSpanSize, which can be smaller than
+  // requested near the end of the ring or when the ring is filling up. A
+  // zero result means the ring is full.
+  char* ReserveSpan(size_t aSize, size_t* aSpanSize) {
+    size_t offset = mHead & (mCapacity - 1);
+    *aSpanSize = std::min({ aSize, Available(), mCapacity - offset });
+    return mBuffer + offset;
+  }
+
+  // Producer: publish aSize bytes previously filled via ReserveSpan.
+  void CommitSpan(size_t aSize) {
+    MOZ_ASSERT(aSize <= Available());
+    mHead += aSize;
+  }
+
+  // Producer convenience for callers which already have the data in hand.
+  // Returns the number of bytes which fit.
+  size_t Append(const char* aData, size_t aSize) {
+    size_t total = 0;
+    while (aSize) {
+      size_t spanSize;
+      char* span = ReserveSpan(aSize, &spanSize);
+      if (!spanSize) {
+        break;
+      }
+      memcpy(span, aData, spanSize);
+      CommitSpan(spanSize);
+      aData += spanSize;
+      aSize -= spanSize;
+      total += spanSize;
+    }
+    return total;
+  }
+
+  // Consumer: get a pointer to the next contiguous span of committed bytes,
+  // with its size in *aSpanSize. A zero result means the ring is empty.
+  const char* PeekSpan(size_t* aSpanSize) {
+    size_t offset = mTail & (mCapacity - 1);
+    *aSpanSize = std::min(Length(), mCapacity - offset);
+    return mBuffer + offset;
+  }
+
+  // Consumer: release aSize bytes previously obtained via PeekSpan.
+  void ReleaseSpan(size_t aSize) {
+    MOZ_ASSERT(aSize <= Length());
+    mTail += aSize;
+  }
+
+ private:
+  char* mBuffer;
+  size_t mCapacity;
+
+  // Total bytes ever committed / released. Only the producer writes mHead
+  // and only the consumer writes mTail.
+  Atomic<size_t> mHead;
+  Atomic<size_t> mTail;
+};
+
+}  // namespace mozilla::recordreplay
+
+#endif  // mozilla_recordreplay_RecordingRingBuffer_h
@@ -0,0 +1,88 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Hash-consed string table for recording metadata, see
+// RecordingStringTable.h.
+
+#include "RecordingStringTable.h"
+
+#include "InfallibleVector.h"
+#include "mozilla/StaticMutex.h"
+
+#include <string>
+#include <unordered_map>
+
+namespace mozilla::recordreplay {
+
+// All state below is protected by gStringTableMutex.
+static StaticMutex gStringTableMutex;
+
+// Storage for interned strings, indexed by id - 1. Segmented so that strings
+// never move and references handed out by GetInternedString stay valid as
+// the table grows.
+static SegmentedInfallibleVector<nsCString>* gStrings;
+
+// Deduplication indexes, mapping string contents to id. Young entries have
+// been interned once; interning a string found in the young index promotes
+// it to the tenured index.
+static std::unordered_map<std::string, uint32_t>* gYoungIndex;
+static std::unordered_map<std::string, uint32_t>* gTenuredIndex;
+
+// Discard the young index when it grows past this many entries.
+static const size_t YoungIndexLimit = 100000;
+
+static void EnsureInitialized() {
+  if (!gStrings) {
+    gStrings = new SegmentedInfallibleVector<nsCString>();
+    gYoungIndex = new std::unordered_map<std::string, uint32_t>();
+    gTenuredIndex = new std::unordered_map<std::string, uint32_t>();
+  }
+}
+
+uint32_t InternRecordingString(const char* aString) {
+  StaticMutexAutoLock lock(gStringTableMutex);
+  EnsureInitialized();
+
+  std::string key(aString);
+
+  auto tenured = gTenuredIndex->find(key);
+  if (tenured != gTenuredIndex->end()) {
+    return tenured->second;
+  }
+
+  auto young = gYoungIndex->find(key);
+  if (young != gYoungIndex->end()) {
+    uint32_t id = young->second;
+    gTenuredIndex->emplace(std::move(key), id);
+    gYoungIndex->erase(young);
+    return id;
+  }
+
+  gStrings->append(nsCString(aString));
+  uint32_t id = gStrings->length();
+
+  if (gYoungIndex->size() >= YoungIndexLimit) {
+    gYoungIndex->clear();
+  }
+  gYoungIndex->emplace(std::move(key), id);
+
+  return id;
+}
+
+const nsCString& GetInternedString(uint32_t aId) {
+  StaticMutexAutoLock lock(gStringTableMutex);
+  MOZ_RELEASE_ASSERT(gStrings && aId && aId <= gStrings->length());
+  return (*gStrings)[aId - 1];
+}
+
+void CollectYoungRecordingStrings() {
+  StaticMutexAutoLock lock(gStringTableMutex);
+  if (gYoungIndex) {
+    gYoungIndex->clear();
+  }
+}
+
+}  // namespace mozilla::recordreplay
@@ -0,0 +1,42 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef mozilla_recordreplay_RecordingStringTable_h
+#define mozilla_recordreplay_RecordingStringTable_h
+
+#include "nsString.h"
+
+#include <stdint.h>
+
+namespace mozilla::recordreplay {
+
+// Recording metadata contains the same URLs, source names and header strings
+// thousands of times. The table below hash-conses such strings: each
+// distinct string is stored once and gets a stable 32 bit id, so metadata
+// can hold and write ids instead of the bytes. Ids are never reused or
+// invalidated.
+//
+// To bound the memory used by the deduplication index itself, the index is
+// generational: strings interned only once sit in a young index which is
+// discarded periodically, while strings interned more than once are
+// promoted to a tenured index which is kept for the life of the process.
+// Collecting the young index never affects issued ids or stored strings,
+// only the ability to deduplicate against them.
+
+// Intern a string, returning its stable id. Ids start at 1; 0 is never a
+// valid id. Threadsafe.
+uint32_t InternRecordingString(const char* aString);
+
+// Get the string for an id previously returned by InternRecordingString.
+// The returned reference is valid for the life of the process. Threadsafe.
+const nsCString& GetInternedString(uint32_t aId);
+
+// Discard the young deduplication index, see above. Threadsafe.
+void CollectYoungRecordingStrings();
+
+}  // namespace mozilla::recordreplay
+
+#endif  // mozilla_recordreplay_RecordingStringTable_h
@@ -0,0 +1,123 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Parallel multi-connection upload engine for recordings, see
+// RecordingUpload.h.
+
+#include "RecordingUpload.h"
+
+#include "ProcessRecordReplay.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef XP_WIN
+#include <unistd.h>
+#else
+#include <windows.h>
+#endif
+
+namespace mozilla::recordreplay {
+
+// Size of each independently uploaded part of the recording.
+static const size_t UploadPartSize = 8 * 1024 * 1024;
+
+// Number of concurrent upload connections.
+static const size_t NumUploadThreads = 4;
+
+// Attempts made for each part before giving up and leaving the remainder to
+// the driver's serial path.
+static const size_t MaxUploadAttempts = 3;
+
+// Optional driver entry points, null if the driver predates range uploads.
+//
+// RecordReplayGetUploadableRecordingSize returns the number of bytes at the
+// start of the recording which are stable and will not be rewritten; while
+// the recording is still being finished this can grow, so parallel upload
+// overlaps with the tail of recording.
+static uint64_t (*gGetUploadableRecordingSize)();
+static bool (*gUploadRecordingRange)(uint64_t aOffset, uint64_t aLength);
+
+void InitializeRecordingUpload() {
+  LoadSymbol("RecordReplayGetUploadableRecordingSize",
+             gGetUploadableRecordingSize, /* aOptional */ true);
+  LoadSymbol("RecordReplayUploadRecordingRange", gUploadRecordingRange,
+             /* aOptional */ true);
+}
+
+static void SleepMilliseconds(size_t aMs) {
+#ifndef XP_WIN
+  usleep(aMs * 1000);
+#else
+  ::Sleep(aMs);
+#endif
+}
+
+// Upload a single part, retrying with exponential backoff. Returns false if
+// all attempts failed.
+static bool UploadPartWithRetry(uint64_t aOffset, uint64_t aLength) {
+  size_t backoffMs = 100;
+  for (size_t attempt = 0; attempt < MaxUploadAttempts; attempt++) {
+    if (gUploadRecordingRange(aOffset, aLength)) {
+      return true;
+    }
+    SleepMilliseconds(backoffMs);
+    backoffMs *= 2;
+  }
+  return false;
+}
+
+void UploadRecordingInParallel() {
+  if (!gGetUploadableRecordingSize || !gUploadRecordingRange ||
+      !IsUploadingRecording()) {
+    return;
+  }
+
+  uint64_t size = gGetUploadableRecordingSize();
+  if (!size) {
+    return;
+  }
+
+  size_t numParts = (size + UploadPartSize - 1) / UploadPartSize;
+
+  // Index of the next part to claim, shared between upload threads.
+  std::atomic<size_t> nextPart(0);
+  std::atomic<size_t> numFailed(0);
+
+  auto worker = [&]() {
+    AutoPassThroughThreadEvents pt;
+    while (true) {
+      size_t part = nextPart.fetch_add(1);
+      if (part >= numParts) {
+        break;
+      }
+      uint64_t offset = uint64_t(part) * UploadPartSize;
+      uint64_t length = std::min<uint64_t>(UploadPartSize, size - offset);
+      if (!UploadPartWithRetry(offset, length)) {
+        numFailed++;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < std::min(NumUploadThreads, numParts); i++) {
+    threads.emplace_back(worker);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  if (numFailed) {
+    // Any parts which could not be uploaded will be retransmitted by the
+    // driver's serial path in RecordReplayFinishRecording().
+    PrintLog("UploadRecordingInParallel %zu/%zu parts failed, driver will retry",
+             numFailed.load(), numParts);
+  }
+}
+
+}  // namespace mozilla::recordreplay
@@ -0,0 +1,31 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef mozilla_recordreplay_RecordingUpload_h
+#define mozilla_recordreplay_RecordingUpload_h
+
+namespace mozilla::recordreplay {
+
+// When directly uploading a recording, session teardown is normally bounded
+// by a single serial upload performed by the driver inside
+// RecordReplayFinishRecording(). Newer drivers expose entry points for
+// uploading byte ranges of the recording independently; when those are
+// available we split the recording into parts and upload them over several
+// concurrent connections with retry/backoff, leaving only the final
+// manifest for the driver's serial path.
+
+// Load the optional driver entry points. Called during initialization,
+// after the driver has been attached.
+void InitializeRecordingUpload();
+
+// Upload as much of the recording as possible in parallel. Blocks until the
+// uploaded parts are durable. No-op if the driver does not support range
+// uploads; the driver's serial path then uploads everything as before.
+void UploadRecordingInParallel();
+
+}  // namespace mozilla::recordreplay
+
+#endif  // mozilla_recordreplay_RecordingUpload_h
@@ -201,11 +201,15 @@ class PromiseJobRunnable final : public MicroTaskRunnable {
     JSObject* callback = mCallback->CallbackPreserveColor();
     nsIGlobalObject* global = callback ? xpc::NativeGlobal(callback) : nullptr;
     if (global && !global->IsDying()) {
-      // Propagate the user input event handling bit if needed.
-      nsCOMPtr<nsPIDOMWindowInner> win = do_QueryInterface(global);
+      // Propagate the user input event handling bit if needed. Only look up
+      // the window and document when there is a bit to propagate; for the
+      // vast majority of promise jobs there isn't, and the QI and document
+      // ref would be pure per-microtask overhead.
       RefPtr<Document> doc;
-      if (win) {
-        doc = win->GetExtantDoc();
+      if (mPropagateUserInputEventHandling) {
+        if (nsCOMPtr<nsPIDOMWindowInner> win = do_QueryInterface(global)) {
+          doc = win->GetExtantDoc();
+        }
       }
       AutoHandlingUserInputStatePusher userInpStatePusher(
           mPropagateUserInputEventHandling);
@@ -247,12 +247,23 @@ nsresult MemoryTelemetry::GatherReports(
   // Collect cheap or main-thread only metrics synchronously, on the main
   // thread.
   RECORD(MEMORY_JS_GC_HEAP, JSMainRuntimeGCHeap, UNITS_BYTES);
-  RECORD(MEMORY_JS_COMPARTMENTS_SYSTEM, JSMainRuntimeCompartmentsSystem,
-         UNITS_COUNT);
-  RECORD(MEMORY_JS_COMPARTMENTS_USER, JSMainRuntimeCompartmentsUser,
-         UNITS_COUNT);
-  RECORD(MEMORY_JS_REALMS_SYSTEM, JSMainRuntimeRealmsSystem, UNITS_COUNT);
-  RECORD(MEMORY_JS_REALMS_USER, JSMainRuntimeRealmsUser, UNITS_COUNT);
+  {
+    // The compartment and realm counts are sampled together from a single
+    // traversal of the JS runtime, rather than one walk per histogram.
+    int64_t systemCompartments, userCompartments, systemRealms, userRealms;
+    if (NS_SUCCEEDED(mgr->GetJSMainRuntimeCompartmentsRealms(
+            &systemCompartments, &userCompartments, &systemRealms,
+            &userRealms))) {
+      HandleMemoryReport(Telemetry::MEMORY_JS_COMPARTMENTS_SYSTEM,
+                         nsIMemoryReporter::UNITS_COUNT, systemCompartments);
+      HandleMemoryReport(Telemetry::MEMORY_JS_COMPARTMENTS_USER,
+                         nsIMemoryReporter::UNITS_COUNT, userCompartments);
+      HandleMemoryReport(Telemetry::MEMORY_JS_REALMS_SYSTEM,
+                         nsIMemoryReporter::UNITS_COUNT, systemRealms);
+      HandleMemoryReport(Telemetry::MEMORY_JS_REALMS_USER,
+                         nsIMemoryReporter::UNITS_COUNT, userRealms);
+    }
+  }
   RECORD(MEMORY_IMAGES_CONTENT_USED_UNCOMPRESSED, ImagesContentUsedUncompressed,
          UNITS_BYTES);
   RECORD(MEMORY_STORAGE_SQLITE, StorageSQLite, UNITS_BYTES);
@@ -2484,6 +2484,17 @@ nsMemoryReporterManager::GetJSMainRuntimeRealmsUser(int64_t* aAmount) {
   return GetInfallibleAmount(mAmountFns.mJSMainRuntimeRealmsUser, aAmount);
 }
 
+nsresult nsMemoryReporterManager::GetJSMainRuntimeCompartmentsRealms(
+    int64_t* aSystemCompartments, int64_t* aUserCompartments,
+    int64_t* aSystemRealms, int64_t* aUserRealms) {
+  if (!mAmountFns.mJSMainRuntimeCompartmentsRealms) {
+    return NS_ERROR_NOT_AVAILABLE;
+  }
+  mAmountFns.mJSMainRuntimeCompartmentsRealms(
+      aSystemCompartments, aUserCompartments, aSystemRealms, aUserRealms);
+  return NS_OK;
+}
+
 NS_IMETHODIMP
 nsMemoryReporterManager::GetImagesContentUsedUncompressed(int64_t* aAmount) {
   return GetInfallibleAmount(mAmountFns.mImagesContentUsedUncompressed,
@@ -2746,6 +2757,13 @@ DEFINE_REGISTER_DISTINGUISHED_AMOUNT(Infallible, GhostWindows)
 #undef DEFINE_REGISTER_DISTINGUISHED_AMOUNT
 #undef DEFINE_UNREGISTER_DISTINGUISHED_AMOUNT
 
+nsresult RegisterJSMainRuntimeCompartmentsRealmsDistinguishedAmounts(
+    JSCompartmentsRealmsFn aFn) {
+  GET_MEMORY_REPORTER_MANAGER(mgr)
+  mgr->mAmountFns.mJSMainRuntimeCompartmentsRealms = aFn;
+  return NS_OK;
+}
+
 #define DEFINE_REGISTER_SIZE_OF_TAB(name)                              \
   nsresult Register##name##SizeOfTab(name##SizeOfTabFn aSizeOfTabFn) { \
     GET_MEMORY_REPORTER_MANAGER(mgr)                                   \
@@ -152,6 +152,7 @@ class nsMemoryReporterManager final : public nsIMemoryReporterManager,
     mozilla::InfallibleAmountFn mJSMainRuntimeCompartmentsUser = nullptr;
     mozilla::InfallibleAmountFn mJSMainRuntimeRealmsSystem = nullptr;
     mozilla::InfallibleAmountFn mJSMainRuntimeRealmsUser = nullptr;
+    mozilla::JSCompartmentsRealmsFn mJSMainRuntimeCompartmentsRealms = nullptr;
 
     mozilla::InfallibleAmountFn mImagesContentUsedUncompressed = nullptr;
 
@@ -163,6 +164,13 @@ class nsMemoryReporterManager final : public nsIMemoryReporterManager,
   };
   AmountFns mAmountFns;
 
+  // Gets all four JS compartment/realm counts from a single traversal of the
+  // main runtime, for samplers (e.g. MemoryTelemetry) that want them all.
+  // Fails if the JS engine hasn't registered its combined amount function.
+  [[nodiscard]] nsresult GetJSMainRuntimeCompartmentsRealms(
+      int64_t* aSystemCompartments, int64_t* aUserCompartments,
+      int64_t* aSystemRealms, int64_t* aUserRealms);
+
   // Convenience function to get RSS easily from other code.  This is useful
   // when debugging transient memory spikes with printf instrumentation.
   static int64_t ResidentFast();
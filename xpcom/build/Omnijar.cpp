@@ -11,6 +11,10 @@
 #include "nsIFile.h"
 #include "nsZipArchive.h"
 #include "nsNetUtil.h"
+#include "nsTArray.h"
+#include "nsThreadUtils.h"
+#include "nsXULAppAPI.h"
+#include "prthread.h"
 
 namespace mozilla {
 
@@ -99,10 +103,43 @@ void Omnijar::InitOne(nsIFile* aPath, Type aType) {
   sPath[aType] = file;
 }
 
+static void PrefetchOmnijar_ThreadStart(void* aArg) {
+  NS_SetCurrentThreadName("OmnijarPrefetch");
+  auto* archives = static_cast<nsTArray<RefPtr<nsZipArchive>>*>(aArg);
+  for (auto& archive : *archives) {
+    archive->PrefetchArchive();
+  }
+  delete archives;
+}
+
 void Omnijar::Init(nsIFile* aGrePath, nsIFile* aAppPath) {
   InitOne(aGrePath, GRE);
   InitOne(aAppPath, APP);
   sInitialized = true;
+
+  // On a cold start, entries are read from the archives in an essentially
+  // random order, which performs poorly on rotating disks. Pull the whole
+  // mappings into the page cache with one sequential pass on a background
+  // thread, ahead of the code that needs them. Only do this in the parent
+  // process; children inherit the warmed page cache.
+  if (XRE_IsParentProcess()) {
+    auto* archives = new nsTArray<RefPtr<nsZipArchive>>();
+    for (auto type : {GRE, APP}) {
+      // For nested archives, prefetching the outer archive covers the
+      // pages the inner reader is mapped from.
+      if (RefPtr<nsZipArchive> zip =
+              sOuterReader[type] ? sOuterReader[type].get()
+                                 : sReader[type].get()) {
+        archives->AppendElement(std::move(zip));
+      }
+    }
+    if (archives->IsEmpty() ||
+        !PR_CreateThread(PR_USER_THREAD, PrefetchOmnijar_ThreadStart, archives,
+                         PR_PRIORITY_NORMAL, PR_GLOBAL_THREAD,
+                         PR_UNJOINABLE_THREAD, 256 * 1024)) {
+      delete archives;
+    }
+  }
 }
 
 void Omnijar::CleanUp() {
@@ -179,10 +179,10 @@ struct ContractEntry final {
 /**
  * Represents a declared category manager entry declared in an XPCOM manifest.
  *
- * The entire set of static category entries is read at startup and loaded into
- * the category manager's dynamic hash tables, so there is memory and
- * initialization overhead for each entry in these tables. This may be further
- * optimized in the future to reduce some of that overhead.
+ * Static category entries stay in these read-only tables -- which live in the
+ * binary's memory-mapped image and are shared between processes -- until the
+ * category manager materializes a category on first use, so process startup
+ * does no per-entry registration work and untouched categories cost nothing.
  */
 struct StaticCategoryEntry final {
   StringOffset mEntry;
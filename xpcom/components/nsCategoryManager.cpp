@@ -33,9 +33,11 @@
 #include "mozilla/SimpleEnumerator.h"
 
 #include "ManifestParser.h"
+#include "StaticComponents.h"
 #include "nsSimpleEnumerator.h"
 
 using namespace mozilla;
+using mozilla::xpcom::gStaticCategories;
 class nsIComponentLoaderManager;
 
 /*
@@ -370,11 +372,48 @@ nsCategoryManager::~nsCategoryManager() {
 inline CategoryNode* nsCategoryManager::get_category(const nsACString& aName) {
   CategoryNode* node;
   if (!mTable.Get(PromiseFlatCString(aName).get(), &node)) {
-    return nullptr;
+    return MaybeMaterializeStaticCategory(aName);
   }
   return node;
 }
 
+CategoryNode* nsCategoryManager::MaybeMaterializeStaticCategory(
+    const nsACString& aName) {
+  // Categories declared in XPCOM manifests live in read-only tables in the
+  // binary image, shared between processes, and are only copied into the
+  // dynamic table the first time something asks for the category. Most
+  // categories are never touched in a given process and never leave the
+  // read-only image. The copy shares the static strings (they're literals,
+  // so MaybeStrdup doesn't copy them), and once made it behaves exactly
+  // like a dynamically registered category: later additions, overrides and
+  // deletions all act on the materialized node.
+  for (const auto& cat : gStaticCategories) {
+    if (!aName.Equals(cat.Name())) {
+      continue;
+    }
+
+    CategoryNode* category =
+        mTable
+            .InsertOrUpdate(MaybeStrdup(cat.Name(), &mArena),
+                            UniquePtr<CategoryNode>{CategoryNode::Create(
+                                &mArena)})
+            .get();
+    if (!category) {
+      return nullptr;
+    }
+
+    for (const auto& entry : cat) {
+      if (entry.Active()) {
+        nsAutoCString oldValue;
+        category->AddLeaf(entry.Entry(), entry.Value(), /* aReplace */ true,
+                          oldValue, &mArena);
+      }
+    }
+    return category;
+  }
+  return nullptr;
+}
+
 MOZ_DEFINE_MALLOC_SIZE_OF(CategoryManagerMallocSizeOf)
 
 NS_IMETHODIMP
@@ -607,6 +646,14 @@ nsCategoryManager::EnumerateCategories(nsISimpleEnumerator** aResult) {
   }
 
   MutexAutoLock lock(mLock);
+
+  // Materialize any static categories that haven't been asked for yet, so
+  // the enumeration sees them. This is rare enough that undoing the lazy
+  // copying for the remainder isn't worth tracking.
+  for (const auto& cat : gStaticCategories) {
+    get_category(cat.Name());
+  }
+
   CategoryEnumerator* enumObj = CategoryEnumerator::Create(mTable);
 
   if (!enumObj) {
@@ -131,6 +131,10 @@ class nsCategoryManager final : public nsICategoryManager,
   size_t SizeOfIncludingThis(mozilla::MallocSizeOf aMallocSizeOf);
 
   CategoryNode* get_category(const nsACString& aName);
+  // Copy a category out of the read-only static category table on first
+  // use; returns null if aName isn't a static category. Called by
+  // get_category() on a table miss, with mLock held.
+  CategoryNode* MaybeMaterializeStaticCategory(const nsACString& aName);
   void NotifyObservers(
       const char* aTopic,
       const nsACString& aCategoryName,  // must be a static string
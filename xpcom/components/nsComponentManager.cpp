@@ -372,14 +372,9 @@ nsresult nsComponentManagerImpl::Init() {
     RegisterModule((*sExtraStaticModules)[i]);
   }
 
-  auto* catMan = nsCategoryManager::GetSingleton();
-  for (const auto& cat : gStaticCategories) {
-    for (const auto& entry : cat) {
-      if (entry.Active()) {
-        catMan->AddCategoryEntry(cat.Name(), entry.Entry(), entry.Value());
-      }
-    }
-  }
+  // Note: static category entries are not registered here. The category
+  // manager materializes them lazily from the read-only tables in
+  // StaticComponents the first time each category is asked for.
 
   bool loadChromeManifests;
   switch (XRE_GetProcessType()) {
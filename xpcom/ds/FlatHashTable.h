@@ -0,0 +1,456 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef mozilla_FlatHashTable_h
+#define mozilla_FlatHashTable_h
+
+#include <string.h>
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include "mozilla/Assertions.h"
+#include "mozilla/CheckedInt.h"
+#include "mozilla/EndianUtils.h"
+#include "mozilla/HashFunctions.h"
+#include "mozilla/MathAlgorithms.h"
+#include "mozilla/MemoryReporting.h"
+#include "mozilla/RecordReplay.h"
+#include "mozilla/mozalloc.h"
+
+namespace mozilla {
+
+// FlatHashTable is an open-addressed hash table with flat metadata, in the
+// style of the "SwissTable" family of tables. It is an alternative to
+// PLDHashTable for hot tables with small, trivially-copyable entries.
+//
+// The table keeps one control byte per entry slot. A control byte records
+// whether the slot is empty or a tombstone, or else holds seven bits of the
+// entry's hash. Probing loads a group of kGroupWidth control bytes into a
+// single word and matches them with bitwise (SWAR) operations, so a lookup
+// normally inspects one or two cache lines of metadata and then touches only
+// entries whose control bytes already match the search hash. PLDHashTable's
+// double hashing, by contrast, reads a full stored hash word per probe and
+// strides across the entry store on collisions.
+//
+// Callers provide a traits class:
+//
+//   struct Traits {
+//     using Entry = ...;  // must be trivially copyable and destructible
+//     using Key = ...;
+//     static HashNumber Hash(const Key& aKey);
+//     static bool Match(const Entry& aEntry, const Key& aKey);
+//   };
+//
+// Newly added entries are zero-filled; callers that need to distinguish a
+// fresh entry from an existing one should test a member that is non-zero for
+// every initialized entry, as PLDHashTable consumers do with initEntry.
+//
+// Unlike PLDHashTable, this class performs no internal concurrency checking.
+// Callers must serialize all access to a given table.
+//
+// Like PLDHashTable, the table registers itself for stable hash codes when
+// recording or replaying, so iteration order is consistent between the two
+// executions.
+template <typename Traits>
+class FlatHashTable {
+ public:
+  using Entry = typename Traits::Entry;
+  using Key = typename Traits::Key;
+
+  static_assert(std::is_trivially_copyable_v<Entry> &&
+                    std::is_trivially_destructible_v<Entry>,
+                "entries are moved with memcpy and dropped without running "
+                "destructors");
+
+  static constexpr uint32_t kGroupWidth = 8;
+
+  static constexpr uint32_t kMinCapacity = kGroupWidth;
+  static constexpr uint32_t kMaxCapacity = ((uint32_t)1 << 26);
+
+  // This gives a default capacity of kMinCapacity.
+  static constexpr uint32_t kDefaultInitialLength = 4;
+
+  // Initialize the table with an initial capacity sized to hold aLength
+  // elements. The entry store is not allocated until the first element is
+  // added, so tables that are created but never used don't pay for the
+  // allocation.
+  explicit FlatHashTable(uint32_t aLength = kDefaultInitialLength)
+      : mInitialCapacity(CapacityForLength(aLength)) {
+    recordreplay::NewStableHashTable(this, KeyEqualsEntry, nullptr);
+  }
+
+  FlatHashTable(const FlatHashTable&) = delete;
+  FlatHashTable& operator=(const FlatHashTable&) = delete;
+
+  ~FlatHashTable() {
+    recordreplay::DeleteStableHashTable(this);
+    free(mHashes);
+  }
+
+  uint32_t EntryCount() const { return mEntryCount; }
+  uint32_t Capacity() const { return mCapacity; }
+
+  // Return the entry matching aKey, or null if there is none.
+  Entry* Search(const Key& aKey) const {
+    if (!mHashes) {
+      return nullptr;
+    }
+    return SearchInternal(aKey, ComputeKeyHash(aKey));
+  }
+
+  // Return the entry matching aKey, adding a zero-filled one if not present.
+  // Infallible; aborts on OOM like PLDHashTable's infallible Add.
+  Entry* Add(const Key& aKey) {
+    if (!mHashes) {
+      AllocateStore(mInitialCapacity);
+    }
+
+    HashNumber keyHash = ComputeKeyHash(aKey);
+    if (Entry* entry = SearchInternal(aKey, keyHash)) {
+      return entry;
+    }
+
+    // Grow or purge tombstones if the new entry would push the occupancy
+    // (live entries plus tombstones) above 7/8 of capacity.
+    if ((mEntryCount + mRemovedCount + 1) * 8 > mCapacity * 7) {
+      // Double only if the table is at least half full of live entries;
+      // otherwise rehash at the same size to reclaim tombstones.
+      uint32_t newCapacity =
+          mEntryCount * 2 >= mCapacity ? mCapacity * 2 : mCapacity;
+      if (newCapacity > kMaxCapacity) {
+        MOZ_CRASH("FlatHashTable is full");
+      }
+      ChangeTable(newCapacity);
+    }
+
+    uint32_t index = FindFreeSlot(keyHash);
+    if (mCtrl[index] == kDeleted) {
+      mRemovedCount--;
+    }
+    SetCtrl(index, H2(keyHash));
+    mHashes[index] = keyHash;
+    mEntryCount++;
+
+    Entry* entry = &mEntries[index];
+    memset(entry, 0, sizeof(Entry));
+    recordreplay::StableHashTableAddEntryForLastLookup(this, entry);
+    return entry;
+  }
+
+  // Remove the entry matching aKey, if present.
+  void Remove(const Key& aKey) {
+    if (!mHashes) {
+      return;
+    }
+    if (Entry* entry = SearchInternal(aKey, ComputeKeyHash(aKey))) {
+      RawRemove(uint32_t(entry - mEntries));
+      ShrinkIfAppropriate();
+    }
+  }
+
+  // An iterator over the live entries, in table order. As with PLDHashTable,
+  // the table must not otherwise be modified while iterating, and if any
+  // entries are removed via the iterator the table may shrink when the
+  // iterator is destroyed.
+  class Iterator {
+   public:
+    explicit Iterator(FlatHashTable* aTable)
+        : mTable(aTable), mIndex(0), mHaveRemoved(false) {
+      SkipToLive();
+    }
+
+    Iterator(Iterator&& aOther)
+        : mTable(aOther.mTable),
+          mIndex(aOther.mIndex),
+          mHaveRemoved(aOther.mHaveRemoved) {
+      aOther.mTable = nullptr;
+    }
+
+    Iterator(const Iterator&) = delete;
+    Iterator& operator=(const Iterator&) = delete;
+
+    ~Iterator() {
+      if (mTable && mHaveRemoved) {
+        mTable->ShrinkIfAppropriate();
+      }
+    }
+
+    bool Done() const { return mIndex >= mTable->mCapacity; }
+
+    Entry* Get() const {
+      MOZ_ASSERT(!Done());
+      return &mTable->mEntries[mIndex];
+    }
+
+    void Next() {
+      MOZ_ASSERT(!Done());
+      mIndex++;
+      SkipToLive();
+    }
+
+    // Remove the entry the iterator currently points at.
+    void Remove() {
+      MOZ_ASSERT(!Done());
+      mTable->RawRemove(mIndex);
+      mHaveRemoved = true;
+    }
+
+   private:
+    void SkipToLive() {
+      while (mIndex < mTable->mCapacity && !IsFull(mTable->mCtrl[mIndex])) {
+        mIndex++;
+      }
+    }
+
+    FlatHashTable* mTable;
+    uint32_t mIndex;
+    bool mHaveRemoved;
+  };
+
+  Iterator Iter() { return Iterator(this); }
+
+  // Measure the size of the table's entry storage. Doesn't measure anything
+  // the entries point to; callers should iterate for that.
+  size_t ShallowSizeOfExcludingThis(MallocSizeOf aMallocSizeOf) const {
+    return mHashes ? aMallocSizeOf(mHashes) : 0;
+  }
+
+ private:
+  // Control byte values. A full slot's control byte holds seven bits of the
+  // entry's hash (H2) with the sign bit clear, so empty and removed slots can
+  // be told apart from full ones with a single sign-bit test.
+  static constexpr uint8_t kEmpty = 0x80;
+  static constexpr uint8_t kDeleted = 0xFE;
+
+  static bool IsFull(uint8_t aCtrl) { return (aCtrl & 0x80) == 0; }
+
+  // The primary hash determines the slot where probing starts, and the seven
+  // H2 bits are what the control bytes are matched against. Neither uses the
+  // low seven bits of the hash: consumers that shard across several tables
+  // (like the atom table) select the shard with the low bits, and with a
+  // multiplicative scramble the low output bits depend only on the low input
+  // bits, so within a shard they'd be constant and every control byte in a
+  // table would match every search. The topmost bits are the best mixed, so
+  // H2 comes from the top of the word.
+  static uint32_t H1(HashNumber aHash) { return aHash >> 7; }
+  static uint8_t H2(HashNumber aHash) {
+    return uint8_t(aHash >> (kHashNumberBits - 7));
+  }
+
+  // A group of kGroupWidth control bytes, loaded into a single word and
+  // matched with bitwise (SWAR) operations in the style of SIMD hash tables,
+  // but portable to every target.
+  class Group {
+   public:
+    explicit Group(const uint8_t* aCtrl)
+        : mBytes(LittleEndian::readUint64(aCtrl)) {}
+
+    // Return a mask with the high bit set in each byte equal to aByte. The
+    // per-byte zero test is exact: no carries cross byte boundaries, so there
+    // are no false positives to filter out.
+    uint64_t Match(uint8_t aByte) const {
+      uint64_t cmp = mBytes ^ (kLsbs * aByte);
+      return ~(((cmp & ~kMsbs) + ~kMsbs) | cmp) & kMsbs;
+    }
+
+    uint64_t MatchEmpty() const { return Match(kEmpty); }
+
+    // Empty and removed slots are exactly those whose sign bit is set.
+    uint64_t MatchEmptyOrDeleted() const { return mBytes & kMsbs; }
+
+   private:
+    static constexpr uint64_t kLsbs = 0x0101010101010101ULL;
+    static constexpr uint64_t kMsbs = 0x8080808080808080ULL;
+
+    uint64_t mBytes;
+  };
+
+  // Index within a group of the lowest set mask bit from Group::Match.
+  static uint32_t MaskBitIndex(uint64_t aMask) {
+    return CountTrailingZeroes64(aMask) / 8;
+  }
+
+  // Compute the smallest power-of-two capacity that holds aLength entries
+  // under the 7/8 maximum load factor.
+  static uint32_t CapacityForLength(uint32_t aLength) {
+    if (aLength > kMaxCapacity / 2) {
+      MOZ_CRASH("Initial length is too large");
+    }
+    uint32_t minCapacity = aLength + (aLength + 6) / 7;
+    return std::max(kMinCapacity, RoundUpPow2(minCapacity));
+  }
+
+  static bool KeyEqualsEntry(const void* aKey, const void* aEntry,
+                             void* /* aPrivate */) {
+    return Traits::Match(*static_cast<const Entry*>(aEntry),
+                         *static_cast<const Key*>(aKey));
+  }
+
+  HashNumber ComputeKeyHash(const Key& aKey) const {
+    HashNumber keyHash = ScrambleHashCode(Traits::Hash(aKey));
+    if (recordreplay::IsRecordingOrReplaying()) {
+      keyHash = recordreplay::LookupStableHashCode(this, &aKey, keyHash,
+                                                   nullptr);
+    }
+    return keyHash;
+  }
+
+  // Probe the control bytes a group at a time. Successive groups are a
+  // growing number of groups apart; since the group count is a power of two
+  // this visits every slot before repeating, and it terminates because the
+  // load factor limit keeps at least one slot per table empty.
+  template <typename OnMatch, typename OnEmpty>
+  auto ProbeGroups(HashNumber aKeyHash, OnMatch&& aOnMatch,
+                   OnEmpty&& aOnEmpty) const {
+    const uint32_t sizeMask = mCapacity - 1;
+    const uint8_t h2 = H2(aKeyHash);
+    uint32_t pos = H1(aKeyHash) & sizeMask;
+    uint32_t stride = 0;
+
+    for (;;) {
+      Group group(&mCtrl[pos]);
+
+      for (uint64_t match = group.Match(h2); match; match &= match - 1) {
+        uint32_t index = (pos + MaskBitIndex(match)) & sizeMask;
+        if (auto result = aOnMatch(index)) {
+          return result;
+        }
+      }
+
+      if (uint64_t empties = group.MatchEmpty()) {
+        return aOnEmpty(pos, group, empties);
+      }
+
+      stride += kGroupWidth;
+      pos = (pos + stride) & sizeMask;
+    }
+  }
+
+  Entry* SearchInternal(const Key& aKey, HashNumber aKeyHash) const {
+    return ProbeGroups(
+        aKeyHash,
+        [&](uint32_t aIndex) -> Entry* {
+          Entry* entry = &mEntries[aIndex];
+          return MOZ_LIKELY(Traits::Match(*entry, aKey)) ? entry : nullptr;
+        },
+        [](uint32_t, const Group&, uint64_t) -> Entry* { return nullptr; });
+  }
+
+  // Find the slot a new entry with the given hash should occupy: the first
+  // empty or removed slot along the probe sequence. The caller must have
+  // already established that no matching entry exists.
+  uint32_t FindFreeSlot(HashNumber aKeyHash) const {
+    const uint32_t sizeMask = mCapacity - 1;
+    uint32_t pos = H1(aKeyHash) & sizeMask;
+    uint32_t stride = 0;
+
+    for (;;) {
+      Group group(&mCtrl[pos]);
+      if (uint64_t mask = group.MatchEmptyOrDeleted()) {
+        return (pos + MaskBitIndex(mask)) & sizeMask;
+      }
+      stride += kGroupWidth;
+      pos = (pos + stride) & sizeMask;
+    }
+  }
+
+  // Write a control byte, mirroring the first group's bytes past the end of
+  // the array so group loads near the end of the table wrap without masking.
+  void SetCtrl(uint32_t aIndex, uint8_t aCtrl) {
+    mCtrl[aIndex] = aCtrl;
+    if (aIndex < kGroupWidth) {
+      mCtrl[mCapacity + aIndex] = aCtrl;
+    }
+  }
+
+  // The hashes, entries and control bytes live in a single allocation, in
+  // that order. The stored hashes are not read on the lookup path; they
+  // exist so rehashing needn't recompute (or, when recording or replaying,
+  // re-look-up) each entry's hash.
+  void AllocateStore(uint32_t aCapacity) {
+    MOZ_ASSERT(IsPowerOfTwo(aCapacity));
+    MOZ_ASSERT(aCapacity >= kMinCapacity && aCapacity <= kMaxCapacity);
+
+    CheckedUint32 nbytes = aCapacity;
+    nbytes *= sizeof(HashNumber) + sizeof(Entry) + sizeof(uint8_t);
+    nbytes += kGroupWidth;
+    if (!nbytes.isValid()) {
+      MOZ_CRASH("FlatHashTable entry store size overflow");
+    }
+
+    char* store = (char*)moz_xmalloc(nbytes.value());
+    mHashes = reinterpret_cast<HashNumber*>(store);
+    mEntries =
+        reinterpret_cast<Entry*>(store + aCapacity * sizeof(HashNumber));
+    mCtrl = reinterpret_cast<uint8_t*>(
+        store + aCapacity * (sizeof(HashNumber) + sizeof(Entry)));
+    memset(mCtrl, kEmpty, aCapacity + kGroupWidth);
+    mCapacity = aCapacity;
+    mRemovedCount = 0;
+  }
+
+  // Rehash into a store of the given capacity, dropping tombstones.
+  void ChangeTable(uint32_t aNewCapacity) {
+    HashNumber* oldHashes = mHashes;
+    Entry* oldEntries = mEntries;
+    uint8_t* oldCtrl = mCtrl;
+    uint32_t oldCapacity = mCapacity;
+
+    AllocateStore(aNewCapacity);
+
+    for (uint32_t i = 0; i < oldCapacity; i++) {
+      if (!IsFull(oldCtrl[i])) {
+        continue;
+      }
+      HashNumber keyHash = oldHashes[i];
+      uint32_t index = FindFreeSlot(keyHash);
+      SetCtrl(index, H2(keyHash));
+      mHashes[index] = keyHash;
+      memcpy(&mEntries[index], &oldEntries[i], sizeof(Entry));
+      recordreplay::StableHashTableMoveEntry(this, &oldEntries[i],
+                                             &mEntries[index]);
+    }
+
+    free(oldHashes);
+  }
+
+  void RawRemove(uint32_t aIndex) {
+    MOZ_ASSERT(IsFull(mCtrl[aIndex]));
+    recordreplay::StableHashTableDeleteEntry(this, &mEntries[aIndex]);
+    SetCtrl(aIndex, kDeleted);
+    mRemovedCount++;
+    mEntryCount--;
+  }
+
+  // Shrink the table if it is underloaded, like PLDHashTable, so a table
+  // that temporarily ballooned gives its memory back.
+  void ShrinkIfAppropriate() {
+    if (!mHashes || mEntryCount * 4 >= mCapacity) {
+      return;
+    }
+    uint32_t newCapacity = mCapacity;
+    while (newCapacity > kMinCapacity && mEntryCount * 4 < newCapacity) {
+      newCapacity >>= 1;
+    }
+    if (newCapacity != mCapacity) {
+      ChangeTable(newCapacity);
+    }
+  }
+
+  HashNumber* mHashes = nullptr;
+  Entry* mEntries = nullptr;
+  uint8_t* mCtrl = nullptr;
+  uint32_t mCapacity = 0;
+  uint32_t mEntryCount = 0;
+  uint32_t mRemovedCount = 0;
+  const uint32_t mInitialCapacity;
+};
+
+}  // namespace mozilla
+
+#endif  // mozilla_FlatHashTable_h
@@ -5,7 +5,9 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "mozilla/Assertions.h"
+#include "mozilla/Atomics.h"
 #include "mozilla/Attributes.h"
+#include "mozilla/FlatHashTable.h"
 #include "mozilla/HashFunctions.h"
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/MruCache.h"
@@ -24,7 +26,6 @@
 #include "nsString.h"
 #include "nsThreadUtils.h"
 #include "nsUnicharUtils.h"
-#include "PLDHashTable.h"
 #include "prenv.h"
 
 // There are two kinds of atoms handled by this module.
@@ -160,13 +161,33 @@ struct AtomTableKey {
   uint32_t mHash;
 };
 
-struct AtomTableEntry : public PLDHashEntryHdr {
+struct AtomTableEntry {
   // These references are either to dynamic atoms, in which case they are
   // non-owning, or they are to static atoms, which aren't really refcounted.
   // See the comment at the top of this file for more details.
   nsAtom* MOZ_NON_OWNING_REF mAtom;
 };
 
+struct AtomTableTraits {
+  using Entry = AtomTableEntry;
+  using Key = AtomTableKey;
+
+  static HashNumber Hash(const AtomTableKey& aKey) { return aKey.mHash; }
+
+  static bool Match(const AtomTableEntry& aEntry, const AtomTableKey& aKey) {
+    if (aKey.mUTF8String) {
+      bool err = false;
+      return (CompareUTF8toUTF16(
+                  nsDependentCSubstring(aKey.mUTF8String,
+                                        aKey.mUTF8String + aKey.mLength),
+                  nsDependentAtomString(aEntry.mAtom), &err) == 0) &&
+             !err;
+    }
+
+    return aEntry.mAtom->Equals(aKey.mUTF16String, aKey.mLength);
+  }
+};
+
 struct AtomCache : public MruCache<AtomTableKey, nsAtom*, AtomCache> {
   static HashNumber Hash(const AtomTableKey& aKey) { return aKey.mHash; }
   static bool Match(const AtomTableKey& aKey, const nsAtom* aVal) {
@@ -187,7 +208,7 @@ static AtomCache sRecentlyUsedMainThreadAtoms;
 class nsAtomSubTable {
   friend class nsAtomTable;
   Mutex mLock;
-  PLDHashTable mTable;
+  FlatHashTable<AtomTableTraits> mTable;
   nsAtomSubTable();
   void GCLocked(GCKind aKind);
   void AddSizeOfExcludingThisLocked(MallocSizeOf aMallocSizeOf,
@@ -195,12 +216,12 @@ class nsAtomSubTable {
 
   AtomTableEntry* Search(AtomTableKey& aKey) const {
     mLock.AssertCurrentThreadOwns();
-    return static_cast<AtomTableEntry*>(mTable.Search(&aKey));
+    return mTable.Search(aKey);
   }
 
   AtomTableEntry* Add(AtomTableKey& aKey) {
     mLock.AssertCurrentThreadOwns();
-    return static_cast<AtomTableEntry*>(mTable.Add(&aKey));  // Infallible
+    return mTable.Add(aKey);  // Infallible
   }
 };
 
@@ -222,11 +243,6 @@ class nsAtomTable {
   // counting.
   size_t RacySlowCount();
 
-  // This hash table op is a static member of this class so that it can take
-  // advantage of |friend| declarations.
-  static void AtomTableClearEntry(PLDHashTable* aTable,
-                                  PLDHashEntryHdr* aEntry);
-
   // We achieve measurable reduction in locking contention in parallel CSS
   // parsing by increasing the number of subtables up to 128. This has been
   // measured to have neglible impact on the performance of initialization, GC,
@@ -263,40 +279,6 @@ class nsAtomTable {
 // Static singleton instance for the atom table.
 static nsAtomTable* gAtomTable;
 
-static PLDHashNumber AtomTableGetHash(const void* aKey) {
-  const AtomTableKey* k = static_cast<const AtomTableKey*>(aKey);
-  return k->mHash;
-}
-
-static bool AtomTableMatchKey(const PLDHashEntryHdr* aEntry, const void* aKey) {
-  const AtomTableEntry* he = static_cast<const AtomTableEntry*>(aEntry);
-  const AtomTableKey* k = static_cast<const AtomTableKey*>(aKey);
-
-  if (k->mUTF8String) {
-    bool err = false;
-    return (CompareUTF8toUTF16(nsDependentCSubstring(
-                                   k->mUTF8String, k->mUTF8String + k->mLength),
-                               nsDependentAtomString(he->mAtom), &err) == 0) &&
-           !err;
-  }
-
-  return he->mAtom->Equals(k->mUTF16String, k->mLength);
-}
-
-void nsAtomTable::AtomTableClearEntry(PLDHashTable* aTable,
-                                      PLDHashEntryHdr* aEntry) {
-  auto entry = static_cast<AtomTableEntry*>(aEntry);
-  entry->mAtom = nullptr;
-}
-
-static void AtomTableInitEntry(PLDHashEntryHdr* aEntry, const void* aKey) {
-  static_cast<AtomTableEntry*>(aEntry)->mAtom = nullptr;
-}
-
-static const PLDHashTableOps AtomTableOps = {
-    AtomTableGetHash, AtomTableMatchKey, PLDHashTable::MoveEntryStub,
-    nsAtomTable::AtomTableClearEntry, AtomTableInitEntry};
-
 // The atom table very quickly gets 10,000+ entries in it (or even 100,000+).
 // But choosing the best initial subtable length has some subtleties: we add
 // ~2700 static atoms at start-up, and then we start adding and removing
@@ -328,9 +310,10 @@ nsAtomSubTable& nsAtomTable::SelectSubTable(AtomTableKey& aKey) {
   // entry's position within the subtable. If we used the exact same bits used
   // by the subtables, then each subtable would compute the same position for
   // every entry it observes, leading to pessimal performance. In this case,
-  // we're using PLDHashTable, whose primary hash function uses the N leftmost
-  // bits of the hash value (where N is the log2 capacity of the table). This
-  // means we should prefer the rightmost bits here.
+  // we're using FlatHashTable, which deliberately ignores the low seven bits
+  // of the hash for both its probe position and its control bytes, precisely
+  // so they remain free for this kind of sharding. This means we should
+  // prefer the rightmost bits here.
   //
   // Note that the below is equivalent to mHash % kNumSubTables, a replacement
   // which an optimizing compiler should make, but let's avoid any doubt.
@@ -343,6 +326,10 @@ void nsAtomTable::AddSizeOfIncludingThis(MallocSizeOf aMallocSizeOf,
                                          AtomsSizes& aSizes) {
   MOZ_ASSERT(NS_IsMainThread());
   aSizes.mTable += aMallocSizeOf(this);
+  if (FlatHashTable<AtomTableTraits>* snapshot = gStaticAtomSnapshot) {
+    aSizes.mTable += aMallocSizeOf(snapshot) +
+                     snapshot->ShallowSizeOfExcludingThis(aMallocSizeOf);
+  }
   for (auto& table : mSubTables) {
     MutexAutoLock lock(table.mLock);
     table.AddSizeOfExcludingThisLocked(aMallocSizeOf, aSizes);
@@ -397,8 +384,7 @@ size_t nsAtomTable::RacySlowCount() {
 }
 
 nsAtomSubTable::nsAtomSubTable()
-    : mLock("Atom Sub-Table Lock"),
-      mTable(&AtomTableOps, sizeof(AtomTableEntry), INITIAL_SUBTABLE_LENGTH) {}
+    : mLock("Atom Sub-Table Lock"), mTable(INITIAL_SUBTABLE_LENGTH) {}
 
 void nsAtomSubTable::GCLocked(GCKind aKind) {
   MOZ_ASSERT(NS_IsMainThread());
@@ -408,7 +394,7 @@ void nsAtomSubTable::GCLocked(GCKind aKind) {
   nsAutoCString nonZeroRefcountAtoms;
   uint32_t nonZeroRefcountAtomsCount = 0;
   for (auto i = mTable.Iter(); !i.Done(); i.Next()) {
-    auto entry = static_cast<AtomTableEntry*>(i.Get());
+    AtomTableEntry* entry = i.Get();
     if (entry->mAtom->IsStatic()) {
       continue;
     }
@@ -458,6 +444,26 @@ void nsDynamicAtom::GCAtomTable() {
 // Have the static atoms been inserted into the table?
 static bool gStaticAtomsDone = false;
 
+// An immutable snapshot of the static atom set, published once static atom
+// registration has finished and never modified afterwards. Atomization
+// consults it before taking any subtable lock: a reader either observes null
+// (and takes the locked path) or a fully-built table. Because static atoms
+// are neither refcounted nor ever removed, a match can be handed out without
+// holding a lock, which spares parser and style threads the subtable mutex
+// for the most frequently atomized strings -- element names, attribute names,
+// CSS keywords and the like. The duplicate table costs ~50KB per process.
+static Atomic<FlatHashTable<AtomTableTraits>*, ReleaseAcquire>
+    gStaticAtomSnapshot;
+
+static nsStaticAtom* SearchStaticAtomSnapshot(const AtomTableKey& aKey) {
+  FlatHashTable<AtomTableTraits>* snapshot = gStaticAtomSnapshot;
+  if (MOZ_UNLIKELY(!snapshot)) {
+    return nullptr;
+  }
+  AtomTableEntry* he = snapshot->Search(aKey);
+  return he ? static_cast<nsStaticAtom*>(he->mAtom) : nullptr;
+}
+
 void NS_InitAtomTable() {
   MOZ_ASSERT(NS_IsMainThread());
   MOZ_ASSERT(!gAtomTable);
@@ -467,6 +473,16 @@ void NS_InitAtomTable() {
   gAtomTable = new nsAtomTable();
   gAtomTable->RegisterStaticAtoms(nsGkAtoms::sAtoms, nsGkAtoms::sAtomsLen);
   gStaticAtomsDone = true;
+
+  // Registration is complete, so build and publish the snapshot for the
+  // lock-free read path.
+  auto* snapshot = new FlatHashTable<AtomTableTraits>(nsGkAtoms::sAtomsLen);
+  for (uint32_t i = 0; i < nsGkAtoms::sAtomsLen; ++i) {
+    const nsStaticAtom* atom = &nsGkAtoms::sAtoms[i];
+    AtomTableKey key(atom);
+    snapshot->Add(key)->mAtom = const_cast<nsStaticAtom*>(atom);
+  }
+  gStaticAtomSnapshot = snapshot;
 }
 
 void NS_ShutdownAtomTable() {
@@ -479,6 +495,7 @@ void NS_ShutdownAtomTable() {
   gAtomTable->GC(GCKind::Shutdown);
 #endif
 
+  delete gStaticAtomSnapshot.exchange(nullptr);
   delete gAtomTable;
   gAtomTable = nullptr;
 }
@@ -494,8 +511,7 @@ void nsAtomSubTable::AddSizeOfExcludingThisLocked(MallocSizeOf aMallocSizeOf,
   mLock.AssertCurrentThreadOwns();
   aSizes.mTable += mTable.ShallowSizeOfExcludingThis(aMallocSizeOf);
   for (auto iter = mTable.Iter(); !iter.Done(); iter.Next()) {
-    auto entry = static_cast<AtomTableEntry*>(iter.Get());
-    entry->mAtom->AddSizeOfIncludingThis(aMallocSizeOf, aSizes);
+    iter.Get()->mAtom->AddSizeOfIncludingThis(aMallocSizeOf, aSizes);
   }
 }
 
@@ -552,6 +568,11 @@ already_AddRefed<nsAtom> nsAtomTable::Atomize(const nsACString& aUTF8String) {
     CopyUTF8toUTF16(aUTF8String, str);
     return Atomize(str);
   }
+
+  if (RefPtr<nsAtom> atom = SearchStaticAtomSnapshot(key)) {
+    return atom.forget();
+  }
+
   nsAtomSubTable& table = SelectSubTable(key);
   MutexAutoLock lock(table.mLock);
   AtomTableEntry* he = table.Add(key);
@@ -582,6 +603,11 @@ already_AddRefed<nsAtom> NS_Atomize(const char16_t* aUTF16String) {
 
 already_AddRefed<nsAtom> nsAtomTable::Atomize(const nsAString& aUTF16String) {
   AtomTableKey key(aUTF16String.Data(), aUTF16String.Length());
+
+  if (RefPtr<nsAtom> atom = SearchStaticAtomSnapshot(key)) {
+    return atom.forget();
+  }
+
   nsAtomSubTable& table = SelectSubTable(key);
   MutexAutoLock lock(table.mLock);
   AtomTableEntry* he = table.Add(key);
@@ -614,6 +640,12 @@ already_AddRefed<nsAtom> nsAtomTable::AtomizeMainThread(
     return retVal.forget();
   }
 
+  if (nsStaticAtom* atom = SearchStaticAtomSnapshot(key)) {
+    retVal = atom;
+    p.Set(retVal);
+    return retVal.forget();
+  }
+
   nsAtomSubTable& table = SelectSubTable(key);
   MutexAutoLock lock(table.mLock);
   AtomTableEntry* he = table.Add(key);
@@ -650,12 +682,10 @@ nsStaticAtom* NS_GetStaticAtom(const nsAString& aUTF16String) {
 }
 
 nsStaticAtom* nsAtomTable::GetStaticAtom(const nsAString& aUTF16String) {
+  // NS_GetStaticAtom asserts that static atom setup is done, so the snapshot
+  // is already published and the subtables never need to be consulted.
   AtomTableKey key(aUTF16String.Data(), aUTF16String.Length());
-  nsAtomSubTable& table = SelectSubTable(key);
-  MutexAutoLock lock(table.mLock);
-  AtomTableEntry* he = table.Search(key);
-  return he && he->mAtom->IsStatic() ? static_cast<nsStaticAtom*>(he->mAtom)
-                                     : nullptr;
+  return SearchStaticAtomSnapshot(key);
 }
 
 void ToLowerCaseASCII(RefPtr<nsAtom>& aAtom) {
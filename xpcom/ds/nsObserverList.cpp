@@ -14,6 +14,7 @@ nsresult nsObserverList::AddObserver(nsIObserver* anObserver, bool ownsWeak) {
   NS_ASSERTION(anObserver, "Null input");
 
   MOZ_TRY(mObservers.AppendWeakElement(anObserver, ownsWeak));
+  mSnapshot = nullptr;
   return NS_OK;
 }
 
@@ -21,6 +22,7 @@ nsresult nsObserverList::RemoveObserver(nsIObserver* anObserver) {
   NS_ASSERTION(anObserver, "Null input");
 
   MOZ_TRY(mObservers.RemoveWeakElement(anObserver));
+  mSnapshot = nullptr;
   return NS_OK;
 }
 
@@ -45,6 +47,7 @@ nsCOMArray<nsIObserver> nsObserverList::ReverseCloneObserverArray() {
     } else {
       // the object has gone away, remove the weakref
       mObservers.RemoveElementAt(i);
+      mSnapshot = nullptr;
     }
   }
 
@@ -62,12 +65,37 @@ void nsObserverList::AppendStrongObservers(nsCOMArray<nsIObserver>& aArray) {
   }
 }
 
+already_AddRefed<nsObserverList::Snapshot> nsObserverList::EnsureSnapshot() {
+  if (!mSnapshot) {
+    // Drop released weak references while rebuilding, so the snapshot only
+    // contains entries that were live at build time. Weak references are
+    // still resolved at notification time; a cached snapshot never extends
+    // the lifetime of weakly-held observers.
+    mObservers.RemoveElementsBy([](const nsMaybeWeakPtr<nsIObserver>& aEntry) {
+      return aEntry.IsWeak() && !aEntry.GetValue();
+    });
+    mSnapshot = new Snapshot(mObservers);
+  }
+  return do_AddRef(mSnapshot);
+}
+
 void nsObserverList::NotifyObservers(nsISupports* aSubject, const char* aTopic,
                                      const char16_t* someData) {
-  const nsCOMArray<nsIObserver> observers = ReverseCloneObserverArray();
-
-  for (int32_t i = 0; i < observers.Count(); ++i) {
-    observers[i]->Observe(aSubject, aTopic, someData);
+  RefPtr<Snapshot> snapshot = EnsureSnapshot();
+
+  // An observer may re-enter the observer service and resize the topic
+  // table, which moves this entry: |this| must not be touched after the
+  // first Observe() call below, only the snapshot. (The old clone-and-notify
+  // code had the same constraint; the snapshot just makes the common case
+  // allocation-free.)
+  //
+  // Observers are notified in last-added-first order, matching
+  // ReverseCloneObserverArray().
+  for (int32_t i = snapshot->mObservers.Length() - 1; i >= 0; --i) {
+    nsCOMPtr<nsIObserver> observer = snapshot->mObservers[i].GetValue();
+    if (observer) {
+      observer->Observe(aSubject, aTopic, someData);
+    }
   }
 }
 
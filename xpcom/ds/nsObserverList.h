@@ -14,6 +14,7 @@
 #include "nsMaybeWeakPtr.h"
 #include "nsSimpleEnumerator.h"
 #include "mozilla/Attributes.h"
+#include "mozilla/RefPtr.h"
 
 class nsObserverList : public nsCharPtrHashKey {
   friend class nsObserverService;
@@ -25,7 +26,8 @@ class nsObserverList : public nsCharPtrHashKey {
 
   nsObserverList(nsObserverList&& aOther)
       : nsCharPtrHashKey(std::move(aOther)),
-        mObservers(std::move(aOther.mObservers)) {
+        mObservers(std::move(aOther.mObservers)),
+        mSnapshot(std::move(aOther.mSnapshot)) {
     MOZ_COUNT_CTOR(nsObserverList);
   }
 
@@ -46,7 +48,30 @@ class nsObserverList : public nsCharPtrHashKey {
   void AppendStrongObservers(nsCOMArray<nsIObserver>& aArray);
 
  private:
+  // An immutable, shared snapshot of mObservers. NotifyObservers iterates a
+  // snapshot while holding a reference to it, so a re-entrant AddObserver or
+  // RemoveObserver builds a new snapshot instead of mutating the array being
+  // iterated. Repeated notifications of a topic whose membership is stable
+  // (the common case for hot topics) then make no allocations at all.
+  class Snapshot {
+   public:
+    NS_INLINE_DECL_REFCOUNTING(Snapshot)
+
+    explicit Snapshot(const nsTArray<nsMaybeWeakPtr<nsIObserver>>& aObservers)
+        : mObservers(aObservers.Clone()) {}
+
+    const nsTArray<nsMaybeWeakPtr<nsIObserver>> mObservers;
+
+   private:
+    ~Snapshot() = default;
+  };
+
+  // Return the current snapshot, building one if the observer list changed
+  // since the last notification.
+  already_AddRefed<Snapshot> EnsureSnapshot();
+
   nsMaybeWeakPtrArray<nsIObserver> mObservers;
+  RefPtr<Snapshot> mSnapshot;
 };
 
 class nsObserverEnumerator final : public nsSimpleEnumerator {
@@ -132,6 +132,16 @@ bool nsTArray_base<Alloc, RelocationStrategy>::UsesAutoArrayBuffer() const {
 bool IsTwiceTheRequiredBytesRepresentableAsUint32(size_t aCapacity,
                                                   size_t aElemSize);
 
+// Per-thread spare buffer cache, defined in nsTArray.cpp. Take returns a
+// previously donated malloc'ed block of at least aMinAllocSize bytes and
+// writes its actual size to *aAllocSize, or returns null on a cache miss.
+// Release donates a block of exactly aAllocSize bytes back to the cache, or
+// frees it if it isn't cacheable; it replaces Free() at the call sites that
+// know the allocation size. The destructor can't donate, as it frees without
+// knowing the element size.
+void* nsTArray_TakeSpareBuffer(size_t aMinAllocSize, size_t* aAllocSize);
+void nsTArray_ReleaseSpareBuffer(void* aBuffer, size_t aAllocSize);
+
 template <class Alloc, class RelocationStrategy>
 template <typename ActualAlloc>
 typename ActualAlloc::ResultTypeProxy
@@ -171,13 +181,19 @@ nsTArray_base<Alloc, RelocationStrategy>::EnsureCapacity(size_type aCapacity,
   size_t reqSize = sizeof(Header) + aCapacity * aElemSize;
 
   if (HasEmptyHeader()) {
-    // Malloc() new data
-    Header* header = static_cast<Header*>(ActualAlloc::Malloc(reqSize));
+    // Reuse a spare buffer from this thread's cache, or Malloc() new data.
+    size_t allocSize = reqSize;
+    Header* header =
+        static_cast<Header*>(nsTArray_TakeSpareBuffer(reqSize, &allocSize));
     if (!header) {
-      return ActualAlloc::FailureResult();
+      header = static_cast<Header*>(ActualAlloc::Malloc(reqSize));
+      if (!header) {
+        return ActualAlloc::FailureResult();
+      }
+      allocSize = reqSize;
     }
     header->mLength = 0;
-    header->mCapacity = aCapacity;
+    header->mCapacity = (allocSize - sizeof(Header)) / aElemSize;
     header->mIsAutoArray = 0;
     mHdr = header;
 
@@ -205,7 +221,22 @@ nsTArray_base<Alloc, RelocationStrategy>::EnsureCapacity(size_type aCapacity,
   }
 
   Header* header;
-  if (UsesAutoArrayBuffer() || !RelocationStrategy::allowRealloc) {
+  size_t spareSize;
+  if ((header = static_cast<Header*>(
+           nsTArray_TakeSpareBuffer(bytesToAlloc, &spareSize)))) {
+    // A spare buffer from this thread's cache stands in for both the
+    // malloc-and-copy and the realloc path below. The old buffer's size is
+    // recoverable from its capacity, so it can be donated in turn.
+    bytesToAlloc = spareSize;
+
+    RelocationStrategy::RelocateNonOverlappingRegionWithHeader(
+        header, mHdr, Length(), aElemSize);
+
+    if (!UsesAutoArrayBuffer()) {
+      nsTArray_ReleaseSpareBuffer(mHdr,
+                                  sizeof(Header) + Capacity() * aElemSize);
+    }
+  } else if (UsesAutoArrayBuffer() || !RelocationStrategy::allowRealloc) {
     // Malloc() and copy
     header = static_cast<Header*>(ActualAlloc::Malloc(bytesToAlloc));
     if (!header) {
@@ -216,7 +247,8 @@ nsTArray_base<Alloc, RelocationStrategy>::EnsureCapacity(size_type aCapacity,
         header, mHdr, Length(), aElemSize);
 
     if (!UsesAutoArrayBuffer()) {
-      ActualAlloc::Free(mHdr);
+      nsTArray_ReleaseSpareBuffer(mHdr,
+                                  sizeof(Header) + Capacity() * aElemSize);
     }
   } else {
     // Realloc() existing data
@@ -259,14 +291,16 @@ void nsTArray_base<Alloc, RelocationStrategy>::ShrinkCapacity(
     RelocationStrategy::RelocateNonOverlappingRegion(header + 1, mHdr + 1,
                                                      length, aElemSize);
 
-    nsTArrayFallibleAllocator::Free(mHdr);
+    nsTArray_ReleaseSpareBuffer(mHdr,
+                                sizeof(Header) + Capacity() * aElemSize);
     mHdr = header;
     return;
   }
 
   if (length == 0) {
     MOZ_ASSERT(!IsAutoArray(), "autoarray should have fit 0 elements");
-    nsTArrayFallibleAllocator::Free(mHdr);
+    nsTArray_ReleaseSpareBuffer(mHdr,
+                                sizeof(Header) + Capacity() * aElemSize);
     mHdr = EmptyHdr();
     return;
   }
@@ -285,7 +319,8 @@ void nsTArray_base<Alloc, RelocationStrategy>::ShrinkCapacity(
     RelocationStrategy::RelocateNonOverlappingRegionWithHeader(
         newHeader, mHdr, Length(), aElemSize);
 
-    nsTArrayFallibleAllocator::Free(mHdr);
+    nsTArray_ReleaseSpareBuffer(mHdr,
+                                sizeof(Header) + Capacity() * aElemSize);
   } else {
     // Realloc() existing data.
     newHeader =
@@ -310,7 +345,7 @@ void nsTArray_base<Alloc, RelocationStrategy>::ShrinkCapacityToZero(
 
   const bool isAutoArray = IsAutoArray();
 
-  nsTArrayFallibleAllocator::Free(mHdr);
+  nsTArray_ReleaseSpareBuffer(mHdr, sizeof(Header) + Capacity() * aElemSize);
 
   if (isAutoArray) {
     mHdr = GetAutoArrayBufferUnsafe(aElemAlign);
@@ -9,8 +9,10 @@
 #include "nsXPCOM.h"
 #include "nsCycleCollectionNoteChild.h"
 #include "nsDebug.h"
+#include "mozilla/ArrayUtils.h"
 #include "mozilla/CheckedInt.h"
 #include "mozilla/IntegerPrintfMacros.h"
+#include "prthread.h"
 
 // Ensure this is sufficiently aligned so that Elements() and co don't create
 // unaligned pointers, or slices with unaligned pointers for empty arrays, see
@@ -23,6 +25,129 @@ bool IsTwiceTheRequiredBytesRepresentableAsUint32(size_t aCapacity,
   return ((CheckedUint32(aCapacity) * aElemSize) * 2).isValid();
 }
 
+// ---------------------------------------------------------------------------
+// Per-thread spare buffer cache.
+//
+// Array growth dominates realloc traffic in content processes: display lists
+// and event arrays are built up, torn down, and rebuilt at the same handful
+// of sizes every frame. Since the growth policy rounds allocations below the
+// slow-growth threshold up to a power of two, buffers freed by one array are
+// almost always the exact size the next one asks for. Spare buffers of a few
+// power-of-two sizes are therefore parked on per-thread lists and handed
+// back out by EnsureCapacity, turning the free/malloc churn into pointer
+// swaps that take no allocator lock.
+//
+// The destructor can't participate: nsTArray_base::~nsTArray_base frees its
+// buffer without knowing the element size, so it has no idea how large the
+// allocation was. Buffers enter the cache only from the call sites that do
+// know -- the shrink paths and the growth relocation paths -- which cover
+// the rebuild-heavy workloads this targets.
+
+// Cacheable allocation sizes (header plus elements). These are the sizes
+// EnsureCapacity's power-of-two rounding produces for the small arrays that
+// dominate the churn; larger buffers are rare enough that caching them would
+// mostly pin memory.
+static const size_t kSpareBufferSizes[] = {64, 128, 256, 512, 1024, 2048};
+static const size_t kNumSpareSizes = mozilla::ArrayLength(kSpareBufferSizes);
+static const uint32_t kMaxSparesPerSize = 8;
+
+// A parked buffer. The depth field makes each list self-describing, keeping
+// the thread-local state a plain pointer array with trivial initialization.
+struct SpareBuffer {
+  SpareBuffer* mNext;
+  uint32_t mDepth;  // number of buffers on the list, including this one
+};
+
+// Stored in place of a list head once this thread's cleanup destructor has
+// run, so buffers released during late thread shutdown are freed instead of
+// parked where nothing would ever reclaim them.
+static SpareBuffer* const kSpareCacheDisabled =
+    reinterpret_cast<SpareBuffer*>(1);
+
+static thread_local SpareBuffer* sSpareBuffers[kNumSpareSizes] = {};
+
+static PRUintn sSpareCleanupIndex;
+static PRCallOnceType sSpareCleanupOnce;
+
+// Runs on the owning thread at thread shutdown, via NSPR's thread-private
+// destructor mechanism.
+static void SpareCacheThreadShutdown(void* aUnused) {
+  for (size_t i = 0; i < kNumSpareSizes; i++) {
+    SpareBuffer* spare = sSpareBuffers[i];
+    while (spare && spare != kSpareCacheDisabled) {
+      SpareBuffer* next = spare->mNext;
+      free(spare);
+      spare = next;
+    }
+    sSpareBuffers[i] = kSpareCacheDisabled;
+  }
+}
+
+static PRStatus InitSpareCleanupIndex() {
+  return PR_NewThreadPrivateIndex(&sSpareCleanupIndex,
+                                  SpareCacheThreadShutdown);
+}
+
+// Index of the smallest cacheable size holding aAllocSize bytes, or
+// kNumSpareSizes if the allocation is too large to cache.
+static size_t SpareBucketForSize(size_t aAllocSize) {
+  for (size_t i = 0; i < kNumSpareSizes; i++) {
+    if (aAllocSize <= kSpareBufferSizes[i]) {
+      return i;
+    }
+  }
+  return kNumSpareSizes;
+}
+
+void* nsTArray_TakeSpareBuffer(size_t aMinAllocSize, size_t* aAllocSize) {
+  size_t bucket = SpareBucketForSize(aMinAllocSize);
+  if (bucket == kNumSpareSizes) {
+    return nullptr;
+  }
+  SpareBuffer* head = sSpareBuffers[bucket];
+  if (!head || head == kSpareCacheDisabled) {
+    return nullptr;
+  }
+  sSpareBuffers[bucket] = head->mNext;
+  *aAllocSize = kSpareBufferSizes[bucket];
+  return head;
+}
+
+void nsTArray_ReleaseSpareBuffer(void* aBuffer, size_t aAllocSize) {
+  // Only buffers whose computed size exactly matches a cacheable size are
+  // parked. The caller computes aAllocSize from the header's capacity, which
+  // never overstates the underlying allocation, so an exact match guarantees
+  // the chunk really holds that many bytes when handed back out.
+  size_t bucket = SpareBucketForSize(aAllocSize);
+  if (bucket < kNumSpareSizes && aAllocSize == kSpareBufferSizes[bucket]) {
+    SpareBuffer* head = sSpareBuffers[bucket];
+    if (head != kSpareCacheDisabled) {
+      uint32_t depth = head ? head->mDepth : 0;
+      if (depth < kMaxSparesPerSize) {
+        bool armed = true;
+        if (!head) {
+          // The list is empty, so this thread's cleanup may not be armed
+          // yet. Re-arming when a list merely drained is harmless.
+          armed = PR_CallOnce(&sSpareCleanupOnce, InitSpareCleanupIndex) ==
+                      PR_SUCCESS &&
+                  PR_SetThreadPrivate(sSpareCleanupIndex,
+                                      kSpareCacheDisabled) == PR_SUCCESS;
+        }
+        if (armed) {
+          auto* spare = static_cast<SpareBuffer*>(aBuffer);
+          spare->mNext = head;
+          spare->mDepth = depth + 1;
+          sSpareBuffers[bucket] = spare;
+          return;
+        }
+      }
+    }
+  }
+  free(aBuffer);  // all nsTArray allocators use |malloc|
+}
+
+// ---------------------------------------------------------------------------
+
 MOZ_NORETURN MOZ_COLD void InvalidArrayIndex_CRASH(size_t aIndex,
                                                    size_t aLength) {
   MOZ_CRASH_UNSAFE_PRINTF(
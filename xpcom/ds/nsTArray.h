@@ -2336,6 +2336,8 @@ class nsTArray_Impl
   }
 
   // This method may be called to minimize the memory used by this array.
+  // A heap buffer released here may be donated to the calling thread's spare
+  // buffer cache for reuse by later array growth; see nsTArray.cpp.
   void Compact() { ShrinkCapacity(sizeof(elem_type), MOZ_ALIGNOF(elem_type)); }
 
   //
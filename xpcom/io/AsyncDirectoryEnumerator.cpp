@@ -0,0 +1,155 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "mozilla/AsyncDirectoryEnumerator.h"
+
+#include <utility>
+
+#include "nsIDirectoryEnumerator.h"
+#include "nsISerialEventTarget.h"
+#include "nsThreadUtils.h"
+#include "nsXPCOM.h"
+
+namespace mozilla {
+
+namespace {
+
+// Number of entry names accumulated before a batch is posted back to the
+// dispatching thread. Large enough that the cross-thread traffic is
+// negligible next to the directory reads, small enough that the first
+// entries arrive while the background task is still working.
+constexpr uint32_t kBatchSize = 128;
+
+// Shared state of one enumeration. The background task reads entry names;
+// only nsCStrings cross threads, because nsLocalFile objects are not
+// threadsafe. The nsIFile entries handed to the batch callback are built on
+// the dispatching thread, and the callbacks are destroyed there too, since
+// they may own thread-affine state.
+class Enumeration final {
+ public:
+  NS_INLINE_DECL_THREADSAFE_REFCOUNTING(Enumeration)
+
+  Enumeration(const nsACString& aPath, nsISerialEventTarget* aTarget,
+              AsyncDirectoryEnumerator::BatchCallback&& aOnBatch,
+              AsyncDirectoryEnumerator::CompletionCallback&& aOnComplete)
+      : mPath(aPath),
+        mTarget(aTarget),
+        mOnBatch(std::move(aOnBatch)),
+        mOnComplete(std::move(aOnComplete)) {}
+
+  // Runs as a background task.
+  void Enumerate() { PostCompletion(EnumerateInternal()); }
+
+ private:
+  ~Enumeration() = default;
+
+  nsresult EnumerateInternal() {
+    // The local file object is created, used and released entirely on this
+    // thread, which keeps its non-threadsafe refcount safe.
+    nsCOMPtr<nsIFile> dir;
+    nsresult rv = NS_NewNativeLocalFile(mPath, true, getter_AddRefs(dir));
+    if (NS_FAILED(rv)) {
+      return rv;
+    }
+
+    nsCOMPtr<nsIDirectoryEnumerator> entries;
+    rv = dir->GetDirectoryEntries(getter_AddRefs(entries));
+    if (NS_FAILED(rv)) {
+      return rv;
+    }
+
+    nsTArray<nsCString> names(kBatchSize);
+    nsCOMPtr<nsIFile> entry;
+    while (NS_SUCCEEDED(entries->GetNextFile(getter_AddRefs(entry))) &&
+           entry) {
+      nsAutoCString leafName;
+      if (NS_SUCCEEDED(entry->GetNativeLeafName(leafName))) {
+        names.AppendElement(leafName);
+        if (names.Length() == kBatchSize) {
+          PostBatch(std::move(names));
+          names.SetCapacity(kBatchSize);
+        }
+      }
+    }
+    entries->Close();
+
+    if (!names.IsEmpty()) {
+      PostBatch(std::move(names));
+    }
+    return NS_OK;
+  }
+
+  void PostBatch(nsTArray<nsCString>&& aNames) {
+    RefPtr<Enumeration> self = this;
+    mTarget->Dispatch(NS_NewRunnableFunction(
+        "AsyncDirectoryEnumerator::Batch",
+        [self, names = std::move(aNames)]() { self->DeliverBatch(names); }));
+  }
+
+  void PostCompletion(nsresult aStatus) {
+    RefPtr<Enumeration> self = this;
+    mTarget->Dispatch(NS_NewRunnableFunction(
+        "AsyncDirectoryEnumerator::Completion", [self, aStatus]() {
+          self->mOnComplete(aStatus);
+          // Drop the callbacks on the dispatching thread; the last
+          // reference to |self| may be released elsewhere.
+          self->mOnBatch = nullptr;
+          self->mOnComplete = nullptr;
+        }));
+  }
+
+  // Runs on the dispatching thread.
+  void DeliverBatch(const nsTArray<nsCString>& aNames) {
+    nsTArray<nsCOMPtr<nsIFile>> files(aNames.Length());
+    for (const nsCString& name : aNames) {
+      nsCOMPtr<nsIFile> file;
+      if (NS_SUCCEEDED(
+              NS_NewNativeLocalFile(mPath, true, getter_AddRefs(file))) &&
+          NS_SUCCEEDED(file->AppendNative(name))) {
+        files.AppendElement(std::move(file));
+      }
+    }
+    if (!files.IsEmpty()) {
+      mOnBatch(files);
+    }
+  }
+
+  const nsCString mPath;
+  const nsCOMPtr<nsISerialEventTarget> mTarget;
+  AsyncDirectoryEnumerator::BatchCallback mOnBatch;
+  AsyncDirectoryEnumerator::CompletionCallback mOnComplete;
+};
+
+}  // namespace
+
+// static
+nsresult AsyncDirectoryEnumerator::Enumerate(nsIFile* aDirectory,
+                                             BatchCallback aOnBatch,
+                                             CompletionCallback aOnComplete) {
+  if (NS_WARN_IF(!aDirectory) || NS_WARN_IF(!aOnBatch) ||
+      NS_WARN_IF(!aOnComplete)) {
+    return NS_ERROR_INVALID_ARG;
+  }
+
+  nsISerialEventTarget* target = GetCurrentSerialEventTarget();
+  if (NS_WARN_IF(!target)) {
+    return NS_ERROR_UNEXPECTED;
+  }
+
+  nsAutoCString path;
+  nsresult rv = aDirectory->GetNativePath(path);
+  if (NS_FAILED(rv)) {
+    return rv;
+  }
+
+  RefPtr<Enumeration> state = new Enumeration(
+      path, target, std::move(aOnBatch), std::move(aOnComplete));
+  return NS_DispatchBackgroundTask(
+      NS_NewRunnableFunction("AsyncDirectoryEnumerator::Enumerate",
+                             [state]() { state->Enumerate(); }),
+      NS_DISPATCH_EVENT_MAY_BLOCK);
+}
+
+}  // namespace mozilla
@@ -0,0 +1,55 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef AsyncDirectoryEnumerator_h
+#define AsyncDirectoryEnumerator_h
+
+#include <functional>
+
+#include "nsCOMPtr.h"
+#include "nsIFile.h"
+#include "nsTArray.h"
+
+namespace mozilla {
+
+// Enumerates a directory without blocking the calling thread.
+//
+// nsIFile::GetDirectoryEntries reads a directory synchronously, one entry at
+// a time; on a cold or network-backed profile each call can stall the caller
+// for a disk round trip. Enumerate() instead reads the whole directory as a
+// background task -- where the C library services readdir() from large
+// kernel-batched buffers -- and streams the entries back to the calling
+// thread's event target in batches, so the caller's thread only ever sees
+// ready-made results.
+//
+// Entries are delivered as nsIFile objects that have not been stat()ed.
+// Consumers that only need names never touch the entries' inodes; ones that
+// ask for sizes or times pay for the stat at that point, through nsIFile's
+// usual cache.
+class AsyncDirectoryEnumerator final {
+ public:
+  // Called on the dispatching thread with each batch of entries, in
+  // directory order. A batch is never empty.
+  using BatchCallback = std::function<void(const nsTArray<nsCOMPtr<nsIFile>>&)>;
+
+  // Called on the dispatching thread after the last batch, with the overall
+  // status of the enumeration. No batches are delivered after this.
+  using CompletionCallback = std::function<void(nsresult)>;
+
+  // Start enumerating aDirectory. Must be called on a thread with a serial
+  // event target (the main thread, an nsThread, or a TaskQueue); callbacks
+  // are delivered there. Returns an error if the background dispatch fails;
+  // errors encountered while reading the directory are reported through
+  // aOnComplete instead.
+  static nsresult Enumerate(nsIFile* aDirectory, BatchCallback aOnBatch,
+                            CompletionCallback aOnComplete);
+
+ private:
+  AsyncDirectoryEnumerator() = delete;
+};
+
+}  // namespace mozilla
+
+#endif  // AsyncDirectoryEnumerator_h
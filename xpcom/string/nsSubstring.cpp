@@ -16,12 +16,14 @@
 #endif
 
 #include <stdlib.h>
+#include "mozilla/ArrayUtils.h"
 #include "nsAString.h"
 #include "nsString.h"
 #include "nsStringBuffer.h"
 #include "nsDependentString.h"
 #include "nsMemory.h"
 #include "prprf.h"
+#include "prthread.h"
 #include "nsCOMPtr.h"
 
 #include "mozilla/IntegerPrintfMacros.h"
@@ -105,6 +107,109 @@ static nsStringStats gStringStats;
 
 // ---------------------------------------------------------------------------
 
+// Allocation traces show that short strings -- DOM attribute values, header
+// names and the like -- account for a large share of all nsStringBuffer
+// allocations. A small-string optimization inside nsTSubstring itself isn't
+// an option: the {mData, mLength, flags} representation is shared with the
+// Rust nsstring bindings and with every dependent-string consumer, and
+// nsTAutoStringN already provides inline storage where callers can use it.
+// Instead, released buffers of the two smallest sizes are parked on a
+// per-thread free list and handed back out by Alloc, which removes the
+// malloc/free pair from the short-string hot path without changing the
+// string representation. This matters because mozjemalloc has no per-thread
+// caching of its own; every malloc/free takes an arena lock.
+
+// Cacheable allocation sizes (header plus storage), matching the malloc size
+// classes that short string allocations already land in given the
+// power-of-two rounding in StartBulkWriteImpl. The larger size holds sixteen
+// UTF-16 code units plus the null terminator.
+static const size_t kCachedAllocSizes[] = {32, 64};
+static const size_t kNumCachedSizes = mozilla::ArrayLength(kCachedAllocSizes);
+static const uint32_t kMaxCachedBuffersPerSize = 32;
+
+// A released buffer parked on the cache. The depth field makes each list
+// self-describing, so the thread-local state stays a plain array of
+// pointers with no initialization or destruction order concerns.
+struct CachedBuffer {
+  CachedBuffer* mNext;
+  uint32_t mDepth;  // number of buffers on the list, including this one
+};
+
+// Stored in place of a list head once the thread's cleanup destructor has
+// run, so that buffers released during late thread shutdown fall through to
+// free() instead of being parked where nothing will reclaim them.
+static CachedBuffer* const kCacheDisabled = reinterpret_cast<CachedBuffer*>(1);
+
+static thread_local CachedBuffer* sCachedBuffers[kNumCachedSizes] = {};
+
+static PRUintn sCacheCleanupIndex;
+static PRCallOnceType sCacheCleanupOnce;
+
+// Runs on the owning thread when it shuts down, via NSPR's thread-private
+// destructor mechanism.
+static void CacheThreadShutdown(void* aUnused) {
+  for (size_t i = 0; i < kNumCachedSizes; i++) {
+    CachedBuffer* buffer = sCachedBuffers[i];
+    while (buffer && buffer != kCacheDisabled) {
+      CachedBuffer* next = buffer->mNext;
+      free(buffer);
+      buffer = next;
+    }
+    sCachedBuffers[i] = kCacheDisabled;
+  }
+}
+
+static PRStatus InitCacheCleanupIndex() {
+  return PR_NewThreadPrivateIndex(&sCacheCleanupIndex, CacheThreadShutdown);
+}
+
+// Return the index of the smallest cacheable size that holds aAllocSize
+// bytes, or kNumCachedSizes if the allocation is too large to cache.
+static size_t CacheBucketForSize(size_t aAllocSize) {
+  for (size_t i = 0; i < kNumCachedSizes; i++) {
+    if (aAllocSize <= kCachedAllocSizes[i]) {
+      return i;
+    }
+  }
+  return kNumCachedSizes;
+}
+
+static void* TakeCachedBuffer(size_t aBucket) {
+  CachedBuffer* head = sCachedBuffers[aBucket];
+  if (!head || head == kCacheDisabled) {
+    return nullptr;
+  }
+  sCachedBuffers[aBucket] = head->mNext;
+  return head;
+}
+
+static bool PutCachedBuffer(size_t aBucket, void* aBuffer) {
+  CachedBuffer* head = sCachedBuffers[aBucket];
+  if (head == kCacheDisabled) {
+    return false;
+  }
+  uint32_t depth = head ? head->mDepth : 0;
+  if (depth >= kMaxCachedBuffersPerSize) {
+    return false;
+  }
+  if (!head) {
+    // The list is empty, so this thread's cleanup may not be armed yet. The
+    // redundant re-arming when a list merely drained is harmless and rare.
+    if (PR_CallOnce(&sCacheCleanupOnce, InitCacheCleanupIndex) != PR_SUCCESS ||
+        PR_SetThreadPrivate(sCacheCleanupIndex, kCacheDisabled) !=
+            PR_SUCCESS) {
+      return false;
+    }
+  }
+  auto* cached = static_cast<CachedBuffer*>(aBuffer);
+  cached->mNext = head;
+  cached->mDepth = depth + 1;
+  sCachedBuffers[aBucket] = cached;
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+
 void ReleaseData(void* aData, nsAString::DataFlags aFlags) {
   if (aFlags & nsAString::DataFlags::REFCOUNTED) {
     nsStringBuffer::FromData(aData)->Release();
@@ -190,6 +295,18 @@ void nsStringBuffer::Release() {
     count = mRefCount.load(std::memory_order_acquire);
 
     STRING_STAT_INCREMENT(Free);
+
+    // Park small buffers on the per-thread cache when there's room. Only
+    // buffers whose allocation exactly matches a cacheable size qualify;
+    // Alloc rounds small requests up so this is the common case, and it
+    // guarantees a cached chunk is always large enough to hand back out.
+    size_t allocSize = sizeof(nsStringBuffer) + mStorageSize;
+    size_t bucket = CacheBucketForSize(allocSize);
+    if (bucket < kNumCachedSizes && allocSize == kCachedAllocSizes[bucket] &&
+        PutCachedBuffer(bucket, this)) {
+      return;
+    }
+
     free(this);  // we were allocated with |malloc|
   }
 }
@@ -203,7 +320,19 @@ already_AddRefed<nsStringBuffer> nsStringBuffer::Alloc(size_t aSize) {
                    sizeof(nsStringBuffer) + aSize > aSize,
                "mStorageSize will truncate");
 
-  nsStringBuffer* hdr = (nsStringBuffer*)malloc(sizeof(nsStringBuffer) + aSize);
+  nsStringBuffer* hdr;
+  size_t bucket = CacheBucketForSize(sizeof(nsStringBuffer) + aSize);
+  if (bucket < kNumCachedSizes) {
+    // Round the capacity up to fill the cacheable allocation, so the buffer
+    // qualifies for the cache again when it is released.
+    aSize = kCachedAllocSizes[bucket] - sizeof(nsStringBuffer);
+    hdr = (nsStringBuffer*)TakeCachedBuffer(bucket);
+    if (!hdr) {
+      hdr = (nsStringBuffer*)malloc(kCachedAllocSizes[bucket]);
+    }
+  } else {
+    hdr = (nsStringBuffer*)malloc(sizeof(nsStringBuffer) + aSize);
+  }
   if (hdr) {
     STRING_STAT_INCREMENT(Alloc);
 
@@ -0,0 +1,94 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "gtest/gtest.h"
+
+#include "mozilla/AsyncDirectoryEnumerator.h"
+#include "mozilla/SpinEventLoopUntil.h"
+#include "nsDirectoryServiceDefs.h"
+#include "nsDirectoryServiceUtils.h"
+#include "nsIFile.h"
+#include "nsPrintfCString.h"
+#include "nsTHashtable.h"
+#include "nsHashKeys.h"
+#include "nsThreadUtils.h"
+
+using mozilla::AsyncDirectoryEnumerator;
+using mozilla::SpinEventLoopUntil;
+
+TEST(AsyncDirectoryEnumerator, Enumerate)
+{
+  nsCOMPtr<nsIFile> dir;
+  ASSERT_EQ(NS_GetSpecialDirectory(NS_OS_TEMP_DIR, getter_AddRefs(dir)),
+            NS_OK);
+  ASSERT_EQ(dir->AppendNative("AsyncDirEnumTest"_ns), NS_OK);
+  ASSERT_EQ(dir->CreateUnique(nsIFile::DIRECTORY_TYPE, 0700), NS_OK);
+
+  const uint32_t kNumFiles = 300;  // more than one delivery batch
+  for (uint32_t i = 0; i < kNumFiles; i++) {
+    nsCOMPtr<nsIFile> file;
+    ASSERT_EQ(dir->Clone(getter_AddRefs(file)), NS_OK);
+    ASSERT_EQ(file->AppendNative(nsPrintfCString("file-%u", i)), NS_OK);
+    ASSERT_EQ(file->Create(nsIFile::NORMAL_FILE_TYPE, 0600), NS_OK);
+  }
+
+  nsTHashtable<nsCStringHashKey> seen;
+  bool done = false;
+  nsresult status = NS_ERROR_FAILURE;
+
+  nsresult rv = AsyncDirectoryEnumerator::Enumerate(
+      dir,
+      [&](const nsTArray<nsCOMPtr<nsIFile>>& aFiles) {
+        EXPECT_TRUE(NS_IsMainThread());
+        EXPECT_FALSE(aFiles.IsEmpty());
+        for (const nsCOMPtr<nsIFile>& file : aFiles) {
+          nsAutoCString leafName;
+          EXPECT_EQ(file->GetNativeLeafName(leafName), NS_OK);
+          seen.PutEntry(leafName);
+        }
+      },
+      [&](nsresult aStatus) {
+        EXPECT_TRUE(NS_IsMainThread());
+        status = aStatus;
+        done = true;
+      });
+  ASSERT_EQ(rv, NS_OK);
+
+  MOZ_ALWAYS_TRUE(SpinEventLoopUntil([&]() { return done; }));
+
+  EXPECT_EQ(status, NS_OK);
+  EXPECT_EQ(seen.Count(), kNumFiles);
+  for (uint32_t i = 0; i < kNumFiles; i++) {
+    EXPECT_TRUE(seen.Contains(nsPrintfCString("file-%u", i)));
+  }
+
+  EXPECT_EQ(dir->Remove(/* aRecursive */ true), NS_OK);
+}
+
+TEST(AsyncDirectoryEnumerator, EnumerateMissingDirectory)
+{
+  nsCOMPtr<nsIFile> dir;
+  ASSERT_EQ(NS_GetSpecialDirectory(NS_OS_TEMP_DIR, getter_AddRefs(dir)),
+            NS_OK);
+  ASSERT_EQ(dir->AppendNative("AsyncDirEnumTestDoesNotExist"_ns), NS_OK);
+
+  bool done = false;
+  bool gotBatch = false;
+  nsresult status = NS_OK;
+
+  nsresult rv = AsyncDirectoryEnumerator::Enumerate(
+      dir, [&](const nsTArray<nsCOMPtr<nsIFile>>&) { gotBatch = true; },
+      [&](nsresult aStatus) {
+        status = aStatus;
+        done = true;
+      });
+  ASSERT_EQ(rv, NS_OK);
+
+  MOZ_ALWAYS_TRUE(SpinEventLoopUntil([&]() { return done; }));
+
+  EXPECT_TRUE(NS_FAILED(status));
+  EXPECT_FALSE(gotBatch);
+}
@@ -0,0 +1,107 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Microbenchmarks for core xpcom/mfbt primitives. These report through
+// MozGTestBench (PERFHERDER_DATA JSON on stdout) so CI can trend them;
+// regressions in these containers otherwise land silently.
+
+#include "gtest/gtest.h"
+#include "gtest/MozGTestBench.h"  // For MOZ_GTEST_BENCH
+
+#include "mozilla/ArrayUtils.h"
+#include "mozilla/Vector.h"
+#include "nsAtom.h"
+#include "nsString.h"
+#include "nsTArray.h"
+#include "nsThreadUtils.h"
+#include "PLDHashTable.h"
+
+using namespace mozilla;
+
+// Sizes are chosen so each benchmark runs for a few milliseconds on current
+// hardware: long enough to dominate timer granularity, short enough that the
+// five MozGTestBench iterations stay cheap.
+static const uint32_t kHashEntries = 64 * 1024;
+static const uint32_t kArrayElements = 256 * 1024;
+static const uint32_t kStringAppends = 64 * 1024;
+static const uint32_t kRunnables = 16 * 1024;
+static const uint32_t kAtomLookups = 64 * 1024;
+
+// Keep results observable so the compiler can't discard the work.
+static volatile uint32_t sBenchSink;
+
+MOZ_GTEST_BENCH(BenchPrimitives, PLDHashTableAddSearch, [] {
+  PLDHashTable table(PLDHashTable::StubOps(), sizeof(PLDHashEntryStub));
+  for (uintptr_t i = 1; i <= kHashEntries; i++) {
+    auto* entry = static_cast<PLDHashEntryStub*>(
+        table.Add(reinterpret_cast<const void*>(i)));
+    entry->key = reinterpret_cast<const void*>(i);
+  }
+  uint32_t found = 0;
+  for (uintptr_t i = 1; i <= kHashEntries; i++) {
+    if (table.Search(reinterpret_cast<const void*>(i))) {
+      found++;
+    }
+  }
+  sBenchSink = found;
+  ASSERT_EQ(found, kHashEntries);
+});
+
+MOZ_GTEST_BENCH(BenchPrimitives, TArrayGrowth, [] {
+  nsTArray<uint32_t> array;
+  for (uint32_t i = 0; i < kArrayElements; i++) {
+    array.AppendElement(i);
+  }
+  sBenchSink = array.Length();
+  ASSERT_EQ(array.Length(), kArrayElements);
+});
+
+MOZ_GTEST_BENCH(BenchPrimitives, SubstringConcat, [] {
+  nsAutoCString str;
+  for (uint32_t i = 0; i < kStringAppends; i++) {
+    str.AppendLiteral("0123456789abcdef");
+  }
+  sBenchSink = str.Length();
+  ASSERT_EQ(str.Length(), kStringAppends * 16);
+});
+
+MOZ_GTEST_BENCH(BenchPrimitives, VectorGrowth, [] {
+  Vector<uint32_t> vector;
+  for (uint32_t i = 0; i < kArrayElements; i++) {
+    MOZ_RELEASE_ASSERT(vector.append(i));
+  }
+  sBenchSink = vector.length();
+  ASSERT_EQ(vector.length(), kArrayElements);
+});
+
+MOZ_GTEST_BENCH(BenchPrimitives, RunnableDispatch, [] {
+  uint32_t ran = 0;
+  for (uint32_t i = 0; i < kRunnables; i++) {
+    nsresult rv = NS_DispatchToCurrentThread(NS_NewRunnableFunction(
+        "BenchPrimitives::RunnableDispatch", [&ran] { ran++; }));
+    ASSERT_TRUE(NS_SUCCEEDED(rv));
+  }
+  NS_ProcessPendingEvents(nullptr);
+  sBenchSink = ran;
+  ASSERT_EQ(ran, kRunnables);
+});
+
+MOZ_GTEST_BENCH(BenchPrimitives, AtomTableLookup, [] {
+  // A small working set of atoms, looked up repeatedly: the steady-state
+  // pattern of the parser and style system.
+  const char* names[] = {"div", "span", "class", "style", "href",
+                         "id",  "src",  "width", "height", "type"};
+  uint32_t hits = 0;
+  for (uint32_t i = 0; i < kAtomLookups; i++) {
+    RefPtr<nsAtom> atom =
+        NS_Atomize(nsDependentCString(names[i % ArrayLength(names)]));
+    if (atom) {
+      hits++;
+    }
+  }
+  sBenchSink = hits;
+  ASSERT_EQ(hits, kAtomLookups);
+});
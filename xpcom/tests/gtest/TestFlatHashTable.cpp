@@ -0,0 +1,188 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "mozilla/FlatHashTable.h"
+#include "gtest/gtest.h"
+
+using mozilla::FlatHashTable;
+using mozilla::HashNumber;
+
+namespace {
+
+struct IntEntry {
+  uint64_t mKey;
+  uint32_t mValue;
+};
+
+struct IntTraits {
+  using Entry = IntEntry;
+  using Key = uint64_t;
+
+  static HashNumber Hash(const uint64_t& aKey) {
+    return HashNumber(aKey * 2654435761u);
+  }
+
+  static bool Match(const IntEntry& aEntry, const uint64_t& aKey) {
+    return aEntry.mKey == aKey;
+  }
+};
+
+// A pathological traits class where every key hashes identically, to check
+// that probing alone keeps the table correct.
+struct CollidingTraits : public IntTraits {
+  static HashNumber Hash(const uint64_t& aKey) { return 0x12345678; }
+};
+
+}  // namespace
+
+TEST(FlatHashTable, LazyStorage)
+{
+  // No allocation is made before the first Add, and the empty table supports
+  // searching and iterating.
+  FlatHashTable<IntTraits> t;
+  ASSERT_EQ(t.EntryCount(), 0u);
+  ASSERT_EQ(t.Capacity(), 0u);
+  ASSERT_FALSE(t.Search(1));
+  ASSERT_TRUE(t.Iter().Done());
+  t.Remove(1);
+}
+
+TEST(FlatHashTable, AddSearchRemove)
+{
+  FlatHashTable<IntTraits> t;
+
+  // New entries are zero-filled, so a caller can detect newness the same way
+  // PLDHashTable consumers do.
+  IntEntry* entry = t.Search(42);
+  ASSERT_FALSE(entry);
+  entry = t.Add(42);
+  ASSERT_TRUE(entry);
+  ASSERT_EQ(entry->mKey, 0u);
+  ASSERT_EQ(entry->mValue, 0u);
+  entry->mKey = 42;
+  entry->mValue = 1;
+
+  // Adding the same key again returns the existing entry.
+  ASSERT_EQ(t.Add(42), entry);
+  ASSERT_EQ(t.Search(42), entry);
+  ASSERT_EQ(t.EntryCount(), 1u);
+
+  t.Remove(42);
+  ASSERT_FALSE(t.Search(42));
+  ASSERT_EQ(t.EntryCount(), 0u);
+
+  // Removing an absent key is a no-op.
+  t.Remove(42);
+  ASSERT_EQ(t.EntryCount(), 0u);
+}
+
+TEST(FlatHashTable, GrowAndShrink)
+{
+  static const uint64_t kCount = 10000;
+
+  FlatHashTable<IntTraits> t;
+  for (uint64_t key = 1; key <= kCount; key++) {
+    IntEntry* entry = t.Add(key);
+    ASSERT_EQ(entry->mKey, 0u);
+    entry->mKey = key;
+    entry->mValue = uint32_t(key * 2);
+  }
+  ASSERT_EQ(t.EntryCount(), uint32_t(kCount));
+  uint32_t grownCapacity = t.Capacity();
+  ASSERT_GT(grownCapacity, uint32_t(kCount));
+
+  for (uint64_t key = 1; key <= kCount; key++) {
+    IntEntry* entry = t.Search(key);
+    ASSERT_TRUE(entry);
+    ASSERT_EQ(entry->mKey, key);
+    ASSERT_EQ(entry->mValue, uint32_t(key * 2));
+  }
+  ASSERT_FALSE(t.Search(kCount + 1));
+
+  // Removing most of the entries shrinks the table again.
+  for (uint64_t key = 1; key <= kCount; key++) {
+    if (key % 100 != 0) {
+      t.Remove(key);
+    }
+  }
+  ASSERT_EQ(t.EntryCount(), uint32_t(kCount / 100));
+  ASSERT_LT(t.Capacity(), grownCapacity);
+  for (uint64_t key = 1; key <= kCount; key++) {
+    ASSERT_EQ(!!t.Search(key), key % 100 == 0);
+  }
+}
+
+TEST(FlatHashTable, Iterator)
+{
+  static const uint64_t kCount = 1000;
+
+  FlatHashTable<IntTraits> t;
+  for (uint64_t key = 1; key <= kCount; key++) {
+    t.Add(key)->mKey = key;
+  }
+
+  // Each live entry is visited exactly once; remove the odd keys while
+  // iterating.
+  uint64_t visited = 0;
+  uint64_t keySum = 0;
+  for (auto iter = t.Iter(); !iter.Done(); iter.Next()) {
+    IntEntry* entry = iter.Get();
+    visited++;
+    keySum += entry->mKey;
+    if (entry->mKey % 2 == 1) {
+      iter.Remove();
+    }
+  }
+  ASSERT_EQ(visited, kCount);
+  ASSERT_EQ(keySum, kCount * (kCount + 1) / 2);
+  ASSERT_EQ(t.EntryCount(), uint32_t(kCount / 2));
+  for (uint64_t key = 1; key <= kCount; key++) {
+    ASSERT_EQ(!!t.Search(key), key % 2 == 0);
+  }
+
+  // Emptying the table via the iterator leaves it usable.
+  for (auto iter = t.Iter(); !iter.Done(); iter.Next()) {
+    iter.Remove();
+  }
+  ASSERT_EQ(t.EntryCount(), 0u);
+  t.Add(7)->mKey = 7;
+  ASSERT_TRUE(t.Search(7));
+}
+
+TEST(FlatHashTable, CollidingHashes)
+{
+  static const uint64_t kCount = 300;
+
+  FlatHashTable<CollidingTraits> t;
+  for (uint64_t key = 1; key <= kCount; key++) {
+    IntEntry* entry = t.Add(key);
+    ASSERT_EQ(entry->mKey, 0u);
+    entry->mKey = key;
+  }
+  ASSERT_EQ(t.EntryCount(), uint32_t(kCount));
+  for (uint64_t key = 1; key <= kCount; key++) {
+    IntEntry* entry = t.Search(key);
+    ASSERT_TRUE(entry);
+    ASSERT_EQ(entry->mKey, key);
+  }
+  ASSERT_FALSE(t.Search(kCount + 1));
+
+  // Removal leaves tombstones; the survivors must all remain findable, and
+  // re-adding keys reuses the tombstoned slots without growing forever.
+  for (uint64_t key = 1; key <= kCount; key += 2) {
+    t.Remove(key);
+  }
+  for (uint64_t key = 1; key <= kCount; key++) {
+    ASSERT_EQ(!!t.Search(key), key % 2 == 0);
+  }
+  for (uint64_t key = 1; key <= kCount; key += 2) {
+    t.Add(key)->mKey = key;
+  }
+  ASSERT_EQ(t.EntryCount(), uint32_t(kCount));
+  for (uint64_t key = 1; key <= kCount; key++) {
+    ASSERT_TRUE(t.Search(key));
+  }
+}
@@ -1010,6 +1010,36 @@ TEST(TArray, ToTArray)
   EXPECT_EQ((nsTArray<uint64_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}), keys);
 }
 
+TEST(TArray, SpareBufferCacheReuse)
+{
+  // sizeof(nsTArrayHeader) + 14 * sizeof(uint32_t) == 64 bytes, an exact
+  // spare buffer cache size, so Compact() donates the buffer to this
+  // thread's cache and the next same-sized allocation must get it back.
+
+  // First drain this thread's 64-byte spare list (earlier tests may have
+  // filled it), so the donation below cannot be refused by a full list.
+  nsTArray<nsTArray<uint32_t>> drain;
+  drain.SetCapacity(8);
+  for (int i = 0; i < 8; i++) {
+    drain.AppendElement()->SetCapacity(14);
+  }
+
+  const void* buffer;
+  {
+    nsTArray<uint32_t> array;
+    array.SetCapacity(14);
+    array.AppendElement(42u);
+    buffer = array.Elements();
+    array.Clear();
+    array.Compact();
+  }
+
+  nsTArray<uint32_t> other;
+  other.SetCapacity(14);
+  other.AppendElement(7u);
+  EXPECT_EQ(buffer, other.Elements());
+}
+
 TEST(TArray, RemoveElementsBy)
 {
   // Removing elements returns the correct number of removed elements.
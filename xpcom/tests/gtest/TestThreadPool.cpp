@@ -120,6 +120,46 @@ TEST(ThreadPool, Parallelism)
   pool->Shutdown();
 }
 
+TEST(ThreadPool, AdaptiveThreadLimit)
+{
+  nsCOMPtr<nsIThreadPool> pool = new nsThreadPool();
+
+  bool adaptive = true;
+  EXPECT_TRUE(NS_SUCCEEDED(pool->GetAdaptiveThreadLimit(&adaptive)));
+  EXPECT_FALSE(adaptive);
+
+  EXPECT_TRUE(NS_SUCCEEDED(pool->SetThreadLimit(8)));
+  EXPECT_TRUE(NS_SUCCEEDED(pool->SetAdaptiveThreadLimit(true)));
+  EXPECT_TRUE(NS_SUCCEEDED(pool->GetAdaptiveThreadLimit(&adaptive)));
+  EXPECT_TRUE(adaptive);
+
+  Atomic<int> count(0);
+  for (int i = 0; i < 100; ++i) {
+    nsCOMPtr<nsIRunnable> task = new TestTask(i, count);
+    pool->Dispatch(task, NS_DISPATCH_NORMAL);
+  }
+
+  pool->Shutdown();
+  EXPECT_EQ(count, 100);
+
+  // The controller may have moved the effective limit either way depending
+  // on timing, but it must stay between one and the configured ceiling, and
+  // the averages must have been collected.
+  uint32_t effectiveLimit = 0;
+  EXPECT_TRUE(NS_SUCCEEDED(pool->GetEffectiveThreadLimit(&effectiveLimit)));
+  EXPECT_GE(effectiveLimit, 1u);
+  EXPECT_LE(effectiveLimit, 8u);
+
+  double avgRunTime = 0;
+  EXPECT_TRUE(NS_SUCCEEDED(pool->GetAverageRunTimeMs(&avgRunTime)));
+  EXPECT_GT(avgRunTime, 0.0);
+
+  // Lowering the ceiling clamps the effective limit with it.
+  EXPECT_TRUE(NS_SUCCEEDED(pool->SetThreadLimit(2)));
+  EXPECT_TRUE(NS_SUCCEEDED(pool->GetEffectiveThreadLimit(&effectiveLimit)));
+  EXPECT_LE(effectiveLimit, 2u);
+}
+
 TEST(ThreadPool, ShutdownWithTimeout)
 {
   nsCOMPtr<nsIThreadPool> pool = new nsThreadPool();
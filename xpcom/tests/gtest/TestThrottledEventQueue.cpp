@@ -182,6 +182,38 @@ TEST(ThrottledEventQueue, MixedDispatch)
   ASSERT_TRUE(throttled->IsEmpty());
 }
 
+TEST(ThrottledEventQueue, DispatchBatch)
+{
+  string log;
+
+  auto base = MakeRefPtr<RunnableQueue>();
+  RefPtr<ThrottledEventQueue> throttled =
+      ThrottledEventQueue::Create(base, "test batch queue");
+
+  // A batch takes the queue's lock once and queues a single executor on the
+  // base target for the whole span.
+  nsTArray<nsCOMPtr<nsIRunnable>> batch;
+  batch.AppendElement(
+      NS_NewRunnableFunction("TEQ GTest", [&]() { log += 'a'; }));
+  batch.AppendElement(
+      NS_NewRunnableFunction("TEQ GTest", [&]() { log += 'b'; }));
+  batch.AppendElement(
+      NS_NewRunnableFunction("TEQ GTest", [&]() { log += 'c'; }));
+
+  ASSERT_TRUE(NS_SUCCEEDED(throttled->DispatchBatch(move(batch))));
+  ASSERT_TRUE(batch.IsEmpty());
+  ASSERT_EQ(throttled->Length(), 3U);
+  ASSERT_EQ(base->Length(), 1U);
+
+  // The executor re-enqueues itself until the batch has drained, still one
+  // event per base run.
+  ASSERT_TRUE(NS_SUCCEEDED(base->Run()));
+  ASSERT_EQ(log, "abc");
+
+  ASSERT_TRUE(base->IsEmpty());
+  ASSERT_TRUE(throttled->IsEmpty());
+}
+
 TEST(ThrottledEventQueue, EnqueueFromRun)
 {
   string log;
@@ -257,6 +257,67 @@ class Queue {
   uint16_t mOffsetHead = 0;  // Read position in head page
   uint16_t mHeadLength = 0;  // Number of items in the head page
   uint16_t mTailLength = 0;  // Number of items in the tail page
+
+ public:
+  // A const forward iterator over the queue's elements, oldest first. Any
+  // mutation of the queue invalidates outstanding iterators.
+  class ConstIterator {
+   public:
+    const T& operator*() const {
+      MOZ_ASSERT(mPage);
+      return mPage->mEvents[EffectiveOffset()];
+    }
+
+    ConstIterator& operator++() {
+      MOZ_ASSERT(mPage);
+      if (++mIndex == PageLength()) {
+        mPage = mPage == mQueue->mTail ? nullptr : mPage->mNext;
+        mIndex = 0;
+      }
+      return *this;
+    }
+
+    bool operator==(const ConstIterator& aOther) const {
+      return mPage == aOther.mPage && mIndex == aOther.mIndex;
+    }
+    bool operator!=(const ConstIterator& aOther) const {
+      return !(*this == aOther);
+    }
+
+   private:
+    friend class Queue;
+
+    ConstIterator(const Queue* aQueue, const Page* aPage)
+        : mQueue(aQueue), mPage(aPage) {}
+
+    // Only the head page has a non-zero read position, and its elements may
+    // wrap around to the start of the page.
+    uint16_t EffectiveOffset() const {
+      return mPage == mQueue->mHead
+                 ? (mQueue->mOffsetHead + mIndex) % ItemsPerPage
+                 : mIndex;
+    }
+
+    uint16_t PageLength() const {
+      if (mPage == mQueue->mHead) {
+        return mQueue->mHeadLength;
+      }
+      if (mPage == mQueue->mTail) {
+        return mQueue->mTailLength;
+      }
+      return ItemsPerPage;
+    }
+
+    const Queue* mQueue;
+    const Page* mPage;
+    uint16_t mIndex = 0;
+  };
+
+  ConstIterator begin() const {
+    return ConstIterator(this, IsEmpty() ? nullptr : mHead);
+  }
+
+  ConstIterator end() const { return ConstIterator(this, nullptr); }
 };
 
 }  // namespace mozilla
@@ -20,6 +20,9 @@
 #ifdef XP_WIN
 #  include "ThreadPoolCOMListener.h"
 #endif
+#ifdef MOZ_MEMORY
+#  include "mozmemory.h"
+#endif
 
 namespace mozilla {
 
@@ -30,7 +33,41 @@ static StaticAutoPtr<ReentrantMonitor> sMonitor;
 // Modified only on the main thread.
 static StaticAutoPtr<nsTHashMap<nsCStringHashKey, SharedThreadPool*>> sPools;
 
-static already_AddRefed<nsIThreadPool> CreateThreadPool(const nsCString& aName);
+static already_AddRefed<nsIThreadPool> CreateThreadPool(const nsCString& aName,
+                                                        bool aThreadLocalArenas);
+
+#ifdef MOZ_MEMORY
+// Thread pool listener that pins each pool thread to its own jemalloc arena
+// for the thread's lifetime. An nsIThreadPool only supports a single listener,
+// so this wraps and forwards to any other listener the pool needs.
+class ThreadLocalArenaListener final : public nsIThreadPoolListener {
+ public:
+  NS_DECL_THREADSAFE_ISUPPORTS
+  NS_DECL_NSITHREADPOOLLISTENER
+
+  explicit ThreadLocalArenaListener(nsIThreadPoolListener* aInner)
+      : mInner(aInner) {}
+
+ private:
+  ~ThreadLocalArenaListener() = default;
+
+  nsCOMPtr<nsIThreadPoolListener> mInner;
+};
+
+NS_IMPL_ISUPPORTS(ThreadLocalArenaListener, nsIThreadPoolListener)
+
+NS_IMETHODIMP
+ThreadLocalArenaListener::OnThreadCreated() {
+  jemalloc_thread_local_arena(true);
+  return mInner ? mInner->OnThreadCreated() : NS_OK;
+}
+
+NS_IMETHODIMP
+ThreadLocalArenaListener::OnThreadShuttingDown() {
+  jemalloc_thread_local_arena(false);
+  return mInner ? mInner->OnThreadShuttingDown() : NS_OK;
+}
+#endif
 
 class SharedThreadPoolShutdownObserver : public nsIObserver {
  public:
@@ -95,7 +132,7 @@ void SharedThreadPool::SpinUntilEmpty() {
 }
 
 already_AddRefed<SharedThreadPool> SharedThreadPool::Get(
-    const nsCString& aName, uint32_t aThreadLimit) {
+    const nsCString& aName, uint32_t aThreadLimit, bool aThreadLocalArenas) {
   MOZ_ASSERT(sMonitor && sPools);
   ReentrantMonitorAutoEnter mon(*sMonitor);
   RefPtr<SharedThreadPool> pool;
@@ -108,7 +145,8 @@ already_AddRefed<SharedThreadPool> SharedThreadPool::Get(
             NS_WARNING("Failed to set limits on thread pool");
           }
         } else {
-          nsCOMPtr<nsIThreadPool> threadPool(CreateThreadPool(aName));
+          nsCOMPtr<nsIThreadPool> threadPool(
+              CreateThreadPool(aName, aThreadLocalArenas));
           if (NS_WARN_IF(!threadPool)) {
             sPools->Remove(aName);  // XXX entry.Remove()
             return nullptr;
@@ -217,7 +255,7 @@ nsresult SharedThreadPool::EnsureThreadLimitIsAtLeast(uint32_t aLimit) {
 }
 
 static already_AddRefed<nsIThreadPool> CreateThreadPool(
-    const nsCString& aName) {
+    const nsCString& aName, bool aThreadLocalArenas) {
   nsCOMPtr<nsIThreadPool> pool = new nsThreadPool();
 
   nsresult rv = pool->SetName(aName);
@@ -226,12 +264,20 @@ static already_AddRefed<nsIThreadPool> CreateThreadPool(
   rv = pool->SetThreadStackSize(nsIThreadManager::kThreadPoolStackSize);
   NS_ENSURE_SUCCESS(rv, nullptr);
 
+  nsCOMPtr<nsIThreadPoolListener> listener;
 #ifdef XP_WIN
   // Ensure MSCOM is initialized on the thread pools threads.
-  nsCOMPtr<nsIThreadPoolListener> listener = new MSCOMInitThreadPoolListener();
-  rv = pool->SetListener(listener);
-  NS_ENSURE_SUCCESS(rv, nullptr);
+  listener = new MSCOMInitThreadPoolListener();
+#endif
+#ifdef MOZ_MEMORY
+  if (aThreadLocalArenas) {
+    listener = new ThreadLocalArenaListener(listener);
+  }
 #endif
+  if (listener) {
+    rv = pool->SetListener(listener);
+    NS_ENSURE_SUCCESS(rv, nullptr);
+  }
 
   return pool.forget();
 }
@@ -42,9 +42,13 @@ namespace mozilla {
 class SharedThreadPool : public nsIThreadPool {
  public:
   // Gets (possibly creating) the shared thread pool singleton instance with
-  // thread pool named aName.
+  // thread pool named aName. If aThreadLocalArenas is true and the pool
+  // doesn't exist yet, its threads allocate from per-thread jemalloc arenas
+  // to reduce allocator lock contention; the flag is ignored when the pool
+  // already exists, so all users of a given name should agree on it.
   static already_AddRefed<SharedThreadPool> Get(const nsCString& aName,
-                                                uint32_t aThreadLimit = 4);
+                                                uint32_t aThreadLimit = 4,
+                                                bool aThreadLocalArenas = false);
 
   // We implement custom threadsafe AddRef/Release pair, that destroys the
   // the shared pool singleton when the refcount drops to 0. The addref/release
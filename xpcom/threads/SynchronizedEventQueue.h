@@ -11,8 +11,10 @@
 #include "mozilla/EventQueue.h"
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/Mutex.h"
+#include "mozilla/Unused.h"
 #include "nsIThreadInternal.h"
 #include "nsCOMPtr.h"
+#include "nsTArray.h"
 #include "nsTObserverArray.h"
 
 class nsIEventTarget;
@@ -42,6 +44,28 @@ class ThreadTargetSink {
   virtual bool PutEvent(already_AddRefed<nsIRunnable>&& aEvent,
                         EventQueuePriority aPriority) = 0;
 
+  // Post a span of events in order, clearing aEvents. The default
+  // implementation posts them one at a time; implementations that can take
+  // their lock once for the whole span override this. Returns false if any
+  // event could not be posted, in which case that event and the rest of the
+  // span are leaked the same way PutEvent leaks its event on failure.
+  virtual bool PutEvents(nsTArray<nsCOMPtr<nsIRunnable>>&& aEvents,
+                         EventQueuePriority aPriority) {
+    for (size_t i = 0; i < aEvents.Length(); i++) {
+      if (!PutEvent(aEvents[i].forget(), aPriority)) {
+        // Leak the rest of the span on the same grounds that PutEvent leaked
+        // this event: they may not be safe to release on this thread.
+        for (size_t j = i + 1; j < aEvents.Length(); j++) {
+          Unused << aEvents[j].forget().take();
+        }
+        aEvents.Clear();
+        return false;
+      }
+    }
+    aEvents.Clear();
+    return true;
+  }
+
   // After this method is called, no more events can be posted.
   virtual void Disconnect(const MutexAutoLock& aProofOfLock) = 0;
 
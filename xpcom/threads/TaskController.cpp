@@ -19,6 +19,7 @@
 #include "mozilla/StaticMutex.h"
 #include "mozilla/SchedulerGroup.h"
 #include "mozilla/ScopeExit.h"
+#include "mozilla/Telemetry.h"
 #include "mozilla/Unused.h"
 #include "nsIThreadInternal.h"
 #include "nsQueryObject.h"
@@ -321,6 +322,43 @@ void TaskController::RunPoolThread() {
       }
     }
 
+    if (!ranTask) {
+      // The task graph had no work for us, service our parallel-safe queue,
+      // stealing from a busier thread if ours is empty. Graph tasks are
+      // always serviced first so that prioritization and dependencies keep
+      // working as before.
+      if (RefPtr<Task> task = TakeParallelTask(lock)) {
+        mPoolThreads[mThreadPoolIndex].mCurrentTask = task;
+        mPoolThreads[mThreadPoolIndex].mEffectiveTaskPriority =
+            task->GetPriority();
+        task->mInProgress = true;
+
+        bool taskCompleted = false;
+        {
+          MutexAutoUnlock unlock(mGraphMutex);
+          lastTask = nullptr;
+          AUTO_PROFILE_FOLLOWING_TASK(task);
+          taskCompleted = task->Run();
+          ranTask = true;
+        }
+
+        task->mInProgress = false;
+
+        if (!taskCompleted) {
+          // Parallel-safe tasks are never interrupted, but they may still
+          // yield; requeue at the back of our own queue.
+          mPoolThreads[mThreadPoolIndex].mParallelTasks.push_back(task);
+        } else {
+          task->mCompleted = true;
+#ifdef DEBUG
+          task->mIsInGraph = false;
+#endif
+        }
+
+        lastTask = mPoolThreads[mThreadPoolIndex].mCurrentTask.forget();
+      }
+    }
+
     // Ensure the last task is released before we enter the wait state.
     if (lastTask) {
       MutexAutoUnlock unlock(mGraphMutex);
@@ -335,6 +373,13 @@ void TaskController::RunPoolThread() {
       if (mShuttingDown) {
         IOInterposer::UnregisterCurrentThread();
         MOZ_ASSERT(mThreadableTasks.empty());
+#ifdef DEBUG
+        // We only get here after failing to find any parallel-safe work to
+        // steal, so every queue must have drained.
+        for (PoolThread& thread : mPoolThreads) {
+          MOZ_ASSERT(thread.mParallelTasks.empty());
+        }
+#endif
         return;
       }
 
@@ -348,6 +393,40 @@ void TaskController::RunPoolThread() {
 #endif
 }
 
+RefPtr<Task> TaskController::TakeParallelTask(
+    const MutexAutoLock& aProofOfLock) {
+  std::deque<RefPtr<Task>>& ownQueue =
+      mPoolThreads[mThreadPoolIndex].mParallelTasks;
+
+  if (ownQueue.empty()) {
+    // Steal the newer half of the largest queue. Taking half amortizes the
+    // cost of stealing over a burst, and leaving the older half in place
+    // keeps the victim working at the front of its own queue.
+    PoolThread* victim = nullptr;
+    for (PoolThread& thread : mPoolThreads) {
+      if (!thread.mParallelTasks.empty() &&
+          (!victim ||
+           thread.mParallelTasks.size() > victim->mParallelTasks.size())) {
+        victim = &thread;
+      }
+    }
+    if (!victim) {
+      return nullptr;
+    }
+
+    std::deque<RefPtr<Task>>& victimQueue = victim->mParallelTasks;
+    size_t steal = (victimQueue.size() + 1) / 2;
+    ownQueue.insert(ownQueue.end(),
+                    std::make_move_iterator(victimQueue.end() - steal),
+                    std::make_move_iterator(victimQueue.end()));
+    victimQueue.erase(victimQueue.end() - steal, victimQueue.end());
+  }
+
+  RefPtr<Task> task = std::move(ownQueue.front());
+  ownQueue.pop_front();
+  return task;
+}
+
 void TaskController::AddTask(already_AddRefed<Task>&& aTask) {
   RefPtr<Task> task(aTask);
 
@@ -392,6 +471,20 @@ void TaskController::AddTask(already_AddRefed<Task>&& aTask) {
 
   LogTask::LogDispatch(task);
 
+  if (task->IsParallelSafe()) {
+    // Parallel-safe tasks bypass the task graph entirely; queue to the
+    // emptiest pool thread and let idle threads steal from each other.
+    PoolThread* thread = &mPoolThreads[0];
+    for (PoolThread& candidate : mPoolThreads) {
+      if (candidate.mParallelTasks.size() < thread->mParallelTasks.size()) {
+        thread = &candidate;
+      }
+    }
+    thread->mParallelTasks.push_back(std::move(task));
+    mThreadPoolCV.Notify();
+    return;
+  }
+
   std::pair<std::set<RefPtr<Task>, Task::PriorityCompare>::iterator, bool>
       insertion;
   if (task->IsMainThreadOnly()) {
@@ -467,6 +560,9 @@ void TaskController::ProcessPendingMTTask(bool aMayWait) {
 
 void TaskController::ReprioritizeTask(Task* aTask, uint32_t aPriority) {
   MutexAutoLock lock(mGraphMutex);
+  MOZ_ASSERT(!aTask->IsParallelSafe(),
+             "Parallel-safe tasks run in FIFO order and cannot be "
+             "reprioritized.");
   std::set<RefPtr<Task>, Task::PriorityCompare>* queue = &mMainThreadTasks;
   if (!aTask->IsMainThreadOnly()) {
     queue = &mThreadableTasks;
@@ -484,6 +580,33 @@ void TaskController::ReprioritizeTask(Task* aTask, uint32_t aPriority) {
   MaybeInterruptTask(aTask);
 }
 
+// Histogram key for the per-priority queue-delay histogram. Must stay in
+// sync with the "keys" list of TASK_CONTROLLER_QUEUE_DELAY_MS.
+static const char* TaskPriorityName(EventQueuePriority aPriority) {
+  switch (aPriority) {
+    case EventQueuePriority::Idle:
+      return "Idle";
+    case EventQueuePriority::DeferredTimers:
+      return "DeferredTimers";
+    case EventQueuePriority::InputLow:
+      return "InputLow";
+    case EventQueuePriority::Normal:
+      return "Normal";
+    case EventQueuePriority::MediumHigh:
+      return "MediumHigh";
+    case EventQueuePriority::InputHigh:
+      return "InputHigh";
+    case EventQueuePriority::Vsync:
+      return "Vsync";
+    case EventQueuePriority::InputHighest:
+      return "InputHighest";
+    case EventQueuePriority::Control:
+      return "Control";
+    default:
+      return "Other";
+  }
+}
+
 // Code supporting runnable compatibility.
 // Task that wraps a runnable.
 class RunnableTask : public Task {
@@ -529,9 +652,24 @@ class RunnableTask : public Task {
     memcpy(nsThread::sMainThreadRunnableName.begin(), name.BeginReading(),
            length);
     nsThread::sMainThreadRunnableName[length] = '\0';
+
+    TimeStamp runStart = TimeStamp::Now();
 #endif
 
     mRunnable->Run();
+
+#ifdef MOZ_COLLECTING_RUNNABLE_TELEMETRY
+    // Always-on jank attribution: when a runnable keeps the main thread busy
+    // past the long task threshold, record how long it ran keyed by its name.
+    // Wall time, so time spent in a nested event loop is attributed to the
+    // runnable that spun it.
+    double durationMs = (TimeStamp::Now() - runStart).ToMilliseconds();
+    if (durationMs > LONGTASK_BUSY_WINDOW_MS) {
+      Telemetry::Accumulate(Telemetry::MAIN_THREAD_RUNNABLE_LONG_TASK_MS, name,
+                            static_cast<uint32_t>(durationMs));
+    }
+#endif
+
     mRunnable = nullptr;
     return true;
   }
@@ -824,6 +962,15 @@ bool TaskController::DoExecuteNextTaskOnlyMainThreadInternal(
           } else {
             mainThread->SetRunningEventDelay(now - task->mInsertionTime, now);
           }
+
+          // Always-on queue-delay accounting per priority, so scheduler
+          // regressions show up in telemetry without a profiler attached.
+          Telemetry::Accumulate(
+              Telemetry::TASK_CONTROLLER_QUEUE_DELAY_MS,
+              nsDependentCString(
+                  TaskPriorityName(EventQueuePriority(task->GetPriority()))),
+              static_cast<uint32_t>(
+                  (now - task->mInsertionTime).ToMilliseconds()));
         }
 
         PerformanceCounterState::Snapshot snapshot =
@@ -18,6 +18,7 @@
 #include "nsIEventTarget.h"
 
 #include <atomic>
+#include <deque>
 #include <memory>
 #include <vector>
 #include <set>
@@ -120,6 +121,7 @@ class Task {
   NS_INLINE_DECL_THREADSAFE_REFCOUNTING(Task)
 
   bool IsMainThreadOnly() { return mMainThreadOnly; }
+  bool IsParallelSafe() { return mParallelSafe; }
 
   // This returns the current task priority with its modifier applied.
   uint32_t GetPriority() { return mPriority + mPriorityModifier; }
@@ -141,6 +143,8 @@ class Task {
   void AddDependency(Task* aTask) {
     MOZ_ASSERT(aTask);
     MOZ_ASSERT(!mIsInGraph);
+    MOZ_ASSERT(!mParallelSafe && !aTask->mParallelSafe,
+               "Parallel-safe tasks may not have dependency relationships.");
     mDependencies.insert(aTask);
   }
 
@@ -187,6 +191,21 @@ class Task {
 
   virtual ~Task() {}
 
+  // Mark this task as safe to execute in any order relative to other tasks.
+  // Parallel-safe tasks skip the priority-ordered task graph and are instead
+  // distributed over per-thread run queues that idle pool threads steal from,
+  // so bursts of independent work (image decodes, compression and the like)
+  // scale across the pool instead of contending on graph traversal. This may
+  // only be used for tasks that are not main thread bound and that have no
+  // dependency relationships, and must be called before the task is added to
+  // the controller.
+  void SetParallelSafe() {
+    MOZ_ASSERT(!mIsInGraph);
+    MOZ_ASSERT(!mMainThreadOnly);
+    MOZ_ASSERT(mDependencies.empty());
+    mParallelSafe = true;
+  }
+
   friend class TaskController;
 
   // When this returns false, the task is considered incomplete and will be
@@ -216,6 +235,8 @@ class Task {
 
   // Access to these variables is protected by the GraphMutex.
   bool mMainThreadOnly;
+  // Set before the task is added to the controller, read-only afterwards.
+  bool mParallelSafe = false;
   bool mCompleted = false;
   bool mInProgress = false;
 #ifdef DEBUG
@@ -246,6 +267,10 @@ struct PoolThread {
   // This may be higher than mCurrentTask's priority due to priority
   // propagation. This is -only- valid when mCurrentTask != nullptr.
   uint32_t mEffectiveTaskPriority;
+  // Parallel-safe tasks queued to this thread, in FIFO order. Pool threads
+  // that run dry steal the newer half of the largest of these queues. This
+  // is protected by the GraphMutex.
+  std::deque<RefPtr<Task>> mParallelTasks;
 };
 
 // A task manager implementation for priority levels that should only
@@ -363,6 +388,11 @@ class TaskController {
 
   void RunPoolThread();
 
+  // Take the next parallel-safe task for the current pool thread, stealing
+  // from another thread's queue if our own is empty. Returns null if no
+  // parallel-safe tasks are queued anywhere.
+  RefPtr<Task> TakeParallelTask(const MutexAutoLock& aProofOfLock);
+
   static std::unique_ptr<TaskController> sSingleton;
   static StaticMutex sSingletonMutex;
 
@@ -66,6 +66,38 @@ bool ThreadEventQueue::PutEvent(already_AddRefed<nsIRunnable>&& aEvent,
   return PutEventInternal(std::move(aEvent), aPriority, nullptr);
 }
 
+EventQueuePriority ThreadEventQueue::CorrectedPriority(
+    nsIRunnable* aEvent, EventQueuePriority aPriority) {
+  if (!mIsMainThread) {
+    return aPriority;
+  }
+
+  if (nsCOMPtr<nsIRunnablePriority> runnablePrio = do_QueryInterface(aEvent)) {
+    uint32_t prio = nsIRunnablePriority::PRIORITY_NORMAL;
+    runnablePrio->GetPriority(&prio);
+    if (prio == nsIRunnablePriority::PRIORITY_CONTROL) {
+      aPriority = EventQueuePriority::Control;
+    } else if (prio == nsIRunnablePriority::PRIORITY_VSYNC) {
+      aPriority = EventQueuePriority::Vsync;
+    } else if (prio == nsIRunnablePriority::PRIORITY_INPUT_HIGH) {
+      aPriority = EventQueuePriority::InputHigh;
+    } else if (prio == nsIRunnablePriority::PRIORITY_MEDIUMHIGH) {
+      aPriority = EventQueuePriority::MediumHigh;
+    } else if (prio == nsIRunnablePriority::PRIORITY_DEFERRED_TIMERS) {
+      aPriority = EventQueuePriority::DeferredTimers;
+    } else if (prio == nsIRunnablePriority::PRIORITY_IDLE) {
+      aPriority = EventQueuePriority::Idle;
+    }
+  }
+
+  if (aPriority == EventQueuePriority::Control &&
+      !StaticPrefs::threads_control_event_queue_enabled()) {
+    aPriority = EventQueuePriority::MediumHigh;
+  }
+
+  return aPriority;
+}
+
 bool ThreadEventQueue::PutEventInternal(already_AddRefed<nsIRunnable>&& aEvent,
                                         EventQueuePriority aPriority,
                                         NestedSink* aSink) {
@@ -78,31 +110,7 @@ bool ThreadEventQueue::PutEventInternal(already_AddRefed<nsIRunnable>&& aEvent,
     // Check if the runnable wants to override the passed-in priority.
     // Do this outside the lock, so runnables implemented in JS can QI
     // (and possibly GC) outside of the lock.
-    if (mIsMainThread) {
-      auto* e = event.get();  // can't do_QueryInterface on LeakRefPtr.
-      if (nsCOMPtr<nsIRunnablePriority> runnablePrio = do_QueryInterface(e)) {
-        uint32_t prio = nsIRunnablePriority::PRIORITY_NORMAL;
-        runnablePrio->GetPriority(&prio);
-        if (prio == nsIRunnablePriority::PRIORITY_CONTROL) {
-          aPriority = EventQueuePriority::Control;
-        } else if (prio == nsIRunnablePriority::PRIORITY_VSYNC) {
-          aPriority = EventQueuePriority::Vsync;
-        } else if (prio == nsIRunnablePriority::PRIORITY_INPUT_HIGH) {
-          aPriority = EventQueuePriority::InputHigh;
-        } else if (prio == nsIRunnablePriority::PRIORITY_MEDIUMHIGH) {
-          aPriority = EventQueuePriority::MediumHigh;
-        } else if (prio == nsIRunnablePriority::PRIORITY_DEFERRED_TIMERS) {
-          aPriority = EventQueuePriority::DeferredTimers;
-        } else if (prio == nsIRunnablePriority::PRIORITY_IDLE) {
-          aPriority = EventQueuePriority::Idle;
-        }
-      }
-
-      if (aPriority == EventQueuePriority::Control &&
-          !StaticPrefs::threads_control_event_queue_enabled()) {
-        aPriority = EventQueuePriority::MediumHigh;
-      }
-    }
+    aPriority = CorrectedPriority(event.get(), aPriority);
 
     if (recordreplay::AreThreadEventsDisallowed()) {
       MutexAutoLock lock(mLockNonDeterministic);
@@ -143,6 +151,62 @@ bool ThreadEventQueue::PutEventInternal(already_AddRefed<nsIRunnable>&& aEvent,
   return true;
 }
 
+bool ThreadEventQueue::PutEvents(nsTArray<nsCOMPtr<nsIRunnable>>&& aEvents,
+                                 EventQueuePriority aPriority) {
+  nsCOMPtr<nsIThreadObserver> obs;
+
+  {
+    // Resolve per-runnable priority overrides outside the lock, as in
+    // PutEventInternal.
+    AutoTArray<EventQueuePriority, 32> priorities;
+    priorities.SetCapacity(aEvents.Length());
+    for (const nsCOMPtr<nsIRunnable>& event : aEvents) {
+      priorities.AppendElement(CorrectedPriority(event, aPriority));
+    }
+
+    if (recordreplay::AreThreadEventsDisallowed()) {
+      MutexAutoLock lock(mLockNonDeterministic);
+      for (size_t i = 0; i < aEvents.Length(); i++) {
+        mBaseQueueNonDeterministic.PutEvent(aEvents[i].forget(), priorities[i],
+                                            lock);
+      }
+      aEvents.Clear();
+      return true;
+    }
+
+    MutexAutoLock lock(mLock);
+
+    if (mEventsAreDoomed) {
+      // As in PutEventInternal, leak the events rather than releasing them
+      // on the wrong thread.
+      for (nsCOMPtr<nsIRunnable>& event : aEvents) {
+        Unused << event.forget().take();
+      }
+      aEvents.Clear();
+      return false;
+    }
+
+    for (size_t i = 0; i < aEvents.Length(); i++) {
+      mBaseQueue->PutEvent(aEvents[i].forget(), priorities[i], lock);
+    }
+    aEvents.Clear();
+
+    // A single wakeup suffices: the receiving thread drains its queue in a
+    // loop rather than taking one event per notification.
+    mEventsAvailable.Notify();
+
+    // See the comment in PutEventInternal about grabbing the observer
+    // before dropping the lock.
+    obs = mObserver;
+  }
+
+  if (obs) {
+    obs->OnDispatchedEvent();
+  }
+
+  return true;
+}
+
 already_AddRefed<nsIRunnable> ThreadEventQueue::GetEvent(
     bool aMayWait, mozilla::TimeDuration* aLastEventDelay) {
   // Run any pending non-deterministic events.
@@ -35,6 +35,9 @@ class ThreadEventQueue final : public SynchronizedEventQueue {
   bool PutEvent(already_AddRefed<nsIRunnable>&& aEvent,
                 EventQueuePriority aPriority) final;
 
+  bool PutEvents(nsTArray<nsCOMPtr<nsIRunnable>>&& aEvents,
+                 EventQueuePriority aPriority) final;
+
   already_AddRefed<nsIRunnable> GetEvent(
       bool aMayWait, mozilla::TimeDuration* aLastEventDelay = nullptr) final;
   bool HasPendingEvent() final;
@@ -63,6 +66,12 @@ class ThreadEventQueue final : public SynchronizedEventQueue {
   bool PutEventInternal(already_AddRefed<nsIRunnable>&& aEvent,
                         EventQueuePriority aPriority, NestedSink* aQueue);
 
+  // Apply any priority override the runnable itself requests. Only
+  // meaningful on the main thread; must be called outside mLock since the
+  // QI can run script.
+  EventQueuePriority CorrectedPriority(nsIRunnable* aEvent,
+                                       EventQueuePriority aPriority);
+
   UniquePtr<EventQueue> mBaseQueue;
 
   struct NestedQueueItem {
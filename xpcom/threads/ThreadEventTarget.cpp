@@ -101,6 +101,31 @@ ThreadEventTarget::Dispatch(already_AddRefed<nsIRunnable> aEvent,
   return NS_OK;
 }
 
+nsresult ThreadEventTarget::DispatchBatch(
+    nsTArray<nsCOMPtr<nsIRunnable>>&& aEvents) {
+  for (const nsCOMPtr<nsIRunnable>& event : aEvents) {
+    if (NS_WARN_IF(!event)) {
+      return NS_ERROR_INVALID_ARG;
+    }
+  }
+
+  if (gXPCOMThreadsShutDown && !mIsMainThread) {
+    NS_ASSERTION(false, "Failed DispatchBatch after xpcom-shutdown-threads");
+    return NS_ERROR_ILLEGAL_DURING_SHUTDOWN;
+  }
+
+  for (const nsCOMPtr<nsIRunnable>& event : aEvents) {
+    LogRunnable::LogDispatch(event);
+  }
+
+  if (!mSink->PutEvents(std::move(aEvents), EventQueuePriority::Normal)) {
+    return NS_ERROR_UNEXPECTED;
+  }
+  // Delay to encourage the receiving task to run before we do work.
+  DelayForChaosMode(ChaosFeature::TaskDispatching, 1000);
+  return NS_OK;
+}
+
 NS_IMETHODIMP
 ThreadEventTarget::DelayedDispatch(already_AddRefed<nsIRunnable> aEvent,
                                    uint32_t aDelayMs) {
@@ -26,6 +26,11 @@ class ThreadEventTarget final : public nsISerialEventTarget,
   NS_DECL_THREADSAFE_ISUPPORTS
   NS_DECL_NSIEVENTTARGET_FULL
 
+  // Dispatch a span of runnables in order with NS_DISPATCH_NORMAL semantics,
+  // taking the underlying queue's lock and waking the target only once.
+  // aEvents is cleared.
+  nsresult DispatchBatch(nsTArray<nsCOMPtr<nsIRunnable>>&& aEvents);
+
   // nsIDelayedRunnableObserver
   void OnDelayedRunnableCreated(DelayedRunnable* aRunnable) override;
   void OnDelayedRunnableScheduled(DelayedRunnable* aRunnable) override;
@@ -381,6 +381,37 @@ class ThrottledEventQueue::Inner final : public nsISupports {
     return NS_OK;
   }
 
+  nsresult DispatchBatch(nsTArray<nsCOMPtr<nsIRunnable>>&& aEvents) {
+    if (recordreplay::AreThreadEventsDisallowed()) {
+      MutexAutoLock lock(mMutexNonDeterministic);
+      for (nsCOMPtr<nsIRunnable>& event : aEvents) {
+        mEventQueueNonDeterministic.PutEvent(event.forget(),
+                                             EventQueuePriority::Normal, lock);
+      }
+      aEvents.Clear();
+      return NS_OK;
+    }
+
+    // Any thread
+    MutexAutoLock lock(mMutex);
+
+    if (!IsPaused(lock)) {
+      // A single executor serves the whole span: each run of the executor
+      // draws one event and re-dispatches itself while the queue is
+      // non-empty, so only the first event of a span needs to pay for a
+      // dispatch to the base target.
+      nsresult rv = EnsureExecutor(lock);
+      if (NS_FAILED(rv)) return rv;
+    }
+
+    for (nsCOMPtr<nsIRunnable>& event : aEvents) {
+      LogRunnable::LogDispatch(event);
+      mEventQueue.PutEvent(event.forget(), EventQueuePriority::Normal, lock);
+    }
+    aEvents.Clear();
+    return NS_OK;
+  }
+
   nsresult DelayedDispatch(already_AddRefed<nsIRunnable> aEvent,
                            uint32_t aDelay) {
     // The base target may implement this, but we don't.  Always fail
@@ -451,6 +482,11 @@ ThrottledEventQueue::DelayedDispatch(already_AddRefed<nsIRunnable> aEvent,
   return mInner->DelayedDispatch(std::move(aEvent), aFlags);
 }
 
+nsresult ThrottledEventQueue::DispatchBatch(
+    nsTArray<nsCOMPtr<nsIRunnable>>&& aEvents) {
+  return mInner->DispatchBatch(std::move(aEvents));
+}
+
 NS_IMETHODIMP
 ThrottledEventQueue::IsOnCurrentThread(bool* aResult) {
   *aResult = mInner->IsOnCurrentThread();
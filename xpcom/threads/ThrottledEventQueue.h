@@ -9,7 +9,9 @@
 #ifndef mozilla_ThrottledEventQueue_h
 #define mozilla_ThrottledEventQueue_h
 
+#include "nsCOMPtr.h"
 #include "nsISerialEventTarget.h"
+#include "nsTArray.h"
 
 #define NS_THROTTLEDEVENTQUEUE_IID                   \
   {                                                  \
@@ -105,6 +107,13 @@ class ThrottledEventQueue final : public nsISerialEventTarget {
   // Return true if this ThrottledEventQueue is paused.
   bool IsPaused() const;
 
+  // Dispatch a span of events in order, taking the queue's lock and
+  // dispatching the executor to the base target only once for the whole
+  // span. Callers that enqueue events at a high rate should prefer this to
+  // per-event Dispatch calls. aEvents is cleared.
+  [[nodiscard]] nsresult DispatchBatch(
+      nsTArray<nsCOMPtr<nsIRunnable>>&& aEvents);
+
   NS_DECL_THREADSAFE_ISUPPORTS
   NS_DECL_NSIEVENTTARGET_FULL
 
@@ -23,6 +23,18 @@
 
 using namespace mozilla;
 
+// Timers due further out than this are parked in the unsorted mFarTimers
+// list instead of the heap. Long timeouts -- watchdogs, 30-second page
+// timeouts and the like -- are usually canceled long before they fire, so
+// keeping them out of the heap makes both their arming and their
+// cancellation O(1).
+static const uint32_t kFarThresholdMs = 1000;
+
+// Far timers are cascaded into the heap once they come within this window
+// of being due. It only needs to be wide enough that an entry is in the
+// heap by the time the wait computation wants to order it precisely.
+static const uint32_t kNearWindowMs = 100;
+
 NS_IMPL_ISUPPORTS_INHERITED(TimerThread, Runnable, nsIObserver)
 
 TimerThread::TimerThread()
@@ -38,7 +50,8 @@ TimerThread::TimerThread()
 TimerThread::~TimerThread() {
   mThread = nullptr;
 
-  NS_ASSERTION(mTimers.IsEmpty(), "Timers remain in TimerThread::~TimerThread");
+  NS_ASSERTION(mTimers.IsEmpty() && mFarTimers.IsEmpty(),
+               "Timers remain in TimerThread::~TimerThread");
 }
 
 nsresult TimerThread::InitLocks() { return NS_OK; }
@@ -311,8 +324,13 @@ nsresult TimerThread::Shutdown() {
     for (const UniquePtr<Entry>& entry : mTimers) {
       timers.AppendElement(entry->Take());
     }
+    for (const UniquePtr<Entry>& entry : mFarTimers) {
+      timers.AppendElement(entry->Take());
+    }
 
     mTimers.Clear();
+    mFarTimers.Clear();
+    mFarEarliest = TimeStamp();
   }
 
   for (const RefPtr<nsTimerImpl>& timer : timers) {
@@ -388,6 +406,8 @@ TimerThread::Run() {
       waitFor = TimeDuration::Forever();
       TimeStamp now = TimeStamp::Now();
 
+      CascadeFarTimersInternal(now +
+                               TimeDuration::FromMilliseconds(kNearWindowMs));
       RemoveLeadingCanceledTimersInternal();
 
       if (!mTimers.IsEmpty()) {
@@ -481,6 +501,17 @@ TimerThread::Run() {
         }
       }
 
+      // Far timers don't need to be in the heap to bound the wait: waking at
+      // mFarEarliest cascades the due entries into the heap, after which the
+      // normal path fires them.
+      if (!mFarTimers.IsEmpty()) {
+        TimeDuration farWait =
+            std::max(mFarEarliest - now, TimeDuration::FromMicroseconds(1));
+        if (farWait < waitFor) {
+          waitFor = farWait;
+        }
+      }
+
       if (MOZ_LOG_TEST(GetTimerLog(), LogLevel::Debug)) {
         if (waitFor == TimeDuration::Forever())
           MOZ_LOG(GetTimerLog(), LogLevel::Debug, ("waiting forever\n"));
@@ -523,8 +554,13 @@ nsresult TimerThread::AddTimer(nsTimerImpl* aTimer) {
     return NS_ERROR_OUT_OF_MEMORY;
   }
 
-  // Awaken the timer thread.
-  if (mWaiting && mTimers[0]->Value() == aTimer) {
+  // Awaken the timer thread if the new timer is due no later than the heap
+  // front: it may now be the next to fire, whether it landed at the front of
+  // the heap or in the far list ahead of everything else. A rare spurious
+  // wakeup here only costs the thread a recomputation of its wait.
+  auto* entry = static_cast<Entry*>(aTimer->mHolder);
+  if (mWaiting && entry &&
+      (mTimers.IsEmpty() || entry->Timeout() <= mTimers[0]->Timeout())) {
     mNotified = true;
     mMonitor.Notify();
   }
@@ -557,6 +593,12 @@ TimeStamp TimerThread::FindNextFireTimeForCurrentThread(TimeStamp aDefault,
   TimeStamp timeStamp = aDefault;
   uint32_t index = 0;
 
+  // The heap search below must see every timer that could be due before
+  // aDefault, so bring any such parked far timers into the heap first. For
+  // the short deadlines idle scheduling asks about this is a no-op, since
+  // far timers are at least kFarThresholdMs out.
+  CascadeFarTimersInternal(aDefault);
+
 #ifdef DEBUG
   TimeStamp firstTimeStamp;
   Entry* initialFirstEntry = nullptr;
@@ -640,8 +682,27 @@ bool TimerThread::AddTimerInternal(nsTimerImpl* aTimer) {
 
   LogTimerEvent::LogDispatch(aTimer);
 
-  UniquePtr<Entry>* entry = mTimers.AppendElement(
-      MakeUnique<Entry>(now, aTimer->mTimeout, aTimer), mozilla::fallible);
+  auto newEntry = MakeUnique<Entry>(now, aTimer->mTimeout, aTimer);
+
+  // Timers that aren't due for a while are parked in the unsorted far list,
+  // where both this insertion and a later cancellation are O(1). They only
+  // reach the heap if they survive until CascadeFarTimersInternal() moves
+  // them, shortly before they're due.
+  if (newEntry->Timeout() >
+      now + TimeDuration::FromMilliseconds(kFarThresholdMs)) {
+    UniquePtr<Entry>* entry =
+        mFarTimers.AppendElement(std::move(newEntry), mozilla::fallible);
+    if (!entry) {
+      return false;
+    }
+    if (mFarEarliest.IsNull() || (*entry)->Timeout() < mFarEarliest) {
+      mFarEarliest = (*entry)->Timeout();
+    }
+    return true;
+  }
+
+  UniquePtr<Entry>* entry =
+      mTimers.AppendElement(std::move(newEntry), mozilla::fallible);
   if (!entry) {
     return false;
   }
@@ -651,6 +712,52 @@ bool TimerThread::AddTimerInternal(nsTimerImpl* aTimer) {
   return true;
 }
 
+void TimerThread::CascadeFarTimersInternal(const TimeStamp& aLimit) {
+  mMonitor.AssertCurrentThreadOwns();
+
+  if (mFarTimers.IsEmpty() || mFarEarliest > aLimit) {
+    return;
+  }
+
+  uint32_t moved = 0;
+  TimeStamp earliest;
+  for (uint32_t i = 0; i < mFarTimers.Length();) {
+    Entry* entry = mFarTimers[i].get();
+
+    // Canceled while parked: this is where such entries are reclaimed.
+    if (!entry->Value()) {
+      mFarTimers.UnorderedRemoveElementAt(i);
+      continue;
+    }
+
+    if (entry->Timeout() <= aLimit) {
+      // On allocation failure the entry is left parked; it's retried on the
+      // next cascade.
+      UniquePtr<Entry>* heapEntry =
+          mTimers.AppendElement(std::move(mFarTimers[i]), mozilla::fallible);
+      if (heapEntry) {
+        std::push_heap(mTimers.begin(), mTimers.end(),
+                       Entry::UniquePtrLessThan);
+        mFarTimers.UnorderedRemoveElementAt(i);
+        moved++;
+        continue;
+      }
+    }
+
+    if (earliest.IsNull() || entry->Timeout() < earliest) {
+      earliest = entry->Timeout();
+    }
+    ++i;
+  }
+  mFarEarliest = earliest;
+
+  if (moved) {
+    MOZ_LOG(GetTimerLog(), LogLevel::Debug,
+            ("Cascaded %u far timer(s) into the heap, %u still parked\n",
+             moved, unsigned(mFarTimers.Length())));
+  }
+}
+
 bool TimerThread::RemoveTimerInternal(nsTimerImpl* aTimer) {
   mMonitor.AssertCurrentThreadOwns();
   if (!aTimer || !aTimer->mHolder) {
@@ -67,6 +67,9 @@ class TimerThread final : public mozilla::Runnable, public nsIObserver {
   bool RemoveTimerInternal(nsTimerImpl* aTimer);
   void RemoveLeadingCanceledTimersInternal();
   void RemoveFirstTimerInternal();
+  // Move far timers due at or before aLimit into the heap, dropping
+  // canceled entries along the way.
+  void CascadeFarTimersInternal(const TimeStamp& aLimit);
   nsresult Init();
 
   already_AddRefed<nsTimerImpl> PostTimerEvent(
@@ -108,7 +111,22 @@ class TimerThread final : public mozilla::Runnable, public nsIObserver {
     TimeStamp Timeout() const { return mTimeout; }
   };
 
+  // Binary heap of timers due within kFarThresholdMs, ordered by timeout.
   nsTArray<mozilla::UniquePtr<Entry>> mTimers;
+
+  // Unsorted overflow list of timers due further out than kFarThresholdMs.
+  // Pages with tens of thousands of long timers arm and cancel them without
+  // ever paying for a heap operation: insertion appends, cancellation
+  // forgets the entry through its holder, and only entries that survive
+  // until they come due are cascaded into the heap. This is the overflow
+  // level of a timer wheel, layered over the existing heap.
+  nsTArray<mozilla::UniquePtr<Entry>> mFarTimers;
+
+  // Earliest timeout of any entry in mFarTimers (including canceled entries,
+  // whose stale timeouts at worst cause an early wakeup and a cascade).
+  // Null when mFarTimers is empty.
+  TimeStamp mFarEarliest;
+
   uint32_t mAllowedEarlyFiringMicroseconds;
 };
 
@@ -654,6 +654,15 @@ nsThread::Dispatch(already_AddRefed<nsIRunnable> aEvent, uint32_t aFlags) {
   return mEventTarget->Dispatch(std::move(aEvent), aFlags);
 }
 
+nsresult nsThread::DispatchBatch(nsTArray<nsCOMPtr<nsIRunnable>>&& aEvents) {
+  MOZ_ASSERT(mEventTarget);
+  NS_ENSURE_TRUE(mEventTarget, NS_ERROR_NOT_IMPLEMENTED);
+
+  LOG(("THRD(%p) DispatchBatch [%zu]\n", this, aEvents.Length()));
+
+  return mEventTarget->DispatchBatch(std::move(aEvents));
+}
+
 NS_IMETHODIMP
 nsThread::DelayedDispatch(already_AddRefed<nsIRunnable> aEvent,
                           uint32_t aDelayMs) {
@@ -220,6 +220,11 @@ class nsThread : public nsIThreadInternal,
 
   mozilla::SynchronizedEventQueue* EventQueue() { return mEvents.get(); }
 
+  // Dispatch a span of runnables to this thread in order, taking the event
+  // queue lock and waking the thread only once. Not part of nsIEventTarget;
+  // see NS_DispatchBatchToMainThread.
+  nsresult DispatchBatch(nsTArray<nsCOMPtr<nsIRunnable>>&& aEvents);
+
   bool ShuttingDown() const { return mShutdownContext != nullptr; }
 
   static bool GetLabeledRunnableName(nsIRunnable* aEvent, nsACString& aName,
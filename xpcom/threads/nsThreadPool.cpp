@@ -18,6 +18,7 @@
 #include "mozilla/SpinEventLoopUntil.h"
 #include "nsThreadSyncDispatch.h"
 
+#include <algorithm>
 #include <mutex>
 
 using namespace mozilla;
@@ -40,6 +41,19 @@ static MOZ_THREAD_LOCAL(nsThreadPool*) gCurrentThreadPool;
 #define DEFAULT_IDLE_THREAD_LIMIT 1
 #define DEFAULT_IDLE_THREAD_TIMEOUT PR_SecondsToInterval(60)
 
+// Tuning for the adaptive thread limit controller (see UpdateRunStats).
+// Samples are folded into exponential moving averages with this weight.
+#define ADAPTIVE_SAMPLE_WEIGHT 0.25
+// Grow the effective limit while the average dispatch delay exceeds this
+// multiple of the average run time, shrink it below this fraction; the gap
+// between the two provides hysteresis.
+#define ADAPTIVE_GROW_RATIO 2.0
+#define ADAPTIVE_SHRINK_RATIO 0.25
+// Idle threads above the effective limit retire on this fraction of the
+// configured idle timeout rather than holding their stacks for the full
+// duration.
+#define ADAPTIVE_SURPLUS_TIMEOUT_DIVIDER 10
+
 NS_IMPL_ISUPPORTS_INHERITED(nsThreadPool, Runnable, nsIThreadPool,
                             nsIEventTarget)
 
@@ -70,6 +84,10 @@ nsThreadPool::nsThreadPool()
       mStackSize(nsIThreadManager::DEFAULT_STACK_SIZE),
       mShutdown(false),
       mRegressiveMaxIdleTime(false),
+      mAdaptiveThreadLimit(false),
+      mEffectiveThreadLimit(DEFAULT_THREAD_LIMIT),
+      mAvgDispatchDelayMs(0.0),
+      mAvgRunTimeMs(0.0),
       mIsAPoolThreadFree(true) {
   static std::atomic<int> flag{0};
   call_once(&flag, InitThreadPool);
@@ -83,6 +101,44 @@ nsThreadPool::~nsThreadPool() {
   MOZ_ASSERT(mThreads.IsEmpty());
 }
 
+uint32_t nsThreadPool::ThreadLimit(
+    const MutexAutoLock& aProofOfLock) const {
+  return mAdaptiveThreadLimit ? std::min(mEffectiveThreadLimit, mThreadLimit)
+                              : mThreadLimit;
+}
+
+void nsThreadPool::UpdateRunStats(const MutexAutoLock& aProofOfLock,
+                                  TimeDuration aDelay, TimeDuration aRunTime) {
+  // Exponential moving averages are cheap to maintain and smooth over the
+  // burstiness of individual events.
+  mAvgDispatchDelayMs += ADAPTIVE_SAMPLE_WEIGHT *
+                         (aDelay.ToMilliseconds() - mAvgDispatchDelayMs);
+  mAvgRunTimeMs +=
+      ADAPTIVE_SAMPLE_WEIGHT * (aRunTime.ToMilliseconds() - mAvgRunTimeMs);
+
+  if (!mAdaptiveThreadLimit) {
+    return;
+  }
+
+  // Grow while events spend noticeably longer queued than running, since an
+  // extra thread is then likely to pay for itself; shrink once queuing
+  // latency is a small fraction of run time and the pool is over-provisioned.
+  // Clamping the run time keeps pools of very short events from computing
+  // thresholds out of noise.
+  double runTimeMs = std::max(mAvgRunTimeMs, 1.0);
+  if (mAvgDispatchDelayMs > ADAPTIVE_GROW_RATIO * runTimeMs) {
+    if (mEffectiveThreadLimit < mThreadLimit) {
+      mEffectiveThreadLimit++;
+      LOG(("THRD-P(%p) adaptive grow [%u]\n", this, mEffectiveThreadLimit));
+    }
+  } else if (mAvgDispatchDelayMs < ADAPTIVE_SHRINK_RATIO * runTimeMs) {
+    if (mEffectiveThreadLimit > 1) {
+      mEffectiveThreadLimit--;
+      LOG(("THRD-P(%p) adaptive shrink [%u]\n", this, mEffectiveThreadLimit));
+    }
+  }
+}
+
 nsresult nsThreadPool::PutEvent(nsIRunnable* aEvent) {
   nsCOMPtr<nsIRunnable> event(aEvent);
   return PutEvent(event.forget(), 0);
@@ -115,7 +171,7 @@ nsresult nsThreadPool::PutEvent(already_AddRefed<nsIRunnable> aEvent,
     MOZ_ASSERT(mIdleCount <= (uint32_t)mThreads.Count(), "oops");
 
     // Make sure we have a thread to service this event.
-    if (mThreads.Count() < (int32_t)mThreadLimit &&
+    if (mThreads.Count() < (int32_t)ThreadLimit(lock) &&
         !(aFlags & NS_DISPATCH_AT_END) &&
         // Spawn a new thread if we don't have enough idle threads to serve
         // pending events immediately.
@@ -152,9 +208,9 @@ nsresult nsThreadPool::PutEvent(already_AddRefed<nsIRunnable> aEvent,
     MutexAutoLock lock(mMutex);
     if (mShutdown) {
       killThread = true;
-    } else if (mThreads.Count() < (int32_t)mThreadLimit) {
+    } else if (mThreads.Count() < (int32_t)ThreadLimit(lock)) {
       mThreads.AppendObject(thread);
-      if (mThreads.Count() >= (int32_t)mThreadLimit) {
+      if (mThreads.Count() >= (int32_t)ThreadLimit(lock)) {
         mIsAPoolThreadFree = false;
       }
     } else {
@@ -289,6 +345,13 @@ nsThreadPool::Run() {
         TimeDuration timeout = TimeDuration::FromMilliseconds(
             static_cast<double>(mIdleThreadTimeout) / idleTimeoutDivider);
 
+        // Threads above the adaptive limit are surplus; retire them quickly
+        // instead of holding their stacks for the full idle timeout.
+        if (mAdaptiveThreadLimit &&
+            mThreads.Count() > (int32_t)ThreadLimit(lock)) {
+          timeout = timeout / int64_t(ADAPTIVE_SURPLUS_TIMEOUT_DIVIDER);
+        }
+
         // If we are shutting down, then don't keep any idle threads
         if (mShutdown) {
           exitThread = true;
@@ -319,7 +382,7 @@ nsThreadPool::Run() {
           shutdownThreadOnExit = mThreads.RemoveObject(current);
 
           // keep track if there are threads available to start
-          mIsAPoolThreadFree = (mThreads.Count() < (int32_t)mThreadLimit);
+          mIsAPoolThreadFree = (mThreads.Count() < (int32_t)ThreadLimit(lock));
         } else {
           current->SetRunningEventDelay(TimeDuration(), TimeStamp());
 
@@ -352,13 +415,21 @@ nsThreadPool::Run() {
 
       // We'll handle the case of unstarted threads available
       // when we sample.
-      current->SetRunningEventDelay(delay, TimeStamp::Now());
+      TimeStamp runStart = TimeStamp::Now();
+      current->SetRunningEventDelay(delay, runStart);
 
-      LogRunnable::Run log(event);
-      AUTO_PROFILE_FOLLOWING_RUNNABLE(event);
-      event->Run();
-      // To cover the event's destructor code in the LogRunnable span
-      event = nullptr;
+      {
+        LogRunnable::Run log(event);
+        AUTO_PROFILE_FOLLOWING_RUNNABLE(event);
+        event->Run();
+        // To cover the event's destructor code in the LogRunnable span
+        event = nullptr;
+      }
+
+      {
+        MutexAutoLock lock(mMutex);
+        UpdateRunStats(lock, delay, TimeStamp::Now() - runStart);
+      }
     }
   } while (!exitThread);
 
@@ -569,6 +640,9 @@ nsThreadPool::SetThreadLimit(uint32_t aValue) {
   if (mIdleThreadLimit > mThreadLimit) {
     mIdleThreadLimit = mThreadLimit;
   }
+  if (mEffectiveThreadLimit > mThreadLimit) {
+    mEffectiveThreadLimit = mThreadLimit;
+  }
 
   if (static_cast<uint32_t>(mThreads.Count()) > mThreadLimit) {
     mEventsAvailable
@@ -640,6 +714,45 @@ nsThreadPool::SetIdleThreadTimeoutRegressive(bool aValue) {
   return NS_OK;
 }
 
+NS_IMETHODIMP
+nsThreadPool::GetAdaptiveThreadLimit(bool* aValue) {
+  MutexAutoLock lock(mMutex);
+  *aValue = mAdaptiveThreadLimit;
+  return NS_OK;
+}
+
+NS_IMETHODIMP
+nsThreadPool::SetAdaptiveThreadLimit(bool aValue) {
+  MutexAutoLock lock(mMutex);
+  LOG(("THRD-P(%p) adaptive thread limit [%d]\n", this, aValue));
+  mAdaptiveThreadLimit = aValue;
+  // Start from the configured ceiling and let the controller walk the
+  // effective limit down, so a pool enabled mid-load isn't starved.
+  mEffectiveThreadLimit = mThreadLimit;
+  return NS_OK;
+}
+
+NS_IMETHODIMP
+nsThreadPool::GetAverageDispatchDelayMs(double* aValue) {
+  MutexAutoLock lock(mMutex);
+  *aValue = mAvgDispatchDelayMs;
+  return NS_OK;
+}
+
+NS_IMETHODIMP
+nsThreadPool::GetAverageRunTimeMs(double* aValue) {
+  MutexAutoLock lock(mMutex);
+  *aValue = mAvgRunTimeMs;
+  return NS_OK;
+}
+
+NS_IMETHODIMP
+nsThreadPool::GetEffectiveThreadLimit(uint32_t* aValue) {
+  MutexAutoLock lock(mMutex);
+  *aValue = ThreadLimit(lock);
+  return NS_OK;
+}
+
 NS_IMETHODIMP
 nsThreadPool::GetThreadStackSize(uint32_t* aValue) {
   MutexAutoLock lock(mMutex);
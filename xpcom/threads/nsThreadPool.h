@@ -17,6 +17,7 @@
 #include "mozilla/CondVar.h"
 #include "mozilla/EventQueue.h"
 #include "mozilla/Mutex.h"
+#include "mozilla/TimeStamp.h"
 
 class nsIThread;
 
@@ -36,6 +37,16 @@ class nsThreadPool final : public mozilla::Runnable, public nsIThreadPool {
   nsresult PutEvent(nsIRunnable* aEvent);
   nsresult PutEvent(already_AddRefed<nsIRunnable> aEvent, uint32_t aFlags);
 
+  // The thread limit currently in effect: mThreadLimit, lowered to
+  // mEffectiveThreadLimit when adaptive sizing is enabled.
+  uint32_t ThreadLimit(const mozilla::MutexAutoLock& aProofOfLock) const;
+
+  // Fold one completed event's queuing delay and run time into the averages
+  // and, when adaptive sizing is enabled, step mEffectiveThreadLimit.
+  void UpdateRunStats(const mozilla::MutexAutoLock& aProofOfLock,
+                      mozilla::TimeDuration aDelay,
+                      mozilla::TimeDuration aRunTime);
+
   nsCOMArray<nsIThread> mThreads;
   mozilla::Mutex mMutex;
   mozilla::CondVar mEventsAvailable;
@@ -50,6 +61,11 @@ class nsThreadPool final : public mozilla::Runnable, public nsIThreadPool {
   nsCOMPtr<nsIThreadPoolListener> mListener;
   bool mShutdown;
   bool mRegressiveMaxIdleTime;
+  bool mAdaptiveThreadLimit;
+  // These are protected by mMutex.
+  uint32_t mEffectiveThreadLimit;
+  double mAvgDispatchDelayMs;
+  double mAvgRunTimeMs;
   mozilla::Atomic<bool, mozilla::Relaxed> mIsAPoolThreadFree;
   nsCString mName;
   nsThreadPoolNaming mThreadNaming;
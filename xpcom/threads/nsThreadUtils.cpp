@@ -11,6 +11,7 @@
 #include "mozilla/Attributes.h"
 #include "mozilla/Likely.h"
 #include "mozilla/TimeStamp.h"
+#include "mozilla/Unused.h"
 #include "nsComponentManagerUtils.h"
 #include "nsExceptionHandler.h"
 #include "nsITimer.h"
@@ -228,6 +229,25 @@ nsresult NS_DispatchToMainThread(already_AddRefed<nsIRunnable>&& aEvent,
   return thread->Dispatch(event.take(), aDispatchFlags);
 }
 
+nsresult NS_DispatchBatchToMainThread(
+    nsTArray<nsCOMPtr<nsIRunnable>>&& aEvents) {
+  nsCOMPtr<nsIThread> thread;
+  nsresult rv = NS_GetMainThread(getter_AddRefs(thread));
+  if (NS_WARN_IF(NS_FAILED(rv))) {
+    NS_ASSERTION(false,
+                 "Failed NS_DispatchBatchToMainThread() in shutdown; leaking");
+    // Leak the events as NS_DispatchToMainThread would; they may own main
+    // thread only objects.
+    for (nsCOMPtr<nsIRunnable>& event : aEvents) {
+      Unused << event.forget().take();
+    }
+    aEvents.Clear();
+    return rv;
+  }
+  return static_cast<nsThread*>(thread.get())
+      ->DispatchBatch(std::move(aEvents));
+}
+
 // In the case of failure with a newly allocated runnable with a
 // refcount of zero, we intentionally leak the runnable, because it is
 // likely that the runnable is being dispatched to the main thread
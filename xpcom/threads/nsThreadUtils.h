@@ -124,6 +124,21 @@ extern nsresult NS_DispatchToMainThread(
     already_AddRefed<nsIRunnable>&& aEvent,
     uint32_t aDispatchFlags = NS_DISPATCH_NORMAL);
 
+/**
+ * Dispatch a span of events to the main thread in order, acquiring the event
+ * queue lock and waking the thread only once for the whole span. Useful for
+ * callers that dispatch runnables at a high rate, where per-runnable lock and
+ * condition variable traffic shows up in profiles. aEvents is cleared.
+ *
+ * @param aEvents
+ *   The events to dispatch.
+ *
+ * @returns NS_ERROR_INVALID_ARG
+ *   If any event is null.
+ */
+extern nsresult NS_DispatchBatchToMainThread(
+    nsTArray<nsCOMPtr<nsIRunnable>>&& aEvents);
+
 extern nsresult NS_DelayedDispatchToCurrentThread(
     already_AddRefed<nsIRunnable>&& aEvent, uint32_t aDelayMs);
 